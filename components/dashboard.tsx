@@ -10,6 +10,11 @@ import { FaultPanel } from "./dashboard/fault-panel"
 import { CameraFeed } from "./dashboard/camera-feed"
 import { TurnIndicator } from "./dashboard/turn-indicator"
 import type { VehicleState } from "@/lib/types"
+import { connectVehicleStream } from "@/lib/vehicle-stream"
+
+// Live state from the native dashboard (ui_imgui StateStreamServer), e.g.
+// ws://127.0.0.1:47200. Without it the dashboard runs its own simulation.
+const streamUrl = process.env.NEXT_PUBLIC_VEHICLE_STREAM_URL
 
 const initialState: VehicleState = {
   speed: 0,
@@ -43,6 +48,10 @@ export function Dashboard() {
 
   // Simulate real-time data updates
   useEffect(() => {
+    if (streamUrl) {
+      return connectVehicleStream(streamUrl, initialState, setState)
+    }
+
     const interval = setInterval(() => {
       setState((prev) => {
         const newSpeed = prev.contactorStates.main
@@ -1,6 +1,17 @@
+// Generated from schema/vehicle-state.json by scripts/gen-state.mjs - do not edit
+
+export type Gear = "P" | "R" | "N" | "D"
+export type TurnSignal = "left" | "right" | null
+export type FaultSeverity = "info" | "warning" | "critical"
+
+// Index = C++ enum value (wire and stream encodings)
+export const GEARS: readonly Gear[] = ["P", "R", "N", "D"]
+export const TURN_SIGNALS: readonly TurnSignal[] = [null, "left", "right"]
+export const FAULT_SEVERITIES: readonly FaultSeverity[] = ["info", "warning", "critical"]
+
 export interface VehicleState {
   speed: number
-  gear: "P" | "R" | "N" | "D"
+  gear: Gear
   mainBattery: {
     soc: number
     voltage: number
@@ -24,8 +35,8 @@ export interface VehicleState {
   faults: Array<{
     code: string
     message: string
-    severity: "critical" | "warning" | "info"
+    severity: FaultSeverity
     timestamp: number
   }>
-  turnSignal: "left" | "right" | null
+  turnSignal: TurnSignal
 }
@@ -0,0 +1,176 @@
+import { FAULT_SEVERITIES, GEARS, TURN_SIGNALS, type VehicleState } from "./types"
+
+/**
+ * Decoder for the native dashboard's live state stream (ui_imgui/state_stream.h)
+ *
+ * Each binary WebSocket message carries an 8-byte header (kind, version,
+ * field mask, sequence) followed by only the fields that changed, in bit
+ * order. Floats arrive as float32, so values like 352.4 read back as
+ * 352.39999...; format them for display as usual.
+ */
+
+const STREAM_VERSION = 1
+
+const FIELD_SPEED = 1 << 0
+const FIELD_GEAR = 1 << 1
+const FIELD_MAIN_SOC = 1 << 2
+const FIELD_MAIN_VOLTAGE = 1 << 3
+const FIELD_MAIN_CURRENT = 1 << 4
+const FIELD_SUPP_SOC = 1 << 5
+const FIELD_SUPP_VOLTAGE = 1 << 6
+const FIELD_CRUISE = 1 << 7
+const FIELD_BRAKE = 1 << 8
+const FIELD_CONTACTORS = 1 << 9
+const FIELD_HEARTBEAT = 1 << 10
+const FIELD_TURN_SIGNAL = 1 << 11
+const FIELD_FAULTS = 1 << 12
+
+const utf8 = new TextDecoder()
+
+export interface StreamMessage {
+  state: VehicleState
+  sequence: number
+  full: boolean
+}
+
+/**
+ * Apply one message to the previous state
+ *
+ * Returns a new object; unchanged sub-objects (batteries, cruise, contactors,
+ * faults) are shared with prev so React memoization keeps working. Throws on
+ * a malformed message.
+ */
+export function decodeVehicleMessage(buffer: ArrayBuffer, prev: VehicleState): StreamMessage {
+  const view = new DataView(buffer)
+  const kind = view.getUint8(0)
+  const version = view.getUint8(1)
+  const fields = view.getUint16(2, true)
+  const sequence = view.getUint32(4, true)
+  let offset = 8
+  if (kind > 1 || version !== STREAM_VERSION) {
+    throw new Error(`vehicle stream: unsupported message (kind ${kind}, version ${version})`)
+  }
+
+  const u8 = () => view.getUint8(offset++)
+  const i16 = () => {
+    const value = view.getInt16(offset, true)
+    offset += 2
+    return value
+  }
+  const f32 = () => {
+    const value = view.getFloat32(offset, true)
+    offset += 4
+    return value
+  }
+  const f64 = () => {
+    const value = view.getFloat64(offset, true)
+    offset += 8
+    return value
+  }
+  const text = () => {
+    const length = u8()
+    const value = utf8.decode(new Uint8Array(buffer, offset, length))
+    offset += length
+    return value
+  }
+
+  const state: VehicleState = { ...prev }
+  if (fields & FIELD_SPEED) state.speed = i16()
+  if (fields & FIELD_GEAR) state.gear = GEARS[u8()] ?? "P"
+  if (fields & (FIELD_MAIN_SOC | FIELD_MAIN_VOLTAGE | FIELD_MAIN_CURRENT)) {
+    state.mainBattery = { ...prev.mainBattery }
+    if (fields & FIELD_MAIN_SOC) state.mainBattery.soc = f32()
+    if (fields & FIELD_MAIN_VOLTAGE) state.mainBattery.voltage = f32()
+    if (fields & FIELD_MAIN_CURRENT) state.mainBattery.current = f32()
+  }
+  if (fields & (FIELD_SUPP_SOC | FIELD_SUPP_VOLTAGE)) {
+    state.suppBattery = { ...prev.suppBattery }
+    if (fields & FIELD_SUPP_SOC) state.suppBattery.soc = f32()
+    if (fields & FIELD_SUPP_VOLTAGE) state.suppBattery.voltage = f32()
+  }
+  if (fields & FIELD_CRUISE) {
+    const enabled = u8() !== 0
+    state.cruise = { enabled, setSpeed: i16() }
+  }
+  if (fields & FIELD_BRAKE) state.brakeEngaged = u8() !== 0
+  if (fields & FIELD_CONTACTORS) {
+    const bits = u8()
+    state.contactorStates = { main: (bits & 1) !== 0, precharge: (bits & 2) !== 0, hvil: (bits & 4) !== 0 }
+  }
+  if (fields & FIELD_HEARTBEAT) state.heartbeat = u8()
+  if (fields & FIELD_TURN_SIGNAL) state.turnSignal = TURN_SIGNALS[u8()] ?? null
+  if (fields & FIELD_FAULTS) {
+    const count = u8()
+    const faults: VehicleState["faults"] = []
+    for (let i = 0; i < count; i++) {
+      const severity = FAULT_SEVERITIES[u8()] ?? "info"
+      const timestamp = f64()
+      const code = text()
+      const message = text()
+      faults.push({ code, message, severity, timestamp })
+    }
+    state.faults = faults
+  }
+  if (offset !== buffer.byteLength) {
+    throw new Error("vehicle stream: message length does not match its fields")
+  }
+
+  return { state, sequence, full: kind === 0 }
+}
+
+/**
+ * Subscribe to a state stream, reconnecting with backoff
+ *
+ * Deltas are only applied in sequence. A gap or a malformed message drops
+ * the connection; the server starts every connection with a full state.
+ * Returns a function that closes the stream.
+ */
+export function connectVehicleStream(
+  url: string,
+  initial: VehicleState,
+  onState: (state: VehicleState) => void,
+): () => void {
+  let state = initial
+  let sequence = -1
+  let socket: WebSocket | null = null
+  let retryMs = 500
+  let timer: ReturnType<typeof setTimeout> | undefined
+  let closed = false
+
+  const open = () => {
+    socket = new WebSocket(url)
+    socket.binaryType = "arraybuffer"
+    socket.onopen = () => {
+      retryMs = 500
+    }
+    socket.onmessage = (event: MessageEvent<ArrayBuffer>) => {
+      let message: StreamMessage
+      try {
+        message = decodeVehicleMessage(event.data, state)
+      } catch {
+        socket?.close()
+        return
+      }
+      if (!message.full && message.sequence !== (sequence + 1) >>> 0) {
+        socket?.close()
+        return
+      }
+      sequence = message.sequence
+      state = message.state
+      onState(state)
+    }
+    socket.onclose = () => {
+      sequence = -1
+      if (closed) return
+      timer = setTimeout(open, retryMs)
+      retryMs = Math.min(retryMs * 2, 10000)
+    }
+  }
+  open()
+
+  return () => {
+    closed = true
+    clearTimeout(timer)
+    socket?.close()
+  }
+}
@@ -0,0 +1,75 @@
+// Generated from schema/vehicle-state.json by scripts/gen-state.mjs - do not edit
+
+import { FAULT_SEVERITIES, GEARS, TURN_SIGNALS, type VehicleState } from "./types"
+
+/**
+ * In-place reader for the fixed-layout wire struct (ui_imgui/state_wire.h)
+ *
+ * Works on any DataView (WebSocket ArrayBuffer, fetched file, SharedArrayBuffer)
+ * without copying the buffer; only the returned object is allocated.
+ */
+
+export const WIRE_MAGIC = 0x31545356
+export const WIRE_VERSION = 1
+export const WIRE_SIZE = 1584
+
+const utf8 = new TextDecoder()
+
+function readText(view: DataView, offset: number, capacity: number): string {
+  const bytes = new Uint8Array(view.buffer, view.byteOffset + offset, capacity)
+  const end = bytes.indexOf(0)
+  return utf8.decode(end < 0 ? bytes : bytes.subarray(0, end))
+}
+
+/**
+ * Read one VehicleState at byteOffset; throws on a bad header
+ */
+export function readVehicleWire(view: DataView, byteOffset = 0): VehicleState {
+  if (
+    view.byteLength - byteOffset < WIRE_SIZE ||
+    view.getUint32(byteOffset, true) !== WIRE_MAGIC ||
+    view.getUint16(byteOffset + 4, true) !== WIRE_VERSION ||
+    view.getUint16(byteOffset + 6, true) !== WIRE_SIZE
+  ) {
+    throw new Error("vehicle wire: bad header")
+  }
+
+  const faults: VehicleState["faults"] = []
+  const faultsCount = Math.min(view.getUint8(byteOffset + 1579), 16)
+  for (let i = 0; i < faultsCount; i++) {
+    const base = byteOffset + 8 + i * 96
+    faults.push({
+      code: readText(view, base + 8, 16),
+      message: readText(view, base + 24, 64),
+      severity: FAULT_SEVERITIES[view.getUint8(base + 88)] ?? "info",
+      timestamp: view.getUint32(base, true) + view.getInt32(base + 4, true) * 4294967296,
+    })
+  }
+
+  return {
+    speed: view.getInt32(byteOffset + 1544, true),
+    gear: GEARS[view.getUint8(byteOffset + 1572)] ?? "P",
+    mainBattery: {
+      soc: view.getFloat32(byteOffset + 1548, true),
+      voltage: view.getFloat32(byteOffset + 1552, true),
+      current: view.getFloat32(byteOffset + 1556, true),
+    },
+    suppBattery: {
+      soc: view.getFloat32(byteOffset + 1560, true),
+      voltage: view.getFloat32(byteOffset + 1564, true),
+    },
+    cruise: {
+      enabled: view.getUint8(byteOffset + 1573) !== 0,
+      setSpeed: view.getInt32(byteOffset + 1568, true),
+    },
+    brakeEngaged: view.getUint8(byteOffset + 1574) !== 0,
+    contactorStates: {
+      main: view.getUint8(byteOffset + 1575) !== 0,
+      precharge: view.getUint8(byteOffset + 1576) !== 0,
+      hvil: view.getUint8(byteOffset + 1577) !== 0,
+    },
+    heartbeat: view.getUint8(byteOffset + 1578),
+    faults,
+    turnSignal: TURN_SIGNALS[view.getUint8(byteOffset + 1580)] ?? null,
+  }
+}
@@ -0,0 +1,695 @@
+// Generates the vehicle state types from schema/vehicle-state.json:
+//
+//   ui_imgui/state.h, ui_imgui/fault.h  enums and structs between the GENERATED markers
+//   ui_imgui/state_wire.h               fixed-layout little-endian wire struct, encode/view/compare
+//   ui_imgui/state_diff.h               field change masks, deadbands and patches for the wire struct
+//   lib/types.ts                        VehicleState and the enum value tables
+//   lib/vehicle-wire.ts                 in-place reader for the wire struct
+//
+// Usage: node scripts/gen-state.mjs [--check]
+//   --check exits 1 (writing nothing) if any output is out of date.
+
+import { readFileSync, writeFileSync } from "node:fs"
+import { dirname, join } from "node:path"
+import { fileURLToPath } from "node:url"
+
+const root = join(dirname(fileURLToPath(import.meta.url)), "..")
+const schemaPath = "schema/vehicle-state.json"
+const schema = JSON.parse(readFileSync(join(root, schemaPath), "utf8"))
+const notice = `Generated from ${schemaPath} by scripts/gen-state.mjs - do not edit`
+const beginMarker = `// --- BEGIN GENERATED (${schemaPath}) ---`
+const endMarker = "// --- END GENERATED ---"
+
+const primitives = {
+  bool: { cpp: "bool", wire: "uint8_t", size: 1, ts: "boolean", view: "Uint8" },
+  u8: { cpp: "uint8_t", wire: "uint8_t", size: 1, ts: "number", view: "Uint8" },
+  i32: { cpp: "int", wire: "int32_t", size: 4, ts: "number", view: "Int32" },
+  i64: { cpp: "int64_t", wire: "int64_t", size: 8, ts: "number", view: null },
+  f32: { cpp: "float", wire: "float", size: 4, ts: "number", view: "Float32" },
+  string: { cpp: "std::string", wire: "char", size: 1, ts: "string", view: null },
+}
+
+const enums = new Map(schema.enums.map((e) => [e.name, e]))
+const structs = new Map(schema.structs.map((s) => [s.name, s]))
+
+function fail(message) {
+  console.error(`gen-state: ${message}`)
+  process.exit(1)
+}
+
+const capitalize = (name) => name[0].toUpperCase() + name.slice(1)
+const constantCase = (name) => name.replace(/([a-z0-9])([A-Z])/g, "$1_$2").toUpperCase()
+const plural = (name) => (name.endsWith("y") ? `${name.slice(0, -1)}ies` : `${name}s`)
+
+function classify(field) {
+  if (primitives[field.type]) {
+    if (field.type === "string" && !(field.capacity > 1)) fail(`${field.name}: strings need a capacity`)
+    return field.type === "string" ? "string" : "prim"
+  }
+  if (enums.has(field.type)) return "enum"
+  if (structs.has(field.type)) return field.capacity ? "array" : "struct"
+  fail(`${field.name}: unknown type ${field.type}`)
+}
+
+// --- C++ types ---------------------------------------------------------------
+
+function cppEnum(e) {
+  const values = e.values.map((v, i) => `    ${v.cpp}${i + 1 < e.values.length ? "," : ""}`)
+  return `/**\n * ${e.doc}\n */\nenum class ${e.name} {\n${values.join("\n")}\n};\n`
+}
+
+function cppStruct(s) {
+  const lines = s.fields.map((f) => {
+    const kind = classify(f)
+    if (kind === "array" || kind === "struct") fail(`${s.name}.${f.name}: nested structs are not supported`)
+    const type = kind === "enum" ? f.type : primitives[f.type].cpp
+    return { decl: `${type} ${f.name};`, doc: f.doc }
+  })
+  const width = Math.max(0, ...lines.filter((l) => l.doc).map((l) => l.decl.length))
+  const body = lines.map((l) => (l.doc ? `    ${l.decl.padEnd(width)}  // ${l.doc}` : `    ${l.decl}`))
+  return `/**\n * ${s.doc}\n */\nstruct ${s.name} {\n${body.join("\n")}\n};\n`
+}
+
+function cppRegion(header) {
+  const parts = [
+    ...schema.enums.filter((e) => e.header === header).map(cppEnum),
+    ...schema.structs.filter((s) => s.header === header).map(cppStruct),
+  ]
+  return `${beginMarker}\n\n${parts.join("\n")}\n${endMarker}`
+}
+
+function replaceRegion(text, region, file) {
+  const begin = text.indexOf(beginMarker)
+  const end = text.indexOf(endMarker)
+  if (begin < 0 || end < begin) fail(`${file}: GENERATED markers not found`)
+  return text.slice(0, begin) + region + text.slice(end + endMarker.length)
+}
+
+// --- Wire layout -------------------------------------------------------------
+
+// One wire member: a scalar, a char array or an array of element structs
+function slotsFor(fields, cppBase, tsBase, namePrefix, overrides = {}) {
+  const slots = []
+  for (const f of fields) {
+    const kind = classify(f)
+    const name = namePrefix ? namePrefix + capitalize(f.name) : f.name
+    const cpp = `${cppBase}${overrides[f.name] ?? f.name}`
+    if (kind === "struct") {
+      slots.push(...slotsFor(structs.get(f.type).fields, `${cpp}.`, [...tsBase, f.name], name))
+    } else if (kind === "array") {
+      const element = structs.get(f.type)
+      const elementLayout = layout(slotsFor(element.fields, "item.", [], "", f.cpp?.fields ?? {}))
+      const countType = f.capacity < 256 ? "uint8_t" : "uint16_t"
+      slots.push({ kind: "count", name: `${name}Count`, wire: countType, size: countType === "uint8_t" ? 1 : 2, count: 1, align: countType === "uint8_t" ? 1 : 2, field: f })
+      slots.push({ kind, name, wire: `Wire${element.name}`, size: elementLayout.size, count: f.capacity, align: elementLayout.align, field: f, element, elementLayout, cpp: f.cpp, ts: [...tsBase, f.name] })
+    } else {
+      const prim = primitives[f.type]
+      const size = kind === "enum" ? 1 : prim.size
+      const wire = kind === "enum" ? "uint8_t" : prim.wire
+      const count = kind === "string" ? f.capacity : 1
+      slots.push({ kind, name, wire, size, count, align: size, field: f, cpp, ts: [...tsBase, f.name] })
+    }
+  }
+  return slots
+}
+
+// Natural alignment, widest members first so only tail padding is needed
+function layout(slots, headerSize = 0) {
+  const sorted = [...slots].sort((a, b) => b.align - a.align)
+  let offset = headerSize
+  let align = headerSize ? 8 : 1
+  for (const slot of sorted) {
+    offset = Math.ceil(offset / slot.align) * slot.align
+    slot.offset = offset
+    offset += slot.size * slot.count
+    align = Math.max(align, slot.align)
+  }
+  const size = Math.ceil(offset / align) * align
+  return { slots: sorted, size, align, padding: size - offset, schemaOrder: slots }
+}
+
+const state = schema.state
+const stateSlots = slotsFor(state.fields, "state.", [], "")
+const wire = layout(stateSlots, 8)
+const wireName = `Wire${state.name}`
+
+function cppMembers(l) {
+  const extent = (s) => (s.kind === "array" ? `[kWireMax${capitalize(s.name)}]` : s.count > 1 ? `[${s.count}]` : "")
+  const lines = l.slots.map((s) => `    ${s.wire} ${s.name}${extent(s)};`)
+  if (l.padding) lines.push(`    uint8_t pad_[${l.padding}];`)
+  return lines.join("\n")
+}
+
+function cppEncode(slot, target) {
+  const dst = `${target}.${slot.name}`
+  switch (slot.kind) {
+    case "string": return `WireCopyText(${dst}, sizeof(${dst}), ${slot.cpp});`
+    case "enum": return `${dst} = static_cast<uint8_t>(${slot.cpp});`
+    default:
+      if (slot.field.type === "bool") return `${dst} = ${slot.cpp} ? 1 : 0;`
+      if (slot.wire === primitives[slot.field.type].cpp) return `${dst} = ${slot.cpp};`
+      return `${dst} = static_cast<${slot.wire}>(${slot.cpp});`
+  }
+}
+
+function cppMatch(slot, target) {
+  const w = `${target}.${slot.name}`
+  switch (slot.kind) {
+    case "string": return `WireTextMatches(${w}, sizeof(${w}), ${slot.cpp})`
+    case "enum": return `${w} == static_cast<uint8_t>(${slot.cpp})`
+    default:
+      if (slot.field.type === "bool") return `(${w} != 0) == ${slot.cpp}`
+      if (slot.field.type === "f32") return `WireSameBits(${w}, ${slot.cpp})`
+      if (slot.wire === primitives[slot.field.type].cpp) return `${w} == ${slot.cpp}`
+      return `${w} == static_cast<${slot.wire}>(${slot.cpp})`
+  }
+}
+
+function cppWireHeader() {
+  const arrays = stateSlots.filter((s) => s.kind === "array")
+  const out = []
+  out.push(`#pragma once
+
+// ${notice}
+
+#include "state.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ != __ORDER_LITTLE_ENDIAN__
+#error "state_wire: the wire layout is little-endian"
+#endif
+
+namespace ui {
+
+/**
+ * Fixed-layout ${state.name} for sockets, shared memory and mmapped files
+ *
+ * Every member sits at a fixed little-endian offset with natural alignment,
+ * so a received buffer is used in place through ViewWire() (no parsing, no
+ * copies). Members are ordered by alignment, not schema order; strings are
+ * NUL-terminated and truncated at a UTF-8 boundary; enums and bools are one
+ * byte. lib/vehicle-wire.ts reads the same bytes in the browser.
+ */
+
+constexpr uint32_t kWireMagic = 0x${Buffer.from("VST1").readUInt32LE(0).toString(16).toUpperCase()};   // "VST1"
+constexpr uint16_t kWireVersion = ${schema.wireVersion};
+`)
+  for (const a of arrays) {
+    out.push(`constexpr size_t kWireMax${capitalize(a.name)} = ${a.count};`)
+  }
+  out.push("")
+  for (const a of arrays) {
+    out.push(`struct ${a.wire} {\n${cppMembers(a.elementLayout)}\n};\n`)
+  }
+  out.push(`struct ${wireName} {
+    uint32_t magic;       // kWireMagic
+    uint16_t version;     // kWireVersion
+    uint16_t size;        // sizeof(${wireName})
+${cppMembers(wire)}
+};
+`)
+  out.push(`static_assert(std::is_trivially_copyable<${wireName}>::value, "wire struct must be trivially copyable");`)
+  out.push(`static_assert(sizeof(${wireName}) == ${wire.size}, "wire layout changed");`)
+  for (const a of arrays) {
+    out.push(`static_assert(sizeof(${a.wire}) == ${a.elementLayout.size}, "wire layout changed");`)
+    for (const s of a.elementLayout.slots) {
+      out.push(`static_assert(offsetof(${a.wire}, ${s.name}) == ${s.offset}, "wire layout changed");`)
+    }
+  }
+  for (const s of wire.slots) {
+    out.push(`static_assert(offsetof(${wireName}, ${s.name}) == ${s.offset}, "wire layout changed");`)
+  }
+
+  out.push(`
+// Truncate to capacity - 1 bytes without splitting a UTF-8 sequence, zero-fill the rest
+inline void WireCopyText(char* out, size_t capacity, const std::string& text) {
+    size_t length = text.size();
+    if (length >= capacity) {
+        length = capacity - 1;
+        while (length > 0 && (static_cast<uint8_t>(text[length]) & 0xC0) == 0x80) length--;
+    }
+    memcpy(out, text.data(), length);
+    memset(out + length, 0, capacity - length);
+}
+
+// True if text, truncated as WireCopyText() would, equals the wire string
+inline bool WireTextMatches(const char* wire, size_t capacity, const std::string& text) {
+    char truncated[256];
+    WireCopyText(truncated, std::min(capacity, sizeof(truncated)), text);
+    return strncmp(wire, truncated, capacity) == 0;
+}
+
+inline bool WireSameBits(float a, float b) {
+    return memcmp(&a, &b, sizeof(float)) == 0;
+}
+
+/**
+ * Fill a wire struct from ${state.cpp} (padding and unused entries zeroed)
+ */
+inline void EncodeWire(const ${state.cpp}& state, ${wireName}& out) {
+    memset(&out, 0, sizeof(out));
+    out.magic = kWireMagic;
+    out.version = kWireVersion;
+    out.size = static_cast<uint16_t>(sizeof(${wireName}));`)
+  for (const s of stateSlots) {
+    if (s.kind === "count") continue
+    if (s.kind !== "array") {
+      out.push(`    ${cppEncode(s, "out")}`)
+      continue
+    }
+    out.push(`
+    size_t ${s.name}Count = std::min<size_t>(state.${s.cpp.count}, kWireMax${capitalize(s.name)});
+    out.${s.name}Count = static_cast<${s.count < 256 ? "uint8_t" : "uint16_t"}>(${s.name}Count);
+    for (size_t i = 0; i < ${s.name}Count; i++) {
+        const auto& item = state.${s.cpp.item};
+        ${s.wire}& entry = out.${s.name}[i];`)
+    for (const e of s.elementLayout.schemaOrder) out.push(`        ${cppEncode(e, "entry")}`)
+    out.push("    }")
+  }
+  out.push(`}
+
+/**
+ * Use a received buffer in place
+ *
+ * @return The buffer as a wire struct, or nullptr if it is too short,
+ *         misaligned, or has the wrong magic, version, size or counts
+ */
+inline const ${wireName}* ViewWire(const void* data, size_t size) {
+    if (size < sizeof(${wireName})) return nullptr;
+    if (reinterpret_cast<uintptr_t>(data) % alignof(${wireName}) != 0) return nullptr;
+    const ${wireName}* wire = static_cast<const ${wireName}*>(data);
+    if (wire->magic != kWireMagic || wire->version != kWireVersion || wire->size != sizeof(${wireName})) return nullptr;`)
+  for (const a of arrays) {
+    out.push(`    if (wire->${a.name}Count > kWireMax${capitalize(a.name)}) return nullptr;`)
+  }
+  out.push(`    return wire;
+}
+
+/**
+ * True if the wire struct holds exactly what EncodeWire(state) would write
+ * (floats compared bitwise, strings after truncation)
+ */
+inline bool WireMatches(const ${wireName}& wire, const ${state.cpp}& state) {`)
+  const scalars = stateSlots.filter((s) => s.kind !== "count" && s.kind !== "array")
+  out.push(`    if (!(${scalars.map((s) => cppMatch(s, "wire")).join(" &&\n          ")})) {\n        return false;\n    }`)
+  for (const a of arrays) {
+    out.push(`
+    size_t ${a.name}Count = std::min<size_t>(state.${a.cpp.count}, kWireMax${capitalize(a.name)});
+    if (wire.${a.name}Count != ${a.name}Count) return false;
+    for (size_t i = 0; i < ${a.name}Count; i++) {
+        const auto& item = state.${a.cpp.item};
+        const ${a.wire}& entry = wire.${a.name}[i];
+        if (!(${a.elementLayout.schemaOrder.map((e) => cppMatch(e, "entry")).join(" &&\n              ")})) {
+            return false;
+        }
+    }`)
+  }
+  out.push(`    return true;
+}
+
+} // namespace ui
+`)
+  return out.join("\n")
+}
+
+// --- Field diff ----------------------------------------------------------------
+
+const hex = (value) => `0x${value.toString(16).toUpperCase()}ull`
+
+function cppDiffHeader() {
+  // One change bit per leaf field, in schema order; an array and its count share a bit
+  const fields = stateSlots.filter((s) => s.kind !== "count")
+  if (fields.length > 32) fail("more than 32 diffable fields")
+  const countOf = (a) => wire.slots.find((s) => s.name === `${a.name}Count`)
+  const bitName = (s) => `WireField_${capitalize(s.name)}`
+  const numeric = fields.filter((s) => s.kind === "prim" && (s.field.type === "f32" || s.field.type === "i32"))
+
+  // Scalar members live after the arrays; compare them as whole 16-byte blocks
+  // ending at the struct's end, one mask bit per byte
+  const scalarStart = Math.min(...wire.slots.filter((s) => s.kind !== "array").map((s) => s.offset))
+  const blocks = Math.ceil((wire.size - scalarStart) / 16)
+  const base = wire.size - blocks * 16
+  if (blocks > 4 || base < 0) fail("scalar members do not fit a 64-byte diff window")
+  const byteMask = (s) => hex(((1n << BigInt(s.size * s.count)) - 1n) << BigInt(s.offset - base))
+
+  const out = []
+  out.push(`#pragma once
+
+// ${notice}
+
+#include "state_wire.h"
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define UI_WIRE_DIFF_SSE2 1
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#define UI_WIRE_DIFF_NEON 1
+#endif
+
+namespace ui {
+
+/**
+ * Field-level diff of two ${wireName} snapshots
+ *
+ * DiffWire() returns a WireField mask of the members that differ, so
+ * recorders, bridges and dirty-rect rendering share one comparison instead of
+ * each walking ${state.cpp}. The scalar members are compared as ${blocks} SIMD blocks
+ * giving a per-byte change mask, which is then tested against each member's
+ * byte range; arrays are compared only over their used entries (EncodeWire()
+ * zeroes the rest). ApplyWirePatch() copies the masked members.
+ *
+ * @code
+ *   ui::WireVehicleState last, next;            // last = what consumers have seen
+ *   ui::EncodeWire(state, next);
+ *   uint32_t changed = ui::DiffWire(last, next, &deadbands);
+ *   if (changed) { Send(next, changed); ui::ApplyWirePatch(last, next, changed); }
+ * @endcode
+ */
+
+enum WireField : uint32_t {`)
+  const width = Math.max(...fields.map((s) => bitName(s).length))
+  fields.forEach((s, i) => out.push(`    ${bitName(s).padEnd(width)} = 1u << ${i},`))
+  out.push(`    ${"WireField_All".padEnd(width)} = (1u << ${fields.length}) - 1,
+};
+
+constexpr int kWireFieldCount = ${fields.length};
+
+// Members WireDeadbands applies to
+constexpr uint32_t kWireDeadbandFields = ${numeric.map(bitName).join(" |\n                                         ")};
+
+// Schema path of each WireField bit (index = bit position)
+constexpr const char* kWireFieldNames[kWireFieldCount] = {`)
+  for (const s of fields) out.push(`    "${s.ts.join(".")}",`)
+  out.push(`};
+
+/**
+ * Per-field change thresholds for DiffWire()
+ *
+ * A numeric member counts as changed only when it moved by more than its
+ * deadband; 0 (the default) reports any change. Diff against the last
+ * reported snapshot, not the previous frame, so slow drifts still surface.
+ */
+struct WireDeadbands {`)
+  for (const s of numeric) out.push(`    float ${s.name} = 0.0f;`)
+  out.push(`};
+
+/**
+ * Deadbands declared in the schema (half the displayed resolution)
+ */
+inline WireDeadbands SchemaDeadbands() {
+    WireDeadbands deadbands;`)
+  for (const s of numeric.filter((s) => s.field.deadband)) out.push(`    deadbands.${s.name} = ${s.field.deadband}f;`)
+  out.push(`    return deadbands;
+}
+
+namespace wire_diff {
+
+// Bit i set if byte i of the two 16-byte blocks differs
+inline uint32_t ByteDiffMask16(const uint8_t* a, const uint8_t* b) {
+#if defined(UI_WIRE_DIFF_SSE2)
+    __m128i equal = _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(a)),
+                                   _mm_loadu_si128(reinterpret_cast<const __m128i*>(b)));
+    return ~static_cast<uint32_t>(_mm_movemask_epi8(equal)) & 0xFFFFu;
+#elif defined(UI_WIRE_DIFF_NEON)
+    static const uint8_t kBits[16] = { 1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128 };
+    uint8x16_t differ = vmvnq_u8(vceqq_u8(vld1q_u8(a), vld1q_u8(b)));
+    uint8x16_t bits = vandq_u8(differ, vld1q_u8(kBits));
+    return static_cast<uint32_t>(vaddv_u8(vget_low_u8(bits))) |
+           static_cast<uint32_t>(vaddv_u8(vget_high_u8(bits))) << 8;
+#else
+    uint32_t mask = 0;
+    for (int i = 0; i < 16; i++) mask |= static_cast<uint32_t>(a[i] != b[i]) << i;
+    return mask;
+#endif
+}
+
+// a[0..32) XOR b[0..32), folded into one block
+#if defined(UI_WIRE_DIFF_SSE2)
+inline __m128i Xor32(const uint8_t* a, const uint8_t* b) {
+    __m128i lo = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(a)),
+                               _mm_loadu_si128(reinterpret_cast<const __m128i*>(b)));
+    __m128i hi = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(a + 16)),
+                               _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + 16)));
+    return _mm_or_si128(lo, hi);
+}
+#elif defined(UI_WIRE_DIFF_NEON)
+inline uint8x16_t Xor32(const uint8_t* a, const uint8_t* b) {
+    return vorrq_u8(veorq_u8(vld1q_u8(a), vld1q_u8(b)), veorq_u8(vld1q_u8(a + 16), vld1q_u8(b + 16)));
+}
+#endif`)
+  for (const a of fields.filter((s) => s.kind === "array")) {
+    if (a.size % 32 !== 0) throw new Error(`${a.wire}: ${a.size} bytes is not a whole number of 32-byte steps`)
+    const lanes = a.size / 32
+    const ids = [...Array(lanes).keys()]
+    const fn = `${capitalize(a.name)}Equal`
+    out.push(`
+// The first count entries of both arrays are equal. Each ${a.size}-byte entry
+// is read as ${lanes} steps of 32 bytes, one accumulator per step, so the ORs
+// within an entry do not wait on each other; one test at the end.
+inline bool ${fn}(const ${a.wire}* a, const ${a.wire}* b, size_t count) {
+    const uint8_t* pa = reinterpret_cast<const uint8_t*>(a);
+    const uint8_t* pb = reinterpret_cast<const uint8_t*>(b);
+#if defined(UI_WIRE_DIFF_SSE2)
+${ids.map((k) => `    __m128i differ${k} = _mm_setzero_si128();`).join("\n")}
+    for (size_t i = 0; i < count; i++, pa += ${a.size}, pb += ${a.size}) {
+${ids.map((k) => `        differ${k} = _mm_or_si128(differ${k}, Xor32(pa + ${k * 32}, pb + ${k * 32}));`).join("\n")}
+    }
+    __m128i differ = ${ids.slice(1).reduce((acc, k) => `_mm_or_si128(${acc}, differ${k})`, "differ0")};
+    return _mm_movemask_epi8(_mm_cmpeq_epi8(differ, _mm_setzero_si128())) == 0xFFFF;
+#elif defined(UI_WIRE_DIFF_NEON)
+${ids.map((k) => `    uint8x16_t differ${k} = vdupq_n_u8(0);`).join("\n")}
+    for (size_t i = 0; i < count; i++, pa += ${a.size}, pb += ${a.size}) {
+${ids.map((k) => `        differ${k} = vorrq_u8(differ${k}, Xor32(pa + ${k * 32}, pb + ${k * 32}));`).join("\n")}
+    }
+    return vmaxvq_u8(${ids.slice(1).reduce((acc, k) => `vorrq_u8(${acc}, differ${k})`, "differ0")}) == 0;
+#else
+    return memcmp(pa, pb, count * ${a.size}) == 0;
+#endif
+}`)
+  }
+  out.push(`
+} // namespace wire_diff
+
+/**
+ * Members of next that differ from base
+ *
+ * @param deadbands Optional thresholds for numeric members (nullptr = exact)
+ * @return WireField mask; 0 if nothing changed
+ */
+inline uint32_t DiffWire(const ${wireName}& base, const ${wireName}& next, const WireDeadbands* deadbands = nullptr) {
+    const uint8_t* a = reinterpret_cast<const uint8_t*>(&base);
+    const uint8_t* b = reinterpret_cast<const uint8_t*>(&next);
+
+    // Bytes [${base}, ${wire.size}) hold every scalar member
+    uint64_t bytes = 0;
+    for (int block = 0; block < ${blocks}; block++) {
+        bytes |= static_cast<uint64_t>(wire_diff::ByteDiffMask16(a + ${base} + block * 16, b + ${base} + block * 16)) << (block * 16);
+    }
+
+    uint32_t changed = 0;`)
+  out.push(`    // Branch-free: which members changed varies frame to frame, and
+    // mispredicted branches here cost more than the SIMD compare itself`)
+  for (const s of fields) {
+    if (s.kind === "array") continue
+    out.push(`    changed |= static_cast<uint32_t>((bytes & ${byteMask(s)}) != 0) * ${bitName(s)};`)
+  }
+  for (const a of fields.filter((s) => s.kind === "array")) {
+    out.push(`    if ((bytes & ${byteMask(countOf(a))}) ||
+        !wire_diff::${capitalize(a.name)}Equal(base.${a.name}, next.${a.name}, base.${a.name}Count)) {
+        changed |= ${bitName(a)};
+    }`)
+  }
+  out.push(`
+    if (deadbands && (changed & kWireDeadbandFields)) {`)
+  for (const s of numeric) {
+    const delta = s.field.type === "f32"
+      ? `next.${s.name} - base.${s.name}`
+      : `static_cast<float>(next.${s.name}) - static_cast<float>(base.${s.name})`
+    out.push(`        if ((changed & ${bitName(s)}) && deadbands->${s.name} > 0.0f &&
+            std::fabs(${delta}) <= deadbands->${s.name}) {
+            changed &= ~${bitName(s)};
+        }`)
+  }
+  out.push(`    }
+    return changed;
+}
+
+/**
+ * Copy the members in fields from source into target
+ */
+inline void ApplyWirePatch(${wireName}& target, const ${wireName}& source, uint32_t fields) {`)
+  for (const s of fields) {
+    if (s.kind === "array") {
+      out.push(`    if (fields & ${bitName(s)}) {
+        target.${s.name}Count = source.${s.name}Count;
+        memcpy(target.${s.name}, source.${s.name}, sizeof(target.${s.name}));
+    }`)
+    } else if (s.kind === "string") {
+      out.push(`    if (fields & ${bitName(s)}) memcpy(target.${s.name}, source.${s.name}, sizeof(target.${s.name}));`)
+    } else {
+      out.push(`    if (fields & ${bitName(s)}) target.${s.name} = source.${s.name};`)
+    }
+  }
+  out.push(`}
+
+} // namespace ui
+`)
+  return out.join("\n")
+}
+
+// --- TypeScript ----------------------------------------------------------------
+
+const tsEnumName = (e) => e.name
+const tsLiteral = (v) => (v === null ? "null" : JSON.stringify(v))
+const tableName = (e) => constantCase(plural(e.name))
+
+function tsFieldType(f, indent) {
+  const kind = classify(f)
+  if (kind === "enum") return tsEnumName(enums.get(f.type))
+  if (kind === "prim" || kind === "string") return primitives[f.type].ts
+  const body = tsObject(structs.get(f.type).fields, indent)
+  return kind === "array" ? `Array<${body}>` : body
+}
+
+function tsObject(fields, indent) {
+  const lines = fields.map((f) => `${indent}  ${f.name}: ${tsFieldType(f, indent + "  ")}`)
+  return `{\n${lines.join("\n")}\n${indent}}`
+}
+
+function tsTypes() {
+  const out = [`// ${notice}`, ""]
+  for (const e of schema.enums) {
+    const literals = [...e.values.filter((v) => v.ts !== null), ...e.values.filter((v) => v.ts === null)]
+    out.push(`export type ${tsEnumName(e)} = ${literals.map((v) => tsLiteral(v.ts)).join(" | ")}`)
+  }
+  out.push("", "// Index = C++ enum value (wire and stream encodings)")
+  for (const e of schema.enums) {
+    out.push(`export const ${tableName(e)}: readonly ${tsEnumName(e)}[] = [${e.values.map((v) => tsLiteral(v.ts)).join(", ")}]`)
+  }
+  const fields = state.fields.map((f) => `  ${f.name}: ${tsFieldType(f, "  ")}`)
+  out.push("", `export interface ${state.name} {`, ...fields, "}", "")
+  return out.join("\n")
+}
+
+function tsRead(slot, base) {
+  const at = slot.offset ? `${base} + ${slot.offset}` : base
+  switch (slot.kind) {
+    case "string": return `readText(view, ${at}, ${slot.count})`
+    case "enum": {
+      const e = enums.get(slot.field.type)
+      const fallback = tsLiteral(e.values[0].ts)
+      return `${tableName(e)}[view.getUint8(${at})] ?? ${fallback}`
+    }
+    default:
+      if (slot.field.type === "bool") return `view.getUint8(${at}) !== 0`
+      if (slot.field.type === "i64") return `view.getUint32(${at}, true) + view.getInt32(${at} + 4, true) * 4294967296`
+      return `view.get${primitives[slot.field.type].view}(${at}${primitives[slot.field.type].size > 1 ? ", true" : ""})`
+  }
+}
+
+// Object literal for fields, reading slots by their ts path
+function tsLiteralFor(fields, slots, path, base, indent) {
+  const lines = fields.map((f) => {
+    const kind = classify(f)
+    const fieldPath = [...path, f.name].join(".")
+    if (kind === "struct") {
+      return `${indent}  ${f.name}: ${tsLiteralFor(structs.get(f.type).fields, slots, [...path, f.name], base, indent + "  ")},`
+    }
+    if (kind === "array") return `${indent}  ${f.name},`
+    const slot = slots.find((s) => s.ts && s.ts.join(".") === fieldPath)
+    return `${indent}  ${f.name}: ${tsRead(slot, base)},`
+  })
+  return `{\n${lines.join("\n")}\n${indent}}`
+}
+
+function tsWire() {
+  const arrays = stateSlots.filter((s) => s.kind === "array")
+  const enumImports = schema.enums.map(tableName)
+  const out = [`// ${notice}
+
+import { ${[...enumImports].sort().join(", ")}, type ${state.name} } from "./types"
+
+/**
+ * In-place reader for the fixed-layout wire struct (ui_imgui/state_wire.h)
+ *
+ * Works on any DataView (WebSocket ArrayBuffer, fetched file, SharedArrayBuffer)
+ * without copying the buffer; only the returned object is allocated.
+ */
+
+export const WIRE_MAGIC = 0x${Buffer.from("VST1").readUInt32LE(0).toString(16).toUpperCase()}
+export const WIRE_VERSION = ${schema.wireVersion}
+export const WIRE_SIZE = ${wire.size}
+
+const utf8 = new TextDecoder()
+
+function readText(view: DataView, offset: number, capacity: number): string {
+  const bytes = new Uint8Array(view.buffer, view.byteOffset + offset, capacity)
+  const end = bytes.indexOf(0)
+  return utf8.decode(end < 0 ? bytes : bytes.subarray(0, end))
+}
+
+/**
+ * Read one ${state.name} at byteOffset; throws on a bad header
+ */
+export function readVehicleWire(view: DataView, byteOffset = 0): ${state.name} {
+  if (
+    view.byteLength - byteOffset < WIRE_SIZE ||
+    view.getUint32(byteOffset, true) !== WIRE_MAGIC ||
+    view.getUint16(byteOffset + 4, true) !== WIRE_VERSION ||
+    view.getUint16(byteOffset + 6, true) !== WIRE_SIZE
+  ) {
+    throw new Error("vehicle wire: bad header")
+  }
+`]
+  for (const a of arrays) {
+    const countSlot = wire.slots.find((s) => s.name === `${a.name}Count`)
+    const countRead = countSlot.size === 1 ? `view.getUint8(byteOffset + ${countSlot.offset})` : `view.getUint16(byteOffset + ${countSlot.offset}, true)`
+    out.push(`  const ${a.name}: ${state.name}["${a.field.name}"] = []
+  const ${a.name}Count = Math.min(${countRead}, ${a.count})
+  for (let i = 0; i < ${a.name}Count; i++) {
+    const base = byteOffset + ${a.offset} + i * ${a.size}
+    ${a.name}.push(${tsLiteralFor(a.element.fields, a.elementLayout.slots, [], "base", "    ")})
+  }
+`)
+  }
+  out.push(`  return ${tsLiteralFor(state.fields, stateSlots, [], "byteOffset", "  ")}
+}
+`)
+  return out.join("\n")
+}
+
+// --- Output --------------------------------------------------------------------
+
+const outputs = new Map()
+for (const header of ["state.h", "fault.h"]) {
+  const file = `ui_imgui/${header}`
+  outputs.set(file, replaceRegion(readFileSync(join(root, file), "utf8"), cppRegion(header), file))
+}
+outputs.set("ui_imgui/state_wire.h", cppWireHeader())
+outputs.set("ui_imgui/state_diff.h", cppDiffHeader())
+outputs.set("lib/types.ts", tsTypes())
+outputs.set("lib/vehicle-wire.ts", tsWire())
+
+const check = process.argv.includes("--check")
+const stale = []
+for (const [file, text] of outputs) {
+  let current = null
+  try {
+    current = readFileSync(join(root, file), "utf8")
+  } catch {}
+  if (current === text) continue
+  stale.push(file)
+  if (!check) writeFileSync(join(root, file), text)
+}
+
+if (check && stale.length) fail(`out of date: ${stale.join(", ")} (run npm run gen:state)`)
+console.log(stale.length ? `gen-state: wrote ${stale.join(", ")}` : "gen-state: up to date")
@@ -0,0 +1,267 @@
+#include "arena_alloc.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace ui {
+
+// In front of every arena block: which class it goes back to. 16 bytes, so
+// the payload keeps malloc's 16-byte alignment. Blocks that fall through to
+// malloc are plain malloc blocks with no header.
+struct alignas(16) BlockHeader {
+    ArenaAllocator* owner;
+    uint32_t sizeClass;
+    uint32_t magic;
+};
+static_assert(sizeof(BlockHeader) == 16, "block header must keep 16-byte alignment");
+
+static constexpr uint32_t kBlockMagic = 0xa110c8edu;
+
+static std::atomic<ArenaAllocator*> g_globalArena{nullptr};
+
+// Address ranges of the live (and retired) arenas, so Free can tell an
+// arena block from a malloc block before reading anything in front of it.
+// A retired range belongs to an arena destroyed with blocks outstanding: its
+// memory is never released, and frees into it are dropped.
+struct ArenaRange {
+    std::atomic<const unsigned char*> base{nullptr};   // nullptr = free slot
+    std::atomic<size_t> size{0};
+    std::atomic<ArenaAllocator*> owner{nullptr};       // nullptr = retired
+};
+
+static constexpr int kMaxArenas = 8;
+static ArenaRange g_ranges[kMaxArenas];
+static std::atomic_flag g_rangesLock = ATOMIC_FLAG_INIT;   // Writers only; no destructor to run at exit
+
+static void LockRanges() {
+    while (g_rangesLock.test_and_set(std::memory_order_acquire)) {
+    }
+}
+
+static void UnlockRanges() {
+    g_rangesLock.clear(std::memory_order_release);
+}
+
+static ArenaRange* FindRange(const void* ptr) {
+    const unsigned char* p = static_cast<const unsigned char*>(ptr);
+    for (ArenaRange& range : g_ranges) {
+        const unsigned char* base = range.base.load(std::memory_order_acquire);
+        if (base && p >= base && p < base + range.size.load(std::memory_order_relaxed)) return &range;
+    }
+    return nullptr;
+}
+
+static BlockHeader* HeaderOf(void* ptr) {
+    return reinterpret_cast<BlockHeader*>(static_cast<unsigned char*>(ptr) - sizeof(BlockHeader));
+}
+
+// Smallest class whose blocks hold size bytes plus the header; -1 = too large
+static int ClassFor(size_t size) {
+    size_t total = size + sizeof(BlockHeader);
+    int shift = ArenaAllocator::kMinClassShift;
+    while (shift <= ArenaAllocator::kMaxClassShift && (static_cast<size_t>(1) << shift) < total) shift++;
+    return shift <= ArenaAllocator::kMaxClassShift ? shift - ArenaAllocator::kMinClassShift : -1;
+}
+
+ArenaAllocator::ArenaAllocator(size_t arenaBytes) {
+    size_ = arenaBytes & ~static_cast<size_t>(15);
+    base_ = size_ > 0 ? static_cast<unsigned char*>(aligned_alloc(64, (size_ + 63) & ~static_cast<size_t>(63)))
+                      : nullptr;
+    if (!base_) {
+        size_ = 0;
+        return;
+    }
+
+    LockRanges();
+    for (int slot = 0; slot < kMaxArenas; slot++) {
+        ArenaRange& range = g_ranges[slot];
+        if (range.base.load(std::memory_order_relaxed)) continue;
+        range.size.store(size_, std::memory_order_relaxed);
+        range.owner.store(this, std::memory_order_relaxed);
+        range.base.store(base_, std::memory_order_release);
+        rangeSlot_ = slot;
+        break;
+    }
+    UnlockRanges();
+
+    if (rangeSlot_ < 0) {
+        // Every slot taken: serve everything from malloc
+        fprintf(stderr, "arena: more than %d arenas, falling back to malloc\n", kMaxArenas);
+        free(base_);
+        base_ = nullptr;
+        size_ = 0;
+        return;
+    }
+    // Touch every page now rather than on first use
+    memset(base_, 0, size_);
+}
+
+ArenaAllocator::~ArenaAllocator() {
+    // Stop routing allocations here first
+    ArenaAllocator* self = this;
+    g_globalArena.compare_exchange_strong(self, nullptr);
+    if (rangeSlot_ < 0) return;
+
+    ArenaRange& range = g_ranges[rangeSlot_];
+    LockRanges();
+    range.owner.store(nullptr, std::memory_order_release);
+    bool idle = outstanding_.load(std::memory_order_acquire) == 0;
+    if (idle) range.base.store(nullptr, std::memory_order_release);
+    UnlockRanges();
+
+    if (idle) {
+        free(base_);
+    } else {
+        // A static arena dies before statics that still hold its blocks; keep
+        // the memory so their later frees stay valid
+        fprintf(stderr, "arena: destroyed with %lld blocks outstanding, leaking %zu bytes\n",
+                static_cast<long long>(outstanding_.load()), size_);
+    }
+}
+
+void* ArenaAllocator::Carve(size_t blockSize) {
+    if (used_.load(std::memory_order_relaxed) >= size_) return nullptr;
+    size_t offset = used_.fetch_add(blockSize, std::memory_order_relaxed);
+    if (offset + blockSize > size_) return nullptr;   // The tail stays unused
+    return base_ + offset;
+}
+
+void* ArenaAllocator::HeapBlock(size_t size) {
+    totals_.heap.fetch_add(1, std::memory_order_relaxed);
+    if (sealed_.load(std::memory_order_relaxed) &&
+        heapSinceSeal_.fetch_add(1, std::memory_order_relaxed) == 0) {
+        fprintf(stderr, "arena: malloc after warm-up (%zu bytes, arena %zu/%zu used)\n", size, GetArenaUsed(),
+                size_);
+    }
+    return malloc(size);
+}
+
+void* ArenaAllocator::Allocate(size_t size) {
+    totals_.allocations.fetch_add(1, std::memory_order_relaxed);
+    totals_.bytes.fetch_add(size, std::memory_order_relaxed);
+
+    int sizeClass = ClassFor(size);
+    if (sizeClass < 0) return HeapBlock(size);
+
+    void* block = nullptr;
+    {
+        SizeClass& pool = classes_[sizeClass];
+        std::lock_guard<std::mutex> lock(pool.mutex);
+        if (pool.head) {
+            block = pool.head;
+            pool.head = pool.head->next;
+        }
+    }
+    if (!block) {
+        block = Carve(static_cast<size_t>(1) << (sizeClass + kMinClassShift));
+        if (!block) return HeapBlock(size);
+        totals_.carved.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    outstanding_.fetch_add(1, std::memory_order_relaxed);
+    BlockHeader* header = static_cast<BlockHeader*>(block);
+    header->owner = this;
+    header->sizeClass = static_cast<uint32_t>(sizeClass);
+    header->magic = kBlockMagic;
+    return header + 1;
+}
+
+void ArenaAllocator::Release(void* block, int sizeClass) {
+    totals_.frees.fetch_add(1, std::memory_order_relaxed);
+    outstanding_.fetch_sub(1, std::memory_order_relaxed);
+    FreeBlock* node = static_cast<FreeBlock*>(block);
+    SizeClass& pool = classes_[sizeClass];
+    std::lock_guard<std::mutex> lock(pool.mutex);
+    node->next = pool.head;
+    pool.head = node;
+}
+
+void ArenaAllocator::Free(void* ptr) {
+    if (!ptr) return;
+
+    // Outside every arena: malloc fallback, or allocated before the hooks
+    // were installed
+    ArenaRange* range = FindRange(ptr);
+    if (!range) {
+        free(ptr);
+        return;
+    }
+
+    ArenaAllocator* owner = range->owner.load(std::memory_order_acquire);
+    if (!owner) return;   // Retired arena: the memory is never reused
+
+    BlockHeader* header = HeaderOf(ptr);
+    if (header->magic != kBlockMagic || header->owner != owner ||
+        header->sizeClass >= static_cast<uint32_t>(kClassCount)) {
+        fprintf(stderr, "arena: bad free of %p (double free or not a block start)\n", ptr);
+        return;
+    }
+    header->magic = 0;
+    owner->Release(header, static_cast<int>(header->sizeClass));
+}
+
+ArenaAllocStats ArenaAllocator::GetTotals() const {
+    ArenaAllocStats stats;
+    stats.allocations = totals_.allocations.load(std::memory_order_relaxed);
+    stats.frees = totals_.frees.load(std::memory_order_relaxed);
+    stats.bytes = totals_.bytes.load(std::memory_order_relaxed);
+    stats.carved = totals_.carved.load(std::memory_order_relaxed);
+    stats.heap = totals_.heap.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void ArenaAllocator::BeginFrame() {
+    frameStart_ = GetTotals();
+}
+
+ArenaAllocStats ArenaAllocator::GetFrameStats() const {
+    ArenaAllocStats now = GetTotals();
+    now.allocations -= frameStart_.allocations;
+    now.frees -= frameStart_.frees;
+    now.bytes -= frameStart_.bytes;
+    now.carved -= frameStart_.carved;
+    now.heap -= frameStart_.heap;
+    return now;
+}
+
+void ArenaAllocator::Seal() {
+    heapSinceSeal_.store(0, std::memory_order_relaxed);
+    sealed_.store(true, std::memory_order_relaxed);
+}
+
+size_t ArenaAllocator::GetOutstanding() const {
+    int64_t outstanding = outstanding_.load(std::memory_order_relaxed);
+    return outstanding > 0 ? static_cast<size_t>(outstanding) : 0;
+}
+
+size_t ArenaAllocator::GetArenaUsed() const {
+    size_t used = used_.load(std::memory_order_relaxed);
+    return used < size_ ? used : size_;
+}
+
+void* ArenaAllocator::ImGuiAlloc(size_t size, void* userData) {
+    return static_cast<ArenaAllocator*>(userData)->Allocate(size);
+}
+
+void ArenaAllocator::ImGuiFree(void* ptr, void* /*userData*/) {
+    Free(ptr);
+}
+
+void ArenaAllocator::SetGlobal(ArenaAllocator* arena) {
+    g_globalArena.store(arena, std::memory_order_release);
+}
+
+ArenaAllocator* ArenaAllocator::GetGlobal() {
+    return g_globalArena.load(std::memory_order_acquire);
+}
+
+void* ArenaNew(size_t size) {
+    ArenaAllocator* arena = ArenaAllocator::GetGlobal();
+    return arena ? arena->Allocate(size) : malloc(size);
+}
+
+void ArenaDelete(void* ptr) {
+    ArenaAllocator::Free(ptr);
+}
+
+} // namespace ui
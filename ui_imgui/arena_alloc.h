@@ -0,0 +1,157 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+namespace ui {
+
+/**
+ * Allocation counters (totals, or one frame's worth from GetFrameStats())
+ */
+struct ArenaAllocStats {
+    uint64_t allocations = 0;       // Allocate() calls
+    uint64_t frees = 0;             // Blocks returned to the pools
+    uint64_t bytes = 0;             // Requested bytes
+    uint64_t carved = 0;            // Blocks cut from the arena (size class was empty)
+    uint64_t heap = 0;              // Fell through to malloc (arena exhausted or block too large)
+};
+
+/**
+ * Preallocated arena with power-of-two size-class pools
+ *
+ * Heap allocation on the RT kernel shows up as frame latency spikes. The
+ * allocator takes one block of memory up front (touched, so no page faults
+ * later) and serves every request from a free list per size class, 32 B to
+ * 4 MB; an empty class cuts a new block from the arena with a pointer bump.
+ * Freed blocks go back to their class, never to the system. Only when the
+ * arena is exhausted, or for requests over 4 MB, does it call malloc, and
+ * those calls are counted separately. Free() checks the pointer against
+ * the arenas' address ranges before reading the block header; anything
+ * outside them is a plain malloc block and goes to free().
+ *
+ * Destroying an arena stops routing ArenaNew() through it. If blocks are
+ * still outstanding (a static arena destroyed before statics that hold its
+ * blocks), its memory is deliberately leaked so their frees stay valid.
+ *
+ * Hooked up as ImGui's allocator (ImGuiAlloc / ImGuiFree, before
+ * CreateContext) and, by linking arena_operators.cpp, as global operator
+ * new / delete, so std::string copies in Fault and std::vector growth in the
+ * state containers come from the same pools. Thread-safe: ParallelDraw
+ * workers grow their draw lists through it. Each size class has its own
+ * lock, held for a list push or pop.
+ *
+ * Per-frame counters (BeginFrame / GetFrameStats) show what a frame
+ * allocates. After warm-up, Seal() starts counting malloc calls separately.
+ * A run whose steady state is allocation-free ends with
+ * GetHeapSinceSeal() == 0, and the first offender is logged to stderr.
+ *
+ * @code
+ *   static ui::ArenaAllocator arena(32 << 20);
+ *   ui::InstallImGuiAllocator(arena);               // Before ImGui::CreateContext()
+ *   ui::ArenaAllocator::SetGlobal(&arena);          // operator new, with arena_operators.cpp
+ *
+ *   // ... warm-up frames ...
+ *   arena.Seal();
+ *
+ *   // Each frame:
+ *   arena.BeginFrame();
+ *   // ... NewFrame / RenderUI / Render ...
+ *   ui::ArenaAllocStats frame = arena.GetFrameStats();
+ * @endcode
+ */
+class ArenaAllocator {
+public:
+    static constexpr int kMinClassShift = 5;        // 32 B blocks (16 B header + 16 B)
+    static constexpr int kMaxClassShift = 22;       // 4 MB
+    static constexpr int kClassCount = kMaxClassShift - kMinClassShift + 1;
+
+    explicit ArenaAllocator(size_t arenaBytes = static_cast<size_t>(32) << 20);
+    ~ArenaAllocator();
+
+    ArenaAllocator(const ArenaAllocator&) = delete;
+    ArenaAllocator& operator=(const ArenaAllocator&) = delete;
+
+    /**
+     * @return 16-byte aligned block of at least size bytes (nullptr only if
+     *         malloc itself failed)
+     */
+    void* Allocate(size_t size);
+
+    /**
+     * Return a block from any ArenaAllocator, ArenaNew() or malloc; nullptr
+     * is ignored
+     */
+    static void Free(void* ptr);
+
+    /** Start a frame's counters */
+    void BeginFrame();
+
+    /** Counters since BeginFrame() */
+    ArenaAllocStats GetFrameStats() const;
+    ArenaAllocStats GetTotals() const;
+
+    /** Warm-up is over; from now on malloc calls count as steady-state heap use */
+    void Seal();
+    bool IsSealed() const { return sealed_.load(std::memory_order_relaxed); }
+    uint64_t GetHeapSinceSeal() const { return heapSinceSeal_.load(std::memory_order_relaxed); }
+
+    bool IsValid() const { return base_ != nullptr; }
+    size_t GetArenaSize() const { return size_; }
+    size_t GetArenaUsed() const;
+
+    /** Arena blocks allocated and not yet freed */
+    size_t GetOutstanding() const;
+
+    /** ImGuiMemAllocFunc / ImGuiMemFreeFunc, user data = the allocator */
+    static void* ImGuiAlloc(size_t size, void* userData);
+    static void ImGuiFree(void* ptr, void* userData);
+
+    /** Target of ArenaNew() (and operator new with arena_operators.cpp); nullptr = malloc */
+    static void SetGlobal(ArenaAllocator* arena);
+    static ArenaAllocator* GetGlobal();
+
+private:
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    struct SizeClass {
+        std::mutex mutex;
+        FreeBlock* head = nullptr;
+    };
+
+    struct Counters {
+        std::atomic<uint64_t> allocations{0};
+        std::atomic<uint64_t> frees{0};
+        std::atomic<uint64_t> bytes{0};
+        std::atomic<uint64_t> carved{0};
+        std::atomic<uint64_t> heap{0};
+    };
+
+    void* Carve(size_t blockSize);
+    void* HeapBlock(size_t size);
+    void Release(void* block, int sizeClass);
+
+    unsigned char* base_ = nullptr;
+    size_t size_ = 0;
+    int rangeSlot_ = -1;                            // Slot in the address-range table (-1: none)
+    std::atomic<int64_t> outstanding_{0};
+    std::atomic<size_t> used_{0};                   // Bump offset; may overshoot size_ once exhausted
+    SizeClass classes_[kClassCount];
+
+    Counters totals_;
+    ArenaAllocStats frameStart_;
+    std::atomic<bool> sealed_{false};
+    std::atomic<uint64_t> heapSinceSeal_{0};
+};
+
+/**
+ * Allocate through the global arena (plain malloc if none); ArenaDelete()
+ * frees blocks from either
+ */
+void* ArenaNew(size_t size);
+void ArenaDelete(void* ptr);
+
+} // namespace ui
@@ -0,0 +1,34 @@
+// Global operator new / delete through ArenaAllocator (arena_alloc.h)
+//
+// Link this file into an application to route every C++ allocation
+// (std::string, std::vector, ...) through ArenaAllocator::GetGlobal(), or
+// through malloc with the same block header until one is set. Over-aligned
+// types (alignas > 16) keep the library's aligned operator new.
+
+#include "arena_alloc.h"
+#include <new>
+
+void* operator new(std::size_t size) {
+    if (void* ptr = ui::ArenaNew(size)) return ptr;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+    if (void* ptr = ui::ArenaNew(size)) return ptr;
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    return ui::ArenaNew(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    return ui::ArenaNew(size);
+}
+
+void operator delete(void* ptr) noexcept { ui::ArenaDelete(ptr); }
+void operator delete[](void* ptr) noexcept { ui::ArenaDelete(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { ui::ArenaDelete(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { ui::ArenaDelete(ptr); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { ui::ArenaDelete(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { ui::ArenaDelete(ptr); }
@@ -0,0 +1,445 @@
+#include "can_log.h"
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace ui {
+
+struct HexTable {
+    int8_t value[256];
+
+    constexpr HexTable() : value() {
+        for (int i = 0; i < 256; i++) value[i] = -1;
+        for (int i = 0; i < 10; i++) value['0' + i] = static_cast<int8_t>(i);
+        for (int i = 0; i < 6; i++) {
+            value['a' + i] = static_cast<int8_t>(10 + i);
+            value['A' + i] = static_cast<int8_t>(10 + i);
+        }
+    }
+};
+
+static constexpr HexTable kHex;
+
+static constexpr uint64_t kFractionScale[10] = {
+    1000000000ull, 100000000ull, 10000000ull, 1000000ull, 100000ull, 10000ull, 1000ull, 100ull, 10ull, 1ull,
+};
+
+// linux/can.h CAN_ERR_FLAG, as candump prints it in the 8-digit identifier
+static constexpr uint32_t kCandumpErrorFlag = 0x20000000u;
+
+static inline int HexValue(char c) {
+    return kHex.value[static_cast<uint8_t>(c)];
+}
+
+static inline bool IsDigit(char c) {
+    return static_cast<unsigned>(c - '0') < 10u;
+}
+
+static inline bool IsSpace(char c) {
+    return c == ' ' || c == '\t';
+}
+
+static inline const char* SkipSpaces(const char* p, const char* end) {
+    while (p < end && IsSpace(*p)) p++;
+    return p;
+}
+
+static inline bool AtTokenEnd(const char* p, const char* end) {
+    return p == end || IsSpace(*p);
+}
+
+static bool StartsWith(const char* p, const char* end, const char* prefix) {
+    size_t length = strlen(prefix);
+    return static_cast<size_t>(end - p) >= length && memcmp(p, prefix, length) == 0;
+}
+
+static bool Contains(const char* p, const char* end, const char* needle) {
+    size_t length = strlen(needle);
+    for (; static_cast<size_t>(end - p) >= length; p++) {
+        if (memcmp(p, needle, length) == 0) return true;
+    }
+    return false;
+}
+
+// "seconds[.fraction]" to ns; fraction digits past nanoseconds are dropped
+static bool ParseSeconds(const char*& p, const char* end, uint64_t& ns) {
+    const char* start = p;
+    uint64_t seconds = 0;
+    while (p < end && IsDigit(*p)) seconds = seconds * 10 + static_cast<uint64_t>(*p++ - '0');
+    if (p == start || p - start > 12) return false;
+
+    uint64_t fraction = 0;
+    int digits = 0;
+    if (p < end && *p == '.') {
+        p++;
+        for (; p < end && IsDigit(*p); p++) {
+            if (digits < 9) {
+                fraction = fraction * 10 + static_cast<uint64_t>(*p - '0');
+                digits++;
+            }
+        }
+    }
+    ns = seconds * 1000000000ull + fraction * kFractionScale[digits];
+    return true;
+}
+
+static bool ParseNumber(const char*& p, const char* end, bool hex, uint32_t& value) {
+    const char* start = p;
+    uint32_t v = 0;
+    if (hex) {
+        int digit;
+        while (p < end && (digit = HexValue(*p)) >= 0) {
+            v = v * 16 + static_cast<uint32_t>(digit);
+            p++;
+        }
+        if (p - start > 8) return false;
+    } else {
+        while (p < end && IsDigit(*p)) v = v * 10 + static_cast<uint32_t>(*p++ - '0');
+        if (p - start > 10) return false;
+    }
+    if (p == start) return false;
+    value = v;
+    return true;
+}
+
+// Hex byte pairs with optional '.' separators; -1 on an odd digit or more than max bytes
+static int ParseHexBytes(const char*& p, const char* end, uint8_t* out, int max) {
+    int count = 0;
+    while (p < end) {
+        int hi = HexValue(p[0]);
+        if (hi < 0) {
+            if (p[0] == '.') {
+                p++;
+                continue;
+            }
+            break;
+        }
+        if (p + 1 == end || count == max) return -1;
+        int lo = HexValue(p[1]);
+        if (lo < 0) return -1;
+        out[count++] = static_cast<uint8_t>((hi << 4) | lo);
+        p += 2;
+    }
+    return count;
+}
+
+CanLogReader::~CanLogReader() {
+    Close();
+}
+
+bool CanLogReader::Open(const char* path) {
+    Close();
+
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return false;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+        close(fd);
+        return false;
+    }
+
+    size_t size = static_cast<size_t>(st.st_size);
+    void* mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED) return false;
+    madvise(mapping, size, MADV_SEQUENTIAL);
+
+    mapped_ = true;
+    if (!Start(static_cast<const char*>(mapping), size)) {
+        Close();
+        return false;
+    }
+    return true;
+}
+
+bool CanLogReader::OpenBuffer(const char* text, size_t size) {
+    Close();
+    if (!text || size == 0 || !Start(text, size)) {
+        Close();
+        return false;
+    }
+    return true;
+}
+
+void CanLogReader::Close() {
+    if (mapped_ && data_) munmap(const_cast<char*>(data_), size_);
+    data_ = nullptr;
+    size_ = 0;
+    mapped_ = false;
+    format_ = CanLogFormat::Unknown;
+    channelCount_ = 0;
+    lastChannel_ = -1;
+    Rewind();
+}
+
+bool CanLogReader::Start(const char* text, size_t size) {
+    data_ = text;
+    size_ = size;
+
+    // candump lines open with "(time)"; ASC files with a header
+    const char* p = text;
+    const char* end = text + size;
+    if (StartsWith(p, end, "\xEF\xBB\xBF")) p += 3;
+    for (int line = 0; line < 64 && p < end; line++) {
+        const char* eol = static_cast<const char*>(memchr(p, '\n', static_cast<size_t>(end - p)));
+        const char* next = eol ? eol + 1 : end;
+        if (!eol) eol = end;
+        const char* q = SkipSpaces(p, eol);
+        if (q < eol && *q != '\r') {
+            if (*q == '(') {
+                format_ = CanLogFormat::Candump;
+                break;
+            }
+            if (StartsWith(q, eol, "date ") || StartsWith(q, eol, "base ") ||
+                StartsWith(q, eol, "Begin Triggerblock") || StartsWith(q, eol, "Begin TriggerBlock")) {
+                format_ = CanLogFormat::Asc;
+                break;
+            }
+        }
+        p = next;
+    }
+
+    Rewind();
+    return format_ != CanLogFormat::Unknown;
+}
+
+void CanLogReader::Rewind() {
+    pos_ = 0;
+    frames_ = 0;
+    skipped_ = 0;
+    ascHex_ = true;
+    ascRelative_ = false;
+    ascLastNs_ = 0;
+}
+
+size_t CanLogReader::Read(CanFrame* frames, size_t max) {
+    if (!data_) return 0;
+
+    const char* p = data_ + pos_;
+    const char* end = data_ + size_;
+    size_t count = 0;
+    while (count < max && p < end) {
+        const char* eol = static_cast<const char*>(memchr(p, '\n', static_cast<size_t>(end - p)));
+        const char* next = eol ? eol + 1 : end;
+        if (!eol) eol = end;
+        if (eol > p && eol[-1] == '\r') eol--;
+
+        bool parsed = format_ == CanLogFormat::Candump ? ParseCandump(p, eol, frames[count])
+                                                       : ParseAsc(p, eol, frames[count]);
+        if (parsed) {
+            count++;
+        } else if (SkipSpaces(p, eol) != eol) {
+            skipped_++;
+        }
+        p = next;
+    }
+
+    pos_ = static_cast<size_t>(p - data_);
+    frames_ += count;
+    return count;
+}
+
+bool CanLogReader::ParseCandump(const char* p, const char* end, CanFrame& frame) {
+    // (1436509052.249713) can0 123#DEADBEEF
+    if (p == end || *p != '(') return false;
+    p++;
+    if (!ParseSeconds(p, end, frame.timeNs) || p + 1 >= end || p[0] != ')' || p[1] != ' ') return false;
+    p += 2;
+
+    const char* name = p;
+    while (p < end && *p != ' ') p++;
+    int channel = FindChannel(name, static_cast<size_t>(p - name));
+    if (channel < 0 || p == end) return false;
+    p++;
+    frame.channel = static_cast<uint8_t>(channel);
+
+    const char* idStart = p;
+    uint32_t id = 0;
+    int digit;
+    while (p < end && (digit = HexValue(*p)) >= 0) {
+        id = (id << 4) | static_cast<uint32_t>(digit);
+        p++;
+    }
+    long idDigits = p - idStart;
+    if (idDigits == 0 || idDigits > 8 || p == end || *p != '#') return false;
+    p++;
+
+    uint8_t flags = 0;
+    if (idDigits == 8) {
+        flags |= CanFrame_Extended;
+        if (id & kCandumpErrorFlag) flags |= CanFrame_Error;
+        id &= 0x1fffffffu;
+    } else if (id > 0x7ffu) {
+        return false;
+    }
+
+    int length;
+    if (p < end && *p == '#') {
+        // 123##<flags nibble><data>
+        if (p + 1 >= end || (digit = HexValue(p[1])) < 0) return false;
+        flags |= CanFrame_Fd;
+        if (digit & 1) flags |= CanFrame_Brs;
+        if (digit & 2) flags |= CanFrame_Esi;
+        p += 2;
+        length = ParseHexBytes(p, end, frame.data, 64);
+    } else if (p < end && *p == 'R') {
+        flags |= CanFrame_Remote;
+        p++;
+        length = 0;
+        if (p < end && IsDigit(*p)) length = *p++ - '0';
+        if (length > 8) return false;
+    } else {
+        length = ParseHexBytes(p, end, frame.data, 8);
+    }
+    // Newer candump versions may append a direction (" R" / " T")
+    if (length < 0 || !AtTokenEnd(p, end)) return false;
+
+    frame.id = id;
+    frame.len = static_cast<uint8_t>(length);
+    frame.flags = flags;
+    frame.reserved = 0;
+    return true;
+}
+
+bool CanLogReader::ParseAsc(const char* p, const char* end, CanFrame& frame) {
+    p = SkipSpaces(p, end);
+    if (p == end) return false;
+
+    if (!IsDigit(*p)) {
+        if (StartsWith(p, end, "base ")) {
+            ascHex_ = !Contains(p, end, "base dec");
+            ascRelative_ = Contains(p, end, "timestamps relative");
+        }
+        return false;
+    }
+
+    uint64_t timeNs;
+    if (!ParseSeconds(p, end, timeNs)) return false;
+    if (ascRelative_) timeNs += ascLastNs_;
+    ascLastNs_ = timeNs;
+    p = SkipSpaces(p, end);
+
+    // Classic:  <time> <channel> <id>[x] Rx|Tx d <dlc> <data...> [Length = ...]
+    // CAN FD:   <time> CANFD <channel> Rx|Tx <id>[x] [name] <brs> <esi> <dlc> <length> <data...> ...
+    bool fd = StartsWith(p, end, "CANFD ");
+    if (fd) p = SkipSpaces(p + 6, end);
+
+    uint32_t channel;
+    if (!ParseNumber(p, end, false, channel) || channel > 255 || !AtTokenEnd(p, end)) return false;
+    p = SkipSpaces(p, end);
+
+    uint32_t id = 0;
+    uint8_t flags = 0;
+    bool haveId = false;
+    if (!fd) {
+        if (!ParseNumber(p, end, ascHex_, id)) return false;
+        if (p < end && (*p == 'x' || *p == 'X')) {
+            flags |= CanFrame_Extended;
+            p++;
+        }
+        if (!AtTokenEnd(p, end)) return false;
+        p = SkipSpaces(p, end);
+        haveId = true;
+    }
+
+    if (!(StartsWith(p, end, "Rx") || StartsWith(p, end, "Tx")) || !AtTokenEnd(p + 2, end)) return false;
+    if (*p == 'T') flags |= CanFrame_Tx;
+    p = SkipSpaces(p + 2, end);
+
+    if (!haveId) {
+        if (!ParseNumber(p, end, ascHex_, id)) return false;
+        if (p < end && (*p == 'x' || *p == 'X')) {
+            flags |= CanFrame_Extended;
+            p++;
+        }
+        if (!AtTokenEnd(p, end)) return false;
+        p = SkipSpaces(p, end);
+    }
+    if (id > ((flags & CanFrame_Extended) ? 0x1fffffffu : 0x7ffu)) return false;
+
+    uint32_t length = 0;
+    if (fd) {
+        // The symbolic name is optional: BRS is a lone 0 / 1
+        if (p == end) return false;
+        if (!((p[0] == '0' || p[0] == '1') && AtTokenEnd(p + 1, end))) {
+            while (p < end && !IsSpace(*p)) p++;
+            p = SkipSpaces(p, end);
+        }
+        uint32_t brs, esi, dlc;
+        if (!ParseNumber(p, end, false, brs) || brs > 1) return false;
+        p = SkipSpaces(p, end);
+        if (!ParseNumber(p, end, false, esi) || esi > 1) return false;
+        p = SkipSpaces(p, end);
+        if (!ParseNumber(p, end, true, dlc) || dlc > 15) return false;
+        p = SkipSpaces(p, end);
+        if (!ParseNumber(p, end, false, length) || length > 64) return false;
+        flags |= CanFrame_Fd;
+        if (brs) flags |= CanFrame_Brs;
+        if (esi) flags |= CanFrame_Esi;
+    } else {
+        if (p == end || (*p != 'd' && *p != 'r') || !AtTokenEnd(p + 1, end)) return false;
+        bool remote = *p == 'r';
+        p = SkipSpaces(p + 1, end);
+        uint32_t dlc = 0;
+        if (remote) {
+            flags |= CanFrame_Remote;
+            if (p < end && ParseNumber(p, end, true, dlc) && dlc <= 15) length = dlc > 8 ? 8 : dlc;
+        } else {
+            if (!ParseNumber(p, end, true, dlc) || dlc > 15) return false;
+            length = dlc > 8 ? 8 : dlc;        // Classic DLC 9..15 still carries 8 bytes
+        }
+    }
+
+    bool hexData = ascHex_ || fd;
+    for (uint32_t i = 0; i < length && !(flags & CanFrame_Remote); i++) {
+        p = SkipSpaces(p, end);
+        // Bytes are two hex digits in practice; anything else takes the general path
+        int hi, lo;
+        if (hexData && end - p >= 2 && (hi = HexValue(p[0])) >= 0 && (lo = HexValue(p[1])) >= 0 &&
+            AtTokenEnd(p + 2, end)) {
+            frame.data[i] = static_cast<uint8_t>((hi << 4) | lo);
+            p += 2;
+            continue;
+        }
+        uint32_t byte;
+        if (!ParseNumber(p, end, hexData, byte) || byte > 255 || !AtTokenEnd(p, end)) return false;
+        frame.data[i] = static_cast<uint8_t>(byte);
+    }
+
+    frame.timeNs = timeNs;
+    frame.id = id;
+    frame.len = static_cast<uint8_t>(length);
+    frame.flags = flags;
+    frame.channel = static_cast<uint8_t>(channel);
+    frame.reserved = 0;
+    return true;
+}
+
+int CanLogReader::FindChannel(const char* name, size_t length) {
+    if (length == 0 || length > 64) return -1;
+    if (lastChannel_ >= 0) {
+        const ChannelName& last = channels_[lastChannel_];
+        if (last.length == length && memcmp(last.name, name, length) == 0) return lastChannel_;
+    }
+    for (int i = 0; i < channelCount_; i++) {
+        if (channels_[i].length == length && memcmp(channels_[i].name, name, length) == 0) {
+            lastChannel_ = i;
+            return i;
+        }
+    }
+    if (channelCount_ == kMaxChannels) return -1;
+    channels_[channelCount_] = { name, static_cast<uint32_t>(length) };
+    lastChannel_ = channelCount_;
+    return channelCount_++;
+}
+
+std::string CanLogReader::GetChannelName(int channel) const {
+    if (channel < 0 || channel >= channelCount_) return std::string();
+    return std::string(channels_[channel].name, channels_[channel].length);
+}
+
+} // namespace ui
@@ -0,0 +1,149 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace ui {
+
+enum CanFrameFlags : uint8_t {
+    CanFrame_Extended = 1 << 0,     // 29-bit identifier
+    CanFrame_Remote   = 1 << 1,     // RTR
+    CanFrame_Error    = 1 << 2,     // candump error frame (CAN_ERR_FLAG set in the identifier)
+    CanFrame_Fd       = 1 << 3,     // CAN FD
+    CanFrame_Brs      = 1 << 4,     // FD bit rate switch
+    CanFrame_Esi      = 1 << 5,     // FD error state indicator
+    CanFrame_Tx       = 1 << 6,     // ASC "Tx" direction
+};
+
+/**
+ * One logged CAN or CAN FD frame (80 bytes)
+ */
+struct CanFrame {
+    uint64_t timeNs;            // candump: Unix time; ASC: since the start of the measurement
+    uint32_t id;                // 11 or 29 bits, no flags
+    uint8_t len;                // Data bytes (8 max classic, 64 FD; requested length for remote frames)
+    uint8_t flags;              // CanFrameFlags
+    uint8_t channel;            // candump: interface index (GetChannelName); ASC: channel number
+    uint8_t reserved;
+    uint8_t data[64];
+};
+static_assert(sizeof(CanFrame) == 80, "CanFrame layout changed");
+
+enum class CanLogFormat : uint8_t {
+    Unknown,
+    Candump,    // candump -l / -L:  (1436509052.249713) can0 123#DEADBEEF
+    Asc         // Vector ASC:       0.010000 1  123  Rx   d 8 01 02 03 04 05 06 07 08
+};
+
+/**
+ * Streaming parser for candump and Vector ASC CAN logs
+ *
+ * Open() maps the file read-only and detects the format; Read() then walks
+ * the mapping line by line with a hand-written tokenizer and writes frames
+ * straight into the caller's array. Lines are never copied or split into
+ * strings, so a large log costs one page-in per byte and no allocation.
+ *
+ * candump: classic (123#...), remote (123#R, 123#R5), CAN FD (123##1...)
+ * and error frames; 8 hex digits mark an extended identifier. Interface
+ * names become channel indices (GetChannelName()).
+ *
+ * ASC: classic and CANFD event lines, "base hex|dec" and "timestamps
+ * absolute|relative" headers (relative times are accumulated). Other
+ * events (error frames, statistics, markers) are counted as skipped.
+ *
+ * Not thread-safe; one reader per thread.
+ *
+ * @code
+ *   ui::CanLogReader reader;
+ *   if (!reader.Open("drive.log")) return;
+ *   ui::CanFrame frames[256];
+ *   while (size_t n = reader.Read(frames, 256)) { ... }
+ * @endcode
+ */
+class CanLogReader {
+public:
+    static constexpr int kMaxChannels = 32;
+
+    CanLogReader() = default;
+    ~CanLogReader();
+
+    CanLogReader(const CanLogReader&) = delete;
+    CanLogReader& operator=(const CanLogReader&) = delete;
+
+    /**
+     * Map a log file (POSIX)
+     * @return false if it cannot be mapped, is empty, or is not a candump / ASC log
+     */
+    bool Open(const char* path);
+
+    /**
+     * Parse a log already in memory (must outlive the reader or the next Open)
+     * @return false if the text is not a candump / ASC log
+     */
+    bool OpenBuffer(const char* text, size_t size);
+
+    /**
+     * Unmap (idempotent)
+     */
+    void Close();
+
+    bool IsOpen() const { return data_ != nullptr; }
+    CanLogFormat GetFormat() const { return format_; }
+
+    /**
+     * Parse up to max frames
+     * @return Number written to frames (0 = end of log)
+     */
+    size_t Read(CanFrame* frames, size_t max);
+
+    bool Next(CanFrame& frame) { return Read(&frame, 1) == 1; }
+
+    /**
+     * Start over from the first line (channel table and counters are kept
+     * and reset respectively)
+     */
+    void Rewind();
+
+    uint64_t GetFrameCount() const { return frames_; }          // Returned since Open / Rewind
+    uint64_t GetSkippedLines() const { return skipped_; }       // Non-blank lines that were not frames
+    size_t GetOffset() const { return pos_; }                   // Bytes consumed
+    size_t GetSize() const { return size_; }
+
+    /**
+     * candump interface names in order of first appearance (ASC: none)
+     */
+    int GetChannelCount() const { return channelCount_; }
+    std::string GetChannelName(int channel) const;
+
+private:
+    struct ChannelName {
+        const char* name;       // Into the log text
+        uint32_t length;
+    };
+
+    bool Start(const char* text, size_t size);
+    bool ParseCandump(const char* p, const char* end, CanFrame& frame);
+    bool ParseAsc(const char* p, const char* end, CanFrame& frame);
+    int FindChannel(const char* name, size_t length);
+
+    const char* data_ = nullptr;
+    size_t size_ = 0;
+    size_t pos_ = 0;
+    bool mapped_ = false;
+    CanLogFormat format_ = CanLogFormat::Unknown;
+
+    // ASC header state
+    bool ascHex_ = true;
+    bool ascRelative_ = false;
+    uint64_t ascLastNs_ = 0;
+
+    ChannelName channels_[kMaxChannels] = {};
+    int channelCount_ = 0;
+    int lastChannel_ = -1;
+
+    uint64_t frames_ = 0;
+    uint64_t skipped_ = 0;
+};
+
+} // namespace ui
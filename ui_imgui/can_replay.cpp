@@ -0,0 +1,327 @@
+#include "can_replay.h"
+#include "monotonic_clock.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <thread>
+
+#include <errno.h>
+#include <linux/can.h>
+#include <linux/can/raw.h>
+#include <net/if.h>
+#include <poll.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace ui {
+
+// Sleep until this close to a frame's due time, then spin; sleeps are
+// capped so the stop flag is seen promptly
+static constexpr uint64_t kSpinNs = 1000000;
+static constexpr uint64_t kMaxSleepNs = 50000000;
+
+static constexpr size_t kSendBatch = 64;
+
+static bool Stopped(const std::atomic<bool>* stop) {
+    return stop && stop->load(std::memory_order_relaxed);
+}
+
+// false if stopped while waiting
+static bool WaitUntil(uint64_t dueNs, const std::atomic<bool>* stop) {
+    for (;;) {
+        uint64_t now = MonotonicNowNs();
+        if (now >= dueNs) return true;
+        if (Stopped(stop)) return false;
+        uint64_t remaining = dueNs - now;
+        if (remaining > kSpinNs) {
+            std::this_thread::sleep_for(std::chrono::nanoseconds(std::min(remaining - kSpinNs, kMaxSleepNs)));
+        }
+    }
+}
+
+bool ReplayCanLog(CanLogReader& reader, const CanReplayOptions& options, CanFrameSink sink, void* userData,
+                  CanReplayStats* stats, const std::atomic<bool>* stop) {
+    CanReplayStats local;
+    CanReplayStats& s = stats ? *stats : local;
+    s = CanReplayStats();
+    if (!reader.IsOpen() || !sink) return false;
+
+    size_t batch = options.batchFrames > 0 ? options.batchFrames : 1;
+    std::vector<CanFrame> frames(batch);
+    bool timed = options.speed > 0.0;
+    uint64_t start = MonotonicNowNs();
+    bool ok = true;
+    bool stopped = false;
+
+    for (int pass = 0; ok && !stopped && (options.loops <= 0 || pass < options.loops); pass++) {
+        reader.Rewind();
+        bool first = true;
+        uint64_t logStartNs = 0;
+        uint64_t wallStartNs = 0;
+
+        // Log time offset from the first frame, scaled to the wall clock;
+        // frames stamped before the first one are due immediately
+        auto dueNs = [&](const CanFrame& frame) {
+            uint64_t offset = frame.timeNs > logStartNs ? frame.timeNs - logStartNs : 0;
+            return wallStartNs + static_cast<uint64_t>(static_cast<double>(offset) / options.speed);
+        };
+
+        while (ok && !stopped) {
+            if (Stopped(stop)) {
+                stopped = true;
+                break;
+            }
+            size_t count = reader.Read(frames.data(), batch);
+            if (count == 0) break;
+
+            if (!timed) {
+                ok = sink(frames.data(), count, userData);
+                s.frames += count;
+                s.batches++;
+                continue;
+            }
+
+            if (first) {
+                first = false;
+                logStartNs = frames[0].timeNs;
+                wallStartNs = MonotonicNowNs();
+            }
+            for (size_t i = 0; ok && i < count;) {
+                uint64_t due = dueNs(frames[i]);
+                if (!WaitUntil(due, stop)) {
+                    stopped = true;
+                    break;
+                }
+                uint64_t now = MonotonicNowNs();
+                s.maxLateNs = std::max(s.maxLateNs, now - due);
+
+                size_t j = i + 1;
+                while (j < count && dueNs(frames[j]) <= now) j++;
+                ok = sink(frames.data() + i, j - i, userData);
+                s.frames += j - i;
+                s.batches++;
+                i = j;
+            }
+        }
+
+        s.skippedLines += reader.GetSkippedLines();
+        s.bytes += reader.GetOffset();
+        if (ok && !stopped) s.loops++;
+        if (reader.GetFrameCount() == 0) break;     // Nothing to loop over
+    }
+
+    s.elapsedNs = MonotonicNowNs() - start;
+    return ok;
+}
+
+CanSocket::~CanSocket() {
+    Close();
+}
+
+bool CanSocket::Open(const char* interfaceName) {
+    Close();
+    if (!interfaceName || strlen(interfaceName) >= IFNAMSIZ) return false;
+
+    int fd = socket(PF_CAN, SOCK_RAW | SOCK_CLOEXEC, CAN_RAW);
+    if (fd < 0) return false;
+
+    struct ifreq ifr;
+    memset(&ifr, 0, sizeof(ifr));
+    strncpy(ifr.ifr_name, interfaceName, IFNAMSIZ - 1);
+    if (ioctl(fd, SIOCGIFINDEX, &ifr) != 0) {
+        close(fd);
+        return false;
+    }
+
+    // Write-only: receive nothing, not even the frames we send
+    setsockopt(fd, SOL_CAN_RAW, CAN_RAW_FILTER, nullptr, 0);
+    int enable = 1;
+    fdFrames_ = setsockopt(fd, SOL_CAN_RAW, CAN_RAW_FD_FRAMES, &enable, sizeof(enable)) == 0;
+
+    struct sockaddr_can addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.can_family = AF_CAN;
+    addr.can_ifindex = ifr.ifr_ifindex;
+    if (bind(fd, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr)) != 0) {
+        close(fd);
+        return false;
+    }
+
+    fd_ = fd;
+    return true;
+}
+
+void CanSocket::Close() {
+    if (fd_ >= 0) close(fd_);
+    fd_ = -1;
+    fdFrames_ = false;
+}
+
+size_t CanSocket::Write(const CanFrame* frames, size_t count) {
+    if (fd_ < 0) return 0;
+
+    // canfd_frame starts with the can_frame layout, so one buffer type
+    // serves both; the iovec length tells the kernel which one it is
+    struct canfd_frame buffers[kSendBatch];
+    struct iovec iov[kSendBatch];
+    struct mmsghdr messages[kSendBatch];
+
+    size_t written = 0;
+    while (written < count) {
+        size_t batch = std::min(kSendBatch, count - written);
+        for (size_t i = 0; i < batch; i++) {
+            const CanFrame& frame = frames[written + i];
+            bool fd = (frame.flags & CanFrame_Fd) != 0;
+            if (fd && !fdFrames_) return written + i;
+
+            struct canfd_frame& out = buffers[i];
+            memset(&out, 0, sizeof(out));
+            out.can_id = frame.id;
+            if (frame.flags & CanFrame_Extended) out.can_id |= CAN_EFF_FLAG;
+            if (frame.flags & CanFrame_Remote) out.can_id |= CAN_RTR_FLAG;
+            if (frame.flags & CanFrame_Error) out.can_id |= CAN_ERR_FLAG;
+            out.len = frame.len;
+            if (fd) {
+                if (frame.flags & CanFrame_Brs) out.flags |= CANFD_BRS;
+                if (frame.flags & CanFrame_Esi) out.flags |= CANFD_ESI;
+            }
+            if (!(frame.flags & CanFrame_Remote)) memcpy(out.data, frame.data, frame.len);
+
+            iov[i].iov_base = &out;
+            iov[i].iov_len = fd ? CANFD_MTU : CAN_MTU;
+            memset(&messages[i], 0, sizeof(messages[i]));
+            messages[i].msg_hdr.msg_iov = &iov[i];
+            messages[i].msg_hdr.msg_iovlen = 1;
+        }
+
+        int sent = sendmmsg(fd_, messages, static_cast<unsigned>(batch), 0);
+        if (sent < 0) {
+            if (errno == EINTR) continue;
+            if (errno == ENOBUFS || errno == EAGAIN) {
+                // Interface queue full: CAN sockets do not signal POLLOUT
+                // reliably for this, so poll doubles as a short sleep
+                struct pollfd pfd = { fd_, POLLOUT, 0 };
+                poll(&pfd, 1, 1);
+                continue;
+            }
+            return written;
+        }
+        written += static_cast<size_t>(sent);
+    }
+    return written;
+}
+
+bool CanSocket::Sink(const CanFrame* frames, size_t count, void* userData) {
+    return static_cast<CanSocket*>(userData)->Write(frames, count) == count;
+}
+
+// Highest data byte a signal touches, or -1 if it leaves the 64-byte payload
+static int LastByte(const CanSignalDef& def) {
+    if (!def.bigEndian) {
+        int last = (def.startBit + def.length - 1) / 8;
+        return last < 64 ? last : -1;
+    }
+    // Motorola: walk from the MSB down the DBC bit numbering sawtooth
+    int position = def.startBit;
+    int last = 0;
+    for (int i = 0; i < def.length; i++) {
+        if (position / 8 >= 64) return -1;
+        last = std::max(last, position / 8);
+        position = (position % 8 == 0) ? position + 15 : position - 1;
+    }
+    return last;
+}
+
+bool CanDecoder::AddSignal(const SignalBus& bus, const CanSignalDef& def) {
+    if (def.length < 1 || def.length > 32 || def.signal < 0 || def.signal >= bus.GetSignalCount()) return false;
+    if (def.id > (def.extended ? 0x1fffffffu : 0x7ffu) || LastByte(def) < 0) return false;
+
+    entries_.push_back({ def, bus.GetSignalType(def.signal), static_cast<uint8_t>(LastByte(def)) });
+    Rebuild();
+    return true;
+}
+
+void CanDecoder::Rebuild() {
+    std::stable_sort(entries_.begin(), entries_.end(), [](const Entry& a, const Entry& b) {
+        return Key(a.def.id, a.def.extended) < Key(b.def.id, b.def.extended);
+    });
+    frames_.clear();
+    for (uint32_t i = 0; i < entries_.size(); i++) {
+        Range& range = frames_.emplace(Key(entries_[i].def.id, entries_[i].def.extended), Range{ i, 0 }).first->second;
+        range.count++;
+    }
+}
+
+static uint32_t ExtractRaw(const uint8_t* data, const CanSignalDef& def) {
+    if (!def.bigEndian) {
+        int first = def.startBit / 8;
+        int shift = def.startBit % 8;
+        int bytes = (shift + def.length + 7) / 8;
+        uint64_t raw = 0;
+        for (int i = 0; i < bytes; i++) raw |= static_cast<uint64_t>(data[first + i]) << (8 * i);
+        raw >>= shift;
+        return static_cast<uint32_t>(raw & ((uint64_t(1) << def.length) - 1));
+    }
+    int position = def.startBit;
+    uint32_t raw = 0;
+    for (int i = 0; i < def.length; i++) {
+        raw = (raw << 1) | ((data[position / 8] >> (position % 8)) & 1u);
+        position = (position % 8 == 0) ? position + 15 : position - 1;
+    }
+    return raw;
+}
+
+size_t CanDecoder::Decode(const CanFrame& frame, uint64_t timeNs) {
+    if (frame.flags & (CanFrame_Remote | CanFrame_Error)) return 0;
+    auto it = frames_.find(Key(frame.id, (frame.flags & CanFrame_Extended) != 0));
+    if (it == frames_.end()) {
+        unknown_++;
+        return 0;
+    }
+    decoded_++;
+
+    size_t published = 0;
+    for (uint32_t i = it->second.first; i < it->second.first + it->second.count; i++) {
+        const Entry& entry = entries_[i];
+        if (entry.lastByte >= frame.len) continue;
+
+        const CanSignalDef& def = entry.def;
+        uint32_t raw = ExtractRaw(frame.data, def);
+        double value;
+        if (def.isSigned && def.length < 32 && (raw >> (def.length - 1)) & 1u) {
+            value = static_cast<double>(static_cast<int64_t>(raw) - (int64_t(1) << def.length));
+        } else if (def.isSigned) {
+            value = static_cast<double>(static_cast<int32_t>(raw));
+        } else {
+            value = static_cast<double>(raw);
+        }
+        value = value * def.scale + def.offset;
+
+        switch (entry.type) {
+            case SignalType::Float:
+                producer_->Publish(SignalId<float>{ static_cast<uint16_t>(def.signal) },
+                                   static_cast<float>(value), timeNs);
+                break;
+            case SignalType::Int:
+                producer_->Publish(SignalId<int32_t>{ static_cast<uint16_t>(def.signal) },
+                                   static_cast<int32_t>(std::lround(value)), timeNs);
+                break;
+            case SignalType::Bool:
+                producer_->Publish(SignalId<bool>{ static_cast<uint16_t>(def.signal) }, value != 0.0, timeNs);
+                break;
+        }
+        published++;
+    }
+    return published;
+}
+
+bool CanDecoder::Sink(const CanFrame* frames, size_t count, void* userData) {
+    CanDecoder* decoder = static_cast<CanDecoder*>(userData);
+    uint64_t now = MonotonicNowNs();
+    for (size_t i = 0; i < count; i++) decoder->Decode(frames[i], now);
+    return true;
+}
+
+} // namespace ui
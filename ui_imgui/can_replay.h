@@ -0,0 +1,181 @@
+#pragma once
+
+#include "can_log.h"
+#include "signal_bus.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace ui {
+
+/**
+ * Receives replayed frames in batches
+ * @param frames Frames in log order (valid only during the call)
+ * @param userData Pointer passed to ReplayCanLog
+ * @return false to stop the replay
+ */
+using CanFrameSink = bool (*)(const CanFrame* frames, size_t count, void* userData);
+
+struct CanReplayOptions {
+    double speed = 1.0;         // 1 = original timing, 10 = ten times faster, 0 = as fast as possible
+    int loops = 1;              // Passes over the log (0 = until stopped)
+    size_t batchFrames = 256;   // Most frames handed to the sink per call
+};
+
+struct CanReplayStats {
+    uint64_t frames = 0;        // Delivered to the sink
+    uint64_t batches = 0;       // Sink calls
+    uint64_t skippedLines = 0;  // Log lines that were not frames (all passes)
+    uint64_t bytes = 0;         // Log bytes parsed (all passes)
+    uint64_t elapsedNs = 0;
+    uint64_t maxLateNs = 0;     // Timed replay: worst delay of a frame behind its due time
+    int loops = 0;              // Completed passes
+};
+
+/**
+ * Replay a log into a sink on the calling thread
+ *
+ * Timed replay (speed > 0) schedules each frame at its log time offset from
+ * the first frame of the pass, divided by speed, on the MonotonicNowNs()
+ * clock. It sleeps while the next frame is more than a couple of
+ * milliseconds away and spins for the rest, and hands every frame that is
+ * due to the sink in one batch, so a burst of frames with the same timestamp
+ * goes out together. With speed 0 the reader's batches go straight to the
+ * sink and the replay runs at parse speed.
+ *
+ * Each pass starts from the beginning of the log (Rewind()).
+ *
+ * @param stop Optional flag checked between batches and while waiting
+ * @return false if the sink stopped the replay or the reader is not open
+ */
+bool ReplayCanLog(CanLogReader& reader, const CanReplayOptions& options, CanFrameSink sink, void* userData,
+                  CanReplayStats* stats = nullptr, const std::atomic<bool>* stop = nullptr);
+
+/**
+ * Raw SocketCAN socket for writing replayed frames (Linux only)
+ *
+ * Works with real interfaces and with vcan:
+ *
+ *   sudo modprobe vcan
+ *   sudo ip link add dev vcan0 type vcan && sudo ip link set up vcan0
+ *
+ * FD frames need an FD-capable interface (vcan with mtu 72). Batches are
+ * written with sendmmsg(); when the interface queue is full the write waits
+ * for it to drain instead of dropping.
+ */
+class CanSocket {
+public:
+    CanSocket() = default;
+    ~CanSocket();
+
+    CanSocket(const CanSocket&) = delete;
+    CanSocket& operator=(const CanSocket&) = delete;
+
+    /**
+     * @return false if the interface does not exist or the socket cannot be bound
+     */
+    bool Open(const char* interfaceName);
+    void Close();
+    bool IsOpen() const { return fd_ >= 0; }
+
+    /**
+     * Write frames in order
+     * @return Number written (less than count on an error; FD frames fail
+     *         on a classic interface)
+     */
+    size_t Write(const CanFrame* frames, size_t count);
+
+    /**
+     * CanFrameSink adapter (userData = CanSocket*)
+     */
+    static bool Sink(const CanFrame* frames, size_t count, void* userData);
+
+private:
+    int fd_ = -1;
+    bool fdFrames_ = false;
+};
+
+/**
+ * One signal in a frame, as in a DBC file
+ */
+struct CanSignalDef {
+    uint32_t id = 0;            // Frame identifier
+    bool extended = false;      // 29-bit identifier
+    uint16_t startBit = 0;      // DBC start bit: LSB for Intel, MSB for Motorola byte order
+    uint8_t length = 1;         // Bits (1..32)
+    bool bigEndian = false;     // Motorola byte order
+    bool isSigned = false;
+    float scale = 1.0f;
+    float offset = 0.0f;
+    int signal = -1;            // SignalBus signal index
+};
+
+/**
+ * Table-driven CAN signal decoder publishing to the signal bus
+ *
+ * Each frame is looked up by identifier; every signal defined on it is
+ * extracted, scaled (raw * scale + offset) and published through the
+ * producer with the bus signal's type: float as is, int rounded, bool
+ * non-zero. Remote and error frames and signals past the frame's length
+ * are skipped.
+ *
+ * @code
+ *   ui::CanDecoder decoder(bus.AddProducer("can"));
+ *   ui::CanSignalDef speed;
+ *   speed.id = 0x123; speed.length = 16; speed.scale = 0.01f;
+ *   speed.signal = signals.speed.index;
+ *   decoder.AddSignal(bus, speed);
+ *   bus.Start();
+ *   ui::ReplayCanLog(reader, options, ui::CanDecoder::Sink, &decoder);
+ * @endcode
+ */
+class CanDecoder {
+public:
+    explicit CanDecoder(BusProducer* producer) : producer_(producer) {}
+
+    /**
+     * @return false if the bit range or the signal index is invalid
+     */
+    bool AddSignal(const SignalBus& bus, const CanSignalDef& def);
+
+    /**
+     * Decode one frame and publish its signals with timestamp timeNs
+     * @return Number of signals published
+     */
+    size_t Decode(const CanFrame& frame, uint64_t timeNs);
+
+    /**
+     * CanFrameSink adapter (userData = CanDecoder*); publishes with the
+     * MonotonicNowNs() time of the batch, since log times are on another clock
+     */
+    static bool Sink(const CanFrame* frames, size_t count, void* userData);
+
+    uint64_t GetDecodedFrames() const { return decoded_; }      // Frames with at least one signal defined
+    uint64_t GetUnknownFrames() const { return unknown_; }
+
+private:
+    struct Entry {
+        CanSignalDef def;
+        SignalType type;
+        uint8_t lastByte;       // Highest data byte the signal touches
+    };
+
+    struct Range {
+        uint32_t first;
+        uint32_t count;
+    };
+
+    static uint32_t Key(uint32_t id, bool extended) { return id | (extended ? 0x80000000u : 0u); }
+
+    void Rebuild();
+
+    BusProducer* producer_;
+    std::vector<Entry> entries_;                    // Sorted by frame key
+    std::unordered_map<uint32_t, Range> frames_;
+    uint64_t decoded_ = 0;
+    uint64_t unknown_ = 0;
+};
+
+} // namespace ui
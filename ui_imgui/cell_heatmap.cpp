@@ -0,0 +1,206 @@
+#include "cell_heatmap.h"
+#include "theme.h"
+#include <algorithm>
+
+namespace ui {
+
+// Smallest displayed spread per field, so sensor noise on a balanced pack
+// does not fill the whole color range
+static constexpr float kMinSpan[2] = { 0.010f, 2.0f };   // V, degC
+
+// Range padding on each side, and how far the spread may shrink before the
+// range is tightened again
+static constexpr float kRangePadding = 0.15f;
+static constexpr float kShrinkRatio = 0.4f;
+
+static int LowestSetBit(uint64_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(word);
+#else
+    int bit = 0;
+    while (!(word & 1)) { word >>= 1; bit++; }
+    return bit;
+#endif
+}
+
+CellHeatmap::CellHeatmap(int columns) : columns_(std::max(columns, 1)) {
+    // Low -> high: blue, teal, green, amber, red
+    const ImVec4 stops[] = {
+        ImVec4(0.25f, 0.45f, 0.90f, 1.0f),
+        Colors::Primary(),
+        Colors::Success(),
+        Colors::Warning(),
+        Colors::Destructive(),
+    };
+    const int segments = static_cast<int>(sizeof(stops) / sizeof(stops[0])) - 1;
+
+    for (int i = 0; i < 256; i++) {
+        float t = static_cast<float>(i) / 255.0f * segments;
+        int s = std::min(static_cast<int>(t), segments - 1);
+        float f = t - static_cast<float>(s);
+        const ImVec4& a = stops[s];
+        const ImVec4& b = stops[s + 1];
+        lut_[i] = ImGui::ColorConvertFloat4ToU32(ImVec4(a.x + (b.x - a.x) * f, a.y + (b.y - a.y) * f,
+                                                        a.z + (b.z - a.z) * f, 1.0f));
+    }
+}
+
+void CellHeatmap::SetUploader(UploadFn upload, void* userData) {
+    upload_ = upload;
+    uploadUserData_ = userData;
+    texture_ = ImTextureID();
+    textureRows_ = 0;
+    pendingFirstRow_ = 0;
+    pendingLastRow_ = rows_ - 1;
+}
+
+ImU32 CellHeatmap::ColorFor(float value) const {
+    float t = (value - rangeMin_) / (rangeMax_ - rangeMin_);
+    int index = static_cast<int>(std::min(std::max(t, 0.0f), 1.0f) * 255.0f + 0.5f);
+    return lut_[index];
+}
+
+bool CellHeatmap::UpdateRange(const CellStats& stats, CellField field) {
+    float span = std::max(stats.Delta(), kMinSpan[static_cast<int>(field)]);
+    bool outside = stats.min < rangeMin_ || stats.max > rangeMax_;
+    bool tooWide = span < kShrinkRatio * (rangeMax_ - rangeMin_);
+    if (valid_ && !outside && !tooWide) return false;
+
+    float center = 0.5f * (stats.min + stats.max);
+    float half = 0.5f * span * (1.0f + 2.0f * kRangePadding);
+    rangeMin_ = center - half;
+    rangeMax_ = center + half;
+    return true;
+}
+
+void CellHeatmap::Sync(CellTelemetry& cells, CellField field) {
+    // Another state's telemetry: its dirty bits say nothing about our pixels
+    if (&cells != source_) {
+        source_ = &cells;
+        valid_ = false;
+    }
+    if (cells.CellCount() != cellCount_) {
+        cellCount_ = cells.CellCount();
+        rows_ = static_cast<int>((cellCount_ + columns_ - 1) / columns_);
+        pixels_.assign(static_cast<size_t>(rows_) * columns_, 0);   // Unused tail texels transparent
+        valid_ = false;
+    }
+    if (field != field_) {
+        field_ = field;
+        valid_ = false;
+    }
+    if (UpdateRange(cells.Stats(field), field)) {
+        valid_ = false;
+    }
+
+    uint64_t dirty[CellTelemetry::kDirtyWords];
+    bool anyDirty = cells.TakeDirty(field, dirty);
+
+    if (!valid_) {
+        for (size_t cell = 0; cell < cellCount_; cell++) {
+            pixels_[cell] = ColorFor(cells.Value(field, cell));
+        }
+        valid_ = true;
+        pendingFirstRow_ = 0;
+        pendingLastRow_ = rows_ - 1;
+    } else if (anyDirty) {
+        for (size_t w = 0; w < CellTelemetry::kDirtyWords; w++) {
+            for (uint64_t word = dirty[w]; word; word &= word - 1) {
+                size_t cell = w * 64 + static_cast<size_t>(LowestSetBit(word));
+                if (cell >= cellCount_) break;
+                pixels_[cell] = ColorFor(cells.Value(field, cell));
+
+                int row = static_cast<int>(cell / columns_);
+                pendingFirstRow_ = pendingLastRow_ < pendingFirstRow_ ? row : std::min(pendingFirstRow_, row);
+                pendingLastRow_ = std::max(pendingLastRow_, row);
+            }
+        }
+    }
+
+    if (upload_ && rows_ > 0 && pendingLastRow_ >= pendingFirstRow_) {
+        // A size change needs a new texture; the uploader sees the new size
+        if (textureRows_ != rows_) {
+            pendingFirstRow_ = 0;
+            pendingLastRow_ = rows_ - 1;
+        }
+        texture_ = upload_(texture_, columns_, rows_, pixels_.data(),
+                           pendingFirstRow_, pendingLastRow_ - pendingFirstRow_ + 1, uploadUserData_);
+        textureRows_ = texture_ != ImTextureID() ? rows_ : 0;
+        pendingFirstRow_ = 0;
+        pendingLastRow_ = -1;
+    }
+}
+
+// Per-cell quads, built on a ParallelDraw worker when one is attached
+struct CellQuadsDraw {
+    ImVec2 pos;
+    float cellWidth;
+    float cellHeight;
+    float gap;
+    int columns;
+    int count;
+    const uint32_t* pixels;
+};
+
+static void BuildCellQuads(ImDrawList& drawList, const CellQuadsDraw& d) {
+    drawList.PrimReserve(d.count * 6, d.count * 4);
+    for (int cell = 0; cell < d.count; cell++) {
+        float x = d.pos.x + d.cellWidth * (cell % d.columns);
+        float y = d.pos.y + d.cellHeight * (cell / d.columns);
+        drawList.PrimRect(ImVec2(x, y), ImVec2(x + d.cellWidth - d.gap, y + d.cellHeight - d.gap), d.pixels[cell]);
+    }
+}
+
+void CellHeatmap::Render(const char* id, CellTelemetry& cells, CellField field, const ImVec2& size,
+                         ParallelDraw* parallelDraw) {
+    if (cells.CellCount() == 0) return;
+    Sync(cells, field);
+
+    float width = size.x > 0.0f ? size.x : ImGui::GetContentRegionAvail().x;
+    float cellWidth = width / static_cast<float>(columns_);
+    float cellHeight = size.y > 0.0f ? size.y / static_cast<float>(rows_) : cellWidth;
+    ImVec2 pos = ImGui::GetCursorScreenPos();
+    ImVec2 mapSize(cellWidth * columns_, cellHeight * rows_);
+
+    ImGui::InvisibleButton(id, mapSize);
+    if (!ImGui::IsItemVisible()) return;
+
+    ImDrawList* drawList = ImGui::GetWindowDrawList();
+    float gap = (cellWidth >= 4.0f && cellHeight >= 4.0f) ? 1.0f : 0.0f;
+
+    if (texture_ != ImTextureID()) {
+        // One quad for the whole pack; cell gaps as a handful of grid lines
+        drawList->AddImage(texture_, pos, ImVec2(pos.x + mapSize.x, pos.y + mapSize.y));
+        if (gap > 0.0f) {
+            ImU32 gridColor = ImGui::GetColorU32(Colors::Card());
+            for (int c = 1; c < columns_; c++) {
+                float x = pos.x + cellWidth * c;
+                drawList->AddLine(ImVec2(x, pos.y), ImVec2(x, pos.y + mapSize.y), gridColor, gap);
+            }
+            for (int r = 1; r < rows_; r++) {
+                float y = pos.y + cellHeight * r;
+                drawList->AddLine(ImVec2(pos.x, y), ImVec2(pos.x + mapSize.x, y), gridColor, gap);
+            }
+        }
+    } else {
+        // One batch of solid quads on the font atlas white pixel
+        CellQuadsDraw quads = { pos, cellWidth, cellHeight, gap, columns_, static_cast<int>(cellCount_), pixels_.data() };
+        DeferDraw(parallelDraw, BuildCellQuads, quads);
+    }
+
+    if (ImGui::IsItemHovered()) {
+        ImVec2 mouse = ImGui::GetIO().MousePos;
+        int column = std::min(static_cast<int>((mouse.x - pos.x) / cellWidth), columns_ - 1);
+        int row = std::min(static_cast<int>((mouse.y - pos.y) / cellHeight), rows_ - 1);
+        size_t cell = static_cast<size_t>(row) * columns_ + column;
+        if (column >= 0 && row >= 0 && cell < cellCount_) {
+            ImVec2 min(pos.x + cellWidth * column, pos.y + cellHeight * row);
+            drawList->AddRect(min, ImVec2(min.x + cellWidth, min.y + cellHeight),
+                              ImGui::GetColorU32(Colors::Foreground()));
+            ImGui::SetTooltip("Cell %d\n%.3f V  %.1f C", static_cast<int>(cell) + 1,
+                              cells.Voltage(cell), cells.Temperature(cell));
+        }
+    }
+}
+
+} // namespace ui
@@ -0,0 +1,98 @@
+#pragma once
+
+#include "cell_telemetry.h"
+#include "imgui.h"
+#include "parallel_draw.h"
+#include <cstdint>
+#include <vector>
+
+namespace ui {
+
+/**
+ * Cell voltage / temperature heatmap
+ *
+ * Keeps one RGBA texel per cell (columns x rows, row-major from cell 0)
+ * and only recolors cells whose value changed (CellTelemetry::TakeDirty).
+ * With an uploader the whole map is a single textured quad and only the
+ * band of changed rows is re-uploaded; without one it falls back to one
+ * solid quad per cell, written straight into the draw list in one batch
+ * (no AddRectFilled calls, one draw command).
+ *
+ * The color range follows the cell min/max with hysteresis, so a full
+ * recolor only happens when the spread leaves (or shrinks well inside)
+ * the current range, or when the map is drawn from a different
+ * CellTelemetry than last time (a heatmap shared between states).
+ */
+class CellHeatmap {
+public:
+    /**
+     * Create or update the heatmap texture
+     *
+     * @param texture Existing texture, or ImTextureID() to create one; a
+     *                full-image upload (firstRow 0, rowCount height) may
+     *                also follow a size change, so (re)allocate then
+     * @param width Texture width in texels (columns)
+     * @param height Texture height in texels (rows)
+     * @param pixels Full image, RGBA8 (ImU32 byte order), row stride width * 4
+     * @param firstRow First row to upload (all rows when creating)
+     * @param rowCount Rows to upload
+     * @param userData Pointer passed to SetUploader
+     * @return Texture to draw with (ImTextureID() on failure: falls back to quads)
+     *
+     * Sample with nearest filtering so cells keep hard edges.
+     */
+    using UploadFn = ImTextureID (*)(ImTextureID texture, int width, int height, const uint32_t* pixels,
+                                     int firstRow, int rowCount, void* userData);
+
+    /**
+     * @param columns Cells per row (a module's cell count reads well)
+     */
+    explicit CellHeatmap(int columns = 16);
+
+    void SetUploader(UploadFn upload, void* userData);
+
+    /**
+     * Sync dirty cells and draw the map as one item; hovering shows the
+     * cell's voltage and temperature
+     *
+     * @param id Item ID
+     * @param cells Cell telemetry (dirty bits of the shown field are consumed)
+     * @param field Field to color by
+     * @param size Size; x <= 0 uses the available width, y <= 0 square cells
+     * @param parallelDraw Optional pool to build the per-cell quads on
+     *                     (the pixels stay untouched until the next Render)
+     */
+    void Render(const char* id, CellTelemetry& cells, CellField field, const ImVec2& size = ImVec2(0, 0),
+                ParallelDraw* parallelDraw = nullptr);
+
+    /**
+     * Current texture (ImTextureID() when drawing with quads)
+     */
+    ImTextureID GetTexture() const { return texture_; }
+
+private:
+    void Sync(CellTelemetry& cells, CellField field);
+    bool UpdateRange(const CellStats& stats, CellField field);
+    ImU32 ColorFor(float value) const;
+
+    int columns_;
+    int rows_ = 0;
+    size_t cellCount_ = 0;
+    std::vector<uint32_t> pixels_;
+
+    const CellTelemetry* source_ = nullptr;
+    CellField field_ = CellField::Voltage;
+    bool valid_ = false;           // pixels_ match source_, field_ and the range
+    float rangeMin_ = 0.0f;
+    float rangeMax_ = 0.0f;
+    ImU32 lut_[256];
+
+    UploadFn upload_ = nullptr;
+    void* uploadUserData_ = nullptr;
+    ImTextureID texture_ = ImTextureID();
+    int textureRows_ = 0;
+    int pendingFirstRow_ = 0;      // Rows changed since the last upload
+    int pendingLastRow_ = -1;
+};
+
+} // namespace ui
@@ -0,0 +1,213 @@
+#include "cell_telemetry.h"
+#include <algorithm>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define UI_CELL_STATS_SSE2 1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define UI_CELL_STATS_NEON 1
+#endif
+
+namespace ui {
+
+// Running min/max/sum over values[first, count), continuing from stats
+static void AccumulateScalar(const float* values, size_t first, size_t count, CellStats& stats, float& sum) {
+    for (size_t i = first; i < count; i++) {
+        float v = values[i];
+        if (v < stats.min) { stats.min = v; stats.minCell = static_cast<uint16_t>(i); }
+        if (v > stats.max) { stats.max = v; stats.maxCell = static_cast<uint16_t>(i); }
+        sum += v;
+    }
+}
+
+// Fold the vector lanes (each holding the first min/max of its residue
+// class) into one result; ties pick the lower cell, matching the scalar scan
+static void ReduceLanes(const float* mins, const uint32_t* minCells,
+                        const float* maxs, const uint32_t* maxCells, int lanes, CellStats& stats) {
+    stats.min = mins[0]; stats.minCell = static_cast<uint16_t>(minCells[0]);
+    stats.max = maxs[0]; stats.maxCell = static_cast<uint16_t>(maxCells[0]);
+    for (int lane = 1; lane < lanes; lane++) {
+        if (mins[lane] < stats.min || (mins[lane] == stats.min && minCells[lane] < stats.minCell)) {
+            stats.min = mins[lane];
+            stats.minCell = static_cast<uint16_t>(minCells[lane]);
+        }
+        if (maxs[lane] > stats.max || (maxs[lane] == stats.max && maxCells[lane] < stats.maxCell)) {
+            stats.max = maxs[lane];
+            stats.maxCell = static_cast<uint16_t>(maxCells[lane]);
+        }
+    }
+}
+
+CellStats ComputeCellStatsScalar(const float* values, size_t count) {
+    CellStats stats;
+    if (count == 0) return stats;
+
+    stats.min = stats.max = values[0];
+    float sum = 0.0f;
+    AccumulateScalar(values, 0, count, stats, sum);
+    stats.mean = sum / static_cast<float>(count);
+    return stats;
+}
+
+CellStats ComputeCellStats(const float* values, size_t count) {
+#if defined(UI_CELL_STATS_SSE2) || defined(UI_CELL_STATS_NEON)
+    if (count < 16) return ComputeCellStatsScalar(values, count);
+
+    // Two independent sets of 4 lanes (8 cells per iteration) so the
+    // compare/select chains overlap. Each lane tracks its min/max and the
+    // index where it was first seen; strict compares keep the earlier
+    // index on ties.
+    alignas(16) float mins[8], maxs[8], sums[8];
+    alignas(16) uint32_t minCells[8], maxCells[8];
+    size_t i = 8;
+
+#if defined(UI_CELL_STATS_SSE2)
+    struct Lanes {
+        __m128 min, max, sum;
+        __m128i index, minIndex, maxIndex;
+
+        void Init(const float* values, int first) {
+            min = max = sum = _mm_loadu_ps(values + first);
+            index = minIndex = maxIndex = _mm_setr_epi32(first, first + 1, first + 2, first + 3);
+        }
+        void Add(const float* values, __m128i step) {
+            __m128 v = _mm_loadu_ps(values);
+            index = _mm_add_epi32(index, step);
+
+            __m128 lt = _mm_cmplt_ps(v, min);
+            __m128 gt = _mm_cmpgt_ps(v, max);
+            min = _mm_or_ps(_mm_and_ps(lt, v), _mm_andnot_ps(lt, min));
+            max = _mm_or_ps(_mm_and_ps(gt, v), _mm_andnot_ps(gt, max));
+
+            __m128i ltMask = _mm_castps_si128(lt);
+            __m128i gtMask = _mm_castps_si128(gt);
+            minIndex = _mm_or_si128(_mm_and_si128(ltMask, index), _mm_andnot_si128(ltMask, minIndex));
+            maxIndex = _mm_or_si128(_mm_and_si128(gtMask, index), _mm_andnot_si128(gtMask, maxIndex));
+
+            sum = _mm_add_ps(sum, v);
+        }
+        void Store(float* mins, float* maxs, float* sums, uint32_t* minCells, uint32_t* maxCells) const {
+            _mm_store_ps(mins, min);
+            _mm_store_ps(maxs, max);
+            _mm_store_ps(sums, sum);
+            _mm_store_si128(reinterpret_cast<__m128i*>(minCells), minIndex);
+            _mm_store_si128(reinterpret_cast<__m128i*>(maxCells), maxIndex);
+        }
+    };
+    const __m128i step = _mm_set1_epi32(8);
+#else
+    struct Lanes {
+        float32x4_t min, max, sum;
+        uint32x4_t index, minIndex, maxIndex;
+
+        void Init(const float* values, int first) {
+            const uint32_t lanes[4] = { uint32_t(first), uint32_t(first + 1), uint32_t(first + 2), uint32_t(first + 3) };
+            min = max = sum = vld1q_f32(values + first);
+            index = minIndex = maxIndex = vld1q_u32(lanes);
+        }
+        void Add(const float* values, uint32x4_t step) {
+            float32x4_t v = vld1q_f32(values);
+            index = vaddq_u32(index, step);
+
+            uint32x4_t lt = vcltq_f32(v, min);
+            uint32x4_t gt = vcgtq_f32(v, max);
+            min = vbslq_f32(lt, v, min);
+            max = vbslq_f32(gt, v, max);
+            minIndex = vbslq_u32(lt, index, minIndex);
+            maxIndex = vbslq_u32(gt, index, maxIndex);
+
+            sum = vaddq_f32(sum, v);
+        }
+        void Store(float* mins, float* maxs, float* sums, uint32_t* minCells, uint32_t* maxCells) const {
+            vst1q_f32(mins, min);
+            vst1q_f32(maxs, max);
+            vst1q_f32(sums, sum);
+            vst1q_u32(minCells, minIndex);
+            vst1q_u32(maxCells, maxIndex);
+        }
+    };
+    const uint32x4_t step = vdupq_n_u32(8);
+#endif
+
+    Lanes a, b;
+    a.Init(values, 0);
+    b.Init(values, 4);
+    for (; i + 8 <= count; i += 8) {
+        a.Add(values + i, step);
+        b.Add(values + i + 4, step);
+    }
+    a.Store(mins, maxs, sums, minCells, maxCells);
+    b.Store(mins + 4, maxs + 4, sums + 4, minCells + 4, maxCells + 4);
+
+    CellStats stats;
+    ReduceLanes(mins, minCells, maxs, maxCells, 8, stats);
+    float sum = ((sums[0] + sums[4]) + (sums[1] + sums[5])) + ((sums[2] + sums[6]) + (sums[3] + sums[7]));
+    AccumulateScalar(values, i, count, stats, sum);
+    stats.mean = sum / static_cast<float>(count);
+    return stats;
+#else
+    return ComputeCellStatsScalar(values, count);
+#endif
+}
+
+void CellTelemetry::SetCellCount(size_t count) {
+    count = std::min(count, kMaxCells);
+    if (count == count_) return;
+
+    // Cells beyond the count read as 0 so a later grow starts clean
+    for (size_t f = 0; f < 2; f++) {
+        std::fill(values_[f] + count, values_[f] + kMaxCells, 0.0f);
+        std::fill(dirty_[f], dirty_[f] + kDirtyWords, ~0ull);
+        statsValid_[f] = false;
+    }
+    count_ = count;
+}
+
+void CellTelemetry::Set(CellField field, size_t cell, float value) {
+    size_t f = Index(field);
+    if (cell >= count_ || values_[f][cell] == value) return;
+
+    values_[f][cell] = value;
+    dirty_[f][cell >> 6] |= 1ull << (cell & 63);
+    statsValid_[f] = false;
+}
+
+void CellTelemetry::SetRange(CellField field, size_t first, const float* values, size_t count) {
+    if (first >= count_) return;
+    count = std::min(count, count_ - first);
+
+    size_t f = Index(field);
+    float* dst = values_[f] + first;
+    bool changed = false;
+    for (size_t i = 0; i < count; i++) {
+        if (dst[i] == values[i]) continue;
+        dst[i] = values[i];
+        size_t cell = first + i;
+        dirty_[f][cell >> 6] |= 1ull << (cell & 63);
+        changed = true;
+    }
+    if (changed) statsValid_[f] = false;
+}
+
+const CellStats& CellTelemetry::Stats(CellField field) const {
+    size_t f = Index(field);
+    if (!statsValid_[f]) {
+        stats_[f] = ComputeCellStats(values_[f], count_);
+        statsValid_[f] = true;
+    }
+    return stats_[f];
+}
+
+bool CellTelemetry::TakeDirty(CellField field, uint64_t mask[kDirtyWords]) {
+    size_t f = Index(field);
+    uint64_t any = 0;
+    for (size_t w = 0; w < kDirtyWords; w++) {
+        mask[w] = dirty_[f][w];
+        any |= mask[w];
+        dirty_[f][w] = 0;
+    }
+    return any != 0;
+}
+
+} // namespace ui
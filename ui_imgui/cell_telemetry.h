@@ -0,0 +1,100 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace ui {
+
+/**
+ * Per-cell quantity
+ */
+enum class CellField : uint8_t {
+    Voltage,       // V
+    Temperature    // degC
+};
+
+/**
+ * Summary of one cell field
+ */
+struct CellStats {
+    float min = 0.0f;
+    float max = 0.0f;
+    float mean = 0.0f;
+    uint16_t minCell = 0;   // First cell holding min
+    uint16_t maxCell = 0;   // First cell holding max
+
+    float Delta() const { return max - min; }
+};
+
+/**
+ * Min/max/mean over count values (SSE2 / NEON, scalar elsewhere)
+ * Ties resolve to the lowest index. count 0 returns zeroed stats.
+ */
+CellStats ComputeCellStats(const float* values, size_t count);
+
+/**
+ * Portable reference for ComputeCellStats
+ * Same min/max and cells; mean may differ in the last bits (summation order).
+ */
+CellStats ComputeCellStatsScalar(const float* values, size_t count);
+
+/**
+ * Cell-level pack telemetry (up to 192 cells in series)
+ *
+ * Setters only store and mark a cell dirty when the value actually
+ * changes, so a consumer (the heatmap) can refresh just those cells via
+ * TakeDirty(). Statistics are recomputed lazily, once per change burst,
+ * over the whole array with SIMD: a decreasing max cannot be maintained
+ * incrementally, and 192 floats are a handful of vector ops.
+ */
+class CellTelemetry {
+public:
+    static constexpr size_t kMaxCells = 192;
+    static constexpr size_t kDirtyWords = kMaxCells / 64;
+
+    /**
+     * Set the number of cells in series (clamped to kMaxCells)
+     * Changing the count marks every cell dirty.
+     */
+    void SetCellCount(size_t count);
+    size_t CellCount() const { return count_; }
+
+    void SetVoltage(size_t cell, float volts) { Set(CellField::Voltage, cell, volts); }
+    void SetTemperature(size_t cell, float celsius) { Set(CellField::Temperature, cell, celsius); }
+
+    /**
+     * Store a run of cells starting at first (e.g. one BMS frame)
+     */
+    void SetRange(CellField field, size_t first, const float* values, size_t count);
+
+    float Voltage(size_t cell) const { return values_[0][cell]; }
+    float Temperature(size_t cell) const { return values_[1][cell]; }
+    float Value(CellField field, size_t cell) const { return values_[Index(field)][cell]; }
+    const float* Values(CellField field) const { return values_[Index(field)]; }
+
+    /**
+     * Statistics over all cells (recomputed only after a change)
+     */
+    const CellStats& Stats(CellField field) const;
+
+    /**
+     * Copy and clear the dirty-cell bitmask of a field
+     *
+     * @param mask Receives kDirtyWords words, bit n = cell n changed
+     * @return true if any cell changed since the last call
+     */
+    bool TakeDirty(CellField field, uint64_t mask[kDirtyWords]);
+
+private:
+    static size_t Index(CellField field) { return static_cast<size_t>(field); }
+    void Set(CellField field, size_t cell, float value);
+
+    alignas(16) float values_[2][kMaxCells] = {};
+    uint64_t dirty_[2][kDirtyWords] = {};
+    size_t count_ = 0;
+
+    mutable CellStats stats_[2];
+    mutable bool statsValid_[2] = { true, true };
+};
+
+} // namespace ui
@@ -0,0 +1,504 @@
+#include "column_file.h"
+#include "crc32.h"
+#include "telemetry_codec.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <unordered_map>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace ui {
+
+using codec::GetVarint;
+using codec::PutVarint;
+
+static const char kColumnMagic[8] = { 'S', 'E', 'S', 'S', 'C', 'O', 'L', '1' };
+static constexpr uint32_t kColumnVersion = 2;
+static constexpr size_t kTrailerSize = 16;          // footer size, footer CRC, magic
+
+template <typename T>
+static void PutRaw(std::vector<uint8_t>& out, T value) {
+    size_t at = out.size();
+    out.resize(at + sizeof(T));
+    memcpy(out.data() + at, &value, sizeof(T));
+}
+
+template <typename T>
+static bool GetRaw(const uint8_t*& p, const uint8_t* end, T& value) {
+    if (static_cast<size_t>(end - p) < sizeof(T)) return false;
+    memcpy(&value, p, sizeof(T));
+    p += sizeof(T);
+    return true;
+}
+
+template <typename T>
+struct ChunkCodec {
+    ColumnEncoding encoding;
+    void (*encode)(const T* values, size_t count, std::vector<uint8_t>& out);
+};
+
+// Encode with every candidate and keep the smallest, falling back to plain
+// values; out must be empty
+template <typename T, size_t N>
+static ColumnEncoding EncodeSmallest(const ChunkCodec<T> (&codecs)[N], const T* values, size_t count,
+                                     std::vector<uint8_t>& out, std::vector<uint8_t>& scratch) {
+    ColumnEncoding best = ColumnEncoding::Plain;
+    size_t bestSize = count * sizeof(T);
+    for (const ChunkCodec<T>& candidate : codecs) {
+        scratch.clear();
+        candidate.encode(values, count, scratch);
+        if (scratch.size() < bestSize) {
+            out.swap(scratch);
+            best = candidate.encoding;
+            bestSize = out.size();
+        }
+    }
+    if (best == ColumnEncoding::Plain) {
+        out.resize(bestSize);
+        memcpy(out.data(), values, bestSize);
+    }
+    return best;
+}
+
+static const ChunkCodec<int64_t> kIntCodecs[] = {
+    { ColumnEncoding::FrameOfRef, codec::EncodeFrameOfRef },
+    { ColumnEncoding::Delta, codec::EncodeDelta },
+    { ColumnEncoding::DeltaOfDelta, codec::EncodeDeltaOfDelta },
+};
+
+// Slowly moving floats share sign, exponent and high mantissa bits, so both
+// the XOR and the difference of consecutive bit patterns are small
+static const ChunkCodec<float> kFloatCodecs[] = {
+    { ColumnEncoding::XorFloat, codec::EncodeXorFloat },
+    { ColumnEncoding::Delta, codec::EncodeFloatDelta },
+};
+
+static ColumnEncoding EncodeInts(const int64_t* values, size_t count, std::vector<uint8_t>& out,
+                                 std::vector<uint8_t>& scratch, ColumnValue& min, ColumnValue& max) {
+    int64_t lo = count ? values[0] : 0;
+    int64_t hi = lo;
+    for (size_t i = 0; i < count; i++) {
+        lo = std::min(lo, values[i]);
+        hi = std::max(hi, values[i]);
+    }
+    min.i = lo;
+    max.i = hi;
+    return EncodeSmallest(kIntCodecs, values, count, out, scratch);
+}
+
+static ColumnEncoding EncodeFloats(const float* values, size_t count, std::vector<uint8_t>& out,
+                                   std::vector<uint8_t>& scratch, ColumnValue& min, ColumnValue& max) {
+    double lo = std::numeric_limits<double>::infinity();
+    double hi = -lo;
+    for (size_t i = 0; i < count; i++) {
+        if (!std::isnan(values[i])) {
+            lo = std::min(lo, static_cast<double>(values[i]));
+            hi = std::max(hi, static_cast<double>(values[i]));
+        }
+    }
+    min.f = lo;
+    max.f = hi;
+    return EncodeSmallest(kFloatCodecs, values, count, out, scratch);
+}
+
+static void EncodeStrings(const std::string* values, size_t count, std::vector<uint8_t>& out,
+                          std::vector<int64_t>& indices, ColumnValue& min, ColumnValue& max) {
+    std::unordered_map<std::string, int64_t> lookup;
+    std::vector<const std::string*> dictionary;
+    indices.resize(count);
+    for (size_t i = 0; i < count; i++) {
+        auto inserted = lookup.emplace(values[i], static_cast<int64_t>(dictionary.size()));
+        if (inserted.second) dictionary.push_back(&values[i]);
+        indices[i] = inserted.first->second;
+    }
+
+    PutVarint(out, dictionary.size());
+    for (const std::string* text : dictionary) {
+        PutVarint(out, text->size());
+        out.insert(out.end(), text->begin(), text->end());
+    }
+    codec::EncodeFrameOfRef(indices.data(), count, out);
+    min.i = 0;
+    max.i = dictionary.empty() ? 0 : static_cast<int64_t>(dictionary.size() - 1);
+}
+
+static bool DecodeInts(ColumnEncoding encoding, const uint8_t* p, const uint8_t* end, size_t count,
+                       int64_t* values) {
+    bool ok = false;
+    switch (encoding) {
+        case ColumnEncoding::Plain:
+            if (static_cast<size_t>(end - p) != count * sizeof(int64_t)) return false;
+            memcpy(values, p, count * sizeof(int64_t));
+            return true;
+        case ColumnEncoding::Delta: ok = codec::DecodeDelta(p, end, count, values); break;
+        case ColumnEncoding::DeltaOfDelta: ok = codec::DecodeDeltaOfDelta(p, end, count, values); break;
+        case ColumnEncoding::FrameOfRef: ok = codec::DecodeFrameOfRef(p, end, count, values); break;
+        default: return false;
+    }
+    return ok && p == end;
+}
+
+static bool DecodeFloats(ColumnEncoding encoding, const uint8_t* p, const uint8_t* end, size_t count,
+                         float* values) {
+    bool ok = false;
+    switch (encoding) {
+        case ColumnEncoding::Plain:
+            if (static_cast<size_t>(end - p) != count * sizeof(float)) return false;
+            memcpy(values, p, count * sizeof(float));
+            return true;
+        case ColumnEncoding::Delta: ok = codec::DecodeFloatDelta(p, end, count, values); break;
+        case ColumnEncoding::XorFloat: ok = codec::DecodeXorFloat(p, end, count, values); break;
+        default: return false;
+    }
+    return ok && p == end;
+}
+
+static void PutString(std::vector<uint8_t>& out, const std::string& text) {
+    PutVarint(out, text.size());
+    out.insert(out.end(), text.begin(), text.end());
+}
+
+static bool GetString(const uint8_t*& p, const uint8_t* end, std::string& text) {
+    uint64_t size;
+    if (!GetVarint(p, end, size) || size > static_cast<uint64_t>(end - p)) return false;
+    text.assign(reinterpret_cast<const char*>(p), static_cast<size_t>(size));
+    p += size;
+    return true;
+}
+
+ColumnFileWriter::~ColumnFileWriter() {
+    Close();
+}
+
+bool ColumnFileWriter::Open(const char* path) {
+    Close();
+    fd_ = open(path, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd_ < 0) return false;
+    failed_ = false;
+    offset_ = 0;
+    tables_.clear();
+    chunk_.assign(kColumnMagic, kColumnMagic + sizeof(kColumnMagic));
+    return WriteChunk(chunk_);
+}
+
+bool ColumnFileWriter::WriteChunk(const std::vector<uint8_t>& chunk) {
+    const uint8_t* data = chunk.data();
+    size_t size = chunk.size();
+    while (size > 0 && !failed_) {
+        ssize_t written = write(fd_, data, size);
+        if (written < 0) {
+            failed_ = true;
+            break;
+        }
+        data += written;
+        size -= static_cast<size_t>(written);
+    }
+    offset_ += chunk.size();
+    return !failed_;
+}
+
+int ColumnFileWriter::AddTable(const char* name, const std::vector<ColumnInfo>& columns) {
+    ColumnTable table;
+    table.name = name;
+    table.columns = columns;
+    tables_.push_back(table);
+    return static_cast<int>(tables_.size() - 1);
+}
+
+bool ColumnFileWriter::WriteRowGroup(int table, const ColumnSlice* slices, size_t rows) {
+    if (fd_ < 0 || table < 0 || static_cast<size_t>(table) >= tables_.size()) return false;
+    if (rows == 0) return true;
+    ColumnTable& t = tables_[table];
+
+    ColumnRowGroup group;
+    group.firstRow = t.rows;
+    group.rows = static_cast<uint32_t>(rows);
+    for (size_t c = 0; c < t.columns.size(); c++) {
+        ColumnChunkInfo info;
+        info.offset = offset_;
+        chunk_.clear();
+        switch (t.columns[c].type) {
+            case ColumnType::Int:
+                if (!slices[c].ints) return false;
+                info.encoding = EncodeInts(slices[c].ints, rows, chunk_, scratch_, info.min, info.max);
+                break;
+            case ColumnType::Float:
+                if (!slices[c].floats) return false;
+                info.encoding = EncodeFloats(slices[c].floats, rows, chunk_, scratch_, info.min, info.max);
+                break;
+            case ColumnType::String:
+                if (!slices[c].strings) return false;
+                EncodeStrings(slices[c].strings, rows, chunk_, ints_, info.min, info.max);
+                info.encoding = ColumnEncoding::Dictionary;
+                break;
+        }
+        info.size = static_cast<uint32_t>(chunk_.size());
+        if (!WriteChunk(chunk_)) return false;
+        group.chunks.push_back(info);
+    }
+    t.rowGroups.push_back(group);
+    t.rows += rows;
+    return true;
+}
+
+bool ColumnFileWriter::Close() {
+    if (fd_ < 0) return false;
+
+    std::vector<uint8_t>& footer = scratch_;
+    footer.clear();
+    PutRaw<uint32_t>(footer, kColumnVersion);
+    PutVarint(footer, tables_.size());
+    for (const ColumnTable& table : tables_) {
+        PutString(footer, table.name);
+        PutVarint(footer, table.columns.size());
+        for (const ColumnInfo& column : table.columns) {
+            PutString(footer, column.name);
+            footer.push_back(static_cast<uint8_t>(column.type));
+        }
+        PutVarint(footer, table.rows);
+        PutVarint(footer, table.rowGroups.size());
+        for (const ColumnRowGroup& group : table.rowGroups) {
+            PutVarint(footer, group.firstRow);
+            PutVarint(footer, group.rows);
+            for (const ColumnChunkInfo& chunk : group.chunks) {
+                PutVarint(footer, chunk.offset);
+                PutVarint(footer, chunk.size);
+                footer.push_back(static_cast<uint8_t>(chunk.encoding));
+                PutRaw(footer, chunk.min.i);
+                PutRaw(footer, chunk.max.i);
+            }
+        }
+    }
+    uint32_t footerSize = static_cast<uint32_t>(footer.size());
+    uint32_t footerCrc = Crc32(footer.data(), footer.size());
+    PutRaw(footer, footerSize);
+    PutRaw(footer, footerCrc);
+    footer.insert(footer.end(), kColumnMagic, kColumnMagic + sizeof(kColumnMagic));
+
+    bool ok = WriteChunk(footer);
+    ok &= close(fd_) == 0 && !failed_;
+    fd_ = -1;
+    return ok;
+}
+
+ColumnFileReader::~ColumnFileReader() {
+    Close();
+}
+
+bool ColumnFileReader::Open(const char* path) {
+    Close();
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return false;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(kColumnMagic) + kTrailerSize) {
+        close(fd);
+        return false;
+    }
+    size_t size = static_cast<size_t>(st.st_size);
+    void* mapping = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED) return false;
+    map_ = static_cast<const uint8_t*>(mapping);
+    mapLength_ = size;
+    madvise(mapping, size, MADV_SEQUENTIAL);
+
+    // Trailer, then the footer it points at
+    const uint8_t* trailer = map_ + size - kTrailerSize;
+    uint32_t footerSize;
+    uint32_t footerCrc;
+    memcpy(&footerSize, trailer, sizeof(footerSize));
+    memcpy(&footerCrc, trailer + 4, sizeof(footerCrc));
+    if (memcmp(map_, kColumnMagic, sizeof(kColumnMagic)) != 0 ||
+        memcmp(trailer + 8, kColumnMagic, sizeof(kColumnMagic)) != 0 ||
+        footerSize > size - sizeof(kColumnMagic) - kTrailerSize) {
+        Close();
+        return false;
+    }
+    const uint8_t* p = trailer - footerSize;
+    const uint8_t* end = trailer;
+    uint64_t chunksEnd = static_cast<uint64_t>(p - map_);
+    if (Crc32(p, footerSize) != footerCrc) {
+        Close();
+        return false;
+    }
+
+    uint32_t version;
+    uint64_t tableCount;
+    bool ok = GetRaw(p, end, version) && version == kColumnVersion && GetVarint(p, end, tableCount);
+    for (uint64_t t = 0; ok && t < tableCount; t++) {
+        ColumnTable table;
+        uint64_t columnCount;
+        ok = GetString(p, end, table.name) && GetVarint(p, end, columnCount) && columnCount <= 4096;
+        for (uint64_t c = 0; ok && c < columnCount; c++) {
+            ColumnInfo column;
+            uint8_t type = 0;
+            ok = GetString(p, end, column.name) && GetRaw(p, end, type) && type <= uint8_t(ColumnType::String);
+            column.type = static_cast<ColumnType>(type);
+            table.columns.push_back(column);
+        }
+        uint64_t groupCount;
+        ok = ok && GetVarint(p, end, table.rows) && GetVarint(p, end, groupCount);
+        uint64_t nextRow = 0;
+        for (uint64_t g = 0; ok && g < groupCount; g++) {
+            ColumnRowGroup group;
+            uint64_t rows = 0;
+            ok = GetVarint(p, end, group.firstRow) && GetVarint(p, end, rows) && group.firstRow == nextRow &&
+                 rows <= UINT32_MAX;
+            group.rows = static_cast<uint32_t>(rows);
+            nextRow += rows;
+            for (uint64_t c = 0; ok && c < columnCount; c++) {
+                ColumnChunkInfo chunk;
+                uint64_t chunkSize = 0;
+                uint8_t encoding = 0;
+                ok = GetVarint(p, end, chunk.offset) && GetVarint(p, end, chunkSize) && GetRaw(p, end, encoding) &&
+                     GetRaw(p, end, chunk.min.i) && GetRaw(p, end, chunk.max.i) &&
+                     encoding <= uint8_t(ColumnEncoding::XorFloat) && chunk.offset >= sizeof(kColumnMagic) &&
+                     chunk.offset <= chunksEnd && chunkSize <= chunksEnd - chunk.offset;
+                chunk.size = static_cast<uint32_t>(chunkSize);
+                chunk.encoding = static_cast<ColumnEncoding>(encoding);
+                group.chunks.push_back(chunk);
+            }
+            table.rowGroups.push_back(group);
+        }
+        ok = ok && nextRow == table.rows;
+        tables_.push_back(table);
+    }
+    if (!ok) {
+        Close();
+        return false;
+    }
+    return true;
+}
+
+void ColumnFileReader::Close() {
+    if (map_) munmap(const_cast<uint8_t*>(map_), mapLength_);
+    map_ = nullptr;
+    mapLength_ = 0;
+    tables_.clear();
+}
+
+int ColumnFileReader::FindTable(const char* name) const {
+    for (size_t i = 0; i < tables_.size(); i++) {
+        if (tables_[i].name == name) return static_cast<int>(i);
+    }
+    return -1;
+}
+
+int ColumnFileReader::FindColumn(int table, const char* name) const {
+    if (table < 0 || static_cast<size_t>(table) >= tables_.size()) return -1;
+    const std::vector<ColumnInfo>& columns = tables_[table].columns;
+    for (size_t i = 0; i < columns.size(); i++) {
+        if (columns[i].name == name) return static_cast<int>(i);
+    }
+    return -1;
+}
+
+bool ColumnFileReader::ReadChunk(int table, size_t rowGroup, int column, ColumnChunkData& out) const {
+    if (table < 0 || static_cast<size_t>(table) >= tables_.size()) return false;
+    const ColumnTable& t = tables_[table];
+    if (rowGroup >= t.rowGroups.size() || column < 0 || static_cast<size_t>(column) >= t.columns.size()) return false;
+
+    const ColumnRowGroup& group = t.rowGroups[rowGroup];
+    const ColumnChunkInfo& chunk = group.chunks[column];
+    const uint8_t* p = map_ + chunk.offset;
+    const uint8_t* end = p + chunk.size;
+    size_t rows = group.rows;
+
+    switch (t.columns[column].type) {
+        case ColumnType::Int:
+            out.ints.resize(rows);
+            return DecodeInts(chunk.encoding, p, end, rows, out.ints.data());
+        case ColumnType::Float:
+            out.floats.resize(rows);
+            return DecodeFloats(chunk.encoding, p, end, rows, out.floats.data());
+        case ColumnType::String: {
+            uint64_t count;
+            if (chunk.encoding != ColumnEncoding::Dictionary || !GetVarint(p, end, count) ||
+                count > static_cast<uint64_t>(end - p)) {
+                return false;
+            }
+            out.dictionary.resize(static_cast<size_t>(count));
+            for (std::string& text : out.dictionary) {
+                if (!GetString(p, end, text)) return false;
+            }
+            out.ints.resize(rows);
+            if (!codec::DecodeFrameOfRef(p, end, rows, out.ints.data()) || p != end) return false;
+            for (int64_t index : out.ints) {
+                if (static_cast<uint64_t>(index) >= count) return false;
+            }
+            return true;
+        }
+    }
+    return false;
+}
+
+bool ColumnFileReader::RowGroupMayMatch(int table, size_t rowGroup, int column, ColumnValue lo, ColumnValue hi) const {
+    const ColumnTable& t = tables_[table];
+    const ColumnChunkInfo& chunk = t.rowGroups[rowGroup].chunks[column];
+    switch (t.columns[column].type) {
+        case ColumnType::Int:
+            return chunk.max.i >= lo.i && chunk.min.i <= hi.i;
+        case ColumnType::Float:
+            return chunk.max.f >= lo.f && chunk.min.f <= hi.f;
+        case ColumnType::String:
+            return true;                                    // Indices say nothing about the strings
+    }
+    return true;
+}
+
+void ColumnFileReader::Prefetch(int table, size_t rowGroup, int column) const {
+    const ColumnChunkInfo& chunk = tables_[table].rowGroups[rowGroup].chunks[column];
+    uintptr_t page = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+    uintptr_t begin = reinterpret_cast<uintptr_t>(map_ + chunk.offset) & ~(page - 1);
+    uintptr_t end = reinterpret_cast<uintptr_t>(map_ + chunk.offset + chunk.size);
+    madvise(reinterpret_cast<void*>(begin), end - begin, MADV_WILLNEED);
+}
+
+ColumnScanner::ColumnScanner(const ColumnFileReader& reader, int table, int column)
+    : reader_(reader), table_(table), column_(column) {
+    lo_.i = 0;
+    hi_.i = 0;
+    valid_ = table >= 0 && static_cast<size_t>(table) < reader.GetTableCount() && column >= 0 &&
+             static_cast<size_t>(column) < reader.GetTable(table).columns.size();
+}
+
+void ColumnScanner::SetIntRange(int64_t lo, int64_t hi) {
+    ranged_ = true;
+    lo_.i = lo;
+    hi_.i = hi;
+}
+
+void ColumnScanner::SetFloatRange(double lo, double hi) {
+    ranged_ = true;
+    lo_.f = lo;
+    hi_.f = hi;
+}
+
+size_t ColumnScanner::Next() {
+    if (!valid_) return 0;
+    const std::vector<ColumnRowGroup>& groups = reader_.GetTable(table_).rowGroups;
+    while (next_ < groups.size() && ranged_ && !reader_.RowGroupMayMatch(table_, next_, column_, lo_, hi_)) {
+        next_++;
+        skipped_++;
+    }
+    if (next_ >= groups.size()) return 0;
+
+    group_ = next_++;
+    if (next_ < groups.size()) reader_.Prefetch(table_, next_, column_);
+    if (!reader_.ReadChunk(table_, group_, column_, data_)) {
+        valid_ = false;
+        return 0;
+    }
+    return groups[group_].rows;
+}
+
+uint64_t ColumnScanner::GetFirstRow() const {
+    return reader_.GetTable(table_).rowGroups[group_].firstRow;
+}
+
+} // namespace ui
@@ -0,0 +1,248 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace ui {
+
+/**
+ * Columnar file: tables of typed columns split into row groups
+ *
+ * Every column of a row group is stored as one chunk with its own encoding,
+ * chosen by the writer as the smallest that fits the chunk (the streams are
+ * the block codecs of telemetry_codec.h):
+ *   Plain         raw little-endian values (8-byte ints, 4-byte floats)
+ *   Delta         differences (floats: of the bit patterns)
+ *   DeltaOfDelta  differences of differences (timestamps)
+ *   FrameOfRef    values minus the block minimum (booleans, enums)
+ *   XorFloat      XOR of consecutive float bit patterns
+ *   Dictionary    strings: distinct values once, then FrameOfRef indices
+ * The footer holds the schema and, per chunk, its location and min/max,
+ * so a scan can skip row groups that cannot match a predicate without
+ * touching them. Layout:
+ *
+ *   "SESSCOL1" | chunks ... | footer | u32 footer size | u32 footer CRC | "SESSCOL1"
+ */
+enum class ColumnType : uint8_t {
+    Int,        // int64 values (booleans and enums too)
+    Float,      // float32 values
+    String,     // Dictionary-encoded; read back as dictionary indices
+};
+
+enum class ColumnEncoding : uint8_t {
+    Plain,
+    Delta,
+    FrameOfRef,
+    Dictionary,
+    DeltaOfDelta,
+    XorFloat,
+    Count
+};
+
+/**
+ * Chunk min/max: i for Int and String (dictionary indices), f for Float
+ */
+union ColumnValue {
+    int64_t i;
+    double f;
+};
+
+struct ColumnChunkInfo {
+    uint64_t offset;            // From the start of the file
+    uint32_t size;
+    ColumnEncoding encoding;
+    ColumnValue min;
+    ColumnValue max;
+};
+
+struct ColumnRowGroup {
+    uint64_t firstRow;
+    uint32_t rows;
+    std::vector<ColumnChunkInfo> chunks;    // One per column
+};
+
+struct ColumnInfo {
+    std::string name;
+    ColumnType type;
+};
+
+struct ColumnTable {
+    std::string name;
+    std::vector<ColumnInfo> columns;
+    std::vector<ColumnRowGroup> rowGroups;
+    uint64_t rows = 0;
+};
+
+/**
+ * Values of one column for ColumnFileWriter::WriteRowGroup(); set the
+ * pointer matching the column type
+ */
+struct ColumnSlice {
+    const int64_t* ints = nullptr;
+    const float* floats = nullptr;
+    const std::string* strings = nullptr;
+};
+
+/**
+ * Writes a columnar file (POSIX)
+ *
+ * Chunks are written as row groups arrive, so memory use is bounded by one
+ * row group whatever the file size; the footer is written by Close().
+ *
+ * @code
+ *   ui::ColumnFileWriter writer;
+ *   writer.Open("out.col");
+ *   int table = writer.AddTable("signals", { { "time_ns", ui::ColumnType::Int }, ... });
+ *   ui::ColumnSlice slices[] = { { times.data() }, ... };
+ *   writer.WriteRowGroup(table, slices, times.size());
+ *   writer.Close();
+ * @endcode
+ */
+class ColumnFileWriter {
+public:
+    ColumnFileWriter() = default;
+    ~ColumnFileWriter();
+
+    ColumnFileWriter(const ColumnFileWriter&) = delete;
+    ColumnFileWriter& operator=(const ColumnFileWriter&) = delete;
+
+    bool Open(const char* path);
+
+    /**
+     * Write the footer and close
+     * @return false if the file was not open or a write failed
+     */
+    bool Close();
+
+    bool IsOpen() const { return fd_ >= 0; }
+
+    /**
+     * Declare a table (before or between row groups)
+     * @return table index
+     */
+    int AddTable(const char* name, const std::vector<ColumnInfo>& columns);
+
+    /**
+     * Encode and write one row group
+     * @param slices One per column of the table, rows values each
+     */
+    bool WriteRowGroup(int table, const ColumnSlice* slices, size_t rows);
+
+    uint64_t GetBytesWritten() const { return offset_; }
+
+private:
+    bool WriteChunk(const std::vector<uint8_t>& chunk);
+
+    int fd_ = -1;
+    bool failed_ = false;
+    uint64_t offset_ = 0;
+    std::vector<ColumnTable> tables_;
+    std::vector<uint8_t> chunk_;            // Reused encode buffers
+    std::vector<uint8_t> scratch_;
+    std::vector<int64_t> ints_;
+};
+
+/**
+ * One decoded chunk (buffers reused across calls)
+ */
+struct ColumnChunkData {
+    std::vector<int64_t> ints;                  // Int, and String dictionary indices
+    std::vector<float> floats;                  // Float
+    std::vector<std::string> dictionary;        // String
+};
+
+/**
+ * Reads a columnar file through a read-only mapping (POSIX)
+ */
+class ColumnFileReader {
+public:
+    ColumnFileReader() = default;
+    ~ColumnFileReader();
+
+    ColumnFileReader(const ColumnFileReader&) = delete;
+    ColumnFileReader& operator=(const ColumnFileReader&) = delete;
+
+    /**
+     * @return false if the file is missing, truncated or its footer is corrupt
+     */
+    bool Open(const char* path);
+    void Close();
+    bool IsOpen() const { return map_ != nullptr; }
+
+    size_t GetTableCount() const { return tables_.size(); }
+    const ColumnTable& GetTable(size_t table) const { return tables_[table]; }
+    int FindTable(const char* name) const;
+    int FindColumn(int table, const char* name) const;
+    uint64_t GetSize() const { return mapLength_; }
+
+    /**
+     * Decode one chunk
+     * @return false if the chunk is malformed
+     */
+    bool ReadChunk(int table, size_t rowGroup, int column, ColumnChunkData& out) const;
+
+    /**
+     * False if the chunk's min/max shows no value can lie in [lo, hi]
+     */
+    bool RowGroupMayMatch(int table, size_t rowGroup, int column, ColumnValue lo, ColumnValue hi) const;
+
+    /**
+     * Ask the kernel to read a chunk ahead (sequential scans)
+     */
+    void Prefetch(int table, size_t rowGroup, int column) const;
+
+private:
+    const uint8_t* map_ = nullptr;
+    size_t mapLength_ = 0;
+    std::vector<ColumnTable> tables_;
+};
+
+/**
+ * Streams one column chunk by chunk, optionally skipping row groups whose
+ * statistics rule out a value range
+ *
+ * @code
+ *   ui::ColumnScanner scan(reader, table, reader.FindColumn(table, "speed"));
+ *   scan.SetIntRange(100, INT64_MAX);           // Only groups that reached 100 km/h
+ *   while (size_t rows = scan.Next()) {
+ *       const int64_t* speed = scan.GetData().ints.data();
+ *       ...
+ *   }
+ * @endcode
+ */
+class ColumnScanner {
+public:
+    ColumnScanner(const ColumnFileReader& reader, int table, int column);
+
+    void SetIntRange(int64_t lo, int64_t hi);
+    void SetFloatRange(double lo, double hi);
+
+    /**
+     * Decode the next matching row group
+     * @return its row count, 0 at the end (or on a malformed chunk, see IsValid)
+     */
+    size_t Next();
+
+    const ColumnChunkData& GetData() const { return data_; }
+    size_t GetRowGroup() const { return group_; }          // Of the last Next()
+    uint64_t GetFirstRow() const;
+    size_t GetSkippedGroups() const { return skipped_; }
+    bool IsValid() const { return valid_; }
+
+private:
+    const ColumnFileReader& reader_;
+    int table_;
+    int column_;
+    bool ranged_ = false;
+    ColumnValue lo_;
+    ColumnValue hi_;
+    size_t next_ = 0;
+    size_t group_ = 0;
+    size_t skipped_ = 0;
+    bool valid_ = true;
+    ColumnChunkData data_;
+};
+
+} // namespace ui
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace ui {
+
+/**
+ * CRC-32 (IEEE 802.3, reflected polynomial 0xEDB88320)
+ * Same table as Dear ImGui's ImHashStr/ImHashData.
+ */
+struct Crc32Table {
+    uint32_t entries[256];
+
+    constexpr Crc32Table() : entries() {
+        for (uint32_t i = 0; i < 256; i++) {
+            uint32_t crc = i;
+            for (int bit = 0; bit < 8; bit++) {
+                crc = (crc & 1) ? (crc >> 1) ^ 0xEDB88320u : (crc >> 1);
+            }
+            entries[i] = crc;
+        }
+    }
+};
+
+inline constexpr Crc32Table kCrc32Table{};
+
+/**
+ * Standard CRC-32 of a buffer (continue a running CRC by passing it as crc)
+ */
+inline uint32_t Crc32(const void* data, size_t size, uint32_t crc = 0) {
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    crc = ~crc;
+    for (size_t i = 0; i < size; i++) {
+        crc = (crc >> 8) ^ kCrc32Table.entries[(crc ^ bytes[i]) & 0xFF];
+    }
+    return ~crc;
+}
+
+} // namespace ui
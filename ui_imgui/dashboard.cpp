@@ -1,6 +1,15 @@
 #include "dashboard.h"
 #include "widgets.h"
 #include "theme.h"
+#include "cell_heatmap.h"
+#include "parallel_draw.h"
+#include "draw_budget.h"
+#include "frame_pacer.h"
+#include "signal_interp.h"
+#include "layout_cache.h"
+#include "signal_freshness.h"
+#include "session_store.h"
+#include <algorithm>
 #include <cstdio>
 #include <cmath>
 #include <ctime>
@@ -36,6 +45,99 @@ static ImVec4 GetSpeedColor(int speed) {
     return Colors::Primary();
 }
 
+// Heartbeat text: red while its feed is stale, amber for a few seconds after
+// a gap in the counter
+static constexpr uint64_t kHeartbeatGapHoldNs = 5000000000ull;
+
+static ImVec4 GetHeartbeatColor(const AppState& state) {
+    if (!state.freshness) return Colors::Primary();
+    if (state.freshness->IsStale(DashboardFeed_Heartbeat)) return Colors::Destructive();
+    uint64_t lastGapNs = state.freshness->GetHeartbeat().GetLastGapNs();
+    if (lastGapNs != 0 && state.freshness->GetLastUpdateNs(DashboardFeed_Heartbeat) - lastGapNs < kHeartbeatGapHoldNs) {
+        return Colors::Warning();
+    }
+    return Colors::Primary();
+}
+
+// Get background, border and icon colors for a fault severity
+static void GetFaultColors(FaultSeverity severity, ImVec4& bgColor, ImVec4& borderColor, ImVec4& iconColor) {
+    switch (severity) {
+        case FaultSeverity::Critical:
+            bgColor = Colors::DestructiveBg();
+            borderColor = ColorWithAlpha(Colors::Destructive(), 0.5f);
+            iconColor = Colors::Destructive();
+            break;
+        case FaultSeverity::Warning:
+            bgColor = Colors::WarningBg();
+            borderColor = ColorWithAlpha(Colors::Warning(), 0.5f);
+            iconColor = Colors::Warning();
+            break;
+        case FaultSeverity::Info:
+        default:
+            bgColor = Colors::PrimaryBg();
+            borderColor = ColorWithAlpha(Colors::Primary(), 0.5f);
+            iconColor = Colors::Primary();
+            break;
+    }
+}
+
+// Icon placeholder text for a fault severity (sizes cached in the layout)
+static LayoutText GetFaultIconText(FaultSeverity severity) {
+    switch (severity) {
+        case FaultSeverity::Critical: return LayoutText_CriticalIcon;
+        case FaultSeverity::Warning:  return LayoutText_WarningIcon;
+        case FaultSeverity::Info:
+        default:                      return LayoutText_InfoIcon;
+    }
+}
+
+static const char* GetFaultIcon(FaultSeverity severity) {
+    return GetLayoutTextString(GetFaultIconText(severity));
+}
+
+// Per-panel geometry budgets (vertices, indices, draw commands), checked when
+// a DrawBudget is attached. Starting points with generous headroom; tighten
+// them from the headless_bench budget table for the cluster SoC.
+static constexpr DrawCost kHeaderBudget = { 2000, 3000, 24 };
+static constexpr DrawCost kBatteryBudget = { 8000, 12000, 80 };
+static constexpr DrawCost kSystemStatusBudget = { 3000, 4500, 40 };
+static constexpr DrawCost kGearBudget = { 1500, 2500, 20 };
+static constexpr DrawCost kSpeedGaugeBudget = { 3000, 6000, 20 };
+static constexpr DrawCost kCruiseBudget = { 2000, 3000, 30 };
+static constexpr DrawCost kCameraBudget = { 3000, 5000, 30 };
+static constexpr DrawCost kFaultPanelBudget = { 12000, 18000, 120 };
+static constexpr DrawCost kTimelineBudget = { 2000, 3000, 30 };
+
+// Pulsing elements (Tailwind animate-pulse: opacity 1 -> 0.5 -> 1 over 2 s)
+// and the frame rates they ask the FramePacer for. The turn indicator is a
+// large, bright button and needs a smooth fade; the LIVE dot is 8 px and
+// looks the same stepped at idle rate.
+static constexpr double kPulseSeconds = 2.0;
+static constexpr double kTurnPulseHz = 20.0;
+static constexpr double kLiveDotHz = 4.0;
+
+static float PulseOpacity() {
+    double phase = std::fmod(ImGui::GetTime(), kPulseSeconds) / kPulseSeconds;
+    return 0.75f + 0.25f * static_cast<float>(std::cos(phase * 2.0 * M_PI));
+}
+
+// Interpolated value for arcs and bars, or the raw one without samples
+static float Smoothed(const AppState& state, DashboardSignal signal, float raw) {
+    return state.signals && state.signals->HasSamples(signal) ? state.signals->Get(signal) : raw;
+}
+
+// Layout used when the application does not attach its own
+static LayoutCache s_layoutCache;
+
+static LayoutCache& GetLayoutCache(const AppState& state) {
+    LayoutCache& cache = state.layout ? *state.layout : s_layoutCache;
+    if (!cache.IsValid()) {
+        // A panel drawn on its own, before any RenderDashboard()
+        cache.Update(ImGui::GetIO().DisplaySize, ImGui::GetFont(), ImGui::GetFontSize());
+    }
+    return cache;
+}
+
 void RenderDashboard(AppState& state) {
     ImGuiIO& io = ImGui::GetIO();
     
@@ -54,65 +156,76 @@ void RenderDashboard(AppState& state) {
     
     ImGui::Begin("Dashboard##Main", nullptr, flags);
     
+    // Recomputed only when the display size or font changed
+    LayoutCache& layoutCache = state.layout ? *state.layout : s_layoutCache;
+    layoutCache.Update(io.DisplaySize, ImGui::GetFont(), ImGui::GetFontSize());
+    const DashboardLayout& layout = layoutCache.Get();
+    
     // Header
-    RenderHeader(state);
+    {
+        DrawBudgetScope budget(state.drawBudget, "Header", kHeaderBudget);
+        RenderHeader(state);
+    }
     
     ImGui::Spacing();
     
-    // Main content area - 3 column layout
-    float availWidth = ImGui::GetContentRegionAvail().x;
-    float leftColWidth = availWidth * 0.15f;
-    float rightColWidth = availWidth * 0.15f;
-    float centerColWidth = availWidth - leftColWidth - rightColWidth - Spacing::ItemSpacing * 2;
-    
-    // Constrain column widths
-    leftColWidth = std::max(180.0f, std::min(250.0f, leftColWidth));
-    rightColWidth = std::max(180.0f, std::min(250.0f, rightColWidth));
-    centerColWidth = availWidth - leftColWidth - rightColWidth - Spacing::ItemSpacing * 2;
+    // Main content area - 3 column layout (widths from the layout profile),
+    // leaving room for the session timeline when one is attached
+    float columnHeight = state.playback ? -(ImGui::GetFrameHeight() + Spacing::ItemSpacing) : 0.0f;
     
     // Left Column - Battery & System Status
-    ImGui::BeginChild("##LeftColumn", ImVec2(leftColWidth, 0), ImGuiChildFlags_None);
+    ImGui::BeginChild("##LeftColumn", ImVec2(layout.leftColumnWidth, columnHeight), ImGuiChildFlags_None);
     {
-        RenderBatteryPanel(state);
+        {
+            DrawBudgetScope budget(state.drawBudget, "BatteryPanel", kBatteryBudget);
+            RenderBatteryPanel(state);
+        }
         widgets::Space(Spacing::ItemSpacing);
-        RenderSystemStatus(state);
+        {
+            DrawBudgetScope budget(state.drawBudget, "SystemStatus", kSystemStatusBudget);
+            RenderSystemStatus(state);
+        }
     }
     ImGui::EndChild();
     
     ImGui::SameLine();
     
     // Center Column - Speed, Gear, Cameras
-    ImGui::BeginChild("##CenterColumn", ImVec2(centerColWidth, 0), ImGuiChildFlags_None);
+    ImGui::BeginChild("##CenterColumn", ImVec2(layout.centerColumnWidth, columnHeight), ImGuiChildFlags_None);
     {
         // Speed & Gear Row
-        float rowHeight = 220.0f;
-        ImGui::BeginChild("##SpeedGearRow", ImVec2(0, rowHeight), ImGuiChildFlags_None);
+        ImGui::BeginChild("##SpeedGearRow", ImVec2(0, layout.speedRowHeight), ImGuiChildFlags_None);
         {
-            float gearWidth = 80.0f;
-            float cruiseWidth = 80.0f;
-            float gaugeWidth = 200.0f;
-            float totalWidth = gearWidth + cruiseWidth + gaugeWidth;
-            float spacing = (ImGui::GetContentRegionAvail().x - totalWidth) / 4.0f;
+            float spacing = layout.speedRowSpacing;
             
             ImGui::SetCursorPosX(spacing);
             
             // Gear Indicator
-            ImGui::BeginChild("##GearPanel", ImVec2(gearWidth, 0), ImGuiChildFlags_None);
-            RenderGearIndicator(state);
+            ImGui::BeginChild("##GearPanel", ImVec2(layout.gearWidth, 0), ImGuiChildFlags_None);
+            {
+                DrawBudgetScope budget(state.drawBudget, "GearIndicator", kGearBudget);
+                RenderGearIndicator(state);
+            }
             ImGui::EndChild();
             
             ImGui::SameLine(0, spacing);
             
             // Speed Gauge
-            ImGui::BeginChild("##SpeedPanel", ImVec2(gaugeWidth, 0), ImGuiChildFlags_None);
-            RenderSpeedGauge(state);
+            ImGui::BeginChild("##SpeedPanel", ImVec2(layout.gaugeWidth, 0), ImGuiChildFlags_None);
+            {
+                DrawBudgetScope budget(state.drawBudget, "SpeedGauge", kSpeedGaugeBudget);
+                RenderSpeedGauge(state);
+            }
             ImGui::EndChild();
             
             ImGui::SameLine(0, spacing);
             
             // Cruise Control
-            ImGui::BeginChild("##CruisePanel", ImVec2(cruiseWidth, 0), ImGuiChildFlags_None);
-            RenderCruiseControl(state);
+            ImGui::BeginChild("##CruisePanel", ImVec2(layout.cruiseWidth, 0), ImGuiChildFlags_None);
+            {
+                DrawBudgetScope budget(state.drawBudget, "CruiseControl", kCruiseBudget);
+                RenderCruiseControl(state);
+            }
             ImGui::EndChild();
         }
         ImGui::EndChild();
@@ -123,17 +236,19 @@ void RenderDashboard(AppState& state) {
         float cameraHeight = ImGui::GetContentRegionAvail().y;
         ImGui::BeginChild("##CameraRow", ImVec2(0, cameraHeight), ImGuiChildFlags_None);
         {
-            float halfWidth = (ImGui::GetContentRegionAvail().x - Spacing::ItemSpacing) * 0.5f;
-            
             // Rear View Camera
-            ImGui::BeginChild("##RearCamera", ImVec2(halfWidth, 0), ImGuiChildFlags_None);
-            RenderCameraFeed("Rear View", "rear", true, state.rearCameraTexture);
+            ImGui::BeginChild("##RearCamera", ImVec2(layout.cameraWidth, 0), ImGuiChildFlags_None);
+            if (state.framePacer) state.framePacer->RequestAnimation(kLiveDotHz);
+            {
+                DrawBudgetScope budget(state.drawBudget, "RearCamera", kCameraBudget);
+                RenderCameraFeed("Rear View", "rear", true, state.rearCameraTexture, state.parallelDraw, &layout);
+            }
             ImGui::EndChild();
             
             ImGui::SameLine();
             
             // Side Camera (changes based on turn signal)
-            ImGui::BeginChild("##SideCamera", ImVec2(halfWidth, 0), ImGuiChildFlags_None);
+            ImGui::BeginChild("##SideCamera", ImVec2(layout.cameraWidth, 0), ImGuiChildFlags_None);
             const char* sideLabel = "Side Camera";
             const char* sideType = "side";
             bool sideActive = false;
@@ -148,7 +263,12 @@ void RenderDashboard(AppState& state) {
                 sideActive = true;
             }
             
-            RenderCameraFeed(sideLabel, sideType, sideActive, state.sideCameraTexture);
+            if (sideActive && state.framePacer) state.framePacer->RequestAnimation(kLiveDotHz);
+            {
+                DrawBudgetScope budget(state.drawBudget, "SideCamera", kCameraBudget);
+                RenderCameraFeed(sideLabel, sideType, sideActive, state.sideCameraTexture, state.parallelDraw,
+                                 &layout);
+            }
             ImGui::EndChild();
         }
         ImGui::EndChild();
@@ -158,12 +278,18 @@ void RenderDashboard(AppState& state) {
     ImGui::SameLine();
     
     // Right Column - Faults
-    ImGui::BeginChild("##RightColumn", ImVec2(rightColWidth, 0), ImGuiChildFlags_None);
+    ImGui::BeginChild("##RightColumn", ImVec2(layout.rightColumnWidth, columnHeight), ImGuiChildFlags_None);
     {
+        DrawBudgetScope budget(state.drawBudget, "FaultPanel", kFaultPanelBudget);
         RenderFaultPanel(state);
     }
     ImGui::EndChild();
     
+    if (state.playback) {
+        DrawBudgetScope budget(state.drawBudget, "SessionTimeline", kTimelineBudget);
+        RenderSessionTimeline(state);
+    }
+    
     ImGui::End();
     
     ImGui::PopStyleColor();
@@ -172,7 +298,8 @@ void RenderDashboard(AppState& state) {
 
 void RenderHeader(AppState& state) {
     // Header bar with title, heartbeat, and turn signals
-    float headerHeight = 40.0f;
+    const DashboardLayout& layout = GetLayoutCache(state).Get();
+    float headerHeight = layout.headerHeight;
     
     ImGui::BeginChild("##Header", ImVec2(0, headerHeight), ImGuiChildFlags_None);
     {
@@ -181,93 +308,139 @@ void RenderHeader(AppState& state) {
         ImGui::Text("Vehicle Telemetry");
         
         // Center section with turn signals and heartbeat
-        float centerWidth = 200.0f;
-        float centerX = (ImGui::GetContentRegionAvail().x - centerWidth) * 0.5f + ImGui::GetCursorPosX();
-        
-        ImGui::SameLine(centerX);
+        ImGui::SameLine(layout.headerCenterX);
         ImGui::SetCursorPosY(5.0f);
         
+        if (state.turnSignal != TurnSignal::None && state.framePacer) {
+            state.framePacer->RequestAnimation(kTurnPulseHz);
+        }
+
+        bool turnStale = IsFeedStale(state, DashboardFeed_TurnSignal);
+        
         // Left turn indicator
+        widgets::BeginStale(turnStale);
         if (RenderTurnIndicator(true, state.turnSignal == TurnSignal::Left)) {
             state.turnSignal = (state.turnSignal == TurnSignal::Left) ? TurnSignal::None : TurnSignal::Left;
         }
+        widgets::EndStale();
         
         ImGui::SameLine();
         
-        // Heartbeat display
-        if (widgets::BeginCard("##Heartbeat", ImVec2(70, 30), true)) {
+        // Heartbeat display: red once beats stop, amber for a while after a gap
+        ImVec4 hbColor = GetHeartbeatColor(state);
+        widgets::BeginFlatCard(ImVec2(70, 30), Colors::Card(), Colors::Border(), ImVec2(Spacing::CardPadding, 5.0f));
+        {
             char hbText[16];
             snprintf(hbText, sizeof(hbText), "HB %03d", state.heartbeat);
-            ImGui::PushStyleColor(ImGuiCol_Text, Colors::Primary());
-            ImGui::SetCursorPosY(5.0f);
+            ImGui::PushStyleColor(ImGuiCol_Text, hbColor);
             ImGui::Text("%s", hbText);
             ImGui::PopStyleColor();
         }
-        widgets::EndCard();
+        widgets::EndFlatCard();
+        if (state.freshness && ImGui::IsItemHovered()) {
+            const HeartbeatStats& hb = state.freshness->GetHeartbeat().GetStats();
+            ImGui::SetTooltip("%llu beats, %llu gaps (%llu missed), %llu restarts",
+                              static_cast<unsigned long long>(hb.beats), static_cast<unsigned long long>(hb.gaps),
+                              static_cast<unsigned long long>(hb.missed), static_cast<unsigned long long>(hb.resets));
+        }
         
         ImGui::SameLine();
         
         // Right turn indicator
+        widgets::BeginStale(turnStale);
         if (RenderTurnIndicator(false, state.turnSignal == TurnSignal::Right)) {
             state.turnSignal = (state.turnSignal == TurnSignal::Right) ? TurnSignal::None : TurnSignal::Right;
         }
+        widgets::EndStale();
     }
     ImGui::EndChild();
 }
 
+// Speed gauge geometry, built on a ParallelDraw worker when one is attached
+struct SpeedGaugeDraw {
+    ImVec2 center;
+    float radius;
+    float thickness;
+    float startAngle;
+    float maxAngle;
+    float percentage;
+    int numSegments;
+    ImU32 trackColor;
+    ImU32 progressColor;
+    ImU32 speedColor;
+    ImU32 unitColor;
+    ImFont* font;
+    float speedFontSize;
+    float unitFontSize;
+    ImVec2 speedPos;
+    ImVec2 unitPos;
+    char speedText[16];
+};
+
+static void BuildSpeedGauge(ImDrawList& drawList, const SpeedGaugeDraw& d) {
+    // Background arc
+    drawList.PathArcTo(d.center, d.radius - d.thickness * 0.5f, d.startAngle, d.startAngle + d.maxAngle, d.numSegments);
+    drawList.PathStroke(d.trackColor, 0, d.thickness);
+    
+    // Progress arc
+    if (d.percentage > 0.001f) {
+        float progressAngle = d.maxAngle * d.percentage;
+        drawList.PathArcTo(d.center, d.radius - d.thickness * 0.5f, d.startAngle, d.startAngle + progressAngle, d.numSegments);
+        drawList.PathStroke(d.progressColor, 0, d.thickness);
+    }
+    
+    drawList.AddText(d.font, d.speedFontSize, d.speedPos, d.speedColor, d.speedText);
+    drawList.AddText(d.font, d.unitFontSize, d.unitPos, d.unitColor, "km/h");
+}
+
 void RenderSpeedGauge(const AppState& state) {
     if (!widgets::BeginCard("##SpeedGauge", ImVec2(0, 0), true)) {
         widgets::EndCard();
         return;
     }
     
-    ImDrawList* drawList = ImGui::GetWindowDrawList();
     ImVec2 pos = ImGui::GetCursorScreenPos();
     ImVec2 size = ImGui::GetContentRegionAvail();
     
-    float radius = std::min(size.x, size.y) * 0.45f;
-    float thickness = 12.0f;
-    ImVec2 center = ImVec2(pos.x + size.x * 0.5f, pos.y + size.y * 0.5f);
+    SpeedGaugeDraw d;
+    d.radius = std::min(size.x, size.y) * 0.45f;
+    d.thickness = 12.0f;
+    d.center = ImVec2(pos.x + size.x * 0.5f, pos.y + size.y * 0.5f);
     
     // Calculate progress
     float maxSpeed = 200.0f;
-    float percentage = static_cast<float>(state.speed) / maxSpeed;
-    percentage = std::max(0.0f, std::min(1.0f, percentage));
+    d.percentage = Smoothed(state, DashboardSignal_Speed, static_cast<float>(state.speed)) / maxSpeed;
+    d.percentage = std::max(0.0f, std::min(1.0f, d.percentage));
     
     // Arc angles (270 degree arc, from bottom-left to bottom-right via top)
-    float startAngle = static_cast<float>(M_PI) * 0.75f;  // 135 degrees
-    float maxAngle = static_cast<float>(M_PI) * 1.5f;     // 270 degrees sweep
-    int numSegments = 64;
-    
-    // Background arc
-    drawList->PathArcTo(center, radius - thickness * 0.5f, startAngle, startAngle + maxAngle, numSegments);
-    drawList->PathStroke(ColorToU32(Colors::Muted()), 0, thickness);
-    
-    // Progress arc
-    if (percentage > 0.001f) {
-        float progressAngle = maxAngle * percentage;
-        ImVec4 speedColor = GetSpeedColor(state.speed);
-        drawList->PathArcTo(center, radius - thickness * 0.5f, startAngle, startAngle + progressAngle, numSegments);
-        drawList->PathStroke(ColorToU32(speedColor), 0, thickness);
-    }
+    d.startAngle = static_cast<float>(M_PI) * 0.75f;  // 135 degrees
+    d.maxAngle = static_cast<float>(M_PI) * 1.5f;     // 270 degrees sweep
+    d.numSegments = 64;
+    // Stale speed: grey arc and number (the gauge may be built on a worker,
+    // outside any BeginStale region)
+    bool stale = IsFeedStale(state, DashboardFeed_Speed);
+    d.trackColor = ColorToU32(Colors::Muted());
+    d.progressColor = ColorToU32(stale ? Colors::MutedForeground() : GetSpeedColor(state.speed));
     
     // Center text
-    char speedText[16];
-    snprintf(speedText, sizeof(speedText), "%d", state.speed);
+    snprintf(d.speedText, sizeof(d.speedText), "%d", state.speed);
+    d.font = ImGui::GetFont();
     
     // Large speed number
-    ImVec2 speedSize = ImGui::CalcTextSize(speedText);
     ImGui::SetWindowFontScale(3.0f);
-    speedSize = ImGui::CalcTextSize(speedText);
-    drawList->AddText(ImVec2(center.x - speedSize.x * 0.5f, center.y - speedSize.y * 0.6f),
-                     ColorToU32(Colors::Foreground()), speedText);
+    ImVec2 speedSize = ImGui::CalcTextSize(d.speedText);
+    d.speedFontSize = ImGui::GetFontSize();
+    d.speedPos = ImVec2(d.center.x - speedSize.x * 0.5f, d.center.y - speedSize.y * 0.6f);
+    d.speedColor = ColorToU32(stale ? Colors::MutedForeground() : Colors::Foreground());
     ImGui::SetWindowFontScale(1.0f);
     
     // km/h unit
-    const char* unit = "km/h";
-    ImVec2 unitSize = ImGui::CalcTextSize(unit);
-    drawList->AddText(ImVec2(center.x - unitSize.x * 0.5f, center.y + 20.0f),
-                     ColorToU32(Colors::MutedForeground()), unit);
+    ImVec2 unitSize = GetLayoutCache(state).Get().text[LayoutText_SpeedUnit];
+    d.unitFontSize = ImGui::GetFontSize();
+    d.unitPos = ImVec2(d.center.x - unitSize.x * 0.5f, d.center.y + 20.0f);
+    d.unitColor = ColorToU32(Colors::MutedForeground());
+    
+    DeferDraw(state.parallelDraw, BuildSpeedGauge, d);
     
     ImGui::Dummy(size);
     
@@ -283,10 +456,19 @@ void RenderGearIndicator(AppState& state) {
     widgets::SectionHeader("GEAR");
     widgets::Space(4.0f);
     
-    const Gear gears[] = { Gear::Park, Gear::Reverse, Gear::Neutral, Gear::Drive };
+    // Button IDs are compile-time constants under a fixed scope
+    static constexpr ImGuiID kGearScope = HashId("Dashboard/Gear");
+    static constexpr struct { Gear gear; ImGuiID id; } gears[] = {
+        { Gear::Park,    HashId("P", kGearScope) },
+        { Gear::Reverse, HashId("R", kGearScope) },
+        { Gear::Neutral, HashId("N", kGearScope) },
+        { Gear::Drive,   HashId("D", kGearScope) },
+    };
     bool disabled = state.speed >= 5;
     
-    for (const Gear& gear : gears) {
+    widgets::BeginStale(IsFeedStale(state, DashboardFeed_Gear));
+    for (const auto& entry : gears) {
+        Gear gear = entry.gear;
         const char* gearStr = GearToString(gear);
         bool isSelected = (state.gear == gear);
         bool isDisabled = disabled && !isSelected;
@@ -309,21 +491,83 @@ void RenderGearIndicator(AppState& state) {
         
         ImGui::PushStyleVar(ImGuiStyleVar_FrameRounding, Rounding::Button);
         
-        char buttonId[32];
-        snprintf(buttonId, sizeof(buttonId), "%s##Gear", gearStr);
-        
-        if (ImGui::Button(buttonId, buttonSize) && !isDisabled) {
+        if (widgets::Button(entry.id, gearStr, buttonSize) && !isDisabled) {
             state.gear = gear;
         }
         
         ImGui::PopStyleVar();
         ImGui::PopStyleColor(3);
     }
+    widgets::EndStale();
     
     widgets::EndCard();
 }
 
-void RenderBatteryPanel(const AppState& state) {
+// Per-cell heatmap with V/T toggle and min/max/delta summary
+static void RenderCellSection(AppState& state) {
+    // Used when the application has not attached a texture-backed heatmap.
+    // Shared by every such state (the live one, a playback view); the map
+    // repaints in full whenever it is drawn from a different state's cells.
+    static CellHeatmap s_quadHeatmap;
+    CellHeatmap& heatmap = state.cellHeatmap ? *state.cellHeatmap : s_quadHeatmap;
+    
+    widgets::BeginFlatCard(ImVec2(0, 0), ColorWithAlpha(Colors::Muted(), 0.5f));
+    {
+        ImGui::Spacing();
+        
+        ImGui::PushStyleColor(ImGuiCol_Text, Colors::MutedForeground());
+        ImGui::Text("[#]");  // Cells icon placeholder
+        ImGui::PopStyleColor();
+        
+        ImGui::SameLine();
+        ImGui::Text("Cells %ds", static_cast<int>(state.cells.CellCount()));
+        
+        // Field toggle
+        static constexpr ImGuiID kCellScope = HashId("Dashboard/Cells");
+        static constexpr struct { CellField field; const char* label; ImGuiID id; } fields[] = {
+            { CellField::Voltage,     "V", HashId("V", kCellScope) },
+            { CellField::Temperature, "T", HashId("T", kCellScope) },
+        };
+        
+        ImVec2 buttonSize(24, 20);
+        ImGui::SameLine(ImGui::GetContentRegionAvail().x - 2 * buttonSize.x - 4);
+        ImGui::PushStyleVar(ImGuiStyleVar_FrameRounding, Rounding::Button);
+        for (const auto& entry : fields) {
+            bool isSelected = state.cellHeatmapField == entry.field;
+            ImGui::PushStyleColor(ImGuiCol_Button, isSelected ? Colors::Primary() : Colors::Muted());
+            ImGui::PushStyleColor(ImGuiCol_ButtonHovered, isSelected ? Colors::Primary() : Colors::Secondary());
+            ImGui::PushStyleColor(ImGuiCol_Text, isSelected ? Colors::PrimaryForeground() : Colors::MutedForeground());
+            if (widgets::Button(entry.id, entry.label, buttonSize)) {
+                state.cellHeatmapField = entry.field;
+            }
+            ImGui::PopStyleColor(3);
+            if (entry.field == CellField::Voltage) ImGui::SameLine(0, 4);
+        }
+        ImGui::PopStyleVar();
+        
+        widgets::Space(4.0f);
+        
+        // Summary for the shown field
+        const CellStats& stats = state.cells.Stats(state.cellHeatmapField);
+        ImGui::PushStyleColor(ImGuiCol_Text, Colors::MutedForeground());
+        if (state.cellHeatmapField == CellField::Voltage) {
+            ImGui::Text("%.3f - %.3f V  (%.0f mV)", stats.min, stats.max, stats.Delta() * 1000.0f);
+        } else {
+            ImGui::Text("%.1f - %.1f C  (%.1f C)", stats.min, stats.max, stats.Delta());
+        }
+        ImGui::PopStyleColor();
+        if (ImGui::IsItemHovered()) {
+            ImGui::SetTooltip("Min cell %d, max cell %d", stats.minCell + 1, stats.maxCell + 1);
+        }
+        
+        widgets::Space(4.0f);
+        
+        heatmap.Render("##CellHeatmap", state.cells, state.cellHeatmapField, ImVec2(0, 0), state.parallelDraw);
+    }
+    widgets::EndFlatCard();
+}
+
+void RenderBatteryPanel(AppState& state) {
     if (!widgets::BeginCard("##BatteryPanel", ImVec2(0, 0), true)) {
         widgets::EndCard();
         return;
@@ -333,8 +577,8 @@ void RenderBatteryPanel(const AppState& state) {
     widgets::Space(Spacing::SmallPadding);
     
     // Main Battery Section
-    ImGui::PushStyleColor(ImGuiCol_ChildBg, ColorWithAlpha(Colors::Muted(), 0.5f));
-    ImGui::BeginChild("##MainBattery", ImVec2(0, 150), ImGuiChildFlags_Borders);
+    widgets::BeginFlatCard(ImVec2(0, 150), ColorWithAlpha(Colors::Muted(), 0.5f));
+    widgets::BeginStale(IsFeedStale(state, DashboardFeed_MainBattery));
     {
         ImGui::Spacing();
         
@@ -359,27 +603,29 @@ void RenderBatteryPanel(const AppState& state) {
         widgets::Space(4.0f);
         
         // SOC Progress Bar
-        widgets::ProgressBar(state.mainBattery.soc / 100.0f, ImVec2(-1, 8), GetBatteryColor(state.mainBattery.soc));
+        float mainSoc = Smoothed(state, DashboardSignal_MainSoc, state.mainBattery.soc);
+        widgets::ProgressBar(mainSoc / 100.0f, ImVec2(-1, 8), GetBatteryColor(state.mainBattery.soc));
         
         widgets::Space(Spacing::SmallPadding);
         
         // Voltage and Current row
         float halfWidth = (ImGui::GetContentRegionAvail().x - 8) * 0.5f;
         
-        ImGui::PushStyleColor(ImGuiCol_ChildBg, ColorWithAlpha(Colors::Background(), 0.5f));
+        ImVec4 tileColor = ColorWithAlpha(Colors::Background(), 0.5f);
+        ImVec4 noBorder = ImVec4(0, 0, 0, 0);
         
-        ImGui::BeginChild("##Voltage", ImVec2(halfWidth, 40), ImGuiChildFlags_None);
+        widgets::BeginFlatCard(ImVec2(halfWidth, 40), tileColor, noBorder, ImVec2(0, 0));
         {
             ImGui::PushStyleColor(ImGuiCol_Text, Colors::MutedForeground());
             ImGui::Text("Voltage");
             ImGui::PopStyleColor();
             ImGui::Text("%.1f V", state.mainBattery.voltage);
         }
-        ImGui::EndChild();
+        widgets::EndFlatCard();
         
         ImGui::SameLine();
         
-        ImGui::BeginChild("##Current", ImVec2(halfWidth, 40), ImGuiChildFlags_None);
+        widgets::BeginFlatCard(ImVec2(halfWidth, 40), tileColor, noBorder, ImVec2(0, 0));
         {
             ImGui::PushStyleColor(ImGuiCol_Text, Colors::MutedForeground());
             ImGui::Text("Current");
@@ -398,16 +644,13 @@ void RenderBatteryPanel(const AppState& state) {
             }
             ImGui::PopStyleColor();
         }
-        ImGui::EndChild();
-        
-        ImGui::PopStyleColor();
+        widgets::EndFlatCard();
         
         // Power display (if current is non-zero)
         if (std::abs(state.mainBattery.current) > 0.1f) {
             widgets::Space(4.0f);
             
-            ImGui::PushStyleColor(ImGuiCol_ChildBg, ColorWithAlpha(Colors::Background(), 0.5f));
-            ImGui::BeginChild("##Power", ImVec2(0, 30), ImGuiChildFlags_None);
+            widgets::BeginFlatCard(ImVec2(0, 30), tileColor, noBorder, ImVec2(0, 0));
             {
                 ImVec4 powerColor = state.mainBattery.current < 0 ? Colors::Accent() : Colors::Success();
                 ImGui::PushStyleColor(ImGuiCol_Text, powerColor);
@@ -425,18 +668,17 @@ void RenderBatteryPanel(const AppState& state) {
                 ImGui::Text("%.1f kW", power);
                 ImGui::PopStyleColor();
             }
-            ImGui::EndChild();
-            ImGui::PopStyleColor();
+            widgets::EndFlatCard();
         }
     }
-    ImGui::EndChild();
-    ImGui::PopStyleColor();
+    widgets::EndStale();
+    widgets::EndFlatCard();
     
     widgets::Space(Spacing::SmallPadding);
     
     // Supplementary Battery Section
-    ImGui::PushStyleColor(ImGuiCol_ChildBg, ColorWithAlpha(Colors::Muted(), 0.5f));
-    ImGui::BeginChild("##SuppBattery", ImVec2(0, 80), ImGuiChildFlags_Borders);
+    widgets::BeginFlatCard(ImVec2(0, 80), ColorWithAlpha(Colors::Muted(), 0.5f));
+    widgets::BeginStale(IsFeedStale(state, DashboardFeed_SuppBattery));
     {
         ImGui::Spacing();
         
@@ -459,17 +701,28 @@ void RenderBatteryPanel(const AppState& state) {
         
         // SOC Progress Bar (thinner)
         ImVec4 barColor = state.suppBattery.soc < 30 ? Colors::Destructive() : Colors::MutedForeground();
-        widgets::ProgressBar(state.suppBattery.soc / 100.0f, ImVec2(-1, 6), barColor);
+        float suppSoc = Smoothed(state, DashboardSignal_SuppSoc, state.suppBattery.soc);
+        widgets::ProgressBar(suppSoc / 100.0f, ImVec2(-1, 6), barColor);
         
         widgets::Space(4.0f);
         
         // Voltage
         char voltageStr[16];
         snprintf(voltageStr, sizeof(voltageStr), "%.1f V", state.suppBattery.voltage);
-        widgets::KeyValue("Voltage", voltageStr, Colors::Foreground());
+        widgets::KeyValue("Voltage", voltageStr, GetLayoutCache(state).TextWidth(voltageStr), Colors::Foreground());
+    }
+    widgets::EndStale();
+    widgets::EndFlatCard();
+    
+    // Cell Section (only when the BMS reports cells; sessions do not record
+    // cells, so never while a playback view is shown)
+    bool playbackView = state.playback && state.playback->IsActive();
+    if (state.cells.CellCount() > 0 && !playbackView) {
+        widgets::Space(Spacing::SmallPadding);
+        widgets::BeginStale(IsFeedStale(state, DashboardFeed_Cells));
+        RenderCellSection(state);
+        widgets::EndStale();
     }
-    ImGui::EndChild();
-    ImGui::PopStyleColor();
     
     widgets::EndCard();
 }
@@ -482,6 +735,7 @@ void RenderCruiseControl(AppState& state) {
     
     widgets::SectionHeader("CRUISE");
     widgets::Space(4.0f);
+    widgets::BeginStale(IsFeedStale(state, DashboardFeed_Cruise));
     
     // Center the button
     float buttonSize = 48.0f;
@@ -544,6 +798,7 @@ void RenderCruiseControl(AppState& state) {
         
         ImGui::PopStyleVar();
     }
+    widgets::EndStale();
     
     widgets::EndCard();
 }
@@ -553,6 +808,7 @@ void RenderSystemStatus(AppState& state) {
         widgets::EndCard();
         return;
     }
+    const DashboardLayout& layout = GetLayoutCache(state).Get();
     
     widgets::SectionHeader("SYSTEM STATUS");
     widgets::Space(Spacing::SmallPadding);
@@ -563,12 +819,15 @@ void RenderSystemStatus(AppState& state) {
     ImGui::PopStyleColor();
     widgets::Space(4.0f);
     
+    // Status rows are flat cards; clickable ones end with EndFlatCardButton
+    ImVec4 rowColor = ColorWithAlpha(Colors::Muted(), 0.5f);
+    ImVec2 rowPadding = ImVec2(Spacing::CardPadding, 7.0f);
+    
+    widgets::BeginStale(IsFeedStale(state, DashboardFeed_Contactors));
+    
     // Main contactor button
-    ImGui::PushStyleColor(ImGuiCol_ChildBg, ColorWithAlpha(Colors::Muted(), 0.5f));
-    ImGui::BeginChild("##MainContactor", ImVec2(0, 35), ImGuiChildFlags_Borders);
-    {
-        ImGui::SetCursorPosY(7);
-        
+    widgets::BeginFlatCard(ImVec2(0, 35), rowColor, Colors::Border(), rowPadding);
+    {        
         // Icon
         ImVec4 iconColor = state.contactorStates.main ? Colors::Success() : Colors::MutedForeground();
         ImGui::PushStyleColor(ImGuiCol_Text, iconColor);
@@ -581,28 +840,21 @@ void RenderSystemStatus(AppState& state) {
         // Status badge
         ImGui::SameLine(ImGui::GetContentRegionAvail().x - 50);
         if (state.contactorStates.main) {
-            widgets::Badge("CLOSED", Colors::SuccessBg(), Colors::Success());
+            widgets::Badge("CLOSED", layout.text[LayoutText_Closed], Colors::SuccessBg(), Colors::Success());
         } else {
-            widgets::Badge("OPEN", Colors::Muted(), Colors::MutedForeground());
-        }
-        
-        // Make it clickable
-        ImGui::SetCursorPos(ImVec2(0, 0));
-        if (ImGui::InvisibleButton("##MainContactorBtn", ImGui::GetContentRegionAvail())) {
-            state.contactorStates.main = !state.contactorStates.main;
+            widgets::Badge("OPEN", layout.text[LayoutText_Open], Colors::Muted(), Colors::MutedForeground());
         }
     }
-    ImGui::EndChild();
-    ImGui::PopStyleColor();
+    // The whole row is clickable
+    if (widgets::EndFlatCardButton("##MainContactorBtn")) {
+        state.contactorStates.main = !state.contactorStates.main;
+    }
     
     widgets::Space(4.0f);
     
     // Precharge contactor button
-    ImGui::PushStyleColor(ImGuiCol_ChildBg, ColorWithAlpha(Colors::Muted(), 0.5f));
-    ImGui::BeginChild("##PrechargeContactor", ImVec2(0, 35), ImGuiChildFlags_Borders);
-    {
-        ImGui::SetCursorPosY(7);
-        
+    widgets::BeginFlatCard(ImVec2(0, 35), rowColor, Colors::Border(), rowPadding);
+    {        
         // Icon
         ImVec4 iconColor = state.contactorStates.precharge ? Colors::Success() : Colors::MutedForeground();
         ImGui::PushStyleColor(ImGuiCol_Text, iconColor);
@@ -615,28 +867,21 @@ void RenderSystemStatus(AppState& state) {
         // Status badge
         ImGui::SameLine(ImGui::GetContentRegionAvail().x - 55);
         if (state.contactorStates.precharge) {
-            widgets::Badge("ACTIVE", Colors::SuccessBg(), Colors::Success());
+            widgets::Badge("ACTIVE", layout.text[LayoutText_Active], Colors::SuccessBg(), Colors::Success());
         } else {
-            widgets::Badge("INACTIVE", Colors::Muted(), Colors::MutedForeground());
-        }
-        
-        // Make it clickable
-        ImGui::SetCursorPos(ImVec2(0, 0));
-        if (ImGui::InvisibleButton("##PrechargeBtn", ImGui::GetContentRegionAvail())) {
-            state.contactorStates.precharge = !state.contactorStates.precharge;
+            widgets::Badge("INACTIVE", layout.text[LayoutText_Inactive], Colors::Muted(), Colors::MutedForeground());
         }
     }
-    ImGui::EndChild();
-    ImGui::PopStyleColor();
+    // The whole row is clickable
+    if (widgets::EndFlatCardButton("##PrechargeBtn")) {
+        state.contactorStates.precharge = !state.contactorStates.precharge;
+    }
     
     widgets::Space(4.0f);
     
     // HVIL status (read-only display)
-    ImGui::PushStyleColor(ImGuiCol_ChildBg, ColorWithAlpha(Colors::Muted(), 0.5f));
-    ImGui::BeginChild("##HVILStatus", ImVec2(0, 35), ImGuiChildFlags_Borders);
-    {
-        ImGui::SetCursorPosY(7);
-        
+    widgets::BeginFlatCard(ImVec2(0, 35), rowColor, Colors::Border(), rowPadding);
+    {        
         // Icon
         ImVec4 iconColor = state.contactorStates.hvil ? Colors::Success() : Colors::Destructive();
         ImGui::PushStyleColor(ImGuiCol_Text, iconColor);
@@ -649,13 +894,14 @@ void RenderSystemStatus(AppState& state) {
         // Status badge
         ImGui::SameLine(ImGui::GetContentRegionAvail().x - 40);
         if (state.contactorStates.hvil) {
-            widgets::Badge("OK", Colors::SuccessBg(), Colors::Success());
+            widgets::Badge("OK", layout.text[LayoutText_Ok], Colors::SuccessBg(), Colors::Success());
         } else {
-            widgets::Badge("FAULT", Colors::DestructiveBg(), Colors::Destructive());
+            widgets::Badge("FAULT", layout.text[LayoutText_Fault], Colors::DestructiveBg(), Colors::Destructive());
         }
     }
-    ImGui::EndChild();
-    ImGui::PopStyleColor();
+    widgets::EndFlatCard();
+    
+    widgets::EndStale();
     
     widgets::Space(Spacing::SmallPadding);
     
@@ -666,11 +912,9 @@ void RenderSystemStatus(AppState& state) {
     widgets::Space(4.0f);
     
     // Brake status button
-    ImGui::PushStyleColor(ImGuiCol_ChildBg, ColorWithAlpha(Colors::Muted(), 0.5f));
-    ImGui::BeginChild("##BrakeStatus", ImVec2(0, 35), ImGuiChildFlags_Borders);
-    {
-        ImGui::SetCursorPosY(7);
-        
+    widgets::BeginStale(IsFeedStale(state, DashboardFeed_Brake));
+    widgets::BeginFlatCard(ImVec2(0, 35), rowColor, Colors::Border(), rowPadding);
+    {        
         // Status indicator dot
         ImDrawList* drawList = ImGui::GetWindowDrawList();
         ImVec2 dotPos = ImGui::GetCursorScreenPos();
@@ -679,30 +923,32 @@ void RenderSystemStatus(AppState& state) {
         ImVec4 dotColor = state.brakeEngaged ? Colors::Destructive() : Colors::MutedForeground();
         drawList->AddCircleFilled(dotPos, 6, ColorToU32(dotColor));
         
-        ImGui::SetCursorPosX(24);
+        ImGui::SetCursorPosX(ImGui::GetCursorPosX() + 8);
         ImGui::Text("Brake Pedal");
         
         // Status badge
         ImGui::SameLine(ImGui::GetContentRegionAvail().x - 55);
         if (state.brakeEngaged) {
-            widgets::Badge("ENGAGED", Colors::DestructiveBg(), Colors::Destructive());
+            widgets::Badge("ENGAGED", layout.text[LayoutText_Engaged], Colors::DestructiveBg(), Colors::Destructive());
         } else {
-            widgets::Badge("RELEASED", Colors::Muted(), Colors::MutedForeground());
-        }
-        
-        // Make it clickable
-        ImGui::SetCursorPos(ImVec2(0, 0));
-        if (ImGui::InvisibleButton("##BrakeBtn", ImGui::GetContentRegionAvail())) {
-            state.brakeEngaged = !state.brakeEngaged;
+            widgets::Badge("RELEASED", layout.text[LayoutText_Released], Colors::Muted(), Colors::MutedForeground());
         }
     }
-    ImGui::EndChild();
-    ImGui::PopStyleColor();
+    // The whole row is clickable
+    if (widgets::EndFlatCardButton("##BrakeBtn")) {
+        state.brakeEngaged = !state.brakeEngaged;
+    }
+    widgets::EndStale();
     
     widgets::EndCard();
 }
 
 void RenderFaultPanel(AppState& state) {
+    // Time-based fsync batching for the persistent journal
+    if (state.faultJournal) {
+        state.faultJournal->Poll();
+    }
+    
     if (!widgets::BeginCard("##FaultPanel", ImVec2(0, 0), true)) {
         widgets::EndCard();
         return;
@@ -714,10 +960,28 @@ void RenderFaultPanel(AppState& state) {
     ImGui::PopStyleColor();
     
     // Action buttons
-    ImGui::SameLine(ImGui::GetContentRegionAvail().x - 40);
+    ImGui::SameLine(ImGui::GetContentRegionAvail().x - 62);
     
     ImGui::PushStyleVar(ImGuiStyleVar_FramePadding, ImVec2(4, 4));
     
+    // History toggle
+    if (state.showFaultHistory) {
+        ImGui::PushStyleColor(ImGuiCol_Button, Colors::Primary());
+        ImGui::PushStyleColor(ImGuiCol_Text, Colors::PrimaryForeground());
+    }
+    bool historyClicked = ImGui::Button("H##FaultHistory");
+    if (state.showFaultHistory) {
+        ImGui::PopStyleColor(2);
+    }
+    if (historyClicked) {
+        state.showFaultHistory = !state.showFaultHistory;
+    }
+    if (ImGui::IsItemHovered()) {
+        ImGui::SetTooltip("Session history");
+    }
+    
+    ImGui::SameLine();
+    
     if (ImGui::Button("+##AddFault")) {
         // Add a random fault
         static const struct { const char* code; const char* msg; FaultSeverity sev; } faultTemplates[] = {
@@ -736,11 +1000,7 @@ void RenderFaultPanel(AppState& state) {
         newFault.severity = faultTemplates[idx].sev;
         newFault.timestamp = static_cast<int64_t>(time(nullptr)) * 1000;
         
-        // Keep only last 5 faults
-        if (state.faults.size() >= 5) {
-            state.faults.erase(state.faults.begin());
-        }
-        state.faults.push_back(newFault);
+        ReportFault(state, newFault);
     }
     if (ImGui::IsItemHovered()) {
         ImGui::SetTooltip("Simulate fault");
@@ -749,10 +1009,11 @@ void RenderFaultPanel(AppState& state) {
     ImGui::SameLine();
     
     if (ImGui::Button("X##ClearFaults")) {
-        state.faults.clear();
+        // Clears the active list only; history and journal are append-only
+        state.faults.Clear();
     }
     if (ImGui::IsItemHovered()) {
-        ImGui::SetTooltip("Clear faults");
+        ImGui::SetTooltip("Clear active faults");
     }
     
     ImGui::PopStyleVar();
@@ -760,7 +1021,9 @@ void RenderFaultPanel(AppState& state) {
     widgets::Space(Spacing::SmallPadding);
     
     // Fault list
-    if (state.faults.empty()) {
+    if (state.showFaultHistory) {
+        RenderFaultHistory(state);
+    } else if (state.faults.Empty()) {
         // No faults message
         ImGui::SetCursorPosY(ImGui::GetCursorPosY() + 30);
         float contentWidth = ImGui::GetContentRegionAvail().x;
@@ -776,85 +1039,90 @@ void RenderFaultPanel(AppState& state) {
         
         ImGui::SetCursorPosY(ImGui::GetCursorPosY() + 40);
         
-        float textWidth = ImGui::CalcTextSize("No faults").x;
+        float textWidth = GetLayoutCache(state).Get().text[LayoutText_NoFaults].x;
         ImGui::SetCursorPosX((contentWidth - textWidth) * 0.5f);
         ImGui::PushStyleColor(ImGuiCol_Text, Colors::MutedForeground());
         ImGui::Text("No faults");
         ImGui::PopStyleColor();
     } else {
-        // Display faults
-        for (size_t i = 0; i < state.faults.size(); i++) {
-            const Fault& fault = state.faults[i];
-            
-            // Determine colors based on severity
-            ImVec4 bgColor, borderColor, iconColor;
-            switch (fault.severity) {
-                case FaultSeverity::Critical:
-                    bgColor = Colors::DestructiveBg();
-                    borderColor = ColorWithAlpha(Colors::Destructive(), 0.5f);
-                    iconColor = Colors::Destructive();
-                    break;
-                case FaultSeverity::Warning:
-                    bgColor = Colors::WarningBg();
-                    borderColor = ColorWithAlpha(Colors::Warning(), 0.5f);
-                    iconColor = Colors::Warning();
-                    break;
-                case FaultSeverity::Info:
-                default:
-                    bgColor = Colors::PrimaryBg();
-                    borderColor = ColorWithAlpha(Colors::Primary(), 0.5f);
-                    iconColor = Colors::Primary();
-                    break;
-            }
-            
-            ImGui::PushStyleColor(ImGuiCol_ChildBg, bgColor);
-            ImGui::PushStyleColor(ImGuiCol_Border, borderColor);
+        // One row per distinct fault, most severe first; repeats only bump
+        // the row's counter
+        static const FaultSeverity severityOrder[] = {
+            FaultSeverity::Critical, FaultSeverity::Warning, FaultSeverity::Info
+        };
+        const DashboardLayout& layout = GetLayoutCache(state).Get();
+        
+        for (FaultSeverity severity : severityOrder) {
+            if (state.faults.CountBySeverity(severity) == 0) continue;
             
-            char childId[32];
-            snprintf(childId, sizeof(childId), "##Fault%zu", i);
-            ImGui::BeginChild(childId, ImVec2(0, 50), ImGuiChildFlags_Borders);
-            {
-                ImGui::Spacing();
+            for (size_t i = 0; i < state.faults.Size(); i++) {
+                const FaultAggregator::Entry& fault = state.faults.At(i);
+                if (fault.severity != severity) continue;
+                
+                // Determine colors based on severity
+                ImVec4 bgColor, borderColor, iconColor;
+                GetFaultColors(fault.severity, bgColor, borderColor, iconColor);
                 
-                // Icon
-                ImGui::PushStyleColor(ImGuiCol_Text, iconColor);
-                if (fault.severity == FaultSeverity::Critical) {
-                    ImGui::Text("/!\\");
-                } else if (fault.severity == FaultSeverity::Warning) {
-                    ImGui::Text("(!)");
-                } else {
-                    ImGui::Text("(i)");
+                // Latched but no longer asserted: keep it visible, dimmed
+                if (!fault.active) {
+                    ImGui::PushStyleVar(ImGuiStyleVar_Alpha, 0.6f);
                 }
-                ImGui::PopStyleColor();
                 
-                ImGui::SameLine();
+                widgets::BeginFlatCard(ImVec2(0, 50), bgColor, borderColor);
+                {
+                    ImGui::Spacing();
+                    
+                    // Icon
+                    ImGui::PushStyleColor(ImGuiCol_Text, iconColor);
+                    ImGui::TextUnformatted(GetFaultIcon(fault.severity));
+                    ImGui::PopStyleColor();
+                    
+                    ImGui::SameLine();
+                    
+                    // Code, occurrence count and last-seen time
+                    ImGui::Text("%s", fault.code.c_str());
+                    
+                    if (fault.count > 1) {
+                        ImGui::SameLine();
+                        ImGui::PushStyleColor(ImGuiCol_Text, iconColor);
+                        ImGui::Text("x%u", fault.count);
+                        ImGui::PopStyleColor();
+                    }
+                    
+                    char timeStr[16];
+                    FormatTime(fault.lastSeen, timeStr, sizeof(timeStr));
+                    ImGui::SameLine(ImGui::GetContentRegionAvail().x - 30);
+                    ImGui::PushStyleColor(ImGuiCol_Text, Colors::MutedForeground());
+                    ImGui::Text("%s", timeStr);
+                    ImGui::PopStyleColor();
+                    
+                    // Message, under the code (cursor X is window-relative,
+                    // so offset from the card's line start)
+                    float messageIndent = layout.text[GetFaultIconText(fault.severity)].x +
+                                          ImGui::GetStyle().ItemSpacing.x;
+                    ImGui::SetCursorPosX(ImGui::GetCursorPosX() + messageIndent);
+                    ImGui::Text("%s", fault.message.c_str());
+                }
+                widgets::EndFlatCard();
                 
-                // Code and timestamp
-                ImGui::Text("%s", fault.code.c_str());
+                if (!fault.active) {
+                    ImGui::PopStyleVar();
+                }
                 
-                char timeStr[16];
-                FormatTime(fault.timestamp, timeStr, sizeof(timeStr));
-                ImGui::SameLine(ImGui::GetContentRegionAvail().x - 30);
-                ImGui::PushStyleColor(ImGuiCol_Text, Colors::MutedForeground());
-                ImGui::Text("%s", timeStr);
-                ImGui::PopStyleColor();
+                if (ImGui::IsItemHovered() && fault.count > 1) {
+                    char firstStr[16];
+                    FormatTime(fault.firstSeen, firstStr, sizeof(firstStr));
+                    ImGui::SetTooltip("%u occurrences since %s", fault.count, firstStr);
+                }
                 
-                // Message
-                ImGui::SetCursorPosX(30);
-                ImGui::Text("%s", fault.message.c_str());
+                widgets::Space(4.0f);
             }
-            ImGui::EndChild();
-            
-            ImGui::PopStyleColor(2);
-            
-            widgets::Space(4.0f);
         }
         
         widgets::Space(4.0f);
         
         // Active fault count
-        ImGui::PushStyleColor(ImGuiCol_ChildBg, ColorWithAlpha(Colors::Muted(), 0.5f));
-        ImGui::BeginChild("##FaultCount", ImVec2(0, 25), ImGuiChildFlags_None);
+        widgets::BeginFlatCard(ImVec2(0, 25), ColorWithAlpha(Colors::Muted(), 0.5f), ImVec4(0, 0, 0, 0), ImVec2(0, 0));
         {
             ImGui::PushStyleColor(ImGuiCol_Text, Colors::MutedForeground());
             ImGui::Text("Active");
@@ -862,38 +1130,374 @@ void RenderFaultPanel(AppState& state) {
             
             ImGui::SameLine(ImGui::GetContentRegionAvail().x - 20);
             
-            bool hasCritical = false;
-            for (const auto& f : state.faults) {
-                if (f.severity == FaultSeverity::Critical) {
-                    hasCritical = true;
-                    break;
-                }
-            }
+            bool hasCritical = state.faults.CountBySeverity(FaultSeverity::Critical) > 0;
             
             ImVec4 countColor = hasCritical ? Colors::Destructive() : Colors::Warning();
             ImGui::PushStyleColor(ImGuiCol_Text, countColor);
-            ImGui::Text("%zu", state.faults.size());
+            ImGui::Text("%zu", state.faults.Size());
             ImGui::PopStyleColor();
         }
-        ImGui::EndChild();
-        ImGui::PopStyleColor();
+        widgets::EndFlatCard();
     }
     
     widgets::EndCard();
 }
 
-void RenderCameraFeed(const char* label, const char* type, bool isActive, void* texture) {
+/**
+ * Filter bar and virtualized row list over a fault history source
+ * Works with anything exposing the FaultHistory filter/row interface
+ * (FaultHistory for the session, FaultJournal for persisted history).
+ */
+template<typename Source>
+static void RenderFaultHistoryRows(Source& history, float timeWidth) {
+    // Severity filter toggles
+    static const struct { const char* id; FaultSeverity sev; } severityButtons[] = {
+        { "C##HistCritical", FaultSeverity::Critical },
+        { "W##HistWarning", FaultSeverity::Warning },
+        { "I##HistInfo", FaultSeverity::Info },
+    };
+    
+    uint8_t severityMask = history.GetSeverityMask();
+    int codeFilter = history.GetCodeFilter();
+    
+    ImGui::PushStyleVar(ImGuiStyleVar_FramePadding, ImVec2(6, 2));
+    for (const auto& button : severityButtons) {
+        uint8_t bit = static_cast<uint8_t>(1u << static_cast<unsigned>(button.sev));
+        bool enabled = (severityMask & bit) != 0;
+        
+        ImVec4 bgColor, borderColor, iconColor;
+        GetFaultColors(button.sev, bgColor, borderColor, iconColor);
+        ImGui::PushStyleColor(ImGuiCol_Button, enabled ? bgColor : Colors::Muted());
+        ImGui::PushStyleColor(ImGuiCol_Text, enabled ? iconColor : Colors::MutedForeground());
+        if (ImGui::Button(button.id)) {
+            severityMask ^= bit;
+        }
+        ImGui::PopStyleColor(2);
+        ImGui::SameLine();
+    }
+    
+    // Code filter
+    ImGui::SetNextItemWidth(-1);
+    const char* preview = codeFilter == Source::kAnyCode
+        ? "All codes" : history.CodeString(static_cast<uint32_t>(codeFilter));
+    if (ImGui::BeginCombo("##HistCode", preview)) {
+        if (ImGui::Selectable("All codes", codeFilter == Source::kAnyCode)) {
+            codeFilter = Source::kAnyCode;
+        }
+        for (size_t c = 0; c < history.CodeCount(); c++) {
+            char item[32];
+            snprintf(item, sizeof(item), "%s (%zu)", history.CodeString(static_cast<uint32_t>(c)),
+                     history.CountByCode(static_cast<uint32_t>(c)));
+            if (ImGui::Selectable(item, codeFilter == static_cast<int>(c))) {
+                codeFilter = static_cast<int>(c);
+            }
+        }
+        ImGui::EndCombo();
+    }
+    ImGui::PopStyleVar();
+    
+    history.SetFilter(severityMask, codeFilter);
+    size_t rowCount = history.FilteredCount();
+    
+    ImGui::PushStyleColor(ImGuiCol_Text, Colors::MutedForeground());
+    ImGui::Text("%zu of %zu", rowCount, history.Size());
+    ImGui::PopStyleColor();
+    
+    // Virtualized list: one child window, fixed-height rows drawn straight
+    // onto its draw list, only the visible range submitted
+    const float rowHeight = 44.0f;
+    const float rowGap = 4.0f;
+    
+    ImGui::PushStyleVar(ImGuiStyleVar_ItemSpacing, ImVec2(0, 0));
+    ImGui::PushStyleColor(ImGuiCol_ChildBg, ImVec4(0, 0, 0, 0));
+    ImGui::BeginChild("##FaultHistoryList", ImVec2(0, 0), ImGuiChildFlags_None);
+    {
+        ImDrawList* drawList = ImGui::GetWindowDrawList();
+        float width = ImGui::GetContentRegionAvail().x;
+        float lineHeight = ImGui::GetTextLineHeight();
+        ImU32 textColor = ColorToU32(Colors::Foreground());
+        ImU32 mutedColor = ColorToU32(Colors::MutedForeground());
+        
+        ImGuiListClipper clipper;
+        clipper.Begin(static_cast<int>(rowCount), rowHeight);
+        while (clipper.Step()) {
+            for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; row++) {
+                // Newest first
+                FaultRow record = history.FilteredRow(rowCount - 1 - static_cast<size_t>(row));
+                
+                ImVec4 bgColor, borderColor, iconColor;
+                GetFaultColors(record.severity, bgColor, borderColor, iconColor);
+                
+                ImVec2 pos = ImGui::GetCursorScreenPos();
+                ImVec2 rectMax = ImVec2(pos.x + width, pos.y + rowHeight - rowGap);
+                drawList->AddRectFilled(pos, rectMax, ColorToU32(bgColor), Rounding::Card);
+                drawList->AddRect(pos, rectMax, ColorToU32(borderColor), Rounding::Card);
+                
+                float line1 = pos.y + 4.0f;
+                float line2 = line1 + lineHeight + 2.0f;
+                drawList->AddText(ImVec2(pos.x + 8.0f, line1), ColorToU32(iconColor), GetFaultIcon(record.severity));
+                drawList->AddText(ImVec2(pos.x + 36.0f, line1), textColor, record.code);
+                
+                char timeStr[16];
+                FormatTime(record.timestamp, timeStr, sizeof(timeStr));
+                drawList->AddText(ImVec2(rectMax.x - timeWidth - 8.0f, line1), mutedColor, timeStr);
+                
+                drawList->AddText(ImVec2(pos.x + 36.0f, line2), textColor, record.message);
+                
+                ImGui::Dummy(ImVec2(width, rowHeight));
+            }
+        }
+        clipper.End();
+    }
+    ImGui::EndChild();
+    ImGui::PopStyleColor();
+    ImGui::PopStyleVar();
+}
+
+void RenderFaultHistory(AppState& state) {
+    float timeWidth = GetLayoutCache(state).Get().text[LayoutText_HistoryTime].x;
+    FaultHistory* session = state.faultHistory;
+    FaultJournal* journal = state.faultJournal && state.faultJournal->IsOpen() ? state.faultJournal : nullptr;
+    if (!session || !journal) {
+        if (session) {
+            RenderFaultHistoryRows(*session, timeWidth);
+        } else if (journal) {
+            RenderFaultHistoryRows(*journal, timeWidth);
+        } else {
+            ImGui::PushStyleColor(ImGuiCol_Text, Colors::MutedForeground());
+            ImGui::TextUnformatted("No fault history attached");
+            ImGui::PopStyleColor();
+        }
+        return;
+    }
+    
+    // Source toggle: this session (in memory) or everything journaled
+    ImGui::PushStyleVar(ImGuiStyleVar_FramePadding, ImVec2(6, 2));
+    static const char* sourceLabels[] = { "Session##HistSession", "Saved##HistSaved" };
+    for (int i = 0; i < 2; i++) {
+        bool active = state.faultHistoryFromJournal == (i == 1);
+        ImGui::PushStyleColor(ImGuiCol_Button, active ? Colors::Primary() : Colors::Muted());
+        ImGui::PushStyleColor(ImGuiCol_Text, active ? Colors::PrimaryForeground() : Colors::MutedForeground());
+        if (ImGui::Button(sourceLabels[i])) {
+            state.faultHistoryFromJournal = (i == 1);
+        }
+        ImGui::PopStyleColor(2);
+        if (i == 0) ImGui::SameLine();
+    }
+    ImGui::PopStyleVar();
+    
+    if (state.faultHistoryFromJournal) {
+        RenderFaultHistoryRows(*journal, timeWidth);
+    } else {
+        RenderFaultHistoryRows(*session, timeWidth);
+    }
+}
+
+// Offset from the start of the recording as hh:mm:ss.t
+static void FormatElapsed(uint64_t ns, char* buf, size_t bufSize) {
+    unsigned long long tenths = ns / 100000000ull;
+    unsigned long long seconds = tenths / 10;
+    snprintf(buf, bufSize, "%02llu:%02llu:%02llu.%llu", seconds / 3600, seconds / 60 % 60, seconds % 60, tenths % 10);
+}
+
+void RenderSessionTimeline(AppState& state) {
+    static constexpr ImGuiID kPlayId = HashId("Dashboard/Timeline/Play");
+    static constexpr ImGuiID kLiveId = HashId("Dashboard/Timeline/Live");
+
+    SessionPlayback& playback = *state.playback;
+    const SessionReader& reader = playback.GetReader();
+    if (!reader.IsOpen() || reader.IsEmpty()) return;
+
+    bool active = playback.IsActive();
+    uint64_t startNs = reader.GetStartNs();
+    uint64_t spanNs = std::max<uint64_t>(reader.GetEndNs() - startNs, 1);
+    float height = ImGui::GetFrameHeight();
+
+    // Play / pause (from live: play from the current position)
+    if (widgets::Button(kPlayId, active && playback.IsPlaying() ? "||" : ">", ImVec2(height * 1.5f, height))) {
+        playback.SetPlaying(!active || !playback.IsPlaying());
+        playback.SetActive(true);
+    }
+    ImGui::SameLine();
+
+    ImGui::PushStyleColor(ImGuiCol_Button, active ? Colors::Secondary() : Colors::Primary());
+    ImGui::PushStyleColor(ImGuiCol_Text, active ? Colors::SecondaryForeground() : Colors::PrimaryForeground());
+    if (widgets::Button(kLiveId, "LIVE", ImVec2(0, height))) {
+        playback.SetActive(false);
+        playback.SetPlaying(false);
+    }
+    ImGui::PopStyleColor(2);
+    ImGui::SameLine();
+
+    char total[32];
+    char label[80];
+    FormatElapsed(spanNs, total, sizeof(total));
+    if (active) {
+        char position[32];
+        FormatElapsed(playback.GetTime() - startNs, position, sizeof(position));
+        snprintf(label, sizeof(label), "%s / %s", position, total);
+    } else {
+        snprintf(label, sizeof(label), "live / %s", total);
+    }
+    float labelWidth = ImGui::CalcTextSize("00:00:00.0 / 00:00:00.0").x;
+    float barWidth = std::max(ImGui::GetContentRegionAvail().x - labelWidth - Spacing::ItemSpacing, 1.0f);
+
+    // Scrub bar: holding the mouse seeks every frame
+    ImVec2 pos = ImGui::GetCursorScreenPos();
+    ImGui::InvisibleButton("##SessionBar", ImVec2(barWidth, height));
+    if (ImGui::IsItemActivated()) {
+        playback.SetPlaying(false);
+        playback.SetActive(true);
+        active = true;
+    }
+    if (ImGui::IsItemActive()) {
+        float t = std::min(std::max((ImGui::GetIO().MousePos.x - pos.x) / barWidth, 0.0f), 1.0f);
+        playback.SetTime(startNs + static_cast<uint64_t>(static_cast<double>(spanNs) * t));
+    }
+    bool hovered = ImGui::IsItemHovered();
+
+    ImDrawList* drawList = ImGui::GetWindowDrawList();
+    ImVec2 barMin(pos.x, pos.y + height * 0.25f);
+    ImVec2 barMax(pos.x + barWidth, pos.y + height * 0.75f);
+    drawList->AddRectFilled(barMin, barMax, ColorToU32(hovered ? Colors::Secondary() : Colors::Muted()),
+                            Rounding::ProgressBar);
+
+    float playheadX = barMax.x;
+    if (active) {
+        playheadX = pos.x + barWidth * static_cast<float>(static_cast<double>(playback.GetTime() - startNs) / spanNs);
+        drawList->AddRectFilled(barMin, ImVec2(playheadX, barMax.y), ColorToU32(Colors::PrimaryBg()),
+                                Rounding::ProgressBar);
+    }
+
+    // Fault markers: one tick per pixel column at most
+    ImU32 faultColor = ColorToU32(Colors::Destructive());
+    int lastColumn = -1;
+    for (uint64_t timeNs : reader.GetFaultTimes()) {
+        float x = pos.x + barWidth * static_cast<float>(static_cast<double>(timeNs - startNs) / spanNs);
+        int column = static_cast<int>(x);
+        if (column == lastColumn) continue;
+        lastColumn = column;
+        drawList->AddRectFilled(ImVec2(static_cast<float>(column), pos.y),
+                                ImVec2(static_cast<float>(column) + 1.0f, barMin.y), faultColor);
+    }
+
+    drawList->AddLine(ImVec2(playheadX, pos.y), ImVec2(playheadX, pos.y + height),
+                      ColorToU32(active ? Colors::Primary() : Colors::MutedForeground()), 2.0f);
+
+    ImGui::SameLine(0, Spacing::ItemSpacing);
+    ImGui::AlignTextToFramePadding();
+    ImGui::TextColored(active ? Colors::Foreground() : Colors::MutedForeground(), "%s", label);
+
+    if (playback.IsPlaying() && state.framePacer) {
+        state.framePacer->RequestAnimation(state.framePacer->GetConfig().activeHz);
+    }
+}
+
+// Camera placeholder / overlay geometry, built on a ParallelDraw worker when one is attached
+struct CameraOverlayDraw {
+    ImVec2 pos;
+    ImVec2 size;
+    bool active;
+    bool rear;
+    ImFont* font;
+    float fontSize;
+    ImU32 textColor;
+    ImU32 mutedTextColor;
+    ImVec2 offIconPos;
+    ImVec2 offTextPos;
+    float liveOpacity;
+};
+
+static void BuildCameraOverlay(ImDrawList& drawList, const CameraOverlayDraw& d) {
+    ImVec2 pos = d.pos;
+    ImVec2 feedSize = d.size;
+    
+    // Draw placeholder background
+    if (!d.active) {
+        // Dimmed overlay
+        drawList.AddRectFilled(pos, ImVec2(pos.x + feedSize.x, pos.y + feedSize.y),
+                               ColorToU32(ColorWithAlpha(Colors::Background(), 0.5f)));
+        
+        // Camera off icon and inactive message
+        drawList.AddText(d.font, d.fontSize, d.offIconPos, d.mutedTextColor, "[X]");
+        drawList.AddText(d.font, d.fontSize, d.offTextPos, d.mutedTextColor, "Camera inactive");
+        return;
+    }
+    
+    // TODO: If texture is provided, draw it using ImGui::Image
+    // For now, draw placeholder with "LIVE" indicator
+    
+    // Placeholder pattern
+    drawList.AddRectFilled(pos, ImVec2(pos.x + feedSize.x, pos.y + feedSize.y),
+                           ColorToU32(Colors::Muted()));
+    
+    // Grid pattern to simulate camera feed
+    ImU32 lineColor = ColorToU32(ColorWithAlpha(Colors::MutedForeground(), 0.2f));
+    for (float x = pos.x; x < pos.x + feedSize.x; x += 20) {
+        drawList.AddLine(ImVec2(x, pos.y), ImVec2(x, pos.y + feedSize.y), lineColor);
+    }
+    for (float y = pos.y; y < pos.y + feedSize.y; y += 20) {
+        drawList.AddLine(ImVec2(pos.x, y), ImVec2(pos.x + feedSize.x, y), lineColor);
+    }
+    
+    // LIVE indicator
+    float indicatorX = pos.x + 10;
+    float indicatorY = pos.y + 10;
+    
+    drawList.AddRectFilled(ImVec2(indicatorX, indicatorY),
+                           ImVec2(indicatorX + 50, indicatorY + 20),
+                           ColorToU32(ColorWithAlpha(Colors::Background(), 0.8f)),
+                           Rounding::Badge);
+    
+    // Pulsing red dot
+    ImVec4 dotColor = Colors::Destructive();
+    drawList.AddCircleFilled(ImVec2(indicatorX + 10, indicatorY + 10), 4,
+                             ColorToU32(ColorWithAlpha(dotColor, dotColor.w * d.liveOpacity)));
+    
+    drawList.AddText(d.font, d.fontSize, ImVec2(indicatorX + 20, indicatorY + 3), d.textColor, "LIVE");
+    
+    // Draw trajectory lines for rear camera
+    if (d.rear) {
+        float cx = pos.x + feedSize.x * 0.5f;
+        float bottom = pos.y + feedSize.y;
+        
+        // Green trajectory lines
+        ImU32 greenLine = ColorToU32(ImVec4(0.13f, 0.77f, 0.37f, 0.6f));
+        drawList.AddBezierQuadratic(
+            ImVec2(cx - 40, bottom),
+            ImVec2(cx - 20, bottom - feedSize.y * 0.4f),
+            ImVec2(cx, bottom - feedSize.y * 0.6f),
+            greenLine, 2.0f);
+        drawList.AddBezierQuadratic(
+            ImVec2(cx + 40, bottom),
+            ImVec2(cx + 20, bottom - feedSize.y * 0.4f),
+            ImVec2(cx, bottom - feedSize.y * 0.6f),
+            greenLine, 2.0f);
+        
+        // Yellow distance markers
+        ImU32 yellowLine = ColorToU32(ImVec4(0.98f, 0.80f, 0.08f, 0.6f));
+        float y1 = bottom - feedSize.y * 0.15f;
+        float y2 = bottom - feedSize.y * 0.30f;
+        drawList.AddLine(ImVec2(cx - 60, y1), ImVec2(cx + 60, y1), yellowLine, 2.0f);
+        drawList.AddLine(ImVec2(cx - 45, y2), ImVec2(cx + 45, y2), yellowLine, 2.0f);
+        
+        // Red close distance marker
+        ImU32 redLine = ColorToU32(ImVec4(0.94f, 0.27f, 0.27f, 0.6f));
+        float y3 = bottom - feedSize.y * 0.45f;
+        drawList.AddLine(ImVec2(cx - 30, y3), ImVec2(cx + 30, y3), redLine, 2.0f);
+    }
+}
+
+void RenderCameraFeed(const char* label, const char* type, bool isActive, void* texture, ParallelDraw* parallelDraw,
+                      const DashboardLayout* layout) {
     if (!widgets::BeginCard("", ImVec2(0, 0), true)) {
         widgets::EndCard();
         return;
     }
     
     // Header
-    ImGui::PushStyleColor(ImGuiCol_ChildBg, Colors::Card());
-    ImGui::BeginChild("##CameraHeader", ImVec2(0, 30), ImGuiChildFlags_Borders);
-    {
-        ImGui::SetCursorPosY(5);
-        
+    widgets::BeginFlatCard(ImVec2(0, 30), Colors::Card(), Colors::Border(), ImVec2(Spacing::CardPadding, 5.0f));
+    {        
         // Camera icon
         ImVec4 iconColor = isActive ? Colors::Success() : Colors::MutedForeground();
         ImGui::PushStyleColor(ImGuiCol_Text, iconColor);
@@ -911,104 +1515,35 @@ void RenderCameraFeed(const char* label, const char* type, bool isActive, void*
         }
         ImGui::PopStyleVar();
     }
-    ImGui::EndChild();
-    ImGui::PopStyleColor();
+    widgets::EndFlatCard();
     
     // Camera feed area
     ImVec2 feedSize = ImGui::GetContentRegionAvail();
+    feedSize.y = std::max(feedSize.y, 1.0f);
     
-    ImGui::PushStyleColor(ImGuiCol_ChildBg, Colors::Muted());
-    ImGui::BeginChild("##CameraFeed", feedSize, ImGuiChildFlags_None);
+    widgets::BeginFlatCard(feedSize, Colors::Muted(), ImVec4(0, 0, 0, 0), ImVec2(0, 0));
     {
-        ImDrawList* drawList = ImGui::GetWindowDrawList();
-        ImVec2 pos = ImGui::GetCursorScreenPos();
-        
-        // Draw placeholder background
-        if (!isActive) {
-            // Dimmed overlay
-            drawList->AddRectFilled(pos, ImVec2(pos.x + feedSize.x, pos.y + feedSize.y),
-                                   ColorToU32(ColorWithAlpha(Colors::Background(), 0.5f)));
-            
-            // Inactive message
-            ImVec2 center = ImVec2(pos.x + feedSize.x * 0.5f, pos.y + feedSize.y * 0.5f);
-            
-            // Camera off icon
-            const char* offIcon = "[X]";
-            ImVec2 iconSize = ImGui::CalcTextSize(offIcon);
-            drawList->AddText(ImVec2(center.x - iconSize.x * 0.5f, center.y - 20),
-                            ColorToU32(Colors::MutedForeground()), offIcon);
-            
-            const char* offText = "Camera inactive";
-            ImVec2 textSize = ImGui::CalcTextSize(offText);
-            drawList->AddText(ImVec2(center.x - textSize.x * 0.5f, center.y + 10),
-                            ColorToU32(Colors::MutedForeground()), offText);
-        } else {
-            // TODO: If texture is provided, draw it using ImGui::Image
-            // For now, draw placeholder with "LIVE" indicator
-            
-            // Placeholder pattern
-            drawList->AddRectFilled(pos, ImVec2(pos.x + feedSize.x, pos.y + feedSize.y),
-                                   ColorToU32(Colors::Muted()));
-            
-            // Grid pattern to simulate camera feed
-            ImU32 lineColor = ColorToU32(ColorWithAlpha(Colors::MutedForeground(), 0.2f));
-            for (float x = pos.x; x < pos.x + feedSize.x; x += 20) {
-                drawList->AddLine(ImVec2(x, pos.y), ImVec2(x, pos.y + feedSize.y), lineColor);
-            }
-            for (float y = pos.y; y < pos.y + feedSize.y; y += 20) {
-                drawList->AddLine(ImVec2(pos.x, y), ImVec2(pos.x + feedSize.x, y), lineColor);
-            }
-            
-            // LIVE indicator
-            float indicatorX = pos.x + 10;
-            float indicatorY = pos.y + 10;
-            
-            drawList->AddRectFilled(ImVec2(indicatorX, indicatorY),
-                                   ImVec2(indicatorX + 50, indicatorY + 20),
-                                   ColorToU32(ColorWithAlpha(Colors::Background(), 0.8f)),
-                                   Rounding::Badge);
-            
-            // Pulsing red dot
-            drawList->AddCircleFilled(ImVec2(indicatorX + 10, indicatorY + 10), 4,
-                                     ColorToU32(Colors::Destructive()));
-            
-            drawList->AddText(ImVec2(indicatorX + 20, indicatorY + 3),
-                            ColorToU32(Colors::Foreground()), "LIVE");
-            
-            // Draw trajectory lines for rear camera
-            if (strcmp(type, "rear") == 0) {
-                float cx = pos.x + feedSize.x * 0.5f;
-                float bottom = pos.y + feedSize.y;
-                
-                // Green trajectory lines
-                ImU32 greenLine = ColorToU32(ImVec4(0.13f, 0.77f, 0.37f, 0.6f));
-                drawList->AddBezierQuadratic(
-                    ImVec2(cx - 40, bottom),
-                    ImVec2(cx - 20, bottom - feedSize.y * 0.4f),
-                    ImVec2(cx, bottom - feedSize.y * 0.6f),
-                    greenLine, 2.0f);
-                drawList->AddBezierQuadratic(
-                    ImVec2(cx + 40, bottom),
-                    ImVec2(cx + 20, bottom - feedSize.y * 0.4f),
-                    ImVec2(cx, bottom - feedSize.y * 0.6f),
-                    greenLine, 2.0f);
-                
-                // Yellow distance markers
-                ImU32 yellowLine = ColorToU32(ImVec4(0.98f, 0.80f, 0.08f, 0.6f));
-                float y1 = bottom - feedSize.y * 0.15f;
-                float y2 = bottom - feedSize.y * 0.30f;
-                drawList->AddLine(ImVec2(cx - 60, y1), ImVec2(cx + 60, y1), yellowLine, 2.0f);
-                drawList->AddLine(ImVec2(cx - 45, y2), ImVec2(cx + 45, y2), yellowLine, 2.0f);
-                
-                // Red close distance marker
-                ImU32 redLine = ColorToU32(ImVec4(0.94f, 0.27f, 0.27f, 0.6f));
-                float y3 = bottom - feedSize.y * 0.45f;
-                drawList->AddLine(ImVec2(cx - 30, y3), ImVec2(cx + 30, y3), redLine, 2.0f);
-            }
-        }
+        CameraOverlayDraw d;
+        d.pos = ImGui::GetCursorScreenPos();
+        d.size = feedSize;
+        d.active = isActive;
+        d.rear = strcmp(type, "rear") == 0;
+        d.font = ImGui::GetFont();
+        d.fontSize = ImGui::GetFontSize();
+        d.textColor = ColorToU32(Colors::Foreground());
+        d.mutedTextColor = ColorToU32(Colors::MutedForeground());
+        
+        // Inactive message, centered
+        ImVec2 center = ImVec2(d.pos.x + feedSize.x * 0.5f, d.pos.y + feedSize.y * 0.5f);
+        ImVec2 iconSize = layout ? layout->text[LayoutText_CameraOffIcon] : ImGui::CalcTextSize("[X]");
+        ImVec2 textSize = layout ? layout->text[LayoutText_CameraInactive] : ImGui::CalcTextSize("Camera inactive");
+        d.offIconPos = ImVec2(center.x - iconSize.x * 0.5f, center.y - 20);
+        d.offTextPos = ImVec2(center.x - textSize.x * 0.5f, center.y + 10);
+        d.liveOpacity = PulseOpacity();
+        
+        DeferDraw(parallelDraw, BuildCameraOverlay, d);
     }
-    ImGui::EndChild();
-    ImGui::PopStyleColor();
+    widgets::EndFlatCard();
     
     widgets::EndCard();
 }
@@ -1018,17 +1553,22 @@ bool RenderTurnIndicator(bool isLeft, bool active) {
     
     ImVec4 bgColor = active ? Colors::Accent() : Colors::Card();
     ImVec4 textColor = active ? Colors::AccentForeground() : Colors::MutedForeground();
+    if (active) {
+        // Pulses while signalling, like the web dashboard
+        float opacity = PulseOpacity();
+        bgColor = ColorWithAlpha(bgColor, bgColor.w * opacity);
+        textColor = ColorWithAlpha(textColor, textColor.w * opacity);
+    }
     
     ImGui::PushStyleColor(ImGuiCol_Button, bgColor);
-    ImGui::PushStyleColor(ImGuiCol_ButtonHovered, active ? Colors::Accent() : Colors::Muted());
+    ImGui::PushStyleColor(ImGuiCol_ButtonHovered, active ? bgColor : Colors::Muted());
     ImGui::PushStyleColor(ImGuiCol_Text, textColor);
     ImGui::PushStyleVar(ImGuiStyleVar_FrameRounding, Rounding::Card);
     
-    const char* icon = isLeft ? "<" : ">";
-    char buttonId[32];
-    snprintf(buttonId, sizeof(buttonId), "%s##Turn%s", icon, isLeft ? "Left" : "Right");
+    static constexpr ImGuiID kTurnLeftId = HashId("Dashboard/TurnLeft");
+    static constexpr ImGuiID kTurnRightId = HashId("Dashboard/TurnRight");
     
-    bool clicked = ImGui::Button(buttonId, buttonSize);
+    bool clicked = widgets::Button(isLeft ? kTurnLeftId : kTurnRightId, isLeft ? "<" : ">", buttonSize);
     
     ImGui::PopStyleVar();
     ImGui::PopStyleColor(3);
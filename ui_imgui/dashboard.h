@@ -1,6 +1,7 @@
 #pragma once
 
 #include "state.h"
+#include "layout_cache.h"
 
 namespace ui {
 
@@ -35,7 +36,7 @@ void RenderGearIndicator(AppState& state);
  * Render the battery status panel
  * Maps to battery-panel.tsx
  */
-void RenderBatteryPanel(const AppState& state);
+void RenderBatteryPanel(AppState& state);
 
 /**
  * Render the cruise control panel
@@ -55,6 +56,25 @@ void RenderSystemStatus(AppState& state);
  */
 void RenderFaultPanel(AppState& state);
 
+/**
+ * Render the session fault history (newest first) with severity/code filters
+ * Virtualized through ImGuiListClipper; cost is independent of history size.
+ * Drawn inside the fault panel when AppState::showFaultHistory is set.
+ * Lists AppState::faultHistory; with AppState::faultJournal also attached, a
+ * toggle switches to the persisted journal, which is paged in from its file
+ * mapping as rows become visible.
+ */
+void RenderFaultHistory(AppState& state);
+
+/**
+ * Render the session timeline bar (AppState::playback attached)
+ * Dragging the bar shows the dashboard as recorded at that instant; each
+ * frame costs one SessionReader::Seek() however long the recording is.
+ * Keyframes that hold faults are marked on the bar. Live returns to the
+ * live state.
+ */
+void RenderSessionTimeline(AppState& state);
+
 /**
  * Render a camera feed placeholder
  * Maps to camera-feed.tsx
@@ -63,8 +83,11 @@ void RenderFaultPanel(AppState& state);
  * @param type Camera type identifier
  * @param isActive Whether camera is currently active
  * @param texture Optional texture ID (placeholder if nullptr)
+ * @param parallelDraw Optional pool to build the overlay geometry on
+ * @param layout Optional layout with the overlay's text sizes (measured if nullptr)
  */
-void RenderCameraFeed(const char* label, const char* type, bool isActive, void* texture = nullptr);
+void RenderCameraFeed(const char* label, const char* type, bool isActive, void* texture = nullptr,
+                      ParallelDraw* parallelDraw = nullptr, const DashboardLayout* layout = nullptr);
 
 /**
  * Render a turn indicator button
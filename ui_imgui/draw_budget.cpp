@@ -0,0 +1,180 @@
+#include "draw_budget.h"
+#include "parallel_draw.h"
+#include "imgui_internal.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+namespace ui {
+
+// Windows that end up in ImDrawData. The implicit "Debug##Default" window
+// is still open before Render() and only counts if something was drawn in it.
+static bool IsDrawn(const ImGuiWindow* window) {
+    if (window->IsFallbackWindow && !window->WriteAccessed) return false;
+    return window->Active && !window->Hidden;
+}
+
+// Non-empty commands, i.e. draw calls (callbacks and trailing empties excluded)
+static int CountDrawCalls(const ImDrawList& list) {
+    int calls = 0;
+    for (const ImDrawCmd& cmd : list.CmdBuffer) {
+        if (cmd.ElemCount > 0 && !cmd.UserCallback) calls++;
+    }
+    return calls;
+}
+
+static void AddList(const ImDrawList& list, DrawCost& cost) {
+    cost.vertices += list.VtxBuffer.Size;
+    cost.indices += list.IdxBuffer.Size;
+    cost.cmds += CountDrawCalls(list);
+}
+
+// A child window's whole list, plus its own visible children
+static void AddWindowTree(const ImGuiWindow* window, DrawCost& cost) {
+    if (!IsDrawn(window)) return;
+    AddList(*window->DrawList, cost);
+    for (const ImGuiWindow* child : window->DC.ChildWindows) AddWindowTree(child, cost);
+}
+
+static bool Exceeds(const DrawCost& cost, const DrawCost& budget) {
+    return (budget.vertices > 0 && cost.vertices > budget.vertices) ||
+           (budget.indices > 0 && cost.indices > budget.indices) ||
+           (budget.cmds > 0 && cost.cmds > budget.cmds);
+}
+
+int DrawBudget::FindPanel(const char* name) {
+    for (size_t i = 0; i < panels_.size(); i++) {
+        if (panels_[i].name == name) return static_cast<int>(i);
+    }
+    panels_.emplace_back();
+    panels_.back().name = name;
+    frameCosts_.emplace_back();
+    drawn_.push_back(false);
+    return static_cast<int>(panels_.size()) - 1;
+}
+
+void DrawBudget::SetBudget(const char* panel, const DrawCost& budget) {
+    PanelDrawStats& stats = panels_[FindPanel(panel)];
+    stats.budget = budget;
+    stats.budgetOverridden = true;
+}
+
+void DrawBudget::BeginFrame(const ParallelDraw* pool) {
+    IM_ASSERT(open_.empty() && "DrawBudget: BeginPanel() without EndPanel()");
+    pool_ = pool;
+    records_.clear();
+    open_.clear();
+    if (frame_.name.empty()) frame_.name = "frame";
+}
+
+void DrawBudget::BeginPanel(const char* panel, const DrawCost& budget) {
+    Record record = {};
+    record.panel = FindPanel(panel);
+    if (!panels_[record.panel].budgetOverridden) panels_[record.panel].budget = budget;
+
+    record.window = ImGui::GetCurrentWindowRead();
+    const ImDrawList& list = *record.window->DrawList;
+    record.vtxBegin = list.VtxBuffer.Size;
+    record.idxBegin = list.IdxBuffer.Size;
+    record.cmdBegin = list.CmdBuffer.Size;
+    record.childBegin = record.window->DC.ChildWindows.Size;
+    record.taskBegin = pool_ ? pool_->GetQueuedCount() : 0;
+    record.childEnd = -1;
+
+    open_.push_back(static_cast<int>(records_.size()));
+    records_.push_back(record);
+}
+
+void DrawBudget::EndPanel() {
+    IM_ASSERT(!open_.empty() && "DrawBudget: EndPanel() without BeginPanel()");
+    if (open_.empty()) return;
+
+    Record& record = records_[open_.back()];
+    open_.pop_back();
+    IM_ASSERT(record.window == ImGui::GetCurrentWindowRead() && "DrawBudget: EndPanel() in another window");
+
+    const ImDrawList& list = *record.window->DrawList;
+    record.vtxEnd = list.VtxBuffer.Size;
+    record.idxEnd = list.IdxBuffer.Size;
+    record.cmdEnd = list.CmdBuffer.Size;
+    record.childEnd = record.window->DC.ChildWindows.Size;
+    record.taskEnd = pool_ ? pool_->GetQueuedCount() : 0;
+}
+
+bool DrawBudget::Account(PanelDrawStats& stats, const DrawCost& cost) {
+    DrawCost previousPeak = stats.peak;
+    stats.last = cost;
+    stats.frames++;
+    stats.vertexSum += static_cast<uint64_t>(cost.vertices);
+    stats.indexSum += static_cast<uint64_t>(cost.indices);
+    stats.cmdSum += static_cast<uint64_t>(cost.cmds);
+    stats.peak.vertices = std::max(stats.peak.vertices, cost.vertices);
+    stats.peak.indices = std::max(stats.peak.indices, cost.indices);
+    stats.peak.cmds = std::max(stats.peak.cmds, cost.cmds);
+
+    if (!Exceeds(cost, stats.budget)) return false;
+    stats.overruns++;
+
+    // One line per new worst case, not one per frame
+    bool newWorst = stats.overruns == 1 || cost.vertices > previousPeak.vertices ||
+                    cost.indices > previousPeak.indices || cost.cmds > previousPeak.cmds;
+    if (action_ != BudgetAction::Count && newWorst) {
+        fprintf(stderr, "draw budget: %s at %d vtx / %d idx / %d cmds, budget %d / %d / %d\n", stats.name.c_str(),
+                cost.vertices, cost.indices, cost.cmds, stats.budget.vertices, stats.budget.indices,
+                stats.budget.cmds);
+    }
+    if (action_ == BudgetAction::Assert) {
+        IM_ASSERT(false && "DrawBudget: panel over budget (see stderr / GetPanels())");
+    }
+    return true;
+}
+
+void DrawBudget::EndFrame() {
+    IM_ASSERT(open_.empty() && "DrawBudget: BeginPanel() without EndPanel()");
+    std::fill(frameCosts_.begin(), frameCosts_.end(), DrawCost());
+    std::fill(drawn_.begin(), drawn_.end(), false);
+
+    for (const Record& record : records_) {
+        if (record.childEnd < 0) continue;   // Never ended
+
+        // Growth of the calling window's own list, then the child windows
+        // the panel began (complete lists, spliced geometry included)
+        DrawCost cost;
+        cost.vertices = record.vtxEnd - record.vtxBegin;
+        cost.indices = record.idxEnd - record.idxBegin;
+        cost.cmds = record.cmdEnd - record.cmdBegin;
+        const ImVector<ImGuiWindow*>& children = record.window->DC.ChildWindows;
+        for (int i = record.childBegin; i < record.childEnd && i < children.Size; i++) {
+            AddWindowTree(children[i], cost);
+        }
+
+        // Deferred builds that went into the calling window itself; each
+        // replaced one placeholder command
+        for (int task = record.taskBegin; pool_ && task < record.taskEnd; task++) {
+            ParallelDrawSplice splice;
+            if (!pool_->GetSplice(task, splice) || splice.target != record.window->DrawList) continue;
+            cost.vertices += splice.vertices;
+            cost.indices += splice.indices;
+            cost.cmds += splice.cmds - 1;
+        }
+
+        DrawCost& total = frameCosts_[record.panel];
+        total.vertices += cost.vertices;
+        total.indices += cost.indices;
+        total.cmds += std::max(0, cost.cmds);
+        drawn_[record.panel] = true;
+    }
+
+    frameOverruns_ = 0;
+    for (size_t i = 0; i < panels_.size(); i++) {
+        if (drawn_[i] && Account(panels_[i], frameCosts_[i])) frameOverruns_++;
+    }
+
+    DrawCost frame;
+    for (const ImGuiWindow* window : GImGui->Windows) {
+        if (IsDrawn(window)) AddList(*window->DrawList, frame);
+    }
+    if (Account(frame_, frame)) frameOverruns_++;
+}
+
+} // namespace ui
@@ -0,0 +1,176 @@
+#pragma once
+
+#include "imgui.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+struct ImGuiWindow;
+
+namespace ui {
+
+class ParallelDraw;
+
+/**
+ * Geometry of one panel (or one frame): vertices, indices, draw commands
+ * In a budget, 0 means no limit.
+ */
+struct DrawCost {
+    int vertices = 0;
+    int indices = 0;
+    int cmds = 0;
+};
+
+/**
+ * What DrawBudget does when a panel goes over its budget
+ */
+enum class BudgetAction {
+    Count,      // Only count the overrun (GetPanels()[i].overruns)
+    Log,        // Count, and print to stderr when a panel sets a new worst
+    Assert      // Count and IM_ASSERT (debug builds)
+};
+
+/**
+ * Per-panel accounting
+ */
+struct PanelDrawStats {
+    std::string name;
+    DrawCost budget;                                  // Declared or SetBudget() limits
+    DrawCost last;                                    // Last frame the panel was drawn
+    DrawCost peak;
+    uint64_t frames = 0;                              // Frames the panel was drawn
+    uint64_t vertexSum = 0;                           // For means: sum / frames
+    uint64_t indexSum = 0;
+    uint64_t cmdSum = 0;
+    uint64_t overruns = 0;                            // Frames over any budget limit
+    bool budgetOverridden = false;                    // SetBudget() wins over the panel's declaration
+};
+
+/**
+ * Per-panel vertex, index and draw command accounting with budgets
+ *
+ * BeginPanel() / EndPanel() (or a DrawBudgetScope) around a panel call
+ * record the growth of the current window's VtxBuffer, IdxBuffer and
+ * CmdBuffer, and remember which child windows the panel began. Cards and
+ * child windows have draw lists of their own, so those are counted in
+ * full, recursively. Geometry the panel deferred to a ParallelDraw pool is
+ * not in any list until Splice(), so the costs are settled in EndFrame(),
+ * which RenderUI() calls after Splice(): child lists are read then, and
+ * spliced tasks that targeted the panel's own window are added from
+ * ParallelDraw::GetSplice(). RenderUI() also calls BeginFrame().
+ *
+ * Command counts in the calling window are approximate (ImGui merges a
+ * panel's first command into the previous one when nothing changed);
+ * child windows count their non-empty commands, i.e. draw calls. A panel
+ * nested in another counts toward both.
+ *
+ * A panel declares its budget where it is drawn; SetBudget() overrides
+ * that, e.g. with limits for a particular SoC. Nothing is allocated per
+ * frame once every panel has been seen.
+ *
+ * @code
+ *   static ui::DrawBudget drawBudget;
+ *   state.drawBudget = &drawBudget;
+ *
+ *   {
+ *       ui::DrawBudgetScope budget(state.drawBudget, "FaultPanel", { 6000, 9000, 80 });
+ *       RenderFaultPanel(state);
+ *   }
+ * @endcode
+ */
+class DrawBudget {
+public:
+#ifdef NDEBUG
+    static constexpr BudgetAction kDefaultAction = BudgetAction::Count;
+#else
+    static constexpr BudgetAction kDefaultAction = BudgetAction::Log;
+#endif
+
+    explicit DrawBudget(BudgetAction action = kDefaultAction) : action_(action) {}
+
+    void SetAction(BudgetAction action) { action_ = action; }
+
+    /**
+     * Set a panel's budget, replacing what the panel declares
+     */
+    void SetBudget(const char* panel, const DrawCost& budget);
+
+    /**
+     * Budget for everything the frame draws (all visible windows)
+     */
+    void SetFrameBudget(const DrawCost& budget) { frame_.budget = budget; }
+
+    /**
+     * Start accounting a panel in the current window (main thread)
+     *
+     * @param panel Panel name; one entry per name, so a panel drawn twice a frame is summed
+     * @param budget The panel's declared limits (0 = unlimited)
+     */
+    void BeginPanel(const char* panel, const DrawCost& budget = DrawCost());
+    void EndPanel();
+
+    /**
+     * Start a frame, before the first panel
+     *
+     * @param pool Pool the panels defer to this frame (nullptr if none)
+     */
+    void BeginFrame(const ParallelDraw* pool);
+
+    /**
+     * Settle this frame's costs and check budgets
+     * Call after ParallelDraw::Splice() and before ImGui::Render().
+     */
+    void EndFrame();
+
+    /** Panels in order of first appearance */
+    const std::vector<PanelDrawStats>& GetPanels() const { return panels_; }
+
+    /** Whole-frame totals (all visible windows, panels or not) */
+    const PanelDrawStats& GetFrame() const { return frame_; }
+
+    /** Overruns in the last EndFrame() (panels and frame) */
+    int GetFrameOverruns() const { return frameOverruns_; }
+
+private:
+    struct Record {
+        int panel;
+        ImGuiWindow* window;
+        int vtxBegin, idxBegin, cmdBegin, childBegin, taskBegin;
+        int vtxEnd, idxEnd, cmdEnd, childEnd, taskEnd;
+    };
+
+    int FindPanel(const char* name);
+    bool Account(PanelDrawStats& stats, const DrawCost& cost);
+
+    BudgetAction action_;
+    std::vector<PanelDrawStats> panels_;
+    std::vector<DrawCost> frameCosts_;                // Per panel, this frame
+    std::vector<bool> drawn_;                         // Per panel, this frame
+    std::vector<Record> records_;                     // This frame, in BeginPanel() order
+    std::vector<int> open_;                           // Records between Begin and End
+    PanelDrawStats frame_;
+    int frameOverruns_ = 0;
+    const ParallelDraw* pool_ = nullptr;              // This frame's pool
+};
+
+/**
+ * BeginPanel() / EndPanel() for a block; does nothing when budget is null
+ */
+class DrawBudgetScope {
+public:
+    DrawBudgetScope(DrawBudget* budget, const char* panel, const DrawCost& limits = DrawCost())
+        : budget_(budget) {
+        if (budget_) budget_->BeginPanel(panel, limits);
+    }
+    ~DrawBudgetScope() {
+        if (budget_) budget_->EndPanel();
+    }
+
+    DrawBudgetScope(const DrawBudgetScope&) = delete;
+    DrawBudgetScope& operator=(const DrawBudgetScope&) = delete;
+
+private:
+    DrawBudget* budget_;
+};
+
+} // namespace ui
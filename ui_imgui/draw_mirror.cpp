@@ -0,0 +1,877 @@
+#include "draw_mirror.h"
+#include "monotonic_clock.h"
+#include "telemetry_codec.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <type_traits>
+
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+// Vertex and index buffers are copied into the image as-is
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ != __ORDER_LITTLE_ENDIAN__
+#error "draw_mirror: frame images are little-endian"
+#endif
+
+// Texture ids go on the wire as u64; ImTextureID is an integer from Dear ImGui 1.91.4 on
+static_assert(std::is_integral<ImTextureID>::value && sizeof(ImTextureID) <= sizeof(uint64_t),
+              "draw_mirror: needs Dear ImGui 1.91.4 or later (integer ImTextureID)");
+
+namespace ui {
+namespace mirror {
+
+namespace {
+
+constexpr size_t kImageHeaderSize = 40;
+constexpr size_t kListEntrySize = 12;
+constexpr size_t kCommandSize = 36;
+constexpr size_t kHelloSize = 8;
+constexpr size_t kFrameHeaderSize = 16;
+
+constexpr uint8_t kFrameKey = 0;
+constexpr uint8_t kFrameDelta = 1;
+
+constexpr size_t kMinMatch = 8;
+constexpr size_t kMinHashMatch = 24;      // Shorter hash hits are mostly coincidence (repeated UVs/colors)
+constexpr int kHashBits = 16;
+constexpr size_t kReferenceStride = 8;     // Reference positions indexed for shifted matches
+constexpr size_t kIndexAfterLiterals = 32; // Literal run that suggests a shift, not an edit
+constexpr size_t kIndexWindow = 64 * 1024; // Reference indexed around the current position
+
+constexpr size_t kReceiveChunk = 64 * 1024;
+constexpr size_t kMaxImageSize = 64u * 1024 * 1024;
+
+template <typename T>
+inline void Put(uint8_t*& p, T value) {
+    memcpy(p, &value, sizeof(T));
+    p += sizeof(T);
+}
+
+template <typename T>
+inline T Get(const uint8_t*& p) {
+    T value;
+    memcpy(&value, p, sizeof(T));
+    p += sizeof(T);
+    return value;
+}
+
+inline uint64_t Load64(const uint8_t* p) {
+    uint64_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+inline uint32_t HashAt(const uint8_t* p) {
+    return static_cast<uint32_t>((Load64(p) * 0x9E3779B97F4A7C15ull) >> (64 - kHashBits));
+}
+
+// Length of the common prefix of a and b, at most limit
+inline size_t CommonLength(const uint8_t* a, const uint8_t* b, size_t limit) {
+    size_t n = 0;
+    while (n + 8 <= limit) {
+        uint64_t diff = Load64(a + n) ^ Load64(b + n);
+        if (diff) return n + static_cast<size_t>(__builtin_ctzll(diff) >> 3);
+        n += 8;
+    }
+    while (n < limit && a[n] == b[n]) n++;
+    return n;
+}
+
+using codec::GetVarint;
+using codec::PutVarint;
+
+void WriteFrameHeader(uint8_t* p, uint32_t payloadSize, uint8_t type, uint32_t frameNumber, uint32_t imageSize) {
+    Put<uint32_t>(p, payloadSize);
+    Put<uint8_t>(p, type);
+    Put<uint8_t>(p, 0);
+    Put<uint16_t>(p, 0);
+    Put<uint32_t>(p, frameNumber);
+    Put<uint32_t>(p, imageSize);
+}
+
+// Build a frame message: header + encoded image
+void BuildFrameMessage(const std::vector<uint8_t>& reference, const std::vector<uint8_t>& image, uint8_t type,
+                       uint32_t frameNumber, DeltaEncoderScratch& scratch, std::vector<uint8_t>& message) {
+    message.resize(kFrameHeaderSize);
+    size_t payload = EncodeFrameDelta(reference.data(), reference.size(), image.data(), image.size(),
+                                      scratch, message);
+    WriteFrameHeader(message.data(), static_cast<uint32_t>(payload), type, frameNumber,
+                     static_cast<uint32_t>(image.size()));
+}
+
+} // namespace
+
+void SerializeDrawData(const ImDrawData* drawData, ImTextureID fontTexture, int atlasWidth, int atlasHeight,
+                       std::vector<uint8_t>& image) {
+    int listCount = drawData ? drawData->CmdListsCount : 0;
+
+    size_t size = kImageHeaderSize + static_cast<size_t>(listCount) * kListEntrySize;
+    for (int i = 0; i < listCount; i++) {
+        const ImDrawList* list = drawData->CmdLists[i];
+        size += static_cast<size_t>(list->CmdBuffer.Size) * kCommandSize
+              + static_cast<size_t>(list->VtxBuffer.Size) * sizeof(ImDrawVert)
+              + static_cast<size_t>(list->IdxBuffer.Size) * sizeof(ImDrawIdx);
+    }
+    image.resize(size);
+
+    uint8_t* p = image.data();
+    Put<uint32_t>(p, static_cast<uint32_t>(listCount));
+    ImVec2 displayPos = drawData ? drawData->DisplayPos : ImVec2(0, 0);
+    ImVec2 displaySize = drawData ? drawData->DisplaySize : ImVec2(0, 0);
+    ImVec2 scale = drawData ? drawData->FramebufferScale : ImVec2(1, 1);
+    Put<float>(p, displayPos.x);
+    Put<float>(p, displayPos.y);
+    Put<float>(p, displaySize.x);
+    Put<float>(p, displaySize.y);
+    Put<float>(p, scale.x);
+    Put<float>(p, scale.y);
+    Put<uint64_t>(p, static_cast<uint64_t>(fontTexture));
+    Put<uint16_t>(p, static_cast<uint16_t>(atlasWidth));
+    Put<uint16_t>(p, static_cast<uint16_t>(atlasHeight));
+
+    // Command counts are patched below once callbacks are dropped
+    uint8_t* table = p;
+    p += static_cast<size_t>(listCount) * kListEntrySize;
+
+    for (int i = 0; i < listCount; i++) {
+        const ImDrawList* list = drawData->CmdLists[i];
+
+        uint32_t commands = 0;
+        uint32_t nextIdxOffset = 0;
+        for (const ImDrawCmd& cmd : list->CmdBuffer) {
+            if (cmd.UserCallback) continue;
+            Put<float>(p, cmd.ClipRect.x);
+            Put<float>(p, cmd.ClipRect.y);
+            Put<float>(p, cmd.ClipRect.z);
+            Put<float>(p, cmd.ClipRect.w);
+            Put<uint64_t>(p, static_cast<uint64_t>(cmd.TextureId));
+            Put<uint32_t>(p, cmd.VtxOffset);
+            Put<uint32_t>(p, cmd.IdxOffset - nextIdxOffset);
+            Put<uint32_t>(p, cmd.ElemCount);
+            nextIdxOffset = cmd.IdxOffset + cmd.ElemCount;
+            commands++;
+        }
+
+        size_t vtxBytes = static_cast<size_t>(list->VtxBuffer.Size) * sizeof(ImDrawVert);
+        if (vtxBytes) memcpy(p, list->VtxBuffer.Data, vtxBytes);
+        p += vtxBytes;
+
+        ImDrawIdx previous = 0;
+        for (ImDrawIdx index : list->IdxBuffer) {
+            Put<ImDrawIdx>(p, static_cast<ImDrawIdx>(index - previous));
+            previous = index;
+        }
+
+        uint8_t* entry = table + static_cast<size_t>(i) * kListEntrySize;
+        Put<uint32_t>(entry, commands);
+        Put<uint32_t>(entry, static_cast<uint32_t>(list->VtxBuffer.Size));
+        Put<uint32_t>(entry, static_cast<uint32_t>(list->IdxBuffer.Size));
+    }
+    image.resize(static_cast<size_t>(p - image.data()));
+}
+
+DeltaEncoderScratch::DeltaEncoderScratch() : table_(new uint32_t[size_t(1) << kHashBits]) {}
+
+size_t EncodeFrameDelta(const uint8_t* reference, size_t referenceSize, const uint8_t* image, size_t imageSize,
+                        DeltaEncoderScratch& scratch, std::vector<uint8_t>& out) {
+    // Positions are "virtual": reference bytes first, then the image, so a
+    // distance reaches either the previous frame or earlier in this one.
+    // Table entries are position + 1 (0 = empty).
+    uint32_t* table = scratch.table_.get();
+    std::fill(table, table + (size_t(1) << kHashBits), 0u);
+    size_t indexedEnd = 0;
+
+    size_t start = out.size();
+    size_t literalStart = 0;
+    // Two most recent distances; the first starts at "same place in the
+    // previous frame" and a short self-match elsewhere does not lose it
+    size_t repeat[2] = { referenceSize, referenceSize };
+    size_t i = 0;
+
+    // Bytes matching image[i..] at distance back from virtual position v
+    auto matchLength = [&](size_t distance) -> size_t {
+        size_t v = referenceSize + i;
+        if (distance == 0 || distance > v) return 0;
+        size_t source = v - distance;
+        if (source < referenceSize) {
+            return CommonLength(image + i, reference + source, std::min(imageSize - i, referenceSize - source));
+        }
+        return CommonLength(image + i, image + (source - referenceSize), imageSize - i);
+    };
+
+    auto emit = [&](size_t length, size_t distance) {
+        PutVarint(out, i - literalStart);
+        out.insert(out.end(), image + literalStart, image + i);
+        PutVarint(out, length - kMinMatch);
+        if (distance == repeat[0]) {
+            PutVarint(out, 0);
+        } else if (distance == repeat[1]) {
+            PutVarint(out, 1);
+            repeat[1] = repeat[0];
+        } else {
+            PutVarint(out, distance + 1);
+            repeat[1] = repeat[0];
+        }
+        repeat[0] = distance;
+        i += length;
+        literalStart = i;
+    };
+
+    while (i + kMinMatch <= imageSize) {
+        size_t length = matchLength(repeat[0]);
+        if (length >= kMinMatch) {
+            emit(length, repeat[0]);
+            continue;
+        }
+        length = matchLength(repeat[1]);
+        if (length >= kMinMatch) {
+            emit(length, repeat[1]);
+            continue;
+        }
+
+        // A long literal run means content moved; index the previous frame
+        // around here so the new position can be found. Only a window is
+        // indexed: repeated content further away (another panel with the
+        // same glyphs) would otherwise win the hash slots.
+        if (i - literalStart >= kIndexAfterLiterals && indexedEnd < referenceSize && i + kIndexWindow > indexedEnd) {
+            size_t from = std::max(indexedEnd, i > kIndexWindow ? i - kIndexWindow : size_t(0));
+            from -= from % kReferenceStride;
+            size_t to = std::min(referenceSize, i + 2 * kIndexWindow);
+            for (size_t p = from; p + kMinMatch <= to; p += kReferenceStride) {
+                table[HashAt(reference + p)] = static_cast<uint32_t>(p + 1);
+            }
+            indexedEnd = to;
+        }
+
+        uint32_t& slot = table[HashAt(image + i)];
+        size_t v = referenceSize + i;
+        if (slot) {
+            size_t distance = v - (slot - 1);
+            length = matchLength(distance);
+            if (length >= kMinHashMatch) {
+                slot = static_cast<uint32_t>(v + 1);
+
+                // Extend back over literals that also match
+                size_t source = v - distance;
+                size_t floor = source >= referenceSize ? referenceSize : 0;
+                while (i > literalStart && source > floor) {
+                    uint8_t prior = source - 1 < referenceSize ? reference[source - 1]
+                                                               : image[source - 1 - referenceSize];
+                    if (prior != image[i - 1]) break;
+                    i--;
+                    source--;
+                    length++;
+                }
+                emit(length, distance);
+                continue;
+            }
+        }
+        slot = static_cast<uint32_t>(v + 1);
+        i++;
+    }
+
+    if (literalStart < imageSize) {
+        PutVarint(out, imageSize - literalStart);
+        out.insert(out.end(), image + literalStart, image + imageSize);
+    }
+    return out.size() - start;
+}
+
+bool DecodeFrameDelta(const uint8_t* reference, size_t referenceSize, const uint8_t* data, size_t size,
+                      size_t imageSize, std::vector<uint8_t>& image) {
+    image.resize(imageSize);
+    uint8_t* out = image.data();
+    const uint8_t* p = data;
+    const uint8_t* end = data + size;
+    size_t written = 0;
+    size_t repeat[2] = { referenceSize, referenceSize };
+
+    while (written < imageSize) {
+        uint64_t literals;
+        if (!GetVarint(p, end, literals)) return false;
+        if (literals > static_cast<size_t>(end - p) || literals > imageSize - written) return false;
+        memcpy(out + written, p, literals);
+        p += literals;
+        written += literals;
+        if (written == imageSize) break;
+
+        uint64_t length, distance;
+        if (!GetVarint(p, end, length) || !GetVarint(p, end, distance)) return false;
+        length += kMinMatch;
+        if (distance == 0) {
+            distance = repeat[0];
+        } else if (distance == 1) {
+            distance = repeat[1];
+            repeat[1] = repeat[0];
+        } else {
+            distance -= 1;
+            repeat[1] = repeat[0];
+        }
+        repeat[0] = distance;
+
+        size_t v = referenceSize + written;
+        if (distance == 0 || distance > v || length > imageSize - written) return false;
+        size_t source = v - distance;
+        if (source < referenceSize) {
+            if (length > referenceSize - source) return false;
+            memcpy(out + written, reference + source, length);
+        } else if (distance >= length) {
+            memcpy(out + written, out + (source - referenceSize), length);
+        } else {
+            // Overlapping copy repeats the last `distance` bytes
+            for (size_t k = 0; k < length; k++) out[written + k] = out[source - referenceSize + k];
+        }
+        written += length;
+    }
+    return p == end;
+}
+
+// --- Server ------------------------------------------------------------------
+
+struct MirrorServer::Client {
+    int fd = -1;
+    std::vector<uint8_t> queue;
+    size_t sent = 0;
+    bool synced = false;        // Has every frame up to lastFrame queued
+    uint32_t lastFrame = 0;
+    bool dead = false;
+
+    size_t Queued() const { return queue.size() - sent; }
+
+    void Append(const std::vector<uint8_t>& message) {
+        if (sent > 0) {
+            queue.erase(queue.begin(), queue.begin() + static_cast<std::ptrdiff_t>(sent));
+            sent = 0;
+        }
+        queue.insert(queue.end(), message.begin(), message.end());
+    }
+};
+
+MirrorServer::MirrorServer(const MirrorServerConfig& config) : config_(config) {
+    if (config_.maxClients < 1) config_.maxClients = 1;
+}
+
+MirrorServer::~MirrorServer() {
+    Stop();
+}
+
+bool MirrorServer::Start() {
+    if (running_) return true;
+
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(config_.port);
+    if (inet_pton(AF_INET, config_.bindAddress, &addr.sin_addr) != 1) return false;
+
+    listenFd_ = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    int one = 1;
+    bool ok = listenFd_ >= 0 &&
+              setsockopt(listenFd_, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one)) == 0 &&
+              bind(listenFd_, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)) == 0 &&
+              listen(listenFd_, config_.maxClients) == 0;
+    if (ok) {
+        socklen_t length = sizeof(addr);
+        ok = getsockname(listenFd_, reinterpret_cast<sockaddr*>(&addr), &length) == 0;
+        port_ = ntohs(addr.sin_port);
+    }
+    if (ok) {
+        wakeFd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        ok = wakeFd_ >= 0;
+    }
+    if (!ok) {
+        if (listenFd_ >= 0) close(listenFd_);
+        listenFd_ = -1;
+        return false;
+    }
+
+    stopRequested_.store(false, std::memory_order_relaxed);
+    thread_ = std::thread(&MirrorServer::ServerMain, this);
+    running_ = true;
+    return true;
+}
+
+void MirrorServer::Stop() {
+    if (!running_) return;
+
+    stopRequested_.store(true, std::memory_order_relaxed);
+    uint64_t one = 1;
+    (void)!write(wakeFd_, &one, sizeof(one));
+    if (thread_.joinable()) thread_.join();
+
+    for (auto& client : clients_) close(client->fd);
+    clients_.clear();
+    clientCount_.store(0, std::memory_order_relaxed);
+    close(listenFd_);
+    close(wakeFd_);
+    listenFd_ = wakeFd_ = -1;
+    running_ = false;
+}
+
+void MirrorServer::Publish(const ImDrawData* drawData) {
+    if (!running_ || clientCount_.load(std::memory_order_relaxed) == 0) return;
+
+    const ImFontAtlas* atlas = ImGui::GetIO().Fonts;
+    SerializeDrawData(drawData, atlas->TexID, atlas->TexWidth, atlas->TexHeight, publishImage_);
+    {
+        std::lock_guard<std::mutex> lock(pendingMutex_);
+        if (hasPending_) framesCoalesced_.fetch_add(1, std::memory_order_relaxed);
+        pending_.swap(publishImage_);
+        hasPending_ = true;
+    }
+    framesPublished_.fetch_add(1, std::memory_order_relaxed);
+
+    uint64_t one = 1;
+    (void)!write(wakeFd_, &one, sizeof(one));
+}
+
+MirrorServerStats MirrorServer::GetStats() const {
+    MirrorServerStats stats;
+    stats.framesPublished = framesPublished_.load(std::memory_order_relaxed);
+    stats.framesEncoded = framesEncoded_.load(std::memory_order_relaxed);
+    stats.framesUnchanged = framesUnchanged_.load(std::memory_order_relaxed);
+    stats.framesCoalesced = framesCoalesced_.load(std::memory_order_relaxed);
+    stats.keyframes = keyframes_.load(std::memory_order_relaxed);
+    stats.imageBytes = imageBytes_.load(std::memory_order_relaxed);
+    stats.sentBytes = sentBytes_.load(std::memory_order_relaxed);
+    stats.encodeNs = encodeNs_.load(std::memory_order_relaxed);
+    stats.clients = clientCount_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void MirrorServer::ServerMain() {
+    std::vector<pollfd> fds;
+
+    while (!stopRequested_.load(std::memory_order_relaxed)) {
+        fds.clear();
+        fds.push_back({ listenFd_, POLLIN, 0 });
+        fds.push_back({ wakeFd_, POLLIN, 0 });
+        for (auto& client : clients_) {
+            short events = POLLIN;
+            if (client->Queued()) events |= POLLOUT;
+            fds.push_back({ client->fd, events, 0 });
+        }
+        poll(fds.data(), fds.size(), 100);
+
+        if (fds[1].revents & POLLIN) {
+            uint64_t count;
+            (void)!read(wakeFd_, &count, sizeof(count));
+        }
+
+        // Viewers send nothing; readable means closed (or garbage to drop)
+        for (size_t c = 0; c < clients_.size(); c++) {
+            short revents = fds[c + 2].revents;
+            if (revents & (POLLERR | POLLHUP | POLLNVAL)) {
+                clients_[c]->dead = true;
+            } else if (revents & POLLIN) {
+                uint8_t discard[256];
+                ssize_t n = recv(clients_[c]->fd, discard, sizeof(discard), MSG_DONTWAIT);
+                if (n == 0 || (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK)) clients_[c]->dead = true;
+            }
+        }
+        if (fds[0].revents & POLLIN) AcceptClients();
+
+        EncodeLatest();
+        QueueFrames();
+        for (auto& client : clients_) {
+            if (!client->dead && client->Queued()) FlushClient(*client);
+        }
+
+        size_t alive = 0;
+        for (auto& client : clients_) {
+            if (client->dead) {
+                close(client->fd);
+            } else {
+                clients_[alive++] = std::move(client);
+            }
+        }
+        clients_.resize(alive);
+        clientCount_.store(static_cast<int>(alive), std::memory_order_relaxed);
+    }
+}
+
+void MirrorServer::AcceptClients() {
+    for (;;) {
+        int fd = accept4(listenFd_, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) return;
+        if (static_cast<int>(clients_.size()) >= config_.maxClients) {
+            close(fd);
+            continue;
+        }
+        int one = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+
+        std::unique_ptr<Client> client(new Client());
+        client->fd = fd;
+        std::vector<uint8_t> hello(kHelloSize);
+        uint8_t* p = hello.data();
+        Put<uint32_t>(p, kMirrorMagic);
+        Put<uint16_t>(p, kMirrorVersion);
+        Put<uint8_t>(p, static_cast<uint8_t>(sizeof(ImDrawVert)));
+        Put<uint8_t>(p, static_cast<uint8_t>(sizeof(ImDrawIdx)));
+        client->Append(hello);
+        clients_.push_back(std::move(client));
+    }
+}
+
+void MirrorServer::EncodeLatest() {
+    {
+        std::lock_guard<std::mutex> lock(pendingMutex_);
+        if (!hasPending_) return;
+        incoming_.swap(pending_);
+        hasPending_ = false;
+    }
+
+    if (incoming_.size() == image_.size() && memcmp(incoming_.data(), image_.data(), image_.size()) == 0) {
+        framesUnchanged_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    uint64_t start = MonotonicNowNs();
+    BuildFrameMessage(image_, incoming_, image_.empty() ? kFrameKey : kFrameDelta, frameNumber_ + 1,
+                      scratch_, delta_);
+    encodeNs_.fetch_add(MonotonicNowNs() - start, std::memory_order_relaxed);
+
+    image_.swap(incoming_);
+    frameNumber_++;
+    deltaReady_ = true;
+    keyframeReady_ = false;
+    framesEncoded_.fetch_add(1, std::memory_order_relaxed);
+    imageBytes_.fetch_add(image_.size(), std::memory_order_relaxed);
+}
+
+const std::vector<uint8_t>& MirrorServer::Keyframe() {
+    if (!keyframeReady_) {
+        static const std::vector<uint8_t> kNoReference;
+        uint64_t start = MonotonicNowNs();
+        BuildFrameMessage(kNoReference, image_, kFrameKey, frameNumber_, scratch_, keyframe_);
+        encodeNs_.fetch_add(MonotonicNowNs() - start, std::memory_order_relaxed);
+        keyframeReady_ = true;
+    }
+    return keyframe_;
+}
+
+void MirrorServer::QueueFrames() {
+    for (auto& client : clients_) {
+        if (client->dead) continue;
+
+        if (deltaReady_ && client->synced) {
+            // The delta is against frame N-1: only valid for a client that has it
+            bool fits = client->Queued() + delta_.size() <= config_.maxQueuedBytes;
+            if (client->lastFrame + 1 == frameNumber_ && fits) {
+                client->Append(delta_);
+                client->lastFrame = frameNumber_;
+            } else {
+                client->synced = false;
+            }
+        }
+        if (!client->synced && client->Queued() == 0 && frameNumber_ > 0) {
+            client->Append(Keyframe());
+            client->synced = true;
+            client->lastFrame = frameNumber_;
+            keyframes_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    deltaReady_ = false;
+}
+
+void MirrorServer::FlushClient(Client& client) {
+    while (client.sent < client.queue.size()) {
+        ssize_t n = send(client.fd, client.queue.data() + client.sent, client.queue.size() - client.sent,
+                         MSG_NOSIGNAL | MSG_DONTWAIT);
+        if (n > 0) {
+            client.sent += static_cast<size_t>(n);
+            sentBytes_.fetch_add(static_cast<uint64_t>(n), std::memory_order_relaxed);
+        } else if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            return;
+        } else if (n < 0 && errno == EINTR) {
+            continue;
+        } else {
+            client.dead = true;
+            return;
+        }
+    }
+    client.queue.clear();
+    client.sent = 0;
+}
+
+// --- Viewer ------------------------------------------------------------------
+
+MirrorClient::MirrorClient() {
+    drawData_.Clear();
+}
+
+MirrorClient::~MirrorClient() {
+    Disconnect();
+    for (ImDrawList* list : lists_) delete list;
+}
+
+bool MirrorClient::Connect(const char* host, uint16_t port) {
+    Disconnect();
+
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    if (inet_pton(AF_INET, host, &addr.sin_addr) != 1) return false;
+
+    fd_ = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd_ < 0) return false;
+    if (connect(fd_, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)) != 0) {
+        Disconnect();
+        return false;
+    }
+    fcntl(fd_, F_SETFL, fcntl(fd_, F_GETFL) | O_NONBLOCK);
+
+    // The hello is queued on accept; give the server thread a moment
+    uint64_t deadline = MonotonicNowNs() + 2000000000ull;
+    while (!helloReceived_ && fd_ >= 0 && MonotonicNowNs() < deadline) {
+        Poll(100);
+    }
+    return helloReceived_ && fd_ >= 0;
+}
+
+void MirrorClient::Disconnect() {
+    if (fd_ >= 0) close(fd_);
+    fd_ = -1;
+    receive_.clear();
+    receiveStart_ = 0;
+    helloReceived_ = false;
+}
+
+bool MirrorClient::Poll(int timeoutMs) {
+    if (fd_ < 0) return false;
+
+    if (timeoutMs > 0) {
+        pollfd pfd{ fd_, POLLIN, 0 };
+        poll(&pfd, 1, timeoutMs);
+    }
+
+    bool closed = false;
+    for (;;) {
+        size_t used = receive_.size();
+        receive_.resize(used + kReceiveChunk);
+        ssize_t n = recv(fd_, receive_.data() + used, kReceiveChunk, MSG_DONTWAIT);
+        receive_.resize(used + static_cast<size_t>(n > 0 ? n : 0));
+        if (n > 0) {
+            stats_.receivedBytes += static_cast<uint64_t>(n);
+            continue;
+        }
+        if (n == 0 || (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)) closed = true;
+        if (n < 0 && errno == EINTR) continue;
+        break;
+    }
+
+    uint32_t before = frameNumber_;
+    bool ok = DecodeMessages();
+    if (!ok || closed) Disconnect();
+    return frameNumber_ != before;
+}
+
+bool MirrorClient::DecodeMessages() {
+    const uint8_t* begin = receive_.data() + receiveStart_;
+    const uint8_t* end = receive_.data() + receive_.size();
+
+    if (!helloReceived_) {
+        if (static_cast<size_t>(end - begin) < kHelloSize) return true;
+        const uint8_t* p = begin;
+        uint32_t magic = Get<uint32_t>(p);
+        uint16_t version = Get<uint16_t>(p);
+        uint8_t vertexSize = Get<uint8_t>(p);
+        uint8_t indexSize = Get<uint8_t>(p);
+        if (magic != kMirrorMagic || version != kMirrorVersion ||
+            vertexSize != sizeof(ImDrawVert) || indexSize != sizeof(ImDrawIdx)) {
+            return false;
+        }
+        helloReceived_ = true;
+        begin = p;
+    }
+
+    while (static_cast<size_t>(end - begin) >= kFrameHeaderSize) {
+        const uint8_t* p = begin;
+        uint32_t payloadSize = Get<uint32_t>(p);
+        uint8_t type = Get<uint8_t>(p);
+        p += 3;
+        uint32_t frameNumber = Get<uint32_t>(p);
+        uint32_t imageSize = Get<uint32_t>(p);
+        if (imageSize > kMaxImageSize || type > kFrameDelta) return false;
+        if (static_cast<size_t>(end - p) < payloadSize) break;
+
+        if (type == kFrameDelta && (!hasFrame_ || frameNumber != frameNumber_ + 1)) return false;
+
+        uint64_t start = MonotonicNowNs();
+        bool key = type == kFrameKey;
+        if (!DecodeFrameDelta(key ? nullptr : image_.data(), key ? 0 : image_.size(),
+                              p, payloadSize, imageSize, decoded_)) {
+            return false;
+        }
+        stats_.decodeNs += MonotonicNowNs() - start;
+
+        image_.swap(decoded_);
+        frameNumber_ = frameNumber;
+        hasFrame_ = true;
+        drawDataStale_ = true;
+        stats_.framesReceived++;
+        if (key) stats_.keyframes++;
+        begin = p + payloadSize;
+    }
+
+    receiveStart_ = static_cast<size_t>(begin - receive_.data());
+    if (receiveStart_ == receive_.size()) {
+        receive_.clear();
+        receiveStart_ = 0;
+    } else if (receiveStart_ > receive_.size() / 2) {
+        receive_.erase(receive_.begin(), receive_.begin() + static_cast<std::ptrdiff_t>(receiveStart_));
+        receiveStart_ = 0;
+    }
+    return true;
+}
+
+void MirrorClient::MapTexture(ImTextureID remote, ImTextureID local) {
+    for (auto& entry : textureMap_) {
+        if (entry.first == remote) {
+            entry.second = local;
+            drawDataStale_ = hasFrame_;
+            return;
+        }
+    }
+    textureMap_.emplace_back(remote, local);
+    drawDataStale_ = hasFrame_;
+}
+
+bool MirrorClient::ResolveTexture(ImTextureID remote, ImTextureID& local) const {
+    for (const auto& entry : textureMap_) {
+        if (entry.first == remote) {
+            local = entry.second;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool MirrorClient::AtlasMatches() const {
+    if (image_.size() < kImageHeaderSize) return false;
+    const uint8_t* p = image_.data() + 36;
+    uint16_t width = Get<uint16_t>(p);
+    uint16_t height = Get<uint16_t>(p);
+    const ImFontAtlas* atlas = ImGui::GetIO().Fonts;
+    return width == atlas->TexWidth && height == atlas->TexHeight;
+}
+
+ImDrawData* MirrorClient::GetDrawData() {
+    if (!hasFrame_) return nullptr;
+    if (drawDataStale_) RebuildDrawData();
+    return drawData_.Valid ? &drawData_ : nullptr;
+}
+
+void MirrorClient::RebuildDrawData() {
+    // The image comes from the network: every early return leaves
+    // drawData_.Valid false (Clear()) and the frame is not drawn
+    drawDataStale_ = false;
+    drawData_.Clear();
+
+    const uint8_t* p = image_.data();
+    const uint8_t* end = p + image_.size();
+    if (image_.size() < kImageHeaderSize) return;
+
+    uint32_t listCount = Get<uint32_t>(p);
+    ImVec2 displayPos, displaySize, scale;
+    displayPos.x = Get<float>(p);
+    displayPos.y = Get<float>(p);
+    displaySize.x = Get<float>(p);
+    displaySize.y = Get<float>(p);
+    scale.x = Get<float>(p);
+    scale.y = Get<float>(p);
+    ImTextureID fontTexture = static_cast<ImTextureID>(Get<uint64_t>(p));
+    p += 4;
+    if (listCount > static_cast<size_t>(end - p) / kListEntrySize) return;
+
+    const uint8_t* table = p;
+    p += static_cast<size_t>(listCount) * kListEntrySize;
+    while (lists_.size() < listCount) lists_.push_back(new ImDrawList(ImGui::GetDrawListSharedData()));
+
+    ImTextureID localFont = ImGui::GetIO().Fonts->TexID;
+    int totalVtx = 0, totalIdx = 0;
+
+    for (uint32_t i = 0; i < listCount; i++) {
+        uint32_t commands = Get<uint32_t>(table);
+        uint32_t vertices = Get<uint32_t>(table);
+        uint32_t indices = Get<uint32_t>(table);
+        size_t bytes = static_cast<size_t>(commands) * kCommandSize
+                     + static_cast<size_t>(vertices) * sizeof(ImDrawVert)
+                     + static_cast<size_t>(indices) * sizeof(ImDrawIdx);
+        if (bytes > static_cast<size_t>(end - p)) return;
+
+        ImDrawList* list = lists_[i];
+        list->CmdBuffer.resize(static_cast<int>(commands));
+        int kept = 0;
+        uint32_t nextIdxOffset = 0;
+        for (uint32_t c = 0; c < commands; c++) {
+            ImDrawCmd& cmd = list->CmdBuffer[kept];
+            cmd = ImDrawCmd();
+            cmd.ClipRect.x = Get<float>(p);
+            cmd.ClipRect.y = Get<float>(p);
+            cmd.ClipRect.z = Get<float>(p);
+            cmd.ClipRect.w = Get<float>(p);
+            ImTextureID remote = static_cast<ImTextureID>(Get<uint64_t>(p));
+            cmd.VtxOffset = Get<uint32_t>(p);
+            cmd.IdxOffset = nextIdxOffset + Get<uint32_t>(p);
+            cmd.ElemCount = Get<uint32_t>(p);
+            nextIdxOffset = cmd.IdxOffset + cmd.ElemCount;
+            if (static_cast<uint64_t>(cmd.IdxOffset) + cmd.ElemCount > indices) return;
+
+            if (remote == fontTexture) {
+                cmd.TextureId = localFont;
+            } else if (!ResolveTexture(remote, cmd.TextureId)) {
+                continue;   // Texture the viewer does not have
+            }
+            kept++;
+        }
+        list->CmdBuffer.resize(kept);
+
+        list->VtxBuffer.resize(static_cast<int>(vertices));
+        if (vertices) memcpy(list->VtxBuffer.Data, p, static_cast<size_t>(vertices) * sizeof(ImDrawVert));
+        p += static_cast<size_t>(vertices) * sizeof(ImDrawVert);
+
+        list->IdxBuffer.resize(static_cast<int>(indices));
+        ImDrawIdx previous = 0;
+        for (uint32_t k = 0; k < indices; k++) {
+            previous = static_cast<ImDrawIdx>(previous + Get<ImDrawIdx>(p));
+            list->IdxBuffer.Data[k] = previous;
+        }
+
+        // The renderer reads VtxBuffer[VtxOffset + index]. Commands of a real
+        // draw list cover disjoint index ranges (spliced ones out of order),
+        // so more elements than indices means overlap and bounds the scan
+        uint64_t elements = 0;
+        for (const ImDrawCmd& cmd : list->CmdBuffer) {
+            if (cmd.ElemCount == 0) continue;
+            elements += cmd.ElemCount;
+            if (elements > indices) return;
+            ImDrawIdx highest = 0;
+            const ImDrawIdx* idx = list->IdxBuffer.Data + cmd.IdxOffset;
+            for (unsigned int k = 0; k < cmd.ElemCount; k++) highest = std::max(highest, idx[k]);
+            if (static_cast<uint64_t>(cmd.VtxOffset) + highest >= vertices) return;
+        }
+
+        drawData_.CmdLists.push_back(list);
+        totalVtx += static_cast<int>(vertices);
+        totalIdx += static_cast<int>(indices);
+    }
+
+    drawData_.Valid = true;
+    drawData_.CmdListsCount = static_cast<int>(listCount);
+    drawData_.TotalVtxCount = totalVtx;
+    drawData_.TotalIdxCount = totalIdx;
+    drawData_.DisplayPos = displayPos;
+    drawData_.DisplaySize = displaySize;
+    drawData_.FramebufferScale = scale;
+}
+
+} // namespace mirror
+} // namespace ui
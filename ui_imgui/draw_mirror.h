@@ -0,0 +1,321 @@
+#pragma once
+
+#include "imgui.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ui {
+namespace mirror {
+
+/**
+ * Remote dashboard mirroring (Linux only)
+ *
+ * The car serializes each frame's ImDrawData into a "frame image" and
+ * streams it over TCP as a delta against the previous image; a viewer on a
+ * laptop rebuilds the ImDrawData and renders it with its own backend. No
+ * video encoder, and the viewer's picture is pixel-identical.
+ *
+ * Frame image (little-endian, the uncompressed form of one frame):
+ *
+ *   header   u32 list count, f32 x6 display pos/size/framebuffer scale,
+ *            u64 font atlas texture, u16 x2 atlas size
+ *   lists    u32 x3 per list: command, vertex, index count
+ *   per list commands: f32 x4 clip rect, u64 texture, u32 vertex offset,
+ *            u32 index offset (relative to the end of the previous
+ *            command), u32 element count
+ *            vertices: ImDrawVert as-is
+ *            indices: ImDrawIdx, each stored as the difference to the
+ *            previous one, so inserting a glyph does not change every
+ *            index after it
+ *
+ * Callback commands (ImDrawList::AddCallback) cannot be mirrored and are
+ * dropped. Requires Dear ImGui 1.91.4 or later, where ImTextureID is an
+ * integer (ImU64) and can be sent as-is.
+ *
+ * Delta coding is LZ77 with the previous image as a preset dictionary:
+ * unchanged runs become a copy at the "same place last frame" (a repeat
+ * distance, usually a single byte), shifted runs are found through a hash
+ * table, and new bytes go out as literals. A keyframe is the same coding
+ * with an empty dictionary (only matches within the frame). Identical
+ * frames are not sent at all, so a parked dashboard costs nothing.
+ */
+
+constexpr uint16_t kDefaultMirrorPort = 47100;
+constexpr uint32_t kMirrorMagic = 0x52494D44;   // "DMIR"
+constexpr uint16_t kMirrorVersion = 1;
+
+/**
+ * Serialize draw data into a frame image
+ *
+ * @param drawData Draw data after ImGui::Render() (nullptr gives an empty frame)
+ * @param fontTexture Font atlas texture; the viewer maps it to its own atlas
+ * @param atlasWidth Font atlas size, so the viewer can check that its UVs match
+ * @param image Receives the image (capacity is reused)
+ */
+void SerializeDrawData(const ImDrawData* drawData, ImTextureID fontTexture, int atlasWidth, int atlasHeight,
+                       std::vector<uint8_t>& image);
+
+/**
+ * Scratch state for EncodeFrameDelta (the match hash table)
+ * Reuse one per encoder thread; it holds no frame data between calls.
+ */
+class DeltaEncoderScratch {
+public:
+    DeltaEncoderScratch();
+
+private:
+    friend size_t EncodeFrameDelta(const uint8_t*, size_t, const uint8_t*, size_t,
+                                   DeltaEncoderScratch&, std::vector<uint8_t>&);
+    std::unique_ptr<uint32_t[]> table_;
+};
+
+/**
+ * Encode image as a delta against reference (reference size 0 = keyframe)
+ *
+ * @param out Receives the encoded bytes (appended)
+ * @return Number of bytes appended
+ */
+size_t EncodeFrameDelta(const uint8_t* reference, size_t referenceSize, const uint8_t* image, size_t imageSize,
+                        DeltaEncoderScratch& scratch, std::vector<uint8_t>& out);
+
+/**
+ * Decode a delta produced by EncodeFrameDelta against the same reference
+ *
+ * @param imageSize Size of the original image
+ * @param image Receives the image (must not alias reference)
+ * @return false if the data is malformed (image contents are then undefined)
+ */
+bool DecodeFrameDelta(const uint8_t* reference, size_t referenceSize, const uint8_t* data, size_t size,
+                      size_t imageSize, std::vector<uint8_t>& image);
+
+/**
+ * Server configuration
+ */
+struct MirrorServerConfig {
+    const char* bindAddress = "0.0.0.0";
+    uint16_t port = kDefaultMirrorPort;
+    int maxClients = 4;
+    size_t maxQueuedBytes = 512 * 1024;   // Per client; beyond this it skips to a keyframe
+};
+
+/**
+ * Server counters
+ */
+struct MirrorServerStats {
+    uint64_t framesPublished;   // Publish() calls that were serialized
+    uint64_t framesEncoded;     // Changed frames encoded and sent
+    uint64_t framesUnchanged;   // Identical to the previous frame: nothing sent
+    uint64_t framesCoalesced;   // Replaced by a newer frame before encoding
+    uint64_t keyframes;         // Keyframes sent (new or lagging clients)
+    uint64_t imageBytes;        // Uncompressed image bytes of encoded frames
+    uint64_t sentBytes;         // Bytes written to sockets, all clients
+    uint64_t encodeNs;          // Time spent in EncodeFrameDelta
+    int clients;
+};
+
+/**
+ * Streams frame deltas to connected viewers
+ *
+ * Publish() only serializes (a copy of the draw buffers) and hands the
+ * image to the server thread, which compares, encodes and writes with
+ * non-blocking sockets. If frames arrive faster than they are encoded only
+ * the newest is kept. A client that joins, or whose socket queue overflows,
+ * gets a keyframe once it has drained; nothing is ever blocked on a slow
+ * viewer. With no clients connected Publish() returns immediately.
+ *
+ * @code
+ *   static ui::mirror::MirrorServer mirror({ "0.0.0.0", 47100 });
+ *   mirror.Start();
+ *
+ *   // Render loop, after ImGui::Render():
+ *   mirror.Publish(ImGui::GetDrawData());
+ * @endcode
+ */
+class MirrorServer {
+public:
+    explicit MirrorServer(const MirrorServerConfig& config = MirrorServerConfig());
+    ~MirrorServer();
+
+    MirrorServer(const MirrorServer&) = delete;
+    MirrorServer& operator=(const MirrorServer&) = delete;
+
+    /**
+     * Bind the listening socket and launch the server thread
+     * @return false if the socket could not be bound
+     */
+    bool Start();
+
+    /**
+     * Close all connections and join the server thread (idempotent)
+     */
+    void Stop();
+
+    /**
+     * Queue the current frame for viewers (render thread)
+     * The font atlas is taken from ImGui::GetIO().Fonts.
+     */
+    void Publish(const ImDrawData* drawData);
+
+    /**
+     * Port actually bound (useful with port 0)
+     */
+    uint16_t GetPort() const { return port_; }
+
+    MirrorServerStats GetStats() const;
+
+private:
+    struct Client;
+
+    void ServerMain();
+    void AcceptClients();
+    void EncodeLatest();
+    void QueueFrames();
+    void FlushClient(Client& client);
+    const std::vector<uint8_t>& Keyframe();
+
+    MirrorServerConfig config_;
+    int listenFd_ = -1;
+    int wakeFd_ = -1;
+    uint16_t port_ = 0;
+    std::thread thread_;
+    bool running_ = false;
+    std::atomic<bool> stopRequested_{false};
+    std::atomic<int> clientCount_{0};
+
+    // Render thread -> server thread handoff (newest frame wins)
+    std::mutex pendingMutex_;
+    std::vector<uint8_t> pending_;
+    bool hasPending_ = false;
+    std::vector<uint8_t> publishImage_;     // Render thread only
+
+    // Server thread only
+    std::vector<std::unique_ptr<Client>> clients_;
+    std::vector<uint8_t> image_;            // Last encoded frame
+    std::vector<uint8_t> incoming_;
+    std::vector<uint8_t> delta_;            // image_ as a delta message
+    std::vector<uint8_t> keyframe_;         // image_ as a keyframe message (built on demand)
+    bool deltaReady_ = false;
+    bool keyframeReady_ = false;
+    uint32_t frameNumber_ = 0;
+    DeltaEncoderScratch scratch_;
+
+    std::atomic<uint64_t> framesPublished_{0};
+    std::atomic<uint64_t> framesEncoded_{0};
+    std::atomic<uint64_t> framesUnchanged_{0};
+    std::atomic<uint64_t> framesCoalesced_{0};
+    std::atomic<uint64_t> keyframes_{0};
+    std::atomic<uint64_t> imageBytes_{0};
+    std::atomic<uint64_t> sentBytes_{0};
+    std::atomic<uint64_t> encodeNs_{0};
+};
+
+/**
+ * Viewer counters
+ */
+struct MirrorClientStats {
+    uint64_t framesReceived;
+    uint64_t keyframes;
+    uint64_t receivedBytes;
+    uint64_t decodeNs;
+};
+
+/**
+ * Receives a mirrored dashboard and rebuilds its ImDrawData
+ *
+ * Single-threaded: call Poll() once per viewer frame and render
+ * GetDrawData() with the viewer's backend instead of its own
+ * ImGui::GetDrawData(). The viewer must build the same font atlas as the
+ * car (call ui::InitUI() with the same fonts) so glyph UVs match; the
+ * car's atlas texture is mapped to the viewer's automatically. Other
+ * textures (camera feeds, the cell heatmap) are drawn only if mapped with
+ * MapTexture(); commands using an unmapped texture are skipped.
+ *
+ * @code
+ *   ui::mirror::MirrorClient viewer;
+ *   viewer.Connect("192.168.1.20", 47100);
+ *
+ *   // Viewer loop (ImGui context with the dashboard fonts):
+ *   viewer.Poll();
+ *   if (ImDrawData* drawData = viewer.GetDrawData()) ImGui_ImplOpenGL3_RenderDrawData(drawData);
+ * @endcode
+ */
+class MirrorClient {
+public:
+    MirrorClient();
+    ~MirrorClient();
+
+    MirrorClient(const MirrorClient&) = delete;
+    MirrorClient& operator=(const MirrorClient&) = delete;
+
+    /**
+     * Connect to a server (blocking) and check its hello
+     * @return false if the connection failed or the draw vertex/index
+     *         layout differs from this build
+     */
+    bool Connect(const char* host, uint16_t port);
+
+    void Disconnect();
+    bool IsConnected() const { return fd_ >= 0; }
+
+    /**
+     * Read everything available and decode complete frames (non-blocking)
+     *
+     * @param timeoutMs Wait up to this long for data when none is queued
+     * @return true if a new frame was decoded; a protocol error disconnects
+     */
+    bool Poll(int timeoutMs = 0);
+
+    /**
+     * Latest frame as draw data (rebuilt after Poll() decoded a new frame)
+     * @return nullptr until the first frame arrives, or if the frame has an
+     *         index or vertex reference out of range
+     */
+    ImDrawData* GetDrawData();
+
+    /**
+     * Draw a texture of the car with a local one
+     */
+    void MapTexture(ImTextureID remote, ImTextureID local);
+
+    /**
+     * Latest frame image, as produced by SerializeDrawData on the car
+     */
+    const std::vector<uint8_t>& GetImage() const { return image_; }
+
+    /**
+     * True if the car's font atlas has the same size as the viewer's
+     */
+    bool AtlasMatches() const;
+
+    uint32_t GetFrameNumber() const { return frameNumber_; }
+    MirrorClientStats GetStats() const { return stats_; }
+
+private:
+    bool DecodeMessages();
+    void RebuildDrawData();
+    bool ResolveTexture(ImTextureID remote, ImTextureID& local) const;
+
+    int fd_ = -1;
+    std::vector<uint8_t> receive_;
+    size_t receiveStart_ = 0;
+    bool helloReceived_ = false;
+
+    std::vector<uint8_t> image_;
+    std::vector<uint8_t> decoded_;
+    uint32_t frameNumber_ = 0;
+    bool hasFrame_ = false;
+    bool drawDataStale_ = false;
+
+    ImDrawData drawData_;
+    std::vector<ImDrawList*> lists_;
+    std::vector<std::pair<ImTextureID, ImTextureID>> textureMap_;
+    MirrorClientStats stats_{};
+};
+
+} // namespace mirror
+} // namespace ui
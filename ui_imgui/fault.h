@@ -0,0 +1,42 @@
+#pragma once
+
+#include <string>
+#include <cstdint>
+
+namespace ui {
+
+// --- BEGIN GENERATED (schema/vehicle-state.json) ---
+
+/**
+ * Fault severity levels matching TSX implementation
+ */
+enum class FaultSeverity {
+    Info,
+    Warning,
+    Critical
+};
+
+/**
+ * Individual fault record
+ */
+struct Fault {
+    std::string code;
+    std::string message;
+    FaultSeverity severity;
+    int64_t timestamp;  // Unix timestamp in milliseconds
+};
+
+// --- END GENERATED ---
+
+/**
+ * Read-only view of one stored fault (history or journal row)
+ * Strings point into the owning store and stay valid until it changes.
+ */
+struct FaultRow {
+    int64_t timestamp;
+    const char* code;
+    const char* message;
+    FaultSeverity severity;
+};
+
+} // namespace ui
@@ -0,0 +1,108 @@
+#include "fault_aggregator.h"
+
+namespace ui {
+
+void FaultAggregator::Report(const Fault& fault) {
+    version_++;
+    auto it = ids_.find(fault.code);
+    if (it == ids_.end()) {
+        it = ids_.emplace(fault.code, static_cast<uint32_t>(entries_.size())).first;
+
+        Entry entry;
+        entry.code = fault.code;
+        entry.severity = fault.severity;
+        entry.firstSeen = fault.timestamp;
+        entry.lastSeen = fault.timestamp;
+        entry.count = 0;
+        entry.totalCount = 0;
+        entry.active = false;
+        entry.latched = false;
+        entries_.push_back(entry);
+        displayPos_.push_back(kNotDisplayed);
+    }
+
+    uint32_t id = it->second;
+    Entry& entry = entries_[id];
+
+    if (displayPos_[id] == kNotDisplayed) {
+        // New episode
+        entry.severity = fault.severity;
+        entry.firstSeen = fault.timestamp;
+        entry.count = 0;
+        Show(id);
+    } else if (fault.severity > entry.severity) {
+        displayedBySeverity_[static_cast<int>(entry.severity)]--;
+        displayedBySeverity_[static_cast<int>(fault.severity)]++;
+        entry.severity = fault.severity;
+    }
+
+    // Repeats usually carry the same text; skip the copy when they do
+    if (entry.message != fault.message) {
+        entry.message = fault.message;
+    }
+
+    entry.lastSeen = fault.timestamp;
+    entry.count++;
+    entry.totalCount++;
+    entry.active = true;
+    entry.latched = entry.latched || fault.severity == FaultSeverity::Critical;
+}
+
+void FaultAggregator::Resolve(const std::string& code) {
+    auto it = ids_.find(code);
+    if (it == ids_.end()) return;
+
+    Entry& entry = entries_[it->second];
+    if (entry.active || displayPos_[it->second] != kNotDisplayed) version_++;
+    entry.active = false;
+    if (!entry.latched && displayPos_[it->second] != kNotDisplayed) {
+        Hide(it->second);
+    }
+}
+
+void FaultAggregator::Acknowledge(const std::string& code) {
+    auto it = ids_.find(code);
+    if (it == ids_.end()) return;
+
+    Entry& entry = entries_[it->second];
+    if (entry.latched) version_++;
+    entry.latched = false;
+    if (!entry.active && displayPos_[it->second] != kNotDisplayed) {
+        Hide(it->second);
+    }
+}
+
+void FaultAggregator::Clear() {
+    if (!displayed_.empty()) version_++;
+    for (uint32_t id : displayed_) {
+        entries_[id].active = false;
+        entries_[id].latched = false;
+        displayPos_[id] = kNotDisplayed;
+    }
+    displayed_.clear();
+    for (auto& count : displayedBySeverity_) count = 0;
+}
+
+const FaultAggregator::Entry* FaultAggregator::Find(const std::string& code) const {
+    auto it = ids_.find(code);
+    return it == ids_.end() ? nullptr : &entries_[it->second];
+}
+
+void FaultAggregator::Show(uint32_t id) {
+    displayPos_[id] = static_cast<uint32_t>(displayed_.size());
+    displayed_.push_back(id);
+    displayedBySeverity_[static_cast<int>(entries_[id].severity)]++;
+}
+
+void FaultAggregator::Hide(uint32_t id) {
+    // Order-preserving erase; the displayed set is a handful of codes
+    uint32_t pos = displayPos_[id];
+    displayed_.erase(displayed_.begin() + pos);
+    for (size_t i = pos; i < displayed_.size(); i++) {
+        displayPos_[displayed_[i]] = static_cast<uint32_t>(i);
+    }
+    displayPos_[id] = kNotDisplayed;
+    displayedBySeverity_[static_cast<int>(entries_[id].severity)]--;
+}
+
+} // namespace ui
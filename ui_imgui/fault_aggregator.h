@@ -0,0 +1,100 @@
+#pragma once
+
+#include "fault.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace ui {
+
+/**
+ * Active fault set, deduplicated by fault code
+ *
+ * Each distinct code has one entry holding first/last seen times, an
+ * occurrence count and its active/latched state, so a flapping fault
+ * updates a counter instead of pushing other faults out. Report is O(1)
+ * (one hash lookup, no allocation for repeats); removing a fault from the
+ * displayed set is linear in the handful of displayed codes.
+ *
+ * Critical faults latch: once reported they stay displayed after the
+ * source resolves them, until acknowledged or cleared.
+ */
+class FaultAggregator {
+public:
+    struct Entry {
+        std::string code;
+        std::string message;       // Most recent message
+        FaultSeverity severity;    // Highest severity since displayed
+        int64_t firstSeen;         // Unix ms, start of the current episode
+        int64_t lastSeen;          // Unix ms, most recent occurrence
+        uint32_t count;            // Occurrences since displayed
+        uint64_t totalCount;       // Occurrences since process start
+        bool active;               // Currently asserted by its source
+        bool latched;              // Held for acknowledgement
+    };
+
+    /**
+     * Record one occurrence of a fault (O(1))
+     */
+    void Report(const Fault& fault);
+
+    /**
+     * Source no longer asserts the fault; drops it unless latched
+     */
+    void Resolve(const std::string& code);
+
+    /**
+     * Release the latch on a fault; drops it unless still active
+     */
+    void Acknowledge(const std::string& code);
+
+    /**
+     * Dismiss every displayed fault (the panel's clear action)
+     * Lifetime counts are kept.
+     */
+    void Clear();
+
+    /**
+     * Displayed faults (active or latched), in order of appearance
+     */
+    size_t Size() const { return displayed_.size(); }
+    bool Empty() const { return displayed_.empty(); }
+    const Entry& At(size_t n) const { return entries_[displayed_[n]]; }
+
+    /**
+     * Number of displayed faults per severity (O(1))
+     */
+    size_t CountBySeverity(FaultSeverity severity) const {
+        return displayedBySeverity_[static_cast<int>(severity)];
+    }
+
+    /**
+     * Lookup by code (displayed or not); nullptr if never reported
+     */
+    const Entry* Find(const std::string& code) const;
+
+    /**
+     * Incremented by every Report/Resolve/Acknowledge/Clear that changes
+     * an entry, so observers can skip copying an unchanged fault list
+     */
+    uint64_t Version() const { return version_; }
+
+private:
+    static constexpr uint32_t kNotDisplayed = UINT32_MAX;
+
+    void Show(uint32_t id);
+    void Hide(uint32_t id);
+
+    // Entries are never removed, so ids stay stable
+    std::vector<Entry> entries_;
+    std::vector<uint32_t> displayPos_;
+    std::unordered_map<std::string, uint32_t> ids_;
+
+    std::vector<uint32_t> displayed_;
+    size_t displayedBySeverity_[3] = {};
+    uint64_t version_ = 0;
+};
+
+} // namespace ui
@@ -0,0 +1,116 @@
+#include "fault_history.h"
+#include <algorithm>
+#include <iterator>
+
+namespace ui {
+
+static uint8_t SeverityBit(FaultSeverity severity) {
+    return static_cast<uint8_t>(1u << static_cast<unsigned>(severity));
+}
+
+void FaultHistory::Append(const Fault& fault) {
+    auto code = codeIds_.find(fault.code);
+    if (code == codeIds_.end()) {
+        code = codeIds_.emplace(fault.code, static_cast<uint32_t>(codes_.size())).first;
+        codes_.push_back(fault.code);
+        byCode_.emplace_back();
+    }
+
+    auto message = messageIds_.find(fault.message);
+    if (message == messageIds_.end()) {
+        message = messageIds_.emplace(fault.message, static_cast<uint32_t>(messages_.size())).first;
+        messages_.push_back(fault.message);
+    }
+
+    Record record;
+    record.timestamp = fault.timestamp;
+    record.messageId = message->second;
+    record.codeId = code->second;
+    record.severity = fault.severity;
+
+    uint32_t index = static_cast<uint32_t>(records_.size());
+    records_.push_back(record);
+    bySeverity_[static_cast<int>(fault.severity)].push_back(index);
+    byCode_[record.codeId].push_back(index);
+
+    if (Matches(record)) {
+        filtered_.push_back(index);
+    }
+}
+
+void FaultHistory::Clear() {
+    records_.clear();
+    codes_.clear();
+    messages_.clear();
+    codeIds_.clear();
+    messageIds_.clear();
+    for (auto& list : bySeverity_) list.clear();
+    byCode_.clear();
+    codeFilter_ = kAnyCode;
+    filtered_.clear();
+}
+
+size_t FaultHistory::CountBySeverity(FaultSeverity severity) const {
+    return bySeverity_[static_cast<int>(severity)].size();
+}
+
+void FaultHistory::SetFilter(uint8_t severityMask, int codeId) {
+    severityMask &= kAllSeverities;
+    if (codeId < 0 || codeId >= static_cast<int>(codes_.size())) codeId = kAnyCode;
+    if (severityMask == severityMask_ && codeId == codeFilter_) return;
+
+    severityMask_ = severityMask;
+    codeFilter_ = codeId;
+    RebuildFiltered();
+}
+
+FaultRow FaultHistory::FilteredRow(size_t n) const {
+    const Record& record = records_[filtered_[n]];
+    return { record.timestamp, CodeString(record.codeId), MessageString(record.messageId), record.severity };
+}
+
+bool FaultHistory::Matches(const Record& record) const {
+    if (!(severityMask_ & SeverityBit(record.severity))) return false;
+    return codeFilter_ == kAnyCode || record.codeId == static_cast<uint32_t>(codeFilter_);
+}
+
+void FaultHistory::RebuildFiltered() {
+    filtered_.clear();
+
+    // Code filter: walk that code's posting list, testing severity
+    if (codeFilter_ != kAnyCode) {
+        for (uint32_t index : byCode_[codeFilter_]) {
+            if (severityMask_ & SeverityBit(records_[index].severity)) {
+                filtered_.push_back(index);
+            }
+        }
+        return;
+    }
+
+    if (severityMask_ == kAllSeverities) {
+        filtered_.resize(records_.size());
+        for (uint32_t i = 0; i < static_cast<uint32_t>(filtered_.size()); i++) filtered_[i] = i;
+        return;
+    }
+
+    // Severity filter: merge the selected (already sorted) severity lists
+    const std::vector<uint32_t>* lists[3];
+    int listCount = 0;
+    size_t total = 0;
+    for (int s = 0; s < 3; s++) {
+        if (severityMask_ & (1u << s)) {
+            lists[listCount++] = &bySeverity_[s];
+            total += bySeverity_[s].size();
+        }
+    }
+
+    filtered_.reserve(total);
+    if (listCount == 1) {
+        filtered_ = *lists[0];
+    } else if (listCount == 2) {
+        std::merge(lists[0]->begin(), lists[0]->end(), lists[1]->begin(), lists[1]->end(),
+                   std::back_inserter(filtered_));
+    }
+}
+
+} // namespace ui
@@ -0,0 +1,104 @@
+#pragma once
+
+#include "fault.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace ui {
+
+/**
+ * Session-long fault history with precomputed filter indices
+ *
+ * Fault codes and messages are interned, so a record is 24 bytes and
+ * appending is amortized O(1). Each record is also appended to a
+ * per-severity and a per-code index. The filtered row list used by the
+ * history view is rebuilt from those indices only when the filter changes
+ * and is extended incrementally on Append, so rendering never scans the
+ * full history.
+ */
+class FaultHistory {
+public:
+    static constexpr uint8_t kAllSeverities = 0x7;
+    static constexpr int kAnyCode = -1;
+
+    struct Record {
+        int64_t timestamp;   // Unix timestamp in milliseconds
+        uint32_t messageId;
+        uint32_t codeId;
+        FaultSeverity severity;
+    };
+
+    /**
+     * Append a fault to the history
+     */
+    void Append(const Fault& fault);
+
+    /**
+     * Drop all records and interned strings
+     */
+    void Clear();
+
+    size_t Size() const { return records_.size(); }
+    bool Empty() const { return records_.empty(); }
+    const Record& At(size_t index) const { return records_[index]; }
+
+    /**
+     * Interned strings
+     */
+    size_t CodeCount() const { return codes_.size(); }
+    const char* CodeString(uint32_t codeId) const { return codes_[codeId].c_str(); }
+    const char* MessageString(uint32_t messageId) const { return messages_[messageId].c_str(); }
+
+    /**
+     * Number of records with the given severity / code (O(1))
+     */
+    size_t CountBySeverity(FaultSeverity severity) const;
+    size_t CountByCode(uint32_t codeId) const { return byCode_[codeId].size(); }
+
+    /**
+     * Set the active filter
+     *
+     * @param severityMask Bit (1 << severity) per severity to include
+     * @param codeId Interned code id, or kAnyCode
+     */
+    void SetFilter(uint8_t severityMask, int codeId);
+    uint8_t GetSeverityMask() const { return severityMask_; }
+    int GetCodeFilter() const { return codeFilter_; }
+
+    /**
+     * Record indices matching the active filter, oldest first
+     */
+    const std::vector<uint32_t>& FilteredRows() const { return filtered_; }
+    size_t FilteredCount() const { return filtered_.size(); }
+
+    /**
+     * Row n of the filtered view (0 = oldest)
+     */
+    FaultRow FilteredRow(size_t n) const;
+
+private:
+    bool Matches(const Record& record) const;
+    void RebuildFiltered();
+
+    std::vector<Record> records_;
+
+    // Interning
+    std::vector<std::string> codes_;
+    std::vector<std::string> messages_;
+    std::unordered_map<std::string, uint32_t> codeIds_;
+    std::unordered_map<std::string, uint32_t> messageIds_;
+
+    // Precomputed indices (record indices, ascending)
+    std::vector<uint32_t> bySeverity_[3];
+    std::vector<std::vector<uint32_t>> byCode_;
+
+    // Active filter and its materialized result
+    uint8_t severityMask_ = kAllSeverities;
+    int codeFilter_ = kAnyCode;
+    std::vector<uint32_t> filtered_;
+};
+
+} // namespace ui
@@ -0,0 +1,549 @@
+#include "fault_journal.h"
+#include "crc32.h"
+#include "monotonic_clock.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <iterator>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace ui {
+
+static const char kJournalMagic[8] = { 'F', 'L', 'T', 'J', 'R', 'N', 'L', '1' };
+static const char kCheckpointMagic[8] = { 'F', 'L', 'T', 'J', 'I', 'D', 'X', '1' };
+
+/**
+ * Index checkpoint header (host byte order), followed by the time blocks,
+ * the code names, one u32 posting count per code and per severity, and the
+ * posting lists themselves in that order
+ */
+struct CheckpointHeader {
+    char magic[8];
+    uint64_t recordCount;
+    uint32_t firstRecordCrc;  // ties the checkpoint to this journal's contents
+    uint32_t lastRecordCrc;
+    uint32_t codeCount;
+    uint32_t crc;             // CRC-32 of the preceding 28 bytes
+};
+static_assert(sizeof(CheckpointHeader) == 32, "checkpoint header layout changed");
+
+// Map in large steps so appends rarely need a remap. Mapping past EOF is
+// fine as long as nothing reads beyond the records we know are written.
+static constexpr size_t kMapGranularity = 64ull * 1024 * 1024;
+
+static uint64_t PackCode(const char* code) {
+    uint64_t key = 0;
+    for (int i = 0; i < 7 && code[i]; i++) {
+        key |= static_cast<uint64_t>(static_cast<uint8_t>(code[i])) << (i * 8);
+    }
+    return key;
+}
+
+static uint8_t SeverityBit(uint8_t severity) {
+    return static_cast<uint8_t>(1u << severity);
+}
+
+static bool WriteAll(int fd, const void* data, size_t size) {
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    while (size > 0) {
+        ssize_t written = write(fd, bytes, size);
+        if (written < 0) return false;
+        bytes += written;
+        size -= static_cast<size_t>(written);
+    }
+    return true;
+}
+
+static bool ReadFile(const char* path, std::vector<uint8_t>& out) {
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return false;
+
+    struct stat st;
+    bool ok = fstat(fd, &st) == 0;
+    if (ok) {
+        out.resize(static_cast<size_t>(st.st_size));
+        size_t done = 0;
+        while (done < out.size()) {
+            ssize_t n = read(fd, out.data() + done, out.size() - done);
+            if (n <= 0) {
+                ok = false;
+                break;
+            }
+            done += static_cast<size_t>(n);
+        }
+    }
+    close(fd);
+    return ok;
+}
+
+template <typename T>
+static void PutArray(std::vector<uint8_t>& out, const T* data, size_t count) {
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(data);
+    out.insert(out.end(), bytes, bytes + count * sizeof(T));
+}
+
+// Posting lists must be strictly ascending and inside the journal, or a
+// damaged checkpoint could send RecordAt past the records we validated
+static bool ValidPostings(const uint32_t* postings, size_t count, size_t recordCount) {
+    uint32_t previous = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (postings[i] >= recordCount || (i > 0 && postings[i] <= previous)) return false;
+        previous = postings[i];
+    }
+    return true;
+}
+
+FaultJournal::~FaultJournal() {
+    Close();
+}
+
+bool FaultJournal::Open(const char* path, const Options& options) {
+    Close();
+    options_ = options;
+
+    fd_ = open(path, O_RDWR | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+    if (fd_ < 0) return false;
+
+    struct stat st;
+    if (fstat(fd_, &st) != 0) {
+        Close();
+        return false;
+    }
+
+    size_t fileSize = static_cast<size_t>(st.st_size);
+    if (fileSize < kHeaderSize) {
+        // New (or header-less) file: write a fresh header
+        uint8_t header[kHeaderSize] = {};
+        memcpy(header, kJournalMagic, sizeof(kJournalMagic));
+        uint32_t recordSize = sizeof(FaultJournalRecord);
+        memcpy(header + 8, &recordSize, sizeof(recordSize));
+        if (ftruncate(fd_, 0) != 0 || !WriteAll(fd_, header, sizeof(header)) || fdatasync(fd_) != 0) {
+            Close();
+            return false;
+        }
+        fileSize = kHeaderSize;
+    }
+
+    if (!MapAtLeast(fileSize)) {
+        Close();
+        return false;
+    }
+
+    uint32_t recordSize = 0;
+    memcpy(&recordSize, map_ + 8, sizeof(recordSize));
+    if (memcmp(map_, kJournalMagic, sizeof(kJournalMagic)) != 0 || recordSize != sizeof(FaultJournalRecord)) {
+        Close();
+        return false;
+    }
+
+    // Validate and index every record after the checkpoint; the first bad
+    // CRC marks a torn tail
+    size_t available = (fileSize - kHeaderSize) / sizeof(FaultJournalRecord);
+    indexPath_ = std::string(path) + ".idx";
+    size_t valid = LoadCheckpoint(available);
+    count_ = valid;
+    for (; valid < available; valid++) {
+        const FaultJournalRecord* record = reinterpret_cast<const FaultJournalRecord*>(
+            map_ + kHeaderSize + valid * sizeof(FaultJournalRecord));
+        if (Crc32(record, offsetof(FaultJournalRecord, crc)) != record->crc || record->severity > 2) {
+            break;
+        }
+        IndexRecord(static_cast<uint32_t>(valid), *record);
+        count_ = valid + 1;
+    }
+
+    size_t validSize = kHeaderSize + valid * sizeof(FaultJournalRecord);
+    if (validSize != fileSize) {
+        if (ftruncate(fd_, static_cast<off_t>(validSize)) != 0) {
+            Close();
+            return false;
+        }
+        fdatasync(fd_);
+    }
+
+    RebuildFiltered();
+    return true;
+}
+
+void FaultJournal::Close() {
+    if (fd_ >= 0) {
+        Sync();
+        if (count_ != checkpointCount_) Checkpoint();
+        close(fd_);
+        fd_ = -1;
+    }
+    if (map_) {
+        munmap(const_cast<uint8_t*>(map_), mapLength_);
+        map_ = nullptr;
+        mapLength_ = 0;
+    }
+
+    unsynced_ = 0;
+    ClearIndices();
+    indexPath_.clear();
+    codeFilter_ = kAnyCode;
+    viewMode_ = ViewMode::All;
+    filtered_.clear();
+}
+
+void FaultJournal::ClearIndices() {
+    count_ = 0;
+    checkpointCount_ = 0;
+    timeBlocks_.clear();
+    codeKeys_.clear();
+    codeNames_.clear();
+    byCode_.clear();
+    for (auto& list : bySeverity_) list.clear();
+}
+
+size_t FaultJournal::LoadCheckpoint(size_t available) {
+    std::vector<uint8_t> file;
+    if (!ReadFile(indexPath_.c_str(), file) || file.size() < sizeof(CheckpointHeader)) return 0;
+
+    CheckpointHeader header;
+    memcpy(&header, file.data(), sizeof(header));
+    if (memcmp(header.magic, kCheckpointMagic, sizeof(kCheckpointMagic)) != 0 ||
+        Crc32(&header, offsetof(CheckpointHeader, crc)) != header.crc) {
+        return 0;
+    }
+
+    // The checkpoint must describe a prefix of this journal: a truncated or
+    // replaced journal invalidates it. Only these two records are read here.
+    size_t records = static_cast<size_t>(header.recordCount);
+    if (records == 0 || records > available || header.codeCount > records) return 0;   // Every code has a record
+    const FaultJournalRecord* first = reinterpret_cast<const FaultJournalRecord*>(map_ + kHeaderSize);
+    const FaultJournalRecord* last = first + (records - 1);
+    if (first->crc != header.firstRecordCrc || last->crc != header.lastRecordCrc ||
+        Crc32(last, offsetof(FaultJournalRecord, crc)) != last->crc) {
+        return 0;
+    }
+
+    size_t blocks = (records + kTimeBlockRecords - 1) / kTimeBlockRecords;
+    size_t lists = header.codeCount + 3;
+    size_t fixedSize = sizeof(header) + blocks * sizeof(TimeBlock) + header.codeCount * sizeof(CodeName) +
+                       lists * sizeof(uint32_t);
+    if (file.size() < fixedSize) return 0;
+
+    const uint8_t* p = file.data() + sizeof(header);
+    timeBlocks_.resize(blocks);
+    memcpy(timeBlocks_.data(), p, blocks * sizeof(TimeBlock));
+    p += blocks * sizeof(TimeBlock);
+    codeNames_.resize(header.codeCount);
+    memcpy(codeNames_.data(), p, header.codeCount * sizeof(CodeName));
+    p += header.codeCount * sizeof(CodeName);
+    std::vector<uint32_t> sizes(lists);
+    memcpy(sizes.data(), p, lists * sizeof(uint32_t));
+    p += lists * sizeof(uint32_t);
+
+    // Every record sits in exactly one code list and one severity list
+    uint64_t codeTotal = 0;
+    uint64_t severityTotal = 0;
+    for (size_t i = 0; i < lists; i++) {
+        if (i < header.codeCount) {
+            codeTotal += sizes[i];
+        } else {
+            severityTotal += sizes[i];
+        }
+    }
+    if (codeTotal != records || severityTotal != records ||
+        file.size() != fixedSize + 2 * records * sizeof(uint32_t)) {
+        ClearIndices();
+        return 0;
+    }
+
+    byCode_.resize(header.codeCount);
+    for (size_t i = 0; i < lists; i++) {
+        std::vector<uint32_t>& list = i < header.codeCount ? byCode_[i] : bySeverity_[i - header.codeCount];
+        list.resize(sizes[i]);
+        memcpy(list.data(), p, sizes[i] * sizeof(uint32_t));
+        p += sizes[i] * sizeof(uint32_t);
+        if (!ValidPostings(list.data(), list.size(), records)) {
+            ClearIndices();
+            return 0;
+        }
+    }
+
+    for (size_t i = 0; i < codeNames_.size(); i++) {
+        codeNames_[i].name[sizeof(codeNames_[i].name) - 1] = '\0';
+        if (!codeKeys_.emplace(PackCode(codeNames_[i].name), static_cast<uint32_t>(i)).second) {
+            ClearIndices();
+            return 0;
+        }
+    }
+
+    checkpointCount_ = records;
+    return records;
+}
+
+bool FaultJournal::Checkpoint() {
+    if (fd_ < 0 || count_ == 0) return true;
+
+    CheckpointHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, kCheckpointMagic, sizeof(kCheckpointMagic));
+    header.recordCount = count_;
+    header.firstRecordCrc = RecordAt(0)->crc;
+    header.lastRecordCrc = RecordAt(count_ - 1)->crc;
+    header.codeCount = static_cast<uint32_t>(codeNames_.size());
+    header.crc = Crc32(&header, offsetof(CheckpointHeader, crc));
+
+    std::vector<uint8_t> out;
+    out.reserve(sizeof(header) + timeBlocks_.size() * sizeof(TimeBlock) + codeNames_.size() * 12 +
+                2 * count_ * sizeof(uint32_t) + 12);
+    PutArray(out, &header, 1);
+    PutArray(out, timeBlocks_.data(), timeBlocks_.size());
+    PutArray(out, codeNames_.data(), codeNames_.size());
+    for (const auto& list : byCode_) {
+        uint32_t size = static_cast<uint32_t>(list.size());
+        PutArray(out, &size, 1);
+    }
+    for (const auto& list : bySeverity_) {
+        uint32_t size = static_cast<uint32_t>(list.size());
+        PutArray(out, &size, 1);
+    }
+    for (const auto& list : byCode_) PutArray(out, list.data(), list.size());
+    for (const auto& list : bySeverity_) PutArray(out, list.data(), list.size());
+
+    // The checkpoint may describe records not yet fdatasynced; after a power
+    // loss the journal is then shorter than the checkpoint and Open rescans
+    std::string tmpPath = indexPath_ + ".tmp";
+    int fd = open(tmpPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) return false;
+    bool ok = WriteAll(fd, out.data(), out.size()) && fdatasync(fd) == 0;
+    close(fd);
+    if (!ok || rename(tmpPath.c_str(), indexPath_.c_str()) != 0) {
+        unlink(tmpPath.c_str());
+        return false;
+    }
+
+    checkpointCount_ = count_;
+    return true;
+}
+
+bool FaultJournal::MapAtLeast(size_t bytes) {
+    if (map_ && bytes <= mapLength_) return true;
+
+    size_t length = ((bytes * 2 + kMapGranularity - 1) / kMapGranularity) * kMapGranularity;
+    void* mapping = mmap(nullptr, length, PROT_READ, MAP_SHARED, fd_, 0);
+    if (mapping == MAP_FAILED) return false;
+
+    if (map_) munmap(const_cast<uint8_t*>(map_), mapLength_);
+    map_ = static_cast<const uint8_t*>(mapping);
+    mapLength_ = length;
+    return true;
+}
+
+bool FaultJournal::Append(const Fault& fault) {
+    if (fd_ < 0) return false;
+
+    FaultJournalRecord record;
+    memset(&record, 0, sizeof(record));
+    record.timestamp = fault.timestamp;
+    strncpy(record.code, fault.code.c_str(), sizeof(record.code) - 1);
+    strncpy(record.message, fault.message.c_str(), sizeof(record.message) - 1);
+    record.severity = static_cast<uint8_t>(fault.severity);
+    record.crc = Crc32(&record, offsetof(FaultJournalRecord, crc));
+
+    size_t newSize = kHeaderSize + (count_ + 1) * sizeof(FaultJournalRecord);
+    if (!MapAtLeast(newSize) || !WriteAll(fd_, &record, sizeof(record))) {
+        return false;
+    }
+
+    uint32_t index = static_cast<uint32_t>(count_);
+    IndexRecord(index, record);
+    count_++;
+
+    if (viewMode_ == ViewMode::Materialized && Matches(record)) {
+        filtered_.push_back(index);
+    }
+
+    if (unsynced_++ == 0) firstUnsyncedNs_ = MonotonicNowNs();
+    if (unsynced_ >= options_.syncEveryRecords) {
+        return Sync();
+    }
+    return true;
+}
+
+bool FaultJournal::Sync() {
+    if (fd_ < 0 || unsynced_ == 0) return true;
+    if (fdatasync(fd_) != 0) return false;          // Records stay pending; the next Sync()/Poll() retries
+    unsynced_ = 0;
+    firstUnsyncedNs_ = 0;
+
+    if (options_.checkpointEveryRecords > 0 && count_ - checkpointCount_ >= options_.checkpointEveryRecords) {
+        Checkpoint();
+    }
+    return true;
+}
+
+void FaultJournal::Poll() {
+    if (unsynced_ == 0) return;
+    uint64_t elapsedNs = MonotonicNowNs() - firstUnsyncedNs_;
+    if (elapsedNs >= static_cast<uint64_t>(options_.syncIntervalMs) * 1000000ull) {
+        Sync();
+    }
+}
+
+void FaultJournal::IndexRecord(uint32_t index, const FaultJournalRecord& record) {
+    size_t block = index / kTimeBlockRecords;
+    if (block >= timeBlocks_.size()) {
+        timeBlocks_.push_back({ record.timestamp, record.timestamp });
+    } else {
+        TimeBlock& tb = timeBlocks_[block];
+        tb.minTimestamp = std::min(tb.minTimestamp, record.timestamp);
+        tb.maxTimestamp = std::max(tb.maxTimestamp, record.timestamp);
+    }
+
+    uint64_t key = PackCode(record.code);
+    auto it = codeKeys_.find(key);
+    if (it == codeKeys_.end()) {
+        it = codeKeys_.emplace(key, static_cast<uint32_t>(codeNames_.size())).first;
+        CodeName name;
+        memcpy(name.name, record.code, sizeof(name.name));
+        name.name[sizeof(name.name) - 1] = '\0';
+        codeNames_.push_back(name);
+        byCode_.emplace_back();
+    }
+    byCode_[it->second].push_back(index);
+    bySeverity_[record.severity].push_back(index);
+}
+
+const FaultJournalRecord* FaultJournal::RecordAt(size_t index) const {
+    if (index >= count_) return nullptr;
+    return reinterpret_cast<const FaultJournalRecord*>(map_ + kHeaderSize + index * sizeof(FaultJournalRecord));
+}
+
+FaultRow FaultJournal::RowAt(size_t index) const {
+    const FaultJournalRecord* record = RecordAt(index);
+    return { record->timestamp, record->code, record->message, static_cast<FaultSeverity>(record->severity) };
+}
+
+size_t FaultJournal::CountBySeverity(FaultSeverity severity) const {
+    return bySeverity_[static_cast<int>(severity)].size();
+}
+
+size_t FaultJournal::QueryTimeRange(int64_t from, int64_t to, std::vector<uint32_t>& out) const {
+    size_t before = out.size();
+    for (size_t b = 0; b < timeBlocks_.size(); b++) {
+        if (timeBlocks_[b].maxTimestamp < from || timeBlocks_[b].minTimestamp > to) continue;
+
+        size_t end = std::min(count_, (b + 1) * kTimeBlockRecords);
+        for (size_t i = b * kTimeBlockRecords; i < end; i++) {
+            int64_t ts = RecordAt(i)->timestamp;
+            if (ts >= from && ts <= to) out.push_back(static_cast<uint32_t>(i));
+        }
+    }
+    return out.size() - before;
+}
+
+int FaultJournal::FindCode(const char* code) const {
+    auto it = codeKeys_.find(PackCode(code));
+    return it == codeKeys_.end() ? kAnyCode : static_cast<int>(it->second);
+}
+
+size_t FaultJournal::QueryCode(const char* code, int64_t from, int64_t to, std::vector<uint32_t>& out) const {
+    int codeId = FindCode(code);
+    if (codeId == kAnyCode) return 0;
+
+    const std::vector<uint32_t>& postings = byCode_[codeId];
+    size_t before = out.size();
+
+    // Walk runs of time blocks overlapping the window; within a run, jump
+    // into the posting list with a binary search on record index
+    size_t b = 0;
+    while (b < timeBlocks_.size()) {
+        if (timeBlocks_[b].maxTimestamp < from || timeBlocks_[b].minTimestamp > to) {
+            b++;
+            continue;
+        }
+        size_t runStart = b;
+        while (b < timeBlocks_.size() && timeBlocks_[b].maxTimestamp >= from && timeBlocks_[b].minTimestamp <= to) {
+            b++;
+        }
+
+        uint32_t first = static_cast<uint32_t>(runStart * kTimeBlockRecords);
+        uint32_t last = static_cast<uint32_t>(std::min(count_, b * kTimeBlockRecords));
+        for (auto it = std::lower_bound(postings.begin(), postings.end(), first);
+             it != postings.end() && *it < last; ++it) {
+            int64_t ts = RecordAt(*it)->timestamp;
+            if (ts >= from && ts <= to) out.push_back(*it);
+        }
+    }
+    return out.size() - before;
+}
+
+void FaultJournal::SetFilter(uint8_t severityMask, int codeId) {
+    severityMask &= kAllSeverities;
+    if (codeId < 0 || codeId >= static_cast<int>(codeNames_.size())) codeId = kAnyCode;
+    if (severityMask == severityMask_ && codeId == codeFilter_) return;
+
+    severityMask_ = severityMask;
+    codeFilter_ = codeId;
+    RebuildFiltered();
+}
+
+bool FaultJournal::Matches(const FaultJournalRecord& record) const {
+    if (!(severityMask_ & SeverityBit(record.severity))) return false;
+    return codeFilter_ == kAnyCode || FindCode(record.code) == codeFilter_;
+}
+
+void FaultJournal::RebuildFiltered() {
+    filtered_.clear();
+
+    int severityCount = 0;
+    for (int s = 0; s < 3; s++) {
+        if (severityMask_ & (1u << s)) {
+            severityCount++;
+            viewSeverity_ = s;
+        }
+    }
+
+    if (codeFilter_ == kAnyCode && severityMask_ == kAllSeverities) {
+        viewMode_ = ViewMode::All;
+    } else if (codeFilter_ != kAnyCode && severityMask_ == kAllSeverities) {
+        viewMode_ = ViewMode::Code;
+    } else if (codeFilter_ == kAnyCode && severityCount == 1) {
+        viewMode_ = ViewMode::Severity;
+    } else {
+        viewMode_ = ViewMode::Materialized;
+        if (codeFilter_ != kAnyCode) {
+            for (uint32_t index : byCode_[codeFilter_]) {
+                if (severityMask_ & SeverityBit(RecordAt(index)->severity)) filtered_.push_back(index);
+            }
+        } else if (severityCount == 2) {
+            const std::vector<uint32_t>* lists[2];
+            int n = 0;
+            for (int s = 0; s < 3; s++) {
+                if (severityMask_ & (1u << s)) lists[n++] = &bySeverity_[s];
+            }
+            std::merge(lists[0]->begin(), lists[0]->end(), lists[1]->begin(), lists[1]->end(),
+                       std::back_inserter(filtered_));
+        }
+    }
+}
+
+size_t FaultJournal::FilteredCount() const {
+    switch (viewMode_) {
+        case ViewMode::All:          return count_;
+        case ViewMode::Code:         return byCode_[codeFilter_].size();
+        case ViewMode::Severity:     return bySeverity_[viewSeverity_].size();
+        case ViewMode::Materialized:
+        default:                     return filtered_.size();
+    }
+}
+
+FaultRow FaultJournal::FilteredRow(size_t n) const {
+    switch (viewMode_) {
+        case ViewMode::All:          return RowAt(n);
+        case ViewMode::Code:         return RowAt(byCode_[codeFilter_][n]);
+        case ViewMode::Severity:     return RowAt(bySeverity_[viewSeverity_][n]);
+        case ViewMode::Materialized:
+        default:                     return RowAt(filtered_[n]);
+    }
+}
+
+} // namespace ui
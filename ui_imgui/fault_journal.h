@@ -0,0 +1,200 @@
+#pragma once
+
+#include "fault.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace ui {
+
+/**
+ * On-disk fault record (64 bytes, host byte order)
+ */
+struct FaultJournalRecord {
+    int64_t timestamp;     // Unix timestamp in milliseconds
+    char code[8];          // NUL-terminated, truncated to 7 chars
+    char message[40];      // NUL-terminated, truncated to 39 chars
+    uint8_t severity;      // FaultSeverity
+    uint8_t reserved[3];
+    uint32_t crc;          // CRC-32 of the preceding 60 bytes
+};
+static_assert(sizeof(FaultJournalRecord) == 64, "journal record layout changed");
+
+/**
+ * Persistent append-only fault journal (POSIX)
+ *
+ * Records are appended with write(2) so they survive a process crash as
+ * soon as Append returns; fdatasync is batched (every N records or every
+ * T ms via Poll) for power-loss safety. Each record carries a CRC, so a
+ * torn tail from a crash is detected and truncated on Open.
+ *
+ * Reads go through a read-only shared mapping of the file: RecordAt()
+ * returns a pointer into it, so the OS pages history in lazily as the UI
+ * scrolls and nothing is ever loaded wholesale.
+ *
+ * Indices (maintained on Append):
+ * - sparse time index: min/max timestamp per 4096-record block
+ * - posting list per fault code and per severity (record indices, ascending)
+ *
+ * The indices are checkpointed to "<path>.idx" on Close and every
+ * checkpointEveryRecords appends (written to a temp file and renamed). Open
+ * loads the checkpoint and CRC-checks only the records appended after it, so
+ * reopening a large journal does not touch its old records at all; without
+ * a usable checkpoint (missing, stale or for another file) Open falls back
+ * to scanning the whole journal.
+ *
+ * A query like "all E004 in the last 30 days" touches only the code's
+ * posting list within the blocks overlapping the time window.
+ */
+class FaultJournal {
+public:
+    struct Options {
+        size_t syncEveryRecords = 64;  // fdatasync after this many unsynced appends
+        int syncIntervalMs = 1000;     // ... or this long after the first unsynced append
+        size_t checkpointEveryRecords = 262144;  // re-checkpoint the indices on Sync after this many (0: Close only)
+    };
+
+    static constexpr uint8_t kAllSeverities = 0x7;
+    static constexpr int kAnyCode = -1;
+
+    FaultJournal() = default;
+    ~FaultJournal();
+
+    FaultJournal(const FaultJournal&) = delete;
+    FaultJournal& operator=(const FaultJournal&) = delete;
+
+    /**
+     * Open or create a journal file
+     * @return false if the file cannot be opened/mapped or has a foreign header
+     */
+    bool Open(const char* path, const Options& options);
+    bool Open(const char* path) { return Open(path, Options()); }
+
+    /**
+     * Sync and close (idempotent)
+     */
+    void Close();
+
+    bool IsOpen() const { return fd_ >= 0; }
+
+    /**
+     * Append a fault
+     * @return false on I/O error
+     */
+    bool Append(const Fault& fault);
+
+    /**
+     * fdatasync any unsynced records
+     * @return false on I/O error; the records stay unsynced and are retried
+     */
+    bool Sync();
+
+    /**
+     * Time-based sync batching; call once per frame
+     */
+    void Poll();
+
+    /**
+     * Write the index checkpoint now (Close does this automatically)
+     * @return false on I/O error; the journal itself is unaffected
+     */
+    bool Checkpoint();
+
+    /**
+     * Records covered by the checkpoint loaded or written last; records
+     * after it were validated (or will be) by scanning on Open
+     */
+    size_t CheckpointedRecords() const { return checkpointCount_; }
+
+    size_t Size() const { return count_; }
+
+    /**
+     * Zero-copy access to a record (pointer into the file mapping)
+     * Valid until the next Append or Close.
+     */
+    const FaultJournalRecord* RecordAt(size_t index) const;
+    FaultRow RowAt(size_t index) const;
+
+    /**
+     * Record indices with from <= timestamp <= to, ascending
+     * @return Number of indices appended to out
+     */
+    size_t QueryTimeRange(int64_t from, int64_t to, std::vector<uint32_t>& out) const;
+
+    /**
+     * Record indices for one fault code with from <= timestamp <= to, ascending
+     * @return Number of indices appended to out
+     */
+    size_t QueryCode(const char* code, int64_t from, int64_t to, std::vector<uint32_t>& out) const;
+
+    /**
+     * Distinct codes seen in the journal
+     */
+    size_t CodeCount() const { return codeKeys_.size(); }
+    const char* CodeString(uint32_t codeId) const { return codeNames_[codeId].name; }
+    size_t CountByCode(uint32_t codeId) const { return byCode_[codeId].size(); }
+    size_t CountBySeverity(FaultSeverity severity) const;
+
+    /**
+     * Filtered view for the history panel (same semantics as FaultHistory)
+     * The unfiltered view is an identity mapping and allocates nothing.
+     */
+    void SetFilter(uint8_t severityMask, int codeId);
+    uint8_t GetSeverityMask() const { return severityMask_; }
+    int GetCodeFilter() const { return codeFilter_; }
+    size_t FilteredCount() const;
+    FaultRow FilteredRow(size_t n) const;
+
+private:
+    struct TimeBlock {
+        int64_t minTimestamp;
+        int64_t maxTimestamp;
+    };
+
+    struct CodeName {
+        char name[8];
+    };
+
+    static constexpr size_t kHeaderSize = 64;
+    static constexpr size_t kTimeBlockRecords = 4096;
+
+    bool MapAtLeast(size_t bytes);
+    size_t LoadCheckpoint(size_t available);
+    void ClearIndices();
+    void IndexRecord(uint32_t index, const FaultJournalRecord& record);
+    int FindCode(const char* code) const;
+    bool Matches(const FaultJournalRecord& record) const;
+    void RebuildFiltered();
+
+    int fd_ = -1;
+    Options options_;
+    std::string indexPath_;
+    size_t checkpointCount_ = 0;
+
+    const uint8_t* map_ = nullptr;
+    size_t mapLength_ = 0;
+    size_t count_ = 0;
+
+    size_t unsynced_ = 0;
+    uint64_t firstUnsyncedNs_ = 0;
+
+    // Indices
+    std::vector<TimeBlock> timeBlocks_;
+    std::unordered_map<uint64_t, uint32_t> codeKeys_;
+    std::vector<CodeName> codeNames_;
+    std::vector<std::vector<uint32_t>> byCode_;
+    std::vector<uint32_t> bySeverity_[3];
+
+    // Active filter. Only combined filters are materialized into filtered_;
+    // the others read straight from the identity or a posting list.
+    enum class ViewMode { All, Code, Severity, Materialized };
+    uint8_t severityMask_ = kAllSeverities;
+    int codeFilter_ = kAnyCode;
+    ViewMode viewMode_ = ViewMode::All;
+    int viewSeverity_ = 0;
+    std::vector<uint32_t> filtered_;
+};
+
+} // namespace ui
@@ -0,0 +1,186 @@
+#include "frame_pacer.h"
+#include "monotonic_clock.h"
+#include <algorithm>
+#include <ctime>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+namespace ui {
+
+static uint64_t ProcessCpuNs() {
+    timespec ts;
+    if (clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts) != 0) return 0;
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000000ull + static_cast<uint64_t>(ts.tv_nsec);
+}
+
+static timespec ToTimespec(uint64_t ns) {
+    timespec ts;
+    ts.tv_sec = static_cast<time_t>(ns / 1000000000ull);
+    ts.tv_nsec = static_cast<long>(ns % 1000000000ull);
+    return ts;
+}
+
+// Reset a timerfd / eventfd to not-readable
+static void Drain(int fd) {
+    uint64_t value;
+    while (read(fd, &value, sizeof(value)) == static_cast<ssize_t>(sizeof(value))) {}
+}
+
+const char* PaceModeName(PaceMode mode) {
+    switch (mode) {
+        case PaceMode::Idle:      return "idle";
+        case PaceMode::Update:    return "update";
+        case PaceMode::Animating: return "animating";
+        case PaceMode::Active:    return "active";
+        default:                  return "?";
+    }
+}
+
+FramePacer::FramePacer(const FramePacerConfig& config) : config_(config) {
+    config_.activeHz = std::max(1.0, config_.activeHz);
+    config_.idleHz = std::min(config_.activeHz, std::max(0.1, config_.idleHz));
+
+    timerFd_ = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC | TFD_NONBLOCK);
+    wakeFd_ = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (timerFd_ < 0 || wakeFd_ < 0) {
+        // clock_nanosleep fallback
+        if (timerFd_ >= 0) close(timerFd_);
+        if (wakeFd_ >= 0) close(wakeFd_);
+        timerFd_ = wakeFd_ = -1;
+    }
+}
+
+FramePacer::~FramePacer() {
+    if (timerFd_ >= 0) close(timerFd_);
+    if (wakeFd_ >= 0) close(wakeFd_);
+}
+
+uint64_t FramePacer::IntervalNs(double hz) const {
+    return static_cast<uint64_t>(1e9 / hz);
+}
+
+void FramePacer::NotifyInput() {
+    activeUntilNs_ = std::max(activeUntilNs_,
+                              MonotonicNowNs() + static_cast<uint64_t>(config_.inputLingerSeconds * 1e9));
+}
+
+void FramePacer::NotifyStateChanged() {
+    // Only the first change since the last frame needs to wake the loop
+    if (!stateChanged_.exchange(true, std::memory_order_acq_rel) && wakeFd_ >= 0) {
+        uint64_t one = 1;
+        ssize_t written = write(wakeFd_, &one, sizeof(one));
+        (void)written;
+    }
+}
+
+void FramePacer::RequestAnimation(double hz) {
+    animationHz_ = std::max(animationHz_, std::min(hz, config_.activeHz));
+}
+
+void FramePacer::RequestTransition(double seconds) {
+    activeUntilNs_ = std::max(activeUntilNs_, MonotonicNowNs() + static_cast<uint64_t>(seconds * 1e9));
+}
+
+void FramePacer::Wake() {
+    wakeRequested_.store(true, std::memory_order_release);
+    if (wakeFd_ >= 0) {
+        uint64_t one = 1;
+        ssize_t written = write(wakeFd_, &one, sizeof(one));
+        (void)written;
+    }
+}
+
+void FramePacer::Account(uint64_t nowNs) {
+    uint64_t cpuNs = ProcessCpuNs();
+    if (markWallNs_ != 0) {
+        PaceModeStats& stats = stats_[static_cast<int>(mode_)];
+        stats.wallSeconds += static_cast<double>(nowNs - markWallNs_) * 1e-9;
+        stats.cpuSeconds += static_cast<double>(cpuNs - markCpuNs_) * 1e-9;
+    }
+    markWallNs_ = nowNs;
+    markCpuNs_ = cpuNs;
+}
+
+void FramePacer::FrameStart() {
+    uint64_t now = MonotonicNowNs();
+    Account(now);
+    stats_[static_cast<int>(mode_)].frames++;
+
+    // This frame shows every change made so far
+    lastFrameNs_ = now;
+    animationHz_ = 0.0;
+    stateChanged_.store(false, std::memory_order_release);
+    wakeRequested_.store(false, std::memory_order_relaxed);
+}
+
+uint64_t FramePacer::ScheduleNext() {
+    // The frame just rendered is charged to the mode that scheduled it
+    uint64_t now = MonotonicNowNs();
+    Account(now);
+    uint64_t minInterval = IntervalNs(config_.activeHz);
+
+    if (now < activeUntilNs_) {
+        mode_ = PaceMode::Active;
+        deadlineNs_ = lastFrameNs_ + minInterval;
+    } else if (stateChanged_.load(std::memory_order_acquire)) {
+        mode_ = PaceMode::Update;
+        deadlineNs_ = lastFrameNs_ + minInterval;
+    } else if (animationHz_ > config_.idleHz) {
+        mode_ = PaceMode::Animating;
+        deadlineNs_ = lastFrameNs_ + IntervalNs(animationHz_);
+    } else {
+        mode_ = PaceMode::Idle;
+        deadlineNs_ = lastFrameNs_ + IntervalNs(config_.idleHz);
+    }
+    return deadlineNs_;
+}
+
+bool FramePacer::Wait(int inputFd) {
+    for (;;) {
+        uint64_t now = MonotonicNowNs();
+        if (wakeRequested_.exchange(false, std::memory_order_acq_rel)) return false;
+
+        // A change while idling or animating: come back as soon as allowed
+        if (stateChanged_.load(std::memory_order_acquire) &&
+            (mode_ == PaceMode::Idle || mode_ == PaceMode::Animating)) {
+            Account(now);
+            mode_ = PaceMode::Update;
+            deadlineNs_ = std::min(deadlineNs_, lastFrameNs_ + IntervalNs(config_.activeHz));
+        }
+        if (now >= deadlineNs_) return false;
+
+        timespec deadline = ToTimespec(deadlineNs_);
+        if (timerFd_ < 0) {
+            if (inputFd >= 0) {
+                // No timerfd: poll the input fd with a relative timeout instead
+                pollfd input = { inputFd, POLLIN, 0 };
+                int timeoutMs = static_cast<int>((deadlineNs_ - now + 999999) / 1000000);
+                if (poll(&input, 1, timeoutMs) > 0) return true;
+            } else {
+                clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, nullptr);
+            }
+            continue;
+        }
+
+        itimerspec spec = {};
+        spec.it_value = deadline;
+        timerfd_settime(timerFd_, TFD_TIMER_ABSTIME, &spec, nullptr);
+
+        pollfd fds[3] = { { timerFd_, POLLIN, 0 }, { wakeFd_, POLLIN, 0 }, { inputFd, POLLIN, 0 } };
+        int ready = poll(fds, inputFd >= 0 ? 3 : 2, -1);
+        if (ready < 0) continue;   // EINTR
+        if (fds[0].revents & POLLIN) Drain(timerFd_);
+        if (fds[1].revents & POLLIN) Drain(wakeFd_);
+        if (inputFd >= 0 && (fds[2].revents & (POLLIN | POLLHUP | POLLERR))) return true;
+    }
+}
+
+void FramePacer::ResetStats() {
+    for (PaceModeStats& stats : stats_) stats = PaceModeStats();
+    markWallNs_ = 0;
+    markCpuNs_ = 0;
+}
+
+} // namespace ui
@@ -0,0 +1,156 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace ui {
+
+/**
+ * Why the pacer chose the current frame interval
+ */
+enum class PaceMode {
+    Idle,           // Nothing changing: idleHz
+    Update,         // State changed: one frame, as soon as activeHz allows
+    Animating,      // Continuous animation on screen: the rate it asked for
+    Active,         // Input or a transition in flight: activeHz
+    Count
+};
+
+/**
+ * Pacer rates
+ */
+struct FramePacerConfig {
+    double activeHz = 60.0;           // Input, transitions; also the minimum frame interval
+    double idleHz = 4.0;              // Static screen (2-5 Hz keeps it responsive enough)
+    double inputLingerSeconds = 0.5;  // Stay at activeHz after the last input event
+};
+
+/**
+ * Time and CPU spent in one mode: the wait for each frame it scheduled plus
+ * rendering that frame. CPU is process time (workers included), so
+ * cpuSeconds / wallSeconds is the utilization while in that mode, in cores.
+ */
+struct PaceModeStats {
+    uint64_t frames = 0;
+    double wallSeconds = 0.0;
+    double cpuSeconds = 0.0;
+};
+
+/**
+ * Adaptive frame pacing for the render loop (Linux)
+ *
+ * Rendering at vsync all the time costs the same CPU and GPU whether
+ * anything moves or not. The pacer instead tracks what needs frames:
+ *   - input (NotifyInput): activeHz until inputLingerSeconds after the last
+ *     event, so hover and release states settle;
+ *   - transitions (RequestTransition): activeHz until they end;
+ *   - continuous animations on screen this frame (RequestAnimation, e.g. a
+ *     pulsing turn indicator): the highest rate any of them asked for;
+ *   - state changes (NotifyStateChanged, any thread): one frame, as soon as
+ *     the activeHz interval since the last frame allows;
+ * and otherwise drops to idleHz. ScheduleNext() picks the next deadline;
+ * Wait() sleeps on a timerfd until then, or until NotifyStateChanged(),
+ * Wake() or an input fd wakes it. Without timerfd/eventfd it falls back to
+ * clock_nanosleep, and state changes then wait for the next deadline.
+ *
+ * Per-mode wall time, process CPU time and frame counts (GetStats) show
+ * what each mode costs, e.g. idle vs. driving with the turn signal on.
+ *
+ * @code
+ *   ui::FramePacer pacer;
+ *   state.framePacer = &pacer;                      // Panels request their animations
+ *
+ *   for (;;) {
+ *       if (pacer.Wait(inputFd)) pacer.NotifyInput(); // Host still reads its events
+ *       pacer.FrameStart();
+ *       ImGui::NewFrame(); ui::RenderUI(state); ImGui::Render(); // ... present
+ *       pacer.ScheduleNext();
+ *   }
+ *
+ *   // Telemetry thread, after updating shared state:
+ *   pacer.NotifyStateChanged();
+ * @endcode
+ */
+class FramePacer {
+public:
+    explicit FramePacer(const FramePacerConfig& config = FramePacerConfig());
+    ~FramePacer();
+
+    FramePacer(const FramePacer&) = delete;
+    FramePacer& operator=(const FramePacer&) = delete;
+
+    /** An input event arrived (render thread) */
+    void NotifyInput();
+
+    /** Displayed state changed; thread-safe, wakes Wait() */
+    void NotifyStateChanged();
+
+    /**
+     * A continuous animation is on screen this frame (render thread, every
+     * frame it is visible)
+     *
+     * @param hz Rate it needs to look right; capped at activeHz
+     */
+    void RequestAnimation(double hz);
+
+    /** A transition runs for the next seconds (render thread) */
+    void RequestTransition(double seconds);
+
+    /**
+     * Start of a frame, after Wait() and before NewFrame()
+     */
+    void FrameStart();
+
+    /**
+     * Pick the next frame's mode and deadline, after the frame is presented
+     *
+     * @return Deadline (MonotonicNowNs() clock)
+     */
+    uint64_t ScheduleNext();
+
+    /**
+     * Sleep until the deadline, a state change, Wake(), or inputFd being
+     * readable
+     *
+     * @param inputFd Host input fd to wake on (-1 = none)
+     * @return true if inputFd woke it
+     */
+    bool Wait(int inputFd = -1);
+
+    /** Wake Wait() early for a frame; thread-safe */
+    void Wake();
+
+    PaceMode GetMode() const { return mode_; }
+    uint64_t GetDeadlineNs() const { return deadlineNs_; }
+    const FramePacerConfig& GetConfig() const { return config_; }
+
+    PaceModeStats GetStats(PaceMode mode) const { return stats_[static_cast<int>(mode)]; }
+    void ResetStats();
+
+private:
+    void Account(uint64_t nowNs);
+    uint64_t IntervalNs(double hz) const;
+
+    FramePacerConfig config_;
+    int timerFd_ = -1;
+    int wakeFd_ = -1;
+
+    std::atomic<bool> stateChanged_{false};
+    std::atomic<bool> wakeRequested_{false};
+    uint64_t lastFrameNs_ = 0;
+    uint64_t activeUntilNs_ = 0;
+    double animationHz_ = 0.0;                        // Highest request this frame
+    uint64_t deadlineNs_ = 0;
+    PaceMode mode_ = PaceMode::Active;
+
+    PaceModeStats stats_[static_cast<int>(PaceMode::Count)];
+    uint64_t markWallNs_ = 0;
+    uint64_t markCpuNs_ = 0;
+};
+
+/**
+ * Display name of a mode ("idle", "update", "animating", "active")
+ */
+const char* PaceModeName(PaceMode mode);
+
+} // namespace ui
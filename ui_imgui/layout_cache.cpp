@@ -0,0 +1,132 @@
+#include "layout_cache.h"
+#include "theme.h"
+#include <algorithm>
+#include <cstring>
+
+namespace ui {
+
+// Fluid matches what the dashboard always computed; 1280x720 comes out the
+// same as Fluid and is pinned so it no longer depends on the formula.
+static const LayoutProfileSpec kProfiles[] = {
+    //  name            width    height   side     header  row     gear   gauge   cruise
+    { "fluid",          0.0f,    0.0f,    0.0f,    40.0f,  220.0f, 80.0f, 200.0f, 80.0f },
+    { "800x480",        800.0f,  480.0f,  180.0f,  40.0f,  176.0f, 76.0f, 168.0f, 76.0f },
+    { "1280x720",       1280.0f, 720.0f,  187.2f,  40.0f,  220.0f, 80.0f, 200.0f, 80.0f },
+    { "1920x720",       1920.0f, 720.0f,  300.0f,  40.0f,  230.0f, 88.0f, 220.0f, 88.0f },
+};
+
+static const char* const kTextStrings[LayoutText_Count] = {
+    "No faults", "km/h", "Camera inactive", "[X]", "00:00", "/!\\", "(!)", "(i)",
+    "CLOSED", "OPEN", "ACTIVE", "INACTIVE", "OK", "FAULT", "ENGAGED", "RELEASED",
+};
+
+// Fluid side columns: 15% of the content width, 180-250 px
+static constexpr float kFluidSideFraction = 0.15f;
+static constexpr float kFluidSideMin = 180.0f;
+static constexpr float kFluidSideMax = 250.0f;
+static constexpr float kHeaderCenterWidth = 200.0f;
+
+const LayoutProfileSpec& GetLayoutProfileSpec(LayoutProfile profile) {
+    int index = static_cast<int>(profile) - static_cast<int>(LayoutProfile::Fluid);
+    if (index < 0 || index >= static_cast<int>(sizeof(kProfiles) / sizeof(kProfiles[0]))) index = 0;
+    return kProfiles[index];
+}
+
+LayoutProfile FindLayoutProfile(const ImVec2& displaySize) {
+    for (int i = static_cast<int>(LayoutProfile::Compact800x480); i < static_cast<int>(LayoutProfile::Count); i++) {
+        const LayoutProfileSpec& spec = GetLayoutProfileSpec(static_cast<LayoutProfile>(i));
+        if (displaySize.x == spec.width && displaySize.y == spec.height) return static_cast<LayoutProfile>(i);
+    }
+    return LayoutProfile::Fluid;
+}
+
+const char* GetLayoutTextString(LayoutText text) {
+    return text >= 0 && text < LayoutText_Count ? kTextStrings[text] : "";
+}
+
+// FNV-1a
+static uint32_t HashText(const char* text, size_t length) {
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < length; i++) {
+        hash = (hash ^ static_cast<uint8_t>(text[i])) * 16777619u;
+    }
+    return hash;
+}
+
+void LayoutCache::SetProfile(LayoutProfile profile) {
+    if (profile == requested_) return;
+    requested_ = profile;
+    valid_ = false;
+}
+
+bool LayoutCache::Update(const ImVec2& displaySize, ImFont* font, float fontSize) {
+    if (valid_ && displaySize.x == layout_.displaySize.x && displaySize.y == layout_.displaySize.y &&
+        font == font_ && fontSize == layout_.fontSize) {
+        return false;
+    }
+    layout_.displaySize = displaySize;
+    layout_.fontSize = fontSize;
+    font_ = font;
+    Rebuild();
+    return true;
+}
+
+void LayoutCache::Rebuild() {
+    DashboardLayout& l = layout_;
+    l.profile = requested_ == LayoutProfile::Auto ? FindLayoutProfile(l.displaySize) : requested_;
+    const LayoutProfileSpec& spec = GetLayoutProfileSpec(l.profile);
+
+    // Columns, as RenderDashboard lays them out inside the window padding
+    l.contentWidth = std::max(0.0f, l.displaySize.x - Spacing::WindowPadding * 2.0f);
+    float side = spec.sideColumnWidth;
+    if (side <= 0.0f) {
+        side = std::max(kFluidSideMin, std::min(kFluidSideMax, l.contentWidth * kFluidSideFraction));
+    }
+    l.leftColumnWidth = side;
+    l.rightColumnWidth = side;
+    l.centerColumnWidth = l.contentWidth - side * 2.0f - Spacing::ItemSpacing * 2.0f;
+
+    l.headerHeight = spec.headerHeight;
+    l.headerCenterX = (l.contentWidth - kHeaderCenterWidth) * 0.5f;
+
+    l.speedRowHeight = spec.speedRowHeight;
+    l.gearWidth = spec.gearWidth;
+    l.gaugeWidth = spec.gaugeWidth;
+    l.cruiseWidth = spec.cruiseWidth;
+    l.speedRowSpacing = (l.centerColumnWidth - l.gearWidth - l.gaugeWidth - l.cruiseWidth) / 4.0f;
+    l.cameraWidth = (l.centerColumnWidth - Spacing::ItemSpacing) * 0.5f;
+
+    for (int i = 0; i < LayoutText_Count; i++) {
+        l.text[i] = ImGui::CalcTextSize(kTextStrings[i]);
+    }
+
+    // Memoized widths belong to the old font
+    for (WidthSlot& slot : slots_) slot.length = 0;
+
+    valid_ = true;
+    rebuilds_++;
+}
+
+float LayoutCache::TextWidth(const char* text) {
+    size_t length = strlen(text);
+    if (!valid_ || length == 0 || length > kMaxMemoLength || ImGui::GetFont() != font_ ||
+        ImGui::GetFontSize() != layout_.fontSize) {
+        return ImGui::CalcTextSize(text).x;
+    }
+
+    uint32_t hash = HashText(text, length);
+    WidthSlot& slot = slots_[hash & (kWidthSlots - 1)];
+    if (slot.length == length && slot.hash == hash && memcmp(slot.text, text, length) == 0) {
+        memoHits_++;
+        return slot.width;
+    }
+
+    memoMisses_++;
+    slot.hash = hash;
+    slot.length = static_cast<uint8_t>(length);
+    memcpy(slot.text, text, length);
+    slot.width = ImGui::CalcTextSize(text).x;
+    return slot.width;
+}
+
+} // namespace ui
@@ -0,0 +1,165 @@
+#pragma once
+
+#include "imgui.h"
+#include <cstdint>
+
+namespace ui {
+
+/**
+ * Dashboard layout profiles
+ *
+ * The fixed profiles are tuned for the displays we ship on; Auto picks the
+ * one matching the display exactly and falls back to Fluid (columns at 15%
+ * of the width, clamped to 180-250 px) for any other size.
+ */
+enum class LayoutProfile {
+    Auto,
+    Fluid,
+    Compact800x480,
+    Hd1280x720,
+    Wide1920x720,
+    Count
+};
+
+/**
+ * Layout numbers of one profile
+ */
+struct LayoutProfileSpec {
+    const char* name;
+    float width, height;        // Display the profile is for (0 = any)
+    float sideColumnWidth;      // Left and right columns (0 = fluid)
+    float headerHeight;
+    float speedRowHeight;       // Gear / gauge / cruise row
+    float gearWidth;
+    float gaugeWidth;
+    float cruiseWidth;
+};
+
+/**
+ * Constant strings whose sizes the layout caches
+ */
+enum LayoutText {
+    LayoutText_NoFaults,
+    LayoutText_SpeedUnit,       // "km/h"
+    LayoutText_CameraInactive,
+    LayoutText_CameraOffIcon,   // "[X]"
+    LayoutText_HistoryTime,     // "00:00", fault history time column
+    LayoutText_CriticalIcon,    // Fault severity icons
+    LayoutText_WarningIcon,
+    LayoutText_InfoIcon,
+    LayoutText_Closed,          // Badges
+    LayoutText_Open,
+    LayoutText_Active,
+    LayoutText_Inactive,
+    LayoutText_Ok,
+    LayoutText_Fault,
+    LayoutText_Engaged,
+    LayoutText_Released,
+    LayoutText_Count
+};
+
+/**
+ * Panel rects and text metrics for one display size and font
+ */
+struct DashboardLayout {
+    LayoutProfile profile = LayoutProfile::Fluid;   // Resolved, never Auto
+    ImVec2 displaySize;
+    float fontSize = 0.0f;
+
+    float contentWidth = 0.0f;                      // Inside the window padding
+    float leftColumnWidth = 0.0f;
+    float centerColumnWidth = 0.0f;
+    float rightColumnWidth = 0.0f;
+
+    float headerHeight = 0.0f;
+    float headerCenterX = 0.0f;                     // Turn signals / heartbeat group
+    float speedRowHeight = 0.0f;
+    float gearWidth = 0.0f;
+    float gaugeWidth = 0.0f;
+    float cruiseWidth = 0.0f;
+    float speedRowSpacing = 0.0f;                   // Around and between the three
+    float cameraWidth = 0.0f;                       // Each of the two feeds
+
+    ImVec2 text[LayoutText_Count];                  // CalcTextSize() of each LayoutText
+};
+
+/**
+ * Layout computed once per display size / font change
+ *
+ * RenderDashboard() calls Update() every frame; it only recomputes when the
+ * display size, font or font size changed (or the profile was switched),
+ * so panels read widths and constant text sizes instead of calling
+ * GetContentRegionAvail() and CalcTextSize() each frame.
+ *
+ * TextWidth() memoizes the widths of short dynamic strings (KeyValue
+ * values such as "12.6 V") in a small direct-mapped table; values that
+ * change every frame just miss and are measured.
+ */
+class LayoutCache {
+public:
+    static constexpr int kWidthSlots = 64;
+    static constexpr int kMaxMemoLength = 23;       // Longer strings are measured directly
+
+    /**
+     * Force a profile (Auto = pick by display size)
+     */
+    void SetProfile(LayoutProfile profile);
+    LayoutProfile GetProfile() const { return requested_; }
+
+    /**
+     * Recompute if anything the layout depends on changed
+     * Call with the dashboard window's base font current.
+     *
+     * @return true if the layout was recomputed
+     */
+    bool Update(const ImVec2& displaySize, ImFont* font, float fontSize);
+
+    bool IsValid() const { return valid_; }
+    const DashboardLayout& Get() const { return layout_; }
+
+    /**
+     * CalcTextSize(text).x, memoized for the cached font
+     */
+    float TextWidth(const char* text);
+
+    uint64_t GetRebuilds() const { return rebuilds_; }
+    uint64_t GetMemoHits() const { return memoHits_; }
+    uint64_t GetMemoMisses() const { return memoMisses_; }
+
+private:
+    struct WidthSlot {
+        uint32_t hash;
+        uint8_t length;                             // 0 = empty
+        char text[kMaxMemoLength + 1];
+        float width;
+    };
+
+    void Rebuild();
+
+    LayoutProfile requested_ = LayoutProfile::Auto;
+    ImFont* font_ = nullptr;
+    bool valid_ = false;
+    DashboardLayout layout_;
+    WidthSlot slots_[kWidthSlots] = {};
+
+    uint64_t rebuilds_ = 0;
+    uint64_t memoHits_ = 0;
+    uint64_t memoMisses_ = 0;
+};
+
+/**
+ * Numbers of a profile (Auto resolves to Fluid)
+ */
+const LayoutProfileSpec& GetLayoutProfileSpec(LayoutProfile profile);
+
+/**
+ * Fixed profile made for this display, or Fluid
+ */
+LayoutProfile FindLayoutProfile(const ImVec2& displaySize);
+
+/**
+ * String measured for a LayoutText
+ */
+const char* GetLayoutTextString(LayoutText text);
+
+} // namespace ui
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace ui {
+
+/**
+ * Log-linear histogram for latency / interval measurements
+ *
+ * Values below 16 get their own bucket; above that every power of two is
+ * split into 8 linear sub-buckets (~12% relative error). Recording is a
+ * single relaxed load/store pair, so each histogram must have exactly one
+ * writer thread. Any thread may read or Merge() concurrently.
+ */
+class LogHistogram {
+public:
+    static constexpr int kSubBucketBits = 3;
+    static constexpr int kSubBuckets = 1 << kSubBucketBits;
+    static constexpr int kBucketCount = (64 - kSubBucketBits) * kSubBuckets + kSubBuckets;
+
+    LogHistogram() { Clear(); }
+    LogHistogram(const LogHistogram&) = delete;
+    LogHistogram& operator=(const LogHistogram&) = delete;
+
+    /**
+     * Record one value (single writer only)
+     */
+    void Record(uint64_t value) {
+        Bump(counts_[BucketIndex(value)], 1);
+        Bump(total_, 1);
+        if (value > max_.load(std::memory_order_relaxed)) {
+            max_.store(value, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * Reset all counters (must not race with Record)
+     */
+    void Clear() {
+        for (auto& c : counts_) c.store(0, std::memory_order_relaxed);
+        total_.store(0, std::memory_order_relaxed);
+        max_.store(0, std::memory_order_relaxed);
+    }
+
+    /**
+     * Accumulate another histogram into this one
+     * The target must not have a concurrent writer.
+     */
+    void Merge(const LogHistogram& other) {
+        for (int i = 0; i < kBucketCount; i++) {
+            Bump(counts_[i], other.counts_[i].load(std::memory_order_relaxed));
+        }
+        Bump(total_, other.total_.load(std::memory_order_relaxed));
+        uint64_t otherMax = other.max_.load(std::memory_order_relaxed);
+        if (otherMax > max_.load(std::memory_order_relaxed)) {
+            max_.store(otherMax, std::memory_order_relaxed);
+        }
+    }
+
+    uint64_t Count() const { return total_.load(std::memory_order_relaxed); }
+    uint64_t Max() const { return max_.load(std::memory_order_relaxed); }
+    uint64_t BucketCount(int index) const { return counts_[index].load(std::memory_order_relaxed); }
+
+    /**
+     * Value at the given percentile (0-100)
+     * Returns the midpoint of the bucket holding that rank, clamped to Max().
+     */
+    uint64_t Percentile(double percentile) const {
+        uint64_t total = Count();
+        if (total == 0) return 0;
+
+        uint64_t rank = static_cast<uint64_t>(percentile / 100.0 * static_cast<double>(total));
+        if (rank >= total) rank = total - 1;
+
+        uint64_t seen = 0;
+        for (int i = 0; i < kBucketCount; i++) {
+            seen += BucketCount(i);
+            if (seen > rank) {
+                uint64_t lo = BucketLowerBound(i);
+                uint64_t hi = (i + 1 < kBucketCount) ? BucketLowerBound(i + 1) : lo;
+                uint64_t mid = lo + (hi - lo) / 2;
+                return mid < Max() ? mid : Max();
+            }
+        }
+        return Max();
+    }
+
+    static int BucketIndex(uint64_t value) {
+        if (value < 2 * kSubBuckets) return static_cast<int>(value);
+        int octave = 63 - CountLeadingZeros(value);
+        int sub = static_cast<int>((value >> (octave - kSubBucketBits)) & (kSubBuckets - 1));
+        return (octave - kSubBucketBits) * kSubBuckets + sub + kSubBuckets;
+    }
+
+    static uint64_t BucketLowerBound(int index) {
+        if (index < 2 * kSubBuckets) return static_cast<uint64_t>(index);
+        int k = index - kSubBuckets;
+        int octave = k / kSubBuckets + kSubBucketBits;
+        uint64_t sub = static_cast<uint64_t>(k % kSubBuckets);
+        return (kSubBuckets + sub) << (octave - kSubBucketBits);
+    }
+
+private:
+    static void Bump(std::atomic<uint64_t>& counter, uint64_t amount) {
+        counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+    }
+
+    static int CountLeadingZeros(uint64_t value) {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_clzll(value);
+#else
+        int n = 0;
+        for (uint64_t bit = 1ull << 63; bit && !(value & bit); bit >>= 1) n++;
+        return n;
+#endif
+    }
+
+    std::atomic<uint64_t> counts_[kBucketCount];
+    std::atomic<uint64_t> total_;
+    std::atomic<uint64_t> max_;
+};
+
+} // namespace ui
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+namespace ui {
+
+/**
+ * Monotonic timestamp in nanoseconds
+ * On Linux this is CLOCK_MONOTONIC, so values are comparable across
+ * threads and processes on the same host (e.g. loopback latency)
+ */
+inline uint64_t MonotonicNowNs() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+} // namespace ui
@@ -0,0 +1,221 @@
+#include "parallel_draw.h"
+#include "imgui_internal.h"
+
+namespace ui {
+
+static constexpr uint64_t kCountMask = 0xFFFFFFFFull;
+
+// Worker lists never read the context's shared data: PushFont() rewrites
+// its font and UVs on the main thread, and its TempBuffer is the scratch
+// space of anti-aliased polygons and lines. The rest stays with each list.
+static void RefreshSharedData(ImDrawListSharedData& data, const ImDrawListSharedData& context) {
+    data.TexUvWhitePixel = context.TexUvWhitePixel;
+    data.TexUvLines = context.TexUvLines;
+    data.Font = context.Font;
+    data.FontSize = context.FontSize;
+    data.CurveTessellationTol = context.CurveTessellationTol;
+    data.ClipRectFullscreen = context.ClipRectFullscreen;
+    data.InitialFlags = context.InitialFlags;
+    if (data.CircleSegmentMaxError != context.CircleSegmentMaxError) {
+        data.SetCircleTessellationMaxError(context.CircleSegmentMaxError);
+    }
+}
+
+ParallelDraw::ParallelDraw(int workers)
+    : tasks_(kMaxTasks), lists_(kMaxTasks, nullptr), sharedData_(kMaxTasks, nullptr) {
+    for (int i = 0; i < workers; i++) {
+        workers_.emplace_back(&ParallelDraw::WorkerMain, this);
+    }
+}
+
+ParallelDraw::~ParallelDraw() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopRequested_ = true;
+    }
+    wake_.notify_all();
+    for (std::thread& worker : workers_) worker.join();
+    for (ImDrawList* list : lists_) delete list;
+    for (ImDrawListSharedData* data : sharedData_) delete data;
+}
+
+void ParallelDraw::Placeholder(const ImDrawList*, const ImDrawCmd*) {
+    // Replaced by Splice(); a backend only sees it if Splice() was skipped
+}
+
+ParallelDraw::Task* ParallelDraw::Reserve() {
+    if (workers_.empty() || queued_ >= kMaxTasks) return nullptr;
+
+    Task& task = tasks_[queued_];
+    ImDrawList* target = ImGui::GetWindowDrawList();
+
+    // A callback command is never merged with its neighbours, so it holds
+    // the slot; AddCallback() opens a fresh command after it
+    target->AddCallback(&ParallelDraw::Placeholder, &task);
+    task.target = target;
+    task.placeholder = target->CmdBuffer.Size - 2;
+
+    // Main thread, and the slot's previous build was spliced: safe to update
+    ImDrawListSharedData*& data = sharedData_[queued_];
+    ImDrawList*& list = lists_[queued_];
+    if (!list) {
+        data = new ImDrawListSharedData();
+        list = new ImDrawList(data);
+    }
+    RefreshSharedData(*data, *ImGui::GetDrawListSharedData());
+    list->_ResetForNewFrame();
+    list->Flags = target->Flags;
+    list->_FringeScale = target->_FringeScale;
+    list->PushClipRect(target->GetClipRectMin(), target->GetClipRectMax());
+    list->PushTextureID(target->_CmdHeader.TextureId);
+    task.list = list;
+    return &task;
+}
+
+void ParallelDraw::Publish() {
+    queued_++;
+    published_.store(static_cast<uint64_t>(generation_) << 32 | static_cast<uint32_t>(queued_),
+                     std::memory_order_release);
+    {
+        // Taking the lock orders this with a worker's predicate check, so
+        // the wake-up cannot fall between its check and its wait
+        std::lock_guard<std::mutex> lock(mutex_);
+    }
+    wake_.notify_one();
+}
+
+bool ParallelDraw::RunNext() {
+    uint64_t claim = claimed_.load(std::memory_order_acquire);
+    for (;;) {
+        uint64_t published = published_.load(std::memory_order_acquire);
+        if ((claim >> 32) != (published >> 32) || (claim & kCountMask) >= (published & kCountMask)) return false;
+        if (claimed_.compare_exchange_weak(claim, claim + 1, std::memory_order_acq_rel)) break;
+    }
+
+    Task& task = tasks_[claim & kCountMask];
+    task.invoke(task.build, *task.list, task.params);
+    task.list->_PopUnusedDrawCmd();
+    finished_.fetch_add(1, std::memory_order_release);
+    return true;
+}
+
+void ParallelDraw::WorkerMain() {
+    for (;;) {
+        if (RunNext()) continue;
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        wake_.wait(lock, [this] {
+            uint64_t claim = claimed_.load(std::memory_order_acquire);
+            uint64_t published = published_.load(std::memory_order_acquire);
+            bool pending = (claim >> 32) == (published >> 32) && (claim & kCountMask) < (published & kCountMask);
+            return stopRequested_ || pending;
+        });
+        if (stopRequested_) return;
+    }
+}
+
+void ParallelDraw::Splice() {
+    lastBatch_ = queued_;
+    if (queued_ == 0) return;
+
+    while (RunNext()) helped_.fetch_add(1, std::memory_order_relaxed);
+    while (finished_.load(std::memory_order_acquire) < queued_) std::this_thread::yield();
+
+    // Back to front, so splicing one task never moves an earlier placeholder
+    for (int i = queued_ - 1; i >= 0; i--) SpliceTask(tasks_[i]);
+    deferred_.fetch_add(static_cast<uint64_t>(queued_), std::memory_order_relaxed);
+
+    // All claims of this batch are done; start the next generation
+    queued_ = 0;
+    finished_.store(0, std::memory_order_relaxed);
+    generation_++;
+    claimed_.store(static_cast<uint64_t>(generation_) << 32, std::memory_order_release);
+    published_.store(static_cast<uint64_t>(generation_) << 32, std::memory_order_release);
+}
+
+void ParallelDraw::SpliceTask(Task& task) {
+    ImDrawList& target = *task.target;
+    const ImDrawList& list = *task.list;
+    task.spliced = { nullptr, 0, 0, 0 };
+
+    // The placeholder moves if the window used channels (tables, columns)
+    auto isPlaceholder = [&](int index) {
+        const ImDrawCmd& cmd = target.CmdBuffer[index];
+        return cmd.UserCallback == &ParallelDraw::Placeholder && cmd.UserCallbackData == &task;
+    };
+    int at = task.placeholder;
+    if (at < 0 || at >= target.CmdBuffer.Size || !isPlaceholder(at)) {
+        at = -1;
+        for (int i = target.CmdBuffer.Size - 1; i >= 0 && at < 0; i--) {
+            if (isPlaceholder(i)) at = i;
+        }
+        if (at < 0) {
+            lost_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+    }
+
+    unsigned int vtxBase = static_cast<unsigned int>(target.VtxBuffer.Size);
+    unsigned int idxBase = static_cast<unsigned int>(target.IdxBuffer.Size);
+    bool vtxOffset = (target.Flags & ImDrawListFlags_AllowVtxOffset) != 0;
+
+    // Without VtxOffset support the indices are rebased instead, which
+    // needs the whole window to stay within ImDrawIdx range
+    if (!vtxOffset && sizeof(ImDrawIdx) == 2 && vtxBase + list.VtxBuffer.Size > 0x10000) {
+        IM_ASSERT(false && "ParallelDraw: window exceeds 64k vertices; enable ImGuiBackendFlags_RendererHasVtxOffset");
+        target.CmdBuffer.erase(target.CmdBuffer.Data + at);
+        lost_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    target.VtxBuffer.resize(target.VtxBuffer.Size + list.VtxBuffer.Size);
+    if (list.VtxBuffer.Size) {
+        memcpy(target.VtxBuffer.Data + vtxBase, list.VtxBuffer.Data, list.VtxBuffer.size_in_bytes());
+    }
+    target.IdxBuffer.resize(target.IdxBuffer.Size + list.IdxBuffer.Size);
+    ImDrawIdx* idx = target.IdxBuffer.Data + idxBase;
+    if (vtxOffset) {
+        if (list.IdxBuffer.Size) memcpy(idx, list.IdxBuffer.Data, list.IdxBuffer.size_in_bytes());
+    } else {
+        for (int i = 0; i < list.IdxBuffer.Size; i++) idx[i] = static_cast<ImDrawIdx>(list.IdxBuffer.Data[i] + vtxBase);
+    }
+
+    target.CmdBuffer.erase(target.CmdBuffer.Data + at);
+    int inserted = 0;
+    for (int i = 0; i < list.CmdBuffer.Size; i++) {
+        ImDrawCmd cmd = list.CmdBuffer[i];
+        if (cmd.ElemCount == 0 && cmd.UserCallback == nullptr) continue;
+        if (vtxOffset) cmd.VtxOffset += vtxBase;
+        cmd.IdxOffset += idxBase;
+        target.CmdBuffer.insert(target.CmdBuffer.Data + at + inserted, cmd);
+        inserted++;
+    }
+
+    // ImGui::Render() checks that the write cursors sit at the buffer ends
+    target._VtxWritePtr = target.VtxBuffer.Data + target.VtxBuffer.Size;
+    target._IdxWritePtr = target.IdxBuffer.Data + target.IdxBuffer.Size;
+    if (!vtxOffset) target._VtxCurrentIdx = static_cast<unsigned int>(target.VtxBuffer.Size);
+
+    task.spliced = { &target, list.VtxBuffer.Size, list.IdxBuffer.Size, inserted };
+    splicedCmds_.fetch_add(static_cast<uint64_t>(inserted), std::memory_order_relaxed);
+    splicedVertices_.fetch_add(static_cast<uint64_t>(list.VtxBuffer.Size), std::memory_order_relaxed);
+}
+
+bool ParallelDraw::GetSplice(int index, ParallelDrawSplice& splice) const {
+    if (index < 0 || index >= lastBatch_ || queued_ != 0) return false;
+    splice = tasks_[index].spliced;
+    return true;
+}
+
+ParallelDrawStats ParallelDraw::GetStats() const {
+    ParallelDrawStats stats;
+    stats.deferred = deferred_.load(std::memory_order_relaxed);
+    stats.inlined = inlined_.load(std::memory_order_relaxed);
+    stats.helped = helped_.load(std::memory_order_relaxed);
+    stats.lost = lost_.load(std::memory_order_relaxed);
+    stats.splicedCmds = splicedCmds_.load(std::memory_order_relaxed);
+    stats.splicedVertices = splicedVertices_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+} // namespace ui
@@ -0,0 +1,201 @@
+#pragma once
+
+#include "imgui.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace ui {
+
+/**
+ * Pool counters
+ */
+struct ParallelDrawStats {
+    uint64_t deferred;       // Builds run on a private list (worker or Splice helper)
+    uint64_t inlined;        // Builds run straight into the window (queue full / no workers)
+    uint64_t helped;         // Deferred builds Splice() ran on the main thread
+    uint64_t lost;           // Placeholders no longer found at Splice() (geometry dropped)
+    uint64_t splicedCmds;
+    uint64_t splicedVertices;
+};
+
+/**
+ * Geometry one task of the last batch added to its window's draw list
+ */
+struct ParallelDrawSplice {
+    const ImDrawList* target;                         // nullptr if the task was lost
+    int vertices;
+    int indices;
+    int cmds;
+};
+
+/**
+ * Draw-list construction for geometry-heavy panels on worker threads
+ *
+ * ImGui's API is single-threaded, but a gauge, camera overlay or heatmap
+ * that has finished its layout only appends vertices. Defer() is called at
+ * that point on the main thread: it drops a placeholder command into the
+ * current window's draw list (which keeps the panel's place in the draw
+ * order) and queues build(list, params) on a worker. The worker fills a
+ * private ImDrawList that starts with the window's clip rect and texture.
+ * The list has its own ImDrawListSharedData, refreshed from the context's
+ * at Defer(), because the main thread keeps changing the context's copy
+ * (PushFont()) while builds run. Splice(), after the last
+ * window and before ImGui::Render(), helps run what is still queued and
+ * puts each list's commands where its placeholder was. The vertices and
+ * indices are appended to the window's buffers, so nothing already in the
+ * window's draw list moves.
+ *
+ * Builds start as soon as they are queued, so they overlap the rest of the
+ * layout and each other: with 3 workers plus the main thread, panel-heavy
+ * frames can use up to 4 cores (the speedup is not measured yet; see
+ * headless_bench --workers). Task slots and worker lists are reused, so
+ * nothing is allocated once buffers have grown to their working size.
+ *
+ * Rules for build functions: touch only the given list and params; no
+ * ImGui:: calls (the context belongs to the main thread); draw text with
+ * AddText(font, size, ...) using a font captured in params, never the
+ * list's default font. params must be trivially copyable (copied at
+ * Defer()); pointers in it must stay valid until Splice().
+ *
+ * @code
+ *   static ui::ParallelDraw parallelDraw;           // 3 workers
+ *   state.parallelDraw = &parallelDraw;             // Panels defer through DeferDraw()
+ *
+ *   ImGui::NewFrame();
+ *   ui::RenderUI(state);                            // Calls Splice()
+ *   ImGui::Render();
+ * @endcode
+ */
+class ParallelDraw {
+public:
+    static constexpr int kMaxTasks = 64;              // Per Splice(); more run inline
+    static constexpr size_t kMaxParamsSize = 256;
+
+    /**
+     * @param workers Worker threads (0 = run every build inline)
+     */
+    explicit ParallelDraw(int workers = 3);
+    ~ParallelDraw();
+
+    ParallelDraw(const ParallelDraw&) = delete;
+    ParallelDraw& operator=(const ParallelDraw&) = delete;
+
+    /**
+     * Queue build(list, params) for the current window at this point of its
+     * draw order (main thread, between Begin and End of the window)
+     *
+     * @return false if it ran inline instead (queue full or no workers)
+     */
+    template <typename Params>
+    bool Defer(void (*build)(ImDrawList& drawList, const Params& params), const Params& params);
+
+    /**
+     * Finish every queued build and splice it into its window's draw list
+     * Call on the main thread after the deferring windows have ended and
+     * before ImGui::Render(); the lists must not be appended to afterwards.
+     */
+    void Splice();
+
+    int GetWorkerCount() const { return static_cast<int>(workers_.size()); }
+    ParallelDrawStats GetStats() const;
+
+    /** Tasks queued since the last Splice() (main thread) */
+    int GetQueuedCount() const { return queued_; }
+
+    /**
+     * What the last Splice() added for task index (0 .. its batch size - 1),
+     * for per-panel accounting; valid until the next Defer()
+     *
+     * @return false if index is outside the last batch
+     */
+    bool GetSplice(int index, ParallelDrawSplice& splice) const;
+
+private:
+    using ErasedFn = void (*)();
+    using InvokeFn = void (*)(ErasedFn build, ImDrawList& drawList, const void* params);
+
+    struct Task {
+        InvokeFn invoke;
+        ErasedFn build;
+        ImDrawList* target;                           // Window draw list holding the placeholder
+        int placeholder;                              // Index of the placeholder in target->CmdBuffer
+        ImDrawList* list;                             // Private list the build fills
+        ParallelDrawSplice spliced;                   // Filled by SpliceTask()
+        alignas(16) unsigned char params[kMaxParamsSize];
+    };
+
+    Task* Reserve();
+    void Publish();
+    bool RunNext();
+    void WorkerMain();
+    void SpliceTask(Task& task);
+
+    static void Placeholder(const ImDrawList* parentList, const ImDrawCmd* cmd);
+
+    std::vector<std::thread> workers_;
+    std::vector<Task> tasks_;
+    std::vector<ImDrawList*> lists_;                  // One per task slot, created on first use
+    std::vector<ImDrawListSharedData*> sharedData_;   // Each list's own, see Reserve()
+    int queued_ = 0;                                  // Main thread only
+    int lastBatch_ = 0;                               // Tasks in the last Splice()
+
+    // Claim and publish words: generation << 32 | count, so a worker that
+    // read a stale count cannot claim a slot of the next batch
+    std::atomic<uint64_t> published_{0};
+    std::atomic<uint64_t> claimed_{0};
+    std::atomic<int> finished_{0};
+    uint32_t generation_ = 0;
+
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    bool stopRequested_ = false;
+
+    std::atomic<uint64_t> deferred_{0};
+    std::atomic<uint64_t> inlined_{0};
+    std::atomic<uint64_t> helped_{0};
+    std::atomic<uint64_t> lost_{0};
+    std::atomic<uint64_t> splicedCmds_{0};
+    std::atomic<uint64_t> splicedVertices_{0};
+};
+
+template <typename Params>
+bool ParallelDraw::Defer(void (*build)(ImDrawList& drawList, const Params& params), const Params& params) {
+    static_assert(std::is_trivially_copyable<Params>::value, "Defer() copies params");
+    static_assert(sizeof(Params) <= kMaxParamsSize && alignof(Params) <= 16, "params too large for a task slot");
+
+    Task* task = Reserve();
+    if (!task) {
+        build(*ImGui::GetWindowDrawList(), params);
+        inlined_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    task->build = reinterpret_cast<ErasedFn>(build);
+    task->invoke = [](ErasedFn erased, ImDrawList& drawList, const void* bytes) {
+        reinterpret_cast<void (*)(ImDrawList&, const Params&)>(erased)(drawList, *static_cast<const Params*>(bytes));
+    };
+    memcpy(task->params, &params, sizeof(Params));
+    Publish();
+    return true;
+}
+
+/**
+ * Defer through pool when there is one, else build into the current window
+ */
+template <typename Params>
+inline void DeferDraw(ParallelDraw* pool, void (*build)(ImDrawList& drawList, const Params& params),
+                      const Params& params) {
+    if (pool) {
+        pool->Defer(build, params);
+    } else {
+        build(*ImGui::GetWindowDrawList(), params);
+    }
+}
+
+} // namespace ui
@@ -0,0 +1,241 @@
+#include "session_export.h"
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace ui {
+
+enum SignalIntColumn {
+    IntColumn_Time,
+    IntColumn_Speed,
+    IntColumn_Gear,
+    IntColumn_CruiseEnabled,
+    IntColumn_CruiseSetSpeed,
+    IntColumn_BrakeEngaged,
+    IntColumn_ContactorMain,
+    IntColumn_ContactorPrecharge,
+    IntColumn_ContactorHvil,
+    IntColumn_Heartbeat,
+    IntColumn_TurnSignal,
+    IntColumn_FaultCount,
+    IntColumn_Count
+};
+
+enum SignalFloatColumn {
+    FloatColumn_MainSoc,
+    FloatColumn_MainVoltage,
+    FloatColumn_MainCurrent,
+    FloatColumn_SuppSoc,
+    FloatColumn_SuppVoltage,
+    FloatColumn_Count
+};
+
+struct SignalColumnDef {
+    const char* name;
+    ColumnType type;
+    int index;              // Into the int or float buffers
+};
+
+// File column order
+static const SignalColumnDef kSignalColumns[] = {
+    { "time_ns", ColumnType::Int, IntColumn_Time },
+    { "speed", ColumnType::Int, IntColumn_Speed },
+    { "gear", ColumnType::Int, IntColumn_Gear },
+    { "main_soc", ColumnType::Float, FloatColumn_MainSoc },
+    { "main_voltage", ColumnType::Float, FloatColumn_MainVoltage },
+    { "main_current", ColumnType::Float, FloatColumn_MainCurrent },
+    { "supp_soc", ColumnType::Float, FloatColumn_SuppSoc },
+    { "supp_voltage", ColumnType::Float, FloatColumn_SuppVoltage },
+    { "cruise_enabled", ColumnType::Int, IntColumn_CruiseEnabled },
+    { "cruise_set_speed", ColumnType::Int, IntColumn_CruiseSetSpeed },
+    { "brake_engaged", ColumnType::Int, IntColumn_BrakeEngaged },
+    { "contactor_main", ColumnType::Int, IntColumn_ContactorMain },
+    { "contactor_precharge", ColumnType::Int, IntColumn_ContactorPrecharge },
+    { "contactor_hvil", ColumnType::Int, IntColumn_ContactorHvil },
+    { "heartbeat", ColumnType::Int, IntColumn_Heartbeat },
+    { "turn_signal", ColumnType::Int, IntColumn_TurnSignal },
+    { "fault_count", ColumnType::Int, IntColumn_FaultCount },
+};
+static constexpr size_t kSignalColumnCount = sizeof(kSignalColumns) / sizeof(kSignalColumns[0]);
+
+struct FaultEpisode {
+    std::string code;
+    std::string message;
+    int64_t severity;
+    int64_t firstSeenMs;
+    int64_t startNs;
+    bool seen;
+};
+
+struct SessionExporter {
+    ColumnFileWriter writer;
+    uint32_t rowGroupRows = 0;
+    int signalTable = -1;
+    int faultTable = -1;
+    bool ok = true;
+    uint64_t rows = 0;
+    uint64_t lastTimeNs = 0;
+
+    std::vector<int64_t> ints[IntColumn_Count];
+    std::vector<float> floats[FloatColumn_Count];
+
+    // Fault episodes: open ones, and closed rows as columns
+    WireVehicleState lastFaults;
+    std::vector<FaultEpisode> open;
+    std::vector<std::string> codes;
+    std::vector<std::string> messages;
+    std::vector<int64_t> severities;
+    std::vector<int64_t> firstSeen;
+    std::vector<int64_t> starts;
+    std::vector<int64_t> ends;
+    std::vector<int64_t> stillOpen;
+
+    bool FlushSignals() {
+        if (ints[IntColumn_Time].empty()) return true;
+        ColumnSlice slices[kSignalColumnCount];
+        for (size_t c = 0; c < kSignalColumnCount; c++) {
+            if (kSignalColumns[c].type == ColumnType::Float) {
+                slices[c].floats = floats[kSignalColumns[c].index].data();
+            } else {
+                slices[c].ints = ints[kSignalColumns[c].index].data();
+            }
+        }
+        bool written = writer.WriteRowGroup(signalTable, slices, ints[IntColumn_Time].size());
+        for (std::vector<int64_t>& column : ints) column.clear();
+        for (std::vector<float>& column : floats) column.clear();
+        return written;
+    }
+
+    void CloseEpisode(const FaultEpisode& episode, uint64_t endNs, bool active) {
+        codes.push_back(episode.code);
+        messages.push_back(episode.message);
+        severities.push_back(episode.severity);
+        firstSeen.push_back(episode.firstSeenMs);
+        starts.push_back(episode.startNs);
+        ends.push_back(static_cast<int64_t>(endNs));
+        stillOpen.push_back(active ? 1 : 0);
+    }
+
+    void TrackFaults(uint64_t timeNs, const WireVehicleState& state) {
+        for (FaultEpisode& episode : open) episode.seen = false;
+        for (size_t i = 0; i < state.faultsCount; i++) {
+            const WireFault& fault = state.faults[i];
+            std::string code(fault.code, strnlen(fault.code, sizeof(fault.code)));
+            FaultEpisode* episode = nullptr;
+            for (FaultEpisode& candidate : open) {
+                if (candidate.code == code) episode = &candidate;
+            }
+            if (!episode) {
+                open.push_back({ code, std::string(), 0, 0, static_cast<int64_t>(timeNs), false });
+                episode = &open.back();
+            }
+            episode->message.assign(fault.message, strnlen(fault.message, sizeof(fault.message)));
+            episode->severity = fault.severity;
+            episode->firstSeenMs = fault.timestamp;
+            episode->seen = true;
+        }
+        for (size_t i = 0; i < open.size();) {
+            if (open[i].seen) {
+                i++;
+                continue;
+            }
+            CloseEpisode(open[i], timeNs, false);
+            open.erase(open.begin() + static_cast<std::ptrdiff_t>(i));
+        }
+    }
+
+    void Add(uint64_t timeNs, const WireVehicleState& state) {
+        ints[IntColumn_Time].push_back(static_cast<int64_t>(timeNs));
+        ints[IntColumn_Speed].push_back(state.speed);
+        ints[IntColumn_Gear].push_back(state.gear);
+        ints[IntColumn_CruiseEnabled].push_back(state.cruiseEnabled != 0);
+        ints[IntColumn_CruiseSetSpeed].push_back(state.cruiseSetSpeed);
+        ints[IntColumn_BrakeEngaged].push_back(state.brakeEngaged != 0);
+        ints[IntColumn_ContactorMain].push_back(state.contactorStatesMain != 0);
+        ints[IntColumn_ContactorPrecharge].push_back(state.contactorStatesPrecharge != 0);
+        ints[IntColumn_ContactorHvil].push_back(state.contactorStatesHvil != 0);
+        ints[IntColumn_Heartbeat].push_back(state.heartbeat);
+        ints[IntColumn_TurnSignal].push_back(state.turnSignal);
+        ints[IntColumn_FaultCount].push_back(state.faultsCount);
+        floats[FloatColumn_MainSoc].push_back(state.mainBatterySoc);
+        floats[FloatColumn_MainVoltage].push_back(state.mainBatteryVoltage);
+        floats[FloatColumn_MainCurrent].push_back(state.mainBatteryCurrent);
+        floats[FloatColumn_SuppSoc].push_back(state.suppBatterySoc);
+        floats[FloatColumn_SuppVoltage].push_back(state.suppBatteryVoltage);
+
+        // Episodes only change with the fault list
+        size_t faultBytes = state.faultsCount * sizeof(WireFault);
+        if (rows == 0 || state.faultsCount != lastFaults.faultsCount ||
+            memcmp(state.faults, lastFaults.faults, faultBytes) != 0) {
+            TrackFaults(timeNs, state);
+            lastFaults.faultsCount = state.faultsCount;
+            memcpy(lastFaults.faults, state.faults, faultBytes);
+        }
+
+        rows++;
+        lastTimeNs = timeNs;
+        if (ints[IntColumn_Time].size() >= rowGroupRows) ok &= FlushSignals();
+    }
+
+    static bool Visit(uint64_t timeNs, const WireVehicleState& state, void* userData) {
+        SessionExporter* exporter = static_cast<SessionExporter*>(userData);
+        exporter->Add(timeNs, state);
+        return exporter->ok;
+    }
+
+    bool WriteFaults() {
+        for (const FaultEpisode& episode : open) CloseEpisode(episode, lastTimeNs, true);
+        open.clear();
+        for (size_t first = 0; first < codes.size(); first += rowGroupRows) {
+            ColumnSlice slices[7];
+            slices[0].strings = codes.data() + first;
+            slices[1].strings = messages.data() + first;
+            slices[2].ints = severities.data() + first;
+            slices[3].ints = firstSeen.data() + first;
+            slices[4].ints = starts.data() + first;
+            slices[5].ints = ends.data() + first;
+            slices[6].ints = stillOpen.data() + first;
+            size_t count = std::min<size_t>(rowGroupRows, codes.size() - first);
+            if (!writer.WriteRowGroup(faultTable, slices, count)) return false;
+        }
+        return true;
+    }
+};
+
+bool ExportSessionColumns(SessionReader& reader, const char* path, const SessionExportOptions& options,
+                          SessionExportStats* stats) {
+    if (!reader.IsOpen() || options.rowGroupRows == 0) return false;
+
+    SessionExporter exporter;
+    if (!exporter.writer.Open(path)) return false;
+    exporter.rowGroupRows = options.rowGroupRows;
+    for (std::vector<int64_t>& column : exporter.ints) column.reserve(options.rowGroupRows);
+    for (std::vector<float>& column : exporter.floats) column.reserve(options.rowGroupRows);
+
+    std::vector<ColumnInfo> signalColumns;
+    for (const SignalColumnDef& def : kSignalColumns) signalColumns.push_back({ def.name, def.type });
+    exporter.signalTable = exporter.writer.AddTable("signals", signalColumns);
+    exporter.faultTable = exporter.writer.AddTable("faults", {
+        { "code", ColumnType::String },
+        { "message", ColumnType::String },
+        { "severity", ColumnType::Int },
+        { "first_seen_ms", ColumnType::Int },
+        { "start_ns", ColumnType::Int },
+        { "end_ns", ColumnType::Int },
+        { "open", ColumnType::Int },
+    });
+
+    bool ok = reader.Scan(SessionExporter::Visit, &exporter);
+    ok = ok && exporter.FlushSignals() && exporter.WriteFaults();
+    ok = exporter.writer.Close() && ok;
+
+    if (stats) {
+        stats->rows = exporter.rows;
+        stats->faultEpisodes = exporter.codes.size();
+        stats->bytes = exporter.writer.GetBytesWritten();
+    }
+    return ok;
+}
+
+} // namespace ui
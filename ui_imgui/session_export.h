@@ -0,0 +1,44 @@
+#pragma once
+
+#include "column_file.h"
+#include "session_store.h"
+#include <cstdint>
+
+namespace ui {
+
+struct SessionExportOptions {
+    uint32_t rowGroupRows = 65536;      // Rows per row group (statistics granularity)
+};
+
+struct SessionExportStats {
+    uint64_t rows = 0;                  // "signals" rows (recorded frames)
+    uint64_t faultEpisodes = 0;         // "faults" rows
+    uint64_t bytes = 0;                 // Output file size
+};
+
+/**
+ * Convert a recorded session into a columnar file (column_file.h)
+ *
+ * Table "signals", one row per recorded frame (a value holds until the
+ * next row):
+ *   time_ns, speed, gear, main_soc, main_voltage, main_current, supp_soc,
+ *   supp_voltage, cruise_enabled, cruise_set_speed, brake_engaged,
+ *   contactor_main, contactor_precharge, contactor_hvil, heartbeat,
+ *   turn_signal, fault_count
+ * Floats are Float columns, everything else Int (booleans 0/1, enums as
+ * their values).
+ *
+ * Table "faults", one row per fault episode (a code from when it appears in
+ * the active list until it leaves it):
+ *   code, message (String), severity, first_seen_ms (the fault's own
+ *   timestamp), start_ns, end_ns, open (1 if still active at the end)
+ *
+ * The session is read with one sequential pass (SessionReader::Scan()) and
+ * written one row group at a time.
+ *
+ * @return false if the output cannot be written
+ */
+bool ExportSessionColumns(SessionReader& reader, const char* path, const SessionExportOptions& options,
+                          SessionExportStats* stats = nullptr);
+
+} // namespace ui
@@ -0,0 +1,457 @@
+#include "session_store.h"
+#include "crc32.h"
+#include <algorithm>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace ui {
+
+static const char kSessionMagic[8] = { 'S', 'E', 'S', 'S', 'R', 'E', 'C', '1' };
+static constexpr size_t kFileHeaderSize = 16;   // magic, u32 wire struct size, u32 reserved
+static constexpr size_t kKeyframeRecordSize = sizeof(SessionRecordHeader) + sizeof(WireVehicleState);
+
+struct WireMember {
+    uint16_t offset;
+    uint16_t size;
+};
+
+// Byte range of each WireField member (index = bit); faults are variable
+// length and handled separately
+static const WireMember kWireMembers[kWireFieldCount] = {
+    { offsetof(WireVehicleState, speed), sizeof(int32_t) },
+    { offsetof(WireVehicleState, gear), 1 },
+    { offsetof(WireVehicleState, mainBatterySoc), sizeof(float) },
+    { offsetof(WireVehicleState, mainBatteryVoltage), sizeof(float) },
+    { offsetof(WireVehicleState, mainBatteryCurrent), sizeof(float) },
+    { offsetof(WireVehicleState, suppBatterySoc), sizeof(float) },
+    { offsetof(WireVehicleState, suppBatteryVoltage), sizeof(float) },
+    { offsetof(WireVehicleState, cruiseEnabled), 1 },
+    { offsetof(WireVehicleState, cruiseSetSpeed), sizeof(int32_t) },
+    { offsetof(WireVehicleState, brakeEngaged), 1 },
+    { offsetof(WireVehicleState, contactorStatesMain), 1 },
+    { offsetof(WireVehicleState, contactorStatesPrecharge), 1 },
+    { offsetof(WireVehicleState, contactorStatesHvil), 1 },
+    { offsetof(WireVehicleState, heartbeat), 1 },
+    { 0, 0 },
+    { offsetof(WireVehicleState, turnSignal), 1 },
+};
+
+static constexpr int kFaultsBit = 14;
+static_assert(WireField_Faults == 1u << kFaultsBit, "faults bit moved");
+
+static size_t Align8(size_t size) {
+    return (size + 7) & ~size_t(7);
+}
+
+static size_t DeltaPayloadSize(const WireVehicleState& wire, uint32_t fields) {
+    size_t size = 0;
+    for (int bit = 0; bit < kWireFieldCount; bit++) {
+        if (!(fields & (1u << bit))) continue;
+        size += bit == kFaultsBit ? 1 + wire.faultsCount * sizeof(WireFault) : kWireMembers[bit].size;
+    }
+    return size;
+}
+
+// Offset of the faults count byte in a delta payload
+static size_t FaultsOffset(uint32_t fields) {
+    size_t offset = 0;
+    for (int bit = 0; bit < kFaultsBit; bit++) {
+        if (fields & (1u << bit)) offset += kWireMembers[bit].size;
+    }
+    return offset;
+}
+
+static bool WriteAll(int fd, const void* data, size_t size) {
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    while (size > 0) {
+        ssize_t written = write(fd, bytes, size);
+        if (written < 0) return false;
+        bytes += written;
+        size -= static_cast<size_t>(written);
+    }
+    return true;
+}
+
+SessionWriter::~SessionWriter() {
+    Close();
+}
+
+bool SessionWriter::Open(const char* path, const Options& options) {
+    Close();
+    options_ = options;
+
+    fd_ = open(path, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd_ < 0) return false;
+
+    uint8_t header[kFileHeaderSize] = {};
+    memcpy(header, kSessionMagic, sizeof(kSessionMagic));
+    uint32_t wireSize = sizeof(WireVehicleState);
+    memcpy(header + 8, &wireSize, sizeof(wireSize));
+    if (!WriteAll(fd_, header, sizeof(header))) {
+        Close();
+        return false;
+    }
+
+    buffer_.clear();
+    buffer_.reserve(options_.bufferBytes + kKeyframeRecordSize + 8);
+    hasLast_ = false;
+    lastTimeNs_ = 0;
+    keyframeTimeNs_ = 0;
+    sinceKeyframe_ = 0;
+    keyframes_ = 0;
+    deltas_ = 0;
+    bytes_ = kFileHeaderSize;
+    return true;
+}
+
+void SessionWriter::Close() {
+    if (fd_ >= 0) {
+        Flush();
+        close(fd_);
+        fd_ = -1;
+    }
+    buffer_.clear();
+}
+
+bool SessionWriter::Record(const AppState& state, uint64_t timeNs) {
+    WireVehicleState wire;
+    EncodeWire(state, wire);
+    return RecordWire(wire, timeNs);
+}
+
+bool SessionWriter::RecordWire(const WireVehicleState& wire, uint64_t timeNs) {
+    if (fd_ < 0) return false;
+    if (hasLast_ && timeNs < lastTimeNs_) timeNs = lastTimeNs_;
+
+    bool keyframe = !hasLast_ || sinceKeyframe_ >= options_.keyframeRecords ||
+                    timeNs - keyframeTimeNs_ >= options_.keyframeIntervalNs;
+    uint32_t fields = WireField_All;
+    if (!keyframe) {
+        fields = DiffWire(last_, wire);
+        if (fields == 0) return true;
+    }
+
+    if (!Append(wire, timeNs, fields, keyframe ? SessionRecord_Keyframe : SessionRecord_Delta)) return false;
+
+    if (keyframe) {
+        keyframeTimeNs_ = timeNs;
+        sinceKeyframe_ = 0;
+        keyframes_++;
+    } else {
+        sinceKeyframe_++;
+        deltas_++;
+    }
+    last_ = wire;
+    hasLast_ = true;
+    lastTimeNs_ = timeNs;
+    return true;
+}
+
+bool SessionWriter::Append(const WireVehicleState& wire, uint64_t timeNs, uint32_t fields, SessionRecordKind kind) {
+    size_t payload = kind == SessionRecord_Keyframe ? sizeof(WireVehicleState) : DeltaPayloadSize(wire, fields);
+    size_t size = Align8(sizeof(SessionRecordHeader) + payload);
+    size_t at = buffer_.size();
+    buffer_.resize(at + size);
+    uint8_t* record = buffer_.data() + at;
+
+    SessionRecordHeader header;
+    memset(&header, 0, sizeof(header));
+    header.size = static_cast<uint32_t>(size);
+    header.timeNs = timeNs;
+    header.fields = fields;
+    header.kind = kind;
+
+    uint8_t* out = record + sizeof(SessionRecordHeader);
+    if (kind == SessionRecord_Keyframe) {
+        memcpy(out, &wire, sizeof(wire));
+    } else {
+        const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&wire);
+        for (int bit = 0; bit < kWireFieldCount; bit++) {
+            if (!(fields & (1u << bit))) continue;
+            if (bit == kFaultsBit) {
+                *out++ = wire.faultsCount;
+                memcpy(out, wire.faults, wire.faultsCount * sizeof(WireFault));
+                out += wire.faultsCount * sizeof(WireFault);
+            } else {
+                memcpy(out, bytes + kWireMembers[bit].offset, kWireMembers[bit].size);
+                out += kWireMembers[bit].size;
+            }
+        }
+    }
+
+    memcpy(record, &header, sizeof(header));
+    header.crc = Crc32(record + 8, size - 8);
+    memcpy(record + offsetof(SessionRecordHeader, crc), &header.crc, sizeof(header.crc));
+
+    bytes_ += size;
+    return buffer_.size() < options_.bufferBytes || Flush();
+}
+
+bool SessionWriter::Flush() {
+    if (fd_ < 0) return false;
+    if (buffer_.empty()) return true;
+    bool ok = WriteAll(fd_, buffer_.data(), buffer_.size());
+    buffer_.clear();
+    return ok;
+}
+
+SessionReader::~SessionReader() {
+    Close();
+}
+
+bool SessionReader::Open(const char* path) {
+    Close();
+    fd_ = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd_ < 0) return false;
+    if (!Refresh() || indexedEnd_ == 0) {
+        Close();
+        return false;
+    }
+    return true;
+}
+
+void SessionReader::Close() {
+    if (map_) munmap(const_cast<uint8_t*>(map_), mapLength_);
+    if (fd_ >= 0) close(fd_);
+    fd_ = -1;
+    map_ = nullptr;
+    mapLength_ = 0;
+    indexedEnd_ = 0;
+    endNs_ = 0;
+    records_ = 0;
+    keyframes_.clear();
+    faultTimes_.clear();
+    cursorKeyframe_ = SIZE_MAX;
+    cursorTimeNs_ = 0;
+    nextOffset_ = 0;
+}
+
+bool SessionReader::Refresh() {
+    if (fd_ < 0) return false;
+
+    struct stat st;
+    if (fstat(fd_, &st) != 0) return false;
+    size_t size = static_cast<size_t>(st.st_size);
+    if (size < kFileHeaderSize) return indexedEnd_ != 0;
+
+    if (size > mapLength_) {
+        void* mapping = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd_, 0);
+        if (mapping == MAP_FAILED) return false;
+        if (map_) munmap(const_cast<uint8_t*>(map_), mapLength_);
+        map_ = static_cast<const uint8_t*>(mapping);
+        mapLength_ = size;
+    }
+
+    if (indexedEnd_ == 0) {
+        uint32_t wireSize = 0;
+        memcpy(&wireSize, map_ + 8, sizeof(wireSize));
+        if (memcmp(map_, kSessionMagic, sizeof(kSessionMagic)) != 0 || wireSize != sizeof(WireVehicleState)) {
+            return false;
+        }
+        indexedEnd_ = kFileHeaderSize;
+    }
+
+    // Index complete records; stop at the first torn or foreign one (a
+    // writer may be in the middle of appending it)
+    while (indexedEnd_ + sizeof(SessionRecordHeader) <= mapLength_) {
+        const SessionRecordHeader* header = HeaderAt(indexedEnd_);
+        if (header->size < sizeof(SessionRecordHeader) || header->size % 8 != 0 ||
+            header->size > mapLength_ - indexedEnd_ || header->kind > SessionRecord_Delta) {
+            break;
+        }
+        if (Crc32(map_ + indexedEnd_ + 8, header->size - 8) != header->crc) break;
+
+        const uint8_t* payload = map_ + indexedEnd_ + sizeof(SessionRecordHeader);
+        if (header->kind == SessionRecord_Keyframe) {
+            if (header->size < kKeyframeRecordSize) break;
+            keyframes_.push_back({ header->timeNs, indexedEnd_ });
+            if (payload[offsetof(WireVehicleState, faultsCount)] != 0) faultTimes_.push_back(header->timeNs);
+        } else if (keyframes_.empty()) {
+            break;
+        } else if (header->fields & WireField_Faults) {
+            if (payload[FaultsOffset(header->fields)] != 0) faultTimes_.push_back(header->timeNs);
+        }
+        endNs_ = header->timeNs;
+        records_++;
+        indexedEnd_ += header->size;
+    }
+    return true;
+}
+
+const WireVehicleState* SessionReader::Seek(uint64_t timeNs, uint32_t* appliedDeltas) {
+    if (appliedDeltas) *appliedDeltas = 0;
+    if (keyframes_.empty() || timeNs < keyframes_.front().timeNs) return nullptr;
+
+    // Last keyframe at or before timeNs
+    auto it = std::upper_bound(keyframes_.begin(), keyframes_.end(), timeNs,
+                               [](uint64_t t, const Keyframe& keyframe) { return t < keyframe.timeNs; });
+    size_t keyframe = static_cast<size_t>(it - keyframes_.begin()) - 1;
+
+    // Forward inside the cursor's GOP: continue from where it stopped
+    if (keyframe != cursorKeyframe_ || timeNs < cursorTimeNs_) {
+        const Keyframe& entry = keyframes_[keyframe];
+        memcpy(&current_, map_ + entry.offset + sizeof(SessionRecordHeader), sizeof(current_));
+        cursorKeyframe_ = keyframe;
+        cursorTimeNs_ = entry.timeNs;
+        nextOffset_ = entry.offset + HeaderAt(entry.offset)->size;
+    }
+
+    uint64_t end = keyframe + 1 < keyframes_.size() ? keyframes_[keyframe + 1].offset : indexedEnd_;
+    uint32_t applied = 0;
+    while (nextOffset_ < end) {
+        const SessionRecordHeader* header = HeaderAt(nextOffset_);
+        if (header->timeNs > timeNs) break;
+        ApplyDelta(*header);
+        cursorTimeNs_ = header->timeNs;
+        nextOffset_ += header->size;
+        applied++;
+    }
+
+    if (appliedDeltas) *appliedDeltas = applied;
+    return &current_;
+}
+
+bool SessionReader::Scan(SessionRecordVisitor visitor, void* userData) {
+    cursorKeyframe_ = SIZE_MAX;
+    for (uint64_t offset = kFileHeaderSize; offset < indexedEnd_;) {
+        const SessionRecordHeader* header = HeaderAt(offset);
+        if (header->kind == SessionRecord_Keyframe) {
+            memcpy(&current_, map_ + offset + sizeof(SessionRecordHeader), sizeof(current_));
+        } else {
+            ApplyDelta(*header);
+        }
+        if (!visitor(header->timeNs, current_, userData)) return false;
+        offset += header->size;
+    }
+    return true;
+}
+
+bool SessionReader::ApplyDelta(const SessionRecordHeader& header) {
+    const uint8_t* in = reinterpret_cast<const uint8_t*>(&header) + sizeof(SessionRecordHeader);
+    const uint8_t* end = reinterpret_cast<const uint8_t*>(&header) + header.size;
+    uint8_t* patch = reinterpret_cast<uint8_t*>(&patch_);
+
+    for (int bit = 0; bit < kWireFieldCount; bit++) {
+        if (!(header.fields & (1u << bit))) continue;
+        if (bit == kFaultsBit) {
+            if (in >= end || *in > kWireMaxFaults) return false;
+            size_t count = *in++;
+            if (static_cast<size_t>(end - in) < count * sizeof(WireFault)) return false;
+            patch_.faultsCount = static_cast<uint8_t>(count);
+            memcpy(patch_.faults, in, count * sizeof(WireFault));
+            memset(patch_.faults + count, 0, (kWireMaxFaults - count) * sizeof(WireFault));
+            in += count * sizeof(WireFault);
+        } else {
+            if (static_cast<size_t>(end - in) < kWireMembers[bit].size) return false;
+            memcpy(patch + kWireMembers[bit].offset, in, kWireMembers[bit].size);
+            in += kWireMembers[bit].size;
+        }
+    }
+    ApplyWirePatch(current_, patch_, header.fields);
+    return true;
+}
+
+void ApplyWireToState(const WireVehicleState& wire, AppState& state) {
+    state.speed = wire.speed;
+    state.gear = static_cast<Gear>(wire.gear);
+    state.mainBattery.soc = wire.mainBatterySoc;
+    state.mainBattery.voltage = wire.mainBatteryVoltage;
+    state.mainBattery.current = wire.mainBatteryCurrent;
+    state.suppBattery.soc = wire.suppBatterySoc;
+    state.suppBattery.voltage = wire.suppBatteryVoltage;
+    state.cruise.enabled = wire.cruiseEnabled != 0;
+    state.cruise.setSpeed = wire.cruiseSetSpeed;
+    state.brakeEngaged = wire.brakeEngaged != 0;
+    state.contactorStates.main = wire.contactorStatesMain != 0;
+    state.contactorStates.precharge = wire.contactorStatesPrecharge != 0;
+    state.contactorStates.hvil = wire.contactorStatesHvil != 0;
+    state.heartbeat = wire.heartbeat;
+    state.turnSignal = static_cast<TurnSignal>(wire.turnSignal);
+
+    // Scalars now match, so this only compares the fault lists
+    if (WireMatches(wire, state)) return;
+    state.faults = FaultAggregator();
+    for (size_t i = 0; i < wire.faultsCount; i++) {
+        const WireFault& entry = wire.faults[i];
+        Fault fault;
+        fault.code.assign(entry.code, strnlen(entry.code, sizeof(entry.code)));
+        fault.message.assign(entry.message, strnlen(entry.message, sizeof(entry.message)));
+        fault.severity = static_cast<FaultSeverity>(entry.severity);
+        fault.timestamp = entry.timestamp;
+        state.faults.Report(fault);
+    }
+}
+
+static constexpr uint64_t kRefreshIntervalNs = 1000000000ull;
+
+SessionPlayback::SessionPlayback() : view_(CreateDefaultState()) {
+}
+
+bool SessionPlayback::Open(const char* path) {
+    Close();
+    if (!reader_.Open(path)) return false;
+    timeNs_ = reader_.GetStartNs();
+    return true;
+}
+
+void SessionPlayback::Close() {
+    reader_.Close();
+    wire_ = nullptr;
+    timeNs_ = 0;
+    resolvedNs_ = UINT64_MAX;
+    playing_ = false;
+    lastSeekDeltas_ = 0;
+}
+
+void SessionPlayback::SetTime(uint64_t timeNs) {
+    timeNs_ = std::min(std::max(timeNs, reader_.GetStartNs()), reader_.GetEndNs());
+}
+
+void SessionPlayback::Advance(uint64_t elapsedNs) {
+    if (!playing_) return;
+    uint64_t next = timeNs_ + static_cast<uint64_t>(static_cast<double>(elapsedNs) * rate_);
+    if (next >= reader_.GetEndNs()) {
+        reader_.Refresh();                              // Still recording?
+        if (next >= reader_.GetEndNs()) playing_ = false;
+    }
+    SetTime(next);
+}
+
+void SessionPlayback::Poll(uint64_t nowNs) {
+    if (!reader_.IsOpen() || nowNs - refreshNs_ < kRefreshIntervalNs) return;
+    refreshNs_ = nowNs;
+    reader_.Refresh();
+}
+
+AppState& SessionPlayback::Resolve(const AppState& live) {
+    if (timeNs_ != resolvedNs_) {
+        wire_ = reader_.Seek(timeNs_, &lastSeekDeltas_);
+        resolvedNs_ = timeNs_;
+    }
+    if (wire_) ApplyWireToState(*wire_, view_);
+
+    // The recording holds the wire state only: no cell data, interpolation,
+    // feed freshness or fault history. Leave those detached rather than
+    // borrowing the live state's, so the view never mixes live data into
+    // the past; the dashboard hides the cell section while a playback view
+    // is shown.
+    view_.signals = nullptr;
+    view_.freshness = nullptr;
+    view_.cellHeatmap = nullptr;
+    view_.faultHistory = nullptr;
+
+    view_.layout = live.layout;
+    view_.framePacer = live.framePacer;
+    view_.drawBudget = live.drawBudget;
+    view_.parallelDraw = live.parallelDraw;
+    view_.rearCameraTexture = live.rearCameraTexture;
+    view_.sideCameraTexture = live.sideCameraTexture;
+    view_.playback = this;
+    return view_;
+}
+
+} // namespace ui
@@ -0,0 +1,300 @@
+#pragma once
+
+#include "state.h"
+#include "state_diff.h"
+#include "state_wire.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ui {
+
+/**
+ * On-disk session record header (24 bytes, host byte order)
+ *
+ * A keyframe carries a whole WireVehicleState; a delta carries only the
+ * members in fields, in WireField bit order, each at its wire size (faults
+ * as a count byte followed by that many WireFault entries). Records are
+ * padded to 8 bytes.
+ */
+struct SessionRecordHeader {
+    uint32_t size;              // Header + payload + padding
+    uint32_t crc;               // CRC-32 of the record after this field
+    uint64_t timeNs;            // Caller's clock (non-decreasing)
+    uint32_t fields;            // WireField mask (keyframes: WireField_All)
+    uint8_t kind;               // SessionRecordKind
+    uint8_t reserved[3];
+};
+static_assert(sizeof(SessionRecordHeader) == 24, "session record layout changed");
+
+enum SessionRecordKind : uint8_t {
+    SessionRecord_Keyframe = 0,
+    SessionRecord_Delta = 1,
+};
+
+/**
+ * Records AppState snapshots as keyframes plus deltas (POSIX)
+ *
+ * Like a video GOP: a full WireVehicleState keyframe every keyframeRecords
+ * records or keyframeIntervalNs, whichever comes first, and in between only
+ * the members DiffWire() reports as changed. Frames where nothing changed
+ * write nothing, so an idle dashboard costs no disk space.
+ *
+ * Records are buffered and written with write(2) once the buffer fills, on
+ * Flush() and on Close(); a crash loses at most the buffer, and the reader
+ * drops a torn last record by its CRC.
+ *
+ * @code
+ *   ui::SessionWriter recorder;
+ *   recorder.Open("session.rec");
+ *   // Each frame, after the state was updated:
+ *   recorder.Record(state, ui::MonotonicNowNs());
+ * @endcode
+ */
+class SessionWriter {
+public:
+    struct Options {
+        uint32_t keyframeRecords = 300;                 // Records per GOP at most (5 s at 60 Hz)
+        uint64_t keyframeIntervalNs = 5000000000ull;    // ... or this much time
+        size_t bufferBytes = 64 * 1024;                 // Written out when full
+    };
+
+    SessionWriter() = default;
+    ~SessionWriter();
+
+    SessionWriter(const SessionWriter&) = delete;
+    SessionWriter& operator=(const SessionWriter&) = delete;
+
+    /**
+     * Create (or truncate) a session file
+     * @return false if it cannot be created
+     */
+    bool Open(const char* path, const Options& options);
+    bool Open(const char* path) { return Open(path, Options()); }
+
+    /**
+     * Flush and close (idempotent)
+     */
+    void Close();
+
+    bool IsOpen() const { return fd_ >= 0; }
+
+    /**
+     * Record the state at timeNs (EncodeWire() + RecordWire())
+     * @return false on I/O error
+     */
+    bool Record(const AppState& state, uint64_t timeNs);
+
+    /**
+     * Record a wire snapshot; a keyframe if one is due, else a delta
+     * against the previous snapshot, or nothing if nothing changed
+     */
+    bool RecordWire(const WireVehicleState& wire, uint64_t timeNs);
+
+    /**
+     * Write buffered records to the file
+     */
+    bool Flush();
+
+    uint64_t GetKeyframeCount() const { return keyframes_; }
+    uint64_t GetDeltaCount() const { return deltas_; }
+    uint64_t GetBytesWritten() const { return bytes_; }            // Including the buffer
+
+private:
+    bool Append(const WireVehicleState& wire, uint64_t timeNs, uint32_t fields, SessionRecordKind kind);
+
+    int fd_ = -1;
+    Options options_;
+    std::vector<uint8_t> buffer_;
+    WireVehicleState last_;
+    bool hasLast_ = false;
+    uint64_t lastTimeNs_ = 0;
+    uint64_t keyframeTimeNs_ = 0;
+    uint32_t sinceKeyframe_ = 0;
+    uint64_t keyframes_ = 0;
+    uint64_t deltas_ = 0;
+    uint64_t bytes_ = 0;
+};
+
+/**
+ * Visitor for SessionReader::Scan(): the state after each record
+ * @return false to stop the scan
+ */
+using SessionRecordVisitor = bool (*)(uint64_t timeNs, const WireVehicleState& state, void* userData);
+
+/**
+ * Random access to a recorded session (POSIX)
+ *
+ * Open() maps the file read-only and builds a keyframe index (time, file
+ * offset) from the record headers. Seek(t) binary-searches the last keyframe
+ * at or before t and applies the k deltas between it and t, so any instant
+ * is reconstructed in O(log n + k) with k bounded by the GOP length. Seeking
+ * forward inside the same GOP continues from the previous result, so
+ * playback applies one delta per recorded frame.
+ *
+ * Refresh() picks up records appended since Open(), so a session can be
+ * scrubbed while it is still being recorded.
+ */
+class SessionReader {
+public:
+    struct Keyframe {
+        uint64_t timeNs;
+        uint64_t offset;        // Of the record header
+    };
+
+    SessionReader() = default;
+    ~SessionReader();
+
+    SessionReader(const SessionReader&) = delete;
+    SessionReader& operator=(const SessionReader&) = delete;
+
+    /**
+     * @return false if the file cannot be mapped or is not a session file
+     *         with this build's wire layout
+     */
+    bool Open(const char* path);
+    void Close();
+    bool IsOpen() const { return fd_ >= 0; }
+
+    /**
+     * Index records appended since the last Open() / Refresh()
+     * @return false if the file could not be remapped
+     */
+    bool Refresh();
+
+    bool IsEmpty() const { return keyframes_.empty(); }
+    uint64_t GetStartNs() const { return keyframes_.empty() ? 0 : keyframes_.front().timeNs; }
+    uint64_t GetEndNs() const { return endNs_; }
+    uint64_t GetRecordCount() const { return records_; }
+    uint64_t GetSize() const { return indexedEnd_; }               // Bytes up to the last valid record
+    const std::vector<Keyframe>& GetKeyframes() const { return keyframes_; }
+
+    /**
+     * Times of the records with faults present that are keyframes or
+     * changed the fault list, ascending (for timeline markers)
+     */
+    const std::vector<uint64_t>& GetFaultTimes() const { return faultTimes_; }
+
+    /**
+     * State as of timeNs (the last record at or before it)
+     *
+     * @param appliedDeltas Optional: deltas applied by this call
+     * @return nullptr if timeNs is before the first record; otherwise valid
+     *         until the next Seek(), Refresh() or Close()
+     */
+    const WireVehicleState* Seek(uint64_t timeNs, uint32_t* appliedDeltas = nullptr);
+
+    /**
+     * Visit every indexed record in order, one delta applied per record
+     * (exports). Resets the Seek() cursor.
+     * @return false if the visitor stopped the scan
+     */
+    bool Scan(SessionRecordVisitor visitor, void* userData);
+
+private:
+    const SessionRecordHeader* HeaderAt(uint64_t offset) const {
+        return reinterpret_cast<const SessionRecordHeader*>(map_ + offset);
+    }
+    bool ApplyDelta(const SessionRecordHeader& header);
+
+    int fd_ = -1;
+    const uint8_t* map_ = nullptr;
+    size_t mapLength_ = 0;
+    uint64_t indexedEnd_ = 0;       // Offset after the last valid record
+    uint64_t endNs_ = 0;
+    uint64_t records_ = 0;
+    std::vector<Keyframe> keyframes_;
+    std::vector<uint64_t> faultTimes_;
+
+    // Seek cursor: the state after the record before nextOffset_
+    WireVehicleState current_;
+    WireVehicleState patch_;
+    size_t cursorKeyframe_ = SIZE_MAX;
+    uint64_t cursorTimeNs_ = 0;
+    uint64_t nextOffset_ = 0;
+};
+
+/**
+ * Write a wire snapshot into AppState's dashboard fields
+ *
+ * The fault set is rebuilt only when the wire faults differ from the
+ * state's current ones (WireMatches() comparison), with each fault's
+ * first-seen time from the snapshot.
+ */
+void ApplyWireToState(const WireVehicleState& wire, AppState& state);
+
+/**
+ * Time-travel view of a recorded session for the dashboard
+ *
+ * While active, RenderUI() draws the dashboard from this object's own
+ * AppState, reconstructed for GetTime(), and shows a timeline bar to scrub,
+ * play and return to live. The live AppState keeps being updated underneath.
+ *
+ * @code
+ *   static ui::SessionPlayback playback;
+ *   if (playback.Open("session.rec")) {
+ *       state.playback = &playback;
+ *       playback.SetActive(true);
+ *   }
+ * @endcode
+ */
+class SessionPlayback {
+public:
+    SessionPlayback();
+
+    bool Open(const char* path);
+    void Close();
+
+    SessionReader& GetReader() { return reader_; }
+    const SessionReader& GetReader() const { return reader_; }
+
+    bool IsActive() const { return active_ && reader_.IsOpen() && !reader_.IsEmpty(); }
+    void SetActive(bool active) { active_ = active; }
+
+    /**
+     * Playback position, clamped to the recording
+     */
+    uint64_t GetTime() const { return timeNs_; }
+    void SetTime(uint64_t timeNs);
+
+    bool IsPlaying() const { return playing_; }
+    void SetPlaying(bool playing) { playing_ = playing; }
+    float GetRate() const { return rate_; }
+    void SetRate(float rate) { rate_ = rate; }
+
+    /**
+     * Move the position by elapsedNs * rate while playing; stops at the end
+     */
+    void Advance(uint64_t elapsedNs);
+
+    /**
+     * Pick up records appended by a recorder still writing the file
+     * Refreshes the reader at most once per second; call once per frame.
+     */
+    void Poll(uint64_t nowNs);
+
+    /**
+     * The AppState to render for the current position
+     * Seeks if the position moved, rewrites the dashboard fields, and takes
+     * the presentation attachments (layout, pacer, budgets, worker pool)
+     * from the live state. Cells, signal interpolation and freshness are not
+     * recorded and stay detached, so nothing greys out during playback.
+     */
+    AppState& Resolve(const AppState& live);
+
+    uint32_t GetLastSeekDeltas() const { return lastSeekDeltas_; }
+
+private:
+    SessionReader reader_;
+    AppState view_;
+    const WireVehicleState* wire_ = nullptr;
+    uint64_t timeNs_ = 0;
+    uint64_t resolvedNs_ = UINT64_MAX;
+    float rate_ = 1.0f;
+    bool active_ = false;
+    bool playing_ = false;
+    uint32_t lastSeekDeltas_ = 0;
+    uint64_t refreshNs_ = 0;
+};
+
+} // namespace ui
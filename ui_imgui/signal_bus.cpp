@@ -0,0 +1,281 @@
+#include "signal_bus.h"
+#include "signal_freshness.h"
+#include "signal_interp.h"
+#include "monotonic_clock.h"
+#include <cmath>
+#include <cstring>
+
+namespace ui {
+
+// Counters have a single writer (the producer or consumer thread), so a
+// relaxed load/store pair is enough and keeps lock-prefixed instructions
+// off the publish path
+static inline void Bump(std::atomic<uint64_t>& counter, uint64_t n = 1) {
+    counter.store(counter.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+}
+
+void BusProducer::Deliver(Route& route, const SignalUpdate& update) {
+    if (route.ring->Push(update)) {
+        Bump(delivered_);
+    } else {
+        Bump(dropped_);
+    }
+}
+
+void BusProducer::PublishUpdate(const SignalUpdate& update) {
+    Bump(published_);
+    if (update.signal >= ranges_.size()) return;
+
+    const RouteRange& range = ranges_[update.signal];
+    for (uint32_t i = range.first; i < range.first + range.count; i++) {
+        Route& route = routes_[i];
+        if (route.intervalNs == 0) {
+            Deliver(route, update);
+            continue;
+        }
+        if (update.timeNs < route.nextNs) {
+            route.held = update;
+            route.hasHeld = true;
+            Bump(decimated_);
+            continue;
+        }
+        // Keep the slots evenly spaced while the signal changes faster than
+        // the limit; restart the grid after a quiet period
+        bool onGrid = update.timeNs - route.nextNs < route.intervalNs;
+        route.nextNs = (onGrid ? route.nextNs : update.timeNs) + route.intervalNs;
+        route.hasHeld = false;
+        Deliver(route, update);
+    }
+}
+
+void BusProducer::Flush(uint64_t nowNs) {
+    for (uint32_t index : limited_) {
+        Route& route = routes_[index];
+        if (!route.hasHeld || nowNs < route.nextNs) continue;
+        route.nextNs += route.intervalNs;
+        route.hasHeld = false;
+        Deliver(route, route.held);
+    }
+}
+
+BusProducerStats BusProducer::GetStats() const {
+    BusProducerStats stats;
+    stats.published = published_.load(std::memory_order_relaxed);
+    stats.delivered = delivered_.load(std::memory_order_relaxed);
+    stats.decimated = decimated_.load(std::memory_order_relaxed);
+    stats.dropped = dropped_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+size_t BusConsumer::Poll(SignalUpdate* out, size_t max) {
+    size_t total = 0;
+    size_t ringCount = rings_.size();
+    // Round-robin start so one busy producer cannot starve the others
+    for (size_t n = 0; n < ringCount && total < max; n++) {
+        SpscRing<SignalUpdate>* ring = rings_[(nextRing_ + n) % ringCount];
+        total += ring->PopBatch(out + total, max - total);
+    }
+    if (ringCount > 0) nextRing_ = (nextRing_ + 1) % ringCount;
+    if (total > 0) Bump(received_, total);
+    return total;
+}
+
+int SignalBus::RegisterSignal(const char* name, SignalType type) {
+    if (started_ || !name) return -1;
+    int existing = FindSignal(name);
+    if (existing >= 0) return signals_[existing].type == type ? existing : -1;
+    if (static_cast<int>(signals_.size()) >= kMaxSignals) return -1;
+    signals_.push_back({ name, type });
+    return static_cast<int>(signals_.size()) - 1;
+}
+
+int SignalBus::FindSignal(const char* name) const {
+    for (size_t i = 0; i < signals_.size(); i++) {
+        if (strcmp(signals_[i].name, name) == 0) return static_cast<int>(i);
+    }
+    return -1;
+}
+
+const char* SignalBus::GetSignalName(int index) const {
+    return index >= 0 && index < GetSignalCount() ? signals_[index].name : "";
+}
+
+SignalType SignalBus::GetSignalType(int index) const {
+    return index >= 0 && index < GetSignalCount() ? signals_[index].type : SignalType::Float;
+}
+
+BusProducer* SignalBus::AddProducer(const char* name) {
+    if (started_ || static_cast<int>(producers_.size()) >= kMaxProducers) return nullptr;
+    producers_.emplace_back(new BusProducer(name, static_cast<uint8_t>(producers_.size())));
+    return producers_.back().get();
+}
+
+BusConsumer* SignalBus::AddConsumer(const char* name, size_t ringCapacity) {
+    if (started_ || static_cast<int>(consumers_.size()) >= kMaxConsumers) return nullptr;
+    consumers_.emplace_back(new BusConsumer(name, ringCapacity));
+    return consumers_.back().get();
+}
+
+bool SignalBus::Subscribe(BusConsumer* consumer, int signal, float maxHz) {
+    if (started_ || !consumer || signal < 0 || signal >= GetSignalCount()) return false;
+    uint64_t intervalNs = maxHz > 0.0f ? static_cast<uint64_t>(std::llround(1e9 / maxHz)) : 0;
+    for (BusConsumer::Subscription& subscription : consumer->subscriptions_) {
+        if (subscription.signal == signal) {
+            subscription.intervalNs = intervalNs;
+            return true;
+        }
+    }
+    consumer->subscriptions_.push_back({ static_cast<uint16_t>(signal), intervalNs });
+    return true;
+}
+
+bool SignalBus::SubscribeAll(BusConsumer* consumer, float maxHz) {
+    if (started_ || !consumer) return false;
+    for (int i = 0; i < GetSignalCount(); i++) Subscribe(consumer, i, maxHz);
+    return true;
+}
+
+bool SignalBus::Start() {
+    if (started_) return false;
+    started_ = true;
+
+    for (std::unique_ptr<BusProducer>& producer : producers_) {
+        // A ring to every consumer that subscribed to anything
+        producer->rings_.resize(consumers_.size());
+        for (size_t c = 0; c < consumers_.size(); c++) {
+            BusConsumer& consumer = *consumers_[c];
+            if (consumer.subscriptions_.empty()) continue;
+            producer->rings_[c].reset(new SpscRing<SignalUpdate>(consumer.ringCapacity_));
+            consumer.rings_.push_back(producer->rings_[c].get());
+        }
+
+        // Routes grouped by signal, so Publish() walks one contiguous range
+        producer->ranges_.assign(signals_.size(), { 0, 0 });
+        for (size_t s = 0; s < signals_.size(); s++) {
+            BusProducer::RouteRange& range = producer->ranges_[s];
+            range.first = static_cast<uint32_t>(producer->routes_.size());
+            for (size_t c = 0; c < consumers_.size(); c++) {
+                for (const BusConsumer::Subscription& subscription : consumers_[c]->subscriptions_) {
+                    if (subscription.signal != s) continue;
+                    BusProducer::Route route = {};
+                    route.ring = producer->rings_[c].get();
+                    route.intervalNs = subscription.intervalNs;
+                    if (route.intervalNs > 0) {
+                        producer->limited_.push_back(static_cast<uint32_t>(producer->routes_.size()));
+                    }
+                    producer->routes_.push_back(route);
+                }
+            }
+            range.count = static_cast<uint32_t>(producer->routes_.size()) - range.first;
+        }
+    }
+    return true;
+}
+
+DashboardBusSignals RegisterDashboardBusSignals(SignalBus& bus) {
+    DashboardBusSignals s;
+    s.speed = bus.Register<float>("vehicle.speed");
+    s.gear = bus.Register<int32_t>("vehicle.gear");
+    s.mainSoc = bus.Register<float>("battery.main.soc");
+    s.mainVoltage = bus.Register<float>("battery.main.voltage");
+    s.mainCurrent = bus.Register<float>("battery.main.current");
+    s.suppSoc = bus.Register<float>("battery.supp.soc");
+    s.suppVoltage = bus.Register<float>("battery.supp.voltage");
+    s.cruiseEnabled = bus.Register<bool>("cruise.enabled");
+    s.cruiseSetSpeed = bus.Register<int32_t>("cruise.set_speed");
+    s.brakeEngaged = bus.Register<bool>("vehicle.brake");
+    s.contactorMain = bus.Register<bool>("contactor.main");
+    s.contactorPrecharge = bus.Register<bool>("contactor.precharge");
+    s.contactorHvil = bus.Register<bool>("contactor.hvil");
+    s.heartbeat = bus.Register<int32_t>("vehicle.heartbeat");
+    s.turnSignal = bus.Register<int32_t>("vehicle.turn_signal");
+    return s;
+}
+
+template <typename T>
+static bool Is(const SignalUpdate& update, SignalId<T> id) {
+    return update.signal == id.index && update.type == SignalTypeOf<T>::value;
+}
+
+bool ApplyBusUpdate(AppState& state, const DashboardBusSignals& s, const SignalUpdate& update, uint64_t arrivalNs) {
+    DashboardFeed feed = DashboardFeed_Count;
+    if (Is(update, s.speed)) {
+        float speed = update.Get<float>();
+        state.speed = static_cast<int>(std::lround(speed));
+        if (state.signals) state.signals->Push(DashboardSignal_Speed, update.timeNs, speed);
+        feed = DashboardFeed_Speed;
+    } else if (Is(update, s.gear)) {
+        int32_t gear = update.Get<int32_t>();
+        if (gear < 0 || gear > static_cast<int32_t>(Gear::Drive)) return false;
+        state.gear = static_cast<Gear>(gear);
+        feed = DashboardFeed_Gear;
+    } else if (Is(update, s.mainSoc)) {
+        state.mainBattery.soc = update.Get<float>();
+        if (state.signals) state.signals->Push(DashboardSignal_MainSoc, update.timeNs, state.mainBattery.soc);
+        feed = DashboardFeed_MainBattery;
+    } else if (Is(update, s.mainVoltage)) {
+        state.mainBattery.voltage = update.Get<float>();
+        feed = DashboardFeed_MainBattery;
+    } else if (Is(update, s.mainCurrent)) {
+        state.mainBattery.current = update.Get<float>();
+        feed = DashboardFeed_MainBattery;
+    } else if (Is(update, s.suppSoc)) {
+        state.suppBattery.soc = update.Get<float>();
+        if (state.signals) state.signals->Push(DashboardSignal_SuppSoc, update.timeNs, state.suppBattery.soc);
+        feed = DashboardFeed_SuppBattery;
+    } else if (Is(update, s.suppVoltage)) {
+        state.suppBattery.voltage = update.Get<float>();
+        feed = DashboardFeed_SuppBattery;
+    } else if (Is(update, s.cruiseEnabled)) {
+        state.cruise.enabled = update.Get<bool>();
+        feed = DashboardFeed_Cruise;
+    } else if (Is(update, s.cruiseSetSpeed)) {
+        state.cruise.setSpeed = update.Get<int32_t>();
+        feed = DashboardFeed_Cruise;
+    } else if (Is(update, s.brakeEngaged)) {
+        state.brakeEngaged = update.Get<bool>();
+        feed = DashboardFeed_Brake;
+    } else if (Is(update, s.contactorMain)) {
+        state.contactorStates.main = update.Get<bool>();
+        feed = DashboardFeed_Contactors;
+    } else if (Is(update, s.contactorPrecharge)) {
+        state.contactorStates.precharge = update.Get<bool>();
+        feed = DashboardFeed_Contactors;
+    } else if (Is(update, s.contactorHvil)) {
+        state.contactorStates.hvil = update.Get<bool>();
+        feed = DashboardFeed_Contactors;
+    } else if (Is(update, s.heartbeat)) {
+        // Touches the feed itself, only when the counter advanced
+        ObserveDashboardHeartbeat(state, static_cast<uint8_t>(update.Get<int32_t>()),
+                                  arrivalNs ? arrivalNs : update.timeNs);
+        return true;
+    } else if (Is(update, s.turnSignal)) {
+        int32_t turn = update.Get<int32_t>();
+        if (turn < 0 || turn > static_cast<int32_t>(TurnSignal::Right)) return false;
+        state.turnSignal = static_cast<TurnSignal>(turn);
+        feed = DashboardFeed_TurnSignal;
+    } else {
+        return false;
+    }
+    TouchDashboardFeed(state, feed, arrivalNs ? arrivalNs : update.timeNs);
+    return true;
+}
+
+size_t DrainBusUpdates(AppState& state, BusConsumer& consumer, const DashboardBusSignals& signals) {
+    const size_t kBatch = 256;
+    SignalUpdate batch[kBatch];
+    size_t applied = 0;
+    size_t count;
+    // A short batch means the rings were empty; stop there so producers that
+    // keep publishing cannot hold the frame
+    do {
+        count = consumer.Poll(batch, kBatch);
+        uint64_t arrivalNs = count > 0 && state.freshness ? MonotonicNowNs() : 0;
+        for (size_t i = 0; i < count; i++) {
+            if (ApplyBusUpdate(state, signals, batch[i], arrivalNs)) applied++;
+        }
+    } while (count == kBatch);
+    return applied;
+}
+
+} // namespace ui
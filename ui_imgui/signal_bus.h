@@ -0,0 +1,354 @@
+#pragma once
+
+#include "spsc_ring.h"
+#include "state.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace ui {
+
+/**
+ * Value types a bus signal can carry
+ */
+enum class SignalType : uint8_t {
+    Bool,
+    Int,        // int32_t
+    Float
+};
+
+template <typename T> struct SignalTypeOf;
+template <> struct SignalTypeOf<bool> { static constexpr SignalType value = SignalType::Bool; };
+template <> struct SignalTypeOf<int32_t> { static constexpr SignalType value = SignalType::Int; };
+template <> struct SignalTypeOf<float> { static constexpr SignalType value = SignalType::Float; };
+
+/**
+ * Handle of a registered signal; the type parameter is checked at compile
+ * time on Publish() and Get()
+ */
+template <typename T>
+struct SignalId {
+    static constexpr uint16_t kInvalid = 0xffff;
+    uint16_t index = kInvalid;
+
+    bool IsValid() const { return index != kInvalid; }
+};
+
+/**
+ * One value change as it travels through a ring (16 bytes)
+ */
+struct SignalUpdate {
+    uint64_t timeNs;            // Publisher's timestamp (MonotonicNowNs() unless it has a better one)
+    union {
+        float f;
+        int32_t i;
+        uint32_t b;
+    } value;
+    uint16_t signal;            // SignalId::index
+    SignalType type;
+    uint8_t producer;           // Index in AddProducer() order
+
+    template <typename T> T Get() const;
+};
+
+template <> inline bool SignalUpdate::Get<bool>() const { return value.b != 0; }
+template <> inline int32_t SignalUpdate::Get<int32_t>() const { return value.i; }
+template <> inline float SignalUpdate::Get<float>() const { return value.f; }
+
+static_assert(sizeof(SignalUpdate) == 16, "signal update should stay at 16 bytes");
+
+/**
+ * Producer counters (readable from any thread)
+ */
+struct BusProducerStats {
+    uint64_t published;         // Publish() calls
+    uint64_t delivered;         // Updates pushed to a consumer ring
+    uint64_t decimated;         // Held back by a subscriber's rate limit
+    uint64_t dropped;           // Consumer ring full
+};
+
+class SignalBus;
+
+/**
+ * Publishing side of one producer thread (CAN decode, camera, simulator,
+ * rule engine, ...)
+ *
+ * Publish() looks up the subscribers of the signal in a table built by
+ * SignalBus::Start() and pushes the update into each subscriber's SPSC
+ * ring. No locks, no allocation; a full ring drops the update for that
+ * subscriber and counts it. Only one thread may publish through a producer.
+ */
+class BusProducer {
+public:
+    template <typename T>
+    void Publish(SignalId<T> id, T value, uint64_t timeNs) {
+        SignalUpdate update;
+        update.timeNs = timeNs;
+        update.value.b = 0;
+        Assign(update, value);
+        update.signal = id.index;
+        update.type = SignalTypeOf<T>::value;
+        update.producer = index_;
+        PublishUpdate(update);
+    }
+
+    /**
+     * Deliver held-back values of rate-limited subscriptions whose interval
+     * has passed (so the last value before a signal goes quiet still
+     * arrives). Call from the producer thread, e.g. once per loop.
+     */
+    void Flush(uint64_t nowNs);
+
+    const char* GetName() const { return name_; }
+    int GetIndex() const { return index_; }
+    BusProducerStats GetStats() const;
+
+private:
+    friend class SignalBus;
+
+    // One subscriber of one signal
+    struct Route {
+        SpscRing<SignalUpdate>* ring;
+        uint64_t intervalNs;    // 0 = every update
+        uint64_t nextNs;        // Earliest time the next update may go out
+        SignalUpdate held;      // Latest value held back by the rate limit
+        bool hasHeld;
+    };
+
+    struct RouteRange {
+        uint32_t first;
+        uint32_t count;
+    };
+
+    BusProducer(const char* name, uint8_t index) : name_(name), index_(index) {}
+
+    static void Assign(SignalUpdate& update, bool value) { update.value.b = value ? 1u : 0u; }
+    static void Assign(SignalUpdate& update, int32_t value) { update.value.i = value; }
+    static void Assign(SignalUpdate& update, float value) { update.value.f = value; }
+
+    void PublishUpdate(const SignalUpdate& update);
+    void Deliver(Route& route, const SignalUpdate& update);
+
+    const char* name_;
+    uint8_t index_;
+    std::vector<std::unique_ptr<SpscRing<SignalUpdate>>> rings_;   // One per consumer (nullptr = not subscribed)
+    std::vector<RouteRange> ranges_;                               // Per signal, into routes_
+    std::vector<Route> routes_;
+    std::vector<uint32_t> limited_;                                // Routes with a rate limit (for Flush)
+
+    std::atomic<uint64_t> published_{0};
+    std::atomic<uint64_t> delivered_{0};
+    std::atomic<uint64_t> decimated_{0};
+    std::atomic<uint64_t> dropped_{0};
+};
+
+/**
+ * Receiving side of one consumer thread (UI state, recorder, network
+ * bridge, ...)
+ *
+ * Reads its rings from all producers round-robin. Full-rate updates from
+ * one producer arrive in publish order; there is no order between
+ * producers, and a value held back by a rate limit arrives later with its
+ * original timestamp, so compare timeNs when that matters. Only one thread
+ * may poll a consumer.
+ */
+class BusConsumer {
+public:
+    /**
+     * Take up to max updates
+     * @return Number written to out (0 = nothing pending)
+     */
+    size_t Poll(SignalUpdate* out, size_t max);
+
+    const char* GetName() const { return name_; }
+    uint64_t GetReceived() const { return received_.load(std::memory_order_relaxed); }
+
+private:
+    friend class SignalBus;
+
+    struct Subscription {
+        uint16_t signal;
+        uint64_t intervalNs;
+    };
+
+    BusConsumer(const char* name, size_t ringCapacity) : name_(name), ringCapacity_(ringCapacity) {}
+
+    const char* name_;
+    size_t ringCapacity_;
+    std::vector<Subscription> subscriptions_;
+    std::vector<SpscRing<SignalUpdate>*> rings_;    // Filled by Start()
+    size_t nextRing_ = 0;
+    std::atomic<uint64_t> received_{0};
+};
+
+/**
+ * Typed publish / subscribe signal bus
+ *
+ * Setup happens on one thread before Start(): register signals, add
+ * producers and consumers, and subscribe consumers to signals, optionally
+ * rate-limited (maxHz). Start() creates one SPSC ring per producer /
+ * consumer pair that has something to carry and freezes the topology.
+ * After that, producers publish and consumers poll on their own threads
+ * with no shared locks.
+ *
+ * A rate-limited subscription receives at most maxHz updates per second of
+ * a signal (by the updates' timestamps), spaced evenly while the signal
+ * changes faster; the newest held-back value goes out on the next update or
+ * BusProducer::Flush() once its slot comes up.
+ *
+ * @code
+ *   ui::SignalBus bus;
+ *   ui::DashboardBusSignals signals = ui::RegisterDashboardBusSignals(bus);
+ *   ui::BusProducer* can = bus.AddProducer("can");
+ *   ui::BusConsumer* uiState = bus.AddConsumer("ui");
+ *   ui::BusConsumer* bridge = bus.AddConsumer("bridge");
+ *   bus.SubscribeAll(uiState);
+ *   bus.SubscribeAll(bridge, 10.0f);
+ *   bus.Start();
+ *
+ *   // CAN thread:
+ *   can->Publish(signals.speed, 87.5f, ui::MonotonicNowNs());
+ *
+ *   // Render thread, before RenderUI():
+ *   ui::DrainBusUpdates(state, *uiState, signals);
+ * @endcode
+ */
+class SignalBus {
+public:
+    static constexpr int kMaxSignals = 1024;
+    static constexpr int kMaxProducers = 16;
+    static constexpr int kMaxConsumers = 16;
+    static constexpr size_t kDefaultRingCapacity = 65536;
+
+    SignalBus() = default;
+    SignalBus(const SignalBus&) = delete;
+    SignalBus& operator=(const SignalBus&) = delete;
+
+    /**
+     * Register a signal (before Start())
+     * @return Invalid id if the name is taken with another type, the table is
+     *         full or the bus has started; the existing id if the name is
+     *         already registered with this type
+     */
+    template <typename T>
+    SignalId<T> Register(const char* name) {
+        SignalId<T> id;
+        int index = RegisterSignal(name, SignalTypeOf<T>::value);
+        if (index >= 0) id.index = static_cast<uint16_t>(index);
+        return id;
+    }
+
+    /**
+     * @return Signal index, or -1
+     */
+    int FindSignal(const char* name) const;
+    int GetSignalCount() const { return static_cast<int>(signals_.size()); }
+    const char* GetSignalName(int index) const;
+    SignalType GetSignalType(int index) const;
+
+    /**
+     * @param name Must outlive the bus
+     * @return nullptr if there are too many or the bus has started
+     */
+    BusProducer* AddProducer(const char* name);
+
+    /**
+     * @param name         Must outlive the bus
+     * @param ringCapacity Updates each producer can queue before this
+     *                     consumer polls (rounded up to a power of two)
+     */
+    BusConsumer* AddConsumer(const char* name, size_t ringCapacity = kDefaultRingCapacity);
+
+    /**
+     * Subscribe a consumer to one signal (before Start())
+     *
+     * @param maxHz Rate limit (0 = every update)
+     * @return false if the signal is unknown or the bus has started
+     */
+    bool Subscribe(BusConsumer* consumer, int signal, float maxHz = 0.0f);
+
+    template <typename T>
+    bool Subscribe(BusConsumer* consumer, SignalId<T> id, float maxHz = 0.0f) {
+        return id.IsValid() && Subscribe(consumer, static_cast<int>(id.index), maxHz);
+    }
+
+    /**
+     * Subscribe to every signal registered so far
+     */
+    bool SubscribeAll(BusConsumer* consumer, float maxHz = 0.0f);
+
+    /**
+     * Create the rings and routing tables; no setup calls after this
+     * @return false if already started
+     */
+    bool Start();
+    bool IsStarted() const { return started_; }
+
+    int GetProducerCount() const { return static_cast<int>(producers_.size()); }
+    int GetConsumerCount() const { return static_cast<int>(consumers_.size()); }
+    BusProducer* GetProducer(int index) { return producers_[index].get(); }
+    BusConsumer* GetConsumer(int index) { return consumers_[index].get(); }
+
+private:
+    struct SignalInfo {
+        const char* name;
+        SignalType type;
+    };
+
+    int RegisterSignal(const char* name, SignalType type);
+
+    std::vector<SignalInfo> signals_;
+    std::vector<std::unique_ptr<BusProducer>> producers_;
+    std::vector<std::unique_ptr<BusConsumer>> consumers_;
+    bool started_ = false;
+};
+
+/**
+ * Bus signals for the AppState fields the dashboard shows
+ */
+struct DashboardBusSignals {
+    SignalId<float> speed;                  // km/h
+    SignalId<int32_t> gear;                 // Gear as int
+    SignalId<float> mainSoc;
+    SignalId<float> mainVoltage;
+    SignalId<float> mainCurrent;
+    SignalId<float> suppSoc;
+    SignalId<float> suppVoltage;
+    SignalId<bool> cruiseEnabled;
+    SignalId<int32_t> cruiseSetSpeed;
+    SignalId<bool> brakeEngaged;
+    SignalId<bool> contactorMain;
+    SignalId<bool> contactorPrecharge;
+    SignalId<bool> contactorHvil;
+    SignalId<int32_t> heartbeat;
+    SignalId<int32_t> turnSignal;           // TurnSignal as int
+};
+
+/**
+ * Register the dashboard's signals ("vehicle.speed", "battery.main.soc", ...)
+ */
+DashboardBusSignals RegisterDashboardBusSignals(SignalBus& bus);
+
+/**
+ * Write one update into its AppState field; speed and SOC updates are also
+ * pushed to state.signals (if attached) with the update's timestamp, and
+ * the field's DashboardFeed is touched in state.freshness (if attached)
+ *
+ * @param arrivalNs Receive time on the MonotonicNowNs() clock for freshness
+ *                  (0 = the update's own timestamp)
+ * @return false if the update is not a dashboard signal
+ */
+bool ApplyBusUpdate(AppState& state, const DashboardBusSignals& signals, const SignalUpdate& update,
+                    uint64_t arrivalNs = 0);
+
+/**
+ * Poll a consumer until its rings are empty and apply every update
+ * Stops at the first short batch, so it returns even while producers keep
+ * publishing.
+ *
+ * @return Number of updates applied
+ */
+size_t DrainBusUpdates(AppState& state, BusConsumer& consumer, const DashboardBusSignals& signals);
+
+} // namespace ui
@@ -0,0 +1,191 @@
+#include "signal_freshness.h"
+#include <cstdint>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define UI_FRESHNESS_SSE2 1
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define UI_FRESHNESS_NEON 1
+#endif
+
+namespace ui {
+
+bool HeartbeatMonitor::Observe(uint8_t counter, uint64_t arrivalNs) {
+    if (!hasLast_) {
+        hasLast_ = true;
+        last_ = counter;
+        lastBeatNs_ = arrivalNs;
+        stats_.beats++;
+        return true;
+    }
+
+    uint8_t delta = static_cast<uint8_t>(counter - last_);
+    if (delta == 0) {
+        stats_.repeats++;
+        return false;
+    }
+    if (delta >= 128) {
+        stats_.resets++;
+    } else if (delta > 1) {
+        stats_.gaps++;
+        stats_.missed += delta - 1u;
+        lastGapNs_ = arrivalNs;
+    }
+
+    if (arrivalNs > lastBeatNs_ && arrivalNs - lastBeatNs_ > stats_.maxIntervalNs) {
+        stats_.maxIntervalNs = arrivalNs - lastBeatNs_;
+    }
+    stats_.beats++;
+    last_ = counter;
+    lastBeatNs_ = arrivalNs;
+    return true;
+}
+
+void HeartbeatMonitor::Reset() {
+    *this = HeartbeatMonitor();
+}
+
+FreshnessMonitor::FreshnessMonitor() {
+    for (int i = 0; i < kMaxSignals; i++) {
+        deadlineNs_[i] = INT64_MAX;
+        lastNs_[i] = 0;
+        periodNs_[i] = 0;
+        staleAfterNs_[i] = 0;
+        updates_[i] = 0;
+        late_[i] = 0;
+        names_[i] = "";
+    }
+    for (uint64_t& word : stale_) word = 0;
+}
+
+int FreshnessMonitor::AddSignal(const char* name, uint64_t expectedPeriodNs, float stalePeriods) {
+    if (count_ >= kMaxSignals || expectedPeriodNs == 0) return -1;
+    int signal = count_++;
+    names_[signal] = name ? name : "";
+    periodNs_[signal] = expectedPeriodNs;
+    staleAfterNs_[signal] = static_cast<uint64_t>(static_cast<double>(expectedPeriodNs) * stalePeriods);
+    deadlineNs_[signal] = 0;                        // Stale until the first update
+    stale_[signal >> 6] |= uint64_t(1) << (signal & 63);
+    intervals_[signal].reset(new LogHistogram());
+    return signal;
+}
+
+void FreshnessMonitor::Touch(int signal, uint64_t arrivalNs) {
+    if (signal < 0 || signal >= count_) return;
+    uint64_t last = lastNs_[signal];
+    updates_[signal]++;
+    if (arrivalNs < last) return;                   // Older than what we have
+
+    if (last != 0) {
+        uint64_t interval = arrivalNs - last;
+        intervals_[signal]->Record(interval);
+        if (interval * 2 > periodNs_[signal] * 3) late_[signal]++;
+    }
+    lastNs_[signal] = arrivalNs;
+    deadlineNs_[signal] = static_cast<int64_t>(arrivalNs + staleAfterNs_[signal]);
+}
+
+bool FreshnessMonitor::SweepScalar(uint64_t nowNs) {
+    int64_t now = static_cast<int64_t>(nowNs);
+    bool changed = false;
+    for (int word = 0; word * 64 < count_; word++) {
+        uint64_t bits = 0;
+        for (int bit = 0; bit < 64 && word * 64 + bit < count_; bit++) {
+            if (now > deadlineNs_[word * 64 + bit]) bits |= uint64_t(1) << bit;
+        }
+        changed |= bits != stale_[word];
+        stale_[word] = bits;
+    }
+    return changed;
+}
+
+bool FreshnessMonitor::Sweep(uint64_t nowNs) {
+#if defined(UI_FRESHNESS_SSE2) || defined(UI_FRESHNESS_NEON)
+    // Deadlines and now are both in [0, 2^63), so deadline - now cannot
+    // overflow and its sign bit is exactly now > deadline; four signals per
+    // iteration. Slots past count_ hold INT64_MAX and never set a bit, so the
+    // loop runs to the next multiple of four without a tail.
+    int64_t now = static_cast<int64_t>(nowNs);
+    uint64_t bits[kMaskWords] = {};
+#if defined(UI_FRESHNESS_SSE2)
+    const __m128i vnow = _mm_set1_epi64x(now);
+    for (int i = 0; i < count_; i += 4) {
+        __m128i lo = _mm_sub_epi64(_mm_load_si128(reinterpret_cast<const __m128i*>(deadlineNs_ + i)), vnow);
+        __m128i hi = _mm_sub_epi64(_mm_load_si128(reinterpret_cast<const __m128i*>(deadlineNs_ + i + 2)), vnow);
+        uint64_t quad = static_cast<uint64_t>(_mm_movemask_pd(_mm_castsi128_pd(lo)) |
+                                              (_mm_movemask_pd(_mm_castsi128_pd(hi)) << 2));
+        bits[i >> 6] |= quad << (i & 63);
+    }
+#else
+    const int64x2_t vnow = vdupq_n_s64(now);
+    for (int i = 0; i < count_; i += 4) {
+        uint64x2_t lo = vshrq_n_u64(vreinterpretq_u64_s64(vsubq_s64(vld1q_s64(deadlineNs_ + i), vnow)), 63);
+        uint64x2_t hi = vshrq_n_u64(vreinterpretq_u64_s64(vsubq_s64(vld1q_s64(deadlineNs_ + i + 2), vnow)), 63);
+        uint64_t quad = vgetq_lane_u64(lo, 0) | (vgetq_lane_u64(lo, 1) << 1) |
+                        (vgetq_lane_u64(hi, 0) << 2) | (vgetq_lane_u64(hi, 1) << 3);
+        bits[i >> 6] |= quad << (i & 63);
+    }
+#endif
+    bool changed = false;
+    for (int word = 0; word < kMaskWords; word++) {
+        changed |= bits[word] != stale_[word];
+        stale_[word] = bits[word];
+    }
+    return changed;
+#else
+    return SweepScalar(nowNs);
+#endif
+}
+
+int FreshnessMonitor::GetStaleCount() const {
+    int count = 0;
+    for (uint64_t word : stale_) {
+        for (; word; word &= word - 1) count++;
+    }
+    return count;
+}
+
+void FreshnessMonitor::Reset() {
+    for (int i = 0; i < count_; i++) {
+        deadlineNs_[i] = 0;
+        lastNs_[i] = 0;
+        updates_[i] = 0;
+        late_[i] = 0;
+        intervals_[i]->Clear();
+        stale_[i >> 6] |= uint64_t(1) << (i & 63);
+    }
+    heartbeat_.Reset();
+}
+
+bool AddDashboardFeeds(FreshnessMonitor& monitor, uint64_t expectedPeriodNs, float stalePeriods) {
+    static const char* const kFeedNames[DashboardFeed_Count] = {
+        "speed", "gear", "battery.main", "battery.supp", "cruise",
+        "brake", "contactors", "turn_signal", "heartbeat", "cells",
+    };
+    if (monitor.GetSignalCount() != 0) return false;
+    for (int i = 0; i < DashboardFeed_Count; i++) {
+        if (monitor.AddSignal(kFeedNames[i], expectedPeriodNs, stalePeriods) != i) return false;
+    }
+    return true;
+}
+
+void TouchDashboardFeed(AppState& state, DashboardFeed feed, uint64_t arrivalNs) {
+    if (state.freshness) state.freshness->Touch(feed, arrivalNs);
+}
+
+void TouchDashboardFeeds(AppState& state, uint64_t arrivalNs) {
+    if (!state.freshness) return;
+    for (int i = 0; i < DashboardFeed_Count; i++) {
+        if (i != DashboardFeed_Heartbeat) state.freshness->Touch(i, arrivalNs);
+    }
+}
+
+void ObserveDashboardHeartbeat(AppState& state, uint8_t counter, uint64_t arrivalNs) {
+    state.heartbeat = counter;
+    if (state.freshness && state.freshness->GetHeartbeat().Observe(counter, arrivalNs)) {
+        state.freshness->Touch(DashboardFeed_Heartbeat, arrivalNs);
+    }
+}
+
+} // namespace ui
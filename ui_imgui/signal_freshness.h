@@ -0,0 +1,182 @@
+#pragma once
+
+#include "log_histogram.h"
+#include "state.h"
+#include <cstdint>
+#include <memory>
+
+namespace ui {
+
+/**
+ * Heartbeat counter statistics
+ */
+struct HeartbeatStats {
+    uint64_t beats = 0;             // Counter advanced
+    uint64_t gaps = 0;              // Advanced by more than one
+    uint64_t missed = 0;            // Counter values skipped over all gaps
+    uint64_t repeats = 0;           // Same value again (sender alive, counter frozen)
+    uint64_t resets = 0;            // Went backwards (sender restarted)
+    uint64_t maxIntervalNs = 0;     // Longest time between two beats
+};
+
+/**
+ * Wrap-aware gap detection on an 8-bit heartbeat counter
+ *
+ * The counter advances by one per beat and wraps 255 -> 0. Observe() looks
+ * at the difference modulo 256: 1 is a beat, 2..127 a gap with the values in
+ * between missed, 0 a repeat, and 128..255 a step backwards (the sender
+ * restarted). Call it for every received counter value, not once per frame,
+ * or beats arriving between two frames show up as gaps.
+ */
+class HeartbeatMonitor {
+public:
+    /**
+     * @return true if the counter advanced (a beat, possibly after a gap)
+     */
+    bool Observe(uint8_t counter, uint64_t arrivalNs);
+
+    bool HasBeat() const { return hasLast_; }
+    uint8_t GetLastCounter() const { return last_; }
+    uint64_t GetLastBeatNs() const { return lastBeatNs_; }
+    uint64_t GetLastGapNs() const { return lastGapNs_; }   // Arrival of the last beat after a gap (0 = none)
+    const HeartbeatStats& GetStats() const { return stats_; }
+    void Reset();
+
+private:
+    bool hasLast_ = false;
+    uint8_t last_ = 0;
+    uint64_t lastBeatNs_ = 0;
+    uint64_t lastGapNs_ = 0;
+    HeartbeatStats stats_;
+};
+
+/**
+ * Per-signal freshness: last update times, expected periods, staleness and
+ * inter-arrival histograms
+ *
+ * Each signal has an expected update period; it is stale once nothing has
+ * arrived for stalePeriods periods (and before its first update). Touch()
+ * stores the arrival time and its deadline in flat arrays; Sweep() compares
+ * the deadlines of all signals against the current time with SSE2 / NEON,
+ * four signals per iteration, into a bit mask, so checking every signal every
+ * frame costs next to nothing. IsStale() reads the mask from the last Sweep().
+ *
+ * Every Touch() also records the interval since the previous update in the
+ * signal's LogHistogram, so jitter shows as the spread between its p50 and
+ * p99, and counts late updates (interval over 1.5 periods).
+ *
+ * Single-threaded: touch, sweep and read from the thread that applies
+ * updates to the state (normally the render thread).
+ *
+ * @code
+ *   static ui::FreshnessMonitor freshness;
+ *   ui::AddDashboardFeeds(freshness, 100000000);      // 100 ms telemetry
+ *   state.freshness = &freshness;
+ *   // DrainBusUpdates() / UpdateSimulation() touch the feeds; RenderUI()
+ *   // sweeps and the panels grey out stale values.
+ * @endcode
+ */
+class FreshnessMonitor {
+public:
+    static constexpr int kMaxSignals = 256;
+
+    FreshnessMonitor();
+    FreshnessMonitor(const FreshnessMonitor&) = delete;
+    FreshnessMonitor& operator=(const FreshnessMonitor&) = delete;
+
+    /**
+     * @param name             Must outlive the monitor
+     * @param expectedPeriodNs Interval the source sends at
+     * @param stalePeriods     Periods without an update before it is stale
+     * @return Signal index, or -1 if full or the period is 0
+     */
+    int AddSignal(const char* name, uint64_t expectedPeriodNs, float stalePeriods = 5.0f);
+
+    /**
+     * A new value of the signal arrived (MonotonicNowNs() clock)
+     */
+    void Touch(int signal, uint64_t arrivalNs);
+
+    /**
+     * Recompute the stale mask for nowNs
+     * @return true if any signal changed between fresh and stale
+     */
+    bool Sweep(uint64_t nowNs);
+
+    /** Scalar reference for Sweep() (same result, for checks and benchmarks) */
+    bool SweepScalar(uint64_t nowNs);
+
+    bool IsStale(int signal) const {
+        return signal >= 0 && signal < count_ && ((stale_[signal >> 6] >> (signal & 63)) & 1) != 0;
+    }
+    int GetStaleCount() const;
+
+    int GetSignalCount() const { return count_; }
+    const char* GetSignalName(int signal) const { return names_[signal]; }
+    uint64_t GetExpectedPeriodNs(int signal) const { return periodNs_[signal]; }
+    uint64_t GetLastUpdateNs(int signal) const { return lastNs_[signal]; }     // 0 = never
+    uint64_t GetUpdateCount(int signal) const { return updates_[signal]; }
+    uint64_t GetLateCount(int signal) const { return late_[signal]; }
+
+    /** Inter-arrival intervals of one signal, in ns */
+    const LogHistogram& GetIntervals(int signal) const { return *intervals_[signal]; }
+
+    HeartbeatMonitor& GetHeartbeat() { return heartbeat_; }
+    const HeartbeatMonitor& GetHeartbeat() const { return heartbeat_; }
+
+    /**
+     * Forget all updates (signals stay registered and become stale)
+     */
+    void Reset();
+
+private:
+    static constexpr int kMaskWords = kMaxSignals / 64;
+
+    // Deadlines are signed so the SIMD sweep can subtract them as int64;
+    // monotonic timestamps stay far below 2^63
+    alignas(64) int64_t deadlineNs_[kMaxSignals];  // Stale after this (INT64_MAX = unused slot)
+    uint64_t stale_[kMaskWords];
+    uint64_t lastNs_[kMaxSignals];
+    uint64_t periodNs_[kMaxSignals];
+    uint64_t staleAfterNs_[kMaxSignals];
+    uint64_t updates_[kMaxSignals];
+    uint64_t late_[kMaxSignals];
+    const char* names_[kMaxSignals];
+    std::unique_ptr<LogHistogram> intervals_[kMaxSignals];
+    int count_ = 0;
+    HeartbeatMonitor heartbeat_;
+};
+
+/**
+ * Add the DashboardFeed entries, in enum order, all with the same period
+ * Call once on an empty monitor before attaching it to AppState::freshness.
+ *
+ * @return false if the monitor already had signals
+ */
+bool AddDashboardFeeds(FreshnessMonitor& monitor, uint64_t expectedPeriodNs, float stalePeriods = 5.0f);
+
+/**
+ * Mark one dashboard feed updated (no-op without state.freshness)
+ */
+void TouchDashboardFeed(AppState& state, DashboardFeed feed, uint64_t arrivalNs);
+
+/**
+ * Mark every feed except the heartbeat updated, for sources that write the
+ * whole state at once (simulator, mirrored state)
+ */
+void TouchDashboardFeeds(AppState& state, uint64_t arrivalNs);
+
+/**
+ * Store a received heartbeat counter in the state; with state.freshness,
+ * run gap detection and touch DashboardFeed_Heartbeat when it advanced
+ */
+void ObserveDashboardHeartbeat(AppState& state, uint8_t counter, uint64_t arrivalNs);
+
+/**
+ * @return true if a freshness monitor is attached and the feed is stale
+ */
+inline bool IsFeedStale(const AppState& state, DashboardFeed feed) {
+    return state.freshness && state.freshness->IsStale(feed);
+}
+
+} // namespace ui
@@ -0,0 +1,159 @@
+#include "signal_interp.h"
+#include <algorithm>
+#include <cmath>
+
+namespace ui {
+
+static_assert((SignalInterpolator::kHistory & (SignalInterpolator::kHistory - 1)) == 0,
+              "kHistory must be a power of two");
+
+static constexpr int kHistoryMask = SignalInterpolator::kHistory - 1;
+static constexpr int64_t kClockRelaxNsPerSecond = 1000000;   // 1 ms/s
+static constexpr float kMaxStepSeconds = 0.1f;               // Spring step clamp after a stall
+
+static uint64_t SecondsToNs(float seconds) {
+    return seconds > 0.0f ? static_cast<uint64_t>(static_cast<double>(seconds) * 1e9) : 0;
+}
+
+uint64_t SourceClock::Map(uint64_t sourceNs, uint64_t arrivalNs) {
+    int64_t offset = static_cast<int64_t>(arrivalNs - sourceNs);
+    if (!valid_ || offset < offsetNs_) {
+        offsetNs_ = offset;
+    } else if (arrivalNs > lastArrivalNs_) {
+        double elapsedSeconds = static_cast<double>(arrivalNs - lastArrivalNs_) * 1e-9;
+        int64_t relax = static_cast<int64_t>(elapsedSeconds * kClockRelaxNsPerSecond);
+        offsetNs_ += std::min(offset - offsetNs_, relax);
+    }
+    valid_ = true;
+    lastArrivalNs_ = arrivalNs;
+    return sourceNs + static_cast<uint64_t>(offsetNs_);
+}
+
+int SignalInterpolator::AddSignal(const SignalConfig& config) {
+    if (count_ >= kMaxSignals) return -1;
+    Signal& signal = signals_[count_];
+    signal.config = config;
+    signal.delayNs = SecondsToNs(config.delaySeconds);
+    signal.extrapolateNs = SecondsToNs(config.extrapolateSeconds);
+    signal.omega = 6.2831853f * std::max(0.1f, config.springHz);
+    Reset(count_);
+    return count_++;
+}
+
+void SignalInterpolator::Reset(int index) {
+    Signal& signal = signals_[index];
+    signal.head = 0;
+    signal.count = 0;
+    signal.value = 0.0f;
+    signal.velocity = 0.0f;
+    signal.lastEvalNs = 0;
+    signal.settled = false;
+}
+
+bool SignalInterpolator::Push(int index, uint64_t timeNs, float value) {
+    Signal& signal = signals_[index];
+    if (signal.count > 0) {
+        int newest = (signal.head - 1) & kHistoryMask;
+        if (timeNs < signal.times[newest]) return false;
+        if (timeNs == signal.times[newest]) {
+            signal.values[newest] = value;
+            return true;
+        }
+    }
+    signal.times[signal.head] = timeNs;
+    signal.values[signal.head] = value;
+    signal.head = (signal.head + 1) & kHistoryMask;
+    signal.count = std::min(signal.count + 1, kHistory);
+    return true;
+}
+
+float SignalInterpolator::GetLatest(int index) const {
+    const Signal& signal = signals_[index];
+    return signal.count > 0 ? signal.values[(signal.head - 1) & kHistoryMask] : 0.0f;
+}
+
+bool SignalInterpolator::EvaluateSignal(Signal& signal, uint64_t frameNs) {
+    if (signal.count == 0) return false;
+
+    uint64_t t = frameNs > signal.delayNs ? frameNs - signal.delayNs : 0;
+    int newest = (signal.head - 1) & kHistoryMask;
+    float target;
+    float slope = 0.0f;                                   // Per second
+    bool pending = t < signal.times[newest];              // Samples not presented yet
+
+    if (!pending) {
+        // Past the newest sample: follow its slope up to the horizon, then hold
+        target = signal.values[newest];
+        if (signal.count >= 2 && signal.config.mode != InterpMode::Step) {
+            int previous = (newest - 1) & kHistoryMask;
+            double span = static_cast<double>(signal.times[newest] - signal.times[previous]) * 1e-9;
+            double ahead = static_cast<double>(t - signal.times[newest]) * 1e-9;
+            double horizon = static_cast<double>(signal.extrapolateNs) * 1e-9;
+            float lastSlope = static_cast<float>((signal.values[newest] - signal.values[previous]) / span);
+            target += lastSlope * static_cast<float>(std::min(ahead, horizon));
+            if (ahead < horizon) {
+                slope = lastSlope;
+                pending = slope != 0.0f;
+            }
+        }
+    } else {
+        // Newest to oldest for the last sample at or before t
+        int after = newest;
+        int before = -1;
+        for (int i = 1; i < signal.count; i++) {
+            int slot = (newest - i) & kHistoryMask;
+            if (signal.times[slot] <= t) {
+                before = slot;
+                break;
+            }
+            after = slot;
+        }
+
+        if (before < 0) {
+            target = signal.values[after];                // Older than the history: hold the oldest
+        } else if (signal.config.mode == InterpMode::Step) {
+            target = signal.values[before];
+        } else {
+            double span = static_cast<double>(signal.times[after] - signal.times[before]);
+            float f = static_cast<float>(static_cast<double>(t - signal.times[before]) / span);
+            float delta = signal.values[after] - signal.values[before];
+            target = signal.values[before] + delta * f;
+            slope = static_cast<float>(delta / (span * 1e-9));
+        }
+    }
+
+    float previousValue = signal.value;
+    if (signal.config.mode != InterpMode::Spring || !signal.settled) {
+        signal.value = target;
+        signal.velocity = slope;
+        signal.settled = true;
+    } else {
+        // Critically damped spring on the offset from the target, in the
+        // target's moving frame so a steady ramp has no lag
+        float dt = std::min(kMaxStepSeconds, static_cast<float>(frameNs - signal.lastEvalNs) * 1e-9f);
+        if (frameNs <= signal.lastEvalNs) dt = 0.0f;
+        float omega = signal.omega;
+        float offset = signal.value - (target - slope * dt);
+        float relative = signal.velocity - slope;
+        float decay = std::exp(-omega * dt);
+        float coupled = relative + omega * offset;
+        float nextOffset = (offset + coupled * dt) * decay;
+        float nextRelative = (relative - omega * coupled * dt) * decay;
+        signal.value = target + nextOffset;
+        signal.velocity = slope + nextRelative;
+        pending |= std::fabs(nextOffset) > 1e-4f * std::max(1.0f, std::fabs(target));
+    }
+    signal.lastEvalNs = frameNs;
+
+    return pending || signal.value != previousValue;
+}
+
+bool SignalInterpolator::Evaluate(uint64_t frameNs) {
+    bool moving = false;
+    for (int i = 0; i < count_; i++) {
+        moving |= EvaluateSignal(signals_[i], frameNs);
+    }
+    return moving;
+}
+
+} // namespace ui
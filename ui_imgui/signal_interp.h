@@ -0,0 +1,138 @@
+#pragma once
+
+#include <cstdint>
+
+namespace ui {
+
+/**
+ * How a signal is drawn between samples
+ */
+enum class InterpMode : uint8_t {
+    Step,       // Latest sample at the presentation time (no smoothing)
+    Linear,     // Straight line between the samples around the presentation time
+    Spring      // Linear target followed by a critically damped spring (also hides jitter in the values)
+};
+
+/**
+ * Per-signal settings
+ */
+struct SignalConfig {
+    InterpMode mode = InterpMode::Linear;
+    float delaySeconds = 0.1f;          // Presentation delay; cover a sample interval plus network jitter
+    float extrapolateSeconds = 0.1f;    // Past the newest sample: continue its slope this long, then hold
+    float springHz = 4.0f;              // Spring natural frequency (higher = stiffer)
+};
+
+/**
+ * Map a sender's timestamps onto the local clock
+ *
+ * The offset is the smallest (arrival - source) seen, which is the
+ * fastest network path; samples delayed by jitter keep their source
+ * spacing instead of their arrival spacing. The offset relaxes upwards by
+ * 1 ms per second, so it follows a clock drift or a path that got slower.
+ */
+class SourceClock {
+public:
+    /**
+     * @param sourceNs Sample time on the sender's clock
+     * @param arrivalNs Local receive time (MonotonicNowNs())
+     * @return Sample time on the local clock
+     */
+    uint64_t Map(uint64_t sourceNs, uint64_t arrivalNs);
+
+    void Reset() { valid_ = false; }
+
+private:
+    int64_t offsetNs_ = 0;              // Local - source
+    uint64_t lastArrivalNs_ = 0;
+    bool valid_ = false;
+};
+
+/**
+ * Timestamped sample buffers and per-frame interpolation for gauges
+ *
+ * Telemetry arrives at 10-50 Hz with jitter while the dashboard draws at
+ * 60 Hz. Each signal keeps its last kHistory samples; Evaluate() computes
+ * every signal's value at frame time minus its presentation delay, so
+ * the value always sits between two real samples (linear) or eases toward
+ * them (spring). When samples stop coming the last slope is extrapolated
+ * for extrapolateSeconds and then held.
+ *
+ * Fixed capacity, no allocation. Push and Evaluate on one thread (the
+ * render thread, when it copies new telemetry into AppState). Evaluating
+ * 64 signals takes a couple of microseconds.
+ *
+ * @code
+ *   static ui::SignalInterpolator signals;
+ *   int speed = signals.AddSignal({ ui::InterpMode::Spring, 0.1f, 0.1f, 4.0f });
+ *
+ *   // New packet:
+ *   signals.Push(speed, clock.Map(packet.sendTimeNs, ui::MonotonicNowNs()), packet.speed);
+ *
+ *   // Every frame:
+ *   signals.Evaluate(ui::MonotonicNowNs());
+ *   float shownSpeed = signals.Get(speed);
+ * @endcode
+ */
+class SignalInterpolator {
+public:
+    static constexpr int kMaxSignals = 64;
+    static constexpr int kHistory = 16;               // Samples per signal (power of two)
+
+    /**
+     * @return Signal index, or -1 if all kMaxSignals are in use
+     */
+    int AddSignal(const SignalConfig& config = SignalConfig());
+
+    /**
+     * Add a sample (timeNs on the clock Evaluate() is given)
+     *
+     * @return false if it is older than the newest sample (out of order; dropped).
+     *         A sample with the newest sample's time replaces it.
+     */
+    bool Push(int signal, uint64_t timeNs, float value);
+
+    /**
+     * Evaluate all signals for a frame
+     *
+     * @return true while some signal is still moving (samples not yet fully
+     *         presented, extrapolating, or a spring settling), i.e. while
+     *         frames at the display rate make a difference
+     */
+    bool Evaluate(uint64_t frameNs);
+
+    /** Value from the last Evaluate() (0 before the first sample) */
+    float Get(int signal) const { return signals_[signal].value; }
+
+    /** Newest sample as pushed */
+    float GetLatest(int signal) const;
+
+    bool HasSamples(int signal) const { return signal >= 0 && signal < count_ && signals_[signal].count > 0; }
+    int GetSignalCount() const { return count_; }
+
+    /** Drop a signal's samples; the next sample is shown without easing in */
+    void Reset(int signal);
+
+private:
+    struct Signal {
+        SignalConfig config;
+        uint64_t delayNs;
+        uint64_t extrapolateNs;
+        float omega;                                  // 2 pi springHz
+        uint64_t times[kHistory];
+        float values[kHistory];
+        int head;                                     // Next write slot
+        int count;
+        float value;                                  // Output
+        float velocity;                               // Spring state
+        uint64_t lastEvalNs;
+        bool settled;                                 // Spring has an initial value
+    };
+
+    bool EvaluateSignal(Signal& signal, uint64_t frameNs);
+
+    Signal signals_[kMaxSignals];
+    int count_ = 0;
+};
+
+} // namespace ui
@@ -0,0 +1,252 @@
+#include "soft_raster.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+namespace ui {
+namespace raster {
+
+namespace {
+
+// Inclusive on a tie (pixel centre exactly on the edge) only for top and
+// left edges, so two triangles sharing an edge shade each pixel once.
+// With the winding DrawTriangle() normalizes to (positive area, y down),
+// a top edge runs in +x and a left edge runs in -y.
+bool IsTopLeft(float dx, float dy) {
+    return dy < 0.0f || (dy == 0.0f && dx > 0.0f);
+}
+
+inline float Channel(ImU32 color, int shift) {
+    return static_cast<float>((color >> shift) & 0xFF);
+}
+
+inline ImU32 ToByte(float value) {
+    return static_cast<ImU32>(std::min(255.0f, std::max(0.0f, value)) + 0.5f);
+}
+
+} // namespace
+
+void SoftRasterizer::SetTexture(ImTextureID id, const unsigned char* rgba, int width, int height) {
+    for (Texture& texture : textures_) {
+        if (texture.id == id) {
+            texture = { id, rgba, width, height };
+            return;
+        }
+    }
+    textures_.push_back({ id, rgba, width, height });
+}
+
+const SoftRasterizer::Texture* SoftRasterizer::FindTexture(ImTextureID id) const {
+    for (const Texture& texture : textures_) {
+        if (texture.id == id && texture.rgba && texture.width > 0 && texture.height > 0) return &texture;
+    }
+    return nullptr;
+}
+
+void SoftRasterizer::Render(const ImDrawData& drawData, ImU32 clearColor) {
+    origin_ = drawData.DisplayPos;
+    scale_ = drawData.FramebufferScale;
+    if (scale_.x <= 0.0f || scale_.y <= 0.0f) scale_ = ImVec2(1.0f, 1.0f);
+    width_ = std::max(0, static_cast<int>(drawData.DisplaySize.x * scale_.x));
+    height_ = std::max(0, static_cast<int>(drawData.DisplaySize.y * scale_.y));
+
+    size_t count = static_cast<size_t>(width_) * static_cast<size_t>(height_);
+    pixels_.assign(count, clearColor);
+    overdraw_.assign(count, 0);
+    owner_.assign(count, 0);
+    panels_.resize(static_cast<size_t>(std::max(0, drawData.CmdListsCount)));
+
+    for (int n = 0; n < drawData.CmdListsCount; n++) {
+        const ImDrawList* list = drawData.CmdLists[n];
+        PanelOverdraw& panel = panels_[n];
+        panel.name = list->_OwnerName ? list->_OwnerName : "";
+        panel.triangles = 0;
+        panel.fragments = panel.pixels = panel.overdrawn = panel.transparent = 0;
+        uint32_t stamp = static_cast<uint32_t>(n) + 1;
+
+        for (const ImDrawCmd& cmd : list->CmdBuffer) {
+            if (cmd.UserCallback) continue;
+
+            // Integer scissor, as backends pass to glScissor / vkCmdSetScissor
+            int scissor[4] = {
+                std::max(0, static_cast<int>((cmd.ClipRect.x - origin_.x) * scale_.x)),
+                std::max(0, static_cast<int>((cmd.ClipRect.y - origin_.y) * scale_.y)),
+                std::min(width_, static_cast<int>((cmd.ClipRect.z - origin_.x) * scale_.x)),
+                std::min(height_, static_cast<int>((cmd.ClipRect.w - origin_.y) * scale_.y)),
+            };
+            if (scissor[2] <= scissor[0] || scissor[3] <= scissor[1]) continue;
+
+            const Texture* texture = FindTexture(cmd.GetTexID());
+            const ImDrawVert* vtx = list->VtxBuffer.Data + cmd.VtxOffset;
+            const ImDrawIdx* idx = list->IdxBuffer.Data + cmd.IdxOffset;
+            for (unsigned int i = 0; i + 2 < cmd.ElemCount; i += 3) {
+                DrawTriangle(vtx[idx[i]], vtx[idx[i + 1]], vtx[idx[i + 2]], scissor, texture, stamp, panel);
+            }
+            panel.triangles += cmd.ElemCount / 3;
+        }
+    }
+}
+
+void SoftRasterizer::DrawTriangle(const ImDrawVert& v0, const ImDrawVert& v1, const ImDrawVert& v2,
+                                  const int scissor[4], const Texture* texture, uint32_t panelStamp,
+                                  PanelOverdraw& panel) {
+    const ImDrawVert* v[3] = { &v0, &v1, &v2 };
+    float x[3], y[3];
+    for (int i = 0; i < 3; i++) {
+        x[i] = (v[i]->pos.x - origin_.x) * scale_.x;
+        y[i] = (v[i]->pos.y - origin_.y) * scale_.y;
+    }
+
+    float area = (x[1] - x[0]) * (y[2] - y[0]) - (y[1] - y[0]) * (x[2] - x[0]);
+    if (!(area != 0.0f) || !std::isfinite(area)) return;   // Degenerate or NaN
+    if (area < 0.0f) {
+        std::swap(v[1], v[2]);
+        std::swap(x[1], x[2]);
+        std::swap(y[1], y[2]);
+        area = -area;
+    }
+
+    // Pixels whose centre can fall inside the triangle and the scissor
+    int minX = std::max(scissor[0], static_cast<int>(std::floor(std::min(x[0], std::min(x[1], x[2])))));
+    int minY = std::max(scissor[1], static_cast<int>(std::floor(std::min(y[0], std::min(y[1], y[2])))));
+    int maxX = std::min(scissor[2] - 1, static_cast<int>(std::ceil(std::max(x[0], std::max(x[1], x[2])))));
+    int maxY = std::min(scissor[3] - 1, static_cast<int>(std::ceil(std::max(y[0], std::max(y[1], y[2])))));
+    if (minX > maxX || minY > maxY) return;
+
+    // Edge i is opposite vertex i; its function is that vertex's weight * area
+    float ex[3], ey[3];
+    bool inclusive[3];
+    for (int i = 0; i < 3; i++) {
+        int a = (i + 1) % 3, b = (i + 2) % 3;
+        ex[i] = x[b] - x[a];
+        ey[i] = y[b] - y[a];
+        inclusive[i] = IsTopLeft(ex[i], ey[i]);
+    }
+
+    float inverseArea = 1.0f / area;
+    float color[3][4], u[3], vt[3];
+    for (int i = 0; i < 3; i++) {
+        color[i][0] = Channel(v[i]->col, IM_COL32_R_SHIFT);
+        color[i][1] = Channel(v[i]->col, IM_COL32_G_SHIFT);
+        color[i][2] = Channel(v[i]->col, IM_COL32_B_SHIFT);
+        color[i][3] = Channel(v[i]->col, IM_COL32_A_SHIFT);
+        u[i] = v[i]->uv.x;
+        vt[i] = v[i]->uv.y;
+    }
+
+    for (int py = minY; py <= maxY; py++) {
+        float cy = static_cast<float>(py) + 0.5f;
+        size_t row = static_cast<size_t>(py) * static_cast<size_t>(width_);
+        for (int px = minX; px <= maxX; px++) {
+            float cx = static_cast<float>(px) + 0.5f;
+            float w[3];
+            bool inside = true;
+            for (int i = 0; i < 3 && inside; i++) {
+                int a = (i + 1) % 3;
+                w[i] = ex[i] * (cy - y[a]) - ey[i] * (cx - x[a]);
+                inside = w[i] > 0.0f || (w[i] == 0.0f && inclusive[i]);
+            }
+            if (!inside) continue;
+
+            float l0 = w[0] * inverseArea, l1 = w[1] * inverseArea, l2 = w[2] * inverseArea;
+            float src[4];
+            for (int c = 0; c < 4; c++) src[c] = l0 * color[0][c] + l1 * color[1][c] + l2 * color[2][c];
+            if (texture) {
+                float tu = l0 * u[0] + l1 * u[1] + l2 * u[2];
+                float tv = l0 * vt[0] + l1 * vt[1] + l2 * vt[2];
+                int tx = std::min(texture->width - 1, std::max(0, static_cast<int>(tu * texture->width)));
+                int ty = std::min(texture->height - 1, std::max(0, static_cast<int>(tv * texture->height)));
+                const unsigned char* texel = texture->rgba + (static_cast<size_t>(ty) * texture->width + tx) * 4;
+                for (int c = 0; c < 4; c++) src[c] *= texel[c] * (1.0f / 255.0f);
+            }
+
+            size_t p = row + static_cast<size_t>(px);
+            panel.fragments++;
+            if (overdraw_[p] > 0) panel.overdrawn++;
+            if (overdraw_[p] < UINT16_MAX) overdraw_[p]++;
+            if (owner_[p] != panelStamp) {
+                owner_[p] = panelStamp;
+                panel.pixels++;
+            }
+
+            ImU32 alphaByte = ToByte(src[3]);
+            if (alphaByte == 0) {
+                panel.transparent++;
+                continue;
+            }
+
+            // SrcAlpha / OneMinusSrcAlpha for color, One / OneMinusSrcAlpha for alpha
+            float alpha = alphaByte * (1.0f / 255.0f);
+            ImU32 dst = pixels_[p];
+            ImU32 r = ToByte(src[0] * alpha + Channel(dst, IM_COL32_R_SHIFT) * (1.0f - alpha));
+            ImU32 g = ToByte(src[1] * alpha + Channel(dst, IM_COL32_G_SHIFT) * (1.0f - alpha));
+            ImU32 b = ToByte(src[2] * alpha + Channel(dst, IM_COL32_B_SHIFT) * (1.0f - alpha));
+            ImU32 a = ToByte(src[3] + Channel(dst, IM_COL32_A_SHIFT) * (1.0f - alpha));
+            pixels_[p] = (r << IM_COL32_R_SHIFT) | (g << IM_COL32_G_SHIFT) | (b << IM_COL32_B_SHIFT) |
+                         (a << IM_COL32_A_SHIFT);
+        }
+    }
+}
+
+OverdrawSummary SoftRasterizer::GetSummary() const {
+    OverdrawSummary summary;
+    for (const PanelOverdraw& panel : panels_) {
+        summary.fragments += panel.fragments;
+        summary.transparent += panel.transparent;
+    }
+    for (uint16_t depth : overdraw_) {
+        if (depth > 0) summary.pixels++;
+        summary.maxDepth = std::max(summary.maxDepth, static_cast<int>(depth));
+        int bucket = depth <= 4 ? depth : (depth < 8 ? 5 : 6);
+        summary.depthHistogram[bucket]++;
+    }
+    return summary;
+}
+
+void OverdrawHeatmap(const uint16_t* overdraw, int width, int height, std::vector<ImU32>& rgba) {
+    static const ImU32 ramp[9] = {
+        IM_COL32(0, 0, 0, 255),         // Untouched
+        IM_COL32(20, 40, 160, 255),     // 1
+        IM_COL32(0, 150, 200, 255),     // 2
+        IM_COL32(0, 180, 60, 255),      // 3
+        IM_COL32(230, 220, 0, 255),     // 4
+        IM_COL32(255, 140, 0, 255),     // 5
+        IM_COL32(220, 20, 20, 255),     // 6
+        IM_COL32(220, 20, 20, 255),     // 7
+        IM_COL32(255, 255, 255, 255),   // 8+
+    };
+    size_t count = static_cast<size_t>(std::max(0, width)) * static_cast<size_t>(std::max(0, height));
+    rgba.resize(count);
+    for (size_t i = 0; i < count; i++) rgba[i] = ramp[std::min<int>(overdraw[i], 8)];
+}
+
+bool WritePpm(const char* path, const ImU32* rgba, int width, int height) {
+    FILE* file = fopen(path, "wb");
+    if (!file) return false;
+
+    bool ok = fprintf(file, "P6\n%d %d\n255\n", width, height) > 0;
+    std::vector<unsigned char> line(static_cast<size_t>(std::max(0, width)) * 3);
+    for (int y = 0; y < height && ok; y++) {
+        const ImU32* row = rgba + static_cast<size_t>(y) * width;
+        for (int x = 0; x < width; x++) {
+            line[x * 3 + 0] = static_cast<unsigned char>(row[x] >> IM_COL32_R_SHIFT);
+            line[x * 3 + 1] = static_cast<unsigned char>(row[x] >> IM_COL32_G_SHIFT);
+            line[x * 3 + 2] = static_cast<unsigned char>(row[x] >> IM_COL32_B_SHIFT);
+        }
+        ok = fwrite(line.data(), 1, line.size(), file) == line.size();
+    }
+    return fclose(file) == 0 && ok;
+}
+
+bool WriteImage(const char* path, const SoftRasterizer& raster) {
+    return WritePpm(path, raster.GetPixels(), raster.GetWidth(), raster.GetHeight());
+}
+
+bool WriteOverdrawHeatmap(const char* path, const SoftRasterizer& raster) {
+    std::vector<ImU32> heatmap;
+    OverdrawHeatmap(raster.GetOverdraw(), raster.GetWidth(), raster.GetHeight(), heatmap);
+    return WritePpm(path, heatmap.data(), raster.GetWidth(), raster.GetHeight());
+}
+
+} // namespace raster
+} // namespace ui
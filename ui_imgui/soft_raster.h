@@ -0,0 +1,136 @@
+#pragma once
+
+#include "imgui.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace ui {
+namespace raster {
+
+/**
+ * CPU rasterizer for ImDrawData (headless overdraw and fill-cost analysis)
+ *
+ * Draws a frame the way a GPU backend would (scissor from each command's
+ * clip rect, per-vertex color, nearest-neighbour texture sampling, straight
+ * alpha blending) into an RGBA image, and counts every shaded fragment in
+ * a per-pixel overdraw buffer. Fragments are counted whatever their alpha:
+ * a GPU pays fill rate for a fully transparent fringe or an empty glyph
+ * texel too, so those are reported separately as "transparent".
+ *
+ * Each ImDrawList is one panel: ImGui gives every window and child window
+ * (and so every BeginCard) its own list, named after the window. The
+ * per-panel numbers say how much fill each one costs and how much of it
+ * lands on pixels something else already shaded.
+ *
+ * Not a reference renderer: pixel centres and a top-left fill rule match
+ * GPUs closely enough for counting, but there is no subpixel precision
+ * and no texture filtering. Callback commands are skipped.
+ *
+ * @code
+ *   ui::raster::SoftRasterizer raster;
+ *   raster.SetTexture(io.Fonts->TexID, atlasPixels, atlasWidth, atlasHeight);
+ *   ImGui::Render();
+ *   raster.Render(*ImGui::GetDrawData());
+ *   raster.GetPanels();                              // Per-window fill
+ *   ui::raster::WriteOverdrawHeatmap("heat.ppm", raster);
+ * @endcode
+ */
+
+constexpr int kDepthBuckets = 7;                      // 0, 1, 2, 3, 4, 5-7, 8+ fragments
+
+/**
+ * Fill cost of one draw list (window or child window)
+ */
+struct PanelOverdraw {
+    std::string name;                                 // ImDrawList owner window name
+    uint32_t triangles = 0;
+    uint64_t fragments = 0;                           // Pixels shaded, counting repeats
+    uint64_t pixels = 0;                              // Distinct pixels shaded
+    uint64_t overdrawn = 0;                           // Fragments on a pixel already shaded this frame
+    uint64_t transparent = 0;                         // Fragments with alpha 0 (fill for nothing)
+};
+
+/**
+ * Whole-frame totals
+ */
+struct OverdrawSummary {
+    uint64_t fragments = 0;
+    uint64_t pixels = 0;                              // Pixels shaded at least once
+    uint64_t transparent = 0;
+    int maxDepth = 0;                                 // Most fragments on one pixel
+    uint64_t depthHistogram[kDepthBuckets] = {};      // Pixels per depth bucket
+};
+
+class SoftRasterizer {
+public:
+    /**
+     * Register texture pixels for a texture ID (RGBA8, as from
+     * ImFontAtlas::GetTexDataAsRGBA32); the pixels must outlive Render()
+     * Commands using an unregistered texture sample opaque white.
+     */
+    void SetTexture(ImTextureID id, const unsigned char* rgba, int width, int height);
+
+    /**
+     * Rasterize a frame at DisplaySize * FramebufferScale
+     *
+     * Clears the image to clearColor and the overdraw buffer to 0 first.
+     * Buffers are reused between calls.
+     */
+    void Render(const ImDrawData& drawData, ImU32 clearColor = IM_COL32(0, 0, 0, 255));
+
+    int GetWidth() const { return width_; }
+    int GetHeight() const { return height_; }
+    const ImU32* GetPixels() const { return pixels_.data(); }        // IM_COL32 layout, row-major
+    const uint16_t* GetOverdraw() const { return overdraw_.data(); } // Fragments per pixel (saturating)
+
+    /** Panels in draw order */
+    const std::vector<PanelOverdraw>& GetPanels() const { return panels_; }
+    OverdrawSummary GetSummary() const;
+
+private:
+    struct Texture {
+        ImTextureID id;
+        const unsigned char* rgba;
+        int width;
+        int height;
+    };
+
+    const Texture* FindTexture(ImTextureID id) const;
+    void DrawTriangle(const ImDrawVert& v0, const ImDrawVert& v1, const ImDrawVert& v2, const int scissor[4],
+                      const Texture* texture, uint32_t panelStamp, PanelOverdraw& panel);
+
+    int width_ = 0;
+    int height_ = 0;
+    ImVec2 origin_;                                   // DisplayPos
+    ImVec2 scale_;                                    // FramebufferScale
+    std::vector<ImU32> pixels_;
+    std::vector<uint16_t> overdraw_;
+    std::vector<uint32_t> owner_;                     // Last panel (index + 1) to shade each pixel
+    std::vector<PanelOverdraw> panels_;
+    std::vector<Texture> textures_;
+};
+
+/**
+ * Map an overdraw buffer to colors: black = untouched, then blue, cyan,
+ * green, yellow, orange for 1-5 fragments, red for 6-7, white for 8+
+ *
+ * @param rgba Receives width * height IM_COL32 pixels
+ */
+void OverdrawHeatmap(const uint16_t* overdraw, int width, int height, std::vector<ImU32>& rgba);
+
+/**
+ * Write IM_COL32 pixels as a binary PPM (P6, alpha dropped)
+ *
+ * @return false if the file could not be written
+ */
+bool WritePpm(const char* path, const ImU32* rgba, int width, int height);
+
+/**
+ * WritePpm() of the rasterizer's image / overdraw heatmap
+ */
+bool WriteImage(const char* path, const SoftRasterizer& raster);
+bool WriteOverdrawHeatmap(const char* path, const SoftRasterizer& raster);
+
+} // namespace raster
+} // namespace ui
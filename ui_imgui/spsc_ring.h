@@ -0,0 +1,95 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+
+namespace ui {
+
+/**
+ * Bounded single-producer / single-consumer ring
+ *
+ * One thread pushes, one other thread pops; neither ever blocks or takes a
+ * lock. Head and tail live on their own cache lines, and each side keeps a
+ * cached copy of the other side's index so it only touches the shared line
+ * when the cached value says the ring looks full (or empty). The buffer is
+ * allocated once, in the constructor.
+ *
+ * @tparam T Trivially copyable element
+ */
+template <typename T>
+class SpscRing {
+    static_assert(std::is_trivially_copyable<T>::value, "ring elements are copied as bytes");
+
+public:
+    /**
+     * @param capacity Rounded up to a power of two (at least 2)
+     */
+    explicit SpscRing(size_t capacity) {
+        size_t rounded = 2;
+        while (rounded < capacity) rounded <<= 1;
+        mask_ = rounded - 1;
+        buffer_.reset(new T[rounded]);
+    }
+
+    SpscRing(const SpscRing&) = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+
+    /**
+     * Append an element (producer thread only)
+     * @return false if the ring is full (nothing written)
+     */
+    bool Push(const T& item) {
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - producerHead_ > mask_) {
+            producerHead_ = head_.load(std::memory_order_acquire);
+            if (tail - producerHead_ > mask_) return false;
+        }
+        buffer_[tail & mask_] = item;
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * Remove the oldest element (consumer thread only)
+     * @return false if the ring is empty
+     */
+    bool Pop(T& out) {
+        return PopBatch(&out, 1) == 1;
+    }
+
+    /**
+     * Remove up to max elements, oldest first (consumer thread only)
+     * @return Number of elements written to out
+     */
+    size_t PopBatch(T* out, size_t max) {
+        size_t head = head_.load(std::memory_order_relaxed);
+        if (consumerTail_ == head) {
+            consumerTail_ = tail_.load(std::memory_order_acquire);
+            if (consumerTail_ == head) return 0;
+        }
+        size_t count = consumerTail_ - head;
+        if (count > max) count = max;
+        for (size_t i = 0; i < count; i++) out[i] = buffer_[(head + i) & mask_];
+        head_.store(head + count, std::memory_order_release);
+        return count;
+    }
+
+    size_t Capacity() const { return mask_ + 1; }
+
+    /** Elements queued; exact only when called from one of the two threads while the other is idle */
+    size_t SizeApprox() const {
+        return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire);
+    }
+
+private:
+    alignas(64) std::atomic<size_t> head_{0};       // Next slot to pop (written by the consumer)
+    size_t consumerTail_ = 0;                        // Consumer's cached tail_
+    alignas(64) std::atomic<size_t> tail_{0};       // Next slot to push (written by the producer)
+    size_t producerHead_ = 0;                        // Producer's cached head_
+    alignas(64) size_t mask_ = 0;
+    std::unique_ptr<T[]> buffer_;
+};
+
+} // namespace ui
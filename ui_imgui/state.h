@@ -1,19 +1,26 @@
 #pragma once
 
+#include "cell_telemetry.h"
+#include "fault.h"
+#include "fault_aggregator.h"
+#include "fault_history.h"
+#include "fault_journal.h"
 #include <string>
 #include <vector>
 #include <cstdint>
 
 namespace ui {
 
-/**
- * Fault severity levels matching TSX implementation
- */
-enum class FaultSeverity {
-    Info,
-    Warning,
-    Critical
-};
+class CellHeatmap;
+class ParallelDraw;
+class DrawBudget;
+class FramePacer;
+class SignalInterpolator;
+class LayoutCache;
+class FreshnessMonitor;
+class SessionPlayback;
+
+// --- BEGIN GENERATED (schema/vehicle-state.json) ---
 
 /**
  * Gear positions for the vehicle
@@ -34,16 +41,6 @@ enum class TurnSignal {
     Right
 };
 
-/**
- * Individual fault record
- */
-struct Fault {
-    std::string code;
-    std::string message;
-    FaultSeverity severity;
-    int64_t timestamp;  // Unix timestamp in milliseconds
-};
-
 /**
  * Main battery state
  */
@@ -78,6 +75,38 @@ struct ContactorStates {
     bool hvil;  // High Voltage Interlock Loop
 };
 
+// --- END GENERATED ---
+
+/**
+ * Signals the dashboard smooths through AppState::signals (indices into the
+ * interpolator, in the order AddDashboardSignals() adds them)
+ */
+enum DashboardSignal {
+    DashboardSignal_Speed,          // km/h
+    DashboardSignal_MainSoc,        // 0-100
+    DashboardSignal_SuppSoc,        // 0-100
+    DashboardSignal_Count
+};
+
+/**
+ * Groups of AppState fields whose freshness the dashboard tracks (indices
+ * into the monitor, in the order AddDashboardFeeds() adds them). A panel
+ * greys out the values of a feed that went stale.
+ */
+enum DashboardFeed {
+    DashboardFeed_Speed,
+    DashboardFeed_Gear,
+    DashboardFeed_MainBattery,      // soc, voltage, current
+    DashboardFeed_SuppBattery,
+    DashboardFeed_Cruise,
+    DashboardFeed_Brake,
+    DashboardFeed_Contactors,
+    DashboardFeed_TurnSignal,
+    DashboardFeed_Heartbeat,        // Touched only when the counter advances
+    DashboardFeed_Cells,
+    DashboardFeed_Count
+};
+
 /**
  * Complete application state mirroring VehicleState from TSX
  * All widgets read/write from this struct - no globals.
@@ -91,9 +120,61 @@ struct AppState {
     bool brakeEngaged;
     ContactorStates contactorStates;
     uint8_t heartbeat;      // 0-255 cycling heartbeat counter
-    std::vector<Fault> faults;
+    FaultAggregator faults;     // Active faults, one entry per code (see ReportFault)
     TurnSignal turnSignal;
 
+    // Optional session fault history (owned by the application; it grows
+    // for the whole session, so AppState copies must not carry it). When
+    // attached, reported faults are appended and the history view lists them.
+    FaultHistory* faultHistory = nullptr;
+    bool showFaultHistory = false;
+
+    // Optional persistent journal (owned by the application, not AppState).
+    // When attached, reported faults are also journaled and the history view
+    // can page through past sessions.
+    FaultJournal* faultJournal = nullptr;
+    bool faultHistoryFromJournal = false;
+
+    // Per-cell voltages/temperatures (cell count 0 = not reported, panel hidden)
+    CellTelemetry cells;
+    CellField cellHeatmapField = CellField::Voltage;
+
+    // Optional texture-backed heatmap (owned by the application, with an
+    // uploader set). Without one the dashboard draws the cells as quads.
+    CellHeatmap* cellHeatmap = nullptr;
+
+    // Optional worker pool (owned by the application). When attached, the
+    // gauge, camera overlays and quad heatmap build their geometry on it and
+    // RenderUI() splices the results in before returning.
+    ParallelDraw* parallelDraw = nullptr;
+
+    // Optional per-panel geometry accounting (owned by the application).
+    // RenderUI() starts and settles its frame; panels declare their budgets.
+    DrawBudget* drawBudget = nullptr;
+
+    // Optional frame pacer (owned by the host loop). Pulsing elements ask it
+    // for the frame rate they need while they are on screen.
+    FramePacer* framePacer = nullptr;
+
+    // Optional sample interpolation (owned by the application, signals
+    // added with AddDashboardSignals()). When attached, the speed arc and
+    // SOC bars draw the smoothed DashboardSignal values; numbers stay raw.
+    SignalInterpolator* signals = nullptr;
+
+    // Optional layout cache (owned by the application), e.g. to force a
+    // LayoutProfile. Without one the dashboard keeps its own.
+    LayoutCache* layout = nullptr;
+
+    // Optional freshness tracking (owned by the application, feeds added
+    // with AddDashboardFeeds()). When attached, RenderUI() sweeps it every
+    // frame and panels grey out values whose feed went stale.
+    FreshnessMonitor* freshness = nullptr;
+
+    // Optional recorded session (owned by the application). While it is
+    // active, RenderUI() draws the dashboard as of its playback position
+    // and a timeline bar to scrub through the recording.
+    SessionPlayback* playback = nullptr;
+
     // Camera texture IDs - placeholders for actual textures
     // TODO: Load actual textures when available
     void* rearCameraTexture = nullptr;
@@ -117,6 +198,21 @@ inline AppState CreateDefaultState() {
     return state;
 }
 
+/**
+ * Record a new fault
+ * Updates the active fault set (deduplicated by code) and appends to the
+ * session history and the persistent journal, if attached.
+ */
+inline void ReportFault(AppState& state, const Fault& fault) {
+    state.faults.Report(fault);
+    if (state.faultHistory) {
+        state.faultHistory->Append(fault);
+    }
+    if (state.faultJournal) {
+        state.faultJournal->Append(fault);
+    }
+}
+
 /**
  * Helper to convert Gear enum to display string
  */
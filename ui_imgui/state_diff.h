@@ -0,0 +1,286 @@
+#pragma once
+
+// Generated from schema/vehicle-state.json by scripts/gen-state.mjs - do not edit
+
+#include "state_wire.h"
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define UI_WIRE_DIFF_SSE2 1
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#define UI_WIRE_DIFF_NEON 1
+#endif
+
+namespace ui {
+
+/**
+ * Field-level diff of two WireVehicleState snapshots
+ *
+ * DiffWire() returns a WireField mask of the members that differ, so
+ * recorders, bridges and dirty-rect rendering share one comparison instead of
+ * each walking AppState. The scalar members are compared as 3 SIMD blocks
+ * giving a per-byte change mask, which is then tested against each member's
+ * byte range; arrays are compared only over their used entries (EncodeWire()
+ * zeroes the rest). ApplyWirePatch() copies the masked members.
+ *
+ * @code
+ *   ui::WireVehicleState last, next;            // last = what consumers have seen
+ *   ui::EncodeWire(state, next);
+ *   uint32_t changed = ui::DiffWire(last, next, &deadbands);
+ *   if (changed) { Send(next, changed); ui::ApplyWirePatch(last, next, changed); }
+ * @endcode
+ */
+
+enum WireField : uint32_t {
+    WireField_Speed                    = 1u << 0,
+    WireField_Gear                     = 1u << 1,
+    WireField_MainBatterySoc           = 1u << 2,
+    WireField_MainBatteryVoltage       = 1u << 3,
+    WireField_MainBatteryCurrent       = 1u << 4,
+    WireField_SuppBatterySoc           = 1u << 5,
+    WireField_SuppBatteryVoltage       = 1u << 6,
+    WireField_CruiseEnabled            = 1u << 7,
+    WireField_CruiseSetSpeed           = 1u << 8,
+    WireField_BrakeEngaged             = 1u << 9,
+    WireField_ContactorStatesMain      = 1u << 10,
+    WireField_ContactorStatesPrecharge = 1u << 11,
+    WireField_ContactorStatesHvil      = 1u << 12,
+    WireField_Heartbeat                = 1u << 13,
+    WireField_Faults                   = 1u << 14,
+    WireField_TurnSignal               = 1u << 15,
+    WireField_All                      = (1u << 16) - 1,
+};
+
+constexpr int kWireFieldCount = 16;
+
+// Members WireDeadbands applies to
+constexpr uint32_t kWireDeadbandFields = WireField_Speed |
+                                         WireField_MainBatterySoc |
+                                         WireField_MainBatteryVoltage |
+                                         WireField_MainBatteryCurrent |
+                                         WireField_SuppBatterySoc |
+                                         WireField_SuppBatteryVoltage |
+                                         WireField_CruiseSetSpeed;
+
+// Schema path of each WireField bit (index = bit position)
+constexpr const char* kWireFieldNames[kWireFieldCount] = {
+    "speed",
+    "gear",
+    "mainBattery.soc",
+    "mainBattery.voltage",
+    "mainBattery.current",
+    "suppBattery.soc",
+    "suppBattery.voltage",
+    "cruise.enabled",
+    "cruise.setSpeed",
+    "brakeEngaged",
+    "contactorStates.main",
+    "contactorStates.precharge",
+    "contactorStates.hvil",
+    "heartbeat",
+    "faults",
+    "turnSignal",
+};
+
+/**
+ * Per-field change thresholds for DiffWire()
+ *
+ * A numeric member counts as changed only when it moved by more than its
+ * deadband; 0 (the default) reports any change. Diff against the last
+ * reported snapshot, not the previous frame, so slow drifts still surface.
+ */
+struct WireDeadbands {
+    float speed = 0.0f;
+    float mainBatterySoc = 0.0f;
+    float mainBatteryVoltage = 0.0f;
+    float mainBatteryCurrent = 0.0f;
+    float suppBatterySoc = 0.0f;
+    float suppBatteryVoltage = 0.0f;
+    float cruiseSetSpeed = 0.0f;
+};
+
+/**
+ * Deadbands declared in the schema (half the displayed resolution)
+ */
+inline WireDeadbands SchemaDeadbands() {
+    WireDeadbands deadbands;
+    deadbands.mainBatterySoc = 0.05f;
+    deadbands.mainBatteryVoltage = 0.05f;
+    deadbands.mainBatteryCurrent = 0.05f;
+    deadbands.suppBatterySoc = 0.05f;
+    deadbands.suppBatteryVoltage = 0.05f;
+    return deadbands;
+}
+
+namespace wire_diff {
+
+// Bit i set if byte i of the two 16-byte blocks differs
+inline uint32_t ByteDiffMask16(const uint8_t* a, const uint8_t* b) {
+#if defined(UI_WIRE_DIFF_SSE2)
+    __m128i equal = _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(a)),
+                                   _mm_loadu_si128(reinterpret_cast<const __m128i*>(b)));
+    return ~static_cast<uint32_t>(_mm_movemask_epi8(equal)) & 0xFFFFu;
+#elif defined(UI_WIRE_DIFF_NEON)
+    static const uint8_t kBits[16] = { 1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128 };
+    uint8x16_t differ = vmvnq_u8(vceqq_u8(vld1q_u8(a), vld1q_u8(b)));
+    uint8x16_t bits = vandq_u8(differ, vld1q_u8(kBits));
+    return static_cast<uint32_t>(vaddv_u8(vget_low_u8(bits))) |
+           static_cast<uint32_t>(vaddv_u8(vget_high_u8(bits))) << 8;
+#else
+    uint32_t mask = 0;
+    for (int i = 0; i < 16; i++) mask |= static_cast<uint32_t>(a[i] != b[i]) << i;
+    return mask;
+#endif
+}
+
+// a[0..32) XOR b[0..32), folded into one block
+#if defined(UI_WIRE_DIFF_SSE2)
+inline __m128i Xor32(const uint8_t* a, const uint8_t* b) {
+    __m128i lo = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(a)),
+                               _mm_loadu_si128(reinterpret_cast<const __m128i*>(b)));
+    __m128i hi = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(a + 16)),
+                               _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + 16)));
+    return _mm_or_si128(lo, hi);
+}
+#elif defined(UI_WIRE_DIFF_NEON)
+inline uint8x16_t Xor32(const uint8_t* a, const uint8_t* b) {
+    return vorrq_u8(veorq_u8(vld1q_u8(a), vld1q_u8(b)), veorq_u8(vld1q_u8(a + 16), vld1q_u8(b + 16)));
+}
+#endif
+
+// The first count entries of both arrays are equal. Each 96-byte entry
+// is read as 3 steps of 32 bytes, one accumulator per step, so the ORs
+// within an entry do not wait on each other; one test at the end.
+inline bool FaultsEqual(const WireFault* a, const WireFault* b, size_t count) {
+    const uint8_t* pa = reinterpret_cast<const uint8_t*>(a);
+    const uint8_t* pb = reinterpret_cast<const uint8_t*>(b);
+#if defined(UI_WIRE_DIFF_SSE2)
+    __m128i differ0 = _mm_setzero_si128();
+    __m128i differ1 = _mm_setzero_si128();
+    __m128i differ2 = _mm_setzero_si128();
+    for (size_t i = 0; i < count; i++, pa += 96, pb += 96) {
+        differ0 = _mm_or_si128(differ0, Xor32(pa + 0, pb + 0));
+        differ1 = _mm_or_si128(differ1, Xor32(pa + 32, pb + 32));
+        differ2 = _mm_or_si128(differ2, Xor32(pa + 64, pb + 64));
+    }
+    __m128i differ = _mm_or_si128(_mm_or_si128(differ0, differ1), differ2);
+    return _mm_movemask_epi8(_mm_cmpeq_epi8(differ, _mm_setzero_si128())) == 0xFFFF;
+#elif defined(UI_WIRE_DIFF_NEON)
+    uint8x16_t differ0 = vdupq_n_u8(0);
+    uint8x16_t differ1 = vdupq_n_u8(0);
+    uint8x16_t differ2 = vdupq_n_u8(0);
+    for (size_t i = 0; i < count; i++, pa += 96, pb += 96) {
+        differ0 = vorrq_u8(differ0, Xor32(pa + 0, pb + 0));
+        differ1 = vorrq_u8(differ1, Xor32(pa + 32, pb + 32));
+        differ2 = vorrq_u8(differ2, Xor32(pa + 64, pb + 64));
+    }
+    return vmaxvq_u8(vorrq_u8(vorrq_u8(differ0, differ1), differ2)) == 0;
+#else
+    return memcmp(pa, pb, count * 96) == 0;
+#endif
+}
+
+} // namespace wire_diff
+
+/**
+ * Members of next that differ from base
+ *
+ * @param deadbands Optional thresholds for numeric members (nullptr = exact)
+ * @return WireField mask; 0 if nothing changed
+ */
+inline uint32_t DiffWire(const WireVehicleState& base, const WireVehicleState& next, const WireDeadbands* deadbands = nullptr) {
+    const uint8_t* a = reinterpret_cast<const uint8_t*>(&base);
+    const uint8_t* b = reinterpret_cast<const uint8_t*>(&next);
+
+    // Bytes [1536, 1584) hold every scalar member
+    uint64_t bytes = 0;
+    for (int block = 0; block < 3; block++) {
+        bytes |= static_cast<uint64_t>(wire_diff::ByteDiffMask16(a + 1536 + block * 16, b + 1536 + block * 16)) << (block * 16);
+    }
+
+    uint32_t changed = 0;
+    // Branch-free: which members changed varies frame to frame, and
+    // mispredicted branches here cost more than the SIMD compare itself
+    changed |= static_cast<uint32_t>((bytes & 0xF00ull) != 0) * WireField_Speed;
+    changed |= static_cast<uint32_t>((bytes & 0x1000000000ull) != 0) * WireField_Gear;
+    changed |= static_cast<uint32_t>((bytes & 0xF000ull) != 0) * WireField_MainBatterySoc;
+    changed |= static_cast<uint32_t>((bytes & 0xF0000ull) != 0) * WireField_MainBatteryVoltage;
+    changed |= static_cast<uint32_t>((bytes & 0xF00000ull) != 0) * WireField_MainBatteryCurrent;
+    changed |= static_cast<uint32_t>((bytes & 0xF000000ull) != 0) * WireField_SuppBatterySoc;
+    changed |= static_cast<uint32_t>((bytes & 0xF0000000ull) != 0) * WireField_SuppBatteryVoltage;
+    changed |= static_cast<uint32_t>((bytes & 0x2000000000ull) != 0) * WireField_CruiseEnabled;
+    changed |= static_cast<uint32_t>((bytes & 0xF00000000ull) != 0) * WireField_CruiseSetSpeed;
+    changed |= static_cast<uint32_t>((bytes & 0x4000000000ull) != 0) * WireField_BrakeEngaged;
+    changed |= static_cast<uint32_t>((bytes & 0x8000000000ull) != 0) * WireField_ContactorStatesMain;
+    changed |= static_cast<uint32_t>((bytes & 0x10000000000ull) != 0) * WireField_ContactorStatesPrecharge;
+    changed |= static_cast<uint32_t>((bytes & 0x20000000000ull) != 0) * WireField_ContactorStatesHvil;
+    changed |= static_cast<uint32_t>((bytes & 0x40000000000ull) != 0) * WireField_Heartbeat;
+    changed |= static_cast<uint32_t>((bytes & 0x100000000000ull) != 0) * WireField_TurnSignal;
+    if ((bytes & 0x80000000000ull) ||
+        !wire_diff::FaultsEqual(base.faults, next.faults, base.faultsCount)) {
+        changed |= WireField_Faults;
+    }
+
+    if (deadbands && (changed & kWireDeadbandFields)) {
+        if ((changed & WireField_Speed) && deadbands->speed > 0.0f &&
+            std::fabs(static_cast<float>(next.speed) - static_cast<float>(base.speed)) <= deadbands->speed) {
+            changed &= ~WireField_Speed;
+        }
+        if ((changed & WireField_MainBatterySoc) && deadbands->mainBatterySoc > 0.0f &&
+            std::fabs(next.mainBatterySoc - base.mainBatterySoc) <= deadbands->mainBatterySoc) {
+            changed &= ~WireField_MainBatterySoc;
+        }
+        if ((changed & WireField_MainBatteryVoltage) && deadbands->mainBatteryVoltage > 0.0f &&
+            std::fabs(next.mainBatteryVoltage - base.mainBatteryVoltage) <= deadbands->mainBatteryVoltage) {
+            changed &= ~WireField_MainBatteryVoltage;
+        }
+        if ((changed & WireField_MainBatteryCurrent) && deadbands->mainBatteryCurrent > 0.0f &&
+            std::fabs(next.mainBatteryCurrent - base.mainBatteryCurrent) <= deadbands->mainBatteryCurrent) {
+            changed &= ~WireField_MainBatteryCurrent;
+        }
+        if ((changed & WireField_SuppBatterySoc) && deadbands->suppBatterySoc > 0.0f &&
+            std::fabs(next.suppBatterySoc - base.suppBatterySoc) <= deadbands->suppBatterySoc) {
+            changed &= ~WireField_SuppBatterySoc;
+        }
+        if ((changed & WireField_SuppBatteryVoltage) && deadbands->suppBatteryVoltage > 0.0f &&
+            std::fabs(next.suppBatteryVoltage - base.suppBatteryVoltage) <= deadbands->suppBatteryVoltage) {
+            changed &= ~WireField_SuppBatteryVoltage;
+        }
+        if ((changed & WireField_CruiseSetSpeed) && deadbands->cruiseSetSpeed > 0.0f &&
+            std::fabs(static_cast<float>(next.cruiseSetSpeed) - static_cast<float>(base.cruiseSetSpeed)) <= deadbands->cruiseSetSpeed) {
+            changed &= ~WireField_CruiseSetSpeed;
+        }
+    }
+    return changed;
+}
+
+/**
+ * Copy the members in fields from source into target
+ */
+inline void ApplyWirePatch(WireVehicleState& target, const WireVehicleState& source, uint32_t fields) {
+    if (fields & WireField_Speed) target.speed = source.speed;
+    if (fields & WireField_Gear) target.gear = source.gear;
+    if (fields & WireField_MainBatterySoc) target.mainBatterySoc = source.mainBatterySoc;
+    if (fields & WireField_MainBatteryVoltage) target.mainBatteryVoltage = source.mainBatteryVoltage;
+    if (fields & WireField_MainBatteryCurrent) target.mainBatteryCurrent = source.mainBatteryCurrent;
+    if (fields & WireField_SuppBatterySoc) target.suppBatterySoc = source.suppBatterySoc;
+    if (fields & WireField_SuppBatteryVoltage) target.suppBatteryVoltage = source.suppBatteryVoltage;
+    if (fields & WireField_CruiseEnabled) target.cruiseEnabled = source.cruiseEnabled;
+    if (fields & WireField_CruiseSetSpeed) target.cruiseSetSpeed = source.cruiseSetSpeed;
+    if (fields & WireField_BrakeEngaged) target.brakeEngaged = source.brakeEngaged;
+    if (fields & WireField_ContactorStatesMain) target.contactorStatesMain = source.contactorStatesMain;
+    if (fields & WireField_ContactorStatesPrecharge) target.contactorStatesPrecharge = source.contactorStatesPrecharge;
+    if (fields & WireField_ContactorStatesHvil) target.contactorStatesHvil = source.contactorStatesHvil;
+    if (fields & WireField_Heartbeat) target.heartbeat = source.heartbeat;
+    if (fields & WireField_Faults) {
+        target.faultsCount = source.faultsCount;
+        memcpy(target.faults, source.faults, sizeof(target.faults));
+    }
+    if (fields & WireField_TurnSignal) target.turnSignal = source.turnSignal;
+}
+
+} // namespace ui
@@ -0,0 +1,604 @@
+#include "state_stream.h"
+#include "websocket.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ != __ORDER_LITTLE_ENDIAN__
+#error "state_stream: messages are little-endian"
+#endif
+
+namespace ui {
+namespace stream {
+
+namespace {
+
+constexpr uint8_t kKindFull = 0;
+constexpr uint8_t kKindDelta = 1;
+
+constexpr size_t kMaxRequestSize = 8 * 1024;    // Handshake header block
+constexpr size_t kMaxClientPayload = 4 * 1024;  // Browsers send nothing but control frames
+constexpr size_t kReceiveChunk = 4 * 1024;
+
+template <typename T>
+inline void Put(uint8_t*& p, T value) {
+    memcpy(p, &value, sizeof(T));
+    p += sizeof(T);
+}
+
+// Bounds-checked little-endian reader
+struct Reader {
+    const uint8_t* p;
+    const uint8_t* end;
+
+    template <typename T>
+    bool Get(T& value) {
+        if (static_cast<size_t>(end - p) < sizeof(T)) return false;
+        memcpy(&value, p, sizeof(T));
+        p += sizeof(T);
+        return true;
+    }
+
+    bool GetText(char* out, size_t capacity) {
+        uint8_t length;
+        if (!Get(length) || length >= capacity || static_cast<size_t>(end - p) < length) return false;
+        memcpy(out, p, length);
+        out[length] = '\0';
+        p += length;
+        return true;
+    }
+};
+
+inline int16_t ClampI16(int value) {
+    return static_cast<int16_t>(std::min(32767, std::max(-32768, value)));
+}
+
+// Bitwise, so a NaN reading does not count as a change every frame
+inline bool Differs(float a, float b) {
+    return memcmp(&a, &b, sizeof(float)) != 0;
+}
+
+// Truncate to capacity - 1 bytes without splitting a UTF-8 sequence
+void CopyText(char* out, size_t capacity, const std::string& text) {
+    size_t length = text.size();
+    if (length >= capacity) {
+        length = capacity - 1;
+        while (length > 0 && (static_cast<uint8_t>(text[length]) & 0xC0) == 0x80) length--;
+    }
+    memcpy(out, text.data(), length);
+    out[length] = '\0';
+}
+
+void PutText(uint8_t*& p, const char* text) {
+    size_t length = strlen(text);
+    Put<uint8_t>(p, static_cast<uint8_t>(length));
+    memcpy(p, text, length);
+    p += length;
+}
+
+bool SameFaults(const StateSnapshot& a, const StateSnapshot& b) {
+    if (a.faultVersion == b.faultVersion) return true;
+    if (a.faultCount != b.faultCount) return false;
+    for (uint32_t i = 0; i < a.faultCount; i++) {
+        const StreamFault& x = a.faults[i];
+        const StreamFault& y = b.faults[i];
+        if (x.severity != y.severity || x.timestamp != y.timestamp ||
+            strcmp(x.code, y.code) != 0 || strcmp(x.message, y.message) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// WebSocket binary frame around a message
+void Frame(const uint8_t* payload, size_t size, std::vector<uint8_t>& out) {
+    uint8_t header[ws::kMaxFrameHeader];
+    size_t headerSize = ws::WriteFrameHeader(header, ws::Opcode_Binary, size);
+    out.assign(header, header + headerSize);
+    out.insert(out.end(), payload, payload + size);
+}
+
+} // namespace
+
+void CaptureState(const AppState& state, StateSnapshot& snapshot) {
+    snapshot.speed = state.speed;
+    snapshot.gear = state.gear;
+    snapshot.mainBattery = state.mainBattery;
+    snapshot.suppBattery = state.suppBattery;
+    snapshot.cruise = state.cruise;
+    snapshot.brakeEngaged = state.brakeEngaged;
+    snapshot.contactorStates = state.contactorStates;
+    snapshot.heartbeat = state.heartbeat;
+    snapshot.turnSignal = state.turnSignal;
+
+    uint64_t version = state.faults.Version();
+    if (version == snapshot.faultVersion) return;
+    snapshot.faultVersion = version;
+    snapshot.faultCount = static_cast<uint32_t>(std::min(state.faults.Size(), kMaxStreamFaults));
+    for (uint32_t i = 0; i < snapshot.faultCount; i++) {
+        const FaultAggregator::Entry& entry = state.faults.At(i);
+        StreamFault& fault = snapshot.faults[i];
+        CopyText(fault.code, sizeof(fault.code), entry.code);
+        CopyText(fault.message, sizeof(fault.message), entry.message);
+        fault.severity = entry.severity;
+        fault.timestamp = entry.firstSeen;
+    }
+}
+
+uint16_t DiffState(const StateSnapshot& previous, const StateSnapshot& current) {
+    uint16_t fields = 0;
+    if (ClampI16(previous.speed) != ClampI16(current.speed)) fields |= StateField_Speed;
+    if (previous.gear != current.gear) fields |= StateField_Gear;
+    if (Differs(previous.mainBattery.soc, current.mainBattery.soc)) fields |= StateField_MainSoc;
+    if (Differs(previous.mainBattery.voltage, current.mainBattery.voltage)) fields |= StateField_MainVoltage;
+    if (Differs(previous.mainBattery.current, current.mainBattery.current)) fields |= StateField_MainCurrent;
+    if (Differs(previous.suppBattery.soc, current.suppBattery.soc)) fields |= StateField_SuppSoc;
+    if (Differs(previous.suppBattery.voltage, current.suppBattery.voltage)) fields |= StateField_SuppVoltage;
+    if (previous.cruise.enabled != current.cruise.enabled ||
+        ClampI16(previous.cruise.setSpeed) != ClampI16(current.cruise.setSpeed)) {
+        fields |= StateField_Cruise;
+    }
+    if (previous.brakeEngaged != current.brakeEngaged) fields |= StateField_Brake;
+    if (previous.contactorStates.main != current.contactorStates.main ||
+        previous.contactorStates.precharge != current.contactorStates.precharge ||
+        previous.contactorStates.hvil != current.contactorStates.hvil) {
+        fields |= StateField_Contactors;
+    }
+    if (previous.heartbeat != current.heartbeat) fields |= StateField_Heartbeat;
+    if (previous.turnSignal != current.turnSignal) fields |= StateField_TurnSignal;
+    if (!SameFaults(previous, current)) fields |= StateField_Faults;
+    return fields;
+}
+
+size_t EncodeState(const StateSnapshot& s, uint16_t fields, bool full, uint32_t sequence, uint8_t* out) {
+    if (full) fields = StateField_All;
+    uint8_t* p = out;
+    Put<uint8_t>(p, full ? kKindFull : kKindDelta);
+    Put<uint8_t>(p, kStreamVersion);
+    Put<uint16_t>(p, fields);
+    Put<uint32_t>(p, sequence);
+
+    if (fields & StateField_Speed) Put<int16_t>(p, ClampI16(s.speed));
+    if (fields & StateField_Gear) Put<uint8_t>(p, static_cast<uint8_t>(s.gear));
+    if (fields & StateField_MainSoc) Put<float>(p, s.mainBattery.soc);
+    if (fields & StateField_MainVoltage) Put<float>(p, s.mainBattery.voltage);
+    if (fields & StateField_MainCurrent) Put<float>(p, s.mainBattery.current);
+    if (fields & StateField_SuppSoc) Put<float>(p, s.suppBattery.soc);
+    if (fields & StateField_SuppVoltage) Put<float>(p, s.suppBattery.voltage);
+    if (fields & StateField_Cruise) {
+        Put<uint8_t>(p, s.cruise.enabled ? 1 : 0);
+        Put<int16_t>(p, ClampI16(s.cruise.setSpeed));
+    }
+    if (fields & StateField_Brake) Put<uint8_t>(p, s.brakeEngaged ? 1 : 0);
+    if (fields & StateField_Contactors) {
+        Put<uint8_t>(p, static_cast<uint8_t>((s.contactorStates.main ? 1 : 0) |
+                                             (s.contactorStates.precharge ? 2 : 0) |
+                                             (s.contactorStates.hvil ? 4 : 0)));
+    }
+    if (fields & StateField_Heartbeat) Put<uint8_t>(p, s.heartbeat);
+    if (fields & StateField_TurnSignal) Put<uint8_t>(p, static_cast<uint8_t>(s.turnSignal));
+    if (fields & StateField_Faults) {
+        Put<uint8_t>(p, static_cast<uint8_t>(s.faultCount));
+        for (uint32_t i = 0; i < s.faultCount; i++) {
+            const StreamFault& fault = s.faults[i];
+            Put<uint8_t>(p, static_cast<uint8_t>(fault.severity));
+            Put<double>(p, static_cast<double>(fault.timestamp));
+            PutText(p, fault.code);
+            PutText(p, fault.message);
+        }
+    }
+    return static_cast<size_t>(p - out);
+}
+
+bool ApplyState(const uint8_t* data, size_t size, StateSnapshot& s, uint32_t& sequence, bool& full) {
+    Reader r{ data, data + size };
+    uint8_t kind = 0, version = 0;
+    uint16_t fields = 0;
+    if (!r.Get(kind) || !r.Get(version) || !r.Get(fields) || !r.Get(sequence)) return false;
+    if (kind > kKindDelta || version != kStreamVersion || (fields & ~StateField_All)) return false;
+    full = kind == kKindFull;
+
+    int16_t i16;
+    uint8_t u8;
+    if (fields & StateField_Speed) {
+        if (!r.Get(i16)) return false;
+        s.speed = i16;
+    }
+    if (fields & StateField_Gear) {
+        if (!r.Get(u8) || u8 > static_cast<uint8_t>(Gear::Drive)) return false;
+        s.gear = static_cast<Gear>(u8);
+    }
+    if ((fields & StateField_MainSoc) && !r.Get(s.mainBattery.soc)) return false;
+    if ((fields & StateField_MainVoltage) && !r.Get(s.mainBattery.voltage)) return false;
+    if ((fields & StateField_MainCurrent) && !r.Get(s.mainBattery.current)) return false;
+    if ((fields & StateField_SuppSoc) && !r.Get(s.suppBattery.soc)) return false;
+    if ((fields & StateField_SuppVoltage) && !r.Get(s.suppBattery.voltage)) return false;
+    if (fields & StateField_Cruise) {
+        if (!r.Get(u8) || !r.Get(i16)) return false;
+        s.cruise.enabled = u8 != 0;
+        s.cruise.setSpeed = i16;
+    }
+    if (fields & StateField_Brake) {
+        if (!r.Get(u8)) return false;
+        s.brakeEngaged = u8 != 0;
+    }
+    if (fields & StateField_Contactors) {
+        if (!r.Get(u8)) return false;
+        s.contactorStates = { (u8 & 1) != 0, (u8 & 2) != 0, (u8 & 4) != 0 };
+    }
+    if ((fields & StateField_Heartbeat) && !r.Get(s.heartbeat)) return false;
+    if (fields & StateField_TurnSignal) {
+        if (!r.Get(u8) || u8 > static_cast<uint8_t>(TurnSignal::Right)) return false;
+        s.turnSignal = static_cast<TurnSignal>(u8);
+    }
+    if (fields & StateField_Faults) {
+        uint8_t count;
+        if (!r.Get(count) || count > kMaxStreamFaults) return false;
+        for (uint32_t i = 0; i < count; i++) {
+            StreamFault& fault = s.faults[i];
+            double timestamp;
+            if (!r.Get(u8) || u8 > static_cast<uint8_t>(FaultSeverity::Critical) || !r.Get(timestamp) ||
+                !r.GetText(fault.code, sizeof(fault.code)) || !r.GetText(fault.message, sizeof(fault.message))) {
+                return false;
+            }
+            fault.severity = static_cast<FaultSeverity>(u8);
+            fault.timestamp = static_cast<int64_t>(timestamp);
+        }
+        s.faultCount = count;
+        s.faultVersion++;
+    }
+    return r.p == r.end;
+}
+
+// --- Server ------------------------------------------------------------------
+
+struct StateStreamServer::Client {
+    int fd = -1;
+    std::vector<uint8_t> input;
+    std::vector<uint8_t> queue;
+    size_t sent = 0;
+    bool open = false;          // Handshake done
+    bool synced = false;        // Has every message up to lastSequence queued
+    uint32_t lastSequence = 0;
+    bool closing = false;       // Close once the queue drains
+    bool dead = false;
+
+    size_t Queued() const { return queue.size() - sent; }
+
+    void Append(const uint8_t* data, size_t size) {
+        if (sent > 0) {
+            queue.erase(queue.begin(), queue.begin() + static_cast<std::ptrdiff_t>(sent));
+            sent = 0;
+        }
+        queue.insert(queue.end(), data, data + size);
+    }
+};
+
+StateStreamServer::StateStreamServer(const StateStreamConfig& config) : config_(config) {
+    if (config_.maxClients < 1) config_.maxClients = 1;
+}
+
+StateStreamServer::~StateStreamServer() {
+    Stop();
+}
+
+bool StateStreamServer::Start() {
+    if (running_) return true;
+
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(config_.port);
+    if (inet_pton(AF_INET, config_.bindAddress, &addr.sin_addr) != 1) return false;
+
+    listenFd_ = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    int one = 1;
+    bool ok = listenFd_ >= 0 &&
+              setsockopt(listenFd_, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one)) == 0 &&
+              bind(listenFd_, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)) == 0 &&
+              listen(listenFd_, config_.maxClients) == 0;
+    if (ok) {
+        socklen_t length = sizeof(addr);
+        ok = getsockname(listenFd_, reinterpret_cast<sockaddr*>(&addr), &length) == 0;
+        port_ = ntohs(addr.sin_port);
+    }
+    if (ok) {
+        wakeFd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        ok = wakeFd_ >= 0;
+    }
+    if (!ok) {
+        if (listenFd_ >= 0) close(listenFd_);
+        listenFd_ = -1;
+        return false;
+    }
+
+    stopRequested_.store(false, std::memory_order_relaxed);
+    thread_ = std::thread(&StateStreamServer::ServerMain, this);
+    running_ = true;
+    return true;
+}
+
+void StateStreamServer::Stop() {
+    if (!running_) return;
+
+    stopRequested_.store(true, std::memory_order_relaxed);
+    uint64_t one = 1;
+    (void)!write(wakeFd_, &one, sizeof(one));
+    if (thread_.joinable()) thread_.join();
+
+    for (auto& client : clients_) close(client->fd);
+    clients_.clear();
+    clientCount_.store(0, std::memory_order_relaxed);
+    close(listenFd_);
+    close(wakeFd_);
+    listenFd_ = wakeFd_ = -1;
+    running_ = false;
+}
+
+void StateStreamServer::Publish(const AppState& state) {
+    if (!running_ || clientCount_.load(std::memory_order_relaxed) == 0) return;
+
+    // Most frames change nothing that is streamed: skip the handoff and wakeup
+    CaptureState(state, capture_);
+    if (hasPublished_ && DiffState(published_, capture_) == 0) {
+        skipped_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    published_ = capture_;
+    hasPublished_ = true;
+    {
+        std::lock_guard<std::mutex> lock(pendingMutex_);
+        if (hasPending_) coalesced_.fetch_add(1, std::memory_order_relaxed);
+        pending_ = capture_;
+        hasPending_ = true;
+    }
+    offered_.fetch_add(1, std::memory_order_relaxed);
+
+    // One wakeup per batch: the server clears the flag before taking the state
+    if (!wakeRequested_.exchange(true, std::memory_order_acq_rel)) {
+        uint64_t one = 1;
+        (void)!write(wakeFd_, &one, sizeof(one));
+    }
+}
+
+StateStreamStats StateStreamServer::GetStats() const {
+    StateStreamStats stats;
+    stats.published = offered_.load(std::memory_order_relaxed);
+    stats.skipped = skipped_.load(std::memory_order_relaxed);
+    stats.coalesced = coalesced_.load(std::memory_order_relaxed);
+    stats.unchanged = unchanged_.load(std::memory_order_relaxed);
+    stats.deltas = deltas_.load(std::memory_order_relaxed);
+    stats.fullStates = fullStates_.load(std::memory_order_relaxed);
+    stats.messagesSent = messagesSent_.load(std::memory_order_relaxed);
+    stats.sentBytes = sentBytes_.load(std::memory_order_relaxed);
+    stats.handshakes = handshakes_.load(std::memory_order_relaxed);
+    stats.rejected = rejected_.load(std::memory_order_relaxed);
+    stats.clients = clientCount_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void StateStreamServer::ServerMain() {
+    std::vector<pollfd> fds;
+
+    while (!stopRequested_.load(std::memory_order_relaxed)) {
+        fds.clear();
+        fds.push_back({ listenFd_, POLLIN, 0 });
+        fds.push_back({ wakeFd_, POLLIN, 0 });
+        for (auto& client : clients_) {
+            short events = client->closing ? 0 : POLLIN;
+            if (client->Queued()) events |= POLLOUT;
+            fds.push_back({ client->fd, events, 0 });
+        }
+        poll(fds.data(), fds.size(), 100);
+
+        if (fds[1].revents & POLLIN) {
+            uint64_t count;
+            (void)!read(wakeFd_, &count, sizeof(count));
+        }
+
+        for (size_t c = 0; c < clients_.size(); c++) {
+            short revents = fds[c + 2].revents;
+            if (revents & POLLIN) ReadClient(*clients_[c]);
+            if (revents & (POLLERR | POLLNVAL) || ((revents & POLLHUP) && !(revents & POLLIN))) {
+                clients_[c]->dead = true;
+            }
+        }
+        if (fds[0].revents & POLLIN) AcceptClients();
+
+        EncodeLatest();
+        for (auto& client : clients_) {
+            if (client->dead) continue;
+            if (client->open && !client->synced && !client->closing) QueueFull(*client);
+            if (client->Queued()) FlushClient(*client);
+            if (client->closing && client->Queued() == 0) client->dead = true;
+        }
+
+        size_t alive = 0;
+        for (auto& client : clients_) {
+            if (client->dead) {
+                close(client->fd);
+            } else {
+                clients_[alive++] = std::move(client);
+            }
+        }
+        clients_.resize(alive);
+        clientCount_.store(static_cast<int>(alive), std::memory_order_relaxed);
+    }
+}
+
+void StateStreamServer::AcceptClients() {
+    for (;;) {
+        int fd = accept4(listenFd_, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) return;
+        if (static_cast<int>(clients_.size()) >= config_.maxClients) {
+            rejected_.fetch_add(1, std::memory_order_relaxed);
+            close(fd);
+            continue;
+        }
+        int one = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+
+        std::unique_ptr<Client> client(new Client());
+        client->fd = fd;
+        clients_.push_back(std::move(client));
+    }
+}
+
+void StateStreamServer::ReadClient(Client& client) {
+    for (;;) {
+        size_t size = client.input.size();
+        client.input.resize(size + kReceiveChunk);
+        ssize_t n = recv(client.fd, client.input.data() + size, kReceiveChunk, MSG_DONTWAIT);
+        client.input.resize(size + (n > 0 ? static_cast<size_t>(n) : 0));
+        if (n > 0) continue;
+        if (n < 0 && errno == EINTR) continue;
+        if (n == 0 || (errno != EAGAIN && errno != EWOULDBLOCK)) {
+            client.dead = true;
+            return;
+        }
+        break;
+    }
+
+    if (!client.open) {
+        std::string response;
+        size_t consumed = 0;
+        ws::HandshakeStatus status = ws::ParseHandshake(reinterpret_cast<const char*>(client.input.data()),
+                                                        client.input.size(), response, consumed);
+        if (status == ws::HandshakeStatus::Incomplete) {
+            if (client.input.size() > kMaxRequestSize) {
+                rejected_.fetch_add(1, std::memory_order_relaxed);
+                client.dead = true;
+            }
+            return;
+        }
+        client.Append(reinterpret_cast<const uint8_t*>(response.data()), response.size());
+        client.input.erase(client.input.begin(), client.input.begin() + static_cast<std::ptrdiff_t>(consumed));
+        if (status == ws::HandshakeStatus::Rejected) {
+            rejected_.fetch_add(1, std::memory_order_relaxed);
+            client.closing = true;
+            return;
+        }
+        client.open = true;
+        handshakes_.fetch_add(1, std::memory_order_relaxed);
+    }
+    HandleFrames(client);
+}
+
+void StateStreamServer::HandleFrames(Client& client) {
+    size_t offset = 0;
+    while (!client.closing) {
+        ws::ClientFrame frame;
+        int result = ws::ParseClientFrame(client.input.data() + offset, client.input.size() - offset, frame);
+        if (result < 0 || (result > 0 && frame.payloadSize > kMaxClientPayload)) {
+            rejected_.fetch_add(1, std::memory_order_relaxed);
+            client.dead = true;
+            return;
+        }
+        size_t frameSize = result > 0 ? frame.headerSize + static_cast<size_t>(frame.payloadSize) : 0;
+        if (result == 0 || client.input.size() - offset < frameSize) break;
+
+        uint8_t* payload = client.input.data() + offset + frame.headerSize;
+        size_t payloadSize = static_cast<size_t>(frame.payloadSize);
+        ws::Unmask(payload, payloadSize, frame.mask);
+
+        uint8_t header[ws::kMaxFrameHeader];
+        if (frame.opcode == ws::Opcode_Close) {
+            // Echo the status code, then close once it is out
+            size_t echo = std::min<size_t>(payloadSize, 2);
+            client.Append(header, ws::WriteFrameHeader(header, ws::Opcode_Close, echo));
+            client.Append(payload, echo);
+            client.closing = true;
+        } else if (frame.opcode == ws::Opcode_Ping) {
+            client.Append(header, ws::WriteFrameHeader(header, ws::Opcode_Pong, payloadSize));
+            client.Append(payload, payloadSize);
+        }
+        offset += frameSize;
+    }
+    client.input.erase(client.input.begin(), client.input.begin() + static_cast<std::ptrdiff_t>(offset));
+}
+
+void StateStreamServer::EncodeLatest() {
+    wakeRequested_.store(false, std::memory_order_release);
+    {
+        std::lock_guard<std::mutex> lock(pendingMutex_);
+        if (!hasPending_) return;
+        incoming_ = pending_;
+        hasPending_ = false;
+    }
+
+    uint16_t fields = sequence_ == 0 ? static_cast<uint16_t>(StateField_All) : DiffState(current_, incoming_);
+    if (fields == 0) {
+        unchanged_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    std::swap(current_, incoming_);
+    sequence_++;
+    fullReady_ = false;
+
+    uint8_t message[kMaxStateMessage];
+    size_t size = EncodeState(current_, fields, false, sequence_, message);
+    Frame(message, size, delta_);
+    deltas_.fetch_add(1, std::memory_order_relaxed);
+
+    for (auto& client : clients_) {
+        if (client->dead || !client->open || !client->synced || client->closing) continue;
+
+        // The delta is against sequence N-1: only valid for a client that has it
+        bool fits = client->Queued() + delta_.size() <= config_.maxQueuedBytes;
+        if (client->lastSequence + 1 == sequence_ && fits) {
+            client->Append(delta_.data(), delta_.size());
+            client->lastSequence = sequence_;
+            messagesSent_.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            client->synced = false;
+        }
+    }
+}
+
+void StateStreamServer::QueueFull(Client& client) {
+    if (sequence_ == 0) return;
+    if (!fullReady_) {
+        uint8_t message[kMaxStateMessage];
+        size_t size = EncodeState(current_, StateField_All, true, sequence_, message);
+        Frame(message, size, full_);
+        fullReady_ = true;
+    }
+    // A lagging client drains what it has first, so the full state lands in order
+    if (client.Queued() + full_.size() > config_.maxQueuedBytes) return;
+
+    client.Append(full_.data(), full_.size());
+    client.synced = true;
+    client.lastSequence = sequence_;
+    fullStates_.fetch_add(1, std::memory_order_relaxed);
+    messagesSent_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void StateStreamServer::FlushClient(Client& client) {
+    while (client.sent < client.queue.size()) {
+        ssize_t n = send(client.fd, client.queue.data() + client.sent, client.queue.size() - client.sent,
+                         MSG_NOSIGNAL | MSG_DONTWAIT);
+        if (n > 0) {
+            client.sent += static_cast<size_t>(n);
+            sentBytes_.fetch_add(static_cast<uint64_t>(n), std::memory_order_relaxed);
+        } else if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            return;
+        } else if (n < 0 && errno == EINTR) {
+            continue;
+        } else {
+            client.dead = true;
+            return;
+        }
+    }
+    client.queue.clear();
+    client.sent = 0;
+}
+
+} // namespace stream
+} // namespace ui
@@ -0,0 +1,246 @@
+#pragma once
+
+#include "state.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace ui {
+namespace stream {
+
+/**
+ * Live AppState stream for the browser dashboard (Linux only)
+ *
+ * The fields of lib/types.ts VehicleState are captured from AppState each
+ * frame and sent over WebSocket as binary messages holding only the fields
+ * that changed since the previous message. lib/vehicle-stream.ts decodes
+ * them into VehicleState objects.
+ *
+ * Message (little-endian):
+ *
+ *   0 u8  kind: 0 = full state, 1 = delta
+ *   1 u8  version (1)
+ *   2 u16 field mask (StateField bits)
+ *   4 u32 sequence (+1 per message; a delta applies to sequence - 1)
+ *   8 fields present in the mask, in bit order:
+ *       Speed i16, Gear u8 (P R N D), MainSoc/MainVoltage/MainCurrent/
+ *       SuppSoc/SuppVoltage f32, Cruise u8 enabled + i16 set speed,
+ *       Brake u8, Contactors u8 (bit 0 main, 1 precharge, 2 hvil),
+ *       Heartbeat u8, TurnSignal u8 (none left right),
+ *       Faults u8 count, then per fault: u8 severity (info warning
+ *       critical), f64 timestamp (Unix ms), u8 + code, u8 + message (UTF-8)
+ */
+
+constexpr uint16_t kDefaultStreamPort = 47200;
+constexpr uint8_t kStreamVersion = 1;
+constexpr size_t kMaxStreamFaults = 16;
+constexpr size_t kMaxStateMessage = 8 + 40 + 1 + kMaxStreamFaults * (1 + 8 + 1 + 15 + 1 + 63);
+
+enum StateField : uint16_t {
+    StateField_Speed       = 1 << 0,
+    StateField_Gear        = 1 << 1,
+    StateField_MainSoc     = 1 << 2,
+    StateField_MainVoltage = 1 << 3,
+    StateField_MainCurrent = 1 << 4,
+    StateField_SuppSoc     = 1 << 5,
+    StateField_SuppVoltage = 1 << 6,
+    StateField_Cruise      = 1 << 7,
+    StateField_Brake       = 1 << 8,
+    StateField_Contactors  = 1 << 9,
+    StateField_Heartbeat   = 1 << 10,
+    StateField_TurnSignal  = 1 << 11,
+    StateField_Faults      = 1 << 12,
+    StateField_All         = (1 << 13) - 1,
+};
+
+/**
+ * Displayed fault as streamed (fixed size, no allocation)
+ */
+struct StreamFault {
+    char code[16];
+    char message[64];
+    FaultSeverity severity;
+    int64_t timestamp;          // Unix ms, start of the current episode
+};
+
+/**
+ * The streamed subset of AppState (VehicleState)
+ */
+struct StateSnapshot {
+    int speed = 0;
+    Gear gear = Gear::Park;
+    MainBattery mainBattery{};
+    SuppBattery suppBattery{};
+    CruiseControl cruise{};
+    bool brakeEngaged = false;
+    ContactorStates contactorStates{};
+    uint8_t heartbeat = 0;
+    TurnSignal turnSignal = TurnSignal::None;
+
+    uint64_t faultVersion = ~0ull;   // FaultAggregator::Version() of faults[]
+    uint32_t faultCount = 0;
+    StreamFault faults[kMaxStreamFaults];
+};
+
+/**
+ * Copy the streamed fields of state
+ * The fault list is only copied when the aggregator's version changed.
+ */
+void CaptureState(const AppState& state, StateSnapshot& snapshot);
+
+/**
+ * Fields that differ between two snapshots (exact comparison)
+ */
+uint16_t DiffState(const StateSnapshot& previous, const StateSnapshot& current);
+
+/**
+ * Encode a message with the given fields of snapshot
+ *
+ * @param out At least kMaxStateMessage bytes
+ * @return Message size
+ */
+size_t EncodeState(const StateSnapshot& snapshot, uint16_t fields, bool full, uint32_t sequence, uint8_t* out);
+
+/**
+ * Apply a message to a snapshot (the C++ counterpart of lib/vehicle-stream.ts)
+ *
+ * @param sequence Receives the message's sequence number
+ * @param full Receives true for a full-state message
+ * @return false if the message is malformed
+ */
+bool ApplyState(const uint8_t* data, size_t size, StateSnapshot& snapshot, uint32_t& sequence, bool& full);
+
+/**
+ * Server configuration
+ */
+struct StateStreamConfig {
+    const char* bindAddress = "127.0.0.1";
+    uint16_t port = kDefaultStreamPort;
+    int maxClients = 128;
+    size_t maxQueuedBytes = 64 * 1024;   // Per client; beyond this it skips to a full state
+};
+
+/**
+ * Server counters
+ */
+struct StateStreamStats {
+    uint64_t skipped;        // Publish() calls that changed no streamed field
+    uint64_t published;      // States handed to the server thread
+    uint64_t coalesced;      // Replaced by a newer state before encoding
+    uint64_t unchanged;      // Equal to the last sent state after coalescing
+    uint64_t deltas;         // Delta messages encoded (once for all clients)
+    uint64_t fullStates;     // Full-state messages queued (new or lagging clients)
+    uint64_t messagesSent;   // Messages queued, all clients
+    uint64_t sentBytes;      // Bytes written to sockets, incl. handshakes
+    uint64_t handshakes;     // Successful WebSocket upgrades
+    uint64_t rejected;       // Bad requests, protocol errors, over maxClients
+    int clients;
+};
+
+/**
+ * WebSocket endpoint streaming AppState deltas
+ *
+ * Publish() captures the streamed fields (~100 bytes, plus the fault list
+ * when its version changed) and compares them with the last published
+ * state; only when something changed are they handed to the server thread
+ * through a mutex-protected slot, with at most one eventfd write per
+ * batch. Most frames therefore cost the render thread well under a
+ * microsecond and no syscall. The server thread (poll, non-blocking
+ * sockets) diffs against the last sent state, encodes one delta for all
+ * clients and queues it on each; new clients and clients whose queue
+ * overflowed get a full state instead. Handshake, ping/pong and close are
+ * handled in-house (websocket.h).
+ *
+ * @code
+ *   static ui::stream::StateStreamServer stream({ "0.0.0.0", 47200 });
+ *   stream.Start();
+ *
+ *   // Render loop:
+ *   stream.Publish(state);
+ * @endcode
+ */
+class StateStreamServer {
+public:
+    explicit StateStreamServer(const StateStreamConfig& config = StateStreamConfig());
+    ~StateStreamServer();
+
+    StateStreamServer(const StateStreamServer&) = delete;
+    StateStreamServer& operator=(const StateStreamServer&) = delete;
+
+    /**
+     * Bind the listening socket and launch the server thread
+     * @return false if the socket could not be bound
+     */
+    bool Start();
+
+    /**
+     * Close all connections and join the server thread (idempotent)
+     */
+    void Stop();
+
+    /**
+     * Offer the current state to clients (render thread)
+     * Returns immediately when no client is connected.
+     */
+    void Publish(const AppState& state);
+
+    uint16_t GetPort() const { return port_; }
+    StateStreamStats GetStats() const;
+
+private:
+    struct Client;
+
+    void ServerMain();
+    void AcceptClients();
+    void ReadClient(Client& client);
+    void HandleFrames(Client& client);
+    void EncodeLatest();
+    void QueueFull(Client& client);
+    void FlushClient(Client& client);
+
+    StateStreamConfig config_;
+    int listenFd_ = -1;
+    int wakeFd_ = -1;
+    uint16_t port_ = 0;
+    std::thread thread_;
+    bool running_ = false;
+    std::atomic<bool> stopRequested_{false};
+    std::atomic<bool> wakeRequested_{false};
+    std::atomic<int> clientCount_{0};
+
+    // Render thread -> server thread handoff (newest state wins)
+    std::mutex pendingMutex_;
+    StateSnapshot pending_;
+    bool hasPending_ = false;
+    StateSnapshot capture_;                 // Render thread only
+    StateSnapshot published_;               // Render thread only
+    bool hasPublished_ = false;
+
+    // Server thread only
+    std::vector<std::unique_ptr<Client>> clients_;
+    StateSnapshot current_;                 // Last encoded state
+    StateSnapshot incoming_;
+    std::vector<uint8_t> delta_;            // Framed delta for current_
+    std::vector<uint8_t> full_;             // Framed full state (built on demand)
+    bool fullReady_ = false;
+    uint32_t sequence_ = 0;
+
+    std::atomic<uint64_t> skipped_{0};
+    std::atomic<uint64_t> offered_{0};
+    std::atomic<uint64_t> coalesced_{0};
+    std::atomic<uint64_t> unchanged_{0};
+    std::atomic<uint64_t> deltas_{0};
+    std::atomic<uint64_t> fullStates_{0};
+    std::atomic<uint64_t> messagesSent_{0};
+    std::atomic<uint64_t> sentBytes_{0};
+    std::atomic<uint64_t> handshakes_{0};
+    std::atomic<uint64_t> rejected_{0};
+};
+
+} // namespace stream
+} // namespace ui
@@ -0,0 +1,202 @@
+#pragma once
+
+// Generated from schema/vehicle-state.json by scripts/gen-state.mjs - do not edit
+
+#include "state.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ != __ORDER_LITTLE_ENDIAN__
+#error "state_wire: the wire layout is little-endian"
+#endif
+
+namespace ui {
+
+/**
+ * Fixed-layout VehicleState for sockets, shared memory and mmapped files
+ *
+ * Every member sits at a fixed little-endian offset with natural alignment,
+ * so a received buffer is used in place through ViewWire() (no parsing, no
+ * copies). Members are ordered by alignment, not schema order; strings are
+ * NUL-terminated and truncated at a UTF-8 boundary; enums and bools are one
+ * byte. lib/vehicle-wire.ts reads the same bytes in the browser.
+ */
+
+constexpr uint32_t kWireMagic = 0x31545356;   // "VST1"
+constexpr uint16_t kWireVersion = 1;
+
+constexpr size_t kWireMaxFaults = 16;
+
+struct WireFault {
+    int64_t timestamp;
+    char code[16];
+    char message[64];
+    uint8_t severity;
+    uint8_t pad_[7];
+};
+
+struct WireVehicleState {
+    uint32_t magic;       // kWireMagic
+    uint16_t version;     // kWireVersion
+    uint16_t size;        // sizeof(WireVehicleState)
+    WireFault faults[kWireMaxFaults];
+    int32_t speed;
+    float mainBatterySoc;
+    float mainBatteryVoltage;
+    float mainBatteryCurrent;
+    float suppBatterySoc;
+    float suppBatteryVoltage;
+    int32_t cruiseSetSpeed;
+    uint8_t gear;
+    uint8_t cruiseEnabled;
+    uint8_t brakeEngaged;
+    uint8_t contactorStatesMain;
+    uint8_t contactorStatesPrecharge;
+    uint8_t contactorStatesHvil;
+    uint8_t heartbeat;
+    uint8_t faultsCount;
+    uint8_t turnSignal;
+    uint8_t pad_[3];
+};
+
+static_assert(std::is_trivially_copyable<WireVehicleState>::value, "wire struct must be trivially copyable");
+static_assert(sizeof(WireVehicleState) == 1584, "wire layout changed");
+static_assert(sizeof(WireFault) == 96, "wire layout changed");
+static_assert(offsetof(WireFault, timestamp) == 0, "wire layout changed");
+static_assert(offsetof(WireFault, code) == 8, "wire layout changed");
+static_assert(offsetof(WireFault, message) == 24, "wire layout changed");
+static_assert(offsetof(WireFault, severity) == 88, "wire layout changed");
+static_assert(offsetof(WireVehicleState, faults) == 8, "wire layout changed");
+static_assert(offsetof(WireVehicleState, speed) == 1544, "wire layout changed");
+static_assert(offsetof(WireVehicleState, mainBatterySoc) == 1548, "wire layout changed");
+static_assert(offsetof(WireVehicleState, mainBatteryVoltage) == 1552, "wire layout changed");
+static_assert(offsetof(WireVehicleState, mainBatteryCurrent) == 1556, "wire layout changed");
+static_assert(offsetof(WireVehicleState, suppBatterySoc) == 1560, "wire layout changed");
+static_assert(offsetof(WireVehicleState, suppBatteryVoltage) == 1564, "wire layout changed");
+static_assert(offsetof(WireVehicleState, cruiseSetSpeed) == 1568, "wire layout changed");
+static_assert(offsetof(WireVehicleState, gear) == 1572, "wire layout changed");
+static_assert(offsetof(WireVehicleState, cruiseEnabled) == 1573, "wire layout changed");
+static_assert(offsetof(WireVehicleState, brakeEngaged) == 1574, "wire layout changed");
+static_assert(offsetof(WireVehicleState, contactorStatesMain) == 1575, "wire layout changed");
+static_assert(offsetof(WireVehicleState, contactorStatesPrecharge) == 1576, "wire layout changed");
+static_assert(offsetof(WireVehicleState, contactorStatesHvil) == 1577, "wire layout changed");
+static_assert(offsetof(WireVehicleState, heartbeat) == 1578, "wire layout changed");
+static_assert(offsetof(WireVehicleState, faultsCount) == 1579, "wire layout changed");
+static_assert(offsetof(WireVehicleState, turnSignal) == 1580, "wire layout changed");
+
+// Truncate to capacity - 1 bytes without splitting a UTF-8 sequence, zero-fill the rest
+inline void WireCopyText(char* out, size_t capacity, const std::string& text) {
+    size_t length = text.size();
+    if (length >= capacity) {
+        length = capacity - 1;
+        while (length > 0 && (static_cast<uint8_t>(text[length]) & 0xC0) == 0x80) length--;
+    }
+    memcpy(out, text.data(), length);
+    memset(out + length, 0, capacity - length);
+}
+
+// True if text, truncated as WireCopyText() would, equals the wire string
+inline bool WireTextMatches(const char* wire, size_t capacity, const std::string& text) {
+    char truncated[256];
+    WireCopyText(truncated, std::min(capacity, sizeof(truncated)), text);
+    return strncmp(wire, truncated, capacity) == 0;
+}
+
+inline bool WireSameBits(float a, float b) {
+    return memcmp(&a, &b, sizeof(float)) == 0;
+}
+
+/**
+ * Fill a wire struct from AppState (padding and unused entries zeroed)
+ */
+inline void EncodeWire(const AppState& state, WireVehicleState& out) {
+    memset(&out, 0, sizeof(out));
+    out.magic = kWireMagic;
+    out.version = kWireVersion;
+    out.size = static_cast<uint16_t>(sizeof(WireVehicleState));
+    out.speed = static_cast<int32_t>(state.speed);
+    out.gear = static_cast<uint8_t>(state.gear);
+    out.mainBatterySoc = state.mainBattery.soc;
+    out.mainBatteryVoltage = state.mainBattery.voltage;
+    out.mainBatteryCurrent = state.mainBattery.current;
+    out.suppBatterySoc = state.suppBattery.soc;
+    out.suppBatteryVoltage = state.suppBattery.voltage;
+    out.cruiseEnabled = state.cruise.enabled ? 1 : 0;
+    out.cruiseSetSpeed = static_cast<int32_t>(state.cruise.setSpeed);
+    out.brakeEngaged = state.brakeEngaged ? 1 : 0;
+    out.contactorStatesMain = state.contactorStates.main ? 1 : 0;
+    out.contactorStatesPrecharge = state.contactorStates.precharge ? 1 : 0;
+    out.contactorStatesHvil = state.contactorStates.hvil ? 1 : 0;
+    out.heartbeat = state.heartbeat;
+
+    size_t faultsCount = std::min<size_t>(state.faults.Size(), kWireMaxFaults);
+    out.faultsCount = static_cast<uint8_t>(faultsCount);
+    for (size_t i = 0; i < faultsCount; i++) {
+        const auto& item = state.faults.At(i);
+        WireFault& entry = out.faults[i];
+        WireCopyText(entry.code, sizeof(entry.code), item.code);
+        WireCopyText(entry.message, sizeof(entry.message), item.message);
+        entry.severity = static_cast<uint8_t>(item.severity);
+        entry.timestamp = item.firstSeen;
+    }
+    out.turnSignal = static_cast<uint8_t>(state.turnSignal);
+}
+
+/**
+ * Use a received buffer in place
+ *
+ * @return The buffer as a wire struct, or nullptr if it is too short,
+ *         misaligned, or has the wrong magic, version, size or counts
+ */
+inline const WireVehicleState* ViewWire(const void* data, size_t size) {
+    if (size < sizeof(WireVehicleState)) return nullptr;
+    if (reinterpret_cast<uintptr_t>(data) % alignof(WireVehicleState) != 0) return nullptr;
+    const WireVehicleState* wire = static_cast<const WireVehicleState*>(data);
+    if (wire->magic != kWireMagic || wire->version != kWireVersion || wire->size != sizeof(WireVehicleState)) return nullptr;
+    if (wire->faultsCount > kWireMaxFaults) return nullptr;
+    return wire;
+}
+
+/**
+ * True if the wire struct holds exactly what EncodeWire(state) would write
+ * (floats compared bitwise, strings after truncation)
+ */
+inline bool WireMatches(const WireVehicleState& wire, const AppState& state) {
+    if (!(wire.speed == static_cast<int32_t>(state.speed) &&
+          wire.gear == static_cast<uint8_t>(state.gear) &&
+          WireSameBits(wire.mainBatterySoc, state.mainBattery.soc) &&
+          WireSameBits(wire.mainBatteryVoltage, state.mainBattery.voltage) &&
+          WireSameBits(wire.mainBatteryCurrent, state.mainBattery.current) &&
+          WireSameBits(wire.suppBatterySoc, state.suppBattery.soc) &&
+          WireSameBits(wire.suppBatteryVoltage, state.suppBattery.voltage) &&
+          (wire.cruiseEnabled != 0) == state.cruise.enabled &&
+          wire.cruiseSetSpeed == static_cast<int32_t>(state.cruise.setSpeed) &&
+          (wire.brakeEngaged != 0) == state.brakeEngaged &&
+          (wire.contactorStatesMain != 0) == state.contactorStates.main &&
+          (wire.contactorStatesPrecharge != 0) == state.contactorStates.precharge &&
+          (wire.contactorStatesHvil != 0) == state.contactorStates.hvil &&
+          wire.heartbeat == state.heartbeat &&
+          wire.turnSignal == static_cast<uint8_t>(state.turnSignal))) {
+        return false;
+    }
+
+    size_t faultsCount = std::min<size_t>(state.faults.Size(), kWireMaxFaults);
+    if (wire.faultsCount != faultsCount) return false;
+    for (size_t i = 0; i < faultsCount; i++) {
+        const auto& item = state.faults.At(i);
+        const WireFault& entry = wire.faults[i];
+        if (!(WireTextMatches(entry.code, sizeof(entry.code), item.code) &&
+              WireTextMatches(entry.message, sizeof(entry.message), item.message) &&
+              entry.severity == static_cast<uint8_t>(item.severity) &&
+              entry.timestamp == item.firstSeen)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace ui
@@ -0,0 +1,387 @@
+#include "telemetry_aggregator.h"
+#include "log_histogram.h"
+#include "monotonic_clock.h"
+#include "telemetry_batch.h"
+#include "work_stealing_deque.h"
+#include <thread>
+#include <vector>
+
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace ui {
+namespace fleet {
+
+namespace {
+
+constexpr int kBatchSize = 32;          // Datagrams per recvmmsg call
+// Room for a batched uplink datagram in every receive slot; the receive
+// ring is kBatchesPerWorker * kBatchSize * kMaxDatagram (about 6 MB) per worker
+constexpr int kMaxDatagram = kTelemetryBatchMaxDatagram;  // Larger datagrams are truncated and rejected
+constexpr int kBatchesPerWorker = 128;  // Receive ring per worker (power of two)
+constexpr int kMaxReceivesPerWake = 4;  // Batches pulled off the socket before decoding
+constexpr int kIdleSpins = 64;          // Steal attempts before blocking in poll()
+constexpr int kSocketBufferBytes = 4 * 1024 * 1024;
+
+struct Batch {
+    std::atomic<bool> busy{false};
+    uint32_t count = 0;
+    uint16_t length[kBatchSize];
+    uint8_t data[kBatchSize][kMaxDatagram];
+};
+
+inline void CpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+    asm volatile("yield");
+#endif
+}
+
+inline void Bump(std::atomic<uint64_t>& counter) {
+    counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+
+} // namespace
+
+struct alignas(64) TelemetryAggregator::VehicleSlot {
+    std::atomic<uint64_t> version{0};  // Odd while a writer owns the slot
+    TelemetryPacket packet{};
+};
+
+struct alignas(64) TelemetryAggregator::Worker {
+    int index = 0;
+    int fd = -1;
+    std::thread thread;
+    uint32_t nextBatch = 0;
+    uint32_t rng = 0;
+
+    WorkStealingDeque<uint32_t, kBatchesPerWorker> deque;
+    std::unique_ptr<Batch[]> batches{new Batch[kBatchesPerWorker]};
+
+    // Written only by this worker
+    std::atomic<uint64_t> messages{0};
+    std::atomic<uint64_t> uplinkBatches{0};
+    std::atomic<uint64_t> malformed{0};
+    std::atomic<uint64_t> dropped{0};
+    std::atomic<uint64_t> stale{0};
+    std::atomic<uint64_t> steals{0};
+    LogHistogram latency;
+    std::vector<TelemetryPacket> unpacked;  // Samples of one VTLB datagram
+
+    mmsghdr msgs[kBatchSize];
+    iovec iov[kBatchSize];
+};
+
+TelemetryAggregator::TelemetryAggregator(const AggregatorConfig& config)
+    : config_(config) {
+    if (config_.workers <= 0) {
+        config_.workers = static_cast<int>(std::thread::hardware_concurrency());
+        if (config_.workers <= 0) config_.workers = 1;
+    }
+    if (config_.workers > 0xFFFF) config_.workers = 0xFFFF;
+}
+
+TelemetryAggregator::~TelemetryAggregator() {
+    Stop();
+}
+
+bool TelemetryAggregator::Start() {
+    if (running_) return true;
+
+    slots_.reset(new VehicleSlot[config_.maxVehicles]);
+    workers_.reset(new std::unique_ptr<Worker>[config_.workers]);
+    workerCount_ = config_.workers;
+
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(config_.port);
+    if (inet_pton(AF_INET, config_.bindAddress, &addr.sin_addr) != 1) {
+        workerCount_ = 0;
+        return false;
+    }
+
+    for (int i = 0; i < workerCount_; i++) {
+        workers_[i].reset(new Worker());
+        Worker& worker = *workers_[i];
+        worker.index = i;
+        worker.rng = 0x9E3779B9u * static_cast<uint32_t>(i + 1);
+
+        worker.fd = socket(AF_INET, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        int one = 1;
+        int bufferBytes = kSocketBufferBytes;
+        bool ok = worker.fd >= 0 &&
+                  setsockopt(worker.fd, SOL_SOCKET, SO_REUSEPORT, &one, sizeof(one)) == 0 &&
+                  bind(worker.fd, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)) == 0;
+        if (!ok) {
+            for (int j = 0; j <= i; j++) {
+                if (workers_[j]->fd >= 0) close(workers_[j]->fd);
+            }
+            workers_.reset();
+            workerCount_ = 0;
+            return false;
+        }
+        // Best effort - the kernel clamps this to rmem_max
+        setsockopt(worker.fd, SOL_SOCKET, SO_RCVBUF, &bufferBytes, sizeof(bufferBytes));
+    }
+
+    stopRequested_.store(false, std::memory_order_relaxed);
+    for (int i = 0; i < workerCount_; i++) {
+        workers_[i]->thread = std::thread(&TelemetryAggregator::WorkerMain, this, i);
+    }
+    running_ = true;
+    return true;
+}
+
+void TelemetryAggregator::Stop() {
+    if (!running_) return;
+
+    stopRequested_.store(true, std::memory_order_relaxed);
+    for (int i = 0; i < workerCount_; i++) {
+        if (workers_[i]->thread.joinable()) workers_[i]->thread.join();
+    }
+    for (int i = 0; i < workerCount_; i++) {
+        close(workers_[i]->fd);
+        workers_[i]->fd = -1;
+    }
+    running_ = false;
+}
+
+void TelemetryAggregator::WorkerMain(int index) {
+    Worker& self = *workers_[index];
+    int idle = 0;
+
+    while (!stopRequested_.load(std::memory_order_relaxed)) {
+        uint32_t handle;
+
+        // 1. Own queue first (LIFO - the batch we just received is cache-hot)
+        if (self.deque.Pop(handle)) {
+            ProcessBatch(self, handle);
+            idle = 0;
+            continue;
+        }
+
+        // 2. Drain our socket
+        if (ReceiveBatches(self) > 0) {
+            idle = 0;
+            continue;
+        }
+
+        // 3. Help a busy neighbour
+        if (TrySteal(self, handle)) {
+            ProcessBatch(self, handle);
+            idle = 0;
+            continue;
+        }
+
+        // 4. Nothing to do - spin briefly, then block on our socket
+        if (++idle < kIdleSpins) {
+            CpuRelax();
+            continue;
+        }
+        pollfd pfd{ self.fd, POLLIN, 0 };
+        poll(&pfd, 1, 1);
+        idle = 0;
+    }
+}
+
+int TelemetryAggregator::ReceiveBatches(Worker& worker) {
+    int received = 0;
+
+    for (int wake = 0; wake < kMaxReceivesPerWake; wake++) {
+        Batch& batch = worker.batches[worker.nextBatch];
+        if (batch.busy.load(std::memory_order_acquire)) {
+            break;  // Whole ring is queued or being decoded elsewhere
+        }
+
+        for (int i = 0; i < kBatchSize; i++) {
+            worker.iov[i].iov_base = batch.data[i];
+            worker.iov[i].iov_len = kMaxDatagram;
+            worker.msgs[i].msg_hdr = msghdr{};
+            worker.msgs[i].msg_hdr.msg_iov = &worker.iov[i];
+            worker.msgs[i].msg_hdr.msg_iovlen = 1;
+        }
+
+        int count = recvmmsg(worker.fd, worker.msgs, kBatchSize, MSG_DONTWAIT, nullptr);
+        if (count <= 0) break;
+
+        batch.count = static_cast<uint32_t>(count);
+        for (int i = 0; i < count; i++) {
+            bool truncated = (worker.msgs[i].msg_hdr.msg_flags & MSG_TRUNC) != 0;
+            batch.length[i] = truncated ? 0 : static_cast<uint16_t>(worker.msgs[i].msg_len);
+        }
+        batch.busy.store(true, std::memory_order_relaxed);
+
+        // Cannot fail: at most kBatchesPerWorker batches are busy at once
+        worker.deque.Push((static_cast<uint32_t>(worker.index) << 16) | worker.nextBatch);
+        worker.nextBatch = (worker.nextBatch + 1) & (kBatchesPerWorker - 1);
+        received += count;
+
+        if (count < kBatchSize) break;  // Socket drained
+    }
+
+    return received;
+}
+
+bool TelemetryAggregator::TrySteal(Worker& self, uint32_t& handle) {
+    if (workerCount_ < 2) return false;
+
+    // xorshift32 - random victim order avoids every thief hammering worker 0
+    self.rng ^= self.rng << 13;
+    self.rng ^= self.rng >> 17;
+    self.rng ^= self.rng << 5;
+
+    int start = static_cast<int>(self.rng % static_cast<uint32_t>(workerCount_));
+    for (int n = 0; n < workerCount_; n++) {
+        int victim = (start + n) % workerCount_;
+        if (victim == self.index) continue;
+        if (workers_[victim]->deque.Steal(handle)) return true;
+    }
+    return false;
+}
+
+void TelemetryAggregator::ProcessBatch(Worker& self, uint32_t handle) {
+    Worker& owner = *workers_[handle >> 16];
+    Batch& batch = owner.batches[handle & 0xFFFF];
+    if (&owner != &self) Bump(self.steals);
+
+    uint64_t sendTimes[kBatchSize];
+    uint32_t published = 0;
+
+    for (uint32_t i = 0; i < batch.count; i++) {
+        const uint8_t* data = batch.data[i];
+        size_t length = batch.length[i];
+
+        // Batched uplink: every sample is published, but none counts toward
+        // latency, since the vehicle held them back on purpose
+        if (length >= 4 && detail::LoadLE32(data) == kTelemetryBatchMagic) {
+            if (!DecodeTelemetryBatch(data, length, self.unpacked)) {
+                Bump(self.malformed);
+                continue;
+            }
+            Bump(self.uplinkBatches);
+            if (self.unpacked[0].vehicleId >= config_.maxVehicles) {
+                Bump(self.dropped);
+                continue;
+            }
+            for (const TelemetryPacket& packet : self.unpacked) Publish(self, packet);
+            continue;
+        }
+
+        TelemetryPacket packet;
+        if (!DecodeTelemetryPacket(data, length, packet)) {
+            Bump(self.malformed);
+            continue;
+        }
+        if (packet.vehicleId >= config_.maxVehicles) {
+            Bump(self.dropped);
+            continue;
+        }
+        Publish(self, packet);
+        sendTimes[published++] = packet.sendTimeNs;
+    }
+
+    // Hand the batch back to its owner's ring
+    batch.busy.store(false, std::memory_order_release);
+
+    // One clock read per batch; latency is measured to the end of the batch
+    uint64_t nowNs = MonotonicNowNs();
+    for (uint32_t i = 0; i < published; i++) {
+        self.latency.Record(nowNs > sendTimes[i] ? nowNs - sendTimes[i] : 0);
+    }
+}
+
+void TelemetryAggregator::Publish(Worker& self, const TelemetryPacket& packet) {
+    VehicleSlot& slot = slots_[packet.vehicleId];
+
+    // Per-slot seqlock: an odd version means a writer owns the slot. Two
+    // workers only contend here when a stolen batch and a fresh one carry
+    // the same vehicle.
+    uint64_t version = slot.version.load(std::memory_order_relaxed);
+    for (;;) {
+        if (version & 1) {
+            CpuRelax();
+            version = slot.version.load(std::memory_order_relaxed);
+            continue;
+        }
+        if (slot.version.compare_exchange_weak(version, version + 1, std::memory_order_acquire,
+                                               std::memory_order_relaxed)) {
+            break;
+        }
+    }
+    // Keep the packet stores below from becoming visible before the odd
+    // version; the acquire CAS alone does not order later stores on
+    // weakly ordered CPUs, and a reader could accept a torn packet
+    std::atomic_thread_fence(std::memory_order_release);
+
+    // Wrap-aware sequence check rejects samples overtaken by a newer one
+    bool newer = version == 0 ||
+                 static_cast<int32_t>(packet.sequence - slot.packet.sequence) > 0;
+    if (newer) {
+        slot.packet = packet;
+        Bump(self.messages);
+    } else {
+        Bump(self.stale);
+    }
+
+    slot.version.store(version + 2, std::memory_order_release);
+}
+
+bool TelemetryAggregator::ReadPacket(uint32_t vehicleId, TelemetryPacket& packet) const {
+    if (!slots_ || vehicleId >= config_.maxVehicles) return false;
+    const VehicleSlot& slot = slots_[vehicleId];
+
+    for (;;) {
+        uint64_t before = slot.version.load(std::memory_order_acquire);
+        if (before == 0) return false;
+        if (before & 1) {
+            CpuRelax();
+            continue;
+        }
+
+        TelemetryPacket copy = slot.packet;
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.version.load(std::memory_order_relaxed) == before) {
+            packet = copy;
+            return true;
+        }
+    }
+}
+
+bool TelemetryAggregator::ReadVehicle(uint32_t vehicleId, AppState& state) const {
+    TelemetryPacket packet;
+    if (!ReadPacket(vehicleId, packet)) return false;
+    ApplyTelemetryPacket(packet, state);
+    return true;
+}
+
+AggregatorStats TelemetryAggregator::GetStats() const {
+    AggregatorStats stats{};
+    LogHistogram latency;
+
+    for (int i = 0; i < workerCount_; i++) {
+        const Worker& worker = *workers_[i];
+        stats.messages += worker.messages.load(std::memory_order_relaxed);
+        stats.uplinkBatches += worker.uplinkBatches.load(std::memory_order_relaxed);
+        stats.malformed += worker.malformed.load(std::memory_order_relaxed);
+        stats.dropped += worker.dropped.load(std::memory_order_relaxed);
+        stats.stale += worker.stale.load(std::memory_order_relaxed);
+        stats.steals += worker.steals.load(std::memory_order_relaxed);
+        latency.Merge(worker.latency);
+    }
+
+    stats.latencyP50Ns = latency.Percentile(50.0);
+    stats.latencyP99Ns = latency.Percentile(99.0);
+    stats.latencyMaxNs = latency.Max();
+    return stats;
+}
+
+int TelemetryAggregator::GetWorkerCount() const {
+    return workerCount_;
+}
+
+} // namespace fleet
+} // namespace ui
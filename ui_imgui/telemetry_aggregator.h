@@ -0,0 +1,120 @@
+#pragma once
+
+#include "state.h"
+#include "telemetry_packet.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+namespace ui {
+namespace fleet {
+
+/**
+ * Aggregator configuration
+ */
+struct AggregatorConfig {
+    const char* bindAddress = "127.0.0.1";
+    uint16_t port = 47000;
+    int workers = 0;              // 0 = one per hardware thread
+    uint32_t maxVehicles = 4096;  // Vehicle ids must be < maxVehicles
+};
+
+/**
+ * Aggregate counters across all workers
+ */
+struct AggregatorStats {
+    uint64_t messages;     // Samples decoded and published
+    uint64_t uplinkBatches; // VTLB batch datagrams decoded (their samples count in messages)
+    uint64_t malformed;    // Datagrams rejected by DecodeTelemetryPacket / DecodeTelemetryBatch
+    uint64_t dropped;      // Valid datagrams with an out-of-range vehicle id
+    uint64_t stale;        // Samples older than the slot's current sample
+    uint64_t steals;       // Batches decoded by a worker other than the receiver
+    uint64_t latencyP50Ns; // Send -> publish latency
+    uint64_t latencyP99Ns;
+    uint64_t latencyMaxNs;
+};
+
+/**
+ * Fleet telemetry aggregator (Linux only)
+ *
+ * Every worker owns a UDP socket bound to the same port with SO_REUSEPORT,
+ * so the kernel spreads vehicles across workers by source address. Workers
+ * receive with recvmmsg into batches, queue them on their own work-stealing
+ * deque and decode them; idle workers steal batches from busy ones. Both
+ * single-sample datagrams (telemetry_packet.h) and batched uplink datagrams
+ * (telemetry_batch.h, up to kTelemetryBatchMaxDatagram bytes) are accepted;
+ * send -> publish latency is measured on single-sample datagrams only.
+ *
+ * Decoded samples land in per-vehicle slots guarded by a per-slot seqlock,
+ * so there is no global lock anywhere on the ingest path. Samples arriving
+ * out of order (e.g. a stolen batch finishing late) are discarded by
+ * sequence number.
+ *
+ * @code
+ *   ui::fleet::TelemetryAggregator aggregator({ "0.0.0.0", 47000, 4, 1024 });
+ *   if (!aggregator.Start()) { ... }
+ *
+ *   // Render thread:
+ *   aggregator.ReadVehicle(selectedVehicle, state);
+ * @endcode
+ */
+class TelemetryAggregator {
+public:
+    explicit TelemetryAggregator(const AggregatorConfig& config);
+    ~TelemetryAggregator();
+
+    TelemetryAggregator(const TelemetryAggregator&) = delete;
+    TelemetryAggregator& operator=(const TelemetryAggregator&) = delete;
+
+    /**
+     * Open sockets and launch the worker threads
+     * @return false if a socket could not be bound (nothing is left running)
+     */
+    bool Start();
+
+    /**
+     * Stop and join all workers (idempotent)
+     */
+    void Stop();
+
+    /**
+     * Copy the latest sample for a vehicle into the telemetry fields of state
+     * Lock-free; safe from any thread while the aggregator is running.
+     *
+     * @return false if nothing has been received for this vehicle yet
+     */
+    bool ReadVehicle(uint32_t vehicleId, AppState& state) const;
+
+    /**
+     * Latest raw sample for a vehicle (same semantics as ReadVehicle)
+     */
+    bool ReadPacket(uint32_t vehicleId, TelemetryPacket& packet) const;
+
+    /**
+     * Snapshot of the counters and latency percentiles
+     */
+    AggregatorStats GetStats() const;
+
+    int GetWorkerCount() const;
+    uint32_t GetMaxVehicles() const { return config_.maxVehicles; }
+
+private:
+    struct Worker;
+    struct VehicleSlot;
+
+    void WorkerMain(int index);
+    int ReceiveBatches(Worker& worker);
+    void ProcessBatch(Worker& self, uint32_t handle);
+    bool TrySteal(Worker& self, uint32_t& handle);
+    void Publish(Worker& self, const TelemetryPacket& packet);
+
+    AggregatorConfig config_;
+    std::unique_ptr<VehicleSlot[]> slots_;
+    std::unique_ptr<std::unique_ptr<Worker>[]> workers_;
+    int workerCount_ = 0;
+    bool running_ = false;
+    std::atomic<bool> stopRequested_{false};
+};
+
+} // namespace fleet
+} // namespace ui
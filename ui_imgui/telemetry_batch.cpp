@@ -0,0 +1,208 @@
+#include "telemetry_batch.h"
+#include "telemetry_codec.h"
+
+namespace ui {
+
+static constexpr size_t kBatchHeaderSize = 13;     // Fixed header + first heartbeat
+
+enum BatchFloatCodec : uint8_t {
+    BatchFloat_Xor,
+    BatchFloat_Quantized,
+    BatchFloat_Delta,
+};
+
+enum BatchFloatField {
+    BatchFloat_MainSoc,
+    BatchFloat_MainVoltage,
+    BatchFloat_MainCurrent,
+    BatchFloat_SuppSoc,
+    BatchFloat_SuppVoltage,
+    BatchFloat_Count
+};
+
+// float& or const float& as the packet is
+template <typename Packet>
+static auto& FloatField(Packet& packet, int field) {
+    switch (field) {
+        case BatchFloat_MainSoc: return packet.mainBattery.soc;
+        case BatchFloat_MainVoltage: return packet.mainBattery.voltage;
+        case BatchFloat_MainCurrent: return packet.mainBattery.current;
+        case BatchFloat_SuppSoc: return packet.suppBattery.soc;
+        default: return packet.suppBattery.voltage;
+    }
+}
+
+static float FloatStep(const TelemetryBatchOptions& options, int field) {
+    switch (field) {
+        case BatchFloat_MainSoc:
+        case BatchFloat_SuppSoc: return options.socStep;
+        case BatchFloat_MainCurrent: return options.currentStep;
+        default: return options.voltageStep;
+    }
+}
+
+static uint16_t PacketFlags(const TelemetryPacket& packet) {
+    uint16_t flags = 0;
+    if (packet.brakeEngaged) flags |= TelemetryFlag_Brake;
+    if (packet.cruise.enabled) flags |= TelemetryFlag_CruiseEnabled;
+    if (packet.contactorStates.main) flags |= TelemetryFlag_MainContactor;
+    if (packet.contactorStates.precharge) flags |= TelemetryFlag_Precharge;
+    if (packet.contactorStates.hvil) flags |= TelemetryFlag_Hvil;
+    return flags;
+}
+
+// Int columns in datagram order
+enum BatchIntColumn {
+    BatchInt_Sequence,
+    BatchInt_SendTime,
+    BatchInt_Speed,
+    BatchInt_CruiseSetSpeed,
+    BatchInt_Gear,
+    BatchInt_TurnSignal,
+    BatchInt_Flags,
+    BatchInt_Heartbeat,
+    BatchInt_Count
+};
+
+static int64_t IntField(const TelemetryPacket& packet, const TelemetryPacket& previous, int column) {
+    switch (column) {
+        case BatchInt_Sequence: return packet.sequence;
+        case BatchInt_SendTime: return static_cast<int64_t>(packet.sendTimeNs);
+        case BatchInt_Speed: return packet.speed;
+        case BatchInt_CruiseSetSpeed: return packet.cruise.setSpeed;
+        case BatchInt_Gear: return static_cast<int64_t>(packet.gear);
+        case BatchInt_TurnSignal: return static_cast<int64_t>(packet.turnSignal);
+        case BatchInt_Flags: return PacketFlags(packet);
+        default: return static_cast<uint8_t>(packet.heartbeat - previous.heartbeat);
+    }
+}
+
+static void PutIntColumn(int column, const int64_t* values, size_t count, std::vector<uint8_t>& out) {
+    switch (column) {
+        case BatchInt_Sequence:
+        case BatchInt_Speed:
+        case BatchInt_CruiseSetSpeed: codec::EncodeDelta(values, count, out); break;
+        case BatchInt_SendTime: codec::EncodeDeltaOfDelta(values, count, out); break;
+        default: codec::EncodeFrameOfRef(values, count, out); break;
+    }
+}
+
+static bool GetIntColumn(int column, const uint8_t*& p, const uint8_t* end, size_t count, int64_t* values) {
+    switch (column) {
+        case BatchInt_Sequence:
+        case BatchInt_Speed:
+        case BatchInt_CruiseSetSpeed: return codec::DecodeDelta(p, end, count, values);
+        case BatchInt_SendTime: return codec::DecodeDeltaOfDelta(p, end, count, values);
+        default: return codec::DecodeFrameOfRef(p, end, count, values);
+    }
+}
+
+bool EncodeTelemetryBatch(const TelemetryPacket* packets, size_t count, const TelemetryBatchOptions& options,
+                          std::vector<uint8_t>& out) {
+    if (count == 0 || count > kTelemetryBatchMaxSamples) return false;
+    for (size_t i = 1; i < count; i++) {
+        if (packets[i].vehicleId != packets[0].vehicleId) return false;
+    }
+
+    out.resize(kBatchHeaderSize);
+    detail::StoreLE32(out.data() + 0, kTelemetryBatchMagic);
+    detail::StoreLE16(out.data() + 4, kTelemetryBatchVersion);
+    detail::StoreLE16(out.data() + 6, static_cast<uint16_t>(count));
+    detail::StoreLE32(out.data() + 8, packets[0].vehicleId);
+    out[12] = packets[0].heartbeat;
+
+    std::vector<int64_t> ints(count);
+    for (int column = 0; column < BatchInt_Count; column++) {
+        for (size_t i = 0; i < count; i++) ints[i] = IntField(packets[i], packets[i ? i - 1 : 0], column);
+        PutIntColumn(column, ints.data(), count, out);
+    }
+
+    std::vector<float> floats(count);
+    std::vector<uint8_t> delta;
+    for (int field = 0; field < BatchFloat_Count; field++) {
+        for (size_t i = 0; i < count; i++) floats[i] = FloatField(packets[i], field);
+        float step = FloatStep(options, field);
+        if (step > 0.0f) {
+            out.push_back(BatchFloat_Quantized);
+            codec::EncodeQuantized(floats.data(), count, step, out);
+            continue;
+        }
+        // Lossless: the smaller of XOR and bit-pattern differences
+        size_t at = out.size();
+        out.push_back(BatchFloat_Xor);
+        codec::EncodeXorFloat(floats.data(), count, out);
+        delta.assign(1, BatchFloat_Delta);
+        codec::EncodeFloatDelta(floats.data(), count, delta);
+        if (delta.size() < out.size() - at) {
+            out.resize(at);
+            out.insert(out.end(), delta.begin(), delta.end());
+        }
+    }
+    return true;
+}
+
+bool DecodeTelemetryBatch(const uint8_t* data, size_t size, std::vector<TelemetryPacket>& packets) {
+    if (size < kBatchHeaderSize) return false;
+    if (detail::LoadLE32(data + 0) != kTelemetryBatchMagic) return false;
+    if (detail::LoadLE16(data + 4) != kTelemetryBatchVersion) return false;
+    size_t count = detail::LoadLE16(data + 6);
+    if (count == 0) return false;
+
+    packets.assign(count, TelemetryPacket{});
+    uint32_t vehicleId = detail::LoadLE32(data + 8);
+    uint8_t heartbeat = data[12];
+    const uint8_t* p = data + kBatchHeaderSize;
+    const uint8_t* end = data + size;
+
+    std::vector<int64_t> ints(count);
+    for (int column = 0; column < BatchInt_Count; column++) {
+        if (!GetIntColumn(column, p, end, count, ints.data())) return false;
+        for (size_t i = 0; i < count; i++) {
+            TelemetryPacket& packet = packets[i];
+            int64_t value = ints[i];
+            switch (column) {
+                case BatchInt_Sequence:
+                    packet.vehicleId = vehicleId;
+                    packet.sequence = static_cast<uint32_t>(value);
+                    break;
+                case BatchInt_SendTime: packet.sendTimeNs = static_cast<uint64_t>(value); break;
+                case BatchInt_Speed: packet.speed = static_cast<int>(value); break;
+                case BatchInt_CruiseSetSpeed: packet.cruise.setSpeed = static_cast<int>(value); break;
+                case BatchInt_Gear:
+                    if (value < 0 || value > static_cast<int64_t>(Gear::Drive)) return false;
+                    packet.gear = static_cast<Gear>(value);
+                    break;
+                case BatchInt_TurnSignal:
+                    if (value < 0 || value > static_cast<int64_t>(TurnSignal::Right)) return false;
+                    packet.turnSignal = static_cast<TurnSignal>(value);
+                    break;
+                case BatchInt_Flags:
+                    packet.brakeEngaged = (value & TelemetryFlag_Brake) != 0;
+                    packet.cruise.enabled = (value & TelemetryFlag_CruiseEnabled) != 0;
+                    packet.contactorStates.main = (value & TelemetryFlag_MainContactor) != 0;
+                    packet.contactorStates.precharge = (value & TelemetryFlag_Precharge) != 0;
+                    packet.contactorStates.hvil = (value & TelemetryFlag_Hvil) != 0;
+                    break;
+                default:
+                    heartbeat = static_cast<uint8_t>(heartbeat + value);
+                    packet.heartbeat = heartbeat;
+                    break;
+            }
+        }
+    }
+
+    std::vector<float> floats(count);
+    for (int field = 0; field < BatchFloat_Count; field++) {
+        if (p >= end) return false;
+        uint8_t floatCodec = *p++;
+        bool ok = false;
+        if (floatCodec == BatchFloat_Xor) ok = codec::DecodeXorFloat(p, end, count, floats.data());
+        if (floatCodec == BatchFloat_Quantized) ok = codec::DecodeQuantized(p, end, count, floats.data());
+        if (floatCodec == BatchFloat_Delta) ok = codec::DecodeFloatDelta(p, end, count, floats.data());
+        if (!ok) return false;
+        for (size_t i = 0; i < count; i++) FloatField(packets[i], field) = floats[i];
+    }
+    return p == end;
+}
+
+} // namespace ui
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "telemetry_packet.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ui {
+
+/**
+ * Batched telemetry datagram
+ *
+ * A vehicle that does not need every sample delivered live (logging
+ * uplinks, links billed per byte) buffers its packets and sends them as one
+ * datagram with every field stored as a column (telemetry_codec.h):
+ *
+ *   0  u32 magic 'VTLB'
+ *   4  u16 version (1)
+ *   6  u16 sample count
+ *   8  u32 vehicle id
+ *  12  u8 first heartbeat, then the columns in this order:
+ *        sequence                        Delta
+ *        send time                       DeltaOfDelta
+ *        speed, cruise set speed         Delta
+ *        gear, turn signal, flag bits    FrameOfRef
+ *        heartbeat                       FrameOfRef of the steps modulo 256
+ *        main SOC, voltage, current,     u8 codec, then the stream: 0 XorFloat
+ *        supp SOC, voltage               or 2 FloatDelta (lossless, whichever
+ *                                        is smaller), 1 Quantized
+ *
+ * Batches decode to the same packets the 52-byte datagrams would carry,
+ * except for floats quantized on request. Keep batches to whole codec
+ * blocks (128 samples) where latency allows; a partial block packs less
+ * tightly. The caller sizes batches to the path MTU: TelemetryAggregator
+ * rejects datagrams over kTelemetryBatchMaxDatagram bytes.
+ */
+constexpr uint32_t kTelemetryBatchMagic = 0x424C5456;  // "VTLB"
+constexpr uint16_t kTelemetryBatchVersion = 1;
+constexpr size_t kTelemetryBatchMaxSamples = 65535;
+constexpr size_t kTelemetryBatchMaxDatagram = 1472;    // UDP payload of a 1500-byte IPv4 MTU
+
+/**
+ * Float quantization steps; 0 keeps the field lossless
+ */
+struct TelemetryBatchOptions {
+    float socStep = 0.0f;           // %, main and supp
+    float voltageStep = 0.0f;       // V, main and supp
+    float currentStep = 0.0f;       // A
+};
+
+/**
+ * Encode samples of one vehicle
+ * @param out Replaced with the datagram
+ * @return false if count is 0 or above kTelemetryBatchMaxSamples, or the
+ *         packets are from more than one vehicle
+ */
+bool EncodeTelemetryBatch(const TelemetryPacket* packets, size_t count, const TelemetryBatchOptions& options,
+                          std::vector<uint8_t>& out);
+
+/**
+ * Parse a batch datagram
+ * @param packets Replaced with the samples in send order
+ * @return false if the datagram is truncated, has the wrong magic/version,
+ *         carries out-of-range enum values or has trailing bytes
+ */
+bool DecodeTelemetryBatch(const uint8_t* data, size_t size, std::vector<TelemetryPacket>& packets);
+
+} // namespace ui
@@ -0,0 +1,407 @@
+#include "telemetry_codec.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define UI_CODEC_SSE2 1
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define UI_CODEC_NEON 1
+#endif
+
+namespace ui {
+namespace codec {
+
+static constexpr size_t kLanes = 4;
+static constexpr int kLaneBits = 32;                        // Widest block stored as lanes
+static constexpr size_t kStreamBytes = kBlockValues * 8 + 8;    // Widest bit stream + read slack
+
+static int BitsFor(uint64_t max) {
+    int bits = 0;
+    while (bits < 64 && (max >> bits) != 0) bits++;
+    return bits;
+}
+
+static void PutU32(std::vector<uint8_t>& out, uint32_t value) {
+    size_t at = out.size();
+    out.resize(at + sizeof(value));
+    memcpy(out.data() + at, &value, sizeof(value));
+}
+
+static bool GetU32(const uint8_t*& p, const uint8_t* end, uint32_t& value) {
+    if (end - p < static_cast<std::ptrdiff_t>(sizeof(value))) return false;
+    memcpy(&value, p, sizeof(value));
+    p += sizeof(value);
+    return true;
+}
+
+static uint32_t FloatBits(float value) {
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+// Unpack a full lane-interleaved block of width W and add the reference.
+// Iteration j yields values 4j..4j+3 (one per lane), so the output is in
+// order; W is a template argument so the straddle test and the masks are
+// constants.
+#if defined(UI_CODEC_SSE2)
+template <int W>
+static void UnpackLanes(const uint8_t* in, uint64_t reference, uint64_t* out) {
+    const __m128i* words = reinterpret_cast<const __m128i*>(in);
+    const __m128i mask = _mm_set1_epi32(static_cast<int>(W == 32 ? 0xFFFFFFFFu : (1u << (W & 31)) - 1));
+    const __m128i base = _mm_set1_epi64x(static_cast<int64_t>(reference));
+    const __m128i zero = _mm_setzero_si128();
+    for (int j = 0; j < kLaneBits; j++) {
+        const int bit = j * W;
+        const int shift = bit & 31;
+        __m128i v = _mm_srl_epi32(_mm_loadu_si128(words + (bit >> 5)), _mm_cvtsi32_si128(shift));
+        if (shift + W > 32) {
+            v = _mm_or_si128(v, _mm_sll_epi32(_mm_loadu_si128(words + (bit >> 5) + 1), _mm_cvtsi32_si128(32 - shift)));
+        }
+        v = _mm_and_si128(v, mask);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + j * 4), _mm_add_epi64(_mm_unpacklo_epi32(v, zero), base));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + j * 4 + 2), _mm_add_epi64(_mm_unpackhi_epi32(v, zero), base));
+    }
+}
+#elif defined(UI_CODEC_NEON)
+template <int W>
+static void UnpackLanes(const uint8_t* in, uint64_t reference, uint64_t* out) {
+    const uint32_t* words = reinterpret_cast<const uint32_t*>(in);
+    const uint32x4_t mask = vdupq_n_u32(W == 32 ? 0xFFFFFFFFu : (1u << (W & 31)) - 1);
+    const uint64x2_t base = vdupq_n_u64(reference);
+    for (int j = 0; j < kLaneBits; j++) {
+        const int bit = j * W;
+        const int shift = bit & 31;
+        uint32x4_t v = vshlq_u32(vld1q_u32(words + (bit >> 5) * 4), vdupq_n_s32(-shift));
+        if (shift + W > 32) {
+            v = vorrq_u32(v, vshlq_u32(vld1q_u32(words + ((bit >> 5) + 1) * 4), vdupq_n_s32(32 - shift)));
+        }
+        v = vandq_u32(v, mask);
+        vst1q_u64(out + j * 4, vaddq_u64(vmovl_u32(vget_low_u32(v)), base));
+        vst1q_u64(out + j * 4 + 2, vaddq_u64(vmovl_u32(vget_high_u32(v)), base));
+    }
+}
+#else
+template <int W>
+static void UnpackLanes(const uint8_t* in, uint64_t reference, uint64_t* out) {
+    uint32_t words[W * kLanes];
+    memcpy(words, in, sizeof(words));
+    const uint32_t mask = W == 32 ? 0xFFFFFFFFu : (1u << (W & 31)) - 1;
+    for (int j = 0; j < kLaneBits; j++) {
+        const int bit = j * W;
+        const int shift = bit & 31;
+        for (size_t lane = 0; lane < kLanes; lane++) {
+            uint32_t v = words[(bit >> 5) * kLanes + lane] >> shift;
+            if (shift + W > 32) v |= words[((bit >> 5) + 1) * kLanes + lane] << ((32 - shift) & 31);
+            out[j * kLanes + lane] = reference + (v & mask);
+        }
+    }
+}
+#endif
+
+using UnpackFn = void (*)(const uint8_t* in, uint64_t reference, uint64_t* out);
+
+static const UnpackFn kUnpackLanes[kLaneBits + 1] = {
+    nullptr,
+    UnpackLanes<1>,  UnpackLanes<2>,  UnpackLanes<3>,  UnpackLanes<4>,  UnpackLanes<5>,  UnpackLanes<6>,
+    UnpackLanes<7>,  UnpackLanes<8>,  UnpackLanes<9>,  UnpackLanes<10>, UnpackLanes<11>, UnpackLanes<12>,
+    UnpackLanes<13>, UnpackLanes<14>, UnpackLanes<15>, UnpackLanes<16>, UnpackLanes<17>, UnpackLanes<18>,
+    UnpackLanes<19>, UnpackLanes<20>, UnpackLanes<21>, UnpackLanes<22>, UnpackLanes<23>, UnpackLanes<24>,
+    UnpackLanes<25>, UnpackLanes<26>, UnpackLanes<27>, UnpackLanes<28>, UnpackLanes<29>, UnpackLanes<30>,
+    UnpackLanes<31>, UnpackLanes<32>,
+};
+
+// One block of at most kBlockValues residuals. The reference is the signed
+// minimum, so small negative deltas pack as well as positive ones.
+static void PutBlock(std::vector<uint8_t>& out, const uint64_t* residuals, size_t count) {
+    int64_t lo = static_cast<int64_t>(residuals[0]);
+    int64_t hi = lo;
+    for (size_t i = 1; i < count; i++) {
+        lo = std::min(lo, static_cast<int64_t>(residuals[i]));
+        hi = std::max(hi, static_cast<int64_t>(residuals[i]));
+    }
+    uint64_t reference = static_cast<uint64_t>(lo);
+    int width = BitsFor(static_cast<uint64_t>(hi) - reference);
+    out.push_back(static_cast<uint8_t>(width));
+    PutVarint(out, ZigZag(lo));
+    if (width == 0) return;
+
+    if (count == kBlockValues && width <= kLaneBits) {
+        uint32_t words[kLaneBits * kLanes] = {};
+        for (size_t i = 0; i < count; i++) {
+            uint32_t v = static_cast<uint32_t>(residuals[i] - reference);
+            size_t lane = i % kLanes;
+            size_t bit = (i / kLanes) * static_cast<size_t>(width);
+            size_t word = bit / 32;
+            unsigned shift = static_cast<unsigned>(bit % 32);
+            words[word * kLanes + lane] |= v << shift;
+            if (shift + width > 32) words[(word + 1) * kLanes + lane] |= v >> (32 - shift);
+        }
+        size_t at = out.size();
+        out.resize(at + static_cast<size_t>(width) * kLanes * sizeof(uint32_t));
+        memcpy(out.data() + at, words, static_cast<size_t>(width) * kLanes * sizeof(uint32_t));
+        return;
+    }
+
+    uint8_t stream[kStreamBytes] = {};
+    for (size_t i = 0; i < count; i++) {
+        uint64_t v = residuals[i] - reference;
+        size_t bit = i * static_cast<size_t>(width);
+        size_t at = bit / 8;
+        unsigned shift = static_cast<unsigned>(bit % 8);
+        uint64_t word;
+        memcpy(&word, stream + at, sizeof(word));
+        word |= v << shift;
+        memcpy(stream + at, &word, sizeof(word));
+        if (shift + width > 64) stream[at + 8] |= static_cast<uint8_t>(v >> (64 - shift));
+    }
+    out.insert(out.end(), stream, stream + (count * static_cast<size_t>(width) + 7) / 8);
+}
+
+static bool GetBlock(const uint8_t*& p, const uint8_t* end, size_t count, uint64_t* residuals) {
+    uint64_t zigzag;
+    if (p >= end) return false;
+    int width = *p++;
+    if (width > 64 || !GetVarint(p, end, zigzag)) return false;
+    uint64_t reference = static_cast<uint64_t>(UnZigZag(zigzag));
+    if (width == 0) {
+        std::fill(residuals, residuals + count, reference);
+        return true;
+    }
+
+    if (count == kBlockValues && width <= kLaneBits) {
+        size_t bytes = static_cast<size_t>(width) * kLanes * sizeof(uint32_t);
+        if (static_cast<size_t>(end - p) < bytes) return false;
+        kUnpackLanes[width](p, reference, residuals);
+        p += bytes;
+        return true;
+    }
+
+    // Copied out so the 64-bit reads below may run past the last byte
+    size_t bytes = (count * static_cast<size_t>(width) + 7) / 8;
+    if (static_cast<size_t>(end - p) < bytes) return false;
+    uint8_t stream[kStreamBytes];
+    memcpy(stream, p, bytes);
+    memset(stream + bytes, 0, 8);
+    uint64_t mask = width == 64 ? ~uint64_t(0) : (uint64_t(1) << width) - 1;
+    for (size_t i = 0; i < count; i++) {
+        size_t bit = i * static_cast<size_t>(width);
+        size_t at = bit / 8;
+        unsigned shift = static_cast<unsigned>(bit % 8);
+        uint64_t word;
+        memcpy(&word, stream + at, sizeof(word));
+        uint64_t v = word >> shift;
+        if (shift + width > 64) v |= static_cast<uint64_t>(stream[at + 8]) << (64 - shift);
+        residuals[i] = reference + (v & mask);
+    }
+    p += bytes;
+    return true;
+}
+
+void EncodeFrameOfRef(const int64_t* values, size_t count, std::vector<uint8_t>& out) {
+    for (size_t first = 0; first < count; first += kBlockValues) {
+        PutBlock(out, reinterpret_cast<const uint64_t*>(values + first), std::min(kBlockValues, count - first));
+    }
+}
+
+bool DecodeFrameOfRef(const uint8_t*& p, const uint8_t* end, size_t count, int64_t* values) {
+    for (size_t first = 0; first < count; first += kBlockValues) {
+        if (!GetBlock(p, end, std::min(kBlockValues, count - first), reinterpret_cast<uint64_t*>(values + first))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// The first residual of Delta and DeltaOfDelta is 0 and the start values go
+// in the header, so a large first value does not widen the first block.
+
+void EncodeDelta(const int64_t* values, size_t count, std::vector<uint8_t>& out) {
+    if (count == 0) return;
+    PutVarint(out, ZigZag(values[0]));
+    uint64_t block[kBlockValues];
+    uint64_t previous = static_cast<uint64_t>(values[0]);
+    for (size_t first = 0; first < count; first += kBlockValues) {
+        size_t n = std::min(kBlockValues, count - first);
+        for (size_t i = 0; i < n; i++) {
+            uint64_t value = static_cast<uint64_t>(values[first + i]);
+            block[i] = value - previous;
+            previous = value;
+        }
+        PutBlock(out, block, n);
+    }
+}
+
+bool DecodeDelta(const uint8_t*& p, const uint8_t* end, size_t count, int64_t* values) {
+    if (count == 0) return true;
+    uint64_t zigzag;
+    if (!GetVarint(p, end, zigzag)) return false;
+    uint64_t value = static_cast<uint64_t>(UnZigZag(zigzag));
+    for (size_t first = 0; first < count; first += kBlockValues) {
+        size_t n = std::min(kBlockValues, count - first);
+        uint64_t* block = reinterpret_cast<uint64_t*>(values + first);
+        if (!GetBlock(p, end, n, block)) return false;
+        for (size_t i = 0; i < n; i++) {
+            value += block[i];
+            block[i] = value;
+        }
+    }
+    return true;
+}
+
+void EncodeDeltaOfDelta(const int64_t* values, size_t count, std::vector<uint8_t>& out) {
+    if (count == 0) return;
+    uint64_t delta = count > 1 ? static_cast<uint64_t>(values[1]) - static_cast<uint64_t>(values[0]) : 0;
+    PutVarint(out, ZigZag(values[0]));
+    PutVarint(out, ZigZag(static_cast<int64_t>(delta)));
+    // Start one step before values[0] so the first two residuals are 0
+    uint64_t block[kBlockValues];
+    uint64_t previous = static_cast<uint64_t>(values[0]) - delta;
+    for (size_t first = 0; first < count; first += kBlockValues) {
+        size_t n = std::min(kBlockValues, count - first);
+        for (size_t i = 0; i < n; i++) {
+            uint64_t value = static_cast<uint64_t>(values[first + i]);
+            uint64_t next = value - previous;
+            block[i] = next - delta;
+            delta = next;
+            previous = value;
+        }
+        PutBlock(out, block, n);
+    }
+}
+
+bool DecodeDeltaOfDelta(const uint8_t*& p, const uint8_t* end, size_t count, int64_t* values) {
+    if (count == 0) return true;
+    uint64_t zigzag;
+    uint64_t zigzagDelta;
+    if (!GetVarint(p, end, zigzag) || !GetVarint(p, end, zigzagDelta)) return false;
+    uint64_t delta = static_cast<uint64_t>(UnZigZag(zigzagDelta));
+    uint64_t value = static_cast<uint64_t>(UnZigZag(zigzag)) - delta;
+    for (size_t first = 0; first < count; first += kBlockValues) {
+        size_t n = std::min(kBlockValues, count - first);
+        uint64_t* block = reinterpret_cast<uint64_t*>(values + first);
+        if (!GetBlock(p, end, n, block)) return false;
+        for (size_t i = 0; i < n; i++) {
+            delta += block[i];
+            value += delta;
+            block[i] = value;
+        }
+    }
+    return true;
+}
+
+void EncodeXorFloat(const float* values, size_t count, std::vector<uint8_t>& out) {
+    if (count == 0) return;
+    uint32_t previous = FloatBits(values[0]);
+    PutU32(out, previous);
+    uint64_t block[kBlockValues];
+    for (size_t first = 0; first < count; first += kBlockValues) {
+        size_t n = std::min(kBlockValues, count - first);
+        for (size_t i = 0; i < n; i++) {
+            uint32_t bits = FloatBits(values[first + i]);
+            block[i] = bits ^ previous;
+            previous = bits;
+        }
+        PutBlock(out, block, n);
+    }
+}
+
+bool DecodeXorFloat(const uint8_t*& p, const uint8_t* end, size_t count, float* values) {
+    if (count == 0) return true;
+    uint32_t bits;
+    if (!GetU32(p, end, bits)) return false;
+    uint64_t block[kBlockValues];
+    for (size_t first = 0; first < count; first += kBlockValues) {
+        size_t n = std::min(kBlockValues, count - first);
+        if (!GetBlock(p, end, n, block)) return false;
+        for (size_t i = 0; i < n; i++) {
+            bits ^= static_cast<uint32_t>(block[i]);
+            memcpy(values + first + i, &bits, sizeof(bits));
+        }
+    }
+    return true;
+}
+
+void EncodeFloatDelta(const float* values, size_t count, std::vector<uint8_t>& out) {
+    if (count == 0) return;
+    uint32_t previous = FloatBits(values[0]);
+    PutU32(out, previous);
+    uint64_t block[kBlockValues];
+    for (size_t first = 0; first < count; first += kBlockValues) {
+        size_t n = std::min(kBlockValues, count - first);
+        for (size_t i = 0; i < n; i++) {
+            uint32_t bits = FloatBits(values[first + i]);
+            block[i] = static_cast<uint64_t>(static_cast<int64_t>(static_cast<int32_t>(bits - previous)));
+            previous = bits;
+        }
+        PutBlock(out, block, n);
+    }
+}
+
+bool DecodeFloatDelta(const uint8_t*& p, const uint8_t* end, size_t count, float* values) {
+    if (count == 0) return true;
+    uint32_t bits;
+    if (!GetU32(p, end, bits)) return false;
+    uint64_t block[kBlockValues];
+    for (size_t first = 0; first < count; first += kBlockValues) {
+        size_t n = std::min(kBlockValues, count - first);
+        if (!GetBlock(p, end, n, block)) return false;
+        for (size_t i = 0; i < n; i++) {
+            bits += static_cast<uint32_t>(block[i]);
+            memcpy(values + first + i, &bits, sizeof(bits));
+        }
+    }
+    return true;
+}
+
+static int64_t Quantize(float value, double step) {
+    double scaled = static_cast<double>(value) / step;
+    if (std::isnan(scaled)) return 0;
+    scaled = std::min(std::max(scaled, -4.6e18), 4.6e18);
+    return std::llround(scaled);
+}
+
+void EncodeQuantized(const float* values, size_t count, float step, std::vector<uint8_t>& out) {
+    if (count == 0) return;
+    PutU32(out, FloatBits(step));
+    uint64_t previous = static_cast<uint64_t>(Quantize(values[0], step));
+    PutVarint(out, ZigZag(static_cast<int64_t>(previous)));
+    uint64_t block[kBlockValues];
+    for (size_t first = 0; first < count; first += kBlockValues) {
+        size_t n = std::min(kBlockValues, count - first);
+        for (size_t i = 0; i < n; i++) {
+            uint64_t value = static_cast<uint64_t>(Quantize(values[first + i], step));
+            block[i] = value - previous;
+            previous = value;
+        }
+        PutBlock(out, block, n);
+    }
+}
+
+bool DecodeQuantized(const uint8_t*& p, const uint8_t* end, size_t count, float* values) {
+    if (count == 0) return true;
+    uint32_t stepBits;
+    if (!GetU32(p, end, stepBits)) return false;
+    float step;
+    memcpy(&step, &stepBits, sizeof(step));
+    if (!(step > 0.0f) || std::isinf(step)) return false;
+    uint64_t zigzag;
+    if (!GetVarint(p, end, zigzag)) return false;
+    uint64_t value = static_cast<uint64_t>(UnZigZag(zigzag));
+    uint64_t block[kBlockValues];
+    for (size_t first = 0; first < count; first += kBlockValues) {
+        size_t n = std::min(kBlockValues, count - first);
+        if (!GetBlock(p, end, n, block)) return false;
+        for (size_t i = 0; i < n; i++) {
+            value += block[i];
+            values[first + i] = static_cast<float>(static_cast<double>(static_cast<int64_t>(value)) * step);
+        }
+    }
+    return true;
+}
+
+} // namespace codec
+} // namespace ui
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ui {
+namespace codec {
+
+/**
+ * Telemetry stream codecs
+ *
+ * Integer and float series (timestamps, counters, slowly changing battery
+ * values) are turned into small residuals by a predictor and the residuals
+ * are bit-packed with frame of reference, 128 values per block:
+ *
+ *   Delta          v[i] - v[i-1]                    counters, speed, set points
+ *   DeltaOfDelta   (v[i] - v[i-1]) - (v[i-1] - v[i-2])   regular timestamps
+ *   FrameOfRef     v[i] itself                      enums, booleans, indices
+ *   XorFloat       bits[i] ^ bits[i-1]              floats, lossless
+ *   FloatDelta     bits[i] - bits[i-1]              monotone floats, lossless
+ *   Quantized      round(v[i] / step), then Delta   floats, error <= step / 2
+ *
+ * Block layout: u8 width, zigzag varint reference (the block minimum), then
+ * each residual minus the reference in width bits. A full block with width
+ * <= 32 is stored as four interleaved 32-bit lanes (value i in lane i % 4)
+ * and decodes with one shift/mask per four values (SSE2, NEON, or a scalar
+ * fallback); the last, partial block and wider blocks are a plain little-
+ * endian bit stream. A block of equal residuals is just its header.
+ *
+ * Streams do not store their length: the caller keeps the value count (row
+ * group size, batch header) and passes it to both sides. Every decoder
+ * advances p past what it read and returns false on truncated or malformed
+ * input, never reading outside [p, end).
+ */
+constexpr size_t kBlockValues = 128;
+
+inline uint64_t ZigZag(int64_t value) {
+    return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+inline int64_t UnZigZag(uint64_t value) {
+    return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+/**
+ * LEB128 varints (7 bits per byte, low first)
+ */
+inline size_t VarintSize(uint64_t value) {
+    size_t size = 1;
+    while (value >= 0x80) {
+        value >>= 7;
+        size++;
+    }
+    return size;
+}
+
+inline void PutVarint(std::vector<uint8_t>& out, uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(value));
+}
+
+inline bool GetVarint(const uint8_t*& p, const uint8_t* end, uint64_t& value) {
+    value = 0;
+    for (int shift = 0; shift < 64 && p < end; shift += 7) {
+        uint8_t byte = *p++;
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) return true;
+    }
+    return false;
+}
+
+void EncodeFrameOfRef(const int64_t* values, size_t count, std::vector<uint8_t>& out);
+bool DecodeFrameOfRef(const uint8_t*& p, const uint8_t* end, size_t count, int64_t* values);
+
+void EncodeDelta(const int64_t* values, size_t count, std::vector<uint8_t>& out);
+bool DecodeDelta(const uint8_t*& p, const uint8_t* end, size_t count, int64_t* values);
+
+void EncodeDeltaOfDelta(const int64_t* values, size_t count, std::vector<uint8_t>& out);
+bool DecodeDeltaOfDelta(const uint8_t*& p, const uint8_t* end, size_t count, int64_t* values);
+
+void EncodeXorFloat(const float* values, size_t count, std::vector<uint8_t>& out);
+bool DecodeXorFloat(const uint8_t*& p, const uint8_t* end, size_t count, float* values);
+
+void EncodeFloatDelta(const float* values, size_t count, std::vector<uint8_t>& out);
+bool DecodeFloatDelta(const uint8_t*& p, const uint8_t* end, size_t count, float* values);
+
+/**
+ * Lossy: values are rounded to multiples of step (> 0, stored in the
+ * stream) and decode to within step / 2. NaN decodes as 0 and values
+ * beyond +-2^62 steps saturate; use XorFloat where that matters.
+ */
+void EncodeQuantized(const float* values, size_t count, float step, std::vector<uint8_t>& out);
+bool DecodeQuantized(const uint8_t*& p, const uint8_t* end, size_t count, float* values);
+
+} // namespace codec
+} // namespace ui
@@ -0,0 +1,205 @@
+#pragma once
+
+#include "state.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace ui {
+
+/**
+ * Telemetry datagram exchanged between vehicles and the fleet aggregator
+ *
+ * Fixed 52-byte little-endian layout:
+ *
+ *   0  u32 magic 'VTLM'     24 i16 speed (km/h)      36 f32 main voltage
+ *   4  u16 version (1)      26 u8  gear              40 f32 main current
+ *   6  u16 flag bits        27 u8  turn signal       44 f32 supp SOC
+ *   8  u32 vehicle id       28 u8  heartbeat         48 f32 supp voltage
+ *  12  u32 sequence         29 u8  reserved
+ *  16  u64 send time (ns)   30 u16 cruise set speed
+ *                           32 f32 main SOC
+ */
+constexpr uint32_t kTelemetryMagic = 0x4D4C5456;  // "VTLM"
+constexpr uint16_t kTelemetryVersion = 1;
+constexpr size_t kTelemetryPacketSize = 52;
+
+/**
+ * Flag bits in the packet header
+ */
+enum TelemetryFlags : uint16_t {
+    TelemetryFlag_Brake          = 1 << 0,
+    TelemetryFlag_CruiseEnabled  = 1 << 1,
+    TelemetryFlag_MainContactor  = 1 << 2,
+    TelemetryFlag_Precharge      = 1 << 3,
+    TelemetryFlag_Hvil           = 1 << 4,
+};
+
+/**
+ * Decoded telemetry sample for one vehicle
+ * Plain data: safe to copy under a seqlock.
+ */
+struct TelemetryPacket {
+    uint32_t vehicleId;
+    uint32_t sequence;
+    uint64_t sendTimeNs;    // Sender's monotonic clock
+    int speed;
+    Gear gear;
+    TurnSignal turnSignal;
+    uint8_t heartbeat;
+    bool brakeEngaged;
+    CruiseControl cruise;
+    ContactorStates contactorStates;
+    MainBattery mainBattery;
+    SuppBattery suppBattery;
+};
+
+namespace detail {
+
+inline void StoreLE16(uint8_t* p, uint16_t v) {
+    p[0] = static_cast<uint8_t>(v);
+    p[1] = static_cast<uint8_t>(v >> 8);
+}
+
+inline void StoreLE32(uint8_t* p, uint32_t v) {
+    for (int i = 0; i < 4; i++) p[i] = static_cast<uint8_t>(v >> (i * 8));
+}
+
+inline void StoreLE64(uint8_t* p, uint64_t v) {
+    for (int i = 0; i < 8; i++) p[i] = static_cast<uint8_t>(v >> (i * 8));
+}
+
+inline void StoreLEFloat(uint8_t* p, float v) {
+    uint32_t bits;
+    memcpy(&bits, &v, sizeof(bits));
+    StoreLE32(p, bits);
+}
+
+inline uint16_t LoadLE16(const uint8_t* p) {
+    return static_cast<uint16_t>(p[0] | (p[1] << 8));
+}
+
+inline uint32_t LoadLE32(const uint8_t* p) {
+    return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+           (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+inline uint64_t LoadLE64(const uint8_t* p) {
+    return static_cast<uint64_t>(LoadLE32(p)) | (static_cast<uint64_t>(LoadLE32(p + 4)) << 32);
+}
+
+inline float LoadLEFloat(const uint8_t* p) {
+    uint32_t bits = LoadLE32(p);
+    float v;
+    memcpy(&v, &bits, sizeof(v));
+    return v;
+}
+
+} // namespace detail
+
+/**
+ * Build a packet from the current dashboard state
+ */
+inline TelemetryPacket MakeTelemetryPacket(const AppState& state, uint32_t vehicleId,
+                                           uint32_t sequence, uint64_t sendTimeNs) {
+    TelemetryPacket packet{};
+    packet.vehicleId = vehicleId;
+    packet.sequence = sequence;
+    packet.sendTimeNs = sendTimeNs;
+    packet.speed = state.speed;
+    packet.gear = state.gear;
+    packet.turnSignal = state.turnSignal;
+    packet.heartbeat = state.heartbeat;
+    packet.brakeEngaged = state.brakeEngaged;
+    packet.cruise = state.cruise;
+    packet.contactorStates = state.contactorStates;
+    packet.mainBattery = state.mainBattery;
+    packet.suppBattery = state.suppBattery;
+    return packet;
+}
+
+/**
+ * Copy a decoded sample into the telemetry fields of an AppState
+ * Faults and camera textures are left untouched.
+ */
+inline void ApplyTelemetryPacket(const TelemetryPacket& packet, AppState& state) {
+    state.speed = packet.speed;
+    state.gear = packet.gear;
+    state.turnSignal = packet.turnSignal;
+    state.heartbeat = packet.heartbeat;
+    state.brakeEngaged = packet.brakeEngaged;
+    state.cruise = packet.cruise;
+    state.contactorStates = packet.contactorStates;
+    state.mainBattery = packet.mainBattery;
+    state.suppBattery = packet.suppBattery;
+}
+
+/**
+ * Serialize a packet
+ * @return Bytes written, or 0 if the buffer is too small
+ */
+inline size_t EncodeTelemetryPacket(const TelemetryPacket& packet, uint8_t* out, size_t outSize) {
+    if (outSize < kTelemetryPacketSize) return 0;
+
+    uint16_t flags = 0;
+    if (packet.brakeEngaged) flags |= TelemetryFlag_Brake;
+    if (packet.cruise.enabled) flags |= TelemetryFlag_CruiseEnabled;
+    if (packet.contactorStates.main) flags |= TelemetryFlag_MainContactor;
+    if (packet.contactorStates.precharge) flags |= TelemetryFlag_Precharge;
+    if (packet.contactorStates.hvil) flags |= TelemetryFlag_Hvil;
+
+    detail::StoreLE32(out + 0, kTelemetryMagic);
+    detail::StoreLE16(out + 4, kTelemetryVersion);
+    detail::StoreLE16(out + 6, flags);
+    detail::StoreLE32(out + 8, packet.vehicleId);
+    detail::StoreLE32(out + 12, packet.sequence);
+    detail::StoreLE64(out + 16, packet.sendTimeNs);
+    detail::StoreLE16(out + 24, static_cast<uint16_t>(static_cast<int16_t>(packet.speed)));
+    out[26] = static_cast<uint8_t>(packet.gear);
+    out[27] = static_cast<uint8_t>(packet.turnSignal);
+    out[28] = packet.heartbeat;
+    out[29] = 0;
+    detail::StoreLE16(out + 30, static_cast<uint16_t>(packet.cruise.setSpeed));
+    detail::StoreLEFloat(out + 32, packet.mainBattery.soc);
+    detail::StoreLEFloat(out + 36, packet.mainBattery.voltage);
+    detail::StoreLEFloat(out + 40, packet.mainBattery.current);
+    detail::StoreLEFloat(out + 44, packet.suppBattery.soc);
+    detail::StoreLEFloat(out + 48, packet.suppBattery.voltage);
+    return kTelemetryPacketSize;
+}
+
+/**
+ * Parse a datagram
+ * @return false if the datagram is truncated, has the wrong magic/version
+ *         or carries out-of-range enum values
+ */
+inline bool DecodeTelemetryPacket(const uint8_t* data, size_t size, TelemetryPacket& out) {
+    if (size < kTelemetryPacketSize) return false;
+    if (detail::LoadLE32(data + 0) != kTelemetryMagic) return false;
+    if (detail::LoadLE16(data + 4) != kTelemetryVersion) return false;
+    if (data[26] > static_cast<uint8_t>(Gear::Drive)) return false;
+    if (data[27] > static_cast<uint8_t>(TurnSignal::Right)) return false;
+
+    uint16_t flags = detail::LoadLE16(data + 6);
+    out.vehicleId = detail::LoadLE32(data + 8);
+    out.sequence = detail::LoadLE32(data + 12);
+    out.sendTimeNs = detail::LoadLE64(data + 16);
+    out.speed = static_cast<int16_t>(detail::LoadLE16(data + 24));
+    out.gear = static_cast<Gear>(data[26]);
+    out.turnSignal = static_cast<TurnSignal>(data[27]);
+    out.heartbeat = data[28];
+    out.brakeEngaged = (flags & TelemetryFlag_Brake) != 0;
+    out.cruise.enabled = (flags & TelemetryFlag_CruiseEnabled) != 0;
+    out.cruise.setSpeed = detail::LoadLE16(data + 30);
+    out.contactorStates.main = (flags & TelemetryFlag_MainContactor) != 0;
+    out.contactorStates.precharge = (flags & TelemetryFlag_Precharge) != 0;
+    out.contactorStates.hvil = (flags & TelemetryFlag_Hvil) != 0;
+    out.mainBattery.soc = detail::LoadLEFloat(data + 32);
+    out.mainBattery.voltage = detail::LoadLEFloat(data + 36);
+    out.mainBattery.current = detail::LoadLEFloat(data + 40);
+    out.suppBattery.soc = detail::LoadLEFloat(data + 44);
+    out.suppBattery.voltage = detail::LoadLEFloat(data + 48);
+    return true;
+}
+
+} // namespace ui
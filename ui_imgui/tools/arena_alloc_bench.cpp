@@ -0,0 +1,248 @@
+/**
+ * Arena allocator correctness, latency and steady-state check
+ *
+ * Three parts, all with ArenaAllocator (arena_alloc.h) installed as global
+ * operator new through arena_operators.cpp:
+ *   threads    --threads threads allocate random sizes (16 B - 64 KB, some
+ *              1 MB), fill them, and swap them through shared slots, so
+ *              blocks are freed on other threads than the one that
+ *              allocated them. Every block's fill is checked on free.
+ *   latency    alloc/free pairs of the same size mix on one thread, arena
+ *              vs. malloc, p50 / p99.9 / max
+ *   state      AppState fault traffic: faults (std::string code and
+ *              message) reported, repeated and resolved, and the session
+ *              history growing. One cycle warms up, then the arena is sealed
+ *              and --cycles more must not reach malloc.
+ *   lifetime   Free() of a plain malloc block, and an arena destroyed with a
+ *              block outstanding: the arena must stop serving ArenaNew()
+ *              and the late free must be harmless.
+ *
+ * Usage:
+ *   arena_alloc_bench [--threads N] [--ops N] [--cycles N] [--arena-mb MB]
+ *
+ * Build (Linux):
+ *   g++ -O2 -std=c++17 -pthread -I.. arena_alloc_bench.cpp ../arena_alloc.cpp ../arena_operators.cpp \
+ *       ../fault_aggregator.cpp ../fault_history.cpp ../fault_journal.cpp ../cell_telemetry.cpp
+ */
+
+#include "../arena_alloc.h"
+#include "../monotonic_clock.h"
+#include "../state.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct Options {
+    int threads = 4;
+    int ops = 200000;       // Per thread, and latency samples per allocator
+    int cycles = 200;       // Fault cycles after warm-up
+    int arenaMb = 64;
+};
+
+constexpr int kSlots = 1024;
+constexpr int kFaultCodes = 16;
+
+volatile uint64_t g_sink;
+
+// Mostly small, log-distributed, with the occasional large buffer
+size_t RandomSize(std::mt19937& rng) {
+    uint32_t r = rng();
+    if (r % 1000 == 0) return static_cast<size_t>(1) << 20;
+    int shift = 4 + static_cast<int>((r >> 10) % 13);              // 16 B .. 64 KB
+    return (static_cast<size_t>(1) << shift) + (r >> 24) % (static_cast<size_t>(1) << shift);
+}
+
+// Block layout: size, then bytes derived from it
+void* FillBlock(void* ptr, size_t size) {
+    unsigned char* bytes = static_cast<unsigned char*>(ptr);
+    memcpy(bytes, &size, sizeof(size));
+    for (size_t i = sizeof(size); i + 1 < size; i += 61) bytes[i] = static_cast<unsigned char>(size + i);
+    bytes[size - 1] = static_cast<unsigned char>(size * 7);
+    return ptr;
+}
+
+bool CheckBlock(const void* ptr) {
+    const unsigned char* bytes = static_cast<const unsigned char*>(ptr);
+    size_t size;
+    memcpy(&size, bytes, sizeof(size));
+    for (size_t i = sizeof(size); i + 1 < size; i += 61) {
+        if (bytes[i] != static_cast<unsigned char>(size + i)) return false;
+    }
+    return bytes[size - 1] == static_cast<unsigned char>(size * 7);
+}
+
+bool RunThreads(ui::ArenaAllocator& arena, const Options& options) {
+    std::vector<std::atomic<void*>> slots(kSlots);
+    for (std::atomic<void*>& slot : slots) slot.store(nullptr);
+    std::atomic<int> corrupt{0};
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < options.threads; t++) {
+        threads.emplace_back([&, t] {
+            std::mt19937 rng(1234 + t);
+            for (int op = 0; op < options.ops; op++) {
+                size_t size = std::max(sizeof(size_t) + 1, RandomSize(rng));
+                void* block = FillBlock(arena.Allocate(size), size);
+                void* previous = slots[rng() % kSlots].exchange(block, std::memory_order_acq_rel);
+                if (previous) {
+                    if (!CheckBlock(previous)) corrupt.fetch_add(1);
+                    ui::ArenaAllocator::Free(previous);
+                }
+            }
+        });
+    }
+    for (std::thread& thread : threads) thread.join();
+
+    for (std::atomic<void*>& slot : slots) {
+        void* block = slot.exchange(nullptr);
+        if (!block) continue;
+        if (!CheckBlock(block)) corrupt.fetch_add(1);
+        ui::ArenaAllocator::Free(block);
+    }
+
+    ui::ArenaAllocStats totals = arena.GetTotals();
+    printf("threads        %d x %d ops, %llu carved, %llu malloc, %d corrupt, %.1f MB arena used\n",
+           options.threads, options.ops, static_cast<unsigned long long>(totals.carved),
+           static_cast<unsigned long long>(totals.heap), corrupt.load(), arena.GetArenaUsed() / 1048576.0);
+    return corrupt.load() == 0 && arena.GetOutstanding() == 0 && totals.frees == totals.allocations - totals.heap;
+}
+
+template <typename Alloc, typename Free>
+void MeasureLatency(const char* name, int ops, Alloc alloc, Free release) {
+    std::mt19937 rng(99);
+    std::vector<uint64_t> samples(static_cast<size_t>(ops));
+    // A working set that stays allocated, like a frame's buffers
+    std::vector<void*> live(256, nullptr);
+    for (int i = 0; i < ops; i++) {
+        size_t size = RandomSize(rng);
+        size_t slot = rng() % live.size();
+        uint64_t start = ui::MonotonicNowNs();
+        release(live[slot]);
+        live[slot] = alloc(size);
+        samples[static_cast<size_t>(i)] = ui::MonotonicNowNs() - start;
+        static_cast<unsigned char*>(live[slot])[0] = 1;
+    }
+    for (void* block : live) release(block);
+
+    std::sort(samples.begin(), samples.end());
+    printf("  %-12s %8llu %8llu %10llu ns\n", name, static_cast<unsigned long long>(samples[samples.size() / 2]),
+           static_cast<unsigned long long>(samples[samples.size() * 999 / 1000]),
+           static_cast<unsigned long long>(samples.back()));
+}
+
+// One cycle of fault traffic through the state containers
+void FaultCycle(ui::AppState& state, int cycle) {
+    for (int i = 0; i < kFaultCodes; i++) {
+        ui::Fault fault;
+        char code[8];
+        snprintf(code, sizeof(code), "E%03d", i);
+        fault.code = code;
+        fault.message = "Cell module over temperature, derating drive power";
+        fault.severity = static_cast<ui::FaultSeverity>(i % 3);
+        fault.timestamp = 1700000000000ll + cycle * 1000 + i;
+        ui::ReportFault(state, fault);
+        ui::ReportFault(state, fault);   // Repeat: bumps the count
+    }
+    for (int i = 0; i < kFaultCodes; i++) {
+        char code[8];
+        snprintf(code, sizeof(code), "E%03d", i);
+        state.faults.Resolve(code);
+    }
+}
+
+void PrintUsage() {
+    printf("usage: arena_alloc_bench [--threads N] [--ops N] [--cycles N] [--arena-mb MB]\n");
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+
+        if (value && strcmp(arg, "--threads") == 0) {
+            options.threads = atoi(value); i++;
+        } else if (value && strcmp(arg, "--ops") == 0) {
+            options.ops = atoi(value); i++;
+        } else if (value && strcmp(arg, "--cycles") == 0) {
+            options.cycles = atoi(value); i++;
+        } else if (value && strcmp(arg, "--arena-mb") == 0) {
+            options.arenaMb = atoi(value); i++;
+        } else {
+            PrintUsage();
+            return 1;
+        }
+    }
+
+    if (options.threads <= 0 || options.ops <= 0 || options.cycles <= 0 || options.arenaMb <= 0) {
+        PrintUsage();
+        return 1;
+    }
+
+    bool ok = true;
+    {
+        ui::ArenaAllocator arena(static_cast<size_t>(options.arenaMb) << 20);
+        ok &= RunThreads(arena, options);
+
+        printf("latency        %-8s %8s %10s\n", "p50", "p99.9", "max");
+        MeasureLatency("arena", options.ops, [&](size_t size) { return arena.Allocate(size); },
+                       [](void* ptr) { ui::ArenaAllocator::Free(ptr); });
+        MeasureLatency("malloc", options.ops, [](size_t size) { return malloc(size); }, [](void* ptr) { free(ptr); });
+    }
+
+    // Never destroyed: the state's blocks (and any static's) are freed into it
+    ui::ArenaAllocator* arena = new ui::ArenaAllocator(static_cast<size_t>(options.arenaMb) << 20);
+    ui::ArenaAllocator::SetGlobal(arena);
+    {
+        ui::FaultHistory history;
+        ui::AppState state = ui::CreateDefaultState();
+        state.faultHistory = &history;
+        FaultCycle(state, 0);
+        arena->Seal();
+
+        uint64_t peak = 0;
+        ui::ArenaAllocStats total;
+        for (int cycle = 1; cycle <= options.cycles; cycle++) {
+            arena->BeginFrame();
+            FaultCycle(state, cycle);
+            ui::ArenaAllocStats frame = arena->GetFrameStats();
+            total.allocations += frame.allocations;
+            total.carved += frame.carved;
+            peak = std::max(peak, frame.allocations);
+        }
+        g_sink = history.Size();
+        printf("state          %d cycles, %.1f allocations/cycle (peak %llu), %llu carved, %llu malloc after warm-up\n",
+               options.cycles, static_cast<double>(total.allocations) / options.cycles,
+               static_cast<unsigned long long>(peak), static_cast<unsigned long long>(total.carved),
+               static_cast<unsigned long long>(arena->GetHeapSinceSeal()));
+        ok &= arena->GetHeapSinceSeal() == 0;
+    }
+    ui::ArenaAllocator::SetGlobal(nullptr);
+
+    {
+        ui::ArenaAllocator::Free(malloc(48));
+
+        ui::ArenaAllocator* shortLived = new ui::ArenaAllocator(1 << 20);
+        ui::ArenaAllocator::SetGlobal(shortLived);
+        void* late = ui::ArenaNew(64);
+        delete shortLived;
+        bool unrouted = ui::ArenaAllocator::GetGlobal() == nullptr;
+        ui::ArenaAllocator::Free(late);
+        printf("lifetime       foreign free ok, late free after destruction ok, %s\n",
+               unrouted ? "unrouted" : "STILL ROUTED");
+        ok &= unrouted;
+    }
+
+    printf("%s\n", ok ? "OK" : "FAILED");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,397 @@
+/**
+ * CAN log parse/replay check and benchmark
+ *
+ * Writes a synthetic candump and Vector ASC log of --frames random frames
+ * (classic, extended, remote and FD on two channels) to --dir and checks
+ * (can_log.h, can_replay.h):
+ *   roundtrip  every frame parsed back from both files matches what was written
+ *   rate       max-speed ReplayCanLog() into a counting sink parses at least
+ *              --min-rate frames/s for each format (best of three passes)
+ *   timing     a 1 s log replayed at 4x finishes in 250 ms, no frame later
+ *              than --max-late-us behind schedule
+ *   decoder    Intel / Motorola, signed and bit signals decoded from a log
+ *              and applied to an AppState through the signal bus
+ *   asc        "base dec" and relative timestamps
+ *
+ * Usage:
+ *   can_log_bench [--frames N] [--dir PATH] [--min-rate N] [--max-late-us US]
+ *
+ * Build (Linux):
+ *   g++ -O2 -std=c++17 -pthread -I.. can_log_bench.cpp ../can_log.cpp ../can_replay.cpp ../signal_bus.cpp \
+ *       ../signal_interp.cpp ../signal_freshness.cpp \
+ *       ../fault_aggregator.cpp ../fault_history.cpp ../fault_journal.cpp ../cell_telemetry.cpp
+ */
+
+#include "../can_replay.h"
+#include "../monotonic_clock.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct Options {
+    size_t frames = 2000000;
+    std::string dir = "/tmp";
+    double minRate = 5000000.0;
+    double maxLateUs = 2000.0;
+};
+
+constexpr uint64_t kLogStartNs = 1760000000ull * 1000000000ull;    // candump Unix time base
+constexpr uint8_t kFdLengths[] = { 12, 16, 20, 24, 32, 48, 64 };
+
+std::vector<ui::CanFrame> MakeFrames(size_t count, uint64_t spanNs, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::vector<ui::CanFrame> frames(count);
+    uint64_t step = count > 1 ? spanNs / count : 0;
+    uint64_t time = 0;
+    for (size_t i = 0; i < count; i++) {
+        ui::CanFrame& frame = frames[i];
+        memset(&frame, 0, sizeof(frame));
+        // Microsecond timestamps, as both formats print them
+        time += (step ? rng() % (2 * step) : 0) / 1000 * 1000;
+        frame.timeNs = time;
+        frame.channel = static_cast<uint8_t>(rng() % 2);
+
+        uint32_t kind = rng() % 20;
+        if (kind < 3) {
+            frame.flags = ui::CanFrame_Extended;
+            frame.id = rng() & 0x1fffffffu;
+        } else {
+            frame.id = rng() & 0x7ffu;
+        }
+        if (kind == 3) {
+            frame.flags |= ui::CanFrame_Remote;
+            frame.len = static_cast<uint8_t>(rng() % 9);
+        } else if (kind < 6) {
+            frame.flags |= ui::CanFrame_Fd;
+            if (rng() & 1) frame.flags |= ui::CanFrame_Brs;
+            frame.len = (rng() & 1) ? static_cast<uint8_t>(rng() % 9) : kFdLengths[rng() % 7];
+        } else {
+            frame.len = static_cast<uint8_t>(rng() % 9);
+        }
+        if (!(frame.flags & ui::CanFrame_Remote)) {
+            for (int b = 0; b < frame.len; b++) frame.data[b] = static_cast<uint8_t>(rng());
+        }
+    }
+    return frames;
+}
+
+bool WriteCandump(const char* path, const std::vector<ui::CanFrame>& frames) {
+    FILE* file = fopen(path, "w");
+    if (!file) return false;
+    for (const ui::CanFrame& frame : frames) {
+        uint64_t ns = kLogStartNs + frame.timeNs;
+        fprintf(file, "(%llu.%06llu) can%d ", static_cast<unsigned long long>(ns / 1000000000ull),
+                static_cast<unsigned long long>(ns % 1000000000ull / 1000), frame.channel);
+        fprintf(file, (frame.flags & ui::CanFrame_Extended) ? "%08X#" : "%03X#", frame.id);
+        if (frame.flags & ui::CanFrame_Remote) {
+            fputc('R', file);
+            if (frame.len) fputc('0' + frame.len, file);
+        } else {
+            if (frame.flags & ui::CanFrame_Fd) fprintf(file, "#%X", (frame.flags & ui::CanFrame_Brs) ? 1 : 0);
+            for (int b = 0; b < frame.len; b++) fprintf(file, "%02X", frame.data[b]);
+        }
+        fputc('\n', file);
+    }
+    return fclose(file) == 0;
+}
+
+int FdDlc(int length) {
+    static const int kLengths[16] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 12, 16, 20, 24, 32, 48, 64 };
+    for (int dlc = 0; dlc < 16; dlc++) {
+        if (kLengths[dlc] >= length) return dlc;
+    }
+    return 15;
+}
+
+bool WriteAsc(const char* path, const std::vector<ui::CanFrame>& frames) {
+    FILE* file = fopen(path, "w");
+    if (!file) return false;
+    fprintf(file, "date Mon Oct 19 10:00:00.000 am 2026\n");
+    fprintf(file, "base hex  timestamps absolute\n");
+    fprintf(file, "internal events logged\n");
+    fprintf(file, "// version 9.0.0\n");
+    fprintf(file, "Begin Triggerblock Mon Oct 19 10:00:00.000 am 2026\n");
+    fprintf(file, "   0.000000 Start of measurement\n");
+    for (const ui::CanFrame& frame : frames) {
+        double seconds = static_cast<double>(frame.timeNs / 1000) * 1e-6;
+        char id[16];
+        snprintf(id, sizeof(id), (frame.flags & ui::CanFrame_Extended) ? "%Xx" : "%X", frame.id);
+        if (frame.flags & ui::CanFrame_Fd) {
+            fprintf(file, "%11.6f CANFD %3d Rx %10s %s %d 0 %X %2d", seconds, frame.channel + 1, id,
+                    (frame.id & 1) ? "EngineData" : "", (frame.flags & ui::CanFrame_Brs) ? 1 : 0,
+                    FdDlc(frame.len), frame.len);
+            for (int b = 0; b < frame.len; b++) fprintf(file, " %02X", frame.data[b]);
+            fprintf(file, "   102203 %d 303000 0 0 0 0 0\n", 64 + frame.len * 10);
+        } else if (frame.flags & ui::CanFrame_Remote) {
+            fprintf(file, "%11.6f %d  %-15s Rx   r %X\n", seconds, frame.channel + 1, id, frame.len);
+        } else {
+            fprintf(file, "%11.6f %d  %-15s Rx   d %X", seconds, frame.channel + 1, id, frame.len);
+            for (int b = 0; b < frame.len; b++) fprintf(file, " %02X", frame.data[b]);
+            fprintf(file, "  Length = 228000 BitCount = 117 ID = %u%s\n", frame.id,
+                    (frame.flags & ui::CanFrame_Extended) ? "x" : "");
+        }
+        if ((&frame - frames.data()) % 100000 == 99999) {
+            fprintf(file, "%11.6f 1  Statistic: D 0 R 0 XD 0 XR 0 E 0 O 0 B 0.00%%\n", seconds);
+        }
+    }
+    fprintf(file, "End TriggerBlock\n");
+    return fclose(file) == 0;
+}
+
+bool SameFrame(const ui::CanFrame& a, const ui::CanFrame& b) {
+    const uint8_t flagMask = static_cast<uint8_t>(~ui::CanFrame_Tx);
+    return a.timeNs == b.timeNs && a.id == b.id && a.len == b.len && a.channel == b.channel &&
+           (a.flags & flagMask) == (b.flags & flagMask) &&
+           ((a.flags & ui::CanFrame_Remote) || memcmp(a.data, b.data, a.len) == 0);
+}
+
+// Compare a parsed log against the frames written; ASC channels are 1-based
+bool CheckRoundTrip(const char* label, const char* path, const std::vector<ui::CanFrame>& expected,
+                    uint64_t timeBaseNs, int channelBase, ui::CanLogFormat format) {
+    ui::CanLogReader reader;
+    if (!reader.Open(path) || reader.GetFormat() != format) {
+        printf("%-14s cannot open %s\n", label, path);
+        return false;
+    }
+
+    ui::CanFrame frames[512];
+    size_t index = 0;
+    size_t mismatches = 0;
+    while (size_t count = reader.Read(frames, 512)) {
+        for (size_t i = 0; i < count; i++, index++) {
+            if (index >= expected.size()) {
+                mismatches++;
+                continue;
+            }
+            ui::CanFrame want = expected[index];
+            want.timeNs += timeBaseNs;
+            want.channel = static_cast<uint8_t>(want.channel + channelBase);
+            if (!SameFrame(frames[i], want)) {
+                if (mismatches++ == 0) {
+                    printf("%-14s first mismatch at frame %zu: id %X len %d flags %02X\n", label, index,
+                           frames[i].id, frames[i].len, frames[i].flags);
+                }
+            }
+        }
+    }
+    bool ok = index == expected.size() && mismatches == 0;
+    printf("%-14s %zu frames, %zu mismatches, %llu other lines, %d channels\n", label, index, mismatches,
+           static_cast<unsigned long long>(reader.GetSkippedLines()),
+           format == ui::CanLogFormat::Candump ? reader.GetChannelCount() : 2);
+    return ok;
+}
+
+bool CountFrames(const ui::CanFrame* frames, size_t count, void* userData) {
+    uint64_t* sum = static_cast<uint64_t*>(userData);
+    for (size_t i = 0; i < count; i++) *sum += frames[i].id;
+    return true;
+}
+
+bool CheckRate(const char* label, const char* path, double minRate) {
+    ui::CanLogReader reader;
+    if (!reader.Open(path)) return false;
+
+    ui::CanReplayOptions options;
+    options.speed = 0.0;
+    double best = 0.0;
+    ui::CanReplayStats stats;
+    for (int run = 0; run < 3; run++) {
+        uint64_t sum = 0;
+        if (!ui::ReplayCanLog(reader, options, CountFrames, &sum, &stats)) return false;
+        best = std::max(best, static_cast<double>(stats.frames) * 1e9 / static_cast<double>(stats.elapsedNs));
+    }
+    printf("%-14s %.2f M frames/s, %.0f MB/s (%.1f bytes/frame)\n", label, best * 1e-6,
+           best * static_cast<double>(stats.bytes) / static_cast<double>(stats.frames) * 1e-6,
+           static_cast<double>(stats.bytes) / static_cast<double>(stats.frames));
+    return best >= minRate;
+}
+
+bool CheckTiming(const Options& options) {
+    // 2000 frames over one second, replayed at 4x
+    std::vector<ui::CanFrame> frames = MakeFrames(2000, 1000000000ull, 11);
+    std::string path = options.dir + "/can_log_bench_timing.log";
+    if (!WriteCandump(path.c_str(), frames)) return false;
+
+    ui::CanLogReader reader;
+    if (!reader.Open(path.c_str())) return false;
+    ui::CanReplayOptions replay;
+    replay.speed = 4.0;
+    ui::CanReplayStats stats;
+    uint64_t sum = 0;
+    bool ok = ui::ReplayCanLog(reader, replay, CountFrames, &sum, &stats);
+
+    double expectedMs = static_cast<double>(frames.back().timeNs - frames.front().timeNs) / 4.0 * 1e-6;
+    double elapsedMs = static_cast<double>(stats.elapsedNs) * 1e-6;
+    double maxLateUs = static_cast<double>(stats.maxLateNs) * 1e-3;
+    printf("%-14s %llu frames in %llu batches, %.1f ms (log span / 4 = %.1f ms), max late %.0f us\n", "timing 4x",
+           static_cast<unsigned long long>(stats.frames), static_cast<unsigned long long>(stats.batches),
+           elapsedMs, expectedMs, maxLateUs);
+    remove(path.c_str());
+    return ok && stats.frames == frames.size() && std::fabs(elapsedMs - expectedMs) < 1.0 + options.maxLateUs * 1e-3 &&
+           maxLateUs <= options.maxLateUs;
+}
+
+bool CheckDecoder() {
+    ui::SignalBus bus;
+    ui::DashboardBusSignals signals = ui::RegisterDashboardBusSignals(bus);
+    ui::BusProducer* can = bus.AddProducer("can");
+    ui::BusConsumer* consumer = bus.AddConsumer("ui");
+    bus.SubscribeAll(consumer);
+
+    ui::CanDecoder decoder(can);
+    bool ok = true;
+
+    ui::CanSignalDef def;
+    def.id = 0x123;                                     // Speed: Intel 16 bit, 0.01 km/h
+    def.length = 16;
+    def.scale = 0.01f;
+    def.signal = signals.speed.index;
+    ok &= decoder.AddSignal(bus, def);
+
+    def = ui::CanSignalDef();
+    def.id = 0x123;                                     // Brake: bit 20
+    def.startBit = 20;
+    def.signal = signals.brakeEngaged.index;
+    ok &= decoder.AddSignal(bus, def);
+
+    def = ui::CanSignalDef();
+    def.id = 0x18ff1001;                                // Current: Motorola signed 16 bit at byte 0, 0.1 A
+    def.extended = true;
+    def.startBit = 7;
+    def.length = 16;
+    def.bigEndian = true;
+    def.isSigned = true;
+    def.scale = 0.1f;
+    def.signal = signals.mainCurrent.index;
+    ok &= decoder.AddSignal(bus, def);
+
+    def = ui::CanSignalDef();
+    def.id = 0x18ff1001;                                // Heartbeat: Motorola 8 bit in byte 2
+    def.extended = true;
+    def.startBit = 23;
+    def.length = 8;
+    def.bigEndian = true;
+    def.signal = signals.heartbeat.index;
+    ok &= decoder.AddSignal(bus, def);
+
+    def = ui::CanSignalDef();
+    def.id = 0x7ff;                                     // Past the payload: rejected
+    def.startBit = 510;
+    def.length = 8;
+    def.signal = signals.gear.index;
+    ok &= !decoder.AddSignal(bus, def);
+    bus.Start();
+
+    // 10000 * 0.01 = 100 km/h, brake bit 20 set; -123 * 0.1 = -12.3 A, heartbeat 0xA5
+    static const char kLog[] =
+        "(1760000000.000100) can0 123#1027100000000000\n"
+        "(1760000000.000200) can0 18FF1001#FF85A5\n"
+        "(1760000000.000300) can0 456#0102\n"
+        "(1760000000.000400) can0 123#R\n";
+    ui::CanLogReader reader;
+    ok &= reader.OpenBuffer(kLog, sizeof(kLog) - 1);
+    ui::CanReplayOptions replay;
+    replay.speed = 0.0;
+    ok &= ui::ReplayCanLog(reader, replay, ui::CanDecoder::Sink, &decoder);
+
+    ui::AppState state = ui::CreateDefaultState();
+    state.brakeEngaged = false;
+    size_t applied = ui::DrainBusUpdates(state, *consumer, signals);
+    ok &= applied == 4 && state.speed == 100 && state.brakeEngaged && state.heartbeat == 0xa5 &&
+          std::fabs(state.mainBattery.current + 12.3f) < 1e-4f;
+    ok &= decoder.GetDecodedFrames() == 2 && decoder.GetUnknownFrames() == 1;
+
+    printf("%-14s %zu signals applied: speed %d, brake %d, current %.1f, heartbeat 0x%02X: %s\n", "decoder", applied,
+           state.speed, state.brakeEngaged ? 1 : 0, state.mainBattery.current, state.heartbeat, ok ? "ok" : "WRONG");
+    return ok;
+}
+
+bool CheckAscVariants() {
+    static const char kLog[] =
+        "date Mon Oct 19 10:00:00.000 am 2026\r\n"
+        "base dec  timestamps relative\r\n"
+        "Begin Triggerblock Mon Oct 19 10:00:00.000 am 2026\r\n"
+        "   0.000000 Start of measurement\r\n"
+        "   0.010000 1  291             Rx   d 2 1 255\r\n"
+        "   0.005000 2  419360000x      Tx   d 1 16\r\n"
+        "   0.001000 1  ErrorFrame\r\n"
+        "   0.002000 1  291             Rx   r\r\n"
+        "End TriggerBlock\r\n";
+    ui::CanLogReader reader;
+    bool ok = reader.OpenBuffer(kLog, sizeof(kLog) - 1) && reader.GetFormat() == ui::CanLogFormat::Asc;
+    ui::CanFrame frames[8];
+    size_t count = ok ? reader.Read(frames, 8) : 0;
+    ok &= count == 3;
+    if (ok) {
+        ok &= frames[0].id == 291 && frames[0].len == 2 && frames[0].data[1] == 255 && frames[0].timeNs == 10000000;
+        ok &= frames[1].id == 419360000 && (frames[1].flags & ui::CanFrame_Extended) &&
+              (frames[1].flags & ui::CanFrame_Tx) && frames[1].channel == 2 && frames[1].timeNs == 15000000;
+        ok &= (frames[2].flags & ui::CanFrame_Remote) && frames[2].timeNs == 18000000;
+    }
+    printf("%-14s base dec, relative timestamps, CRLF: %s\n", "asc variants", ok ? "ok" : "WRONG");
+    return ok;
+}
+
+void PrintUsage() {
+    printf("usage: can_log_bench [--frames N] [--dir PATH] [--min-rate N] [--max-late-us US]\n");
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+
+        if (value && strcmp(arg, "--frames") == 0) {
+            options.frames = static_cast<size_t>(atoll(value)); i++;
+        } else if (value && strcmp(arg, "--dir") == 0) {
+            options.dir = value; i++;
+        } else if (value && strcmp(arg, "--min-rate") == 0) {
+            options.minRate = atof(value); i++;
+        } else if (value && strcmp(arg, "--max-late-us") == 0) {
+            options.maxLateUs = atof(value); i++;
+        } else {
+            PrintUsage();
+            return 1;
+        }
+    }
+
+    if (options.frames == 0) {
+        PrintUsage();
+        return 1;
+    }
+
+    // One hour of traffic compressed into the frame count
+    std::vector<ui::CanFrame> frames = MakeFrames(options.frames, 3600ull * 1000000000ull, 7);
+    std::string candump = options.dir + "/can_log_bench.log";
+    std::string asc = options.dir + "/can_log_bench.asc";
+    if (!WriteCandump(candump.c_str(), frames) || !WriteAsc(asc.c_str(), frames)) {
+        printf("cannot write logs to %s\n", options.dir.c_str());
+        return 1;
+    }
+
+    bool ok = true;
+    ok &= CheckRoundTrip("candump", candump.c_str(), frames, kLogStartNs, 0, ui::CanLogFormat::Candump);
+    ok &= CheckRoundTrip("asc", asc.c_str(), frames, 0, 1, ui::CanLogFormat::Asc);
+    ok &= CheckRate("candump rate", candump.c_str(), options.minRate);
+    ok &= CheckRate("asc rate", asc.c_str(), options.minRate);
+    ok &= CheckTiming(options);
+    ok &= CheckDecoder();
+    ok &= CheckAscVariants();
+
+    remove(candump.c_str());
+    remove(asc.c_str());
+
+    printf("%s\n", ok ? "OK" : "FAILED");
+    return ok ? 0 : 1;
+}
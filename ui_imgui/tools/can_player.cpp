@@ -0,0 +1,219 @@
+/**
+ * CAN log player
+ *
+ * Replays a candump (-l / -L) or Vector ASC log (can_log.h, can_replay.h)
+ * into a SocketCAN interface, into the signal decoder, or both. Without
+ * --vcan or --signal it only parses, which measures the parse rate.
+ *
+ * Usage:
+ *   can_player LOG [--vcan IFACE] [--speed X | --max-speed] [--loops N]
+ *              [--signal NAME,ID,START,LENGTH[,SCALE[,OFFSET]][,be][,signed][,ext]]...
+ *
+ *   --speed X    X times the original timing (default 1)
+ *   --max-speed  no timing: as fast as the sink takes frames
+ *   --loops 0    repeat until Ctrl-C
+ *   --signal     decode a dashboard bus signal (e.g. vehicle.speed) from
+ *                frame ID (hex with 0x), DBC start bit and length; be =
+ *                Motorola byte order, ext = 29-bit ID. Repeatable. The
+ *                decoded values are applied to an AppState and printed at
+ *                the end.
+ *
+ *   vcan setup: sudo modprobe vcan
+ *               sudo ip link add dev vcan0 type vcan && sudo ip link set up vcan0
+ *
+ * Build (Linux):
+ *   g++ -O2 -std=c++17 -pthread -I.. can_player.cpp ../can_log.cpp ../can_replay.cpp ../signal_bus.cpp \
+ *       ../signal_interp.cpp ../signal_freshness.cpp \
+ *       ../fault_aggregator.cpp ../fault_history.cpp ../fault_journal.cpp ../cell_telemetry.cpp
+ */
+
+#include "../can_replay.h"
+#include <atomic>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct Options {
+    const char* path = nullptr;
+    const char* vcan = nullptr;
+    double speed = 1.0;
+    int loops = 1;
+    std::vector<std::string> signals;
+};
+
+struct Player {
+    ui::CanSocket* socket = nullptr;
+    ui::CanDecoder* decoder = nullptr;
+    ui::BusConsumer* consumer = nullptr;
+    const ui::DashboardBusSignals* signals = nullptr;
+    ui::AppState* state = nullptr;
+};
+
+std::atomic<bool> g_stop{false};
+
+void OnInterrupt(int) {
+    g_stop.store(true);
+}
+
+bool PlayFrames(const ui::CanFrame* frames, size_t count, void* userData) {
+    Player* player = static_cast<Player*>(userData);
+    if (player->socket && !ui::CanSocket::Sink(frames, count, player->socket)) return false;
+    if (player->decoder) {
+        ui::CanDecoder::Sink(frames, count, player->decoder);
+        ui::DrainBusUpdates(*player->state, *player->consumer, *player->signals);
+    }
+    return true;
+}
+
+// NAME,ID,START,LENGTH[,SCALE[,OFFSET]][,be][,signed][,ext]
+bool ParseSignal(const std::string& spec, const ui::SignalBus& bus, ui::CanSignalDef& def) {
+    std::vector<std::string> fields;
+    size_t start = 0;
+    for (;;) {
+        size_t comma = spec.find(',', start);
+        fields.push_back(spec.substr(start, comma == std::string::npos ? std::string::npos : comma - start));
+        if (comma == std::string::npos) break;
+        start = comma + 1;
+    }
+    if (fields.size() < 4) return false;
+
+    def = ui::CanSignalDef();
+    def.signal = bus.FindSignal(fields[0].c_str());
+    def.id = static_cast<uint32_t>(strtoul(fields[1].c_str(), nullptr, 0));
+    def.startBit = static_cast<uint16_t>(atoi(fields[2].c_str()));
+    def.length = static_cast<uint8_t>(atoi(fields[3].c_str()));
+    int numbers = 0;
+    for (size_t i = 4; i < fields.size(); i++) {
+        if (fields[i] == "be") {
+            def.bigEndian = true;
+        } else if (fields[i] == "signed") {
+            def.isSigned = true;
+        } else if (fields[i] == "ext") {
+            def.extended = true;
+        } else if (numbers == 0) {
+            def.scale = static_cast<float>(atof(fields[i].c_str()));
+            numbers++;
+        } else if (numbers == 1) {
+            def.offset = static_cast<float>(atof(fields[i].c_str()));
+            numbers++;
+        } else {
+            return false;
+        }
+    }
+    return def.signal >= 0;
+}
+
+void PrintUsage() {
+    printf("usage: can_player LOG [--vcan IFACE] [--speed X | --max-speed] [--loops N]\n"
+           "                  [--signal NAME,ID,START,LENGTH[,SCALE[,OFFSET]][,be][,signed][,ext]]...\n");
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+
+        if (value && strcmp(arg, "--vcan") == 0) {
+            options.vcan = value; i++;
+        } else if (value && strcmp(arg, "--speed") == 0) {
+            options.speed = atof(value); i++;
+        } else if (strcmp(arg, "--max-speed") == 0) {
+            options.speed = 0.0;
+        } else if (value && strcmp(arg, "--loops") == 0) {
+            options.loops = atoi(value); i++;
+        } else if (value && strcmp(arg, "--signal") == 0) {
+            options.signals.push_back(value); i++;
+        } else if (arg[0] != '-' && !options.path) {
+            options.path = arg;
+        } else {
+            PrintUsage();
+            return 1;
+        }
+    }
+
+    if (!options.path || options.speed < 0.0 || options.loops < 0) {
+        PrintUsage();
+        return 1;
+    }
+
+    ui::CanLogReader reader;
+    if (!reader.Open(options.path)) {
+        printf("cannot open %s (missing, empty, or not a candump / ASC log)\n", options.path);
+        return 1;
+    }
+
+    Player player;
+    ui::CanSocket socket;
+    if (options.vcan) {
+        if (!socket.Open(options.vcan)) {
+            printf("cannot open CAN interface %s\n", options.vcan);
+            return 1;
+        }
+        player.socket = &socket;
+    }
+
+    ui::SignalBus bus;
+    ui::DashboardBusSignals signals = ui::RegisterDashboardBusSignals(bus);
+    ui::CanDecoder decoder(bus.AddProducer("can"));
+    ui::BusConsumer* consumer = bus.AddConsumer("ui");
+    ui::AppState state = ui::CreateDefaultState();
+    if (!options.signals.empty()) {
+        for (const std::string& spec : options.signals) {
+            ui::CanSignalDef def;
+            if (!ParseSignal(spec, bus, def) || !decoder.AddSignal(bus, def)) {
+                printf("bad --signal %s\n", spec.c_str());
+                return 1;
+            }
+        }
+        bus.SubscribeAll(consumer);
+        bus.Start();
+        player.decoder = &decoder;
+        player.consumer = consumer;
+        player.signals = &signals;
+        player.state = &state;
+    }
+
+    signal(SIGINT, OnInterrupt);
+
+    ui::CanReplayOptions replay;
+    replay.speed = options.speed;
+    replay.loops = options.loops;
+    ui::CanReplayStats stats;
+    bool ok = ui::ReplayCanLog(reader, replay, PlayFrames, &player, &stats, &g_stop);
+
+    double seconds = static_cast<double>(stats.elapsedNs) * 1e-9;
+    printf("log            %s (%s, %.1f MB)\n", options.path,
+           reader.GetFormat() == ui::CanLogFormat::Candump ? "candump" : "asc",
+           static_cast<double>(reader.GetSize()) * 1e-6);
+    printf("frames         %llu in %.3f s (%.2f M frames/s), %llu other lines, %d passes\n",
+           static_cast<unsigned long long>(stats.frames), seconds,
+           seconds > 0.0 ? static_cast<double>(stats.frames) / seconds * 1e-6 : 0.0,
+           static_cast<unsigned long long>(stats.skippedLines), stats.loops);
+    if (options.speed > 0.0) {
+        printf("timing         %.2fx, max %.0f us behind schedule\n", options.speed,
+               static_cast<double>(stats.maxLateNs) * 1e-3);
+    }
+    for (int i = 0; i < reader.GetChannelCount(); i++) {
+        printf("channel %-6d %s\n", i, reader.GetChannelName(i).c_str());
+    }
+    if (player.decoder) {
+        printf("decoder        %llu frames decoded, %llu without signals\n",
+               static_cast<unsigned long long>(decoder.GetDecodedFrames()),
+               static_cast<unsigned long long>(decoder.GetUnknownFrames()));
+        printf("state          speed %d km/h, main %.1f%% %.1f V %.1f A, heartbeat %u\n", state.speed,
+               state.mainBattery.soc, state.mainBattery.voltage, state.mainBattery.current, state.heartbeat);
+    }
+    if (!ok) printf("replay stopped: %s\n", player.socket ? "CAN write failed" : "sink error");
+
+    printf("%s\n", ok ? "OK" : "FAILED");
+    return ok ? 0 : 1;
+}
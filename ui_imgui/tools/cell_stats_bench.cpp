@@ -0,0 +1,125 @@
+/**
+ * Cell statistics benchmark
+ *
+ * Checks the SIMD ComputeCellStats against the scalar reference for every
+ * cell count up to 192 (random values plus forced ties, so first-index
+ * selection is exercised), then times both on a full 192s pack and times
+ * a BMS-style update (SetRange of all cells with a few changed, then
+ * Stats + TakeDirty) as the dashboard sees it.
+ *
+ * Usage:
+ *   cell_stats_bench [--iterations N]
+ *
+ * Build (Linux):
+ *   g++ -O2 -std=c++17 -I.. cell_stats_bench.cpp ../cell_telemetry.cpp
+ */
+
+#include "../cell_telemetry.h"
+#include "../monotonic_clock.h"
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+uint64_t g_rng = 0x9E3779B97F4A7C15ull;
+
+float NextFloat() {
+    g_rng ^= g_rng << 13;
+    g_rng ^= g_rng >> 7;
+    g_rng ^= g_rng << 17;
+    return static_cast<float>(g_rng >> 40) * (1.0f / 16777216.0f);
+}
+
+bool SameStats(const ui::CellStats& a, const ui::CellStats& b) {
+    return a.min == b.min && a.max == b.max && a.minCell == b.minCell && a.maxCell == b.maxCell
+        && std::fabs(a.mean - b.mean) <= 1e-5f * std::fabs(b.mean) + 1e-6f;
+}
+
+// Keeps results alive so the timed loops are not optimized out
+volatile float g_sink;
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int iterations = 1000000;
+    for (int i = 1; i < argc; i++) {
+        if (i + 1 < argc && strcmp(argv[i], "--iterations") == 0) {
+            iterations = atoi(argv[++i]);
+        } else {
+            printf("usage: cell_stats_bench [--iterations N]\n");
+            return 1;
+        }
+    }
+
+    const size_t kCells = ui::CellTelemetry::kMaxCells;
+    std::vector<float> values(kCells);
+    bool ok = true;
+
+    // Correctness: every length, random data, then quantized data full of ties
+    for (int round = 0; round < 200 && ok; round++) {
+        bool ties = round & 1;
+        for (size_t i = 0; i < kCells; i++) {
+            float v = 3.6f + 0.1f * NextFloat();
+            values[i] = ties ? std::round(v * 100.0f) * 0.01f : v;
+        }
+        for (size_t count = 0; count <= kCells; count++) {
+            ui::CellStats simd = ui::ComputeCellStats(values.data(), count);
+            ui::CellStats scalar = ui::ComputeCellStatsScalar(values.data(), count);
+            if (!SameStats(simd, scalar)) {
+                printf("mismatch at count %zu: min %.4f@%u vs %.4f@%u, max %.4f@%u vs %.4f@%u\n", count,
+                       simd.min, simd.minCell, scalar.min, scalar.minCell,
+                       simd.max, simd.maxCell, scalar.max, scalar.maxCell);
+                ok = false;
+                break;
+            }
+        }
+    }
+
+    // Throughput on a 192-cell array
+    for (size_t i = 0; i < kCells; i++) values[i] = 3.6f + 0.1f * NextFloat();
+
+    uint64_t start = ui::MonotonicNowNs();
+    for (int i = 0; i < iterations; i++) {
+        values[i % kCells] += 1e-7f;
+        g_sink = ui::ComputeCellStats(values.data(), kCells).max;
+    }
+    double simdNs = static_cast<double>(ui::MonotonicNowNs() - start) / iterations;
+
+    start = ui::MonotonicNowNs();
+    for (int i = 0; i < iterations; i++) {
+        values[i % kCells] += 1e-7f;
+        g_sink = ui::ComputeCellStatsScalar(values.data(), kCells).max;
+    }
+    double scalarNs = static_cast<double>(ui::MonotonicNowNs() - start) / iterations;
+
+    // BMS frame: all 192 cells written, 4 actually changed
+    ui::CellTelemetry cells;
+    cells.SetCellCount(kCells);
+    cells.SetRange(ui::CellField::Voltage, 0, values.data(), kCells);
+    uint64_t dirty[ui::CellTelemetry::kDirtyWords];
+    cells.TakeDirty(ui::CellField::Voltage, dirty);
+
+    int changedCells = 0;
+    start = ui::MonotonicNowNs();
+    for (int i = 0; i < iterations; i++) {
+        for (int k = 0; k < 4; k++) {
+            values[(i * 4 + k) * 37 % kCells] += 0.001f;
+        }
+        cells.SetRange(ui::CellField::Voltage, 0, values.data(), kCells);
+        g_sink = cells.Stats(ui::CellField::Voltage).Delta();
+        if (cells.TakeDirty(ui::CellField::Voltage, dirty)) {
+            for (uint64_t word : dirty) changedCells += __builtin_popcountll(word);
+        }
+    }
+    double frameNs = static_cast<double>(ui::MonotonicNowNs() - start) / iterations;
+
+    printf("stats simd     %.1f ns / %zu cells\n", simdNs, kCells);
+    printf("stats scalar   %.1f ns / %zu cells (%.1fx)\n", scalarNs, kCells, scalarNs / simdNs);
+    printf("bms frame      %.1f ns (SetRange + Stats + TakeDirty, %.1f cells dirty)\n",
+           frameNs, static_cast<double>(changedCells) / iterations);
+    printf("%s\n", ok ? "OK" : "FAILED");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,368 @@
+/**
+ * Telemetry codec benchmark
+ *
+ * Drives a simulated fleet (vehicle_sim.h) and samples every vehicle at
+ * --hz into TelemetryPackets, then for each signal and codec
+ * (telemetry_codec.h) reports the stored bytes per sample and the decode
+ * rate in GB/s of decoded values (best of kPasses), and checks that
+ * every stream decodes to the input (Quantized: to within step / 2). The
+ * packets are then sent through the batched uplink (telemetry_batch.h) in
+ * batches of --batch, lossless and with the floats quantized to a tenth of
+ * the dashboard's display resolution, and compared with 52 bytes per
+ * sample as individual datagrams.
+ *
+ * Send times are taken from the simulation clock; --jitter-us adds uniform
+ * sender jitter to see what a real scheduler costs the timestamp column.
+ * Fails unless every decode reaches --min-gbps and the quantized uplink
+ * compresses at least --min-ratio.
+ *
+ * Usage:
+ *   codec_bench [--vehicles N] [--hours H] [--hz N] [--batch N] [--jitter-us U]
+ *               [--min-gbps G] [--min-ratio R]
+ *
+ * Build (Linux):
+ *   g++ -O2 -std=c++17 -I.. codec_bench.cpp ../telemetry_codec.cpp ../telemetry_batch.cpp ../vehicle_sim.cpp \
+ *       ../cell_telemetry.cpp ../fault_aggregator.cpp ../fault_history.cpp ../fault_journal.cpp
+ */
+
+#include "../telemetry_batch.h"
+#include "../telemetry_codec.h"
+#include "../vehicle_sim.h"
+#include "../monotonic_clock.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace {
+
+struct Options {
+    uint32_t vehicles = 8;
+    double hours = 1.0;
+    int hz = 10;
+    size_t batch = 128;
+    int jitterUs = 0;
+    double minGBps = 1.0;
+    double minRatio = 8.0;
+};
+
+using Series = std::vector<std::vector<ui::TelemetryPacket>>;     // Per vehicle
+
+constexpr int kPasses = 20;              // Decode timing: best of, each pass about a millisecond
+
+volatile int64_t g_sink;
+
+struct IntSignal {
+    const char* name;
+    int64_t (*get)(const ui::TelemetryPacket& packet);
+};
+
+struct FloatSignal {
+    const char* name;
+    float step;                 // For Quantized
+    float (*get)(const ui::TelemetryPacket& packet);
+};
+
+const IntSignal kIntSignals[] = {
+    { "send_time", [](const ui::TelemetryPacket& p) { return static_cast<int64_t>(p.sendTimeNs); } },
+    { "speed", [](const ui::TelemetryPacket& p) { return static_cast<int64_t>(p.speed); } },
+    { "heartbeat", [](const ui::TelemetryPacket& p) { return static_cast<int64_t>(p.heartbeat); } },
+};
+
+const FloatSignal kFloatSignals[] = {
+    { "main_soc", 0.01f, [](const ui::TelemetryPacket& p) { return p.mainBattery.soc; } },
+    { "main_voltage", 0.01f, [](const ui::TelemetryPacket& p) { return p.mainBattery.voltage; } },
+    { "main_current", 0.01f, [](const ui::TelemetryPacket& p) { return p.mainBattery.current; } },
+    { "supp_soc", 0.01f, [](const ui::TelemetryPacket& p) { return p.suppBattery.soc; } },
+    { "supp_voltage", 0.01f, [](const ui::TelemetryPacket& p) { return p.suppBattery.voltage; } },
+};
+
+struct IntCodec {
+    const char* name;
+    void (*encode)(const int64_t* values, size_t count, std::vector<uint8_t>& out);
+    bool (*decode)(const uint8_t*& p, const uint8_t* end, size_t count, int64_t* values);
+};
+
+const IntCodec kIntCodecs[] = {
+    { "delta", ui::codec::EncodeDelta, ui::codec::DecodeDelta },
+    { "dod", ui::codec::EncodeDeltaOfDelta, ui::codec::DecodeDeltaOfDelta },
+    { "for", ui::codec::EncodeFrameOfRef, ui::codec::DecodeFrameOfRef },
+};
+
+enum FloatCodec {
+    FloatCodec_Xor,
+    FloatCodec_Delta,
+    FloatCodec_Quantized,
+    FloatCodec_Count
+};
+
+const char* const kFloatCodecNames[FloatCodec_Count] = { "xor", "fdelta", "quant" };
+
+void EncodeFloats(int codec, const float* values, size_t count, float step, std::vector<uint8_t>& out) {
+    switch (codec) {
+        case FloatCodec_Xor: ui::codec::EncodeXorFloat(values, count, out); break;
+        case FloatCodec_Delta: ui::codec::EncodeFloatDelta(values, count, out); break;
+        default: ui::codec::EncodeQuantized(values, count, step, out); break;
+    }
+}
+
+bool DecodeFloats(int codec, const uint8_t*& p, const uint8_t* end, size_t count, float* values) {
+    switch (codec) {
+        case FloatCodec_Xor: return ui::codec::DecodeXorFloat(p, end, count, values);
+        case FloatCodec_Delta: return ui::codec::DecodeFloatDelta(p, end, count, values);
+        default: return ui::codec::DecodeQuantized(p, end, count, values);
+    }
+}
+
+bool WithinStep(float decoded, float value, float step) {
+    return std::fabs(decoded - value) <= step * 0.5f * 1.001f + std::fabs(value) * 1e-6f;
+}
+
+Series Simulate(const Options& options) {
+    ui::sim::SimConfig config;
+    config.vehicles = options.vehicles;
+    config.scenarioProbability = 0.25f;
+    ui::sim::FleetSimulator sim(config);
+
+    std::vector<ui::AppState> states(options.vehicles, ui::CreateDefaultState());
+    Series series(options.vehicles);
+    std::mt19937 rng(5);
+    uint64_t periodNs = 1000000000ull / static_cast<uint64_t>(options.hz);
+    uint64_t samples = static_cast<uint64_t>(options.hours * 3600.0 * options.hz);
+    for (uint32_t v = 0; v < options.vehicles; v++) series[v].reserve(samples);
+
+    for (uint64_t s = 0; s < samples; s++) {
+        sim.Advance(1.0 / options.hz);
+        for (uint32_t v = 0; v < options.vehicles; v++) {
+            sim.ReadVehicle(v, states[v]);
+            uint64_t jitter = options.jitterUs ? rng() % (static_cast<uint64_t>(options.jitterUs) * 1000) : 0;
+            series[v].push_back(ui::MakeTelemetryPacket(states[v], v, static_cast<uint32_t>(s), s * periodNs + jitter));
+        }
+    }
+    return series;
+}
+
+// Encodes every vehicle's series, checks the round trip, then times the
+// decode; returns false on a mismatch
+template <typename T, typename Encode, typename Decode, typename Same>
+bool MeasureCodec(const std::vector<std::vector<T>>& inputs, Encode encode, Decode decode, Same same,
+                  double& bytesPerSample, double& gbps) {
+    std::vector<std::vector<uint8_t>> encoded(inputs.size());
+    size_t bytes = 0;
+    size_t samples = 0;
+    for (size_t v = 0; v < inputs.size(); v++) {
+        encode(inputs[v].data(), inputs[v].size(), encoded[v]);
+        bytes += encoded[v].size();
+        samples += inputs[v].size();
+    }
+
+    std::vector<T> decoded;
+    bool ok = true;
+    for (size_t v = 0; v < inputs.size(); v++) {
+        decoded.assign(inputs[v].size(), T());
+        const uint8_t* p = encoded[v].data();
+        const uint8_t* end = p + encoded[v].size();
+        ok &= decode(p, end, inputs[v].size(), decoded.data()) && p == end;
+        for (size_t i = 0; ok && i < decoded.size(); i++) ok = same(decoded[i], inputs[v][i]);
+    }
+
+    double best = 1e30;
+    for (int pass = 0; pass < kPasses; pass++) {
+        uint64_t start = ui::MonotonicNowNs();
+        for (size_t v = 0; v < inputs.size(); v++) {
+            const uint8_t* p = encoded[v].data();
+            decode(p, p + encoded[v].size(), inputs[v].size(), decoded.data());
+            g_sink = static_cast<int64_t>(decoded[decoded.size() / 2]);
+        }
+        best = std::min(best, static_cast<double>(ui::MonotonicNowNs() - start) * 1e-9);
+    }
+    bytesPerSample = static_cast<double>(bytes) / static_cast<double>(samples);
+    gbps = static_cast<double>(samples * sizeof(T)) / best * 1e-9;
+    return ok;
+}
+
+bool RunStreams(const Series& series, double& minGBps) {
+    bool ok = true;
+    minGBps = 1e30;
+    std::vector<std::vector<int64_t>> ints(series.size());
+    for (const IntSignal& signal : kIntSignals) {
+        for (size_t v = 0; v < series.size(); v++) {
+            ints[v].clear();
+            for (const ui::TelemetryPacket& packet : series[v]) ints[v].push_back(signal.get(packet));
+        }
+        for (const IntCodec& codec : kIntCodecs) {
+            double bytes = 0.0;
+            double gbps = 0.0;
+            bool same = MeasureCodec(
+                ints,
+                [&](const int64_t* values, size_t count, std::vector<uint8_t>& out) { codec.encode(values, count, out); },
+                [&](const uint8_t*& p, const uint8_t* end, size_t count, int64_t* values) {
+                    return codec.decode(p, end, count, values);
+                },
+                [](int64_t decoded, int64_t value) { return decoded == value; }, bytes, gbps);
+            printf("  %-14s %-7s %6.3f bytes/sample %7.2f GB/s%s\n", signal.name, codec.name, bytes, gbps,
+                   same ? "" : "  MISMATCH");
+            ok &= same;
+            minGBps = std::min(minGBps, gbps);
+        }
+    }
+
+    std::vector<std::vector<float>> floats(series.size());
+    for (const FloatSignal& signal : kFloatSignals) {
+        for (size_t v = 0; v < series.size(); v++) {
+            floats[v].clear();
+            for (const ui::TelemetryPacket& packet : series[v]) floats[v].push_back(signal.get(packet));
+        }
+        for (int codec = 0; codec < FloatCodec_Count; codec++) {
+            double bytes = 0.0;
+            double gbps = 0.0;
+            bool lossy = codec == FloatCodec_Quantized;
+            bool same = MeasureCodec(
+                floats,
+                [&](const float* values, size_t count, std::vector<uint8_t>& out) {
+                    EncodeFloats(codec, values, count, signal.step, out);
+                },
+                [&](const uint8_t*& p, const uint8_t* end, size_t count, float* values) {
+                    return DecodeFloats(codec, p, end, count, values);
+                },
+                [&](float decoded, float value) {
+                    return lossy ? WithinStep(decoded, value, signal.step) : memcmp(&decoded, &value, sizeof(value)) == 0;
+                },
+                bytes, gbps);
+            printf("  %-14s %-7s %6.3f bytes/sample %7.2f GB/s%s%s\n", signal.name, kFloatCodecNames[codec], bytes,
+                   gbps, lossy ? "  (step 0.01)" : "", same ? "" : "  MISMATCH");
+            ok &= same;
+            minGBps = std::min(minGBps, gbps);
+        }
+    }
+    return ok;
+}
+
+bool SamePacket(const ui::TelemetryPacket& a, const ui::TelemetryPacket& b, float step) {
+    auto sameFloat = [step](float x, float y) { return step > 0.0f ? WithinStep(x, y, step) : x == y; };
+    return a.vehicleId == b.vehicleId && a.sequence == b.sequence && a.sendTimeNs == b.sendTimeNs &&
+           a.speed == b.speed && a.gear == b.gear && a.turnSignal == b.turnSignal && a.heartbeat == b.heartbeat &&
+           a.brakeEngaged == b.brakeEngaged && a.cruise.enabled == b.cruise.enabled &&
+           a.cruise.setSpeed == b.cruise.setSpeed && a.contactorStates.main == b.contactorStates.main &&
+           a.contactorStates.precharge == b.contactorStates.precharge &&
+           a.contactorStates.hvil == b.contactorStates.hvil && sameFloat(a.mainBattery.soc, b.mainBattery.soc) &&
+           sameFloat(a.mainBattery.voltage, b.mainBattery.voltage) &&
+           sameFloat(a.mainBattery.current, b.mainBattery.current) &&
+           sameFloat(a.suppBattery.soc, b.suppBattery.soc) && sameFloat(a.suppBattery.voltage, b.suppBattery.voltage);
+}
+
+bool RunBatches(const Series& series, const Options& options, float step, double& ratio) {
+    ui::TelemetryBatchOptions batchOptions;
+    batchOptions.socStep = step;
+    batchOptions.voltageStep = step;
+    batchOptions.currentStep = step;
+
+    std::vector<std::vector<uint8_t>> datagrams;
+    size_t bytes = 0;
+    size_t samples = 0;
+    size_t largest = 0;
+    for (const std::vector<ui::TelemetryPacket>& packets : series) {
+        for (size_t first = 0; first < packets.size(); first += options.batch) {
+            datagrams.emplace_back();
+            size_t count = std::min(options.batch, packets.size() - first);
+            if (!ui::EncodeTelemetryBatch(packets.data() + first, count, batchOptions, datagrams.back())) return false;
+            bytes += datagrams.back().size();
+            largest = std::max(largest, datagrams.back().size());
+            samples += count;
+        }
+    }
+
+    // Round trip in send order, then decode timing
+    std::vector<ui::TelemetryPacket> decoded;
+    size_t datagram = 0;
+    size_t mismatches = 0;
+    for (const std::vector<ui::TelemetryPacket>& packets : series) {
+        for (size_t first = 0; first < packets.size(); first += options.batch, datagram++) {
+            const std::vector<uint8_t>& d = datagrams[datagram];
+            if (!ui::DecodeTelemetryBatch(d.data(), d.size(), decoded)) {
+                mismatches++;
+                continue;
+            }
+            for (size_t i = 0; i < decoded.size(); i++) mismatches += !SamePacket(decoded[i], packets[first + i], step);
+        }
+    }
+    double best = 1e30;
+    for (int pass = 0; pass < kPasses; pass++) {
+        uint64_t start = ui::MonotonicNowNs();
+        for (const std::vector<uint8_t>& d : datagrams) ui::DecodeTelemetryBatch(d.data(), d.size(), decoded);
+        best = std::min(best, static_cast<double>(ui::MonotonicNowNs() - start) * 1e-9);
+    }
+
+    ratio = static_cast<double>(samples * ui::kTelemetryPacketSize) / static_cast<double>(bytes);
+    printf("uplink %-7s %5.2f bytes/sample (%4.1fx vs %zu-byte datagrams), largest batch %zu bytes, "
+           "%.1f M samples/s decoded, %zu mismatches\n",
+           step > 0.0f ? "quant" : "exact", static_cast<double>(bytes) / static_cast<double>(samples), ratio,
+           ui::kTelemetryPacketSize, largest, static_cast<double>(samples) / best * 1e-6, mismatches);
+    return mismatches == 0;
+}
+
+void PrintUsage() {
+    printf("usage: codec_bench [--vehicles N] [--hours H] [--hz N] [--batch N] [--jitter-us U]\n"
+           "                   [--min-gbps G] [--min-ratio R]\n");
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+
+        if (value && strcmp(arg, "--vehicles") == 0) {
+            options.vehicles = static_cast<uint32_t>(atoi(value)); i++;
+        } else if (value && strcmp(arg, "--hours") == 0) {
+            options.hours = atof(value); i++;
+        } else if (value && strcmp(arg, "--hz") == 0) {
+            options.hz = atoi(value); i++;
+        } else if (value && strcmp(arg, "--batch") == 0) {
+            options.batch = static_cast<size_t>(atoi(value)); i++;
+        } else if (value && strcmp(arg, "--jitter-us") == 0) {
+            options.jitterUs = atoi(value); i++;
+        } else if (value && strcmp(arg, "--min-gbps") == 0) {
+            options.minGBps = atof(value); i++;
+        } else if (value && strcmp(arg, "--min-ratio") == 0) {
+            options.minRatio = atof(value); i++;
+        } else {
+            PrintUsage();
+            return 1;
+        }
+    }
+
+    if (options.vehicles == 0 || options.hours <= 0.0 || options.hz <= 0 || options.batch == 0 ||
+        options.batch > ui::kTelemetryBatchMaxSamples || options.jitterUs < 0) {
+        PrintUsage();
+        return 1;
+    }
+
+    uint64_t start = ui::MonotonicNowNs();
+    Series series = Simulate(options);
+    printf("drive data     %u vehicles x %.1f h at %d Hz, %zu samples each (simulated in %.2f s)\n",
+           options.vehicles, options.hours, options.hz, series[0].size(),
+           static_cast<double>(ui::MonotonicNowNs() - start) * 1e-9);
+
+    printf("streams\n");
+    double minGBps = 0.0;
+    bool ok = RunStreams(series, minGBps);
+    printf("slowest decode %.2f GB/s (need %.2f)\n", minGBps, options.minGBps);
+    ok &= minGBps >= options.minGBps;
+
+    double exactRatio = 0.0;
+    double quantRatio = 0.0;
+    ok &= RunBatches(series, options, 0.0f, exactRatio);
+    ok &= RunBatches(series, options, 0.01f, quantRatio);
+    printf("ratio          %.1fx quantized (need %.1f), %.1fx lossless\n", quantRatio, options.minRatio, exactRatio);
+    ok &= quantRatio >= options.minRatio;
+
+    printf("%s\n", ok ? "OK" : "FAILED");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,263 @@
+/**
+ * Frame pacer rates and CPU utilization per mode
+ *
+ * Drives a FramePacer (frame_pacer.h) through a scripted session, each
+ * phase --phase-seconds long, with a synthetic frame that spins for
+ * --frame-us (stand-in for NewFrame + RenderUI + Render on the SoC):
+ *   static      nothing changes
+ *   telemetry   a thread calls NotifyStateChanged() at --telemetry-hz
+ *   turn signal the pulsing indicator requests 20 Hz every frame
+ *   input       a thread writes to a pipe every 100 ms; Wait() wakes on it
+ *   transition  a 0.3 s transition starts every second
+ * and then runs the same frame at a fixed 60 Hz, as a host spinning at
+ * vsync would. Prints frame rate and CPU per phase, the pacer's per-mode
+ * totals and state-change wake latency, and checks each phase ran at the
+ * rate its mode calls for.
+ *
+ * Usage:
+ *   frame_pacer_bench [--phase-seconds S] [--frame-us N] [--idle-hz HZ] [--telemetry-hz HZ]
+ *
+ * Build (Linux):
+ *   g++ -O2 -std=c++17 -pthread -I.. frame_pacer_bench.cpp ../frame_pacer.cpp
+ */
+
+#include "../frame_pacer.h"
+#include "../monotonic_clock.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+
+namespace {
+
+struct Options {
+    double phaseSeconds = 2.0;
+    int frameUs = 2000;
+    double idleHz = 4.0;
+    double telemetryHz = 10.0;
+};
+
+enum class Phase { Static, Telemetry, TurnSignal, Input, Transition };
+
+constexpr double kTurnPulseHz = 20.0;
+constexpr double kTransitionSeconds = 0.3;
+constexpr uint64_t kInputIntervalNs = 100000000ull;
+
+struct PhaseResult {
+    const char* name;
+    int frames = 0;
+    double wallSeconds = 0.0;
+    double cpuSeconds = 0.0;
+
+    double Rate() const { return wallSeconds > 0.0 ? frames / wallSeconds : 0.0; }
+    double Utilization() const { return wallSeconds > 0.0 ? cpuSeconds / wallSeconds : 0.0; }
+};
+
+volatile uint64_t g_sink;   // Keeps the frame spin from being optimized out
+
+double ProcessCpuSeconds() {
+    timespec ts;
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+    return static_cast<double>(ts.tv_sec) + ts.tv_nsec * 1e-9;
+}
+
+// The synthetic frame
+void Spin(int frameUs) {
+    uint64_t end = ui::MonotonicNowNs() + static_cast<uint64_t>(frameUs) * 1000ull;
+    uint64_t sink = 0;
+    while (ui::MonotonicNowNs() < end) sink++;
+    g_sink = sink;
+}
+
+PhaseResult RunPhase(ui::FramePacer& pacer, Phase phase, const char* name, const Options& options,
+                     std::vector<uint64_t>& wakeLatencyNs) {
+    PhaseResult result;
+    result.name = name;
+
+    std::atomic<bool> stop{false};
+    std::atomic<uint64_t> pendingChangeNs{0};   // Oldest change no frame has shown yet
+    int pipeFds[2] = { -1, -1 };
+    std::thread helper;
+
+    if (phase == Phase::Telemetry) {
+        helper = std::thread([&] {
+            uint64_t interval = static_cast<uint64_t>(1e9 / options.telemetryHz);
+            uint64_t next = ui::MonotonicNowNs() + interval;
+            while (!stop.load(std::memory_order_relaxed)) {
+                timespec ts = { static_cast<time_t>(next / 1000000000ull), static_cast<long>(next % 1000000000ull) };
+                clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr);
+                uint64_t expected = 0;
+                pendingChangeNs.compare_exchange_strong(expected, ui::MonotonicNowNs());
+                pacer.NotifyStateChanged();
+                next += interval;
+            }
+        });
+    } else if (phase == Phase::Input) {
+        if (pipe(pipeFds) != 0) pipeFds[0] = pipeFds[1] = -1;
+        helper = std::thread([&] {
+            while (!stop.load(std::memory_order_relaxed)) {
+                char event = 'i';
+                if (pipeFds[1] >= 0 && write(pipeFds[1], &event, 1) != 1) break;
+                std::this_thread::sleep_for(std::chrono::nanoseconds(kInputIntervalNs));
+            }
+        });
+    }
+
+    uint64_t start = ui::MonotonicNowNs();
+    uint64_t end = start + static_cast<uint64_t>(options.phaseSeconds * 1e9);
+    uint64_t nextTransition = start;
+    double cpuStart = ProcessCpuSeconds();
+
+    for (;;) {
+        if (pacer.Wait(pipeFds[0])) {
+            char events[64];
+            ssize_t readBytes = read(pipeFds[0], events, sizeof(events));
+            (void)readBytes;
+            pacer.NotifyInput();
+        }
+        uint64_t now = ui::MonotonicNowNs();
+        if (now >= end) break;
+
+        pacer.FrameStart();
+        uint64_t change = pendingChangeNs.exchange(0);
+        if (change) wakeLatencyNs.push_back(now - change);
+
+        if (phase == Phase::TurnSignal) pacer.RequestAnimation(kTurnPulseHz);
+        if (phase == Phase::Transition && now >= nextTransition) {
+            pacer.RequestTransition(kTransitionSeconds);
+            nextTransition += 1000000000ull;
+        }
+        Spin(options.frameUs);
+        result.frames++;
+        pacer.ScheduleNext();
+    }
+
+    result.wallSeconds = static_cast<double>(ui::MonotonicNowNs() - start) * 1e-9;
+    result.cpuSeconds = ProcessCpuSeconds() - cpuStart;
+
+    stop.store(true);
+    if (helper.joinable()) helper.join();
+    if (pipeFds[0] >= 0) close(pipeFds[0]);
+    if (pipeFds[1] >= 0) close(pipeFds[1]);
+    return result;
+}
+
+// A host that renders every vsync regardless
+PhaseResult RunVsyncBaseline(const Options& options) {
+    PhaseResult result;
+    result.name = "vsync 60 Hz";
+    uint64_t interval = 1000000000ull / 60;
+    uint64_t start = ui::MonotonicNowNs();
+    uint64_t end = start + static_cast<uint64_t>(options.phaseSeconds * 1e9);
+    double cpuStart = ProcessCpuSeconds();
+    for (uint64_t next = start; next < end; next += interval) {
+        timespec ts = { static_cast<time_t>(next / 1000000000ull), static_cast<long>(next % 1000000000ull) };
+        clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr);
+        Spin(options.frameUs);
+        result.frames++;
+    }
+    result.wallSeconds = static_cast<double>(ui::MonotonicNowNs() - start) * 1e-9;
+    result.cpuSeconds = ProcessCpuSeconds() - cpuStart;
+    return result;
+}
+
+bool RateWithin(double rate, double low, double high) {
+    return rate >= low && rate <= high;
+}
+
+void PrintUsage() {
+    printf("usage: frame_pacer_bench [--phase-seconds S] [--frame-us N] [--idle-hz HZ] [--telemetry-hz HZ]\n");
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+
+        if (value && strcmp(arg, "--phase-seconds") == 0) {
+            options.phaseSeconds = atof(value); i++;
+        } else if (value && strcmp(arg, "--frame-us") == 0) {
+            options.frameUs = atoi(value); i++;
+        } else if (value && strcmp(arg, "--idle-hz") == 0) {
+            options.idleHz = atof(value); i++;
+        } else if (value && strcmp(arg, "--telemetry-hz") == 0) {
+            options.telemetryHz = atof(value); i++;
+        } else {
+            PrintUsage();
+            return 1;
+        }
+    }
+
+    if (options.phaseSeconds < 1.0 || options.frameUs < 0 || options.frameUs > 10000 || options.idleHz <= 0.0 ||
+        options.telemetryHz <= 0.0 || options.telemetryHz > 30.0) {
+        PrintUsage();
+        return 1;
+    }
+
+    ui::FramePacerConfig config;
+    config.idleHz = options.idleHz;
+    ui::FramePacer pacer(config);
+    std::vector<uint64_t> wakeLatencyNs;
+
+    // Settle into idle before measuring
+    RunPhase(pacer, Phase::Static, "warm-up", { 1.0, options.frameUs, options.idleHz, options.telemetryHz },
+             wakeLatencyNs);
+    pacer.ResetStats();
+
+    PhaseResult phases[6];
+    phases[0] = RunPhase(pacer, Phase::Static, "static", options, wakeLatencyNs);
+    phases[1] = RunPhase(pacer, Phase::Telemetry, "telemetry", options, wakeLatencyNs);
+    phases[2] = RunPhase(pacer, Phase::TurnSignal, "turn signal", options, wakeLatencyNs);
+    phases[3] = RunPhase(pacer, Phase::Input, "input", options, wakeLatencyNs);
+    phases[4] = RunPhase(pacer, Phase::Transition, "transition", options, wakeLatencyNs);
+    phases[5] = RunVsyncBaseline(options);
+    const PhaseResult& baseline = phases[5];
+
+    printf("frame          %d us synthetic, idle %.1f Hz, active %.0f Hz, %.1f s per phase\n", options.frameUs,
+           options.idleHz, config.activeHz, options.phaseSeconds);
+    printf("  %-14s %7s %9s %8s %10s\n", "phase", "frames", "rate", "cpu", "vs vsync");
+    for (const PhaseResult& phase : phases) {
+        double saving = baseline.Utilization() > 0.0 ? 100.0 * (1.0 - phase.Utilization() / baseline.Utilization()) : 0.0;
+        printf("  %-14s %7d %6.1f Hz %7.2f%% %8.0f%%\n", phase.name, phase.frames, phase.Rate(),
+               100.0 * phase.Utilization(), -saving);
+    }
+
+    printf("  %-14s %7s %9s %8s\n", "mode", "frames", "wall", "cpu");
+    for (int mode = 0; mode < static_cast<int>(ui::PaceMode::Count); mode++) {
+        ui::PaceModeStats stats = pacer.GetStats(static_cast<ui::PaceMode>(mode));
+        printf("  %-14s %7llu %7.2f s %7.2f%%\n", ui::PaceModeName(static_cast<ui::PaceMode>(mode)),
+               static_cast<unsigned long long>(stats.frames), stats.wallSeconds,
+               stats.wallSeconds > 0.0 ? 100.0 * stats.cpuSeconds / stats.wallSeconds : 0.0);
+    }
+
+    double latencyP50 = 0.0, latencyMax = 0.0;
+    if (!wakeLatencyNs.empty()) {
+        std::sort(wakeLatencyNs.begin(), wakeLatencyNs.end());
+        latencyP50 = wakeLatencyNs[wakeLatencyNs.size() / 2] * 1e-6;
+        latencyMax = wakeLatencyNs.back() * 1e-6;
+    }
+    printf("state wake     %zu changes, p50 %.2f ms, max %.2f ms\n", wakeLatencyNs.size(), latencyP50, latencyMax);
+
+    // Rates the modes call for, with room for timer slack on a busy machine
+    double frameInterval = 1.0 / config.activeHz;
+    bool ok = true;
+    ok &= RateWithin(phases[0].Rate(), options.idleHz * 0.8, options.idleHz * 1.2 + 0.5);
+    ok &= RateWithin(phases[1].Rate(), options.telemetryHz * 0.8, options.telemetryHz + options.idleHz + 1.0);
+    ok &= RateWithin(phases[2].Rate(), kTurnPulseHz * 0.8, kTurnPulseHz * 1.1);
+    ok &= RateWithin(phases[3].Rate(), config.activeHz * 0.8, config.activeHz * 1.05);
+    ok &= phases[4].Rate() > options.idleHz * 1.5 && phases[4].Rate() < config.activeHz * 0.8;
+    ok &= latencyMax < frameInterval * 1e3 + 5.0;
+    ok &= phases[0].Utilization() < baseline.Utilization() * 0.25;
+    printf("%s\n", ok ? "OK" : "FAILED");
+    return ok ? 0 : 1;
+}
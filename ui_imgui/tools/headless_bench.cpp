@@ -0,0 +1,540 @@
+/**
+ * Headless dashboard benchmark
+ *
+ * Runs the full dashboard against an ImGui context with no renderer
+ * backend (font atlas built on the CPU, draw data discarded) and reports
+ * per-frame cost: CPU time for NewFrame + RenderUI + Render, the number of
+ * windows submitted, and draw list / draw command / vertex / index totals
+ * of the resulting ImDrawData. With --workers the gauge, camera overlays
+ * and cell quads are built on a ParallelDraw pool; compare e.g. --cells 4096
+ * with --workers 0 and 3.
+ *
+ * With --overdraw the last frame is also drawn by the CPU rasterizer
+ * (soft_raster.h): the report gives fragments shaded per pixel, the depth
+ * distribution and the most expensive panels, and PREFIX.ppm (the frame)
+ * and PREFIX_heat.ppm (overdraw heatmap) are written. Fill rate is what
+ * limits the low-end GPU, so this is the number to watch when layering
+ * card backgrounds and overlays.
+ *
+ * Every run also attaches a DrawBudget and ends with the per-panel table:
+ * mean and peak vertices, peak indices and draw commands against each
+ * panel's budget, and how many frames went over. --strict exits with 1 if
+ * any panel (or the frame, with --frame-vertices) went over, for CI.
+ *
+ * --profiles then renders each fixed layout profile (800x480, 1280x720,
+ * 1920x720) at its display size and checks it: the profile was picked, the
+ * layout cache was computed once and not again while the size held, every
+ * column and panel lies inside the display without overlapping its
+ * neighbours, and the speed row, camera feeds and cached texts fit.
+ *
+ * --arena MB installs an ArenaAllocator (arena_alloc.h) as ImGui's allocator
+ * and operator new before the context exists, and cycles the dashboard
+ * through its scenarios (turn signals, faults reported and resolved, fault
+ * history, contactors, brake, gears, cruise) every 600 frames. Warm-up
+ * covers one full cycle, and then the arena is sealed. The run prints the
+ * allocations per frame and fails if anything reached malloc after the
+ * warm-up.
+ *
+ * Usage:
+ *   headless_bench [--frames N] [--width W] [--height H] [--faults N] [--cells N] [--workers N]
+ *                  [--overdraw PREFIX] [--frame-vertices N] [--strict] [--profiles] [--arena MB]
+ *
+ * Build (Linux, IMGUI_DIR = Dear ImGui 1.91 source tree):
+ *   g++ -O2 -std=c++17 -pthread -I.. -I$IMGUI_DIR headless_bench.cpp \
+ *       ../dashboard.cpp ../widgets.cpp ../theme.cpp ../layout_cache.cpp \
+ *       ../parallel_draw.cpp ../draw_budget.cpp ../soft_raster.cpp ../frame_pacer.cpp ../signal_interp.cpp \
+ *       ../signal_freshness.cpp ../session_store.cpp \
+ *       ../fault_aggregator.cpp ../fault_history.cpp ../fault_journal.cpp \
+ *       ../vehicle_sim.cpp ../cell_telemetry.cpp ../cell_heatmap.cpp \
+ *       ../arena_alloc.cpp ../arena_operators.cpp \
+ *       $IMGUI_DIR/imgui.cpp $IMGUI_DIR/imgui_draw.cpp \
+ *       $IMGUI_DIR/imgui_tables.cpp $IMGUI_DIR/imgui_widgets.cpp
+ */
+
+#include "../ui.h"
+#include "../monotonic_clock.h"
+#include "../soft_raster.h"
+#include "../arena_alloc.h"
+#include "imgui_internal.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct Options {
+    int frames = 2000;
+    float width = 1280.0f;
+    float height = 720.0f;
+    int faults = 5;
+    int cells = 96;         // Per-cell telemetry (0 hides the cell heatmap)
+    int workers = -1;       // ParallelDraw workers (-1 = no pool)
+    const char* overdraw = nullptr;   // Output prefix for the rasterized last frame
+    int frameVertices = 0;  // Whole-frame vertex budget (0 = none)
+    bool strict = false;    // Fail on any budget overrun
+    bool profiles = false;  // Validate the fixed layout profiles
+    int arenaMb = 0;        // ArenaAllocator size (0 = system allocator)
+};
+
+constexpr int kOverdrawPanels = 12;   // Rows in the panel table
+constexpr int kProfileFrames = 120;   // Frames per layout profile
+constexpr float kMinCameraHeight = 120.0f;
+constexpr int kScenarioFrames = 60;   // Frames per scenario step
+constexpr int kScenarioSteps = 10;
+
+struct FrameStats {
+    int windows = 0;        // Windows begun this frame (incl. child windows)
+    int drawLists = 0;
+    int drawCmds = 0;
+    int vertices = 0;
+    int indices = 0;
+};
+
+FrameStats CollectFrameStats() {
+    FrameStats stats;
+    ImGuiContext& g = *GImGui;
+    for (ImGuiWindow* window : g.Windows) {
+        if (window->Active) stats.windows++;
+    }
+
+    ImDrawData* drawData = ImGui::GetDrawData();
+    stats.drawLists = drawData->CmdListsCount;
+    stats.vertices = drawData->TotalVtxCount;
+    stats.indices = drawData->TotalIdxCount;
+    for (const ImDrawList* list : drawData->CmdLists) {
+        stats.drawCmds += list->CmdBuffer.Size;
+    }
+    return stats;
+}
+
+void SetupContext(const Options& options) {
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = nullptr;
+    io.DisplaySize = ImVec2(options.width, options.height);
+    io.DeltaTime = 1.0f / 60.0f;
+
+    ui::InitUI();
+
+    // No backend: build the atlas on the CPU and hand ImGui a dummy texture
+    unsigned char* pixels = nullptr;
+    int texWidth = 0, texHeight = 0;
+    io.Fonts->GetTexDataAsRGBA32(&pixels, &texWidth, &texHeight);
+    io.Fonts->SetTexID(static_cast<ImTextureID>(1));
+}
+
+ui::AppState MakeBenchState(ui::FaultHistory& history, int faultCount, int cellCount) {
+    ui::AppState state = ui::CreateDefaultState();
+    state.faultHistory = &history;
+    state.speed = 88;
+    state.gear = ui::Gear::Drive;
+    state.brakeEngaged = false;
+    state.contactorStates = { true, false, true };
+    state.mainBattery.current = -120.0f;
+    state.cruise = { true, 90 };
+    state.turnSignal = ui::TurnSignal::Left;
+
+    static const char* codes[] = { "E001", "E002", "E003", "E004", "E005", "E006", "E007", "E008" };
+    for (int i = 0; i < faultCount; i++) {
+        ui::Fault fault;
+        fault.code = codes[i % 8];
+        fault.message = "Bench fault";
+        fault.severity = static_cast<ui::FaultSeverity>(i % 3);
+        fault.timestamp = 1700000000000ll + i * 1000;
+        ui::ReportFault(state, fault);
+    }
+
+    state.cells.SetCellCount(static_cast<size_t>(cellCount));
+    for (int i = 0; i < cellCount; i++) {
+        state.cells.SetVoltage(i, 3.700f + 0.001f * (i % 7));
+        state.cells.SetTemperature(i, 30.0f + 0.1f * (i % 11));
+    }
+    return state;
+}
+
+// One step of the scenario cycle: every view and state change the dashboard
+// has, so a sealed arena sees all of them during warm-up first
+void ApplyScenario(ui::AppState& state, int frame) {
+    if (frame % kScenarioFrames != 0) return;
+    int step = (frame / kScenarioFrames) % kScenarioSteps;
+    switch (step) {
+        case 0: state.turnSignal = ui::TurnSignal::Left; break;
+        case 1: state.turnSignal = ui::TurnSignal::Right; break;
+        case 2: {
+            state.turnSignal = ui::TurnSignal::None;
+            ui::Fault fault;
+            fault.code = "E100";
+            fault.message = "Scenario fault with a message long enough to need the heap";
+            fault.severity = ui::FaultSeverity::Critical;
+            fault.timestamp = 1700000000000ll + frame;
+            ui::ReportFault(state, fault);
+            break;
+        }
+        case 3: state.faults.Resolve("E100"); break;
+        case 4: state.showFaultHistory = true; break;
+        case 5: state.showFaultHistory = false; break;
+        case 6: state.contactorStates.main = !state.contactorStates.main; break;
+        case 7: state.brakeEngaged = !state.brakeEngaged; break;
+        case 8: state.gear = state.gear == ui::Gear::Drive ? ui::Gear::Neutral : ui::Gear::Drive; break;
+        case 9: state.cruise.enabled = !state.cruise.enabled; break;
+    }
+}
+
+// "Dashboard##Main/##LeftColumn_1A2B3C4D/##BatteryPanel_5E6F7081" -> "BatteryPanel"
+std::string PanelLabel(const std::string& windowName) {
+    std::string label = windowName.substr(windowName.rfind('/') + 1);
+    size_t suffix = label.rfind('_');
+    if (suffix != std::string::npos && label.size() - suffix == 9) label.erase(suffix);
+    if (label.compare(0, 2, "##") == 0) label.erase(0, 2);
+    size_t hashes = label.find("##");
+    if (hashes != std::string::npos && hashes > 0) label.erase(hashes);
+    return label.empty() ? windowName : label;
+}
+
+// Rasterize the last frame's draw data, print the report and write the images
+bool ReportOverdraw(const char* prefix) {
+    ImGuiIO& io = ImGui::GetIO();
+    unsigned char* atlas = nullptr;
+    int atlasWidth = 0, atlasHeight = 0;
+    io.Fonts->GetTexDataAsRGBA32(&atlas, &atlasWidth, &atlasHeight);
+
+    ui::raster::SoftRasterizer raster;
+    raster.SetTexture(io.Fonts->TexID, atlas, atlasWidth, atlasHeight);
+    uint64_t start = ui::MonotonicNowNs();
+    raster.Render(*ImGui::GetDrawData());
+    uint64_t elapsed = ui::MonotonicNowNs() - start;
+
+    ui::raster::OverdrawSummary summary = raster.GetSummary();
+    double screen = static_cast<double>(raster.GetWidth()) * raster.GetHeight();
+    double shaded = summary.pixels ? static_cast<double>(summary.fragments) / summary.pixels : 0.0;
+    printf("overdraw       %.2f fragments/shaded pixel, %.2f screens of fill, max depth %d, %.1f%% transparent\n",
+           shaded, screen > 0 ? summary.fragments / screen : 0.0, summary.maxDepth,
+           summary.fragments ? 100.0 * summary.transparent / summary.fragments : 0.0);
+    static const char* bucketNames[ui::raster::kDepthBuckets] = { "0", "1", "2", "3", "4", "5-7", "8+" };
+    printf("depth         ");
+    for (int i = 0; i < ui::raster::kDepthBuckets; i++) {
+        printf(" %s:%.1f%%", bucketNames[i], screen > 0 ? 100.0 * summary.depthHistogram[i] / screen : 0.0);
+    }
+    printf("\n");
+
+    std::vector<ui::raster::PanelOverdraw> panels = raster.GetPanels();
+    std::sort(panels.begin(), panels.end(), [](const ui::raster::PanelOverdraw& a, const ui::raster::PanelOverdraw& b) {
+        return a.fragments > b.fragments;
+    });
+    printf("  %-26s %10s %10s %10s %10s %6s\n", "panel", "fragments", "pixels", "overdrawn", "transp.", "tris");
+    for (size_t i = 0; i < panels.size() && i < static_cast<size_t>(kOverdrawPanels); i++) {
+        const ui::raster::PanelOverdraw& panel = panels[i];
+        double fragments = panel.fragments ? static_cast<double>(panel.fragments) : 1.0;
+        printf("  %-26.26s %10llu %10llu %9.0f%% %9.0f%% %6u\n", PanelLabel(panel.name).c_str(),
+               static_cast<unsigned long long>(panel.fragments), static_cast<unsigned long long>(panel.pixels),
+               100.0 * panel.overdrawn / fragments, 100.0 * panel.transparent / fragments, panel.triangles);
+    }
+    printf("raster         %.1f ms\n", elapsed * 1e-6);
+
+    std::string imagePath = std::string(prefix) + ".ppm";
+    std::string heatmapPath = std::string(prefix) + "_heat.ppm";
+    if (!ui::raster::WriteImage(imagePath.c_str(), raster) ||
+        !ui::raster::WriteOverdrawHeatmap(heatmapPath.c_str(), raster)) {
+        printf("error          could not write %s / %s\n", imagePath.c_str(), heatmapPath.c_str());
+        return false;
+    }
+    printf("images         %s, %s\n", imagePath.c_str(), heatmapPath.c_str());
+    return true;
+}
+
+void PrintBudgetRow(const ui::PanelDrawStats& panel) {
+    double frames = panel.frames ? static_cast<double>(panel.frames) : 1.0;
+    char budget[3][16];
+    int limits[3] = { panel.budget.vertices, panel.budget.indices, panel.budget.cmds };
+    for (int i = 0; i < 3; i++) {
+        if (limits[i] > 0) {
+            snprintf(budget[i], sizeof(budget[i]), "%d", limits[i]);
+        } else {
+            snprintf(budget[i], sizeof(budget[i]), "-");
+        }
+    }
+    printf("  %-16.16s %8.0f %7d %7s %7d %7s %5d %5s %8llu\n", panel.name.c_str(), panel.vertexSum / frames,
+           panel.peak.vertices, budget[0], panel.peak.indices, budget[1], panel.peak.cmds, budget[2],
+           static_cast<unsigned long long>(panel.overruns));
+}
+
+// Per-panel geometry against budgets; returns the number of overrun frames
+uint64_t PrintBudgetTable(const ui::DrawBudget& drawBudget) {
+    printf("  %-16s %8s %7s %7s %7s %7s %5s %5s %8s\n", "panel", "vtx mean", "peak", "budget", "idx", "budget",
+           "cmds", "budget", "overruns");
+    uint64_t overruns = 0;
+    for (const ui::PanelDrawStats& panel : drawBudget.GetPanels()) {
+        PrintBudgetRow(panel);
+        overruns += panel.overruns;
+    }
+    PrintBudgetRow(drawBudget.GetFrame());
+    return overruns + drawBudget.GetFrame().overruns;
+}
+
+// Rect of the active child window with this PanelLabel (false if not drawn)
+bool FindPanelRect(const char* label, ImRect& rect) {
+    for (ImGuiWindow* window : GImGui->Windows) {
+        if (window->Active && PanelLabel(window->Name) == label) {
+            rect = window->Rect();
+            return true;
+        }
+    }
+    return false;
+}
+
+bool Inside(const ImRect& rect, const ImVec2& display) {
+    const float slack = 0.5f;
+    return rect.Min.x >= -slack && rect.Min.y >= -slack && rect.Max.x <= display.x + slack &&
+           rect.Max.y <= display.y + slack;
+}
+
+// Render every fixed profile at its display size and check the layout
+bool ValidateProfiles(ui::AppState& state) {
+    static const char* const kPanels[] = {
+        "Header", "LeftColumn", "CenterColumn", "RightColumn", "SpeedGearRow",
+        "GearPanel", "SpeedPanel", "CruisePanel", "CameraRow", "RearCamera", "SideCamera",
+    };
+    // Left to right within a row; neighbours must not overlap
+    static const char* const kRows[][3] = {
+        { "LeftColumn", "CenterColumn", "RightColumn" },
+        { "GearPanel", "SpeedPanel", "CruisePanel" },
+        { "RearCamera", "SideCamera", nullptr },
+    };
+
+    ImGuiIO& io = ImGui::GetIO();
+    ImVec2 savedSize = io.DisplaySize;
+    ui::LayoutCache* savedLayout = state.layout;
+    bool allOk = true;
+
+    printf("  %-10s %7s %7s %7s %9s %9s %9s  %s\n", "profile", "side", "center", "gauge", "camera h",
+           "rebuilds", "cpu mean", "result");
+    for (int p = static_cast<int>(ui::LayoutProfile::Compact800x480); p < static_cast<int>(ui::LayoutProfile::Count);
+         p++) {
+        ui::LayoutProfile profile = static_cast<ui::LayoutProfile>(p);
+        const ui::LayoutProfileSpec& spec = ui::GetLayoutProfileSpec(profile);
+        ImVec2 display(spec.width, spec.height);
+        io.DisplaySize = display;
+
+        ui::LayoutCache cache;
+        state.layout = &cache;
+        uint64_t totalNs = 0;
+        uint64_t rebuildsAfterFirst = 0;
+        for (int frame = 0; frame < kProfileFrames; frame++) {
+            uint64_t start = ui::MonotonicNowNs();
+            ImGui::NewFrame();
+            ui::RenderUI(state);
+            ImGui::Render();
+            totalNs += ui::MonotonicNowNs() - start;
+            if (frame == 0) rebuildsAfterFirst = cache.GetRebuilds();
+        }
+        rebuildsAfterFirst = cache.GetRebuilds() - rebuildsAfterFirst;
+
+        const ui::DashboardLayout& layout = cache.Get();
+        std::string problems;
+        if (layout.profile != profile) problems += " not-selected";
+        if (cache.GetRebuilds() != 1 || rebuildsAfterFirst != 0) problems += " rebuilt";
+
+        ImRect rects[sizeof(kPanels) / sizeof(kPanels[0])];
+        for (size_t i = 0; i < sizeof(kPanels) / sizeof(kPanels[0]); i++) {
+            if (!FindPanelRect(kPanels[i], rects[i])) {
+                problems += std::string(" missing:") + kPanels[i];
+            } else if (!Inside(rects[i], display)) {
+                problems += std::string(" outside:") + kPanels[i];
+            }
+        }
+        for (const auto& row : kRows) {
+            for (int i = 0; i + 1 < 3 && row[i + 1]; i++) {
+                ImRect left, right;
+                if (FindPanelRect(row[i], left) && FindPanelRect(row[i + 1], right) && left.Max.x > right.Min.x + 0.5f) {
+                    problems += std::string(" overlap:") + row[i];
+                }
+            }
+        }
+
+        ImRect camera;
+        float cameraHeight = FindPanelRect("RearCamera", camera) ? camera.GetHeight() : 0.0f;
+        if (cameraHeight < kMinCameraHeight) problems += " camera-height";
+        if (layout.speedRowSpacing < 0.0f) problems += " speed-row";
+        if (layout.text[ui::LayoutText_CameraInactive].x > layout.cameraWidth) problems += " camera-text";
+        if (layout.text[ui::LayoutText_NoFaults].x > layout.rightColumnWidth) problems += " fault-text";
+
+        bool ok = problems.empty();
+        allOk &= ok;
+        printf("  %-10s %7.1f %7.1f %7.1f %9.1f %9llu %6.1f us  %s\n", spec.name, layout.leftColumnWidth,
+               layout.centerColumnWidth, layout.gaugeWidth, cameraHeight,
+               static_cast<unsigned long long>(cache.GetRebuilds()),
+               static_cast<double>(totalNs) / kProfileFrames * 1e-3, ok ? "ok" : problems.c_str() + 1);
+    }
+
+    io.DisplaySize = savedSize;
+    state.layout = savedLayout;
+    return allOk;
+}
+
+void PrintUsage() {
+    printf("usage: headless_bench [--frames N] [--width W] [--height H] [--faults N] [--cells N] [--workers N]\n"
+           "                      [--overdraw PREFIX] [--frame-vertices N] [--strict] [--profiles] [--arena MB]\n");
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+
+        if (value && strcmp(arg, "--frames") == 0) {
+            options.frames = atoi(value); i++;
+        } else if (value && strcmp(arg, "--width") == 0) {
+            options.width = static_cast<float>(atof(value)); i++;
+        } else if (value && strcmp(arg, "--height") == 0) {
+            options.height = static_cast<float>(atof(value)); i++;
+        } else if (value && strcmp(arg, "--faults") == 0) {
+            options.faults = atoi(value); i++;
+        } else if (value && strcmp(arg, "--cells") == 0) {
+            options.cells = atoi(value); i++;
+        } else if (value && strcmp(arg, "--workers") == 0) {
+            options.workers = atoi(value); i++;
+        } else if (value && strcmp(arg, "--overdraw") == 0) {
+            options.overdraw = value; i++;
+        } else if (value && strcmp(arg, "--frame-vertices") == 0) {
+            options.frameVertices = atoi(value); i++;
+        } else if (strcmp(arg, "--strict") == 0) {
+            options.strict = true;
+        } else if (strcmp(arg, "--profiles") == 0) {
+            options.profiles = true;
+        } else if (value && strcmp(arg, "--arena") == 0) {
+            options.arenaMb = atoi(value); i++;
+        } else {
+            PrintUsage();
+            return 1;
+        }
+    }
+
+    if (options.frames <= 0 || options.arenaMb < 0) {
+        PrintUsage();
+        return 1;
+    }
+
+    // Never destroyed: blocks still held by statics are freed into it at exit
+    ui::ArenaAllocator* arena = nullptr;
+    if (options.arenaMb > 0) {
+        arena = new ui::ArenaAllocator(static_cast<size_t>(options.arenaMb) << 20);
+        ui::InstallImGuiAllocator(*arena);
+        ui::ArenaAllocator::SetGlobal(arena);
+    }
+
+    SetupContext(options);
+    ui::FaultHistory history;
+    ui::AppState state = MakeBenchState(history, options.faults, options.cells);
+    std::unique_ptr<ui::ParallelDraw> parallelDraw;
+    if (options.workers >= 0) {
+        parallelDraw.reset(new ui::ParallelDraw(options.workers));
+        state.parallelDraw = parallelDraw.get();
+    }
+
+    // Overruns show up in the table rather than as log lines every frame
+    ui::DrawBudget drawBudget(ui::BudgetAction::Count);
+    drawBudget.SetFrameBudget({ options.frameVertices, 0, 0 });
+
+    // Warm up so window creation and first-use allocations are excluded;
+    // with an arena, through one full scenario cycle
+    const int kWarmupFrames = arena ? kScenarioFrames * kScenarioSteps + 60 : 60;
+    std::vector<uint64_t> frameNs;
+    frameNs.reserve(static_cast<size_t>(options.frames));
+    std::vector<ui::ArenaAllocStats> frameAllocs;
+    frameAllocs.reserve(arena ? static_cast<size_t>(options.frames) : 0);
+    FrameStats stats;
+
+    for (int frame = -kWarmupFrames; frame < options.frames; frame++) {
+        state.heartbeat = static_cast<uint8_t>(frame);
+        if (arena) {
+            ApplyScenario(state, frame + kWarmupFrames);
+            if (frame == 0) arena->Seal();
+            arena->BeginFrame();
+        }
+        state.drawBudget = frame >= 0 ? &drawBudget : nullptr;
+        if (options.cells > 0) {
+            // One cell changes per frame, as with a BMS cycling through modules
+            state.cells.SetVoltage(static_cast<size_t>((frame + kWarmupFrames) % options.cells), 3.700f + 0.001f * (frame % 5));
+        }
+
+        uint64_t start = ui::MonotonicNowNs();
+        ImGui::NewFrame();
+        ui::RenderUI(state);
+        ImGui::Render();
+        uint64_t end = ui::MonotonicNowNs();
+
+        if (frame >= 0) {
+            frameNs.push_back(end - start);
+            stats = CollectFrameStats();
+            if (arena) frameAllocs.push_back(arena->GetFrameStats());
+        }
+    }
+
+    std::sort(frameNs.begin(), frameNs.end());
+    uint64_t totalNs = 0;
+    for (uint64_t ns : frameNs) totalNs += ns;
+
+    printf("display        %.0fx%.0f, %d frames, %d faults, %d cells\n",
+           options.width, options.height, options.frames, options.faults, options.cells);
+    printf("windows        %d\n", stats.windows);
+    printf("draw lists     %d\n", stats.drawLists);
+    printf("draw cmds      %d\n", stats.drawCmds);
+    printf("vertices       %d\n", stats.vertices);
+    printf("indices        %d\n", stats.indices);
+    printf("cpu mean       %.1f us\n", static_cast<double>(totalNs) / frameNs.size() * 1e-3);
+    printf("cpu p50        %.1f us\n", static_cast<double>(frameNs[frameNs.size() / 2]) * 1e-3);
+    printf("cpu p99        %.1f us\n", static_cast<double>(frameNs[frameNs.size() * 99 / 100]) * 1e-3);
+    if (parallelDraw) {
+        ui::ParallelDrawStats parallel = parallelDraw->GetStats();
+        double frames = options.frames + kWarmupFrames;
+        printf("parallel       %d workers, %.1f deferred/frame (%.1f on main), %.1f inline, %llu lost\n",
+               parallelDraw->GetWorkerCount(), parallel.deferred / frames, parallel.helped / frames,
+               parallel.inlined / frames, static_cast<unsigned long long>(parallel.lost));
+    }
+
+    bool ok = true;
+    if (arena) {
+        uint64_t allocations = 0, bytes = 0, carved = 0, peak = 0;
+        for (const ui::ArenaAllocStats& frame : frameAllocs) {
+            allocations += frame.allocations;
+            bytes += frame.bytes;
+            carved += frame.carved;
+            peak = std::max(peak, frame.allocations);
+        }
+        printf("allocations    %.1f/frame (peak %llu), %.1f KB/frame, %llu carved after warm-up\n",
+               static_cast<double>(allocations) / frameAllocs.size(), static_cast<unsigned long long>(peak),
+               static_cast<double>(bytes) / frameAllocs.size() / 1024.0, static_cast<unsigned long long>(carved));
+        printf("arena          %.1f of %d MB used, %llu malloc after warm-up\n", arena->GetArenaUsed() / 1048576.0,
+               options.arenaMb, static_cast<unsigned long long>(arena->GetHeapSinceSeal()));
+        ok &= arena->GetHeapSinceSeal() == 0;
+    }
+
+    uint64_t overruns = PrintBudgetTable(drawBudget);
+    ok &= !options.overdraw || ReportOverdraw(options.overdraw);
+    if (options.strict && overruns > 0) {
+        printf("budget         %llu overrun frames\n", static_cast<unsigned long long>(overruns));
+        ok = false;
+    }
+
+    state.drawBudget = nullptr;
+    if (options.profiles) {
+        printf("layout profiles\n");
+        if (!ValidateProfiles(state)) {
+            printf("profiles       FAILED\n");
+            ok = false;
+        }
+    }
+
+    state.parallelDraw = nullptr;
+    parallelDraw.reset();
+    ImGui::DestroyContext();
+    return ok ? 0 : 1;
+}
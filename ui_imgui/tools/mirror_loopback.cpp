@@ -0,0 +1,222 @@
+/**
+ * Dashboard mirroring loopback test
+ *
+ * Renders the dashboard headless (as headless_bench does), publishes every
+ * frame to a MirrorServer and receives it with a MirrorClient over
+ * loopback TCP, in lockstep. Each received frame is rebuilt into ImDrawData,
+ * serialized again and compared byte for byte with the original.
+ *
+ * Two phases: "parked" (nothing changes, so nothing should be sent after
+ * the keyframe) and "driving" (simulated drive cycle, speed and power
+ * changing every frame). Reports bytes on the wire per frame, the
+ * uncompressed frame image size, and encode/decode time per frame.
+ *
+ * Usage:
+ *   mirror_loopback [--frames N] [--width W] [--height H] [--port P]
+ *
+ * Build (Linux, IMGUI_DIR = Dear ImGui 1.91 source tree):
+ *   g++ -O2 -std=c++17 -pthread -I.. -I$IMGUI_DIR mirror_loopback.cpp ../draw_mirror.cpp \
+ *       ../dashboard.cpp ../widgets.cpp ../theme.cpp ../layout_cache.cpp \
+ *       ../parallel_draw.cpp ../draw_budget.cpp ../frame_pacer.cpp ../signal_interp.cpp \
+ *       ../signal_freshness.cpp ../session_store.cpp \
+ *       ../fault_aggregator.cpp ../fault_history.cpp ../fault_journal.cpp \
+ *       ../vehicle_sim.cpp ../cell_telemetry.cpp ../cell_heatmap.cpp \
+ *       $IMGUI_DIR/imgui.cpp $IMGUI_DIR/imgui_draw.cpp \
+ *       $IMGUI_DIR/imgui_tables.cpp $IMGUI_DIR/imgui_widgets.cpp
+ */
+
+#include "../ui.h"
+#include "../draw_mirror.h"
+#include "../monotonic_clock.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+struct Options {
+    int frames = 600;
+    float width = 1280.0f;
+    float height = 720.0f;
+    uint16_t port = 0;      // 0 = any free port
+};
+
+struct PhaseResult {
+    int frames = 0;
+    uint64_t sentBytes = 0;
+    uint64_t imageBytes = 0;     // Uncompressed images, all frames
+    uint64_t framesEncoded = 0;
+    uint64_t framesUnchanged = 0;
+    uint64_t encodeNs = 0;
+    uint64_t decodeNs = 0;
+    bool ok = true;
+};
+
+void SetupContext(const Options& options) {
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = nullptr;
+    io.DisplaySize = ImVec2(options.width, options.height);
+    io.DeltaTime = 1.0f / 60.0f;
+
+    ui::InitUI();
+
+    unsigned char* pixels = nullptr;
+    int texWidth = 0, texHeight = 0;
+    io.Fonts->GetTexDataAsRGBA32(&pixels, &texWidth, &texHeight);
+    io.Fonts->SetTexID(static_cast<ImTextureID>(1));
+}
+
+// Wait until the server has handled every published frame and the client
+// has decoded everything that was sent
+bool WaitForClient(ui::mirror::MirrorServer& server, ui::mirror::MirrorClient& client) {
+    uint64_t deadline = ui::MonotonicNowNs() + 2000000000ull;
+    while (ui::MonotonicNowNs() < deadline && client.IsConnected()) {
+        ui::mirror::MirrorServerStats stats = server.GetStats();
+        bool handled = stats.framesEncoded + stats.framesUnchanged + stats.framesCoalesced == stats.framesPublished;
+        if (handled && client.GetFrameNumber() == stats.framesEncoded) return true;
+        client.Poll(1);
+    }
+    return false;
+}
+
+PhaseResult RunPhase(ui::AppState& state, bool driving, int frames,
+                     ui::mirror::MirrorServer& server, ui::mirror::MirrorClient& client) {
+    PhaseResult result;
+    ui::mirror::MirrorServerStats before = server.GetStats();
+    ui::mirror::MirrorClientStats clientBefore = client.GetStats();
+    std::vector<uint8_t> original, mirrored;
+    const ImFontAtlas* atlas = ImGui::GetIO().Fonts;
+
+    for (int frame = 0; frame < frames; frame++) {
+        if (driving) ui::UpdateSimulation(state, 1.0f / 60.0f);
+
+        ImGui::NewFrame();
+        ui::RenderUI(state);
+        ImGui::Render();
+        server.Publish(ImGui::GetDrawData());
+
+        if (!WaitForClient(server, client)) {
+            printf("frame %d: viewer did not catch up\n", frame);
+            result.ok = false;
+            break;
+        }
+
+        ui::mirror::SerializeDrawData(ImGui::GetDrawData(), atlas->TexID, atlas->TexWidth, atlas->TexHeight, original);
+        ui::mirror::SerializeDrawData(client.GetDrawData(), atlas->TexID, atlas->TexWidth, atlas->TexHeight, mirrored);
+        if (original != mirrored) {
+            printf("frame %d: mirrored draw data differs (%zu vs %zu bytes)\n", frame, mirrored.size(), original.size());
+            result.ok = false;
+            break;
+        }
+        result.imageBytes += original.size();
+        result.frames++;
+    }
+
+    ui::mirror::MirrorServerStats after = server.GetStats();
+    result.sentBytes = after.sentBytes - before.sentBytes;
+    result.framesEncoded = after.framesEncoded - before.framesEncoded;
+    result.framesUnchanged = after.framesUnchanged - before.framesUnchanged;
+    result.encodeNs = after.encodeNs - before.encodeNs;
+    result.decodeNs = client.GetStats().decodeNs - clientBefore.decodeNs;
+    return result;
+}
+
+void PrintPhase(const char* name, const PhaseResult& r) {
+    double frames = r.frames > 0 ? r.frames : 1;
+    printf("%-8s       %d frames, %llu sent, %llu unchanged\n", name, r.frames,
+           static_cast<unsigned long long>(r.framesEncoded), static_cast<unsigned long long>(r.framesUnchanged));
+    printf("  wire         %.1f bytes/frame (%.1f KB/s at 60 Hz)\n",
+           r.sentBytes / frames, r.sentBytes / frames * 60.0 / 1024.0);
+    printf("  image        %.1f KB/frame uncompressed (%.0fx)\n", r.imageBytes / frames / 1024.0,
+           r.sentBytes ? static_cast<double>(r.imageBytes) / r.sentBytes : 0.0);
+    printf("  encode       %.1f us/frame\n", r.encodeNs / frames * 1e-3);
+    printf("  decode       %.1f us/frame\n", r.decodeNs / frames * 1e-3);
+}
+
+void PrintUsage() {
+    printf("usage: mirror_loopback [--frames N] [--width W] [--height H] [--port P]\n");
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+
+        if (value && strcmp(arg, "--frames") == 0) {
+            options.frames = atoi(value); i++;
+        } else if (value && strcmp(arg, "--width") == 0) {
+            options.width = static_cast<float>(atof(value)); i++;
+        } else if (value && strcmp(arg, "--height") == 0) {
+            options.height = static_cast<float>(atof(value)); i++;
+        } else if (value && strcmp(arg, "--port") == 0) {
+            options.port = static_cast<uint16_t>(atoi(value)); i++;
+        } else {
+            PrintUsage();
+            return 1;
+        }
+    }
+
+    if (options.frames <= 0) {
+        PrintUsage();
+        return 1;
+    }
+
+    SetupContext(options);
+
+    ui::mirror::MirrorServerConfig config;
+    config.bindAddress = "127.0.0.1";
+    config.port = options.port;
+    ui::mirror::MirrorServer server(config);
+    if (!server.Start()) {
+        printf("cannot bind 127.0.0.1:%u\n", options.port);
+        return 1;
+    }
+
+    ui::mirror::MirrorClient client;
+    if (!client.Connect("127.0.0.1", server.GetPort())) {
+        printf("cannot connect to the mirror server\n");
+        return 1;
+    }
+    while (server.GetStats().clients == 0) client.Poll(1);
+
+    // Parked: contactors open, in P, nothing animating
+    ui::AppState state = ui::CreateDefaultState();
+    state.gear = ui::Gear::Park;
+    state.speed = 0;
+    state.turnSignal = ui::TurnSignal::None;
+    state.cells.SetCellCount(96);
+    for (int i = 0; i < 96; i++) {
+        state.cells.SetVoltage(i, 3.700f + 0.001f * (i % 7));
+        state.cells.SetTemperature(i, 30.0f + 0.1f * (i % 11));
+    }
+
+    // The first frame goes out as a keyframe; measure it on its own
+    PhaseResult keyframe = RunPhase(state, false, 1, server, client);
+    PhaseResult parked = keyframe.ok ? RunPhase(state, false, options.frames, server, client) : PhaseResult();
+
+    // Driving: close the contactor, select D, release the brake
+    state.contactorStates = { true, false, true };
+    state.gear = ui::Gear::Drive;
+    state.brakeEngaged = false;
+    PhaseResult driving = parked.ok ? RunPhase(state, true, options.frames, server, client) : PhaseResult();
+
+    printf("display        %.0fx%.0f, %d frames per phase\n", options.width, options.height, options.frames);
+    printf("keyframe       %llu bytes (image %llu bytes, encode %.1f us)\n",
+           static_cast<unsigned long long>(keyframe.sentBytes), static_cast<unsigned long long>(keyframe.imageBytes),
+           keyframe.encodeNs * 1e-3);
+    if (keyframe.ok) PrintPhase("parked", parked);
+    if (parked.ok) PrintPhase("driving", driving);
+    printf("atlas          %s\n", client.AtlasMatches() ? "matches" : "differs");
+
+    bool ok = keyframe.ok && parked.ok && driving.ok && driving.frames == options.frames;
+    server.Stop();
+    ImGui::DestroyContext();
+    printf("%s\n", ok ? "OK" : "FAILED");
+    return ok ? 0 : 1;
+}
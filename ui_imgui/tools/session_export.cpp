@@ -0,0 +1,126 @@
+/**
+ * Session export
+ *
+ * Converts a recorded session (session_store.h) into a columnar file
+ * (session_export.h) and prints the per-column size and encodings.
+ *
+ * Usage:
+ *   session_export SESSION OUT [--row-group N]
+ *
+ * Build (Linux):
+ *   g++ -O2 -std=c++17 -I.. session_export.cpp ../session_export.cpp ../column_file.cpp ../telemetry_codec.cpp \
+ *       ../session_store.cpp ../fault_aggregator.cpp ../fault_history.cpp ../fault_journal.cpp ../cell_telemetry.cpp
+ */
+
+#include "../session_export.h"
+#include "../monotonic_clock.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace {
+
+struct Options {
+    const char* session = nullptr;
+    const char* out = nullptr;
+    uint32_t rowGroupRows = 65536;
+};
+
+const char* EncodingName(ui::ColumnEncoding encoding) {
+    switch (encoding) {
+        case ui::ColumnEncoding::Plain: return "plain";
+        case ui::ColumnEncoding::Delta: return "delta";
+        case ui::ColumnEncoding::FrameOfRef: return "for";
+        case ui::ColumnEncoding::Dictionary: return "dict";
+        case ui::ColumnEncoding::DeltaOfDelta: return "dod";
+        case ui::ColumnEncoding::XorFloat: return "xor";
+        case ui::ColumnEncoding::Count: break;
+    }
+    return "?";
+}
+
+void PrintTable(const ui::ColumnTable& table) {
+    printf("table %-8s %llu rows, %zu row groups\n", table.name.c_str(), static_cast<unsigned long long>(table.rows),
+           table.rowGroups.size());
+    for (size_t c = 0; c < table.columns.size(); c++) {
+        uint64_t bytes = 0;
+        int used[static_cast<int>(ui::ColumnEncoding::Count)] = {};
+        for (const ui::ColumnRowGroup& group : table.rowGroups) {
+            bytes += group.chunks[c].size;
+            used[static_cast<int>(group.chunks[c].encoding)]++;
+        }
+        char encodings[64] = "";
+        for (int e = 0; e < static_cast<int>(ui::ColumnEncoding::Count); e++) {
+            if (!used[e]) continue;
+            size_t at = strlen(encodings);
+            snprintf(encodings + at, sizeof(encodings) - at, "%s%s x%d", at ? ", " : "",
+                     EncodingName(static_cast<ui::ColumnEncoding>(e)), used[e]);
+        }
+        printf("  %-20s %10.1f KB  %5.2f bytes/row  %s\n", table.columns[c].name.c_str(),
+               static_cast<double>(bytes) / 1024.0,
+               table.rows ? static_cast<double>(bytes) / static_cast<double>(table.rows) : 0.0, encodings);
+    }
+}
+
+void PrintUsage() {
+    printf("usage: session_export SESSION OUT [--row-group N]\n");
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+
+        if (value && strcmp(arg, "--row-group") == 0) {
+            options.rowGroupRows = static_cast<uint32_t>(atoi(value)); i++;
+        } else if (arg[0] != '-' && !options.session) {
+            options.session = arg;
+        } else if (arg[0] != '-' && !options.out) {
+            options.out = arg;
+        } else {
+            PrintUsage();
+            return 1;
+        }
+    }
+
+    if (!options.session || !options.out || options.rowGroupRows == 0) {
+        PrintUsage();
+        return 1;
+    }
+
+    ui::SessionReader reader;
+    if (!reader.Open(options.session)) {
+        printf("cannot open %s (missing or not a session recording)\n", options.session);
+        return 1;
+    }
+
+    ui::SessionExportOptions exportOptions;
+    exportOptions.rowGroupRows = options.rowGroupRows;
+    ui::SessionExportStats stats;
+    uint64_t start = ui::MonotonicNowNs();
+    bool ok = ui::ExportSessionColumns(reader, options.out, exportOptions, &stats);
+    double seconds = static_cast<double>(ui::MonotonicNowNs() - start) * 1e-9;
+    if (!ok) {
+        printf("export to %s failed\n", options.out);
+        return 1;
+    }
+
+    printf("exported       %llu rows, %llu fault episodes in %.2f s\n", static_cast<unsigned long long>(stats.rows),
+           static_cast<unsigned long long>(stats.faultEpisodes), seconds);
+    printf("size           %.1f MB (session %.1f MB)\n", static_cast<double>(stats.bytes) / (1024.0 * 1024.0),
+           static_cast<double>(reader.GetSize()) / (1024.0 * 1024.0));
+
+    ui::ColumnFileReader columns;
+    if (!columns.Open(options.out)) {
+        printf("cannot read back %s\n", options.out);
+        return 1;
+    }
+    for (size_t t = 0; t < columns.GetTableCount(); t++) PrintTable(columns.GetTable(t));
+
+    printf("OK\n");
+    return 0;
+}
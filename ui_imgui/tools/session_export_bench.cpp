@@ -0,0 +1,374 @@
+/**
+ * Session export benchmark
+ *
+ * Records a synthetic session of --hours at 60 Hz (parked, city and
+ * highway stretches, faults raised and resolved), exports it with
+ * ExportSessionColumns() (session_export.h) and checks:
+ *   size       columnar file vs. the same signal rows as CSV
+ *   round trip every signal value read back equals the session, row by
+ *              row (all columns streamed in lockstep), and the fault
+ *              episodes equal the ones raised
+ *   predicate  speed >= 95 scanned with row-group skipping finds the same
+ *              rows as a full scan
+ *   scan       each signal column streamed on its own, in M values/s and
+ *              GB/s of decoded values, next to memcpy bandwidth
+ *
+ * Usage:
+ *   session_export_bench [--hours H] [--row-group N] [--path FILE] [--keep]
+ *
+ * Build (Linux):
+ *   g++ -O2 -std=c++17 -I.. session_export_bench.cpp ../session_export.cpp ../column_file.cpp ../telemetry_codec.cpp \
+ *       ../session_store.cpp ../fault_aggregator.cpp ../fault_history.cpp ../fault_journal.cpp ../cell_telemetry.cpp
+ */
+
+#include "../session_export.h"
+#include "../monotonic_clock.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+namespace {
+
+struct Options {
+    double hours = 3.0;
+    uint32_t rowGroupRows = 65536;
+    const char* path = "session_export_bench";
+    bool keep = false;
+};
+
+constexpr int kHz = 60;
+constexpr uint64_t kStartNs = 1000000000ull;
+constexpr int64_t kHighwaySpeed = 95;
+
+volatile int64_t g_sink;
+
+struct RaisedFault {
+    std::string code;
+    uint64_t startNs;
+};
+
+// 20-minute phases: parked, city, highway, city
+void Step(ui::AppState& state, std::mt19937& rng, uint64_t frame, std::vector<RaisedFault>& raised, int& faultFrames) {
+    double t = static_cast<double>(frame) / kHz;
+    int phase = static_cast<int>(t / 1200.0) % 4;
+    bool parked = phase == 0;
+    state.gear = parked ? ui::Gear::Park : ui::Gear::Drive;
+    state.brakeEngaged = parked;
+    state.contactorStates = { !parked, false, true };
+    if (parked) {
+        state.speed = 0;
+    } else if (phase == 2) {
+        state.speed = static_cast<int>(105.0 + 8.0 * std::sin(t * 0.05));
+    } else {
+        state.speed = static_cast<int>(std::max(0.0, 30.0 + 20.0 * std::sin(t * 0.2)));
+    }
+    state.mainBattery.current = (parked ? -1.0f : -40.0f) + static_cast<float>(rng() % 1000) * 0.01f;
+    state.mainBattery.soc = std::max(0.0f, 95.0f - static_cast<float>(t) * 0.002f);
+    state.mainBattery.voltage = 330.0f + state.mainBattery.soc * 0.3f;
+    state.suppBattery.voltage = 12.6f + static_cast<float>(frame / (kHz * 30) % 3) * 0.1f;
+    state.cruise.enabled = phase == 2;
+    state.cruise.setSpeed = phase == 2 ? 105 : 0;
+    state.heartbeat = static_cast<uint8_t>(frame / 6);
+    state.turnSignal = !parked && static_cast<int>(t) % 97 < 3 ? ui::TurnSignal::Left : ui::TurnSignal::None;
+
+    if (faultFrames > 0 && --faultFrames == 0) {
+        state.faults.Resolve(state.faults.At(0).code);
+    } else if (faultFrames == 0 && frame % (kHz * 300) == kHz * 100) {
+        char code[8];
+        snprintf(code, sizeof(code), "E%03d", static_cast<int>(raised.size() % 12));
+        state.faults.Report({ code, raised.size() % 2 ? "Cell overtemperature" : "CAN timeout",
+                              ui::FaultSeverity::Warning, 1700000000000ll + static_cast<int64_t>(t * 1000.0) });
+        raised.push_back({ code, kStartNs + frame * (1000000000ull / kHz) });
+        faultFrames = kHz * (1 + static_cast<int>(rng() % 120));
+    }
+}
+
+// Same signal rows as the "signals" table, as an analyst's CSV dump
+size_t CsvRow(char* out, size_t capacity, uint64_t timeNs, const ui::WireVehicleState& s) {
+    int n = snprintf(out, capacity, "%llu,%d,%u,%.3f,%.3f,%.3f,%.3f,%.3f,%u,%d,%u,%u,%u,%u,%u,%u,%u\n",
+                     static_cast<unsigned long long>(timeNs), s.speed, s.gear, s.mainBatterySoc,
+                     s.mainBatteryVoltage, s.mainBatteryCurrent, s.suppBatterySoc, s.suppBatteryVoltage,
+                     s.cruiseEnabled, s.cruiseSetSpeed, s.brakeEngaged, s.contactorStatesMain,
+                     s.contactorStatesPrecharge, s.contactorStatesHvil, s.heartbeat, s.turnSignal, s.faultsCount);
+    return n > 0 ? static_cast<size_t>(n) : 0;
+}
+
+struct CsvSink {
+    FILE* file;
+    uint64_t bytes = 0;
+};
+
+bool WriteCsv(uint64_t timeNs, const ui::WireVehicleState& state, void* userData) {
+    CsvSink* sink = static_cast<CsvSink*>(userData);
+    char row[256];
+    size_t size = CsvRow(row, sizeof(row), timeNs, state);
+    sink->bytes += fwrite(row, 1, size, sink->file);
+    return true;
+}
+
+// All signal columns streamed in lockstep against a second session scan
+struct RoundTrip {
+    const ui::ColumnFileReader* reader;
+    int table;
+    std::vector<ui::ColumnScanner> scanners;
+    size_t row = 0;
+    size_t rows = 0;
+    uint64_t checked = 0;
+    uint64_t mismatches = 0;
+
+    int64_t Int(const char* name) const {
+        return scanners[reader->FindColumn(table, name)].GetData().ints[row];
+    }
+    float Float(const char* name) const {
+        return scanners[reader->FindColumn(table, name)].GetData().floats[row];
+    }
+
+    static bool Visit(uint64_t timeNs, const ui::WireVehicleState& s, void* userData) {
+        RoundTrip* trip = static_cast<RoundTrip*>(userData);
+        if (trip->row == trip->rows) {
+            trip->row = 0;
+            trip->rows = 0;
+            for (ui::ColumnScanner& scanner : trip->scanners) trip->rows = scanner.Next();
+            if (trip->rows == 0) {
+                trip->mismatches++;
+                return false;
+            }
+        }
+        bool same = trip->Int("time_ns") == static_cast<int64_t>(timeNs) && trip->Int("speed") == s.speed &&
+                    trip->Int("gear") == s.gear && trip->Float("main_soc") == s.mainBatterySoc &&
+                    trip->Float("main_voltage") == s.mainBatteryVoltage &&
+                    trip->Float("main_current") == s.mainBatteryCurrent &&
+                    trip->Float("supp_soc") == s.suppBatterySoc &&
+                    trip->Float("supp_voltage") == s.suppBatteryVoltage &&
+                    trip->Int("cruise_enabled") == s.cruiseEnabled &&
+                    trip->Int("cruise_set_speed") == s.cruiseSetSpeed &&
+                    trip->Int("brake_engaged") == s.brakeEngaged &&
+                    trip->Int("contactor_main") == s.contactorStatesMain &&
+                    trip->Int("contactor_precharge") == s.contactorStatesPrecharge &&
+                    trip->Int("contactor_hvil") == s.contactorStatesHvil &&
+                    trip->Int("heartbeat") == s.heartbeat && trip->Int("turn_signal") == s.turnSignal &&
+                    trip->Int("fault_count") == s.faultsCount;
+        if (!same) trip->mismatches++;
+        trip->checked++;
+        trip->row++;
+        return true;
+    }
+};
+
+bool CheckRoundTrip(ui::SessionReader& session, const ui::ColumnFileReader& reader) {
+    RoundTrip trip;
+    trip.reader = &reader;
+    trip.table = reader.FindTable("signals");
+    for (size_t c = 0; c < reader.GetTable(trip.table).columns.size(); c++) {
+        trip.scanners.emplace_back(reader, trip.table, static_cast<int>(c));
+    }
+    session.Scan(RoundTrip::Visit, &trip);
+    bool ok = trip.mismatches == 0 && trip.checked == reader.GetTable(trip.table).rows;
+    printf("round trip     %llu rows x %zu columns, %llu mismatches\n", static_cast<unsigned long long>(trip.checked),
+           trip.scanners.size(), static_cast<unsigned long long>(trip.mismatches));
+    return ok;
+}
+
+bool CheckFaults(const ui::ColumnFileReader& reader, const std::vector<RaisedFault>& raised) {
+    int table = reader.FindTable("faults");
+    ui::ColumnScanner codes(reader, table, reader.FindColumn(table, "code"));
+    ui::ColumnScanner starts(reader, table, reader.FindColumn(table, "start_ns"));
+    ui::ColumnScanner ends(reader, table, reader.FindColumn(table, "end_ns"));
+
+    size_t episodes = 0;
+    size_t mismatches = 0;
+    while (size_t rows = codes.Next()) {
+        starts.Next();
+        ends.Next();
+        const ui::ColumnChunkData& code = codes.GetData();
+        for (size_t i = 0; i < rows; i++, episodes++) {
+            bool same = episodes < raised.size() && code.dictionary[code.ints[i]] == raised[episodes].code &&
+                        static_cast<uint64_t>(starts.GetData().ints[i]) == raised[episodes].startNs &&
+                        ends.GetData().ints[i] > starts.GetData().ints[i];
+            if (!same) mismatches++;
+        }
+    }
+    printf("faults         %zu episodes (%zu raised), %zu mismatches\n", episodes, raised.size(), mismatches);
+    return episodes == raised.size() && mismatches == 0;
+}
+
+bool CheckPredicate(const ui::ColumnFileReader& reader) {
+    int table = reader.FindTable("signals");
+    int speed = reader.FindColumn(table, "speed");
+
+    uint64_t full = 0;
+    ui::ColumnScanner all(reader, table, speed);
+    while (size_t rows = all.Next()) {
+        const int64_t* values = all.GetData().ints.data();
+        for (size_t i = 0; i < rows; i++) full += values[i] >= kHighwaySpeed;
+    }
+
+    uint64_t matched = 0;
+    size_t groups = 0;
+    ui::ColumnScanner ranged(reader, table, speed);
+    ranged.SetIntRange(kHighwaySpeed, INT64_MAX);
+    while (size_t rows = ranged.Next()) {
+        const int64_t* values = ranged.GetData().ints.data();
+        for (size_t i = 0; i < rows; i++) matched += values[i] >= kHighwaySpeed;
+        groups++;
+    }
+    printf("predicate      speed >= %lld: %llu rows, %zu of %zu row groups skipped by min/max\n",
+           static_cast<long long>(kHighwaySpeed), static_cast<unsigned long long>(matched),
+           ranged.GetSkippedGroups(), ranged.GetSkippedGroups() + groups);
+    return matched == full && ranged.GetSkippedGroups() > 0;
+}
+
+double MemcpyGBps() {
+    std::vector<uint8_t> from(256 << 20, 1);
+    std::vector<uint8_t> to(from.size());
+    double best = 0.0;
+    for (int pass = 0; pass < 3; pass++) {
+        uint64_t start = ui::MonotonicNowNs();
+        memcpy(to.data(), from.data(), from.size());
+        double seconds = static_cast<double>(ui::MonotonicNowNs() - start) * 1e-9;
+        best = std::max(best, static_cast<double>(from.size()) / seconds * 1e-9);
+    }
+    g_sink = to[12345];
+    return best;
+}
+
+void TimeScans(const ui::ColumnFileReader& reader) {
+    int table = reader.FindTable("signals");
+    const ui::ColumnTable& t = reader.GetTable(table);
+    printf("memcpy         %.1f GB/s\n", MemcpyGBps());
+    for (size_t c = 0; c < t.columns.size(); c++) {
+        double best = 1e30;
+        for (int pass = 0; pass < 3; pass++) {
+            ui::ColumnScanner scan(reader, table, static_cast<int>(c));
+            uint64_t start = ui::MonotonicNowNs();
+            int64_t sum = 0;
+            while (size_t rows = scan.Next()) {
+                sum += t.columns[c].type == ui::ColumnType::Float ? static_cast<int64_t>(scan.GetData().floats[rows - 1])
+                                                                  : scan.GetData().ints[rows - 1];
+            }
+            g_sink = sum;
+            best = std::min(best, static_cast<double>(ui::MonotonicNowNs() - start) * 1e-9);
+        }
+        uint64_t bytes = 0;
+        for (const ui::ColumnRowGroup& group : t.rowGroups) bytes += group.chunks[c].size;
+        size_t width = t.columns[c].type == ui::ColumnType::Float ? sizeof(float) : sizeof(int64_t);
+        printf("scan %-19s %7.1f M values/s, %5.2f GB/s decoded (%.2f bytes/row stored)\n", t.columns[c].name.c_str(),
+               static_cast<double>(t.rows) / best * 1e-6, static_cast<double>(t.rows * width) / best * 1e-9,
+               static_cast<double>(bytes) / static_cast<double>(t.rows));
+    }
+}
+
+void PrintUsage() {
+    printf("usage: session_export_bench [--hours H] [--row-group N] [--path FILE] [--keep]\n");
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+
+        if (strcmp(arg, "--keep") == 0) {
+            options.keep = true;
+        } else if (value && strcmp(arg, "--hours") == 0) {
+            options.hours = atof(value); i++;
+        } else if (value && strcmp(arg, "--row-group") == 0) {
+            options.rowGroupRows = static_cast<uint32_t>(atoi(value)); i++;
+        } else if (value && strcmp(arg, "--path") == 0) {
+            options.path = value; i++;
+        } else {
+            PrintUsage();
+            return 1;
+        }
+    }
+
+    if (options.hours <= 0.0 || options.rowGroupRows == 0) {
+        PrintUsage();
+        return 1;
+    }
+
+    std::string sessionPath = std::string(options.path) + ".rec";
+    std::string columnPath = std::string(options.path) + ".col";
+    std::string csvPath = std::string(options.path) + ".csv";
+
+    // Record
+    ui::SessionWriter writer;
+    if (!writer.Open(sessionPath.c_str())) {
+        printf("cannot create %s\n", sessionPath.c_str());
+        return 1;
+    }
+    ui::AppState state = ui::CreateDefaultState();
+    std::mt19937 rng(17);
+    std::vector<RaisedFault> raised;
+    int faultFrames = 0;
+    uint64_t frames = static_cast<uint64_t>(options.hours * 3600.0 * kHz);
+    for (uint64_t frame = 0; frame < frames; frame++) {
+        Step(state, rng, frame, raised, faultFrames);
+        writer.Record(state, kStartNs + frame * (1000000000ull / kHz));
+    }
+    writer.Close();
+
+    ui::SessionReader session;
+    if (!session.Open(sessionPath.c_str())) {
+        printf("cannot open %s\n", sessionPath.c_str());
+        return 1;
+    }
+
+    // Export, and the CSV it replaces
+    ui::SessionExportOptions exportOptions;
+    exportOptions.rowGroupRows = options.rowGroupRows;
+    ui::SessionExportStats stats;
+    uint64_t start = ui::MonotonicNowNs();
+    bool ok = ui::ExportSessionColumns(session, columnPath.c_str(), exportOptions, &stats);
+    double exportMs = static_cast<double>(ui::MonotonicNowNs() - start) * 1e-6;
+
+    CsvSink csv;
+    csv.file = fopen(csvPath.c_str(), "w");
+    if (!ok || !csv.file) {
+        printf("cannot write %s / %s\n", columnPath.c_str(), csvPath.c_str());
+        return 1;
+    }
+    session.Scan(WriteCsv, &csv);
+    fclose(csv.file);
+
+    printf("session        %.1f h at %d Hz: %llu records, %.1f MB\n", options.hours, kHz,
+           static_cast<unsigned long long>(session.GetRecordCount()),
+           static_cast<double>(session.GetSize()) / (1024.0 * 1024.0));
+    printf("export         %llu rows, %llu fault episodes in %.0f ms\n", static_cast<unsigned long long>(stats.rows),
+           static_cast<unsigned long long>(stats.faultEpisodes), exportMs);
+    printf("size           %.1f MB columnar vs %.1f MB CSV (%.1fx smaller, %.2f vs %.1f bytes/row)\n",
+           static_cast<double>(stats.bytes) / (1024.0 * 1024.0), static_cast<double>(csv.bytes) / (1024.0 * 1024.0),
+           static_cast<double>(csv.bytes) / static_cast<double>(stats.bytes),
+           static_cast<double>(stats.bytes) / static_cast<double>(stats.rows),
+           static_cast<double>(csv.bytes) / static_cast<double>(stats.rows));
+
+    ui::ColumnFileReader reader;
+    if (!reader.Open(columnPath.c_str())) {
+        printf("cannot read back %s\n", columnPath.c_str());
+        return 1;
+    }
+    ok &= CheckRoundTrip(session, reader);
+    ok &= CheckFaults(reader, raised);
+    ok &= CheckPredicate(reader);
+    TimeScans(reader);
+
+    printf("%s\n", ok ? "OK" : "FAILED");
+    reader.Close();
+    session.Close();
+    if (!options.keep) {
+        unlink(sessionPath.c_str());
+        unlink(columnPath.c_str());
+        unlink(csvPath.c_str());
+    }
+    return ok ? 0 : 1;
+}
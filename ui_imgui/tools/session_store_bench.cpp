@@ -0,0 +1,308 @@
+/**
+ * Session store benchmark
+ *
+ * Records a synthetic drive of --hours at --hz frames per second through
+ * SessionWriter (session_store.h): noisy battery current, a speed profile,
+ * a 10 Hz heartbeat and faults raised and resolved every few minutes. Then
+ * checks the SessionReader:
+ *   seek       sampled frames reconstruct exactly (EncodeWire at record
+ *              time vs Seek()), also between frames and via ApplyWireToState
+ *   timing     random seeks and a scrub drag across the whole recording,
+ *              forward and back: p99 against --max-seek-us, max within
+ *              one 60 Hz frame
+ *   playback   forward seeks inside a GOP apply one delta per frame
+ *   live       records flushed after Open() appear on Refresh()
+ *   torn tail  a truncated last record is ignored on reopen
+ *
+ * Usage:
+ *   session_store_bench [--hours H] [--hz N] [--max-seek-us US] [--path FILE] [--keep]
+ *
+ * Build (Linux):
+ *   g++ -O2 -std=c++17 -I.. session_store_bench.cpp ../session_store.cpp \
+ *       ../fault_aggregator.cpp ../fault_history.cpp ../fault_journal.cpp ../cell_telemetry.cpp
+ */
+
+#include "../session_store.h"
+#include "../monotonic_clock.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+namespace {
+
+struct Options {
+    double hours = 3.0;
+    int hz = 60;
+    double maxSeekUs = 1000.0;
+    const char* path = "session_store_bench.rec";
+    bool keep = false;
+};
+
+constexpr uint64_t kStartNs = 1000000000ull;
+constexpr size_t kSampleEvery = 997;            // Frames between stored expectations
+constexpr double kFrameUs = 1e6 / 60.0;
+
+struct Sample {
+    uint64_t timeNs;
+    ui::WireVehicleState wire;
+};
+
+struct Drive {
+    ui::AppState state = ui::CreateDefaultState();
+    std::mt19937 rng{ 11 };
+    int faultFrames = 0;
+    int nextFault = 0;
+
+    // One frame of synthetic telemetry
+    void Step(uint64_t frame, int hz) {
+        double t = static_cast<double>(frame) / hz;
+        state.gear = ui::Gear::Drive;
+        state.brakeEngaged = false;
+        state.contactorStates = { true, false, true };
+        state.speed = static_cast<int>(60.0 + 40.0 * std::sin(t * 0.01) + 10.0 * std::sin(t * 0.13));
+        state.mainBattery.current = -40.0f + static_cast<float>(rng() % 2000) * 0.01f;
+        state.mainBattery.soc = std::max(0.0f, 95.0f - static_cast<float>(t) * 0.002f);
+        state.mainBattery.voltage = 330.0f + state.mainBattery.soc * 0.3f;
+        state.suppBattery.voltage = 12.6f + static_cast<float>(frame / (hz * 30) % 3) * 0.1f;
+        state.cruise.enabled = static_cast<int>(t / 600.0) % 2 == 1;
+        state.cruise.setSpeed = state.cruise.enabled ? 80 : 0;
+        state.heartbeat = static_cast<uint8_t>(frame * 10 / hz);
+        state.turnSignal = static_cast<int>(t) % 97 < 3 ? ui::TurnSignal::Left : ui::TurnSignal::None;
+
+        // A fault every ~4 minutes, lasting 0.2 s to 90 s (some inside one GOP)
+        if (faultFrames > 0 && --faultFrames == 0) {
+            state.faults.Resolve(state.faults.At(0).code);
+        } else if (faultFrames == 0 && frame % (static_cast<uint64_t>(hz) * 240) == static_cast<uint64_t>(hz) * 100) {
+            char code[8];
+            snprintf(code, sizeof(code), "E%03d", nextFault++ % 40);
+            ui::Fault fault{ code, "Synthetic fault", ui::FaultSeverity::Warning,
+                             1700000000000ll + static_cast<int64_t>(t * 1000.0) };
+            state.faults.Report(fault);
+            faultFrames = nextFault % 3 == 0 ? hz / 5 : hz * (1 + static_cast<int>(rng() % 90));
+        }
+    }
+};
+
+double Percentile(std::vector<double>& values, double p) {
+    std::sort(values.begin(), values.end());
+    size_t index = static_cast<size_t>(p / 100.0 * static_cast<double>(values.size() - 1));
+    return values[index];
+}
+
+bool CheckSamples(ui::SessionReader& reader, const std::vector<Sample>& samples) {
+    std::mt19937 rng(5);
+    std::vector<size_t> order(samples.size());
+    for (size_t i = 0; i < order.size(); i++) order[i] = i;
+    std::shuffle(order.begin(), order.end(), rng);
+
+    ui::AppState state = ui::CreateDefaultState();
+    int mismatches = 0;
+    for (size_t i : order) {
+        const Sample& sample = samples[i];
+        // Exactly at the frame and just before the next one
+        for (uint64_t t : { sample.timeNs, sample.timeNs + 1000 }) {
+            const ui::WireVehicleState* wire = reader.Seek(t);
+            if (!wire || memcmp(wire, &sample.wire, sizeof(sample.wire)) != 0) mismatches++;
+        }
+        ui::ApplyWireToState(sample.wire, state);
+        if (!ui::WireMatches(sample.wire, state)) mismatches++;
+    }
+    bool beforeStart = reader.Seek(reader.GetStartNs() - 1) == nullptr;
+
+    printf("seek           %zu sampled frames in random order, %d mismatches\n", samples.size(), mismatches);
+    return mismatches == 0 && beforeStart;
+}
+
+bool TimeSeeks(ui::SessionReader& reader, const Options& options) {
+    uint64_t startNs = reader.GetStartNs();
+    uint64_t spanNs = reader.GetEndNs() - startNs;
+
+    std::mt19937_64 rng(9);
+    std::vector<double> randomUs;
+    uint32_t maxDeltas = 0;
+    for (int i = 0; i < 20000; i++) {
+        uint64_t t = startNs + rng() % (spanNs + 1);
+        uint32_t deltas = 0;
+        uint64_t begin = ui::MonotonicNowNs();
+        reader.Seek(t, &deltas);
+        randomUs.push_back(static_cast<double>(ui::MonotonicNowNs() - begin) * 1e-3);
+        maxDeltas = std::max(maxDeltas, deltas);
+    }
+
+    // A drag across the bar: one seek plus the AppState rebuild per frame
+    ui::AppState state = ui::CreateDefaultState();
+    std::vector<double> dragUs;
+    const int steps = 600;
+    for (int pass = 0; pass < 2; pass++) {
+        for (int i = 0; i <= steps; i++) {
+            int step = pass == 0 ? i : steps - i;
+            uint64_t t = startNs + spanNs / steps * static_cast<uint64_t>(step);
+            uint64_t begin = ui::MonotonicNowNs();
+            const ui::WireVehicleState* wire = reader.Seek(t);
+            if (wire) ui::ApplyWireToState(*wire, state);
+            dragUs.push_back(static_cast<double>(ui::MonotonicNowNs() - begin) * 1e-3);
+        }
+    }
+
+    double randomP99 = Percentile(randomUs, 99);
+    double dragP99 = Percentile(dragUs, 99);
+    printf("random seek    p50 %.1f / p99 %.1f / max %.1f us, at most %u deltas applied\n",
+           Percentile(randomUs, 50), randomP99, randomUs.back(), maxDeltas);
+    printf("drag           %d steps there and back: p50 %.1f / p99 %.1f / max %.1f us per frame\n", steps,
+           Percentile(dragUs, 50), dragP99, dragUs.back());
+    // p99 against the budget; the max (scheduler noise included) within one 60 Hz frame
+    return randomP99 <= options.maxSeekUs && dragP99 <= options.maxSeekUs &&
+           std::max(randomUs.back(), dragUs.back()) <= kFrameUs;
+}
+
+bool CheckPlayback(ui::SessionReader& reader, const Options& options) {
+    uint64_t frameNs = 1000000000ull / options.hz;
+    uint64_t t = reader.GetStartNs() + (reader.GetEndNs() - reader.GetStartNs()) / 3;
+    reader.Seek(t);
+
+    uint32_t maxDeltas = 0;
+    uint64_t total = 0;
+    for (int i = 0; i < options.hz * 60; i++) {
+        uint32_t deltas = 0;
+        reader.Seek(t += frameNs, &deltas);
+        maxDeltas = std::max(maxDeltas, deltas);
+        total += deltas;
+    }
+    printf("playback       60 s forward: %llu deltas applied, at most %u per frame\n",
+           static_cast<unsigned long long>(total), maxDeltas);
+    return maxDeltas <= 1;
+}
+
+bool CheckLive(const char* path) {
+    ui::SessionWriter writer;
+    ui::SessionReader reader;
+    ui::AppState state = ui::CreateDefaultState();
+    if (!writer.Open(path)) return false;
+    writer.Record(state, kStartNs);
+    writer.Flush();
+    bool ok = reader.Open(path) && reader.GetRecordCount() == 1;
+
+    state.speed = 42;
+    writer.Record(state, kStartNs + 1000);
+    writer.Flush();
+    ok &= reader.Refresh() && reader.GetRecordCount() == 2 && reader.GetEndNs() == kStartNs + 1000;
+    const ui::WireVehicleState* wire = reader.Seek(kStartNs + 1000);
+    ok &= wire && wire->speed == 42;
+
+    printf("live           records flushed after Open() seen on Refresh(): %s\n", ok ? "yes" : "NO");
+    return ok;
+}
+
+bool CheckTornTail(const char* path, uint64_t records, uint64_t bytes) {
+    // Cut into the last record
+    bool ok = truncate(path, static_cast<off_t>(bytes - 5)) == 0;
+    ui::SessionReader reader;
+    ok &= reader.Open(path) && reader.GetRecordCount() == records - 1;
+    ok &= reader.Seek(reader.GetEndNs()) != nullptr;
+    printf("torn tail      last record cut: %llu of %llu records indexed\n",
+           static_cast<unsigned long long>(reader.GetRecordCount()), static_cast<unsigned long long>(records));
+    return ok;
+}
+
+void PrintUsage() {
+    printf("usage: session_store_bench [--hours H] [--hz N] [--max-seek-us US] [--path FILE] [--keep]\n");
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+
+        if (strcmp(arg, "--keep") == 0) {
+            options.keep = true;
+        } else if (value && strcmp(arg, "--hours") == 0) {
+            options.hours = atof(value); i++;
+        } else if (value && strcmp(arg, "--hz") == 0) {
+            options.hz = atoi(value); i++;
+        } else if (value && strcmp(arg, "--max-seek-us") == 0) {
+            options.maxSeekUs = atof(value); i++;
+        } else if (value && strcmp(arg, "--path") == 0) {
+            options.path = value; i++;
+        } else {
+            PrintUsage();
+            return 1;
+        }
+    }
+
+    if (options.hours <= 0.0 || options.hz <= 0 || options.hz > 1000) {
+        PrintUsage();
+        return 1;
+    }
+
+    // Record
+    ui::SessionWriter writer;
+    if (!writer.Open(options.path)) {
+        printf("cannot create %s\n", options.path);
+        return 1;
+    }
+    Drive drive;
+    std::vector<Sample> samples;
+    uint64_t frames = static_cast<uint64_t>(options.hours * 3600.0 * options.hz);
+    uint64_t frameNs = 1000000000ull / options.hz;
+    uint64_t begin = ui::MonotonicNowNs();
+    bool ok = true;
+    for (uint64_t frame = 0; frame < frames; frame++) {
+        drive.Step(frame, options.hz);
+        uint64_t t = kStartNs + frame * frameNs;
+        ok &= writer.Record(drive.state, t);
+        if (frame % kSampleEvery == 0 || frame + 1 == frames) {
+            samples.push_back({ t, ui::WireVehicleState() });
+            ui::EncodeWire(drive.state, samples.back().wire);
+        }
+    }
+    writer.Close();
+    double recordMs = static_cast<double>(ui::MonotonicNowNs() - begin) * 1e-6;
+
+    uint64_t records = writer.GetKeyframeCount() + writer.GetDeltaCount();
+    uint64_t bytes = writer.GetBytesWritten();
+    printf("recorded       %.1f h at %d Hz: %llu frames in %.0f ms\n", options.hours, options.hz,
+           static_cast<unsigned long long>(frames), recordMs);
+    printf("file           %.1f MB, %.1f bytes/frame (%llu keyframes, %llu deltas; raw %zu bytes/frame)\n",
+           static_cast<double>(bytes) / (1024.0 * 1024.0), static_cast<double>(bytes) / frames,
+           static_cast<unsigned long long>(writer.GetKeyframeCount()),
+           static_cast<unsigned long long>(writer.GetDeltaCount()), sizeof(ui::WireVehicleState));
+
+    // Reopen and index
+    ui::SessionReader reader;
+    begin = ui::MonotonicNowNs();
+    if (!reader.Open(options.path)) {
+        printf("cannot open %s\n", options.path);
+        return 1;
+    }
+    double openMs = static_cast<double>(ui::MonotonicNowNs() - begin) * 1e-6;
+    printf("open+index     %.1f ms, %llu records, %zu keyframes, %zu fault markers\n", openMs,
+           static_cast<unsigned long long>(reader.GetRecordCount()), reader.GetKeyframes().size(),
+           reader.GetFaultTimes().size());
+    ok &= reader.GetRecordCount() == records;
+
+    ok &= CheckSamples(reader, samples);
+    ok &= TimeSeeks(reader, options);
+    ok &= CheckPlayback(reader, options);
+    reader.Close();
+
+    ok &= CheckTornTail(options.path, records, bytes);
+
+    std::string livePath = std::string(options.path) + ".live";
+    ok &= CheckLive(livePath.c_str());
+    unlink(livePath.c_str());
+
+    printf("%s\n", ok ? "OK" : "FAILED");
+    if (!options.keep) unlink(options.path);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,290 @@
+/**
+ * Signal bus end-to-end benchmark
+ *
+ * Four producer threads (can, camera, sim, rules) publish --rate signal
+ * updates per second in total through a SignalBus (signal_bus.h) to three
+ * consumer threads:
+ *   ui        every signal at full rate, applied to an AppState
+ *   recorder  every signal at full rate
+ *   bridge    every signal rate-limited to --bridge-hz
+ *
+ * Reports the achieved rate, publish cost, drops, and publish -> poll latency
+ * per consumer (for the bridge it includes the time a value was held back).
+ * Checks that nothing was dropped, that the full-rate consumers received
+ * every update in per-producer order with p99.9 latency under
+ * --max-latency-us, and that no bridge signal exceeded its rate limit.
+ *
+ * Usage:
+ *   signal_bus_bench [--rate N] [--seconds S] [--signals N] [--bridge-hz HZ] [--max-latency-us US]
+ *
+ * Build (Linux):
+ *   g++ -O2 -std=c++17 -pthread -I.. signal_bus_bench.cpp ../signal_bus.cpp ../signal_interp.cpp ../signal_freshness.cpp \
+ *       ../fault_aggregator.cpp ../fault_history.cpp ../fault_journal.cpp ../cell_telemetry.cpp
+ */
+
+#include "../signal_bus.h"
+#include "../log_histogram.h"
+#include "../monotonic_clock.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct Options {
+    double rate = 1000000.0;    // Updates per second, all producers together
+    double seconds = 2.0;
+    int signals = 256;          // Extra signals besides the dashboard's
+    float bridgeHz = 20.0f;
+    double maxLatencyUs = 1000.0;
+};
+
+struct ProducerSpec {
+    const char* name;
+    double share;               // Of --rate
+};
+
+constexpr ProducerSpec kProducers[] = {
+    { "can",    0.70 },
+    { "camera", 0.05 },
+    { "sim",    0.20 },
+    { "rules",  0.05 },
+};
+constexpr int kProducerCount = sizeof(kProducers) / sizeof(kProducers[0]);
+constexpr uint64_t kTickNs = 100000;    // Producers publish what is due every 100 us
+constexpr size_t kPollBatch = 256;
+
+struct ProducerRun {
+    ui::BusProducer* producer = nullptr;
+    std::vector<int> signals;           // Signal indices this producer publishes
+    double rate = 0.0;
+    uint64_t publishNs = 0;             // Time spent inside Publish()
+    uint64_t published = 0;
+};
+
+struct ConsumerRun {
+    ui::BusConsumer* consumer = nullptr;
+    bool applyToState = false;
+    ui::LogHistogram latency;
+    std::vector<uint64_t> lastTimeNs;   // Per producer
+    std::vector<uint64_t> perSignal;
+    bool ordered = true;
+};
+
+std::vector<std::string> g_names;       // Signal names must outlive the bus
+
+void Publish(ui::BusProducer& producer, ui::SignalType type, int signal, uint64_t counter, uint64_t timeNs) {
+    switch (type) {
+        case ui::SignalType::Bool:
+            producer.Publish(ui::SignalId<bool>{ static_cast<uint16_t>(signal) }, (counter & 1) != 0, timeNs);
+            break;
+        case ui::SignalType::Int:
+            producer.Publish(ui::SignalId<int32_t>{ static_cast<uint16_t>(signal) },
+                             static_cast<int32_t>(counter % 4), timeNs);
+            break;
+        case ui::SignalType::Float:
+            producer.Publish(ui::SignalId<float>{ static_cast<uint16_t>(signal) },
+                             static_cast<float>(counter % 1000) * 0.1f, timeNs);
+            break;
+    }
+}
+
+void RunProducer(const ui::SignalBus& bus, ProducerRun& run, uint64_t startNs, uint64_t endNs) {
+    uint64_t counter = 0;
+    size_t next = 0;
+    for (uint64_t now = startNs; now < endNs; now = ui::MonotonicNowNs()) {
+        uint64_t due = static_cast<uint64_t>(run.rate * static_cast<double>(now - startNs) * 1e-9);
+        uint64_t burstStart = ui::MonotonicNowNs();
+        while (run.published < due) {
+            int signal = run.signals[next];
+            next = next + 1 == run.signals.size() ? 0 : next + 1;
+            Publish(*run.producer, bus.GetSignalType(signal), signal, counter++, ui::MonotonicNowNs());
+            run.published++;
+        }
+        run.producer->Flush(ui::MonotonicNowNs());
+        run.publishNs += ui::MonotonicNowNs() - burstStart;
+        std::this_thread::sleep_for(std::chrono::nanoseconds(kTickNs));
+    }
+}
+
+void RunConsumer(ui::AppState& state, const ui::DashboardBusSignals& signals, ConsumerRun& run,
+                 const std::atomic<bool>& producersDone) {
+    ui::SignalUpdate batch[kPollBatch];
+    for (;;) {
+        // Read the flag first: an empty poll after it is set means done
+        bool done = producersDone.load(std::memory_order_acquire);
+        size_t count = run.consumer->Poll(batch, kPollBatch);
+        if (count == 0) {
+            if (done) break;
+            std::this_thread::yield();
+            continue;
+        }
+        uint64_t now = ui::MonotonicNowNs();
+        for (size_t i = 0; i < count; i++) {
+            const ui::SignalUpdate& update = batch[i];
+            run.latency.Record(now - update.timeNs);
+            if (update.timeNs < run.lastTimeNs[update.producer]) run.ordered = false;
+            run.lastTimeNs[update.producer] = update.timeNs;
+            run.perSignal[update.signal]++;
+            if (run.applyToState) ui::ApplyBusUpdate(state, signals, update);
+        }
+    }
+}
+
+void PrintUsage() {
+    printf("usage: signal_bus_bench [--rate N] [--seconds S] [--signals N] [--bridge-hz HZ] [--max-latency-us US]\n");
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+
+        if (value && strcmp(arg, "--rate") == 0) {
+            options.rate = atof(value); i++;
+        } else if (value && strcmp(arg, "--seconds") == 0) {
+            options.seconds = atof(value); i++;
+        } else if (value && strcmp(arg, "--signals") == 0) {
+            options.signals = atoi(value); i++;
+        } else if (value && strcmp(arg, "--bridge-hz") == 0) {
+            options.bridgeHz = static_cast<float>(atof(value)); i++;
+        } else if (value && strcmp(arg, "--max-latency-us") == 0) {
+            options.maxLatencyUs = atof(value); i++;
+        } else {
+            PrintUsage();
+            return 1;
+        }
+    }
+
+    if (options.rate <= 0.0 || options.seconds <= 0.0 || options.signals < 0 || options.bridgeHz <= 0.0f ||
+        options.signals + 15 > ui::SignalBus::kMaxSignals) {
+        PrintUsage();
+        return 1;
+    }
+
+    // Dashboard signals come from "can"; the extra ones rotate through the
+    // three types and are spread over all producers
+    ui::SignalBus bus;
+    ui::DashboardBusSignals dashboard = ui::RegisterDashboardBusSignals(bus);
+    int dashboardCount = bus.GetSignalCount();
+    g_names.reserve(static_cast<size_t>(options.signals));
+    for (int i = 0; i < options.signals; i++) {
+        g_names.push_back("bench." + std::to_string(i));
+        const char* name = g_names.back().c_str();
+        switch (i % 3) {
+            case 0: bus.Register<float>(name); break;
+            case 1: bus.Register<int32_t>(name); break;
+            case 2: bus.Register<bool>(name); break;
+        }
+    }
+
+    ProducerRun producers[kProducerCount];
+    for (int p = 0; p < kProducerCount; p++) {
+        producers[p].producer = bus.AddProducer(kProducers[p].name);
+        producers[p].rate = options.rate * kProducers[p].share;
+    }
+    for (int s = 0; s < dashboardCount; s++) producers[0].signals.push_back(s);
+    for (int s = dashboardCount; s < bus.GetSignalCount(); s++) {
+        producers[s % kProducerCount].signals.push_back(s);
+    }
+    for (ProducerRun& run : producers) {
+        if (run.signals.empty()) run.signals.push_back(0);
+    }
+
+    // Rings hold 50 ms of the full rate, so a consumer descheduled for a
+    // timeslice does not drop anything
+    size_t ringCapacity = std::max<size_t>(4096, static_cast<size_t>(options.rate * 0.05));
+    const char* consumerNames[] = { "ui", "recorder", "bridge" };
+    std::unique_ptr<ConsumerRun> consumers[3];
+    for (int c = 0; c < 3; c++) {
+        consumers[c].reset(new ConsumerRun());
+        consumers[c]->consumer = bus.AddConsumer(consumerNames[c], ringCapacity);
+        consumers[c]->lastTimeNs.assign(kProducerCount, 0);
+        consumers[c]->perSignal.assign(static_cast<size_t>(bus.GetSignalCount()), 0);
+    }
+    consumers[0]->applyToState = true;
+    bus.SubscribeAll(consumers[0]->consumer);
+    bus.SubscribeAll(consumers[1]->consumer);
+    bus.SubscribeAll(consumers[2]->consumer, options.bridgeHz);
+    bus.Start();
+
+    ui::AppState state = ui::CreateDefaultState();
+    std::atomic<bool> producersDone{false};
+    std::vector<std::thread> consumerThreads;
+    for (int c = 0; c < 3; c++) {
+        consumerThreads.emplace_back(RunConsumer, std::ref(state), std::cref(dashboard), std::ref(*consumers[c]),
+                                     std::cref(producersDone));
+    }
+
+    uint64_t startNs = ui::MonotonicNowNs();
+    uint64_t endNs = startNs + static_cast<uint64_t>(options.seconds * 1e9);
+    std::vector<std::thread> producerThreads;
+    for (ProducerRun& run : producers) {
+        producerThreads.emplace_back(RunProducer, std::cref(bus), std::ref(run), startNs, endNs);
+    }
+    for (std::thread& thread : producerThreads) thread.join();
+    double elapsed = static_cast<double>(ui::MonotonicNowNs() - startNs) * 1e-9;
+    producersDone.store(true, std::memory_order_release);
+    for (std::thread& thread : consumerThreads) thread.join();
+
+    uint64_t published = 0;
+    uint64_t publishNs = 0;
+    uint64_t dropped = 0;
+    uint64_t decimated = 0;
+    for (const ProducerRun& run : producers) {
+        ui::BusProducerStats stats = run.producer->GetStats();
+        published += stats.published;
+        dropped += stats.dropped;
+        decimated += stats.decimated;
+        publishNs += run.publishNs;
+    }
+
+    printf("signals        %d (%d dashboard), %d producers, 3 consumers, rings of %zu\n", bus.GetSignalCount(),
+           dashboardCount, kProducerCount, ringCapacity);
+    printf("published      %llu in %.2f s = %.0f updates/s (target %.0f)\n",
+           static_cast<unsigned long long>(published), elapsed, published / elapsed, options.rate);
+    printf("publish cost   %.1f ns/update (3 subscribers, incl. timestamp)\n",
+           published ? static_cast<double>(publishNs) / static_cast<double>(published) : 0.0);
+    printf("dropped        %llu, decimated %llu\n", static_cast<unsigned long long>(dropped),
+           static_cast<unsigned long long>(decimated));
+    printf("%-14s %10s %10s %10s %10s %10s\n", "latency (us)", "received", "p50", "p99", "p99.9", "max");
+
+    bool ok = dropped == 0 && published / elapsed >= options.rate * 0.95;
+    for (int c = 0; c < 3; c++) {
+        ConsumerRun& run = *consumers[c];
+        printf("  %-12s %10llu %10.1f %10.1f %10.1f %10.1f%s\n", consumerNames[c],
+               static_cast<unsigned long long>(run.consumer->GetReceived()), run.latency.Percentile(50) * 1e-3,
+               run.latency.Percentile(99) * 1e-3, run.latency.Percentile(99.9) * 1e-3, run.latency.Max() * 1e-3,
+               run.ordered || c == 2 ? "" : "  OUT OF ORDER");
+        if (c == 2) continue;   // Held values keep their timestamps
+        ok &= run.ordered;
+        ok &= run.latency.Percentile(99.9) * 1e-3 <= options.maxLatencyUs;
+        ok &= run.consumer->GetReceived() == published;
+    }
+
+    // Bridge: no signal above its rate limit over the run
+    uint64_t limit = static_cast<uint64_t>(std::ceil(elapsed * options.bridgeHz)) + 1;
+    uint64_t busiest = 0;
+    for (uint64_t count : consumers[2]->perSignal) busiest = std::max(busiest, count);
+    printf("bridge         busiest signal %llu updates (limit %llu at %.0f Hz)\n",
+           static_cast<unsigned long long>(busiest), static_cast<unsigned long long>(limit), options.bridgeHz);
+    ok &= busiest <= limit && busiest > 0;
+
+    printf("ui state       speed %d, gear %s, main soc %.1f\n", state.speed, ui::GearToString(state.gear),
+           state.mainBattery.soc);
+
+    printf("%s\n", ok ? "OK" : "FAILED");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,267 @@
+/**
+ * Gauge smoothing accuracy, smoothness and cost
+ *
+ * Simulates a speed trace sampled by the sender at --sample-hz, delivered
+ * with a fixed latency plus up to --jitter-ms of random delay, and drawn at
+ * 60 Hz. Sender timestamps go through a SourceClock (the sender's clock is
+ * offset from ours). Compares what the gauge shows:
+ *   raw      latest value received (what the dashboard drew before)
+ *   step     SignalInterpolator, InterpMode::Step
+ *   linear   InterpMode::Linear
+ *   spring   InterpMode::Spring
+ * by error against the true trace at the presentation time (frame time
+ * minus --delay-ms; raw has no delay) and by frame-to-frame jerk (RMS second
+ * difference, what reads as stepping). Then checks a 0.5 s dropout is
+ * extrapolated for the configured horizon and held after, that nothing
+ * allocates, and times Evaluate() over all 64 signals against --budget-us.
+ *
+ * Usage:
+ *   signal_interp_bench [--sample-hz HZ] [--jitter-ms MS] [--delay-ms MS] [--seconds S] [--budget-us US]
+ *
+ * Build (Linux):
+ *   g++ -O2 -std=c++17 -I.. signal_interp_bench.cpp ../signal_interp.cpp
+ */
+
+#include "../signal_interp.h"
+#include "../monotonic_clock.h"
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <random>
+#include <vector>
+
+namespace {
+
+struct Options {
+    double sampleHz = 20.0;
+    double jitterMs = 15.0;
+    double delayMs = 100.0;
+    double seconds = 20.0;
+    double budgetUs = 10.0;
+};
+
+constexpr double kFrameHz = 60.0;
+constexpr double kLatencyMs = 5.0;
+constexpr uint64_t kSenderEpochNs = 123456789000ull;  // Sender clock = ours + this
+constexpr uint64_t kStartNs = 1000000000ull;
+constexpr int kTimedFrames = 20000;
+
+size_t g_allocations = 0;
+volatile float g_sink;
+
+// Speed in km/h: cruising oscillation plus an acceleration and a braking ramp
+double Truth(double t) {
+    double v = 60.0 + 25.0 * std::sin(2.0 * M_PI * t / 6.0) + 8.0 * std::sin(2.0 * M_PI * t / 1.7);
+    double cycle = std::fmod(t, 10.0);
+    if (cycle > 2.0 && cycle < 4.0) v += 20.0 * (cycle - 2.0);
+    else if (cycle >= 4.0 && cycle < 6.0) v += 40.0 - 20.0 * (cycle - 4.0);
+    return v;
+}
+
+uint64_t ToNs(double seconds) { return static_cast<uint64_t>(seconds * 1e9); }
+
+struct Method {
+    const char* name;
+    int signal;          // -1 = raw
+    double delaySeconds;
+    double errorSq = 0.0;
+    double errorMax = 0.0;
+    double jerkSq = 0.0;
+    int frames = 0;
+    float history[2] = {};
+};
+
+struct Arrival {
+    uint64_t arrivalNs;
+    uint64_t sourceNs;
+    float value;
+};
+
+void PrintUsage() {
+    printf("usage: signal_interp_bench [--sample-hz HZ] [--jitter-ms MS] [--delay-ms MS] [--seconds S] "
+           "[--budget-us US]\n");
+}
+
+} // namespace
+
+void* operator new(size_t size) {
+    g_allocations++;
+    if (void* p = malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+
+int main(int argc, char** argv) {
+    Options options;
+
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+
+        if (value && strcmp(arg, "--sample-hz") == 0) {
+            options.sampleHz = atof(value); i++;
+        } else if (value && strcmp(arg, "--jitter-ms") == 0) {
+            options.jitterMs = atof(value); i++;
+        } else if (value && strcmp(arg, "--delay-ms") == 0) {
+            options.delayMs = atof(value); i++;
+        } else if (value && strcmp(arg, "--seconds") == 0) {
+            options.seconds = atof(value); i++;
+        } else if (value && strcmp(arg, "--budget-us") == 0) {
+            options.budgetUs = atof(value); i++;
+        } else {
+            PrintUsage();
+            return 1;
+        }
+    }
+
+    if (options.sampleHz < 1.0 || options.sampleHz > 1000.0 || options.jitterMs < 0.0 || options.delayMs < 0.0 ||
+        options.seconds < 2.0 || options.budgetUs <= 0.0) {
+        PrintUsage();
+        return 1;
+    }
+
+    // Sender samples and their (jittered) arrival; arrival order can differ
+    // from send order when jitter exceeds the sample interval
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<double> jitter(0.0, options.jitterMs);
+    int sampleCount = static_cast<int>(options.seconds * options.sampleHz);
+    std::vector<Arrival> arrivals(sampleCount);
+    for (int i = 0; i < sampleCount; i++) {
+        double t = i / options.sampleHz;
+        arrivals[i].sourceNs = kSenderEpochNs + kStartNs + ToNs(t);
+        arrivals[i].arrivalNs = kStartNs + ToNs(t + (kLatencyMs + jitter(rng)) * 1e-3);
+        arrivals[i].value = static_cast<float>(Truth(t));
+    }
+    for (int i = 1; i < sampleCount; i++) {
+        for (int j = i; j > 0 && arrivals[j].arrivalNs < arrivals[j - 1].arrivalNs; j--) {
+            Arrival swap = arrivals[j]; arrivals[j] = arrivals[j - 1]; arrivals[j - 1] = swap;
+        }
+    }
+
+    // Presentation delay is measured from the mapped sender time, which
+    // already includes the fastest-path latency
+    float delaySeconds = static_cast<float>(options.delayMs * 1e-3);
+    static ui::SignalInterpolator signals;
+    int stepSignal = signals.AddSignal({ ui::InterpMode::Step, delaySeconds, 0.1f, 4.0f });
+    int linearSignal = signals.AddSignal({ ui::InterpMode::Linear, delaySeconds, 0.1f, 4.0f });
+    int springSignal = signals.AddSignal({ ui::InterpMode::Spring, delaySeconds, 0.1f, 4.0f });
+    ui::SourceClock clock;
+
+    Method methods[4] = {
+        { "raw", -1, 0.0 },
+        { "step", stepSignal, delaySeconds },
+        { "linear", linearSignal, delaySeconds },
+        { "spring", springSignal, delaySeconds },
+    };
+
+    size_t allocationsBefore = g_allocations;
+    int next = 0;
+    int dropped = 0;
+    float raw = 0.0f;
+    int frameCount = static_cast<int>(options.seconds * kFrameHz);
+    for (int frame = 0; frame < frameCount; frame++) {
+        double frameSeconds = frame / kFrameHz;
+        uint64_t frameNs = kStartNs + ToNs(frameSeconds);
+        while (next < sampleCount && arrivals[next].arrivalNs <= frameNs) {
+            uint64_t timeNs = clock.Map(arrivals[next].sourceNs, arrivals[next].arrivalNs);
+            for (int m = 1; m < 4; m++) {
+                if (!signals.Push(methods[m].signal, timeNs, arrivals[next].value) && m == 1) dropped++;
+            }
+            raw = arrivals[next].value;
+            next++;
+        }
+        signals.Evaluate(frameNs);
+
+        // Skip the first second: buffers filling, clock offset settling
+        if (frameSeconds < 1.0) continue;
+        for (Method& method : methods) {
+            float shown = method.signal < 0 ? raw : signals.Get(method.signal);
+            double error = std::fabs(shown - Truth(frameSeconds - method.delaySeconds - kLatencyMs * 1e-3));
+            method.errorSq += error * error;
+            method.errorMax = std::max(method.errorMax, error);
+            if (method.frames >= 2) {
+                double jerk = shown - 2.0 * method.history[1] + method.history[0];
+                method.jerkSq += jerk * jerk;
+            }
+            method.history[0] = method.history[1];
+            method.history[1] = shown;
+            method.frames++;
+        }
+    }
+    size_t traceAllocations = g_allocations - allocationsBefore;
+
+    printf("trace          %.0f Hz samples, %.0f + 0-%.0f ms latency, %.0f Hz frames, %.0f ms delay, %.0f s\n",
+           options.sampleHz, kLatencyMs, options.jitterMs, kFrameHz, options.delayMs, options.seconds);
+    printf("  %-8s %10s %10s %12s\n", "method", "rms err", "max err", "rms jerk");
+    for (const Method& method : methods) {
+        printf("  %-8s %10.3f %10.3f %12.4f\n", method.name, std::sqrt(method.errorSq / method.frames),
+               method.errorMax, std::sqrt(method.jerkSq / std::max(1, method.frames - 2)));
+    }
+    printf("out of order   %d samples dropped\n", dropped);
+
+    // Dropout: a ramp at 10 units/s whose samples stop; the gauge continues
+    // the ramp for the horizon and then holds
+    static ui::SignalInterpolator gap;
+    int gapSignal = gap.AddSignal({ ui::InterpMode::Linear, 0.1f, 0.1f, 4.0f });
+    uint64_t sampleNs = ToNs(1.0 / options.sampleHz);
+    uint64_t lastSampleNs = 0;
+    for (uint64_t t = kStartNs; t <= kStartNs + ToNs(1.0); t += sampleNs) {
+        gap.Push(gapSignal, t, static_cast<float>((t - kStartNs) * 1e-8));
+        lastSampleNs = t;
+    }
+    float lastSample = gap.GetLatest(gapSignal);
+    gap.Evaluate(lastSampleNs + ToNs(0.1 + 0.05));
+    float extrapolated = gap.Get(gapSignal);
+    gap.Evaluate(lastSampleNs + ToNs(0.1 + 0.12));
+    float held = gap.Get(gapSignal);
+    bool movingAfter = gap.Evaluate(lastSampleNs + ToNs(0.6));
+    float heldLater = gap.Get(gapSignal);
+    printf("dropout        last %.3f, +50 ms %.3f, held %.3f -> %.3f, still moving %s\n", lastSample, extrapolated,
+           held, heldLater, movingAfter ? "yes" : "no");
+
+    // Cost: all 64 signals updating at the sample rate, evaluated per frame
+    static ui::SignalInterpolator full;
+    for (int i = 0; i < ui::SignalInterpolator::kMaxSignals; i++) {
+        full.AddSignal({ static_cast<ui::InterpMode>(i % 3), 0.1f, 0.1f, 4.0f });
+    }
+    allocationsBefore = g_allocations;
+    int framesPerSample = std::max(1, static_cast<int>(kFrameHz / options.sampleHz));
+    uint64_t evalNs = 0;
+    for (int frame = 0; frame < kTimedFrames; frame++) {
+        uint64_t frameNs = kStartNs + ToNs(frame / kFrameHz);
+        if (frame % framesPerSample == 0) {
+            for (int i = 0; i < ui::SignalInterpolator::kMaxSignals; i++) {
+                full.Push(i, frameNs, static_cast<float>(Truth(frame / kFrameHz + i)));
+            }
+        }
+        uint64_t begin = ui::MonotonicNowNs();
+        full.Evaluate(frameNs);
+        evalNs += ui::MonotonicNowNs() - begin;
+        g_sink = full.Get(frame % ui::SignalInterpolator::kMaxSignals);
+    }
+    size_t evalAllocations = g_allocations - allocationsBefore;
+    double evalUs = static_cast<double>(evalNs) / kTimedFrames * 1e-3;
+    printf("evaluate       %d signals, %.2f us/frame (budget %.1f us)\n", ui::SignalInterpolator::kMaxSignals,
+           evalUs, options.budgetUs);
+    printf("allocations    %zu in trace, %zu in timed frames\n", traceAllocations, evalAllocations);
+
+    double rawJerk = std::sqrt(methods[0].jerkSq / methods[0].frames);
+    double linearJerk = std::sqrt(methods[2].jerkSq / methods[2].frames);
+    double springJerk = std::sqrt(methods[3].jerkSq / methods[3].frames);
+    double rawError = std::sqrt(methods[0].errorSq / methods[0].frames);
+    double linearError = std::sqrt(methods[2].errorSq / methods[2].frames);
+
+    bool ok = true;
+    ok &= linearJerk < rawJerk * 0.25 && springJerk < rawJerk * 0.25;
+    ok &= options.jitterMs + kLatencyMs >= options.delayMs || linearError < rawError * 0.5;
+    ok &= extrapolated > lastSample && std::fabs(extrapolated - (lastSample + 0.5f)) < 0.05f;
+    ok &= std::fabs(held - (lastSample + 1.0f)) < 0.05f && !movingAfter && held == heldLater;
+    ok &= traceAllocations == 0 && evalAllocations == 0;
+    ok &= evalUs < options.budgetUs;
+    printf("%s\n", ok ? "OK" : "FAILED");
+    return ok ? 0 : 1;
+}
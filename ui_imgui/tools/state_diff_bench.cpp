@@ -0,0 +1,264 @@
+/**
+ * Field diff correctness check and timing
+ *
+ * Checks DiffWire() and ApplyWirePatch() (state_diff.h):
+ *   - changing one member of a snapshot reports exactly that member's bit,
+ *     and patching that bit onto the original reproduces the changed copy;
+ *   - along a simulated drive (with faults coming and going), patching the
+ *     reported fields onto a baseline keeps it byte-identical to the latest
+ *     state, every reported bit is a real change, and with the schema
+ *     deadbands the baseline never strays further than a deadband.
+ * Then times DiffWire() over consecutive states, with and without
+ * deadbands, and for a full fault list that did not change (worst case).
+ * Each timing is the best of several passes; the run fails if any of them
+ * is over the 100 ns budget (build with -O2 or better).
+ *
+ * Usage:
+ *   state_diff_bench [--states N] [--repeat N]
+ *
+ * Build (Linux):
+ *   g++ -O2 -std=c++17 -I.. state_diff_bench.cpp ../vehicle_sim.cpp ../cell_telemetry.cpp \
+ *       ../fault_aggregator.cpp ../fault_history.cpp ../fault_journal.cpp
+ */
+
+#include "../state_diff.h"
+#include "../vehicle_sim.h"
+#include "../monotonic_clock.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct Options {
+    int states = 50000;
+    int repeat = 20;
+};
+
+constexpr double kBudgetNs = 100.0;
+constexpr int kPasses = 5;
+
+volatile uint32_t g_sink;   // Keeps the timing loops from being optimized out
+
+static_assert(ui::kWireFieldCount == 16, "add the new member to Mutate()");
+
+// Change the member behind one WireField bit
+void Mutate(ui::WireVehicleState& w, int bit) {
+    switch (bit) {
+        case 0:  w.speed += 1; break;
+        case 1:  w.gear = static_cast<uint8_t>((w.gear + 1) % 4); break;
+        case 2:  w.mainBatterySoc += 0.5f; break;
+        case 3:  w.mainBatteryVoltage += 0.5f; break;
+        case 4:  w.mainBatteryCurrent += 0.5f; break;
+        case 5:  w.suppBatterySoc += 0.5f; break;
+        case 6:  w.suppBatteryVoltage += 0.5f; break;
+        case 7:  w.cruiseEnabled ^= 1; break;
+        case 8:  w.cruiseSetSpeed += 5; break;
+        case 9:  w.brakeEngaged ^= 1; break;
+        case 10: w.contactorStatesMain ^= 1; break;
+        case 11: w.contactorStatesPrecharge ^= 1; break;
+        case 12: w.contactorStatesHvil ^= 1; break;
+        case 13: w.heartbeat++; break;
+        case 14: w.faults[w.faultsCount ? w.faultsCount - 1 : 0].message[3] ^= 1; break;
+        case 15: w.turnSignal = static_cast<uint8_t>((w.turnSignal + 1) % 3); break;
+    }
+}
+
+// Within the deadband for deadband members, identical otherwise
+bool WithinDeadbands(const ui::WireVehicleState& baseline, const ui::WireVehicleState& next,
+                     const ui::WireDeadbands& d) {
+    ui::WireVehicleState exact = baseline;
+    uint32_t drift = ui::DiffWire(baseline, next) & ui::kWireDeadbandFields;
+    ui::ApplyWirePatch(exact, next, drift);
+    if (memcmp(&exact, &next, sizeof(next)) != 0) return false;
+    return std::fabs(static_cast<float>(baseline.speed - next.speed)) <= d.speed &&
+           std::fabs(baseline.mainBatterySoc - next.mainBatterySoc) <= d.mainBatterySoc &&
+           std::fabs(baseline.mainBatteryVoltage - next.mainBatteryVoltage) <= d.mainBatteryVoltage &&
+           std::fabs(baseline.mainBatteryCurrent - next.mainBatteryCurrent) <= d.mainBatteryCurrent &&
+           std::fabs(baseline.suppBatterySoc - next.suppBatterySoc) <= d.suppBatterySoc &&
+           std::fabs(baseline.suppBatteryVoltage - next.suppBatteryVoltage) <= d.suppBatteryVoltage &&
+           std::fabs(static_cast<float>(baseline.cruiseSetSpeed - next.cruiseSetSpeed)) <= d.cruiseSetSpeed;
+}
+
+// Every reported bit must change the baseline when patched on its own
+bool BitsAreReal(const ui::WireVehicleState& baseline, const ui::WireVehicleState& next, uint32_t changed) {
+    for (int bit = 0; bit < ui::kWireFieldCount; bit++) {
+        if (!(changed & (1u << bit))) continue;
+        ui::WireVehicleState patched = baseline;
+        ui::ApplyWirePatch(patched, next, 1u << bit);
+        if (memcmp(&patched, &baseline, sizeof(baseline)) == 0) return false;
+    }
+    return true;
+}
+
+void Step(ui::AppState& state, ui::sim::FleetSimulator& simulator, int index) {
+    simulator.SetControls(0, ui::sim::ControlsFromState(state));
+    simulator.Advance(0.1);
+    simulator.ReadVehicle(0, state);
+    for (const ui::sim::SimEvent& event : simulator.GetEvents()) {
+        if (event.raised) {
+            state.faults.Report(ui::sim::MakeFault(event));
+        } else {
+            state.faults.Resolve(ui::sim::SimFaultCode(event.fault));
+        }
+    }
+    simulator.ClearEvents();
+    state.turnSignal = static_cast<ui::TurnSignal>(index / 40 % 3);
+
+    // A synthetic fault every few seconds so the list changes now and then
+    if (index % 50 == 0) {
+        std::string code = "SYN_" + std::to_string(index / 50 % 12);
+        if (index / 600 % 2 == 0) {
+            state.faults.Report({ code, "Synthetic fault " + code, ui::FaultSeverity::Warning,
+                                  1700000000000 + index * 100 });
+        } else {
+            state.faults.Resolve(code);
+            state.faults.Acknowledge(code);
+        }
+    }
+}
+
+// Average ns per DiffWire() over consecutive pairs, best of kPasses passes
+// (the machine may be shared). Pairs are timed in cache-resident windows,
+// as a consumer diffs the two newest snapshots.
+double TimeDiffs(const std::vector<ui::WireVehicleState>& states, int repeat, const ui::WireDeadbands* deadbands) {
+    const size_t window = 32;
+    double best = 0.0;
+    for (int pass = 0; pass < kPasses; pass++) {
+        uint32_t sink = 0;
+        uint64_t diffs = 0;
+        uint64_t start = ui::MonotonicNowNs();
+        for (size_t first = 1; first + window <= states.size(); first += window) {
+            for (int r = 0; r < repeat; r++) {
+                for (size_t i = first; i < first + window; i++) sink += ui::DiffWire(states[i - 1], states[i], deadbands);
+            }
+            diffs += window * repeat;
+        }
+        uint64_t elapsed = ui::MonotonicNowNs() - start;
+        g_sink = sink;
+        double ns = diffs ? static_cast<double>(elapsed) / diffs : 0.0;
+        if (pass == 0 || ns < best) best = ns;
+    }
+    return best;
+}
+
+void PrintUsage() {
+    printf("usage: state_diff_bench [--states N] [--repeat N]\n");
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+
+        if (value && strcmp(arg, "--states") == 0) {
+            options.states = atoi(value); i++;
+        } else if (value && strcmp(arg, "--repeat") == 0) {
+            options.repeat = atoi(value); i++;
+        } else {
+            PrintUsage();
+            return 1;
+        }
+    }
+
+    if (options.states < 2 || options.repeat <= 0) {
+        PrintUsage();
+        return 1;
+    }
+
+    ui::sim::SimConfig simConfig;
+    simConfig.randomizeCycleStart = false;
+    simConfig.scenarioProbability = 1.0f;
+    simConfig.scenarioWindowSeconds = options.states * 0.05f;
+    simConfig.startTimeMs = 1700000000000;
+    ui::sim::FleetSimulator simulator(simConfig);
+    ui::AppState state = ui::CreateDefaultState();
+    state.contactorStates = { true, false, true };
+    state.gear = ui::Gear::Drive;
+    state.brakeEngaged = false;
+    simulator.InitVehicle(0, state);
+
+    std::vector<ui::WireVehicleState> states(static_cast<size_t>(options.states));
+    for (int i = 0; i < options.states; i++) {
+        Step(state, simulator, i);
+        ui::EncodeWire(state, states[i]);
+    }
+
+    // Single-member changes
+    int singleOk = 0;
+    const ui::WireVehicleState& sample = states[states.size() / 2];
+    for (int bit = 0; bit < ui::kWireFieldCount; bit++) {
+        ui::WireVehicleState changed = sample;
+        Mutate(changed, bit);
+        ui::WireVehicleState patched = sample;
+        ui::ApplyWirePatch(patched, changed, ui::DiffWire(sample, changed));
+        if (ui::DiffWire(sample, changed) == (1u << bit) && ui::DiffWire(changed, changed) == 0 &&
+            memcmp(&patched, &changed, sizeof(changed)) == 0) {
+            singleOk++;
+        } else {
+            printf("field          %s: mask 0x%04x\n", ui::kWireFieldNames[bit], ui::DiffWire(sample, changed));
+        }
+    }
+
+    // Drive: exact and deadbanded baselines
+    ui::WireDeadbands deadbands = ui::SchemaDeadbands();
+    ui::WireVehicleState exact = states[0], banded = states[0];
+    int exactOk = 0, bandedOk = 0;
+    uint64_t exactFields = 0, bandedFields = 0, exactFrames = 0, bandedFrames = 0;
+    for (size_t i = 1; i < states.size(); i++) {
+        uint32_t changed = ui::DiffWire(exact, states[i]);
+        exactOk += BitsAreReal(exact, states[i], changed) ? 1 : 0;
+        ui::ApplyWirePatch(exact, states[i], changed);
+        exactOk += memcmp(&exact, &states[i], sizeof(exact)) == 0 ? 0 : -1;
+        exactFields += __builtin_popcount(changed);
+        exactFrames += changed ? 1 : 0;
+
+        changed = ui::DiffWire(banded, states[i], &deadbands);
+        ui::ApplyWirePatch(banded, states[i], changed);
+        bandedOk += WithinDeadbands(banded, states[i], deadbands) ? 1 : 0;
+        bandedFields += __builtin_popcount(changed);
+        bandedFrames += changed ? 1 : 0;
+    }
+    int pairs = options.states - 1;
+
+    // Worst case: every fault slot used and unchanged, so all of them are compared
+    ui::AppState full = state;
+    for (int i = 0; i < 16; i++) {
+        full.faults.Report({ "FULL_" + std::to_string(i), "Fault list at capacity", ui::FaultSeverity::Info, i });
+    }
+    std::vector<ui::WireVehicleState> fullStates(states.size());
+    for (size_t i = 0; i < states.size(); i++) {
+        fullStates[i] = states[i];
+        ui::WireVehicleState faults;
+        ui::EncodeWire(full, faults);
+        ui::ApplyWirePatch(fullStates[i], faults, ui::WireField_Faults);
+    }
+
+    double exactNs = TimeDiffs(states, options.repeat, nullptr);
+    double bandedNs = TimeDiffs(states, options.repeat, &deadbands);
+    double fullNs = TimeDiffs(fullStates, options.repeat, &deadbands);
+    double worst = std::max(exactNs, std::max(bandedNs, fullNs));
+
+    printf("states         %d (%zu bytes each, %d fields)\n", options.states, sizeof(ui::WireVehicleState),
+           ui::kWireFieldCount);
+    printf("single field   %d/%d exact masks and patches\n", singleOk, ui::kWireFieldCount);
+    printf("exact          %d/%d baselines match, %.2f fields/frame, %.0f%% frames changed\n",
+           exactOk, pairs, static_cast<double>(exactFields) / pairs, 100.0 * exactFrames / pairs);
+    printf("deadbands      %d/%d within deadband, %.2f fields/frame, %.0f%% frames changed\n",
+           bandedOk, pairs, static_cast<double>(bandedFields) / pairs, 100.0 * bandedFrames / pairs);
+    printf("diff           exact %.1f ns, deadbands %.1f ns, 16 unchanged faults %.1f ns (budget %.0f ns)\n",
+           exactNs, bandedNs, fullNs, kBudgetNs);
+    if (worst > kBudgetNs) printf("budget         over %.0f ns (optimized build?)\n", kBudgetNs);
+
+    bool ok = singleOk == ui::kWireFieldCount && exactOk == pairs && bandedOk == pairs && worst <= kBudgetNs;
+    printf("%s\n", ok ? "OK" : "FAILED");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,361 @@
+/**
+ * Browser bridge load test
+ *
+ * Publishes a simulated vehicle to a StateStreamServer from a paced "render"
+ * loop while many WebSocket viewers (raw sockets, one poll thread) decode
+ * the stream the way lib/vehicle-stream.ts does. Checks the handshake,
+ * ping/pong, sequence continuity of every delta, that each viewer ends on
+ * exactly the state that was published last, and the close handshake.
+ *
+ * Reports the cost of Publish() on the render thread (p50/p99/max), bytes
+ * per message and the delta/full split.
+ *
+ * Usage:
+ *   state_stream_loadtest [--clients N] [--seconds S] [--rate HZ] [--port P]
+ *
+ *   --rate 0 publishes as fast as possible.
+ *
+ * Build (Linux):
+ *   g++ -O2 -std=c++17 -pthread -I.. state_stream_loadtest.cpp ../state_stream.cpp ../websocket.cpp \
+ *       ../vehicle_sim.cpp ../cell_telemetry.cpp ../fault_aggregator.cpp ../fault_history.cpp \
+ *       ../fault_journal.cpp
+ */
+
+#include "../state_stream.h"
+#include "../websocket.h"
+#include "../vehicle_sim.h"
+#include "../log_histogram.h"
+#include "../monotonic_clock.h"
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+
+namespace {
+
+// RFC 6455 section 1.3 example key and its accept value
+const char kTestKey[] = "dGhlIHNhbXBsZSBub25jZQ==";
+const char kTestAccept[] = "s3pPLMBiTxaQ9kYGzzhZRbK+xOo=";
+
+struct Options {
+    int clients = 100;
+    double seconds = 10.0;
+    double rate = 60.0;
+    uint16_t port = 0;      // 0 = any free port
+};
+
+struct Viewer {
+    int fd = -1;
+    bool open = false;
+    bool failed = false;
+    std::atomic<bool> closed{false};        // Close frame echoed back
+    std::atomic<uint32_t> progress{0};      // Sequence decoded so far, 0 once failed
+    std::vector<uint8_t> input;
+    ui::stream::StateSnapshot state;
+    uint32_t sequence = 0;
+    bool synced = false;
+    uint64_t messages = 0;
+    uint64_t fullStates = 0;
+    uint64_t payloadBytes = 0;
+    uint64_t pongs = 0;
+};
+
+// Client frames must be masked
+bool SendFrame(const Viewer& viewer, ui::ws::Opcode opcode, const uint8_t* payload, size_t size) {
+    const uint8_t mask[4] = { 0x12, 0x34, 0x56, 0x78 };
+    uint8_t frame[2 + 4 + 125];
+    frame[0] = static_cast<uint8_t>(0x80 | opcode);
+    frame[1] = static_cast<uint8_t>(0x80 | size);
+    memcpy(frame + 2, mask, 4);
+    for (size_t i = 0; i < size; i++) frame[6 + i] = payload[i] ^ mask[i & 3];
+    return send(viewer.fd, frame, 6 + size, MSG_NOSIGNAL) == static_cast<ssize_t>(6 + size);
+}
+
+bool Connect(Viewer& viewer, uint16_t port) {
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    inet_pton(AF_INET, "127.0.0.1", &addr.sin_addr);
+
+    viewer.fd = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (viewer.fd < 0 || connect(viewer.fd, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)) != 0) {
+        return false;
+    }
+    char request[256];
+    int length = snprintf(request, sizeof(request),
+                          "GET /state HTTP/1.1\r\nHost: 127.0.0.1:%u\r\nUpgrade: websocket\r\n"
+                          "Connection: Upgrade\r\nSec-WebSocket-Key: %s\r\nSec-WebSocket-Version: 13\r\n\r\n",
+                          port, kTestKey);
+    return send(viewer.fd, request, static_cast<size_t>(length), MSG_NOSIGNAL) == length;
+}
+
+// Consume whatever complete frames (and the 101 response) have arrived
+void Process(Viewer& viewer) {
+    size_t offset = 0;
+    if (!viewer.open) {
+        std::string text(viewer.input.begin(), viewer.input.end());
+        size_t end = text.find("\r\n\r\n");
+        if (end == std::string::npos) return;
+        if (text.compare(0, 12, "HTTP/1.1 101") != 0 || text.find(kTestAccept) >= end) {
+            viewer.failed = true;
+            viewer.progress.store(0);
+            return;
+        }
+        viewer.open = true;
+        offset = end + 4;
+    }
+
+    while (viewer.input.size() - offset >= 2) {
+        const uint8_t* p = viewer.input.data() + offset;
+        size_t available = viewer.input.size() - offset;
+        uint64_t length = p[1] & 0x7F;
+        size_t header = 2;
+        if (length == 126) {
+            if (available < 4) break;
+            length = (uint64_t(p[2]) << 8) | p[3];
+            header = 4;
+        } else if (length == 127) {
+            viewer.failed = true;   // Never sent for state messages
+            viewer.progress.store(0);
+            return;
+        }
+        if (available < header + length) break;
+
+        const uint8_t* payload = p + header;
+        uint8_t opcode = p[0] & 0x0F;
+        if (opcode == ui::ws::Opcode_Binary) {
+            uint32_t sequence = 0;
+            bool full = false;
+            if (!ui::stream::ApplyState(payload, static_cast<size_t>(length), viewer.state, sequence, full) ||
+                (!full && (!viewer.synced || sequence != viewer.sequence + 1))) {
+                viewer.failed = true;
+                viewer.progress.store(0);
+                return;
+            }
+            viewer.synced = true;
+            viewer.sequence = sequence;
+            viewer.messages++;
+            viewer.fullStates += full ? 1 : 0;
+            viewer.payloadBytes += length;
+            viewer.progress.store(sequence);
+        } else if (opcode == ui::ws::Opcode_Pong) {
+            viewer.pongs++;
+        } else if (opcode == ui::ws::Opcode_Close) {
+            viewer.closed.store(true);
+        }
+        offset += header + static_cast<size_t>(length);
+    }
+    viewer.input.erase(viewer.input.begin(), viewer.input.begin() + static_cast<std::ptrdiff_t>(offset));
+}
+
+void ViewerMain(std::vector<Viewer>& viewers, std::atomic<bool>& stop) {
+    std::vector<pollfd> fds(viewers.size());
+    uint8_t buffer[16 * 1024];
+
+    while (!stop.load(std::memory_order_relaxed)) {
+        for (size_t i = 0; i < viewers.size(); i++) fds[i] = { viewers[i].fd, POLLIN, 0 };
+        if (poll(fds.data(), fds.size(), 5) <= 0) continue;
+
+        for (size_t i = 0; i < viewers.size(); i++) {
+            if (!(fds[i].revents & POLLIN) || viewers[i].failed) continue;
+            ssize_t n = recv(viewers[i].fd, buffer, sizeof(buffer), MSG_DONTWAIT);
+            if (n <= 0) continue;
+            viewers[i].input.insert(viewers[i].input.end(), buffer, buffer + n);
+            Process(viewers[i]);
+        }
+    }
+}
+
+void SleepUntil(uint64_t deadlineNs) {
+    timespec ts;
+    ts.tv_sec = static_cast<time_t>(deadlineNs / 1000000000ull);
+    ts.tv_nsec = static_cast<long>(deadlineNs % 1000000000ull);
+    clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr);
+}
+
+// The dashboard's simulation step, without the cell panel
+void Step(ui::AppState& state, ui::sim::FleetSimulator& simulator, int frame, double frameSeconds) {
+    simulator.SetControls(0, ui::sim::ControlsFromState(state));
+    simulator.Advance(frameSeconds);
+    simulator.ReadVehicle(0, state);
+    for (const ui::sim::SimEvent& event : simulator.GetEvents()) {
+        if (event.raised) {
+            ui::ReportFault(state, ui::sim::MakeFault(event));
+        } else {
+            state.faults.Resolve(ui::sim::SimFaultCode(event.fault));
+        }
+    }
+    simulator.ClearEvents();
+
+    // Exercise the rarely changing fields too
+    int second = static_cast<int>(frame * frameSeconds);
+    state.turnSignal = (second % 4 == 1) ? ui::TurnSignal::Left : ui::TurnSignal::None;
+    state.cruise = { second % 6 >= 3, second % 6 >= 3 ? 80 : 0 };
+    if (frame % 120 == 60) {
+        ui::ReportFault(state, { "STREAM_TEST", "Synthetic fault with a long message, \xC3\xA9\xC3\xA9 "
+                                 "\xE2\x80\x94 truncated at a UTF-8 boundary", ui::FaultSeverity::Warning,
+                                 simulator.GetConfig().startTimeMs + static_cast<int64_t>(simulator.GetTime() * 1000) });
+    } else if (frame % 120 == 100) {
+        state.faults.Resolve("STREAM_TEST");
+    }
+}
+
+bool WaitForViewers(ui::stream::StateStreamServer& server, const std::vector<Viewer>& viewers) {
+    uint64_t deadline = ui::MonotonicNowNs() + 3000000000ull;
+    while (ui::MonotonicNowNs() < deadline) {
+        ui::stream::StateStreamStats stats = server.GetStats();
+        bool handled = stats.deltas + stats.unchanged + stats.coalesced == stats.published;
+        bool caughtUp = handled;
+        for (const Viewer& viewer : viewers) caughtUp = caughtUp && viewer.progress.load() == stats.deltas;
+        if (caughtUp) return true;
+        usleep(1000);
+    }
+    return false;
+}
+
+void PrintUsage() {
+    printf("usage: state_stream_loadtest [--clients N] [--seconds S] [--rate HZ] [--port P]\n");
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+
+        if (value && strcmp(arg, "--clients") == 0) {
+            options.clients = atoi(value); i++;
+        } else if (value && strcmp(arg, "--seconds") == 0) {
+            options.seconds = atof(value); i++;
+        } else if (value && strcmp(arg, "--rate") == 0) {
+            options.rate = atof(value); i++;
+        } else if (value && strcmp(arg, "--port") == 0) {
+            options.port = static_cast<uint16_t>(atoi(value)); i++;
+        } else {
+            PrintUsage();
+            return 1;
+        }
+    }
+
+    if (options.clients <= 0 || options.seconds <= 0.0 || options.rate < 0.0) {
+        PrintUsage();
+        return 1;
+    }
+
+    ui::stream::StateStreamConfig config;
+    config.port = options.port;
+    config.maxClients = options.clients + 8;
+    ui::stream::StateStreamServer server(config);
+    if (!server.Start()) {
+        printf("cannot bind 127.0.0.1:%u\n", options.port);
+        return 1;
+    }
+
+    std::vector<Viewer> viewers(static_cast<size_t>(options.clients));
+    for (Viewer& viewer : viewers) {
+        if (!Connect(viewer, server.GetPort())) {
+            printf("cannot connect to the stream server\n");
+            return 1;
+        }
+    }
+    std::atomic<bool> stop{false};
+    std::thread viewerThread(ViewerMain, std::ref(viewers), std::ref(stop));
+    uint64_t deadline = ui::MonotonicNowNs() + 2000000000ull;
+    while (server.GetStats().handshakes < viewers.size() && ui::MonotonicNowNs() < deadline) usleep(1000);
+
+    const uint8_t ping[] = { 'p', 'i', 'n', 'g' };
+    bool sent = SendFrame(viewers[0], ui::ws::Opcode_Ping, ping, sizeof(ping));
+
+    ui::sim::SimConfig simConfig;
+    simConfig.randomizeCycleStart = false;
+    simConfig.scenarioProbability = 1.0f;
+    simConfig.scenarioWindowSeconds = static_cast<float>(options.seconds * 0.5);
+    simConfig.startTimeMs = 1700000000000;
+    ui::sim::FleetSimulator simulator(simConfig);
+    ui::AppState state = ui::CreateDefaultState();
+    state.contactorStates = { true, false, true };
+    state.gear = ui::Gear::Drive;
+    state.brakeEngaged = false;
+    simulator.InitVehicle(0, state);
+
+    // Render loop
+    double frameSeconds = 1.0 / (options.rate > 0.0 ? options.rate : 60.0);
+    int frames = static_cast<int>(options.seconds / frameSeconds);
+    uint64_t periodNs = options.rate > 0.0 ? static_cast<uint64_t>(1e9 / options.rate) : 0;
+    ui::LogHistogram publishNs;
+    uint64_t start = ui::MonotonicNowNs();
+    for (int frame = 0; frame < frames; frame++) {
+        Step(state, simulator, frame, frameSeconds);
+
+        uint64_t before = ui::MonotonicNowNs();
+        server.Publish(state);
+        publishNs.Record(ui::MonotonicNowNs() - before);
+
+        if (periodNs) SleepUntil(start + (frame + 1) * periodNs);
+    }
+    double elapsed = (ui::MonotonicNowNs() - start) * 1e-9;
+
+    bool caughtUp = WaitForViewers(server, viewers);
+
+    // Close handshake from one viewer
+    const uint8_t normalClosure[] = { 0x03, 0xE8 };
+    sent = SendFrame(viewers[0], ui::ws::Opcode_Close, normalClosure, sizeof(normalClosure)) && sent;
+    deadline = ui::MonotonicNowNs() + 1000000000ull;
+    while (!viewers[0].closed.load() && ui::MonotonicNowNs() < deadline) usleep(1000);
+
+    stop.store(true);
+    viewerThread.join();
+    ui::stream::StateStreamStats stats = server.GetStats();
+    server.Stop();
+    for (Viewer& viewer : viewers) close(viewer.fd);
+
+
+    // Every viewer must hold exactly what was published last
+    ui::stream::StateSnapshot expected;
+    ui::stream::CaptureState(state, expected);
+    int mismatched = 0, failed = 0;
+    uint64_t messages = 0, fullStates = 0, payloadBytes = 0;
+    for (Viewer& viewer : viewers) {
+        viewer.state.faultVersion = expected.faultVersion + 1;   // Compare fault contents
+        if (ui::stream::DiffState(expected, viewer.state) != 0) mismatched++;
+        failed += viewer.failed ? 1 : 0;
+        messages += viewer.messages;
+        fullStates += viewer.fullStates;
+        payloadBytes += viewer.payloadBytes;
+    }
+
+    printf("clients        %d (%llu handshakes, %llu rejected)\n", options.clients,
+           static_cast<unsigned long long>(stats.handshakes), static_cast<unsigned long long>(stats.rejected));
+    printf("frames         %d in %.2f s (%.0f Hz)\n", frames, elapsed, frames / elapsed);
+    printf("publish        p50 %llu ns, p99 %llu ns, max %llu ns\n",
+           static_cast<unsigned long long>(publishNs.Percentile(50)),
+           static_cast<unsigned long long>(publishNs.Percentile(99)),
+           static_cast<unsigned long long>(publishNs.Max()));
+    printf("server         %llu deltas, %llu skipped, %llu coalesced, %llu full states\n",
+           static_cast<unsigned long long>(stats.deltas), static_cast<unsigned long long>(stats.skipped),
+           static_cast<unsigned long long>(stats.coalesced), static_cast<unsigned long long>(stats.fullStates));
+    printf("wire           %.1f bytes/message, %.1f KB/s per client\n",
+           messages ? static_cast<double>(payloadBytes) / messages : 0.0,
+           payloadBytes / static_cast<double>(viewers.size()) / elapsed / 1024.0);
+    printf("viewers        %llu messages (%llu full), %d failed, %d mismatched, pong %s, close %s\n",
+           static_cast<unsigned long long>(messages), static_cast<unsigned long long>(fullStates),
+           failed, mismatched, viewers[0].pongs ? "ok" : "missing", viewers[0].closed.load() ? "ok" : "missing");
+
+    bool ok = sent && caughtUp && failed == 0 && mismatched == 0 && viewers[0].pongs > 0 && viewers[0].closed.load() &&
+              stats.handshakes == viewers.size();
+    printf("%s\n", ok ? "OK" : "FAILED");
+    return ok ? 0 : 1;
+}
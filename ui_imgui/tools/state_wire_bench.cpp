@@ -0,0 +1,489 @@
+/**
+ * Wire struct round-trip test and JSON comparison
+ *
+ * Steps a simulated vehicle (with synthetic faults, including long UTF-8
+ * messages and characters JSON must escape) and for every state:
+ *   - encodes it with EncodeWire(), copies the bytes into a fresh buffer
+ *     as a socket would, views them in place with ViewWire() and checks
+ *     WireMatches() against the source state;
+ *   - serializes the same state as VehicleState JSON (the shape
+ *     JSON.stringify gives lib/types.ts), parses it back and compares.
+ * Then times encode and read/parse of all states for both formats, and
+ * checks that ViewWire() rejects short, misaligned and corrupt buffers.
+ *
+ * Usage:
+ *   state_wire_bench [--states N] [--repeat N]
+ *
+ * Build (Linux):
+ *   g++ -O2 -std=c++17 -I.. state_wire_bench.cpp ../vehicle_sim.cpp ../cell_telemetry.cpp \
+ *       ../fault_aggregator.cpp ../fault_history.cpp ../fault_journal.cpp
+ */
+
+#include "../state_wire.h"
+#include "../vehicle_sim.h"
+#include "../monotonic_clock.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct Options {
+    int states = 20000;
+    int repeat = 5;
+};
+
+volatile uint64_t g_sink;   // Keeps the read loops from being optimized out
+
+const char* const kGears[] = { "P", "R", "N", "D" };
+const char* const kSeverities[] = { "info", "warning", "critical" };
+const char* const kTurnSignals[] = { nullptr, "left", "right" };
+
+// --- JSON --------------------------------------------------------------------
+
+void AppendEscaped(std::string& out, const std::string& text) {
+    out += '"';
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            char escaped[8];
+            snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+            out += escaped;
+        } else {
+            out += c;
+        }
+    }
+    out += '"';
+}
+
+void AppendNumber(std::string& out, const char* key, double value, const char* format = "%.9g") {
+    char buffer[64];
+    int length = snprintf(buffer, sizeof(buffer), "\"%s\":", key);
+    length += snprintf(buffer + length, sizeof(buffer) - length, format, value);
+    out.append(buffer, static_cast<size_t>(length));
+}
+
+// Same fields (and fault truncation) as the wire struct, so both sides carry equal content
+void EncodeJson(const ui::AppState& state, std::string& out) {
+    out.clear();
+    out += '{';
+    AppendNumber(out, "speed", state.speed, "%.0f");
+    out += ",\"gear\":\"";
+    out += kGears[static_cast<int>(state.gear)];
+    out += "\",\"mainBattery\":{";
+    AppendNumber(out, "soc", state.mainBattery.soc);
+    out += ',';
+    AppendNumber(out, "voltage", state.mainBattery.voltage);
+    out += ',';
+    AppendNumber(out, "current", state.mainBattery.current);
+    out += "},\"suppBattery\":{";
+    AppendNumber(out, "soc", state.suppBattery.soc);
+    out += ',';
+    AppendNumber(out, "voltage", state.suppBattery.voltage);
+    out += "},\"cruise\":{\"enabled\":";
+    out += state.cruise.enabled ? "true," : "false,";
+    AppendNumber(out, "setSpeed", state.cruise.setSpeed, "%.0f");
+    out += "},\"brakeEngaged\":";
+    out += state.brakeEngaged ? "true" : "false";
+    out += ",\"contactorStates\":{\"main\":";
+    out += state.contactorStates.main ? "true" : "false";
+    out += ",\"precharge\":";
+    out += state.contactorStates.precharge ? "true" : "false";
+    out += ",\"hvil\":";
+    out += state.contactorStates.hvil ? "true" : "false";
+    out += "},";
+    AppendNumber(out, "heartbeat", state.heartbeat, "%.0f");
+    out += ",\"faults\":[";
+    size_t count = std::min<size_t>(state.faults.Size(), ui::kWireMaxFaults);
+    for (size_t i = 0; i < count; i++) {
+        const ui::FaultAggregator::Entry& entry = state.faults.At(i);
+        ui::WireFault truncated;
+        ui::WireCopyText(truncated.code, sizeof(truncated.code), entry.code);
+        ui::WireCopyText(truncated.message, sizeof(truncated.message), entry.message);
+        out += i ? ",{\"code\":" : "{\"code\":";
+        AppendEscaped(out, truncated.code);
+        out += ",\"message\":";
+        AppendEscaped(out, truncated.message);
+        out += ",\"severity\":\"";
+        out += kSeverities[static_cast<int>(entry.severity)];
+        out += "\",";
+        AppendNumber(out, "timestamp", static_cast<double>(entry.firstSeen), "%.0f");
+        out += '}';
+    }
+    out += "],\"turnSignal\":";
+    const char* turn = kTurnSignals[static_cast<int>(state.turnSignal)];
+    if (turn) {
+        out += '"';
+        out += turn;
+        out += '"';
+    } else {
+        out += "null";
+    }
+    out += '}';
+}
+
+struct JsonFault {
+    std::string code, message, severity;
+    double timestamp = 0;
+};
+
+struct JsonState {
+    double speed = 0, mainSoc = 0, mainVoltage = 0, mainCurrent = 0, suppSoc = 0, suppVoltage = 0;
+    double setSpeed = 0, heartbeat = 0;
+    bool cruiseEnabled = false, brakeEngaged = false, main = false, precharge = false, hvil = false;
+    std::string gear, turnSignal;
+    std::vector<JsonFault> faults;
+};
+
+// Minimal recursive-descent parser for the shape above (what a typical consumer does)
+class JsonParser {
+public:
+    JsonParser(const std::string& text, JsonState& out) : p_(text.c_str()), end_(text.c_str() + text.size()), out_(out) {}
+
+    bool Parse() {
+        out_.faults.clear();
+        return Object("") && (Skip(), p_ == end_);
+    }
+
+private:
+    void Skip() {
+        while (p_ < end_ && (*p_ == ' ' || *p_ == '\n' || *p_ == '\t' || *p_ == '\r')) p_++;
+    }
+
+    bool String(std::string& out) {
+        Skip();
+        if (p_ >= end_ || *p_ != '"') return false;
+        out.clear();
+        for (p_++; p_ < end_ && *p_ != '"'; p_++) {
+            if (*p_ != '\\') {
+                out += *p_;
+            } else if (++p_ < end_ && *p_ == 'u' && end_ - p_ > 4) {
+                out += static_cast<char>(strtol(std::string(p_ + 1, 4).c_str(), nullptr, 16));
+                p_ += 4;
+            } else if (p_ < end_) {
+                out += *p_;
+            }
+        }
+        return p_++ < end_;
+    }
+
+    bool Value(const std::string& path) {
+        Skip();
+        if (p_ >= end_) return false;
+        if (*p_ == '{') return Object(path);
+        if (*p_ == '[') return Array(path);
+        if (*p_ == '"') {
+            std::string text;
+            if (!String(text)) return false;
+            Assign(path, text);
+            return true;
+        }
+        if (strncmp(p_, "true", 4) == 0 || strncmp(p_, "false", 5) == 0) {
+            bool value = *p_ == 't';
+            p_ += value ? 4 : 5;
+            Assign(path, value);
+            return true;
+        }
+        if (strncmp(p_, "null", 4) == 0) {
+            p_ += 4;
+            Assign(path, std::string());
+            return true;
+        }
+        char* next = nullptr;
+        double value = strtod(p_, &next);
+        if (next == p_) return false;
+        p_ = next;
+        Assign(path, value);
+        return true;
+    }
+
+    bool Object(const std::string& path) {
+        Skip();
+        if (p_ >= end_ || *p_ != '{') return false;
+        p_++;
+        Skip();
+        if (p_ < end_ && *p_ == '}') return p_++, true;
+        for (;;) {
+            std::string key;
+            if (!String(key)) return false;
+            Skip();
+            if (p_ >= end_ || *p_++ != ':') return false;
+            if (!Value(path.empty() ? key : path + "." + key)) return false;
+            Skip();
+            if (p_ < end_ && *p_ == ',') {
+                p_++;
+                continue;
+            }
+            return p_ < end_ && *p_++ == '}';
+        }
+    }
+
+    bool Array(const std::string& path) {
+        p_++;
+        Skip();
+        if (p_ < end_ && *p_ == ']') return p_++, true;
+        for (;;) {
+            if (path == "faults") out_.faults.emplace_back();
+            if (!Value(path + "[]")) return false;
+            Skip();
+            if (p_ < end_ && *p_ == ',') {
+                p_++;
+                continue;
+            }
+            return p_ < end_ && *p_++ == ']';
+        }
+    }
+
+    void Assign(const std::string& path, double value) {
+        if (path == "speed") out_.speed = value;
+        else if (path == "mainBattery.soc") out_.mainSoc = value;
+        else if (path == "mainBattery.voltage") out_.mainVoltage = value;
+        else if (path == "mainBattery.current") out_.mainCurrent = value;
+        else if (path == "suppBattery.soc") out_.suppSoc = value;
+        else if (path == "suppBattery.voltage") out_.suppVoltage = value;
+        else if (path == "cruise.setSpeed") out_.setSpeed = value;
+        else if (path == "heartbeat") out_.heartbeat = value;
+        else if (path == "faults[].timestamp" && !out_.faults.empty()) out_.faults.back().timestamp = value;
+    }
+
+    void Assign(const std::string& path, bool value) {
+        if (path == "cruise.enabled") out_.cruiseEnabled = value;
+        else if (path == "brakeEngaged") out_.brakeEngaged = value;
+        else if (path == "contactorStates.main") out_.main = value;
+        else if (path == "contactorStates.precharge") out_.precharge = value;
+        else if (path == "contactorStates.hvil") out_.hvil = value;
+    }
+
+    void Assign(const std::string& path, const std::string& value) {
+        if (path == "gear") out_.gear = value;
+        else if (path == "turnSignal") out_.turnSignal = value;
+        else if (out_.faults.empty()) return;
+        else if (path == "faults[].code") out_.faults.back().code = value;
+        else if (path == "faults[].message") out_.faults.back().message = value;
+        else if (path == "faults[].severity") out_.faults.back().severity = value;
+    }
+
+    const char* p_;
+    const char* end_;
+    JsonState& out_;
+};
+
+bool JsonMatches(const JsonState& json, const ui::AppState& state) {
+    const char* turn = kTurnSignals[static_cast<int>(state.turnSignal)];
+    bool ok = json.speed == state.speed && json.gear == kGears[static_cast<int>(state.gear)] &&
+              static_cast<float>(json.mainSoc) == state.mainBattery.soc &&
+              static_cast<float>(json.mainVoltage) == state.mainBattery.voltage &&
+              static_cast<float>(json.mainCurrent) == state.mainBattery.current &&
+              static_cast<float>(json.suppSoc) == state.suppBattery.soc &&
+              static_cast<float>(json.suppVoltage) == state.suppBattery.voltage &&
+              json.cruiseEnabled == state.cruise.enabled && json.setSpeed == state.cruise.setSpeed &&
+              json.brakeEngaged == state.brakeEngaged && json.main == state.contactorStates.main &&
+              json.precharge == state.contactorStates.precharge && json.hvil == state.contactorStates.hvil &&
+              json.heartbeat == state.heartbeat && json.turnSignal == (turn ? turn : "");
+    size_t count = std::min<size_t>(state.faults.Size(), ui::kWireMaxFaults);
+    if (!ok || json.faults.size() != count) return false;
+    for (size_t i = 0; i < count; i++) {
+        const ui::FaultAggregator::Entry& entry = state.faults.At(i);
+        const JsonFault& fault = json.faults[i];
+        if (!ui::WireTextMatches(fault.code.c_str(), sizeof(ui::WireFault::code), entry.code) ||
+            !ui::WireTextMatches(fault.message.c_str(), sizeof(ui::WireFault::message), entry.message) ||
+            fault.severity != kSeverities[static_cast<int>(entry.severity)] ||
+            fault.timestamp != static_cast<double>(entry.firstSeen)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// --- States ------------------------------------------------------------------
+
+void Step(ui::AppState& state, ui::sim::FleetSimulator& simulator, int index) {
+    simulator.SetControls(0, ui::sim::ControlsFromState(state));
+    simulator.Advance(0.1);
+    simulator.ReadVehicle(0, state);
+    for (const ui::sim::SimEvent& event : simulator.GetEvents()) {
+        if (event.raised) {
+            state.faults.Report(ui::sim::MakeFault(event));
+        } else {
+            state.faults.Resolve(ui::sim::SimFaultCode(event.fault));
+        }
+    }
+    simulator.ClearEvents();
+
+    state.turnSignal = static_cast<ui::TurnSignal>(index / 40 % 3);
+    state.cruise = { index / 90 % 2 == 1, index / 90 % 2 == 1 ? 100 : 0 };
+
+    // Up to 20 synthetic faults (more than the wire holds), some with long or escaped text
+    int slot = index % 20;
+    char code[32];
+    snprintf(code, sizeof(code), "SYN_%02d_LONG_CODE_NAME", slot);
+    if (index / 20 % 2 == 0) {
+        state.faults.Report({ code, "Cell \"" + std::to_string(slot) + "\" \xE2\x80\x94 temp\\delta high, "
+                              "repeated long message to overflow the wire field \xC3\xA9\xC3\xA9\xC3\xA9",
+                              static_cast<ui::FaultSeverity>(slot % 3), 1700000000000 + index * 100 });
+    } else {
+        state.faults.Resolve(code);
+        state.faults.Acknowledge(code);
+    }
+}
+
+bool CheckRejects(const ui::WireVehicleState& good) {
+    alignas(8) uint8_t buffer[sizeof(ui::WireVehicleState) + 8];
+    memcpy(buffer, &good, sizeof(good));
+    bool ok = ui::ViewWire(buffer, sizeof(good)) != nullptr;
+    ok = ok && ui::ViewWire(buffer, sizeof(good) - 1) == nullptr;
+
+    memcpy(buffer + 4, &good, sizeof(good));
+    ok = ok && ui::ViewWire(buffer + 4, sizeof(good)) == nullptr;
+
+    ui::WireVehicleState bad = good;
+    bad.magic ^= 1;
+    ok = ok && ui::ViewWire(&bad, sizeof(bad)) == nullptr;
+    bad = good;
+    bad.version++;
+    ok = ok && ui::ViewWire(&bad, sizeof(bad)) == nullptr;
+    bad = good;
+    bad.faultsCount = static_cast<uint8_t>(ui::kWireMaxFaults + 1);
+    ok = ok && ui::ViewWire(&bad, sizeof(bad)) == nullptr;
+    return ok;
+}
+
+// Touch every field as a consumer would
+uint64_t ReadAll(const ui::WireVehicleState& w) {
+    uint64_t sum = static_cast<uint64_t>(w.speed) + w.gear + w.cruiseEnabled + w.brakeEngaged + w.heartbeat +
+                   w.turnSignal + w.contactorStatesMain + w.contactorStatesPrecharge + w.contactorStatesHvil +
+                   static_cast<uint64_t>(w.cruiseSetSpeed);
+    sum += static_cast<uint64_t>(w.mainBatterySoc + w.mainBatteryVoltage + w.mainBatteryCurrent +
+                                 w.suppBatterySoc + w.suppBatteryVoltage);
+    for (uint8_t i = 0; i < w.faultsCount; i++) {
+        sum += static_cast<uint64_t>(w.faults[i].timestamp) + w.faults[i].severity +
+               static_cast<uint8_t>(w.faults[i].code[0]) + static_cast<uint8_t>(w.faults[i].message[0]);
+    }
+    return sum;
+}
+
+uint64_t ReadAll(const JsonState& j) {
+    uint64_t sum = static_cast<uint64_t>(j.speed + j.setSpeed + j.heartbeat) + j.gear.size() + j.turnSignal.size() +
+                   j.cruiseEnabled + j.brakeEngaged + j.main + j.precharge + j.hvil;
+    sum += static_cast<uint64_t>(j.mainSoc + j.mainVoltage + j.mainCurrent + j.suppSoc + j.suppVoltage);
+    for (const JsonFault& fault : j.faults) {
+        sum += static_cast<uint64_t>(fault.timestamp) + fault.severity.size() + static_cast<uint8_t>(fault.code[0]) +
+               static_cast<uint8_t>(fault.message[0]);
+    }
+    return sum;
+}
+
+void PrintUsage() {
+    printf("usage: state_wire_bench [--states N] [--repeat N]\n");
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+
+        if (value && strcmp(arg, "--states") == 0) {
+            options.states = atoi(value); i++;
+        } else if (value && strcmp(arg, "--repeat") == 0) {
+            options.repeat = atoi(value); i++;
+        } else {
+            PrintUsage();
+            return 1;
+        }
+    }
+
+    if (options.states <= 0 || options.repeat <= 0) {
+        PrintUsage();
+        return 1;
+    }
+
+    ui::sim::SimConfig simConfig;
+    simConfig.randomizeCycleStart = false;
+    simConfig.scenarioProbability = 1.0f;
+    simConfig.scenarioWindowSeconds = options.states * 0.05f;
+    simConfig.startTimeMs = 1700000000000;
+    ui::sim::FleetSimulator simulator(simConfig);
+    ui::AppState state = ui::CreateDefaultState();
+    state.contactorStates = { true, false, true };
+    state.gear = ui::Gear::Drive;
+    state.brakeEngaged = false;
+    simulator.InitVehicle(0, state);
+
+    // Encode every state both ways and check the round trip
+    std::vector<ui::WireVehicleState> wires(static_cast<size_t>(options.states));
+    std::vector<std::string> jsons(static_cast<size_t>(options.states));
+    std::vector<uint8_t> received(sizeof(ui::WireVehicleState) + 8);
+    JsonState parsed;
+    int wireMatches = 0, jsonMatches = 0;
+    size_t maxFaults = 0, jsonBytes = 0;
+    uint64_t wireEncodeNs = 0, jsonEncodeNs = 0;
+    for (int i = 0; i < options.states; i++) {
+        Step(state, simulator, i);
+        maxFaults = std::max(maxFaults, state.faults.Size());
+
+        uint64_t start = ui::MonotonicNowNs();
+        ui::EncodeWire(state, wires[i]);
+        uint64_t middle = ui::MonotonicNowNs();
+        EncodeJson(state, jsons[i]);
+        jsonEncodeNs += ui::MonotonicNowNs() - middle;
+        wireEncodeNs += middle - start;
+        jsonBytes += jsons[i].size();
+
+        // As if received from a socket into a (malloc-aligned) buffer
+        memcpy(received.data(), &wires[i], sizeof(ui::WireVehicleState));
+        const ui::WireVehicleState* view = ui::ViewWire(received.data(), sizeof(ui::WireVehicleState));
+        wireMatches += view && ui::WireMatches(*view, state) ? 1 : 0;
+
+        JsonParser parser(jsons[i], parsed);
+        jsonMatches += parser.Parse() && JsonMatches(parsed, state) ? 1 : 0;
+    }
+    bool rejects = CheckRejects(wires.back());
+
+    // Read side: every field of every state
+    uint64_t wireSum = 0, jsonSum = 0;
+    uint64_t start = ui::MonotonicNowNs();
+    for (int r = 0; r < options.repeat; r++) {
+        for (const ui::WireVehicleState& wire : wires) {
+            const ui::WireVehicleState* view = ui::ViewWire(&wire, sizeof(wire));
+            if (view) wireSum += ReadAll(*view);
+        }
+    }
+    uint64_t wireReadNs = ui::MonotonicNowNs() - start;
+
+    start = ui::MonotonicNowNs();
+    for (int r = 0; r < options.repeat; r++) {
+        for (const std::string& json : jsons) {
+            JsonParser parser(json, parsed);
+            if (parser.Parse()) jsonSum += ReadAll(parsed);
+        }
+    }
+    uint64_t jsonReadNs = ui::MonotonicNowNs() - start;
+    g_sink = wireSum + jsonSum;
+
+    double states = options.states;
+    double reads = states * options.repeat;
+    double wireRead = wireReadNs / reads, jsonRead = jsonReadNs / reads;
+    printf("states         %d (up to %zu faults, wire holds %zu)\n", options.states, maxFaults, ui::kWireMaxFaults);
+    printf("wire           %zu bytes/state, encode %.1f ns, view+read %.1f ns\n",
+           sizeof(ui::WireVehicleState), wireEncodeNs / states, wireRead);
+    printf("json           %.0f bytes/state, encode %.1f ns, parse+read %.1f ns\n",
+           jsonBytes / states, jsonEncodeNs / states, jsonRead);
+    printf("speedup        encode %.1fx, read %.1fx\n",
+           wireEncodeNs ? static_cast<double>(jsonEncodeNs) / wireEncodeNs : 0.0,
+           wireRead > 0 ? jsonRead / wireRead : 0.0);
+    printf("round trip     wire %d/%d, json %d/%d, rejects %s\n",
+           wireMatches, options.states, jsonMatches, options.states, rejects ? "ok" : "FAILED");
+
+    bool ok = wireMatches == options.states && jsonMatches == options.states && rejects;
+    printf("%s\n", ok ? "OK" : "FAILED");
+    return ok ? 0 : 1;
+}
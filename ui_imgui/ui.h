@@ -10,9 +10,30 @@
 #include "theme.h"
 #include "widgets.h"
 #include "dashboard.h"
+#include "vehicle_sim.h"
+#include "parallel_draw.h"
+#include "draw_budget.h"
+#include "frame_pacer.h"
+#include "signal_interp.h"
+#include "signal_bus.h"
+#include "signal_freshness.h"
+#include "session_store.h"
+#include "monotonic_clock.h"
+#include "arena_alloc.h"
+#include <chrono>
 
 namespace ui {
 
+/**
+ * Route ImGui's allocations through an arena
+ * Call before ImGui::CreateContext(); the arena must outlive every context.
+ *
+ * @param arena Preallocated arena (see arena_alloc.h)
+ */
+inline void InstallImGuiAllocator(ArenaAllocator& arena) {
+    ImGui::SetAllocatorFunctions(ArenaAllocator::ImGuiAlloc, ArenaAllocator::ImGuiFree, &arena);
+}
+
 /**
  * Initialize the UI system
  * Call once after creating ImGui context
@@ -47,44 +68,116 @@ inline void InitUI(const char* fontPath = nullptr,
  * @endcode
  */
 inline void RenderUI(AppState& state) {
-    RenderDashboard(state);
+    if (state.freshness) {
+        state.freshness->Sweep(MonotonicNowNs());
+    }
+    if (state.signals && state.signals->Evaluate(MonotonicNowNs()) && state.framePacer) {
+        // Samples still being played out: keep the gauges at the display rate
+        state.framePacer->RequestAnimation(state.framePacer->GetConfig().activeHz);
+    }
+    if (state.playback) {
+        state.playback->Poll(MonotonicNowNs());
+        state.playback->Advance(static_cast<uint64_t>(ImGui::GetIO().DeltaTime * 1e9f));
+    }
+    if (state.drawBudget) {
+        state.drawBudget->BeginFrame(state.parallelDraw);
+    }
+    // While scrubbing a recording, draw its reconstructed state instead
+    bool playback = state.playback && state.playback->IsActive();
+    RenderDashboard(playback ? state.playback->Resolve(state) : state);
+    if (state.parallelDraw) {
+        state.parallelDraw->Splice();
+    }
+    if (state.drawBudget) {
+        state.drawBudget->EndFrame();
+    }
+}
+
+/**
+ * Add the DashboardSignal entries to an interpolator, in enum order
+ * Call once on an empty interpolator before attaching it to AppState::signals.
+ *
+ * @param signals Interpolator to configure
+ * @param config Settings for all dashboard signals
+ * @return false if the interpolator already had signals or is full
+ */
+inline bool AddDashboardSignals(SignalInterpolator& signals, const SignalConfig& config = SignalConfig()) {
+    if (signals.GetSignalCount() != 0) return false;
+    for (int i = 0; i < DashboardSignal_Count; i++) {
+        if (signals.AddSignal(config) != i) return false;
+    }
+    return true;
+}
+
+/**
+ * Push the current speed and SOC values as samples
+ * Call whenever new telemetry has been copied into the state.
+ *
+ * @param state Application state with the new values (signals attached)
+ * @param timeNs Sample time on the MonotonicNowNs() clock; for packets, the
+ *               sender time mapped through a SourceClock
+ */
+inline void PushDashboardSamples(const AppState& state, uint64_t timeNs) {
+    if (!state.signals) return;
+    state.signals->Push(DashboardSignal_Speed, timeNs, static_cast<float>(state.speed));
+    state.signals->Push(DashboardSignal_MainSoc, timeNs, state.mainBattery.soc);
+    state.signals->Push(DashboardSignal_SuppSoc, timeNs, state.suppBattery.soc);
+}
+
+/**
+ * Advance a fleet simulator and copy one vehicle into the dashboard state
+ * Dashboard inputs (gear, brake, contactor, cruise) drive the vehicle, its
+ * outputs (speed, batteries, cells, heartbeat, HVIL) are written back and fault
+ * events raised or cleared by the simulator are reported / resolved.
+ *
+ * @param state Application state to update
+ * @param simulator Simulator owning the vehicle
+ * @param deltaTime Time since last update in seconds
+ * @param vehicle Vehicle index shown on the dashboard
+ */
+inline void UpdateSimulation(AppState& state, sim::FleetSimulator& simulator, float deltaTime,
+                             uint32_t vehicle = 0) {
+    simulator.SetControls(vehicle, sim::ControlsFromState(state));
+    simulator.Advance(deltaTime);
+    simulator.ReadVehicle(vehicle, state);
+    simulator.ReadCells(vehicle, state.cells);
+    if (state.freshness) {
+        uint64_t nowNs = MonotonicNowNs();
+        TouchDashboardFeeds(state, nowNs);
+        ObserveDashboardHeartbeat(state, state.heartbeat, nowNs);
+    }
+
+    for (const sim::SimEvent& event : simulator.GetEvents()) {
+        if (event.vehicle != vehicle) continue;
+        if (event.raised) {
+            ReportFault(state, sim::MakeFault(event));
+        } else {
+            state.faults.Resolve(sim::SimFaultCode(event.fault));
+        }
+    }
+    simulator.ClearEvents();
 }
 
 /**
  * Update simulation state (optional helper)
- * Call this at regular intervals to simulate real-time data updates
+ * Call this at regular intervals to simulate real-time data updates.
+ * Uses a single-vehicle deterministic simulator on the WLTP cycle, started
+ * from the current state's battery readings on the first call.
  * 
  * @param state Application state to update
  * @param deltaTime Time since last update in seconds
  */
 inline void UpdateSimulation(AppState& state, float deltaTime) {
-    // Increment heartbeat
-    state.heartbeat = static_cast<uint8_t>((state.heartbeat + 1) % 256);
-    
-    // Simulate speed changes when main contactor is closed
-    if (state.contactorStates.main) {
-        // Random speed fluctuation
-        float speedDelta = (static_cast<float>(rand()) / RAND_MAX - 0.3f) * 5.0f;
-        state.speed = static_cast<int>(std::max(0.0f, std::min(120.0f, 
-            static_cast<float>(state.speed) + speedDelta)));
-    } else {
-        state.speed = 0;
-    }
-    
-    // Simulate current based on speed
-    if (state.speed > 0) {
-        state.mainBattery.current = -(50.0f + static_cast<float>(rand()) / RAND_MAX * 150.0f);
-    } else {
-        state.mainBattery.current = 0.0f;
-    }
-    
-    // Slight voltage fluctuation
-    state.mainBattery.voltage = 352.4f + (static_cast<float>(rand()) / RAND_MAX - 0.5f) * 2.0f;
-    
-    // Slow SOC drain when current is negative
-    if (state.mainBattery.current < 0) {
-        state.mainBattery.soc = std::max(0.0f, state.mainBattery.soc - 0.001f);
-    }
+    static sim::FleetSimulator simulator = [&state] {
+        sim::SimConfig config;
+        config.randomizeCycleStart = false;
+        config.startTimeMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+        sim::FleetSimulator created(config);
+        created.InitVehicle(0, state);
+        return created;
+    }();
+    UpdateSimulation(state, simulator, deltaTime);
 }
 
 } // namespace ui
@@ -0,0 +1,501 @@
+#include "vehicle_sim.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace ui {
+namespace sim {
+
+namespace {
+
+struct CyclePoint {
+    float t;     // s
+    float kmh;
+};
+
+// WLTC class 3 shape: phase boundaries at 589, 1022, 1477 and 1800 s with
+// peak speeds 56.5, 76.6, 97.4 and 131.3 km/h
+const CyclePoint kWltpPoints[] = {
+    // Low
+    { 0, 0 }, { 11, 0 }, { 18, 18 }, { 30, 25 }, { 40, 10 }, { 47, 0 }, { 60, 0 },
+    { 75, 30 }, { 95, 40 }, { 110, 20 }, { 122, 0 }, { 140, 0 }, { 155, 25 }, { 175, 30 },
+    { 190, 0 }, { 205, 0 }, { 225, 35 }, { 250, 45 }, { 270, 20 }, { 285, 0 }, { 300, 0 },
+    { 320, 40 }, { 345, 56.5f }, { 370, 50 }, { 395, 30 }, { 410, 0 }, { 425, 0 }, { 445, 30 },
+    { 470, 40 }, { 490, 25 }, { 505, 0 }, { 520, 0 }, { 540, 35 }, { 565, 20 }, { 580, 0 },
+    { 589, 0 },
+    // Medium
+    { 600, 0 }, { 625, 45 }, { 660, 60 }, { 690, 50 }, { 715, 0 }, { 730, 0 }, { 760, 55 },
+    { 800, 76.6f }, { 840, 65 }, { 870, 40 }, { 890, 0 }, { 905, 0 }, { 930, 50 }, { 965, 70 },
+    { 990, 45 }, { 1010, 0 }, { 1022, 0 },
+    // High
+    { 1035, 0 }, { 1065, 60 }, { 1110, 85 }, { 1160, 97.4f }, { 1200, 80 }, { 1240, 60 },
+    { 1270, 0 }, { 1285, 0 }, { 1315, 65 }, { 1360, 90 }, { 1400, 75 }, { 1440, 50 },
+    { 1465, 0 }, { 1477, 0 },
+    // Extra high
+    { 1490, 0 }, { 1530, 80 }, { 1580, 110 }, { 1640, 131.3f }, { 1700, 120 }, { 1740, 90 },
+    { 1775, 40 }, { 1795, 0 }, { 1800, 0 },
+};
+
+// ECE-15 elementary urban cycle
+const CyclePoint kUrbanPoints[] = {
+    { 0, 0 }, { 11, 0 }, { 15, 15 }, { 23, 15 }, { 28, 0 }, { 49, 0 }, { 61, 32 }, { 85, 32 },
+    { 96, 0 }, { 117, 0 }, { 143, 50 }, { 155, 50 }, { 163, 35 }, { 176, 35 }, { 188, 0 },
+    { 195, 0 },
+};
+
+// Vehicle
+constexpr float kGravity = 9.81f;
+constexpr float kAirDensity = 1.2f;
+constexpr float kDragArea = 0.62f;          // Cd * A, m^2
+constexpr float kRollingResistance = 0.010f;
+constexpr float kDriverGain = 0.8f;         // 1/s
+constexpr float kAccelMax = 2.5f;           // m/s^2
+constexpr float kDecelMax = 3.5f;
+constexpr float kDriveEfficiency = 0.90f;
+constexpr float kRegenEfficiency = 0.65f;
+constexpr float kRegenMaxW = 60000.0f;
+constexpr float kMotorMaxW = 150000.0f;
+constexpr float kAuxLoadW = 600.0f;
+
+// Pack: 96s, linearized OCV, resistance rising in the cold
+constexpr float kCells = 96.0f;
+constexpr float kCellOcvEmpty = 3.35f;
+constexpr float kCellOcvSpan = 0.45f;
+constexpr float kPackCapacityAh = 200.0f;
+constexpr float kPackResistance = 0.08f;    // Ohm at 25 degC
+constexpr float kAmbientC = 25.0f;
+constexpr float kPackThermalMass = 150000.0f;   // J/K
+constexpr float kPackCoolingWK = 150.0f;
+constexpr float kStuckHeaterW = 6000.0f;
+constexpr float kMotorThermalMass = 10000.0f;
+constexpr float kMotorCoolingWK = 100.0f;
+constexpr float kMotorLossFraction = 0.08f;
+constexpr float kMotorDerateStartC = 140.0f;
+constexpr float kMotorDerateEndC = 170.0f;
+
+// 12V
+constexpr float kSuppCapacityAh = 60.0f;
+constexpr float kSuppLoadA = 48.0f;
+constexpr float kSuppChargeRate = 0.0005f;  // SOC/s with DC-DC running
+
+// Fault thresholds (raise, clear)
+constexpr float kPackTempRaise = 55.0f, kPackTempClear = 50.0f;
+constexpr float kMotorTempRaise = 150.0f, kMotorTempClear = 130.0f;
+constexpr float kSuppVoltRaise = 11.9f, kSuppVoltClear = 12.2f;
+
+constexpr float kFlappingSeconds = 60.0f;
+
+const struct { const char* code; const char* message; FaultSeverity severity; } kFaultInfo[] = {
+    { "E001", "Battery temp high", FaultSeverity::Warning },
+    { "E002", "Motor overheat", FaultSeverity::Critical },
+    { "E003", "CAN timeout", FaultSeverity::Warning },
+    { "E004", "HVIL open", FaultSeverity::Critical },
+    { "E005", "Low 12V battery", FaultSeverity::Info },
+};
+static_assert(sizeof(kFaultInfo) / sizeof(kFaultInfo[0]) == static_cast<size_t>(SimFault::Count),
+              "fault table out of sync");
+
+uint64_t SplitMix64(uint64_t& state) {
+    uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+float NextUniform(uint64_t& state) {
+    return static_cast<float>(SplitMix64(state) >> 40) * (1.0f / 16777216.0f);
+}
+
+uint8_t FaultBit(SimFault fault) {
+    return static_cast<uint8_t>(1u << static_cast<unsigned>(fault));
+}
+
+} // namespace
+
+const char* SimFaultCode(SimFault fault) {
+    return kFaultInfo[static_cast<int>(fault)].code;
+}
+
+const char* SimFaultMessage(SimFault fault) {
+    return kFaultInfo[static_cast<int>(fault)].message;
+}
+
+FaultSeverity SimFaultSeverity(SimFault fault) {
+    return kFaultInfo[static_cast<int>(fault)].severity;
+}
+
+/**
+ * Per-vehicle physics step over structure-of-arrays state
+ *
+ * No branches: controls are 0/1 factors and limits are min/max, and every
+ * array is a distinct restrict parameter (GCC ignores restrict on local
+ * pointers), so the loop vectorizes. GCC additionally needs
+ * -fno-math-errno (inline sqrt) and -fno-trapping-math (if-convert the
+ * min/max); without them it runs the same code scalar.
+ */
+static void IntegrateVehicles(size_t n, float dt,
+                              const float* __restrict target, const float* __restrict mass,
+                              const float* __restrict packCooling, const float* __restrict packHeater,
+                              const float* __restrict motorCooling, const float* __restrict traction,
+                              const float* __restrict dcdc,
+                              float* __restrict speed, float* __restrict accel, float* __restrict soc,
+                              float* __restrict voltage, float* __restrict current,
+                              float* __restrict packTemp, float* __restrict motorTemp,
+                              float* __restrict suppSoc, float* __restrict suppVoltage) {
+    for (size_t i = 0; i < n; i++) {
+        float v = speed[i];
+        float m = mass[i];
+        float vTarget = target[i];
+
+        // Driver, limited by traction: without it the car can only coast or brake
+        // (rolling resistance fades in over the first 0.1 m/s so it never pushes backwards)
+        float rolling = kRollingResistance * m * kGravity * std::min(v * 10.0f, 1.0f);
+        float roadForce = rolling + 0.5f * kAirDensity * kDragArea * v * v;
+        float aCoast = -roadForce / m;
+        float aDriver = std::min(std::max(kDriverGain * (vTarget - v), -kDecelMax), kAccelMax);
+        float a = aDriver - (1.0f - traction[i]) * std::max(aDriver - aCoast, 0.0f);
+
+        // Motor power limit, derated when hot
+        float hot = std::min(std::max((motorTemp[i] - kMotorDerateStartC)
+                                      / (kMotorDerateEndC - kMotorDerateStartC), 0.0f), 1.0f);
+        float wheelLimit = kMotorMaxW * (1.0f - 0.8f * hot) * kDriveEfficiency;
+        float vMid = v + 0.5f * a * dt;
+        float wheelPower = (m * a + roadForce) * vMid;
+        float limitedAccel = (wheelLimit / std::max(vMid, 0.1f) - roadForce) / m;
+        a = std::min(a, limitedAccel);
+        wheelPower = std::min(wheelPower, wheelLimit);
+        float vNew = std::max(v + a * dt, 0.0f);
+
+        float drivePower = std::max(wheelPower, 0.0f) * (1.0f / kDriveEfficiency);
+        float regenPower = std::max(std::min(wheelPower, 0.0f) * kRegenEfficiency, -kRegenMaxW);
+        float tractionPower = drivePower + regenPower;
+        float packPower = traction[i] * tractionPower + dcdc[i] * kAuxLoadW;
+
+        // Pack: P = (OCV - I R) I  ->  I = (OCV - sqrt(OCV^2 - 4 R P)) / 2R
+        float temp = packTemp[i];
+        float ocv = kCells * (kCellOcvEmpty + kCellOcvSpan * soc[i]);
+        float r = kPackResistance * (1.0f + 0.015f * std::max(kAmbientC - temp, 0.0f));
+        float disc = std::max(ocv * ocv - 4.0f * r * packPower, 0.0f);
+        float amps = (ocv - std::sqrt(disc)) / (2.0f * r);
+        float charge = std::min(std::max(soc[i] - amps * dt * (1.0f / (3600.0f * kPackCapacityAh)), 0.0f), 1.0f);
+
+        // Thermal
+        temp += (amps * amps * r + packHeater[i] - packCooling[i] * (temp - kAmbientC))
+                * dt * (1.0f / kPackThermalMass);
+        float motor = motorTemp[i];
+        motor += (kMotorLossFraction * std::fabs(wheelPower) - motorCooling[i] * (motor - kAmbientC))
+                 * dt * (1.0f / kMotorThermalMass);
+
+        // 12V: charged by the DC-DC, otherwise carries the aux load alone
+        float converter = dcdc[i];
+        float supp = suppSoc[i];
+        supp += dt * (converter * kSuppChargeRate * (1.0f - supp)
+                      - (1.0f - converter) * kSuppLoadA * (1.0f / (3600.0f * kSuppCapacityAh)));
+        supp = std::min(std::max(supp, 0.0f), 1.0f);
+
+        speed[i] = vNew;
+        accel[i] = a;
+        soc[i] = charge;
+        current[i] = amps;
+        voltage[i] = ocv - amps * r;
+        packTemp[i] = temp;
+        motorTemp[i] = motor;
+        suppSoc[i] = supp;
+        suppVoltage[i] = 11.8f + 0.9f * supp + converter * 0.9f - (1.0f - converter) * 0.3f;
+    }
+}
+
+FleetSimulator::FleetSimulator(const SimConfig& config) : config_(config) {
+    if (config_.stepSeconds <= 0.0f) config_.stepSeconds = 0.1f;
+
+    // Sample the cycle at 1 Hz so the per-step lookup is an index + lerp
+    const CyclePoint* points = config_.cycle == DriveCycle::Urban ? kUrbanPoints : kWltpPoints;
+    size_t pointCount = config_.cycle == DriveCycle::Urban
+        ? sizeof(kUrbanPoints) / sizeof(kUrbanPoints[0])
+        : sizeof(kWltpPoints) / sizeof(kWltpPoints[0]);
+
+    cycleDuration_ = points[pointCount - 1].t;
+    cycle_.resize(static_cast<size_t>(cycleDuration_) + 2);
+    size_t segment = 0;
+    for (size_t s = 0; s < cycle_.size(); s++) {
+        float t = std::min(static_cast<float>(s), cycleDuration_);
+        while (segment + 2 < pointCount && points[segment + 1].t <= t) segment++;
+        const CyclePoint& a = points[segment];
+        const CyclePoint& b = points[segment + 1];
+        float f = (t - a.t) / (b.t - a.t);
+        cycle_[s] = a.kmh + (b.kmh - a.kmh) * std::min(std::max(f, 0.0f), 1.0f);
+    }
+
+    size_t n = config_.vehicles;
+    cycleOffset_.resize(n);
+    speedScale_.resize(n);
+    mass_.resize(n);
+    packCooling_.assign(n, kPackCoolingWK);
+    packHeater_.assign(n, 0.0f);
+    motorCooling_.assign(n, kMotorCoolingWK);
+    traction_.assign(n, 1.0f);
+    drive_.assign(n, 1.0f);
+    cruise_.assign(n, 0.0f);
+    follow_.assign(n, 1.0f);
+    target_.assign(n, 0.0f);
+    dcdc_.assign(n, 1.0f);
+    speed_.assign(n, 0.0f);
+    accel_.assign(n, 0.0f);
+    soc_.resize(n);
+    voltage_.resize(n);
+    current_.assign(n, 0.0f);
+    packTemp_.assign(n, kAmbientC);
+    motorTemp_.assign(n, kAmbientC);
+    suppSoc_.resize(n);
+    suppVoltage_.resize(n);
+    hvil_.assign(n, 1);
+    faultBits_.assign(n, 0);
+    scenario_.assign(n, FaultScenario::None);
+    scenarioStart_.assign(n, 0.0f);
+    scenarioNextToggle_.assign(n, 0.0f);
+    rng_.resize(n);
+
+    for (size_t i = 0; i < n; i++) {
+        uint64_t& rng = rng_[i];
+        rng = config_.seed ^ (0xD1B54A32D192ED03ull * (i + 1));
+
+        cycleOffset_[i] = config_.randomizeCycleStart ? NextUniform(rng) * cycleDuration_ : 0.0f;
+        speedScale_[i] = 0.92f + 0.16f * NextUniform(rng);
+        mass_[i] = 1700.0f + 400.0f * NextUniform(rng);
+        soc_[i] = 0.55f + 0.40f * NextUniform(rng);
+        suppSoc_[i] = 0.85f + 0.15f * NextUniform(rng);
+        voltage_[i] = kCells * (kCellOcvEmpty + kCellOcvSpan * soc_[i]);
+        suppVoltage_[i] = 11.8f + 0.9f * suppSoc_[i];
+
+        if (NextUniform(rng) < config_.scenarioProbability) {
+            int kinds = static_cast<int>(FaultScenario::Count) - 1;
+            int kind = 1 + std::min(static_cast<int>(NextUniform(rng) * kinds), kinds - 1);
+            scenario_[i] = static_cast<FaultScenario>(kind);
+            scenarioStart_[i] = NextUniform(rng) * config_.scenarioWindowSeconds;
+            scenarioNextToggle_[i] = scenarioStart_[i];
+            scenarioVehicles_.push_back(static_cast<uint32_t>(i));
+        }
+    }
+
+    events_.reserve(64);
+}
+
+void FleetSimulator::Advance(double seconds) {
+    if (seconds <= 0.0) return;
+    carry_ += seconds;
+    double step = config_.stepSeconds;
+    while (carry_ >= step) {
+        Step();
+        carry_ -= step;
+    }
+}
+
+void FleetSimulator::Step() {
+    StepScenarios();
+    StepPhysics();
+    CheckThresholds();
+    steps_++;
+}
+
+void FleetSimulator::StepPhysics() {
+    const size_t n = config_.vehicles;
+    const float duration = cycleDuration_;
+    const float phase = static_cast<float>(std::fmod(GetTime(), static_cast<double>(duration)));
+    const int cycleSeconds = static_cast<int>(duration);
+    const float* cycle = cycle_.data();
+
+    // Pass 1: speed targets. The cycle lookup is a gather, kept out of the
+    // physics loop so that one stays purely streaming.
+    for (size_t i = 0; i < n; i++) {
+        float tc = phase + 1.0f + cycleOffset_[i];   // 1 s lookahead
+        int k = static_cast<int>(tc);
+        float f = tc - static_cast<float>(k);
+        k -= cycleSeconds & -static_cast<int>(k >= cycleSeconds);
+        k -= cycleSeconds & -static_cast<int>(k >= cycleSeconds);
+        float vCycle = (cycle[k] + f * (cycle[k + 1] - cycle[k])) * speedScale_[i] * (1.0f / 3.6f);
+        target_[i] = drive_[i] * (cruise_[i] + follow_[i] * vCycle);
+    }
+
+    // Pass 2: vehicle physics
+    IntegrateVehicles(n, config_.stepSeconds, target_.data(), mass_.data(), packCooling_.data(),
+                      packHeater_.data(), motorCooling_.data(), traction_.data(), dcdc_.data(),
+                      speed_.data(), accel_.data(), soc_.data(), voltage_.data(), current_.data(),
+                      packTemp_.data(), motorTemp_.data(), suppSoc_.data(), suppVoltage_.data());
+}
+
+void FleetSimulator::StepScenarios() {
+    const float time = static_cast<float>(GetTime());
+
+    for (uint32_t i : scenarioVehicles_) {
+        if (time < scenarioStart_[i]) continue;
+        uint64_t& rng = rng_[i];
+
+        switch (scenario_[i]) {
+            case FaultScenario::CanTimeoutFlapping:
+                if (time < scenarioStart_[i] + kFlappingSeconds) {
+                    if (time >= scenarioNextToggle_[i]) {
+                        bool raised = !(faultBits_[i] & FaultBit(SimFault::CanTimeout));
+                        Emit(i, SimFault::CanTimeout, raised);
+                        scenarioNextToggle_[i] = time + 1.0f + 3.0f * NextUniform(rng);
+                    }
+                } else if (faultBits_[i] & FaultBit(SimFault::CanTimeout)) {
+                    Emit(i, SimFault::CanTimeout, false);
+                }
+                break;
+            case FaultScenario::HvilOpen:
+                if (hvil_[i]) {
+                    hvil_[i] = 0;
+                    traction_[i] = 0.0f;
+                    Emit(i, SimFault::HvilOpen, true);
+                }
+                break;
+            case FaultScenario::CoolingFailure:
+                packCooling_[i] = 0.0f;
+                packHeater_[i] = kStuckHeaterW;
+                break;
+            case FaultScenario::DcDcFailure:
+                dcdc_[i] = 0.0f;
+                break;
+            case FaultScenario::MotorCoolingFailure:
+                motorCooling_[i] = 5.0f;
+                break;
+            default:
+                break;
+        }
+    }
+}
+
+void FleetSimulator::CheckThresholds() {
+    const size_t n = config_.vehicles;
+    const uint8_t packBit = FaultBit(SimFault::BatteryTempHigh);
+    const uint8_t motorBit = FaultBit(SimFault::MotorOverheat);
+    const uint8_t suppBit = FaultBit(SimFault::Low12V);
+
+    for (size_t i = 0; i < n; i++) {
+        uint8_t bits = faultBits_[i];
+        bool pack = (bits & packBit) ? packTemp_[i] > kPackTempClear : packTemp_[i] > kPackTempRaise;
+        bool motor = (bits & motorBit) ? motorTemp_[i] > kMotorTempClear : motorTemp_[i] > kMotorTempRaise;
+        bool supp = (bits & suppBit) ? suppVoltage_[i] < kSuppVoltClear : suppVoltage_[i] < kSuppVoltRaise;
+
+        uint8_t next = static_cast<uint8_t>((bits & ~(packBit | motorBit | suppBit))
+                                            | (pack ? packBit : 0) | (motor ? motorBit : 0) | (supp ? suppBit : 0));
+        if (next == bits) continue;
+
+        uint32_t vehicle = static_cast<uint32_t>(i);
+        if ((next ^ bits) & packBit) Emit(vehicle, SimFault::BatteryTempHigh, pack);
+        if ((next ^ bits) & motorBit) Emit(vehicle, SimFault::MotorOverheat, motor);
+        if ((next ^ bits) & suppBit) Emit(vehicle, SimFault::Low12V, supp);
+    }
+}
+
+void FleetSimulator::Emit(uint32_t vehicle, SimFault fault, bool raised) {
+    uint8_t bit = FaultBit(fault);
+    faultBits_[vehicle] = static_cast<uint8_t>(raised ? (faultBits_[vehicle] | bit) : (faultBits_[vehicle] & ~bit));
+
+    SimEvent event;
+    event.vehicle = vehicle;
+    event.fault = fault;
+    event.raised = raised;
+    event.timestampMs = config_.startTimeMs + static_cast<int64_t>(GetTime() * 1000.0);
+    events_.push_back(event);
+}
+
+void FleetSimulator::SetControls(uint32_t vehicle, const VehicleControls& controls) {
+    bool hvilClosed = hvil_[vehicle] != 0;
+    traction_[vehicle] = (controls.mainContactor && hvilClosed) ? 1.0f : 0.0f;
+    drive_[vehicle] = (controls.gear == Gear::Drive && !controls.brake) ? 1.0f : 0.0f;
+    cruise_[vehicle] = static_cast<float>(std::max(controls.cruiseSetSpeed, 0)) * (1.0f / 3.6f);
+    follow_[vehicle] = controls.cruiseSetSpeed > 0 ? 0.0f : 1.0f;
+}
+
+void FleetSimulator::InitVehicle(uint32_t vehicle, const AppState& state) {
+    soc_[vehicle] = std::min(std::max(state.mainBattery.soc * 0.01f, 0.0f), 1.0f);
+    suppSoc_[vehicle] = std::min(std::max(state.suppBattery.soc * 0.01f, 0.0f), 1.0f);
+    voltage_[vehicle] = kCells * (kCellOcvEmpty + kCellOcvSpan * soc_[vehicle]);
+    suppVoltage_[vehicle] = 11.8f + 0.9f * suppSoc_[vehicle];
+}
+
+void FleetSimulator::ReadVehicle(uint32_t vehicle, AppState& state) const {
+    state.speed = static_cast<int>(std::lround(speed_[vehicle] * 3.6f));
+    state.mainBattery.soc = soc_[vehicle] * 100.0f;
+    state.mainBattery.voltage = voltage_[vehicle];
+    state.mainBattery.current = -current_[vehicle];  // AppState: negative = discharging
+    state.suppBattery.soc = suppSoc_[vehicle] * 100.0f;
+    state.suppBattery.voltage = suppVoltage_[vehicle];
+    state.heartbeat = static_cast<uint8_t>(steps_ & 0xFF);
+    state.contactorStates.hvil = hvil_[vehicle] != 0;
+    if (!hvil_[vehicle]) {
+        state.contactorStates.main = false;
+    }
+}
+
+void FleetSimulator::ReadCells(uint32_t vehicle, CellTelemetry& cells) const {
+    const int count = static_cast<int>(kCells);
+    cells.SetCellCount(static_cast<size_t>(count));
+
+    float cellVoltage = voltage_[vehicle] / kCells;
+    float cellCurrent = current_[vehicle];
+    float packTemp = packTemp_[vehicle];
+    float heating = packTemp - kAmbientC;
+
+    float voltages[static_cast<int>(kCells)];
+    float temps[static_cast<int>(kCells)];
+    uint64_t rng = config_.seed ^ (0xA0761D6478BD642Full * (vehicle + 1));
+    for (int i = 0; i < count; i++) {
+        // Fixed per-cell spread: OCV offset +-4 mV, resistance +-20 %, temp +-0.5 degC
+        float ocvOffset = (NextUniform(rng) - 0.5f) * 0.008f;
+        float resistanceSpread = (NextUniform(rng) - 0.5f) * 0.4f;
+        float tempOffset = NextUniform(rng) - 0.5f;
+
+        float volts = cellVoltage + ocvOffset - cellCurrent * (kPackResistance / kCells) * resistanceSpread;
+        // Cells mid-pack run warmer than those near the coolant inlet/outlet
+        float position = (static_cast<float>(i) + 0.5f) / kCells;
+        float celsius = packTemp + 0.3f * heating * std::sin(3.14159265f * position) + tempOffset;
+
+        voltages[i] = std::round(volts * 1000.0f) * 0.001f;
+        temps[i] = std::round(celsius * 10.0f) * 0.1f;
+    }
+    cells.SetRange(CellField::Voltage, 0, voltages, static_cast<size_t>(count));
+    cells.SetRange(CellField::Temperature, 0, temps, static_cast<size_t>(count));
+}
+
+uint64_t FleetSimulator::Checksum() const {
+    uint64_t hash = 0xCBF29CE484222325ull;
+    auto mix = [&hash](const void* data, size_t size) {
+        const uint8_t* bytes = static_cast<const uint8_t*>(data);
+        for (size_t i = 0; i < size; i++) {
+            hash = (hash ^ bytes[i]) * 0x100000001B3ull;
+        }
+    };
+
+    const std::vector<float>* arrays[] = {
+        &speed_, &soc_, &voltage_, &current_, &packTemp_, &motorTemp_, &suppSoc_,
+    };
+    for (const auto* array : arrays) {
+        mix(array->data(), array->size() * sizeof(float));
+    }
+    mix(faultBits_.data(), faultBits_.size());
+    mix(&steps_, sizeof(steps_));
+    return hash;
+}
+
+VehicleControls ControlsFromState(const AppState& state) {
+    VehicleControls controls;
+    controls.mainContactor = state.contactorStates.main;
+    controls.gear = state.gear;
+    controls.brake = state.brakeEngaged;
+    controls.cruiseSetSpeed = state.cruise.enabled ? state.cruise.setSpeed : 0;
+    return controls;
+}
+
+Fault MakeFault(const SimEvent& event) {
+    Fault fault;
+    fault.code = SimFaultCode(event.fault);
+    fault.message = SimFaultMessage(event.fault);
+    fault.severity = SimFaultSeverity(event.fault);
+    fault.timestamp = event.timestampMs;
+    return fault;
+}
+
+} // namespace sim
+} // namespace ui
@@ -0,0 +1,225 @@
+#pragma once
+
+#include "state.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ui {
+namespace sim {
+
+/**
+ * Drive cycles (speed vs time, looped)
+ *
+ * Wltp  - WLTC class 3 shape: Low/Medium/High/Extra-high phases with the
+ *         official phase durations (589/433/455/323 s) and peak speeds,
+ *         built from representative micro-trips rather than the
+ *         per-second regulatory trace
+ * Urban - ECE-15 elementary urban cycle (195 s stop-go, 15/32/50 km/h)
+ */
+enum class DriveCycle {
+    Wltp,
+    Urban
+};
+
+/**
+ * Scripted fault scenarios (in addition to faults the physics raises)
+ */
+enum class FaultScenario : uint8_t {
+    None,
+    CanTimeoutFlapping,   // E003 toggles every few seconds for a minute
+    HvilOpen,             // E004, HVIL opens and the main contactor drops out
+    CoolingFailure,       // Pack cooling lost; E001 follows from the thermal model
+    DcDcFailure,          // 12V no longer charged; E005 once it sags
+    MotorCoolingFailure,  // Motor cooling lost; E002 follows, power derates
+    Count
+};
+
+/**
+ * Simulated fault codes; same codes/messages as the dashboard's templates
+ */
+enum class SimFault : uint8_t {
+    BatteryTempHigh,   // E001
+    MotorOverheat,     // E002
+    CanTimeout,        // E003
+    HvilOpen,          // E004
+    Low12V,            // E005
+    Count
+};
+
+const char* SimFaultCode(SimFault fault);
+const char* SimFaultMessage(SimFault fault);
+FaultSeverity SimFaultSeverity(SimFault fault);
+
+struct SimConfig {
+    uint32_t vehicles = 1;
+    uint64_t seed = 1;
+    DriveCycle cycle = DriveCycle::Wltp;
+    float stepSeconds = 0.1f;          // Fixed integration step
+    float scenarioProbability = 0.0f;  // Chance a vehicle gets a fault scenario
+    float scenarioWindowSeconds = 600.0f;  // Scenarios start uniformly in [0, window)
+    bool randomizeCycleStart = true;   // Spread vehicles over the cycle
+    int64_t startTimeMs = 0;           // Unix ms of sim time 0 (fault timestamps only)
+};
+
+/**
+ * Driver / operator inputs for one vehicle
+ */
+struct VehicleControls {
+    bool mainContactor = true;
+    Gear gear = Gear::Drive;
+    bool brake = false;
+    int cruiseSetSpeed = 0;            // km/h, 0 = follow the drive cycle
+};
+
+/**
+ * Fault raised or cleared during a step
+ */
+struct SimEvent {
+    uint32_t vehicle;
+    SimFault fault;
+    bool raised;
+    int64_t timestampMs;
+};
+
+/**
+ * Deterministic fleet simulator
+ *
+ * Vehicle state is kept as structure-of-arrays and integrated with a fixed
+ * step, so the result depends only on the seed and total simulated time,
+ * never on how Advance() calls are sliced. The per-step physics loop is
+ * branch-free over contiguous float arrays (auto-vectorizes); only
+ * vehicles with an active scenario take the scalar path.
+ *
+ * Model per vehicle: driver P-controller tracking the cycle (or cruise set
+ * speed), road load (rolling + aero), drivetrain/regen efficiency and
+ * motor power limit, 96s pack with SOC-dependent OCV and internal
+ * resistance (voltage sags under load, SOC drains by coulomb counting),
+ * first-order pack and motor thermal models, and a 12V battery kept up by
+ * the DC-DC converter.
+ */
+class FleetSimulator {
+public:
+    explicit FleetSimulator(const SimConfig& config);
+
+    /**
+     * Advance simulated time (runs whole fixed steps, carries the remainder)
+     */
+    void Advance(double seconds);
+
+    /**
+     * Run exactly one fixed step
+     */
+    void Step();
+
+    double GetTime() const { return static_cast<double>(steps_) * config_.stepSeconds; }
+    uint64_t GetStepCount() const { return steps_; }
+    uint32_t GetVehicleCount() const { return config_.vehicles; }
+    const SimConfig& GetConfig() const { return config_; }
+
+    /**
+     * Set operator inputs for a vehicle (defaults: contactor closed, Drive)
+     */
+    void SetControls(uint32_t vehicle, const VehicleControls& controls);
+
+    /**
+     * Start a vehicle from existing readings (pack and 12V SOC)
+     */
+    void InitVehicle(uint32_t vehicle, const AppState& state);
+
+    /**
+     * Write simulated outputs into an AppState
+     * Speed, batteries, heartbeat and HVIL are written; operator inputs
+     * (gear, brake, cruise, precharge) are left alone, except that an open
+     * HVIL opens the main contactor, as the BMS would.
+     */
+    void ReadVehicle(uint32_t vehicle, AppState& state) const;
+
+    /**
+     * Write per-cell voltages (1 mV) and temperatures (0.1 degC) for a
+     * vehicle's 96 cells, derived from the pack state plus fixed per-cell
+     * spread (capacity/resistance mismatch, position in the cooling loop)
+     */
+    void ReadCells(uint32_t vehicle, CellTelemetry& cells) const;
+
+    /**
+     * Scenario assigned to a vehicle
+     */
+    FaultScenario GetScenario(uint32_t vehicle) const { return scenario_[vehicle]; }
+
+    /**
+     * Fault events since the last ClearEvents()
+     */
+    const std::vector<SimEvent>& GetEvents() const { return events_; }
+    void ClearEvents() { events_.clear(); }
+
+    /**
+     * Hash of the full vehicle state, for determinism checks
+     */
+    uint64_t Checksum() const;
+
+private:
+    void StepPhysics();
+    void StepScenarios();
+    void CheckThresholds();
+    void Emit(uint32_t vehicle, SimFault fault, bool raised);
+
+    SimConfig config_;
+    uint64_t steps_ = 0;
+    double carry_ = 0.0;
+
+    // Drive cycle sampled at 1 Hz (duration + 1 entries, km/h)
+    std::vector<float> cycle_;
+    float cycleDuration_ = 0.0f;
+
+    // Per-vehicle parameters
+    std::vector<float> cycleOffset_;   // s
+    std::vector<float> speedScale_;
+    std::vector<float> mass_;          // kg
+    std::vector<float> packCooling_;   // W/K
+    std::vector<float> packHeater_;    // W (stuck coolant heater scenario)
+    std::vector<float> motorCooling_;  // W/K
+
+    // Controls (as floats so the physics loop stays branch-free)
+    std::vector<float> traction_;      // 1 = main contactor closed
+    std::vector<float> drive_;         // 1 = in Drive with brake released
+    std::vector<float> cruise_;        // m/s, 0 = off
+    std::vector<float> follow_;        // 1 = following the drive cycle (cruise off)
+    std::vector<float> dcdc_;          // 1 = DC-DC converter working
+    std::vector<float> target_;        // m/s, driver's target this step
+
+    // Dynamic state
+    std::vector<float> speed_;         // m/s
+    std::vector<float> accel_;         // m/s^2 (last step)
+    std::vector<float> soc_;           // 0..1
+    std::vector<float> voltage_;       // V
+    std::vector<float> current_;       // A, positive = discharge
+    std::vector<float> packTemp_;      // degC
+    std::vector<float> motorTemp_;     // degC
+    std::vector<float> suppSoc_;       // 0..1
+    std::vector<float> suppVoltage_;   // V
+    std::vector<uint8_t> hvil_;        // 1 = loop closed
+
+    // Active fault bits (1 << SimFault) and scenario bookkeeping
+    std::vector<uint8_t> faultBits_;
+    std::vector<FaultScenario> scenario_;
+    std::vector<float> scenarioStart_;
+    std::vector<float> scenarioNextToggle_;
+    std::vector<uint32_t> scenarioVehicles_;
+    std::vector<uint64_t> rng_;
+
+    std::vector<SimEvent> events_;
+};
+
+/**
+ * Map dashboard inputs to simulator controls
+ */
+VehicleControls ControlsFromState(const AppState& state);
+
+/**
+ * Convert a simulator event into a dashboard Fault
+ */
+Fault MakeFault(const SimEvent& event);
+
+} // namespace sim
+} // namespace ui
@@ -0,0 +1,204 @@
+#include "websocket.h"
+#include <cstring>
+#include <strings.h>
+
+namespace ui {
+namespace ws {
+
+static const char kHandshakeGuid[] = "258EAFA5-E914-47DA-95CA-C5AB0DC85B11";
+static constexpr size_t kMaxControlPayload = 125;
+
+static inline uint32_t RotateLeft(uint32_t v, int bits) {
+    return (v << bits) | (v >> (32 - bits));
+}
+
+static void Sha1Block(uint32_t h[5], const uint8_t* block) {
+    uint32_t w[80];
+    for (int i = 0; i < 16; i++) {
+        w[i] = (uint32_t(block[i * 4]) << 24) | (uint32_t(block[i * 4 + 1]) << 16) |
+               (uint32_t(block[i * 4 + 2]) << 8) | uint32_t(block[i * 4 + 3]);
+    }
+    for (int i = 16; i < 80; i++) {
+        w[i] = RotateLeft(w[i - 3] ^ w[i - 8] ^ w[i - 14] ^ w[i - 16], 1);
+    }
+
+    uint32_t a = h[0], b = h[1], c = h[2], d = h[3], e = h[4];
+    for (int i = 0; i < 80; i++) {
+        uint32_t f, k;
+        if (i < 20) {
+            f = (b & c) | (~b & d);
+            k = 0x5A827999;
+        } else if (i < 40) {
+            f = b ^ c ^ d;
+            k = 0x6ED9EBA1;
+        } else if (i < 60) {
+            f = (b & c) | (b & d) | (c & d);
+            k = 0x8F1BBCDC;
+        } else {
+            f = b ^ c ^ d;
+            k = 0xCA62C1D6;
+        }
+        uint32_t t = RotateLeft(a, 5) + f + e + k + w[i];
+        e = d;
+        d = c;
+        c = RotateLeft(b, 30);
+        b = a;
+        a = t;
+    }
+    h[0] += a; h[1] += b; h[2] += c; h[3] += d; h[4] += e;
+}
+
+void Sha1(const void* data, size_t size, uint8_t digest[20]) {
+    uint32_t h[5] = { 0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476, 0xC3D2E1F0 };
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+
+    size_t full = size / 64;
+    for (size_t i = 0; i < full; i++) Sha1Block(h, bytes + i * 64);
+
+    // Final block(s): remaining bytes, 0x80, zero padding, bit length (big-endian)
+    uint8_t tail[128] = {};
+    size_t rest = size - full * 64;
+    memcpy(tail, bytes + full * 64, rest);
+    tail[rest] = 0x80;
+    size_t tailSize = rest + 1 + 8 <= 64 ? 64 : 128;
+    uint64_t bits = static_cast<uint64_t>(size) * 8;
+    for (int i = 0; i < 8; i++) tail[tailSize - 1 - i] = static_cast<uint8_t>(bits >> (i * 8));
+    for (size_t offset = 0; offset < tailSize; offset += 64) Sha1Block(h, tail + offset);
+
+    for (int i = 0; i < 5; i++) {
+        digest[i * 4] = static_cast<uint8_t>(h[i] >> 24);
+        digest[i * 4 + 1] = static_cast<uint8_t>(h[i] >> 16);
+        digest[i * 4 + 2] = static_cast<uint8_t>(h[i] >> 8);
+        digest[i * 4 + 3] = static_cast<uint8_t>(h[i]);
+    }
+}
+
+std::string Base64Encode(const uint8_t* data, size_t size) {
+    static const char kAlphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    std::string out;
+    out.reserve((size + 2) / 3 * 4);
+    for (size_t i = 0; i < size; i += 3) {
+        uint32_t v = uint32_t(data[i]) << 16;
+        if (i + 1 < size) v |= uint32_t(data[i + 1]) << 8;
+        if (i + 2 < size) v |= data[i + 2];
+        out += kAlphabet[(v >> 18) & 63];
+        out += kAlphabet[(v >> 12) & 63];
+        out += i + 1 < size ? kAlphabet[(v >> 6) & 63] : '=';
+        out += i + 2 < size ? kAlphabet[v & 63] : '=';
+    }
+    return out;
+}
+
+std::string AcceptKey(const std::string& clientKey) {
+    std::string input = clientKey + kHandshakeGuid;
+    uint8_t digest[20];
+    Sha1(input.data(), input.size(), digest);
+    return Base64Encode(digest, sizeof(digest));
+}
+
+// Value of a header (name matched case-insensitively), trimmed; empty if absent
+static std::string HeaderValue(const char* begin, const char* end, const char* name) {
+    size_t nameLength = strlen(name);
+    for (const char* line = begin; line < end;) {
+        const char* lineEnd = static_cast<const char*>(memchr(line, '\n', static_cast<size_t>(end - line)));
+        if (!lineEnd) lineEnd = end;
+        if (static_cast<size_t>(lineEnd - line) > nameLength && line[nameLength] == ':' &&
+            strncasecmp(line, name, nameLength) == 0) {
+            const char* value = line + nameLength + 1;
+            const char* valueEnd = lineEnd;
+            while (value < valueEnd && (*value == ' ' || *value == '\t')) value++;
+            while (valueEnd > value && (valueEnd[-1] == '\r' || valueEnd[-1] == ' ' || valueEnd[-1] == '\t')) valueEnd--;
+            return std::string(value, valueEnd);
+        }
+        line = lineEnd + 1;
+    }
+    return std::string();
+}
+
+// Case-insensitive token search in a comma-separated header value
+static bool HasToken(const std::string& value, const char* token) {
+    size_t length = strlen(token);
+    for (size_t i = 0; i + length <= value.size(); i++) {
+        if (strncasecmp(value.c_str() + i, token, length) == 0) return true;
+    }
+    return false;
+}
+
+HandshakeStatus ParseHandshake(const char* request, size_t size, std::string& response, size_t& consumed) {
+    const char* end = nullptr;
+    for (size_t i = 0; i + 4 <= size; i++) {
+        if (memcmp(request + i, "\r\n\r\n", 4) == 0) {
+            end = request + i + 4;
+            break;
+        }
+    }
+    if (!end) return HandshakeStatus::Incomplete;
+    consumed = static_cast<size_t>(end - request);
+
+    std::string key = HeaderValue(request, end, "Sec-WebSocket-Key");
+    bool upgrade = size >= 4 && memcmp(request, "GET ", 4) == 0 &&
+                   HasToken(HeaderValue(request, end, "Upgrade"), "websocket") &&
+                   HasToken(HeaderValue(request, end, "Connection"), "upgrade") &&
+                   !key.empty();
+    if (!upgrade) {
+        response = "HTTP/1.1 400 Bad Request\r\nContent-Length: 0\r\nConnection: close\r\n\r\n";
+        return HandshakeStatus::Rejected;
+    }
+
+    response = "HTTP/1.1 101 Switching Protocols\r\n"
+               "Upgrade: websocket\r\n"
+               "Connection: Upgrade\r\n"
+               "Sec-WebSocket-Accept: " + AcceptKey(key) + "\r\n\r\n";
+    return HandshakeStatus::Upgrade;
+}
+
+size_t WriteFrameHeader(uint8_t* out, Opcode opcode, uint64_t payloadSize) {
+    out[0] = static_cast<uint8_t>(0x80 | opcode);
+    if (payloadSize < 126) {
+        out[1] = static_cast<uint8_t>(payloadSize);
+        return 2;
+    }
+    if (payloadSize <= 0xFFFF) {
+        out[1] = 126;
+        out[2] = static_cast<uint8_t>(payloadSize >> 8);
+        out[3] = static_cast<uint8_t>(payloadSize);
+        return 4;
+    }
+    out[1] = 127;
+    for (int i = 0; i < 8; i++) out[2 + i] = static_cast<uint8_t>(payloadSize >> ((7 - i) * 8));
+    return 10;
+}
+
+int ParseClientFrame(const uint8_t* data, size_t size, ClientFrame& frame) {
+    if (size < 2) return 0;
+    frame.final = (data[0] & 0x80) != 0;
+    frame.opcode = static_cast<Opcode>(data[0] & 0x0F);
+    if (!(data[1] & 0x80)) return -1;   // Clients must mask
+
+    uint64_t length = data[1] & 0x7F;
+    size_t header = 2;
+    if (length == 126) {
+        if (size < 4) return 0;
+        length = (uint64_t(data[2]) << 8) | data[3];
+        header = 4;
+    } else if (length == 127) {
+        if (size < 10) return 0;
+        length = 0;
+        for (int i = 0; i < 8; i++) length = (length << 8) | data[2 + i];
+        header = 10;
+    }
+    if ((frame.opcode & 0x8) && (length > kMaxControlPayload || !frame.final)) return -1;
+    if (size < header + 4) return 0;
+
+    memcpy(frame.mask, data + header, 4);
+    frame.headerSize = header + 4;
+    frame.payloadSize = length;
+    return 1;
+}
+
+void Unmask(uint8_t* data, size_t size, const uint8_t mask[4], uint64_t offset) {
+    for (size_t i = 0; i < size; i++) data[i] ^= mask[(offset + i) & 3];
+}
+
+} // namespace ws
+} // namespace ui
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace ui {
+namespace ws {
+
+/**
+ * Minimal RFC 6455 server-side helpers (no dependencies)
+ *
+ * Enough for a broadcast endpoint: the opening handshake, unfragmented
+ * server frames and parsing of the (masked) frames a browser sends back.
+ * Fragmented client messages are skipped, not reassembled.
+ */
+
+/**
+ * SHA-1 of a buffer (only used for the handshake)
+ */
+void Sha1(const void* data, size_t size, uint8_t digest[20]);
+
+/**
+ * Standard base64 with padding
+ */
+std::string Base64Encode(const uint8_t* data, size_t size);
+
+/**
+ * Sec-WebSocket-Accept value for a client's Sec-WebSocket-Key
+ */
+std::string AcceptKey(const std::string& clientKey);
+
+/**
+ * Result of looking at a (possibly partial) HTTP request
+ */
+enum class HandshakeStatus {
+    Incomplete,   // Header block not finished yet
+    Upgrade,      // Valid WebSocket upgrade; response is the 101 reply
+    Rejected      // Not a WebSocket request; response is a 400 reply
+};
+
+/**
+ * Parse an opening handshake request and build the reply
+ *
+ * @param request Bytes received so far
+ * @param size Number of bytes
+ * @param response Receives the HTTP response to send (Upgrade / Rejected)
+ * @param consumed Receives the length of the request header block
+ */
+HandshakeStatus ParseHandshake(const char* request, size_t size, std::string& response, size_t& consumed);
+
+/**
+ * Frame opcodes
+ */
+enum Opcode : uint8_t {
+    Opcode_Continuation = 0x0,
+    Opcode_Text         = 0x1,
+    Opcode_Binary       = 0x2,
+    Opcode_Close        = 0x8,
+    Opcode_Ping         = 0x9,
+    Opcode_Pong         = 0xA,
+};
+
+constexpr size_t kMaxFrameHeader = 10;   // Server frames are never masked
+
+/**
+ * Write an unmasked, final frame header
+ * @return Header length (2, 4 or 10 bytes)
+ */
+size_t WriteFrameHeader(uint8_t* out, Opcode opcode, uint64_t payloadSize);
+
+/**
+ * One frame received from a client
+ */
+struct ClientFrame {
+    Opcode opcode;
+    bool final;
+    size_t headerSize;
+    uint64_t payloadSize;
+    uint8_t mask[4];
+};
+
+/**
+ * Parse a client frame header
+ *
+ * @return 1 if a header was parsed, 0 if more bytes are needed,
+ *         -1 on a protocol error (unmasked frame, oversized control frame)
+ */
+int ParseClientFrame(const uint8_t* data, size_t size, ClientFrame& frame);
+
+/**
+ * Unmask a client payload in place
+ * @param offset Position of data within the payload (for partial payloads)
+ */
+void Unmask(uint8_t* data, size_t size, const uint8_t mask[4], uint64_t offset = 0);
+
+} // namespace ws
+} // namespace ui
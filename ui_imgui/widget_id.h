@@ -0,0 +1,60 @@
+#pragma once
+
+#include "crc32.h"
+#include "imgui.h"
+
+namespace ui {
+
+/**
+ * Compile-time widget IDs
+ *
+ * HashId reproduces Dear ImGui's ImHashStr (CRC-32, seed chaining, "###"
+ * resets the hash to the seed) and ImHashData for int IDs, so an ID
+ * computed here equals what ImGui::GetID() would return for the same
+ * string under the same seed. Evaluated in a constexpr context the hash
+ * costs nothing at runtime:
+ *
+ * @code
+ *   constexpr ImGuiID kGearScope = HashId("Dashboard/Gear");
+ *   constexpr ImGuiID kParkId = HashId("P", kGearScope);
+ *
+ *   ImGui::PushOverrideID(kGearScope);   // IDs below are now known statically
+ *   widgets::Button(kParkId, "P");
+ *   ImGui::PopID();
+ * @endcode
+ *
+ * Window-relative IDs depend on the runtime ID stack; use an absolute
+ * scope (PushOverrideID or the explicit-ID widget overloads) to make the
+ * whole ID a compile-time constant.
+ */
+constexpr ImGuiID HashId(const char* str, ImGuiID seed = 0) {
+    uint32_t crc = ~seed;
+    for (; *str; str++) {
+        unsigned char c = static_cast<unsigned char>(*str);
+        if (c == '#' && str[1] == '#' && str[2] == '#') {
+            crc = ~seed;
+        }
+        crc = (crc >> 8) ^ kCrc32Table.entries[(crc ^ c) & 0xFF];
+    }
+    return ~crc;
+}
+
+/**
+ * Integer ID, matches ImGui::GetID(int) / PushID(int) under the same seed
+ * (ImHashData over the int's bytes; little-endian hosts)
+ */
+constexpr ImGuiID HashId(int n, ImGuiID seed) {
+    uint32_t crc = ~seed;
+    uint32_t bits = static_cast<uint32_t>(n);
+    for (int i = 0; i < 4; i++) {
+        crc = (crc >> 8) ^ kCrc32Table.entries[(crc ^ (bits >> (i * 8))) & 0xFF];
+    }
+    return ~crc;
+}
+
+// CRC-32 check values and ImGui's "###" rule
+static_assert(HashId("123456789") == 0xCBF43926u, "HashId must match CRC-32 / ImHashStr");
+static_assert(HashId(0, 0) == 0x2144DF1Cu, "HashId(int) must match ImHashData");
+static_assert(HashId("Label###Id", 7) == HashId("###Id", 7), "\"###\" must reset to the seed");
+
+} // namespace ui
@@ -1,4 +1,5 @@
 #include "widgets.h"
+#include "imgui_internal.h"
 #include <cmath>
 #include <algorithm>
 #include <cstdio>
@@ -29,11 +30,112 @@ void EndCard() {
     ImGui::PopStyleVar(2);
 }
 
+// Open flat cards; fixed depth so nesting never allocates and the
+// splitters keep their channel buffers from frame to frame
+struct FlatCardFrame {
+    ImVec2 min;
+    ImVec2 size;
+    ImVec2 padding;
+    ImVec4 bgColor;
+    ImVec4 borderColor;
+    bool fitHeight;
+    float backupWorkMaxX;
+    float backupContentMaxX;
+    ImDrawListSplitter splitter;
+};
+
+static constexpr int kMaxFlatCardDepth = 8;
+static FlatCardFrame s_flatCards[kMaxFlatCardDepth];
+static int s_flatCardDepth = 0;
+
+static void DrawFlatCardFrame(ImDrawList* drawList, const FlatCardFrame& card, const ImVec2& max) {
+    // GetColorU32 applies style alpha, matching how ChildBg/Border are drawn
+    drawList->AddRectFilled(card.min, max, ImGui::GetColorU32(card.bgColor), Rounding::Card);
+    if (card.borderColor.w > 0.0f) {
+        drawList->AddRect(card.min, max, ImGui::GetColorU32(card.borderColor), Rounding::Card);
+    }
+}
+
+void BeginFlatCard(const ImVec2& size, const ImVec4& bgColor, const ImVec4& borderColor, const ImVec2& padding) {
+    IM_ASSERT(s_flatCardDepth < kMaxFlatCardDepth && "flat cards nested too deeply");
+    FlatCardFrame& card = s_flatCards[s_flatCardDepth++];
+    
+    ImGuiWindow* window = ImGui::GetCurrentWindow();
+    ImDrawList* drawList = window->DrawList;
+    ImVec2 avail = ImGui::GetContentRegionAvail();
+    
+    card.min = ImGui::GetCursorScreenPos();
+    card.size = ImVec2(size.x > 0.0f ? size.x : std::max(avail.x + size.x, 1.0f), size.y);
+    card.padding = padding;
+    card.bgColor = bgColor;
+    card.borderColor = borderColor;
+    card.fitHeight = size.y <= 0.0f;
+    
+    float maxX = card.min.x + card.size.x;
+    if (card.fitHeight) {
+        // Height unknown until the content is laid out: content goes to
+        // channel 1, the frame is drawn behind it in channel 0 at End
+        card.splitter.Split(drawList, 2);
+        card.splitter.SetCurrentChannel(drawList, 1);
+        ImGui::PushClipRect(card.min, ImVec2(maxX, window->ClipRect.Max.y), true);
+    } else {
+        ImVec2 max = ImVec2(maxX, card.min.y + card.size.y);
+        DrawFlatCardFrame(drawList, card, max);
+        ImGui::PushClipRect(card.min, max, true);
+    }
+    
+    // Narrow the work rect so avail width and right alignment match the card
+    card.backupWorkMaxX = window->WorkRect.Max.x;
+    card.backupContentMaxX = window->ContentRegionRect.Max.x;
+    window->WorkRect.Max.x = maxX - padding.x;
+    window->ContentRegionRect.Max.x = maxX - padding.x;
+    
+    ImGui::SetCursorScreenPos(ImVec2(card.min.x + padding.x, card.min.y + padding.y));
+    ImGui::BeginGroup();
+}
+
+// Closes the group and frame; leaves the cursor at the card origin with the
+// card's rect ready to be submitted as an item
+static ImVec2 EndFlatCardFrame() {
+    IM_ASSERT(s_flatCardDepth > 0 && "EndFlatCard without BeginFlatCard");
+    FlatCardFrame& card = s_flatCards[--s_flatCardDepth];
+    
+    ImGui::EndGroup();
+    
+    ImGuiWindow* window = ImGui::GetCurrentWindow();
+    ImDrawList* drawList = window->DrawList;
+    window->WorkRect.Max.x = card.backupWorkMaxX;
+    window->ContentRegionRect.Max.x = card.backupContentMaxX;
+    ImGui::PopClipRect();
+    
+    ImVec2 size = card.size;
+    if (card.fitHeight) {
+        size.y = ImGui::GetItemRectMax().y - card.min.y + card.padding.y;
+        card.splitter.SetCurrentChannel(drawList, 0);
+        DrawFlatCardFrame(drawList, card, ImVec2(card.min.x + size.x, card.min.y + size.y));
+        card.splitter.Merge(drawList);
+    }
+    
+    ImGui::SetCursorScreenPos(card.min);
+    return size;
+}
+
+void EndFlatCard() {
+    ImGui::Dummy(EndFlatCardFrame());
+}
+
+bool EndFlatCardButton(const char* id) {
+    return ImGui::InvisibleButton(id, EndFlatCardFrame());
+}
+
 void Badge(const char* label, const ImVec4& color, const ImVec4& textColor) {
+    Badge(label, ImGui::CalcTextSize(label), color, textColor);
+}
+
+void Badge(const char* label, const ImVec2& textSize, const ImVec4& color, const ImVec4& textColor) {
     ImDrawList* drawList = ImGui::GetWindowDrawList();
     ImVec2 pos = ImGui::GetCursorScreenPos();
     
-    ImVec2 textSize = ImGui::CalcTextSize(label);
     float paddingX = 8.0f;
     float paddingY = 2.0f;
     
@@ -108,31 +210,70 @@ bool LabeledToggle(const char* label, bool* value) {
 }
 
 bool LabeledSlider(const char* label, float* value, float minVal, float maxVal, const char* format) {
+    return LabeledSlider(ImGui::GetID(label), label, value, minVal, maxVal, format);
+}
+
+bool LabeledSlider(ImGuiID id, const char* label, float* value, float minVal, float maxVal, const char* format) {
     ImGui::Text("%s", label);
     
-    char idBuf[128];
-    snprintf(idBuf, sizeof(idBuf), "##%s", label);
-    
+    // Empty label under an override ID: GetID("") returns the seed itself
+    ImGui::PushOverrideID(id);
     ImGui::PushItemWidth(-1);
-    bool changed = ImGui::SliderFloat(idBuf, value, minVal, maxVal, format);
+    bool changed = ImGui::SliderFloat("", value, minVal, maxVal, format);
     ImGui::PopItemWidth();
+    ImGui::PopID();
     
     return changed;
 }
 
 bool LabeledInput(const char* label, char* buf, size_t bufSize) {
+    return LabeledInput(ImGui::GetID(label), label, buf, bufSize);
+}
+
+bool LabeledInput(ImGuiID id, const char* label, char* buf, size_t bufSize) {
     ImGui::Text("%s", label);
     
-    char idBuf[128];
-    snprintf(idBuf, sizeof(idBuf), "##%s", label);
-    
+    ImGui::PushOverrideID(id);
     ImGui::PushItemWidth(-1);
-    bool changed = ImGui::InputText(idBuf, buf, bufSize);
+    bool changed = ImGui::InputText("", buf, bufSize);
     ImGui::PopItemWidth();
+    ImGui::PopID();
     
     return changed;
 }
 
+bool Button(ImGuiID id, const char* label, const ImVec2& size) {
+    ImGuiWindow* window = ImGui::GetCurrentWindow();
+    if (window->SkipItems) {
+        return false;
+    }
+    
+    // Mirrors ImGui::ButtonEx without the label -> ID step
+    const ImGuiStyle& style = ImGui::GetStyle();
+    ImVec2 labelSize = ImGui::CalcTextSize(label);
+    ImVec2 itemSize = ImGui::CalcItemSize(size, labelSize.x + style.FramePadding.x * 2.0f,
+                                          labelSize.y + style.FramePadding.y * 2.0f);
+    ImVec2 pos = window->DC.CursorPos;
+    ImRect bb(pos.x, pos.y, pos.x + itemSize.x, pos.y + itemSize.y);
+    
+    ImGui::ItemSize(itemSize, style.FramePadding.y);
+    if (!ImGui::ItemAdd(bb, id)) {
+        return false;
+    }
+    
+    bool hovered = false;
+    bool held = false;
+    bool pressed = ImGui::ButtonBehavior(bb, id, &hovered, &held);
+    
+    ImGuiCol colorIdx = (held && hovered) ? ImGuiCol_ButtonActive : hovered ? ImGuiCol_ButtonHovered : ImGuiCol_Button;
+    ImGui::RenderFrame(bb.Min, bb.Max, ImGui::GetColorU32(colorIdx), true, style.FrameRounding);
+    ImGui::RenderTextClipped(ImVec2(bb.Min.x + style.FramePadding.x, bb.Min.y + style.FramePadding.y),
+                             ImVec2(bb.Max.x - style.FramePadding.x, bb.Max.y - style.FramePadding.y),
+                             label, nullptr, &labelSize, style.ButtonTextAlign, &bb);
+    
+    return pressed;
+}
+
 bool IconButton(const char* icon, const char* tooltip, bool active, float size) {
     if (size <= 0) {
         size = ImGui::GetFrameHeight();
@@ -346,11 +487,15 @@ void ValueDisplay(const char* label, const char* value, const char* unit, const
 }
 
 void KeyValue(const char* key, const char* value, const ImVec4& valueColor) {
+    KeyValue(key, value, ImGui::CalcTextSize(value).x, valueColor);
+}
+
+void KeyValue(const char* key, const char* value, float valueWidth, const ImVec4& valueColor) {
     ImGui::PushStyleColor(ImGuiCol_Text, Colors::MutedForeground());
     ImGui::TextUnformatted(key);
     ImGui::PopStyleColor();
     
-    ImGui::SameLine(ImGui::GetContentRegionAvail().x - ImGui::CalcTextSize(value).x);
+    ImGui::SameLine(ImGui::GetContentRegionAvail().x - valueWidth);
     
     ImGui::PushStyleColor(ImGuiCol_Text, valueColor);
     ImGui::TextUnformatted(value);
@@ -367,5 +512,35 @@ void Space(float height) {
     ImGui::Dummy(ImVec2(0, height));
 }
 
+// Open stale regions: first vertex of each, -1 when not stale
+static constexpr int kMaxStaleDepth = 8;
+static int s_staleStart[kMaxStaleDepth];
+static int s_staleDepth = 0;
+
+// Stale values keep their layout but lose their color and half their alpha
+static constexpr float kStaleAlpha = 0.45f;
+
+void BeginStale(bool stale) {
+    IM_ASSERT(s_staleDepth < kMaxStaleDepth && "stale regions nested too deeply");
+    s_staleStart[s_staleDepth++] = stale ? ImGui::GetWindowDrawList()->VtxBuffer.Size : -1;
+}
+
+void EndStale() {
+    IM_ASSERT(s_staleDepth > 0 && "EndStale() without BeginStale()");
+    int start = s_staleStart[--s_staleDepth];
+    if (start < 0) return;
+    
+    ImDrawList* drawList = ImGui::GetWindowDrawList();
+    for (int i = start; i < drawList->VtxBuffer.Size; i++) {
+        ImU32& col = drawList->VtxBuffer.Data[i].col;
+        unsigned r = (col >> IM_COL32_R_SHIFT) & 0xff;
+        unsigned g = (col >> IM_COL32_G_SHIFT) & 0xff;
+        unsigned b = (col >> IM_COL32_B_SHIFT) & 0xff;
+        unsigned a = (col >> IM_COL32_A_SHIFT) & 0xff;
+        unsigned grey = (r * 77 + g * 150 + b * 29) >> 8;
+        col = IM_COL32(grey, grey, grey, static_cast<unsigned>(a * kStaleAlpha));
+    }
+}
+
 } // namespace widgets
 } // namespace ui
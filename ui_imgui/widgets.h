@@ -2,6 +2,7 @@
 
 #include "imgui.h"
 #include "theme.h"
+#include "widget_id.h"
 #include <string>
 #include <vector>
 
@@ -24,6 +25,43 @@ bool BeginCard(const char* id, const ImVec2& size = ImVec2(0, 0), bool border =
  */
 void EndCard();
 
+/**
+ * Begin a flat card: rounded background and border drawn straight into the
+ * current window's draw list, content laid out in a group
+ *
+ * Same look as a bordered child window, without the child window: no extra
+ * draw list, window lookup or ID scope per card. Content is clipped to the
+ * card (drawing, hover and click tests, culling) and
+ * GetContentRegionAvail() reports the card's inner width, so
+ * right-aligned SameLine() layouts behave as they do inside BeginChild.
+ * Cards may nest.
+ *
+ * @param size Card size; x <= 0 is relative to the available width (as for
+ *             BeginChild), y <= 0 fits the content (background is deferred
+ *             through an ImDrawListSplitter)
+ * @param bgColor Background color
+ * @param borderColor Border color (alpha 0 for no border)
+ * @param padding Inner padding
+ */
+void BeginFlatCard(const ImVec2& size, const ImVec4& bgColor = Colors::Card(),
+                   const ImVec4& borderColor = Colors::Border(),
+                   const ImVec2& padding = ImVec2(Spacing::CardPadding, Spacing::CardPadding));
+
+/**
+ * End a flat card (must match BeginFlatCard)
+ * The card is submitted as a single item, so IsItemHovered() etc. apply to
+ * the whole card.
+ */
+void EndFlatCard();
+
+/**
+ * End a flat card and make the whole card a button
+ * 
+ * @param id Button ID
+ * @return true if clicked
+ */
+bool EndFlatCardButton(const char* id);
+
 /**
  * Render a status badge/pill indicator
  * 
@@ -33,6 +71,12 @@ void EndCard();
  */
 void Badge(const char* label, const ImVec4& color, const ImVec4& textColor = ImVec4(-1, 0, 0, 0));
 
+/**
+ * Badge with the label's size already known (e.g. from the layout cache)
+ */
+void Badge(const char* label, const ImVec2& textSize, const ImVec4& color,
+           const ImVec4& textColor = ImVec4(-1, 0, 0, 0));
+
 /**
  * Render a colored status badge based on severity
  * Uses predefined colors for success, warning, critical states
@@ -60,6 +104,12 @@ bool LabeledToggle(const char* label, bool* value);
  */
 bool LabeledSlider(const char* label, float* value, float minVal, float maxVal, const char* format = "%.1f");
 
+/**
+ * Labeled slider with an explicit ID (e.g. a constexpr HashId)
+ * No ID formatting or hashing per frame.
+ */
+bool LabeledSlider(ImGuiID id, const char* label, float* value, float minVal, float maxVal, const char* format = "%.1f");
+
 /**
  * Render a labeled input field
  * 
@@ -70,6 +120,23 @@ bool LabeledSlider(const char* label, float* value, float minVal, float maxVal,
  */
 bool LabeledInput(const char* label, char* buf, size_t bufSize);
 
+/**
+ * Labeled input field with an explicit ID (e.g. a constexpr HashId)
+ */
+bool LabeledInput(ImGuiID id, const char* label, char* buf, size_t bufSize);
+
+/**
+ * Button with an explicit ID
+ * Looks and behaves like ImGui::Button, but the label is display-only:
+ * the ID is not derived from it, so nothing is formatted or hashed.
+ * 
+ * @param id Widget ID (e.g. a constexpr HashId)
+ * @param label Button text
+ * @param size Button size (0 for auto, as ImGui::Button)
+ * @return true if clicked
+ */
+bool Button(ImGuiID id, const char* label, const ImVec2& size = ImVec2(0, 0));
+
 /**
  * Render an icon button (works with or without icon font)
  * Falls back to text if no icon font available
@@ -174,6 +241,11 @@ void ValueDisplay(const char* label, const char* value, const char* unit = nullp
  */
 void KeyValue(const char* key, const char* value, const ImVec4& valueColor = Colors::Foreground());
 
+/**
+ * Key-value row with the value's width already known (LayoutCache::TextWidth)
+ */
+void KeyValue(const char* key, const char* value, float valueWidth, const ImVec4& valueColor = Colors::Foreground());
+
 /**
  * Separator with proper spacing
  */
@@ -184,5 +256,17 @@ void Separator();
  */
 void Space(float height = 8.0f);
 
+/**
+ * Grey out what is drawn until EndStale() (values whose source stopped
+ * updating)
+ * Recolors the vertices added to the current window's draw list, so it
+ * covers text, badges and bars alike. Begin and end in the same window and
+ * flat card; geometry built on ParallelDraw workers is not included.
+ *
+ * @param stale Nothing happens when false
+ */
+void BeginStale(bool stale);
+void EndStale();
+
 } // namespace widgets
 } // namespace ui